@@ -4,14 +4,41 @@
 #include <EditorPluginProcGen/ProcGenGraphAsset/ProcGenNodeManager.h>
 #include <Foundation/CodeUtils/Expression/ExpressionByteCode.h>
 #include <Foundation/CodeUtils/Expression/ExpressionCompiler.h>
+#include <Foundation/CodeUtils/Expression/ExpressionNativeCode.h>
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/IO/ChunkStream.h>
 #include <Foundation/IO/StringDeduplicationContext.h>
 #include <Foundation/Utilities/DGMLWriter.h>
 #include <ToolsFoundation/Command/NodeCommands.h>
 #include <ToolsFoundation/Serialization/DocumentObjectConverter.h>
 
+plCVarBool cvar_ProcGenGenerateNativeCode("ProcGen.GenerateNativeCode", false, plCVarFlags::Save, "Write C++ code for every ProcGen output to AssetCache/Generated/ProcGenNativeCode when a graph is transformed. A plugin that compiles these files executes the outputs natively.");
+
 namespace
 {
+  /// \brief Writes the native code for the given byte code. The file is named after the byte code hash, so outputs with identical code share it.
+  void WriteNativeCode(const plExpressionByteCode& byteCode, plStringView sAssetName, plStringView sOutputName)
+  {
+    plStringBuilder sFunctionName;
+    sFunctionName.SetFormat("ProcGen_{}", plArgU(byteCode.GetHash(), 16, true, 16));
+
+    plStringBuilder sCode;
+    if (plExpressionNativeCode::GenerateCpp(byteCode, sFunctionName, sCode).Failed())
+    {
+      plLog::Warning("Failed to generate native code for the ProcGen output '{}' in '{}'", sOutputName, sAssetName);
+      return;
+    }
+
+    plStringBuilder sFileName;
+    sFileName.SetFormat(":project/AssetCache/Generated/ProcGenNativeCode/{0}.cpp", sFunctionName);
+
+    plFileWriter fileWriter;
+    if (fileWriter.Open(sFileName).Failed() || fileWriter.WriteBytes(sCode.GetData(), sCode.GetElementCount()).Failed())
+    {
+      plLog::Warning("Failed to write the native code of the ProcGen output '{}' in '{}' to: {}", sOutputName, sAssetName, sFileName);
+    }
+  }
+
   void DumpAST(const plExpressionAST& ast, plStringView sAssetName, plStringView sOutputName)
   {
     plDGMLGraph dgmlGraph;
@@ -161,6 +188,15 @@ plStatus plProcGenGraphAssetDocument::WriteAsset(plStreamWriter& inout_stream, c
 
     PL_SUCCEED_OR_RETURN(byteCode.Save(chunk));
 
+    if (cvar_ProcGenGenerateNativeCode)
+    {
+      plStringBuilder sDocumentPath = GetDocumentPath();
+      plStringView sAssetName = sDocumentPath.GetFileNameAndExtension();
+      const plString sOutputName = pOutputNode->GetTypeAccessor().GetValue("Name").ConvertTo<plString>();
+
+      WriteNativeCode(byteCode, sAssetName, sOutputName);
+    }
+
     return plStatus(PL_SUCCESS);
   };
 
@@ -89,5 +89,35 @@ PL_BEGIN_DYNAMIC_REFLECTED_TYPE(plMsgBuildStaticMesh, 1, plRTTIDefaultAllocator<
 PL_END_DYNAMIC_REFLECTED_TYPE;
 // clang-format on
 
+void plPhysicsWorldModuleInterface::RaycastBatch(plArrayPtr<const plPhysicsCastRequest> rays, plArrayPtr<plPhysicsCastResult> out_results, plArrayPtr<bool> out_hits, const plPhysicsQueryParameters& params, plPhysicsHitCollection collection) const
+{
+  PL_ASSERT_DEV(out_results.GetCount() == rays.GetCount() && out_hits.GetCount() == rays.GetCount(), "Result arrays must have the same size as the query array");
+
+  for (plUInt32 i = 0; i < rays.GetCount(); ++i)
+  {
+    out_hits[i] = Raycast(out_results[i], rays[i].m_vStart, rays[i].m_vDir, rays[i].m_fDistance, params, collection);
+  }
+}
+
+void plPhysicsWorldModuleInterface::SweepTestSphereBatch(float fSphereRadius, plArrayPtr<const plPhysicsCastRequest> sweeps, plArrayPtr<plPhysicsCastResult> out_results, plArrayPtr<bool> out_hits, const plPhysicsQueryParameters& params, plPhysicsHitCollection collection) const
+{
+  PL_ASSERT_DEV(out_results.GetCount() == sweeps.GetCount() && out_hits.GetCount() == sweeps.GetCount(), "Result arrays must have the same size as the query array");
+
+  for (plUInt32 i = 0; i < sweeps.GetCount(); ++i)
+  {
+    out_hits[i] = SweepTestSphere(out_results[i], fSphereRadius, sweeps[i].m_vStart, sweeps[i].m_vDir, sweeps[i].m_fDistance, params, collection);
+  }
+}
+
+void plPhysicsWorldModuleInterface::OverlapTestSphereBatch(plArrayPtr<const plBoundingSphere> spheres, plArrayPtr<bool> out_hits, const plPhysicsQueryParameters& params) const
+{
+  PL_ASSERT_DEV(out_hits.GetCount() == spheres.GetCount(), "Result array must have the same size as the query array");
+
+  for (plUInt32 i = 0; i < spheres.GetCount(); ++i)
+  {
+    out_hits[i] = OverlapTestSphere(spheres[i].m_fRadius, spheres[i].m_vCenter, params);
+  }
+}
+
 
 PL_STATICLINK_FILE(Core, Core_Interfaces_PhysicsWorldModule);
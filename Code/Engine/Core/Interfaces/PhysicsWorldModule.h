@@ -108,6 +108,16 @@ enum class plPhysicsHitCollection
   Any
 };
 
+/// \brief Describes one ray or sweep of a batch query, e.g. plPhysicsWorldModuleInterface::RaycastBatch().
+struct plPhysicsCastRequest
+{
+  PL_DECLARE_POD_TYPE();
+
+  plVec3 m_vStart;
+  plVec3 m_vDir; ///< Has to be normalized.
+  float m_fDistance = 0.0f;
+};
+
 class PL_CORE_DLL plPhysicsWorldModuleInterface : public plWorldModule
 {
   PL_ADD_DYNAMIC_REFLECTION(plPhysicsWorldModuleInterface, plWorldModule);
@@ -140,6 +150,21 @@ public:
 
   virtual void QueryShapesInSphere(plPhysicsOverlapResultArray& out_results, float fSphereRadius, const plVec3& vPosition, const plPhysicsQueryParameters& params) const = 0;
 
+  /// \name Batch queries
+  ///
+  /// These execute many queries of the same kind with one call. out_hits[i] is set to whether query i found anything
+  /// and out_results[i] is only valid if it did. Both arrays must have the same size as the array of queries.
+  /// Physics integrations may process the queries on multiple threads, the default implementations just execute the single queries one after the other.
+  ///@{
+
+  virtual void RaycastBatch(plArrayPtr<const plPhysicsCastRequest> rays, plArrayPtr<plPhysicsCastResult> out_results, plArrayPtr<bool> out_hits, const plPhysicsQueryParameters& params, plPhysicsHitCollection collection = plPhysicsHitCollection::Closest) const;
+
+  virtual void SweepTestSphereBatch(float fSphereRadius, plArrayPtr<const plPhysicsCastRequest> sweeps, plArrayPtr<plPhysicsCastResult> out_results, plArrayPtr<bool> out_hits, const plPhysicsQueryParameters& params, plPhysicsHitCollection collection = plPhysicsHitCollection::Closest) const;
+
+  virtual void OverlapTestSphereBatch(plArrayPtr<const plBoundingSphere> spheres, plArrayPtr<bool> out_hits, const plPhysicsQueryParameters& params) const;
+
+  ///@}
+
   virtual plVec3 GetGravity() const = 0;
 
   virtual void QueryGeometryInBox(const plPhysicsQueryParameters& params, plBoundingBox box, plDynamicArray<plPhysicsTriangle>& out_triangles) const = 0;
@@ -68,6 +68,7 @@ struct plResourceFlags
     PreventFileReload       = PL_BIT(7),  ///< Once this flag is set, no reloading from file is done, until the flag is manually removed. Automatically set when a custom loader is used. To restore a file to the disk state, this flag must be removed and then the resource can be reloaded.
     HasLowResData           = PL_BIT(8),  ///< Whether low resolution data was set on a resource once before
     IsCreatedResource       = PL_BIT(9),  ///< When this is set, the resource was created and not loaded from file
+    StreamQualityLevels     = PL_BIT(10), ///< Additional quality levels are not loaded automatically on acquire, some streaming system decides how many quality levels are needed. See plResourceManager::SetQualityLevelStreaming().
     Default                 = 0,
   };
 
@@ -83,6 +84,7 @@ struct plResourceFlags
     StorageType PreventFileReload       : 1;
     StorageType HasLowResData           : 1;
     StorageType IsCreatedResource       : 1;
+    StorageType StreamQualityLevels     : 1;
   };
 };
 
@@ -140,6 +140,13 @@ void plResource::CallUnloadData(Unload WhatToUnload)
   m_LoadingState = ld.m_State;
   m_uiQualityLevelsDiscardable = ld.m_uiQualityLevelsDiscardable;
   m_uiQualityLevelsLoadable = ld.m_uiQualityLevelsLoadable;
+
+  // the memory usage is used to enforce the memory budgets, so it needs to be up to date after partial unloads as well
+  {
+    plResource::MemoryUsage MemUsage;
+    UpdateMemoryUsage(MemUsage);
+    m_MemoryUsage = MemUsage;
+  }
 }
 
 #if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
@@ -236,6 +243,8 @@ void plResource::SetPriority(plResourcePriority priority)
 
   m_Priority = priority;
 
+  plResourceManager::UpdateLoadingPriority(this);
+
   plResourceEvent e;
   e.m_pResource = this;
   e.m_Type = plResourceEvent::Type::ResourcePriorityChanged;
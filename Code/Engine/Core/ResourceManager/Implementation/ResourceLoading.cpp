@@ -128,29 +128,6 @@ void plResourceManager::RunWorkerTask(plResource* pResource)
   }
 }
 
-void plResourceManager::ReverseBubbleSortStep(plDeque<LoadingInfo>& data)
-{
-  // Yep, it's really bubble sort!
-  // This will move the entry with the smallest value to the front and move all other values closer to their correct position,
-  // which is exactly what we need for the priority queue.
-  // We do this once a frame, which gives us nice iterative sorting, with relatively deterministic performance characteristics.
-
-  PL_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
-
-  const plUInt32 uiCount = data.GetCount();
-
-  for (plUInt32 i = uiCount; i > 1; --i)
-  {
-    const plUInt32 idx2 = i - 1;
-    const plUInt32 idx1 = i - 2;
-
-    if (data[idx1].m_fPriority > data[idx2].m_fPriority)
-    {
-      plMath::Swap(data[idx1], data[idx2]);
-    }
-  }
-}
-
 void plResourceManager::UpdateLoadingDeadlines()
 {
   if (s_pState->m_LoadingQueue.IsEmpty())
@@ -160,36 +137,25 @@ void plResourceManager::UpdateLoadingDeadlines()
 
   PL_PROFILE_SCOPE("UpdateLoadingDeadlines");
 
-  const plUInt32 uiCount = s_pState->m_LoadingQueue.GetCount();
-  s_pState->m_uiLastResourcePriorityUpdateIdx = plMath::Min(s_pState->m_uiLastResourcePriorityUpdateIdx, uiCount);
-
-  plUInt32 uiUpdateCount = plMath::Min(50u, uiCount - s_pState->m_uiLastResourcePriorityUpdateIdx);
-
-  if (uiUpdateCount == 0)
-  {
-    s_pState->m_uiLastResourcePriorityUpdateIdx = 0;
-    uiUpdateCount = plMath::Min(50u, uiCount - s_pState->m_uiLastResourcePriorityUpdateIdx);
-  }
+  // the priorities depend on the time since the last acquire, so they change all the time
+  // refresh all of them once per frame, with the same frame time that is used when resources get queued
+  if (s_pState->m_LastLoadingDeadlinesUpdate == s_pState->m_LastFrameUpdate)
+    return;
 
-  if (uiUpdateCount > 0)
-  {
-    {
-      PL_PROFILE_SCOPE("EvalLoadingDeadlines");
+  s_pState->m_LastLoadingDeadlinesUpdate = s_pState->m_LastFrameUpdate;
+  s_pState->m_LoadingQueue.UpdateAllPriorities(s_pState->m_LastFrameUpdate);
+}
 
-      const plTime tNow = plTime::Now();
+void plResourceManager::UpdateLoadingPriority(plResource* pResource)
+{
+  if (!IsQueuedForLoading(pResource))
+    return;
 
-      for (plUInt32 i = 0; i < uiUpdateCount; ++i)
-      {
-        auto& element = s_pState->m_LoadingQueue[s_pState->m_uiLastResourcePriorityUpdateIdx];
-        element.m_fPriority = element.m_pResource->GetLoadingPriority(tNow);
-        ++s_pState->m_uiLastResourcePriorityUpdateIdx;
-      }
-    }
+  PL_LOCK(s_ResourceMutex);
 
-    {
-      PL_PROFILE_SCOPE("SortLoadingDeadlines");
-      ReverseBubbleSortStep(s_pState->m_LoadingQueue);
-    }
+  if (plResourceLoadingQueue::Contains(pResource))
+  {
+    s_pState->m_LoadingQueue.UpdatePriority(pResource, pResource->GetLoadingPriority(s_pState->m_LastFrameUpdate));
   }
 }
 
@@ -214,6 +180,36 @@ plResourceState plResourceManager::GetLoadingState(const plTypelessResourceHandl
   return hResource.m_pResource->GetLoadingState();
 }
 
+void plResourceManager::SetQualityLevelStreaming(const plTypelessResourceHandle& hResource, bool bEnable)
+{
+  PL_ASSERT_DEV(hResource.IsValid(), "Invalid resource handle");
+
+  PL_LOCK(s_ResourceMutex);
+
+  hResource.m_pResource->m_Flags.AddOrRemove(plResourceFlags::StreamQualityLevels, bEnable);
+}
+
+plResult plResourceManager::DiscardQualityLevel(const plTypelessResourceHandle& hResource)
+{
+  PL_ASSERT_DEV(hResource.IsValid(), "Invalid resource handle");
+
+  plResource* pResource = hResource.m_pResource;
+
+  PL_ASSERT_DEV(!pResource->GetBaseResourceFlags().IsSet(plResourceFlags::UpdateOnMainThread) || plThreadUtils::IsMainThread(), "Resource '{}' can only be modified on the main thread", pResource->GetResourceID());
+
+  PL_LOCK(s_ResourceMutex);
+
+  // a resource that is currently loaded by some thread must not be modified
+  if (IsQueuedForLoading(pResource))
+    return PL_FAILURE;
+
+  if (pResource->GetLoadingState() != plResourceState::Loaded || pResource->GetNumQualityLevelsDiscardable() <= 1)
+    return PL_FAILURE;
+
+  pResource->CallUnloadData(plResource::Unload::OneQualityLevel);
+  return PL_SUCCESS;
+}
+
 plResult plResourceManager::RemoveFromLoadingQueue(plResource* pResource)
 {
   PL_ASSERT_DEV(s_ResourceMutex.IsLocked(), "Resource mutex must be locked");
@@ -221,10 +217,7 @@ plResult plResourceManager::RemoveFromLoadingQueue(plResource* pResource)
   if (!IsQueuedForLoading(pResource))
     return PL_SUCCESS;
 
-  LoadingInfo li;
-  li.m_pResource = pResource;
-
-  if (s_pState->m_LoadingQueue.RemoveAndSwap(li))
+  if (s_pState->m_LoadingQueue.Remove(pResource))
   {
     pResource->m_Flags.Remove(plResourceFlags::IsQueuedForLoading);
     return PL_SUCCESS;
@@ -240,19 +233,14 @@ void plResourceManager::AddToLoadingQueue(plResource* pResource, bool bHighestPr
 
   pResource->m_Flags.Add(plResourceFlags::IsQueuedForLoading);
 
-  LoadingInfo li;
-  li.m_pResource = pResource;
-
   if (bHighestPriority)
   {
     pResource->SetPriority(plResourcePriority::Critical);
-    li.m_fPriority = 0.0f;
-    s_pState->m_LoadingQueue.PushFront(li);
+    s_pState->m_LoadingQueue.Insert(pResource, 0.0f);
   }
   else
   {
-    li.m_fPriority = pResource->GetLoadingPriority(s_pState->m_LastFrameUpdate);
-    s_pState->m_LoadingQueue.PushBack(li);
+    s_pState->m_LoadingQueue.Insert(pResource, pResource->GetLoadingPriority(s_pState->m_LastFrameUpdate));
   }
 }
 
@@ -285,10 +273,7 @@ bool plResourceManager::ReloadResource(plResource* pResource, bool bForce)
   {
     bAllowPreloading = false;
 
-    LoadingInfo li;
-    li.m_pResource = pResource;
-
-    if (s_pState->m_LoadingQueue.IndexOf(li) == plInvalidIndex)
+    if (!plResourceLoadingQueue::Contains(pResource))
     {
       // the resource is marked as 'loading' but it is not in the queue anymore
       // that means some task is already working on loading it
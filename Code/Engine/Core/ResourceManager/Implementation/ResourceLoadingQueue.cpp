@@ -0,0 +1,158 @@
+#include <Core/CorePCH.h>
+
+#include <Core/ResourceManager/Implementation/ResourceLoadingQueue.h>
+#include <Core/ResourceManager/Resource.h>
+
+plResourceLoadingQueue::plResourceLoadingQueue() = default;
+plResourceLoadingQueue::~plResourceLoadingQueue() = default;
+
+bool plResourceLoadingQueue::Contains(const plResource* pResource)
+{
+  return pResource->m_uiLoadingQueueIndex != plInvalidIndex;
+}
+
+void plResourceLoadingQueue::Insert(plResource* pResource, float fPriority)
+{
+  PL_ASSERT_DEV(!Contains(pResource), "Resource is already in the loading queue");
+
+  Entry entry;
+  entry.m_fPriority = fPriority;
+  entry.m_uiSequence = m_uiNextSequence++;
+  entry.m_pResource = pResource;
+
+  m_Heap.PushBack(entry);
+  pResource->m_uiLoadingQueueIndex = m_Heap.GetCount() - 1;
+
+  SiftUp(m_Heap.GetCount() - 1);
+}
+
+bool plResourceLoadingQueue::Remove(plResource* pResource)
+{
+  if (!Contains(pResource))
+    return false;
+
+  RemoveAt(pResource->m_uiLoadingQueueIndex);
+  return true;
+}
+
+plResource* plResourceLoadingQueue::PopFront()
+{
+  PL_ASSERT_DEV(!m_Heap.IsEmpty(), "The loading queue is empty");
+
+  plResource* pResource = m_Heap[0].m_pResource;
+  RemoveAt(0);
+  return pResource;
+}
+
+void plResourceLoadingQueue::UpdatePriority(plResource* pResource, float fPriority)
+{
+  PL_ASSERT_DEV(Contains(pResource), "Resource is not in the loading queue");
+
+  const plUInt32 uiIndex = pResource->m_uiLoadingQueueIndex;
+  const float fOldPriority = m_Heap[uiIndex].m_fPriority;
+
+  m_Heap[uiIndex].m_fPriority = fPriority;
+
+  if (fPriority < fOldPriority)
+    SiftUp(uiIndex);
+  else if (fPriority > fOldPriority)
+    SiftDown(uiIndex);
+}
+
+void plResourceLoadingQueue::UpdateAllPriorities(plTime now)
+{
+  for (Entry& entry : m_Heap)
+  {
+    entry.m_fPriority = entry.m_pResource->GetLoadingPriority(now);
+  }
+
+  // sifting down every inner node, starting with the last one, restores the heap property in linear time
+  for (plUInt32 i = m_Heap.GetCount() / 2; i > 0; --i)
+  {
+    SiftDown(i - 1);
+  }
+}
+
+void plResourceLoadingQueue::Clear()
+{
+  for (const Entry& entry : m_Heap)
+  {
+    entry.m_pResource->m_uiLoadingQueueIndex = plInvalidIndex;
+  }
+
+  m_Heap.Clear();
+}
+
+void plResourceLoadingQueue::RemoveAt(plUInt32 uiIndex)
+{
+  m_Heap[uiIndex].m_pResource->m_uiLoadingQueueIndex = plInvalidIndex;
+
+  const plUInt32 uiLastIndex = m_Heap.GetCount() - 1;
+
+  if (uiIndex != uiLastIndex)
+  {
+    const Entry last = m_Heap[uiLastIndex];
+    const bool bMoveUp = last < m_Heap[uiIndex];
+
+    m_Heap.PopBack();
+    Store(uiIndex, last);
+
+    if (bMoveUp)
+      SiftUp(uiIndex);
+    else
+      SiftDown(uiIndex);
+  }
+  else
+  {
+    m_Heap.PopBack();
+  }
+}
+
+void plResourceLoadingQueue::SiftUp(plUInt32 uiIndex)
+{
+  const Entry entry = m_Heap[uiIndex];
+
+  while (uiIndex > 0)
+  {
+    const plUInt32 uiParent = (uiIndex - 1) / 2;
+
+    if (!(entry < m_Heap[uiParent]))
+      break;
+
+    Store(uiIndex, m_Heap[uiParent]);
+    uiIndex = uiParent;
+  }
+
+  Store(uiIndex, entry);
+}
+
+void plResourceLoadingQueue::SiftDown(plUInt32 uiIndex)
+{
+  const plUInt32 uiCount = m_Heap.GetCount();
+  const Entry entry = m_Heap[uiIndex];
+
+  while (true)
+  {
+    const plUInt32 uiLeft = uiIndex * 2 + 1;
+
+    if (uiLeft >= uiCount)
+      break;
+
+    const plUInt32 uiRight = uiLeft + 1;
+    const plUInt32 uiChild = (uiRight < uiCount && m_Heap[uiRight] < m_Heap[uiLeft]) ? uiRight : uiLeft;
+
+    if (!(m_Heap[uiChild] < entry))
+      break;
+
+    Store(uiIndex, m_Heap[uiChild]);
+    uiIndex = uiChild;
+  }
+
+  Store(uiIndex, entry);
+}
+
+void plResourceLoadingQueue::Store(plUInt32 uiIndex, const Entry& entry)
+{
+  m_Heap[uiIndex] = entry;
+  entry.m_pResource->m_uiLoadingQueueIndex = uiIndex;
+}
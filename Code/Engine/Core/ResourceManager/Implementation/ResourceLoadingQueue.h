@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Core/CoreInternal.h>
+PL_CORE_INTERNAL_HEADER
+
+#include <Core/CoreDLL.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Time/Time.h>
+
+class plResource;
+
+/// \brief [internal] Priority queue of all resources that are waiting for a task to load them.
+///
+/// This is a binary min-heap over the loading priority (see plResource::GetLoadingPriority()), so the front is always the most urgent resource.
+/// Every queued resource stores its position in the heap, which makes looking it up O(1) and removing it or changing its priority O(log n).
+/// Resources with the same priority are dequeued most recently inserted first, since those are usually the ones that just came into view.
+///
+/// The queue is not thread-safe, all access has to be protected by plResourceManager::s_ResourceMutex.
+class plResourceLoadingQueue
+{
+public:
+  plResourceLoadingQueue();
+  ~plResourceLoadingQueue();
+
+  bool IsEmpty() const { return m_Heap.IsEmpty(); }
+  plUInt32 GetCount() const { return m_Heap.GetCount(); }
+
+  /// \brief Returns the resource at the given position of the heap. Only the resource at index 0 has a defined meaning, it is the front of the queue.
+  plResource* GetResource(plUInt32 uiIndex) const { return m_Heap[uiIndex].m_pResource; }
+
+  /// \brief Returns whether the resource is currently in this queue.
+  static bool Contains(const plResource* pResource);
+
+  void Insert(plResource* pResource, float fPriority);
+
+  /// \brief Removes the resource from the queue. Returns false, if it wasn't in the queue.
+  bool Remove(plResource* pResource);
+
+  /// \brief Removes and returns the resource with the lowest priority value.
+  plResource* PopFront();
+
+  /// \brief Changes the priority of a resource that is in the queue and moves it to its new position.
+  void UpdatePriority(plResource* pResource, float fPriority);
+
+  /// \brief Recomputes the priority of every queued resource and rebuilds the heap, which is O(n) instead of O(n log n) for updating them one by one.
+  void UpdateAllPriorities(plTime now);
+
+  void Clear();
+
+private:
+  struct Entry
+  {
+    float m_fPriority = 0.0f;
+    plUInt64 m_uiSequence = 0;
+    plResource* m_pResource = nullptr;
+
+    PL_ALWAYS_INLINE bool operator<(const Entry& rhs) const
+    {
+      if (m_fPriority != rhs.m_fPriority)
+        return m_fPriority < rhs.m_fPriority;
+
+      return m_uiSequence > rhs.m_uiSequence;
+    }
+  };
+
+  void RemoveAt(plUInt32 uiIndex);
+  void SiftUp(plUInt32 uiIndex);
+  void SiftDown(plUInt32 uiIndex);
+  void Store(plUInt32 uiIndex, const Entry& entry);
+
+  plDynamicArray<Entry> m_Heap;
+  plUInt64 m_uiNextSequence = 0;
+};
@@ -6,9 +6,9 @@
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Utilities/Stats.h>
 
 /// \todo Do not unload resources while they are acquired
-/// \todo Resource Type Memory Thresholds
 /// \todo Preload does not load all quality levels
 
 /// Infos to Display:
@@ -123,6 +123,12 @@ void plResourceManager::BroadcastResourceEvent(const plResourceEvent& e)
 
   // and then broadcast it to everyone else through the general event
   s_pState->m_ResourceEvents.Broadcast(e);
+
+  if (e.m_Type == plResourceEvent::Type::ResourceContentUpdated)
+  {
+    // new data may push another resource over its budget or make the evicted memory worth it again
+    s_pState->m_bMemoryBudgetsStalled = false;
+  }
 }
 
 void plResourceManager::RegisterResourceForAssetType(plStringView sAssetTypeName, const plRTTI* pResourceType)
@@ -316,6 +322,223 @@ void plResourceManager::SetAutoFreeUnused(plTime timeout, plTime lastAcquireThre
   s_pState->m_AutoFreeUnusedThreshold = lastAcquireThreshold;
 }
 
+void plResourceManager::SetMemoryBudget(plUInt64 uiMaxMemoryCPU, plUInt64 uiMaxMemoryGPU)
+{
+  PL_LOCK(s_ResourceMutex);
+
+  s_pState->m_uiMemoryBudgetCPU = uiMaxMemoryCPU;
+  s_pState->m_uiMemoryBudgetGPU = uiMaxMemoryGPU;
+
+  UpdateAnyMemoryBudget();
+}
+
+void plResourceManager::SetMemoryBudgetForResourceType(const plRTTI* pResourceType, plUInt64 uiMaxMemoryCPU, plUInt64 uiMaxMemoryGPU)
+{
+  PL_LOCK(s_ResourceMutex);
+
+  ResourceTypeInfo& info = GetResourceTypeInfo(pResourceType);
+  info.m_uiMemoryBudgetCPU = uiMaxMemoryCPU;
+  info.m_uiMemoryBudgetGPU = uiMaxMemoryGPU;
+
+  UpdateAnyMemoryBudget();
+}
+
+void plResourceManager::UpdateAnyMemoryBudget()
+{
+  bool bAnyBudget = s_pState->m_uiMemoryBudgetCPU > 0 || s_pState->m_uiMemoryBudgetGPU > 0;
+
+  for (auto it = s_pState->m_TypeInfo.GetIterator(); it.IsValid(); ++it)
+  {
+    bAnyBudget |= it.Value().m_uiMemoryBudgetCPU > 0 || it.Value().m_uiMemoryBudgetGPU > 0;
+  }
+
+  s_pState->m_bAnyMemoryBudget = bAnyBudget;
+  s_pState->m_bMemoryBudgetsStalled = false;
+}
+
+static PL_ALWAYS_INLINE bool IsOverMemoryBudget(plUInt64 uiMemoryCPU, plUInt64 uiMemoryGPU, plUInt64 uiBudgetCPU, plUInt64 uiBudgetGPU)
+{
+  return (uiBudgetCPU > 0 && uiMemoryCPU > uiBudgetCPU) || (uiBudgetGPU > 0 && uiMemoryGPU > uiBudgetGPU);
+}
+
+static void SetMemoryBudgetStats(plStringView sPrefix, plUInt64 uiMemoryCPU, plUInt64 uiMemoryGPU, plUInt64 uiBudgetCPU, plUInt64 uiBudgetGPU, double fPressureCPU, double fPressureGPU)
+{
+  const double fToMB = 1.0 / (1024.0 * 1024.0);
+
+  plStringBuilder sStatName;
+
+  sStatName.SetFormat("{}/Memory CPU (MB)", sPrefix);
+  plStats::SetStat(sStatName, uiMemoryCPU * fToMB);
+
+  sStatName.SetFormat("{}/Memory GPU (MB)", sPrefix);
+  plStats::SetStat(sStatName, uiMemoryGPU * fToMB);
+
+  if (uiBudgetCPU > 0)
+  {
+    sStatName.SetFormat("{}/Budget CPU (MB)", sPrefix);
+    plStats::SetStat(sStatName, uiBudgetCPU * fToMB);
+
+    sStatName.SetFormat("{}/Budget Pressure CPU", sPrefix);
+    plStats::SetStat(sStatName, fPressureCPU);
+  }
+
+  if (uiBudgetGPU > 0)
+  {
+    sStatName.SetFormat("{}/Budget GPU (MB)", sPrefix);
+    plStats::SetStat(sStatName, uiBudgetGPU * fToMB);
+
+    sStatName.SetFormat("{}/Budget Pressure GPU", sPrefix);
+    plStats::SetStat(sStatName, fPressureGPU);
+  }
+}
+
+void plResourceManager::EnforceMemoryBudgets(plTime tInUseSince)
+{
+  PL_LOCK(s_ResourceMutex);
+  PL_PROFILE_SCOPE("EnforceMemoryBudgets");
+
+  // the previous pass could not get below the budgets and nothing has been loaded since, so this one wouldn't either
+  if (s_pState->m_bMemoryBudgetsStalled)
+    return;
+
+  const plUInt64 uiFreedBefore = s_pState->m_uiBudgetEvictedResources + s_pState->m_uiBudgetDiscardedQualityLevels;
+  bool bStillOverBudget = false;
+
+  plUInt64 uiTotalMemoryCPU = 0;
+  plUInt64 uiTotalMemoryGPU = 0;
+
+  plDynamicArray<plResource*> candidates;
+  plStringBuilder sStatPrefix;
+
+  for (auto itType = s_pState->m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+  {
+    plUInt64 uiMemoryCPU = 0;
+    plUInt64 uiMemoryGPU = 0;
+
+    for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+    {
+      uiMemoryCPU += it.Value()->GetMemoryUsage().m_uiMemoryCPU;
+      uiMemoryGPU += it.Value()->GetMemoryUsage().m_uiMemoryGPU;
+    }
+
+    const ResourceTypeInfo& info = GetResourceTypeInfo(itType.Key());
+
+    if (info.m_uiMemoryBudgetCPU > 0 || info.m_uiMemoryBudgetGPU > 0)
+    {
+      const double fPressureCPU = info.m_uiMemoryBudgetCPU > 0 ? (double)uiMemoryCPU / info.m_uiMemoryBudgetCPU : 0.0;
+      const double fPressureGPU = info.m_uiMemoryBudgetGPU > 0 ? (double)uiMemoryGPU / info.m_uiMemoryBudgetGPU : 0.0;
+
+      if (IsOverMemoryBudget(uiMemoryCPU, uiMemoryGPU, info.m_uiMemoryBudgetCPU, info.m_uiMemoryBudgetGPU))
+      {
+        candidates.Clear();
+        for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+        {
+          candidates.PushBack(it.Value());
+        }
+
+        ReduceMemoryUsage(candidates, uiMemoryCPU, uiMemoryGPU, info.m_uiMemoryBudgetCPU, info.m_uiMemoryBudgetGPU, tInUseSince);
+
+        bStillOverBudget |= IsOverMemoryBudget(uiMemoryCPU, uiMemoryGPU, info.m_uiMemoryBudgetCPU, info.m_uiMemoryBudgetGPU);
+      }
+
+      sStatPrefix.SetFormat("Resource Manager/{}", itType.Key()->GetTypeName());
+      SetMemoryBudgetStats(sStatPrefix, uiMemoryCPU, uiMemoryGPU, info.m_uiMemoryBudgetCPU, info.m_uiMemoryBudgetGPU, fPressureCPU, fPressureGPU);
+    }
+
+    uiTotalMemoryCPU += uiMemoryCPU;
+    uiTotalMemoryGPU += uiMemoryGPU;
+  }
+
+  const plUInt64 uiBudgetCPU = s_pState->m_uiMemoryBudgetCPU;
+  const plUInt64 uiBudgetGPU = s_pState->m_uiMemoryBudgetGPU;
+  const double fPressureCPU = uiBudgetCPU > 0 ? (double)uiTotalMemoryCPU / uiBudgetCPU : 0.0;
+  const double fPressureGPU = uiBudgetGPU > 0 ? (double)uiTotalMemoryGPU / uiBudgetGPU : 0.0;
+
+  if (IsOverMemoryBudget(uiTotalMemoryCPU, uiTotalMemoryGPU, uiBudgetCPU, uiBudgetGPU))
+  {
+    candidates.Clear();
+    for (auto itType = s_pState->m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+    {
+      for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+      {
+        candidates.PushBack(it.Value());
+      }
+    }
+
+    ReduceMemoryUsage(candidates, uiTotalMemoryCPU, uiTotalMemoryGPU, uiBudgetCPU, uiBudgetGPU, tInUseSince);
+
+    bStillOverBudget |= IsOverMemoryBudget(uiTotalMemoryCPU, uiTotalMemoryGPU, uiBudgetCPU, uiBudgetGPU);
+  }
+
+  // if nothing could be evicted, everything that is left is in use or currently loading,
+  // repeating this every frame would only sort and walk all resources again for nothing
+  s_pState->m_bMemoryBudgetsStalled = bStillOverBudget && uiFreedBefore == s_pState->m_uiBudgetEvictedResources + s_pState->m_uiBudgetDiscardedQualityLevels;
+
+  SetMemoryBudgetStats("Resource Manager", uiTotalMemoryCPU, uiTotalMemoryGPU, uiBudgetCPU, uiBudgetGPU, fPressureCPU, fPressureGPU);
+  plStats::SetStat("Resource Manager/Budget Evicted Resources", s_pState->m_uiBudgetEvictedResources);
+  plStats::SetStat("Resource Manager/Budget Discarded Quality Levels", s_pState->m_uiBudgetDiscardedQualityLevels);
+}
+
+void plResourceManager::ReduceMemoryUsage(plDynamicArray<plResource*>& ref_candidates, plUInt64& inout_uiMemoryCPU, plUInt64& inout_uiMemoryGPU, plUInt64 uiBudgetCPU, plUInt64 uiBudgetGPU, plTime tInUseSince)
+{
+  // least recently used resources first
+  ref_candidates.Sort([](const plResource* pLhs, const plResource* pRhs)
+    { return pLhs->GetLastAcquireTime() < pRhs->GetLastAcquireTime(); });
+
+  auto Subtract = [&](const plResource::MemoryUsage& before, const plResource::MemoryUsage& after)
+  {
+    inout_uiMemoryCPU -= plMath::Min(inout_uiMemoryCPU, before.m_uiMemoryCPU - plMath::Min(before.m_uiMemoryCPU, after.m_uiMemoryCPU));
+    inout_uiMemoryGPU -= plMath::Min(inout_uiMemoryGPU, before.m_uiMemoryGPU - plMath::Min(before.m_uiMemoryGPU, after.m_uiMemoryGPU));
+  };
+
+  for (plResource* pResource : ref_candidates)
+  {
+    if (!IsOverMemoryBudget(inout_uiMemoryCPU, inout_uiMemoryGPU, uiBudgetCPU, uiBudgetGPU))
+      return;
+
+    // don't interfere with resources that are currently being loaded
+    if (IsQueuedForLoading(pResource))
+      continue;
+
+    const plResource::MemoryUsage memBefore = pResource->GetMemoryUsage();
+
+    if (pResource->GetReferenceCount() == 0 && GetResourceTypeInfo(pResource->GetDynamicRTTI()).m_bIncrementalUnload)
+    {
+      const plRTTI* pType = pResource->GetDynamicRTTI();
+      const plTempHashedString sResourceID(pResource->GetResourceID());
+
+      if (DeallocateResource(pResource).Succeeded())
+      {
+        s_pState->m_LoadedResources[pType].m_Resources.Remove(sResourceID);
+        Subtract(memBefore, plResource::MemoryUsage());
+
+        ++s_pState->m_uiBudgetEvictedResources;
+      }
+
+      continue;
+    }
+
+    // resources that are still in use keep their data
+    if (pResource->GetLastAcquireTime() >= tInUseSince)
+      continue;
+
+    // referenced resources always keep one quality level, same as in DiscardQualityLevel(),
+    // otherwise they would have to be reloaded as soon as they are used again
+    const plUInt32 uiMinQualityLevels = pResource->GetReferenceCount() > 0 ? 1 : 0;
+
+    while (pResource->GetNumQualityLevelsDiscardable() > uiMinQualityLevels && IsOverMemoryBudget(inout_uiMemoryCPU, inout_uiMemoryGPU, uiBudgetCPU, uiBudgetGPU))
+    {
+      const plResource::MemoryUsage memBeforeDiscard = pResource->GetMemoryUsage();
+
+      pResource->CallUnloadData(plResource::Unload::OneQualityLevel);
+
+      Subtract(memBeforeDiscard, pResource->GetMemoryUsage());
+
+      ++s_pState->m_uiBudgetDiscardedQualityLevels;
+    }
+  }
+}
+
 void plResourceManager::AllowResourceTypeAcquireDuringUpdateContent(const plRTTI* pTypeBeingUpdated, const plRTTI* pTypeItWantsToAcquire)
 {
   auto& info = s_pState->m_TypeInfo[pTypeBeingUpdated];
@@ -435,6 +658,7 @@ void plResourceManager::PerFrameUpdate()
 {
   PL_PROFILE_SCOPE("plResourceManagerUpdate");
 
+  const plTime tPreviousFrameUpdate = s_pState->m_LastFrameUpdate;
   s_pState->m_LastFrameUpdate = plTime::Now();
 
   if (s_pState->m_bBroadcastExistsEvent)
@@ -491,6 +715,12 @@ void plResourceManager::PerFrameUpdate()
   {
     FreeUnusedResources(s_pState->m_AutoFreeUnusedTimeout, s_pState->m_AutoFreeUnusedThreshold);
   }
+
+  if (s_pState->m_bAnyMemoryBudget)
+  {
+    // everything that was acquired since the last update is considered to be in use
+    EnforceMemoryBudgets(tPreviousFrameUpdate);
+  }
 }
 
 const plEvent<const plResourceEvent&, plMutex>& plResourceManager::GetResourceEvents()
@@ -564,9 +794,9 @@ void plResourceManager::EngineAboutToShutdown()
   {
     PL_LOCK(s_ResourceMutex);
 
-    for (auto entry : s_pState->m_LoadingQueue)
+    for (plUInt32 i = 0; i < s_pState->m_LoadingQueue.GetCount(); ++i)
     {
-      entry.m_pResource->m_Flags.Remove(plResourceFlags::IsQueuedForLoading);
+      s_pState->m_LoadingQueue.GetResource(i)->m_Flags.Remove(plResourceFlags::IsQueuedForLoading);
     }
 
     s_pState->m_LoadingQueue.Clear();
@@ -3,6 +3,7 @@
 #include <Core/CoreInternal.h>
 PL_CORE_INTERNAL_HEADER
 
+#include <Core/ResourceManager/Implementation/ResourceLoadingQueue.h>
 #include <Core/ResourceManager/ResourceManager.h>
 
 class plResourceManagerState
@@ -51,7 +52,7 @@ private:
   plUInt32 m_uiForceNoFallbackAcquisition = 0;
 
   // resources in this queue are waiting for a task to load them
-  plDeque<plResourceManager::LoadingInfo> m_LoadingQueue;
+  plResourceLoadingQueue m_LoadingQueue;
 
   plHashTable<const plRTTI*, plResourceManager::LoadedResources> m_LoadedResources;
 
@@ -62,7 +63,7 @@ private:
   plHybridArray<TaskDataDataLoad, 8> m_WorkerTasksDataLoad;
 
   plTime m_LastFrameUpdate;
-  plUInt32 m_uiLastResourcePriorityUpdateIdx = 0;
+  plTime m_LastLoadingDeadlinesUpdate;
 
   plDynamicArray<plResource*> m_LoadedResourceOfTypeTempContainer;
   plHashTable<plTempHashedString, const plRTTI*> m_ResourcesToUnloadOnMainThread;
@@ -101,5 +102,13 @@ private:
   plTime m_AutoFreeUnusedTimeout = plTime::MakeZero();
   plTime m_AutoFreeUnusedThreshold = plTime::MakeZero();
 
+  // Memory budgets, zero means unlimited
+  plUInt64 m_uiMemoryBudgetCPU = 0;
+  plUInt64 m_uiMemoryBudgetGPU = 0;
+  bool m_bAnyMemoryBudget = false;
+  bool m_bMemoryBudgetsStalled = false; ///< The last pass was over budget and could not free anything, nothing changes until a resource is loaded or a budget is modified
+  plUInt64 m_uiBudgetEvictedResources = 0;
+  plUInt64 m_uiBudgetDiscardedQualityLevels = 0;
+
   plMap<const plRTTI*, plResourceManager::ResourceTypeInfo> m_TypeInfo;
 };
@@ -189,7 +189,8 @@ ResourceType* plResourceManager::BeginAcquireResource(const plTypedResourceHandl
       // as long as there are more quality levels available, schedule the resource for more loading
       // accessing IsQueuedForLoading without a lock here is save because InternalPreloadResource() will lock and early out if necessary
       // and accidentally skipping InternalPreloadResource() is no problem
-      if (IsQueuedForLoading(pResource) == false && pResource->GetNumQualityLevelsLoadable() > 0)
+      // resources with quality level streaming only get more quality levels when the streaming system requests them
+      if (IsQueuedForLoading(pResource) == false && pResource->GetNumQualityLevelsLoadable() > 0 && !pResource->GetBaseResourceFlags().IsSet(plResourceFlags::StreamQualityLevels))
         InternalPreloadResource(pResource, false);
     }
   }
@@ -8,11 +8,44 @@
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Profiling/Profiling.h>
 
-struct FileResourceLoadData
+namespace
 {
-  plBlob m_Storage;
-  plRawMemoryStreamReader m_Reader;
-};
+  /// \brief Reads the header from one memory block and the file content from another one, without combining them first.
+  class FileResourceMappedReader : public plStreamReader
+  {
+  public:
+    virtual plUInt64 ReadBytes(void* pReadBuffer, plUInt64 uiBytesToRead) override
+    {
+      const plUInt64 uiHeaderBytes = m_Header.ReadBytes(pReadBuffer, uiBytesToRead);
+
+      if (uiHeaderBytes == uiBytesToRead)
+        return uiHeaderBytes;
+
+      void* pContentBuffer = pReadBuffer != nullptr ? plMemoryUtils::AddByteOffset(pReadBuffer, static_cast<std::ptrdiff_t>(uiHeaderBytes)) : nullptr;
+      return uiHeaderBytes + m_Content.ReadBytes(pContentBuffer, uiBytesToRead - uiHeaderBytes);
+    }
+
+    virtual plUInt64 SkipBytes(plUInt64 uiBytesToSkip) override
+    {
+      const plUInt64 uiHeaderBytes = m_Header.SkipBytes(uiBytesToSkip);
+      return uiHeaderBytes + m_Content.SkipBytes(uiBytesToSkip - uiHeaderBytes);
+    }
+
+    plRawMemoryStreamReader m_Header;
+    plRawMemoryStreamReader m_Content;
+  };
+
+  struct FileResourceLoadData
+  {
+    plBlob m_Storage;
+    plRawMemoryStreamReader m_Reader;
+
+    // if the file content is mapped into memory (e.g. uncompressed archive entries), the file stays open until the data stream is closed
+    // and only the header is stored in m_Storage
+    plFileReader m_File;
+    FileResourceMappedReader m_MappedReader;
+  };
+} // namespace
 
 plResourceLoadData plResourceLoaderFromFile::OpenDataStream(const plResource* pResource)
 {
@@ -20,9 +53,14 @@ plResourceLoadData plResourceLoaderFromFile::OpenDataStream(const plResource* pR
 
   plResourceLoadData res;
 
-  plFileReader File;
+  FileResourceLoadData* pData = PL_DEFAULT_NEW(FileResourceLoadData);
+
+  plFileReader& File = pData->m_File;
   if (File.Open(pResource->GetResourceID().GetData()).Failed())
+  {
+    PL_DEFAULT_DELETE(pData);
     return res;
+  }
 
   res.m_sResourceDescription = File.GetFilePathRelative().GetData();
 
@@ -35,7 +73,26 @@ plResourceLoadData plResourceLoaderFromFile::OpenDataStream(const plResource* pR
 
 #endif
 
-  FileResourceLoadData* pData = PL_DEFAULT_NEW(FileResourceLoadData);
+  const plArrayPtr<const plUInt8> mappedContent = File.GetMappedFileContent();
+
+  if (!mappedContent.IsEmpty())
+  {
+    const plUInt64 uiHeaderCapacity = File.GetFilePathAbsolute().GetElementCount() + 8; // +8 for the string overhead
+    pData->m_Storage.SetCountUninitialized(uiHeaderCapacity);
+
+    plUInt8* pHeaderPtr = pData->m_Storage.GetBlobPtr<plUInt8>().GetPtr();
+
+    // write the absolute path to the read file into the header, the file content is then read directly from the mapped memory
+    plRawMemoryStreamWriter w(pHeaderPtr, uiHeaderCapacity);
+    w << File.GetFilePathAbsolute();
+
+    pData->m_MappedReader.m_Header.Reset(pHeaderPtr, w.GetNumWrittenBytes());
+    pData->m_MappedReader.m_Content.Reset(mappedContent.GetPtr(), mappedContent.GetCount());
+    res.m_pDataStream = &pData->m_MappedReader;
+    res.m_pCustomLoaderData = pData;
+
+    return res;
+  }
 
   const plUInt64 uiFileSize = File.GetFileSize();
 
@@ -52,6 +109,7 @@ plResourceLoadData plResourceLoaderFromFile::OpenDataStream(const plResource* pR
   const plUInt64 uiOffset = w.GetNumWrittenBytes();
 
   File.ReadBytes(pBlobPtr + uiOffset, uiFileSize);
+  File.Close();
 
   pData->m_Reader.Reset(pBlobPtr, w.GetNumWrittenBytes() + uiFileSize);
   res.m_pDataStream = &pData->m_Reader;
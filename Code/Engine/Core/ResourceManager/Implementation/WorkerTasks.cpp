@@ -27,9 +27,7 @@ void plResourceManagerWorkerDataLoad::Execute()
 
     plResourceManager::UpdateLoadingDeadlines();
 
-    auto it = plResourceManager::s_pState->m_LoadingQueue.PeekFront();
-    pResourceToLoad = it.m_pResource;
-    plResourceManager::s_pState->m_LoadingQueue.PopFront();
+    pResourceToLoad = plResourceManager::s_pState->m_LoadingQueue.PopFront();
 
     if (pResourceToLoad->m_Flags.IsSet(plResourceFlags::HasCustomDataLoader))
     {
@@ -120,9 +118,10 @@ void plResourceManagerWorkerUpdateContent::Execute()
 
   m_pResourceToLoad->CallUpdateContent(m_LoaderData.m_pDataStream);
 
-  if (m_pResourceToLoad->m_uiQualityLevelsLoadable > 0)
+  if (m_pResourceToLoad->m_uiQualityLevelsLoadable > 0 && !m_pResourceToLoad->m_Flags.IsSet(plResourceFlags::StreamQualityLevels))
   {
     // if the resource can have more details loaded, put it into the preload queue right away again
+    // with quality level streaming enabled, every request only loads one quality level
     plResourceManager::PreloadResource(m_pResourceToLoad);
   }
 
@@ -140,6 +140,7 @@ private:
   friend class plResourceManager;
   friend class plResourceManagerWorkerDataLoad;
   friend class plResourceManagerWorkerUpdateContent;
+  friend class plResourceLoadingQueue;
 
   /// \brief Called by plResourceManager shortly after resource creation.
   void SetUniqueID(plStringView sUniqueID, bool bIsReloadable);
@@ -173,6 +174,9 @@ private:
   plUInt8 m_uiQualityLevelsDiscardable = 0;
   plUInt8 m_uiQualityLevelsLoadable = 0;
 
+  /// \brief Position in the plResourceLoadingQueue, plInvalidIndex if the resource is not in the queue.
+  plUInt32 m_uiLoadingQueueIndex = plInvalidIndex;
+
 
 protected:
   /// \brief Non-const version for resources that want to write this variable directly.
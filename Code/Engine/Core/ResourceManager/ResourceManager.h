@@ -125,6 +125,18 @@ public:
   /// \brief Returns the current loading state of the given resource.
   static plResourceState GetLoadingState(const plTypelessResourceHandle& hResource);
 
+  /// \brief Specifies whether some streaming system decides how many quality levels of the given resource are loaded.
+  ///
+  /// By default every acquire of a loaded resource queues it for loading more quality levels, until the highest quality is reached.
+  /// When quality level streaming is enabled, this doesn't happen anymore. Instead every call to PreloadResource() loads exactly one more
+  /// quality level and DiscardQualityLevel() can be used to reduce the quality again.
+  static void SetQualityLevelStreaming(const plTypelessResourceHandle& hResource, bool bEnable);
+
+  /// \brief Unloads the highest loaded quality level of the given resource, but never the last one.
+  ///
+  /// Fails if the resource has only one quality level loaded or is currently queued for loading.
+  static plResult DiscardQualityLevel(const plTypelessResourceHandle& hResource);
+
   ///@}
   /// \name Reloading resources
   ///@{
@@ -226,6 +238,26 @@ public:
   template <typename ResourceType>
   static void SetIncrementalUnloadForResourceType(bool bActive);
 
+  /// \brief Sets how much memory (in bytes) all resources together may use. Zero means unlimited, which is the default.
+  ///
+  /// Once per frame the resource manager sums up the memory usage that the resources report (see plResource::GetMemoryUsage()).
+  /// If a budget is exceeded, it goes through the resources from least to most recently acquired. Resources that aren't referenced anymore
+  /// are unloaded (unless incremental unloading is disabled for their type), resources that weren't acquired during the last frame
+  /// discard quality levels, until the memory usage is within the budget again.
+  /// If such a pass can't free anything, the following ones are skipped until a resource is loaded or a budget is changed.
+  ///
+  /// The memory usage and budget pressure are reported through plStats under 'Resource Manager'.
+  static void SetMemoryBudget(plUInt64 uiMaxMemoryCPU, plUInt64 uiMaxMemoryGPU);
+
+  /// \brief Sets how much memory (in bytes) all resources of the given type may use. Zero means unlimited. See SetMemoryBudget().
+  template <typename ResourceType>
+  static void SetMemoryBudgetForResourceType(plUInt64 uiMaxMemoryCPU, plUInt64 uiMaxMemoryGPU)
+  {
+    SetMemoryBudgetForResourceType(plGetStaticRTTI<ResourceType>(), uiMaxMemoryCPU, uiMaxMemoryGPU);
+  }
+
+  static void SetMemoryBudgetForResourceType(const plRTTI* pResourceType, plUInt64 uiMaxMemoryCPU, plUInt64 uiMaxMemoryGPU);
+
   template <typename TypeBeingUpdated, typename TypeItWantsToAcquire>
   static void AllowResourceTypeAcquireDuringUpdateContent()
   {
@@ -238,6 +270,9 @@ public:
 
 private:
   static plResult DeallocateResource(plResource* pResource);
+  static void UpdateAnyMemoryBudget();
+  static void EnforceMemoryBudgets(plTime tInUseSince);
+  static void ReduceMemoryUsage(plDynamicArray<plResource*>& ref_candidates, plUInt64& inout_uiMemoryCPU, plUInt64& inout_uiMemoryGPU, plUInt64 uiBudgetCPU, plUInt64 uiBudgetGPU, plTime tInUseSince);
 
   ///@}
   /// \name Miscellaneous
@@ -454,14 +489,6 @@ private:
     plHashTable<plTempHashedString, plResource*> m_Resources;
   };
 
-  struct LoadingInfo
-  {
-    float m_fPriority = 0;
-    plResource* m_pResource = nullptr;
-
-    PL_ALWAYS_INLINE bool operator==(const LoadingInfo& rhs) const { return m_pResource == rhs.m_pResource; }
-    PL_ALWAYS_INLINE bool operator<(const LoadingInfo& rhs) const { return m_fPriority < rhs.m_fPriority; }
-  };
   static void EnsureResourceLoadingState(plResource* pResource, const plResourceState RequestedState);
   static void PreloadResource(plResource* pResource);
   static void InternalPreloadResource(plResource* pResource, bool bHighestPriority);
@@ -471,7 +498,7 @@ private:
   static plResource* GetResource(const plRTTI* pRtti, plStringView sResourceID, bool bIsReloadable);
   static void RunWorkerTask(plResource* pResource);
   static void UpdateLoadingDeadlines();
-  static void ReverseBubbleSortStep(plDeque<LoadingInfo>& data);
+  static void UpdateLoadingPriority(plResource* pResource);
   static bool ReloadResource(plResource* pResource, bool bForce);
 
   static void SetupWorkerTasks();
@@ -487,6 +514,8 @@ private:
   {
     bool m_bIncrementalUnload = true;
     bool m_bAllowNestedAcquireCached = false;
+    plUInt64 m_uiMemoryBudgetCPU = 0;
+    plUInt64 m_uiMemoryBudgetGPU = 0;
 
     plHybridArray<const plRTTI*, 8> m_NestedTypes;
   };
@@ -55,6 +55,8 @@ public:
 ///
 /// The loader will interpret the plResource 'resource ID' as a path, read that full file into a memory stream.
 /// The file modification data is stored as well.
+/// If the file system provides the file content directly (e.g. for uncompressed entries in archive data directories), it is not copied,
+/// but read from that memory, and the file is kept open until the data stream gets closed.
 /// Resources that use this loader can update their data as if they were reading the file directly.
 class PL_CORE_DLL plResourceLoaderFromFile : public plResourceTypeLoader
 {
@@ -601,6 +601,9 @@ private:
     void UpdateGlobalBounds();
     void UpdateGlobalBoundsAndSpatialData(plSpatialSystem& ref_spatialSystem);
 
+    /// \brief Updates the global bounds and returns whether the spatial data has to be updated with the new bounds.
+    bool UpdateGlobalBoundsAndCheckSpatialData();
+
     void UpdateLastGlobalTransform(plUInt32 uiUpdateCounter);
 
     void RecreateSpatialData(plSpatialSystem& ref_spatialSystem);
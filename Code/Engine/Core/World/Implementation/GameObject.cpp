@@ -1183,12 +1183,7 @@ void plGameObject::TransformationData::UpdateGlobalBounds(plSpatialSystem* pSpat
 
 void plGameObject::TransformationData::UpdateGlobalBoundsAndSpatialData(plSpatialSystem& ref_spatialSystem)
 {
-  plSimdBBoxSphere oldGlobalBounds = m_globalBounds;
-
-  UpdateGlobalBounds();
-
-  const bool bIsAlwaysVisible = m_localBounds.m_BoxHalfExtents.w() != plSimdFloat::MakeZero();
-  if (m_hSpatialData.IsInvalidated() == false && bIsAlwaysVisible == false && m_globalBounds != oldGlobalBounds)
+  if (UpdateGlobalBoundsAndCheckSpatialData())
   {
     ref_spatialSystem.UpdateSpatialDataBounds(m_hSpatialData, m_globalBounds);
   }
@@ -595,6 +595,16 @@ PL_FORCE_INLINE void plGameObject::TransformationData::UpdateGlobalBounds()
   m_globalBounds.Transform(m_globalTransform);
 }
 
+PL_FORCE_INLINE bool plGameObject::TransformationData::UpdateGlobalBoundsAndCheckSpatialData()
+{
+  const plSimdBBoxSphere oldGlobalBounds = m_globalBounds;
+
+  UpdateGlobalBounds();
+
+  const bool bIsAlwaysVisible = m_localBounds.m_BoxHalfExtents.w() != plSimdFloat::MakeZero();
+  return m_hSpatialData.IsInvalidated() == false && bIsAlwaysVisible == false && m_globalBounds != oldGlobalBounds;
+}
+
 PL_ALWAYS_INLINE void plGameObject::TransformationData::UpdateLastGlobalTransform(plUInt32 uiUpdateCounter)
 {
 #if PL_ENABLED(PL_GAMEOBJECT_VELOCITY)
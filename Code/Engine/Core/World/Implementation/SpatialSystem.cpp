@@ -19,6 +19,14 @@ void plSpatialSystem::StartNewFrame()
   ++m_uiFrameCounter;
 }
 
+void plSpatialSystem::UpdateSpatialDataBoundsBatch(plArrayPtr<const BoundsUpdate> updates)
+{
+  for (const BoundsUpdate& update : updates)
+  {
+    UpdateSpatialDataBounds(update.m_hData, update.m_Bounds);
+  }
+}
+
 void plSpatialSystem::FindObjectsInSphere(const plBoundingSphere& sphere, const QueryParams& queryParams, plDynamicArray<plGameObject*>& out_objects) const
 {
   out_objects.Clear();
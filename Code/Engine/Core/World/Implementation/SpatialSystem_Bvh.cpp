@@ -0,0 +1,930 @@
+#include <Core/CorePCH.h>
+
+#include <Core/World/SpatialSystem_Bvh.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  struct BvhPlaneData
+  {
+    plSimdVec4f m_x0x1x2x3;
+    plSimdVec4f m_y0y1y2y3;
+    plSimdVec4f m_z0z1z2z3;
+    plSimdVec4f m_w0w1w2w3;
+
+    plSimdVec4f m_x4x5x4x5;
+    plSimdVec4f m_y4y5y4y5;
+    plSimdVec4f m_z4z5z4z5;
+    plSimdVec4f m_w4w5w4w5;
+
+    // absolute values of the plane normals, used to project box extents onto the normals
+    plSimdVec4f m_absX0X1X2X3;
+    plSimdVec4f m_absY0Y1Y2Y3;
+    plSimdVec4f m_absZ0Z1Z2Z3;
+
+    plSimdVec4f m_absX4X5X4X5;
+    plSimdVec4f m_absY4Y5Y4Y5;
+    plSimdVec4f m_absZ4Z5Z4Z5;
+  };
+
+  struct FrustumQueryData
+  {
+    BvhPlaneData m_PlaneData;
+    plDynamicArray<const plGameObject*>* m_pOutObjects;
+    plUInt64 m_uiFrameIdxAndType;
+    plSpatialSystem::IsOccludedFunc m_IsOccludedCB;
+  };
+
+  enum class BvhFrustumResult
+  {
+    Outside,
+    Intersecting,
+    Inside
+  };
+
+  PL_FORCE_INLINE BvhFrustumResult BoxFrustumIntersect(const plSimdBBox& box, const BvhPlaneData& planeData)
+  {
+    const plSimdVec4f center = box.GetCenter();
+    const plSimdVec4f halfExtents = box.GetHalfExtents();
+
+    const plSimdVec4f pos_xxxx(center.x());
+    const plSimdVec4f pos_yyyy(center.y());
+    const plSimdVec4f pos_zzzz(center.z());
+
+    const plSimdVec4f ext_xxxx(halfExtents.x());
+    const plSimdVec4f ext_yyyy(halfExtents.y());
+    const plSimdVec4f ext_zzzz(halfExtents.z());
+
+    plSimdVec4f dot_0123;
+    dot_0123 = plSimdVec4f::MulAdd(pos_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
+    dot_0123 = plSimdVec4f::MulAdd(pos_yyyy, planeData.m_y0y1y2y3, dot_0123);
+    dot_0123 = plSimdVec4f::MulAdd(pos_zzzz, planeData.m_z0z1z2z3, dot_0123);
+
+    plSimdVec4f dot_4545;
+    dot_4545 = plSimdVec4f::MulAdd(pos_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
+    dot_4545 = plSimdVec4f::MulAdd(pos_yyyy, planeData.m_y4y5y4y5, dot_4545);
+    dot_4545 = plSimdVec4f::MulAdd(pos_zzzz, planeData.m_z4z5z4z5, dot_4545);
+
+    plSimdVec4f radius_0123 = ext_xxxx.CompMul(planeData.m_absX0X1X2X3);
+    radius_0123 = plSimdVec4f::MulAdd(ext_yyyy, planeData.m_absY0Y1Y2Y3, radius_0123);
+    radius_0123 = plSimdVec4f::MulAdd(ext_zzzz, planeData.m_absZ0Z1Z2Z3, radius_0123);
+
+    plSimdVec4f radius_4545 = ext_xxxx.CompMul(planeData.m_absX4X5X4X5);
+    radius_4545 = plSimdVec4f::MulAdd(ext_yyyy, planeData.m_absY4Y5Y4Y5, radius_4545);
+    radius_4545 = plSimdVec4f::MulAdd(ext_zzzz, planeData.m_absZ4Z5Z4Z5, radius_4545);
+
+    if ((dot_0123 > radius_0123 || dot_4545 > radius_4545).AnySet<4>())
+      return BvhFrustumResult::Outside;
+
+    if ((dot_0123 < -radius_0123 && dot_4545 < -radius_4545).AllSet<4>())
+      return BvhFrustumResult::Inside;
+
+    return BvhFrustumResult::Intersecting;
+  }
+
+  PL_FORCE_INLINE bool SphereFrustumIntersect(const plSimdBSphere& sphere, const BvhPlaneData& planeData)
+  {
+    plSimdVec4f pos_xxxx(sphere.m_CenterAndRadius.x());
+    plSimdVec4f pos_yyyy(sphere.m_CenterAndRadius.y());
+    plSimdVec4f pos_zzzz(sphere.m_CenterAndRadius.z());
+    plSimdVec4f pos_rrrr(sphere.m_CenterAndRadius.w());
+
+    plSimdVec4f dot_0123;
+    dot_0123 = plSimdVec4f::MulAdd(pos_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
+    dot_0123 = plSimdVec4f::MulAdd(pos_yyyy, planeData.m_y0y1y2y3, dot_0123);
+    dot_0123 = plSimdVec4f::MulAdd(pos_zzzz, planeData.m_z0z1z2z3, dot_0123);
+
+    plSimdVec4f dot_4545;
+    dot_4545 = plSimdVec4f::MulAdd(pos_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
+    dot_4545 = plSimdVec4f::MulAdd(pos_yyyy, planeData.m_y4y5y4y5, dot_4545);
+    dot_4545 = plSimdVec4f::MulAdd(pos_zzzz, planeData.m_z4z5z4z5, dot_4545);
+
+    plSimdVec4b cmp_0123 = dot_0123 > pos_rrrr;
+    plSimdVec4b cmp_4545 = dot_4545 > pos_rrrr;
+    return (cmp_0123 || cmp_4545).NoneSet<4>();
+  }
+
+  PL_ALWAYS_INLINE bool FilterByTagsBvh(const plTagSet& tags, const plTagSet* pIncludeTags, const plTagSet* pExcludeTags)
+  {
+    if (pExcludeTags != nullptr && !pExcludeTags->IsEmpty() && pExcludeTags->IsAnySet(tags))
+      return true;
+
+    if (pIncludeTags != nullptr && !pIncludeTags->IsEmpty() && !pIncludeTags->IsAnySet(tags))
+      return true;
+
+    return false;
+  }
+
+  PL_ALWAYS_INLINE float GetSurfaceArea(const plSimdBBox& box)
+  {
+    // half the surface area is sufficient to compare costs
+    const plSimdVec4f extents = box.GetExtents();
+    return extents.CompMul(extents.Get<plSwizzle::YZXX>()).HorizontalSum<3>();
+  }
+
+  PL_ALWAYS_INLINE plSimdBBox GetUnion(const plSimdBBox& a, const plSimdBBox& b)
+  {
+    return plSimdBBox(a.m_Min.CompMin(b.m_Min), a.m_Max.CompMax(b.m_Max));
+  }
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace plInternal
+{
+  struct BvhQueryHelper
+  {
+    struct Stats
+    {
+      plUInt32 m_uiNumObjectsTested = 0;
+      plUInt32 m_uiNumObjectsPassed = 0;
+    };
+
+    using NodeStack = plHybridArray<plUInt32, 64>;
+
+    PL_ALWAYS_INLINE static bool UseTagsFilter(const plSpatialSystem::QueryParams& queryParams)
+    {
+      return (queryParams.m_pIncludeTags && queryParams.m_pIncludeTags->IsEmpty() == false) || (queryParams.m_pExcludeTags && queryParams.m_pExcludeTags->IsEmpty() == false);
+    }
+
+    template <typename T, bool UseTagsFilter>
+    static void ShapeQuery(const plSpatialSystem_Bvh& system, const T& shape, const plSpatialSystem::QueryParams& queryParams, const plSpatialSystem::QueryCallback& callback, Stats& ref_stats)
+    {
+      const plUInt32 uiCategoryBitmask = queryParams.m_uiCategoryBitmask;
+
+      // always visible data overlaps every shape
+      for (plUInt32 uiDataIndex : system.m_AlwaysVisibleData)
+      {
+        if ((system.m_DataTable.GetValueUnchecked(uiDataIndex).m_uiCategoryBitmask & uiCategoryBitmask) == 0)
+          continue;
+
+        ref_stats.m_uiNumObjectsTested++;
+
+        if constexpr (UseTagsFilter)
+        {
+          if (FilterByTagsBvh(system.m_TagSets[uiDataIndex], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+            continue;
+        }
+
+        ref_stats.m_uiNumObjectsPassed++;
+
+        if (callback(system.m_ObjectPointers[uiDataIndex]) == plVisitorExecution::Stop)
+          return;
+      }
+
+      if (system.m_uiRootNode == plInvalidIndex)
+        return;
+
+      const plSpatialSystem_Bvh::Node* pNodes = system.m_Nodes.GetData();
+      const plSimdBSphere* pBoundingSpheres = system.m_BoundingSpheres.GetData();
+      const plSimdVec4f* pBoundingBoxHalfExtents = system.m_BoundingBoxHalfExtents.GetData();
+
+      NodeStack stack;
+      stack.PushBack(system.m_uiRootNode);
+
+      while (!stack.IsEmpty())
+      {
+        const plSpatialSystem_Bvh::Node& node = pNodes[stack.PeekBack()];
+        stack.PopBack();
+
+        if ((node.m_uiCategoryBitmask & uiCategoryBitmask) == 0 || !node.m_Box.Overlaps(shape))
+          continue;
+
+        if (!node.IsLeaf())
+        {
+          stack.PushBack(node.m_uiChildren[1]);
+          stack.PushBack(node.m_uiChildren[0]);
+          continue;
+        }
+
+        const plUInt32 uiDataIndex = node.m_uiDataIndex;
+        ref_stats.m_uiNumObjectsTested++;
+
+        // leaf boxes may be enlarged, so the object box has to be tested as well
+        const plSimdBSphere& objectSphere = pBoundingSpheres[uiDataIndex];
+        if (!shape.Overlaps(objectSphere) || !plSimdBBox::MakeFromCenterAndHalfExtents(objectSphere.GetCenter(), pBoundingBoxHalfExtents[uiDataIndex]).Overlaps(shape))
+          continue;
+
+        if constexpr (UseTagsFilter)
+        {
+          if (FilterByTagsBvh(system.m_TagSets[uiDataIndex], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+            continue;
+        }
+
+        ref_stats.m_uiNumObjectsPassed++;
+
+        if (callback(system.m_ObjectPointers[uiDataIndex]) == plVisitorExecution::Stop)
+          return;
+      }
+    }
+
+    template <bool UseTagsFilter, bool UseOcclusionCallback>
+    static void FrustumQuery(const plSpatialSystem_Bvh& system, const FrustumQueryData& queryData, const plSpatialSystem::QueryParams& queryParams, Stats& ref_stats)
+    {
+      const plUInt32 uiCategoryBitmask = queryParams.m_uiCategoryBitmask;
+
+      for (plUInt32 uiDataIndex : system.m_AlwaysVisibleData)
+      {
+        if ((system.m_DataTable.GetValueUnchecked(uiDataIndex).m_uiCategoryBitmask & uiCategoryBitmask) == 0)
+          continue;
+
+        ref_stats.m_uiNumObjectsTested++;
+
+        if constexpr (UseTagsFilter)
+        {
+          if (FilterByTagsBvh(system.m_TagSets[uiDataIndex], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+            continue;
+        }
+
+        queryData.m_pOutObjects->PushBack(system.m_ObjectPointers[uiDataIndex]);
+        ref_stats.m_uiNumObjectsPassed++;
+      }
+
+      if (system.m_uiRootNode == plInvalidIndex)
+        return;
+
+      const BvhPlaneData& planeData = queryData.m_PlaneData;
+      const plSpatialSystem_Bvh::Node* pNodes = system.m_Nodes.GetData();
+      const plSimdBSphere* pBoundingSpheres = system.m_BoundingSpheres.GetData();
+      const plSimdVec4f* pBoundingBoxHalfExtents = system.m_BoundingBoxHalfExtents.GetData();
+      plAtomicInteger64* pLastVisibleFrameIdxAndVisType = system.m_LastVisibleFrameIdxAndVisType.GetData();
+
+      auto AddVisibleObject = [&](plUInt32 uiDataIndex) {
+        pLastVisibleFrameIdxAndVisType[uiDataIndex].Max(queryData.m_uiFrameIdxAndType);
+        queryData.m_pOutObjects->PushBack(system.m_ObjectPointers[uiDataIndex]);
+
+        ref_stats.m_uiNumObjectsPassed++;
+      };
+
+      plSimdBBox batchBoxes[plSpatialSystem::MaxOcclusionBatchSize];
+      plUInt32 batchDataIndices[plSpatialSystem::MaxOcclusionBatchSize];
+      plUInt32 uiNumBatchObjects = 0;
+
+      auto FlushOcclusionBatch = [&]() {
+        if (uiNumBatchObjects == 0)
+          return;
+
+        const plUInt32 occludedMask = queryData.m_IsOccludedCB(plMakeArrayPtr(batchBoxes, uiNumBatchObjects));
+        for (plUInt32 j = 0; j < uiNumBatchObjects; ++j)
+        {
+          if ((occludedMask & (1u << j)) == 0)
+          {
+            AddVisibleObject(batchDataIndices[j]);
+          }
+        }
+
+        uiNumBatchObjects = 0;
+      };
+
+      // the lowest bit of each stack entry marks subtrees that are fully inside the frustum
+      NodeStack stack;
+      stack.PushBack(system.m_uiRootNode << 1);
+
+      while (!stack.IsEmpty())
+      {
+        const plUInt32 uiEntry = stack.PeekBack();
+        stack.PopBack();
+
+        const plSpatialSystem_Bvh::Node& node = pNodes[uiEntry >> 1];
+        bool bInside = (uiEntry & 1) != 0;
+
+        if ((node.m_uiCategoryBitmask & uiCategoryBitmask) == 0)
+          continue;
+
+        if (!node.IsLeaf())
+        {
+          if (!bInside)
+          {
+            const BvhFrustumResult result = BoxFrustumIntersect(node.m_Box, planeData);
+            if (result == BvhFrustumResult::Outside)
+              continue;
+
+            bInside = (result == BvhFrustumResult::Inside);
+          }
+
+          if constexpr (UseOcclusionCallback)
+          {
+            // only test bigger subtrees, for small ones the object tests are cheaper than the additional occlusion test
+            if (node.m_uiHeight >= 2 && queryData.m_IsOccludedCB(plMakeArrayPtr(&node.m_Box, 1)) != 0)
+              continue;
+          }
+
+          const plUInt32 uiInsideFlag = bInside ? 1 : 0;
+          stack.PushBack((node.m_uiChildren[1] << 1) | uiInsideFlag);
+          stack.PushBack((node.m_uiChildren[0] << 1) | uiInsideFlag);
+          continue;
+        }
+
+        const plUInt32 i = node.m_uiDataIndex;
+        ref_stats.m_uiNumObjectsTested++;
+
+        if (!bInside && !SphereFrustumIntersect(pBoundingSpheres[i], planeData))
+          continue;
+
+        if constexpr (UseTagsFilter)
+        {
+          if (FilterByTagsBvh(system.m_TagSets[i], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+            continue;
+        }
+
+        if constexpr (UseOcclusionCallback)
+        {
+          // collect the candidates, so that they can be tested for occlusion in one batch
+          batchBoxes[uiNumBatchObjects] = plSimdBBox::MakeFromCenterAndHalfExtents(pBoundingSpheres[i].GetCenter(), pBoundingBoxHalfExtents[i]);
+          batchDataIndices[uiNumBatchObjects] = i;
+          ++uiNumBatchObjects;
+
+          if (uiNumBatchObjects == plSpatialSystem::MaxOcclusionBatchSize)
+          {
+            FlushOcclusionBatch();
+          }
+        }
+        else
+        {
+          AddVisibleObject(i);
+        }
+      }
+
+      if constexpr (UseOcclusionCallback)
+      {
+        FlushOcclusionBatch();
+      }
+    }
+  };
+} // namespace plInternal
+
+//////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+PL_BEGIN_DYNAMIC_REFLECTED_TYPE(plSpatialSystem_Bvh, 1, plRTTINoAllocator)
+PL_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+plSpatialSystem_Bvh::plSpatialSystem_Bvh(float fLooseness /*= 0.25f*/)
+  : m_AlignedAllocator("Spatial System Aligned", plFoundation::GetAlignedAllocator())
+  , m_fLooseness(fLooseness)
+  , m_Nodes(&m_AlignedAllocator)
+  , m_DataTable(&m_Allocator)
+  , m_BoundingSpheres(&m_AlignedAllocator)
+  , m_BoundingBoxHalfExtents(&m_AlignedAllocator)
+  , m_TagSets(&m_Allocator)
+  , m_ObjectPointers(&m_Allocator)
+  , m_LastVisibleFrameIdxAndVisType(&m_Allocator)
+  , m_AlwaysVisibleData(&m_Allocator)
+{
+}
+
+plSpatialSystem_Bvh::~plSpatialSystem_Bvh() = default;
+
+void plSpatialSystem_Bvh::GetAllNodeBoxes(plDynamicArray<plBoundingBox>& out_boundingBoxes, plSpatialData::Category filterCategory /*= plInvalidSpatialDataCategory*/) const
+{
+  if (m_uiRootNode == plInvalidIndex)
+    return;
+
+  const plUInt32 uiCategoryBitmask = filterCategory != plInvalidSpatialDataCategory ? filterCategory.GetBitmask() : 0xFFFFFFFF;
+
+  plHybridArray<plUInt32, 64> stack;
+  stack.PushBack(m_uiRootNode);
+
+  while (!stack.IsEmpty())
+  {
+    const Node& node = m_Nodes[stack.PeekBack()];
+    stack.PopBack();
+
+    if ((node.m_uiCategoryBitmask & uiCategoryBitmask) == 0)
+      continue;
+
+    out_boundingBoxes.PushBack(plSimdConversion::ToBBox(node.m_Box));
+
+    if (!node.IsLeaf())
+    {
+      stack.PushBack(node.m_uiChildren[0]);
+      stack.PushBack(node.m_uiChildren[1]);
+    }
+  }
+}
+
+plSpatialDataHandle plSpatialSystem_Bvh::CreateSpatialData(const plSimdBBoxSphere& bounds, plGameObject* pObject, plUInt32 uiCategoryBitmask, const plTagSet& tags)
+{
+  if (uiCategoryBitmask == 0)
+    return plSpatialDataHandle();
+
+  const plUInt32 uiNodeIndex = AllocateNode();
+
+  Data data;
+  data.m_uiNodeIndex = uiNodeIndex;
+  data.m_uiCategoryBitmask = uiCategoryBitmask;
+
+  auto hData = plSpatialDataHandle(m_DataTable.Insert(data));
+  const plUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+  m_BoundingSpheres.EnsureCount(uiDataIndex + 1);
+  m_BoundingBoxHalfExtents.EnsureCount(uiDataIndex + 1);
+  m_TagSets.EnsureCount(uiDataIndex + 1);
+  m_ObjectPointers.EnsureCount(uiDataIndex + 1);
+  m_LastVisibleFrameIdxAndVisType.EnsureCount(uiDataIndex + 1);
+
+  m_BoundingSpheres[uiDataIndex] = bounds.GetSphere();
+  m_BoundingBoxHalfExtents[uiDataIndex] = bounds.m_BoxHalfExtents;
+  m_TagSets[uiDataIndex] = tags;
+  m_ObjectPointers[uiDataIndex] = pObject;
+  m_LastVisibleFrameIdxAndVisType[uiDataIndex] = m_uiFrameCounter;
+
+  Node& node = m_Nodes[uiNodeIndex];
+  node.m_Box = ComputeLeafBox(bounds, uiCategoryBitmask);
+  node.m_uiCategoryBitmask = uiCategoryBitmask;
+  node.m_uiDataIndex = uiDataIndex;
+
+  InsertLeaf(uiNodeIndex);
+
+  return hData;
+}
+
+plSpatialDataHandle plSpatialSystem_Bvh::CreateSpatialDataAlwaysVisible(plGameObject* pObject, plUInt32 uiCategoryBitmask, const plTagSet& tags)
+{
+  if (uiCategoryBitmask == 0)
+    return plSpatialDataHandle();
+
+  Data data;
+  data.m_uiNodeIndex = plInvalidIndex;
+  data.m_uiCategoryBitmask = uiCategoryBitmask;
+
+  auto hData = plSpatialDataHandle(m_DataTable.Insert(data));
+  const plUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+  m_TagSets.EnsureCount(uiDataIndex + 1);
+  m_ObjectPointers.EnsureCount(uiDataIndex + 1);
+
+  m_TagSets[uiDataIndex] = tags;
+  m_ObjectPointers[uiDataIndex] = pObject;
+
+  m_AlwaysVisibleData.PushBack(uiDataIndex);
+
+  return hData;
+}
+
+void plSpatialSystem_Bvh::DeleteSpatialData(const plSpatialDataHandle& hData)
+{
+  Data oldData;
+  PL_VERIFY(m_DataTable.Remove(hData.GetInternalID(), &oldData), "Invalid spatial data handle");
+
+  const plUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+  m_TagSets[uiDataIndex].Clear();
+  m_ObjectPointers[uiDataIndex] = nullptr;
+
+  if (oldData.m_uiNodeIndex == plInvalidIndex)
+  {
+    m_AlwaysVisibleData.RemoveAndSwap(uiDataIndex);
+    return;
+  }
+
+  RemoveLeaf(oldData.m_uiNodeIndex);
+  FreeNode(oldData.m_uiNodeIndex);
+}
+
+void plSpatialSystem_Bvh::UpdateSpatialDataBounds(const plSpatialDataHandle& hData, const plSimdBBoxSphere& bounds)
+{
+  Data* pData = nullptr;
+  PL_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  // No need to update bounds for always visible data
+  if (pData->m_uiNodeIndex == plInvalidIndex)
+    return;
+
+  const plUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+  m_BoundingSpheres[uiDataIndex] = bounds.GetSphere();
+  m_BoundingBoxHalfExtents[uiDataIndex] = bounds.m_BoxHalfExtents;
+
+  const plUInt32 uiLeafIndex = pData->m_uiNodeIndex;
+  Node& leaf = m_Nodes[uiLeafIndex];
+
+  const plSimdBBox box = bounds.GetBox();
+  if (leaf.m_Box.Contains(box))
+    return;
+
+  leaf.m_Box = ComputeLeafBox(bounds, pData->m_uiCategoryBitmask);
+
+  // As long as the object stays within its parent node, refitting the ancestors keeps the tree in good shape.
+  // Otherwise the leaf is re-inserted, which also re-balances the tree.
+  const plUInt32 uiParentIndex = leaf.m_uiParent;
+  if (uiParentIndex != plInvalidIndex && m_Nodes[uiParentIndex].m_Box.Contains(box.GetCenter()))
+  {
+    RefitAncestors(uiParentIndex);
+  }
+  else
+  {
+    RemoveLeaf(uiLeafIndex);
+    InsertLeaf(uiLeafIndex);
+  }
+}
+
+void plSpatialSystem_Bvh::UpdateSpatialDataObject(const plSpatialDataHandle& hData, plGameObject* pObject)
+{
+  Data* pData = nullptr;
+  PL_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  m_ObjectPointers[hData.GetInternalID().m_InstanceIndex] = pObject;
+}
+
+void plSpatialSystem_Bvh::FindObjectsInSphere(const plBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const
+{
+  PL_PROFILE_SCOPE("FindObjectsInSphere");
+
+  const plSimdBSphere simdSphere(plSimdConversion::ToVec3(sphere.m_vCenter), sphere.m_fRadius);
+
+  plInternal::BvhQueryHelper::Stats stats;
+  if (plInternal::BvhQueryHelper::UseTagsFilter(queryParams))
+    plInternal::BvhQueryHelper::ShapeQuery<plSimdBSphere, true>(*this, simdSphere, queryParams, callback, stats);
+  else
+    plInternal::BvhQueryHelper::ShapeQuery<plSimdBSphere, false>(*this, simdSphere, queryParams, callback, stats);
+
+#if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
+    queryParams.m_pStats->m_uiNumObjectsTested += stats.m_uiNumObjectsTested;
+    queryParams.m_pStats->m_uiNumObjectsPassed += stats.m_uiNumObjectsPassed;
+  }
+#endif
+}
+
+void plSpatialSystem_Bvh::FindObjectsInBox(const plBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const
+{
+  PL_PROFILE_SCOPE("FindObjectsInBox");
+
+  const plSimdBBox simdBox(plSimdConversion::ToVec3(box.m_vMin), plSimdConversion::ToVec3(box.m_vMax));
+
+  plInternal::BvhQueryHelper::Stats stats;
+  if (plInternal::BvhQueryHelper::UseTagsFilter(queryParams))
+    plInternal::BvhQueryHelper::ShapeQuery<plSimdBBox, true>(*this, simdBox, queryParams, callback, stats);
+  else
+    plInternal::BvhQueryHelper::ShapeQuery<plSimdBBox, false>(*this, simdBox, queryParams, callback, stats);
+
+#if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
+    queryParams.m_pStats->m_uiNumObjectsTested += stats.m_uiNumObjectsTested;
+    queryParams.m_pStats->m_uiNumObjectsPassed += stats.m_uiNumObjectsPassed;
+  }
+#endif
+}
+
+void plSpatialSystem_Bvh::FindVisibleObjects(const plFrustum& frustum, const QueryParams& queryParams, plDynamicArray<const plGameObject*>& out_Objects, plSpatialSystem::IsOccludedFunc IsOccluded, plVisibilityState visType) const
+{
+  PL_PROFILE_SCOPE("FindVisibleObjects");
+
+#if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
+  plStopwatch timer;
+#endif
+
+  FrustumQueryData queryData;
+  {
+    plSimdVec4f plane0 = plSimdConversion::ToVec4(*reinterpret_cast<const plVec4*>(&(frustum.GetPlane(0).m_vNormal.x)));
+    plSimdVec4f plane1 = plSimdConversion::ToVec4(*reinterpret_cast<const plVec4*>(&(frustum.GetPlane(1).m_vNormal.x)));
+    plSimdVec4f plane2 = plSimdConversion::ToVec4(*reinterpret_cast<const plVec4*>(&(frustum.GetPlane(2).m_vNormal.x)));
+    plSimdVec4f plane3 = plSimdConversion::ToVec4(*reinterpret_cast<const plVec4*>(&(frustum.GetPlane(3).m_vNormal.x)));
+    plSimdVec4f plane4 = plSimdConversion::ToVec4(*reinterpret_cast<const plVec4*>(&(frustum.GetPlane(4).m_vNormal.x)));
+    plSimdVec4f plane5 = plSimdConversion::ToVec4(*reinterpret_cast<const plVec4*>(&(frustum.GetPlane(5).m_vNormal.x)));
+
+    BvhPlaneData& planeData = queryData.m_PlaneData;
+
+    plSimdMat4f helperMat;
+    helperMat.SetRows(plane0, plane1, plane2, plane3);
+
+    planeData.m_x0x1x2x3 = helperMat.m_col0;
+    planeData.m_y0y1y2y3 = helperMat.m_col1;
+    planeData.m_z0z1z2z3 = helperMat.m_col2;
+    planeData.m_w0w1w2w3 = helperMat.m_col3;
+
+    helperMat.SetRows(plane4, plane5, plane4, plane5);
+
+    planeData.m_x4x5x4x5 = helperMat.m_col0;
+    planeData.m_y4y5y4y5 = helperMat.m_col1;
+    planeData.m_z4z5z4z5 = helperMat.m_col2;
+    planeData.m_w4w5w4w5 = helperMat.m_col3;
+
+    planeData.m_absX0X1X2X3 = planeData.m_x0x1x2x3.Abs();
+    planeData.m_absY0Y1Y2Y3 = planeData.m_y0y1y2y3.Abs();
+    planeData.m_absZ0Z1Z2Z3 = planeData.m_z0z1z2z3.Abs();
+
+    planeData.m_absX4X5X4X5 = planeData.m_x4x5x4x5.Abs();
+    planeData.m_absY4Y5Y4Y5 = planeData.m_y4y5y4y5.Abs();
+    planeData.m_absZ4Z5Z4Z5 = planeData.m_z4z5z4z5.Abs();
+
+    queryData.m_pOutObjects = &out_Objects;
+    queryData.m_uiFrameIdxAndType = (m_uiFrameCounter << 4) | static_cast<plUInt64>(visType);
+    queryData.m_IsOccludedCB = IsOccluded;
+  }
+
+  plInternal::BvhQueryHelper::Stats stats;
+  const bool bUseTagsFilter = plInternal::BvhQueryHelper::UseTagsFilter(queryParams);
+
+  if (IsOccluded.IsValid())
+  {
+    if (bUseTagsFilter)
+      plInternal::BvhQueryHelper::FrustumQuery<true, true>(*this, queryData, queryParams, stats);
+    else
+      plInternal::BvhQueryHelper::FrustumQuery<false, true>(*this, queryData, queryParams, stats);
+  }
+  else
+  {
+    if (bUseTagsFilter)
+      plInternal::BvhQueryHelper::FrustumQuery<true, false>(*this, queryData, queryParams, stats);
+    else
+      plInternal::BvhQueryHelper::FrustumQuery<false, false>(*this, queryData, queryParams, stats);
+  }
+
+#if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
+    queryParams.m_pStats->m_uiNumObjectsTested += stats.m_uiNumObjectsTested;
+    queryParams.m_pStats->m_uiNumObjectsPassed += stats.m_uiNumObjectsPassed;
+    queryParams.m_pStats->m_TimeTaken = timer.GetRunningTotal();
+  }
+#endif
+}
+
+plVisibilityState plSpatialSystem_Bvh::GetVisibilityState(const plSpatialDataHandle& hData, plUInt32 uiNumFramesBeforeInvisible) const
+{
+  Data* pData = nullptr;
+  PL_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  if (pData->m_uiNodeIndex == plInvalidIndex)
+    return plVisibilityState::Direct;
+
+  const plUInt64 uiLastVisibleFrameIdxAndVisType = m_LastVisibleFrameIdxAndVisType[hData.GetInternalID().m_InstanceIndex];
+  const plUInt64 uiLastVisibleFrameIdx = (uiLastVisibleFrameIdxAndVisType >> 4);
+  const plUInt64 uiLastVisibilityType = (uiLastVisibleFrameIdxAndVisType & static_cast<plUInt64>(15)); // mask out lower 4 bits
+
+  if (m_uiFrameCounter > uiLastVisibleFrameIdx + uiNumFramesBeforeInvisible)
+    return plVisibilityState::Invisible;
+
+  return static_cast<plVisibilityState>(uiLastVisibilityType);
+}
+
+#if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
+void plSpatialSystem_Bvh::GetInternalStats(plStringBuilder& sb) const
+{
+  const plUInt32 uiNumNodes = m_uiRootNode != plInvalidIndex ? m_DataTable.GetCount() - m_AlwaysVisibleData.GetCount() : 0;
+  const plUInt32 uiHeight = m_uiRootNode != plInvalidIndex ? m_Nodes[m_uiRootNode].m_uiHeight : 0;
+
+  sb.SetFormat("Num Objects: {}, Always Visible: {}\n", m_DataTable.GetCount(), m_AlwaysVisibleData.GetCount());
+  sb.AppendFormat("Num Nodes: {}, Tree Height: {}\n", uiNumNodes > 0 ? uiNumNodes * 2 - 1 : 0, uiHeight);
+}
+#endif
+
+plUInt32 plSpatialSystem_Bvh::AllocateNode()
+{
+  plUInt32 uiNodeIndex = m_uiFirstFreeNode;
+  if (uiNodeIndex != plInvalidIndex)
+  {
+    m_uiFirstFreeNode = m_Nodes[uiNodeIndex].m_uiParent;
+  }
+  else
+  {
+    uiNodeIndex = m_Nodes.GetCount();
+    m_Nodes.ExpandAndGetRef();
+  }
+
+  Node& node = m_Nodes[uiNodeIndex];
+  node.m_uiParent = plInvalidIndex;
+  node.m_uiChildren[0] = plInvalidIndex;
+  node.m_uiChildren[1] = plInvalidIndex;
+  node.m_uiCategoryBitmask = 0;
+  node.m_uiHeight = 0;
+  node.m_uiDataIndex = plInvalidIndex;
+
+  return uiNodeIndex;
+}
+
+void plSpatialSystem_Bvh::FreeNode(plUInt32 uiNodeIndex)
+{
+  m_Nodes[uiNodeIndex].m_uiParent = m_uiFirstFreeNode;
+  m_uiFirstFreeNode = uiNodeIndex;
+}
+
+void plSpatialSystem_Bvh::InsertLeaf(plUInt32 uiLeafIndex)
+{
+  if (m_uiRootNode == plInvalidIndex)
+  {
+    m_uiRootNode = uiLeafIndex;
+    m_Nodes[uiLeafIndex].m_uiParent = plInvalidIndex;
+    return;
+  }
+
+  // Find the best sibling by descending the tree along the cheapest path according to the surface area heuristic
+  const plSimdBBox leafBox = m_Nodes[uiLeafIndex].m_Box;
+
+  plUInt32 uiIndex = m_uiRootNode;
+  while (!m_Nodes[uiIndex].IsLeaf())
+  {
+    const Node& node = m_Nodes[uiIndex];
+
+    const float fArea = GetSurfaceArea(node.m_Box);
+    const float fCombinedArea = GetSurfaceArea(GetUnion(node.m_Box, leafBox));
+
+    // cost of creating a new parent for this node and the new leaf
+    const float fCost = 2.0f * fCombinedArea;
+
+    // minimum cost of pushing the leaf further down the tree
+    const float fInheritanceCost = 2.0f * (fCombinedArea - fArea);
+
+    float fChildCosts[2];
+    for (plUInt32 i = 0; i < 2; ++i)
+    {
+      const Node& child = m_Nodes[node.m_uiChildren[i]];
+      const float fChildCombinedArea = GetSurfaceArea(GetUnion(child.m_Box, leafBox));
+
+      fChildCosts[i] = (child.IsLeaf() ? fChildCombinedArea : fChildCombinedArea - GetSurfaceArea(child.m_Box)) + fInheritanceCost;
+    }
+
+    if (fCost < fChildCosts[0] && fCost < fChildCosts[1])
+      break;
+
+    uiIndex = fChildCosts[0] < fChildCosts[1] ? node.m_uiChildren[0] : node.m_uiChildren[1];
+  }
+
+  const plUInt32 uiSiblingIndex = uiIndex;
+
+  // Create a new parent for the sibling and the new leaf
+  const plUInt32 uiNewParentIndex = AllocateNode();
+  const plUInt32 uiOldParentIndex = m_Nodes[uiSiblingIndex].m_uiParent;
+
+  {
+    Node& newParent = m_Nodes[uiNewParentIndex];
+    newParent.m_uiParent = uiOldParentIndex;
+    newParent.m_uiChildren[0] = uiSiblingIndex;
+    newParent.m_uiChildren[1] = uiLeafIndex;
+  }
+
+  if (uiOldParentIndex != plInvalidIndex)
+  {
+    Node& oldParent = m_Nodes[uiOldParentIndex];
+    oldParent.m_uiChildren[oldParent.m_uiChildren[0] == uiSiblingIndex ? 0 : 1] = uiNewParentIndex;
+  }
+  else
+  {
+    m_uiRootNode = uiNewParentIndex;
+  }
+
+  m_Nodes[uiSiblingIndex].m_uiParent = uiNewParentIndex;
+  m_Nodes[uiLeafIndex].m_uiParent = uiNewParentIndex;
+
+  // Walk back up the tree fixing heights, boxes and category bitmasks
+  plUInt32 uiNodeIndex = uiNewParentIndex;
+  while (uiNodeIndex != plInvalidIndex)
+  {
+    UpdateNodeFromChildren(uiNodeIndex);
+    uiNodeIndex = Balance(uiNodeIndex);
+
+    uiNodeIndex = m_Nodes[uiNodeIndex].m_uiParent;
+  }
+}
+
+void plSpatialSystem_Bvh::RemoveLeaf(plUInt32 uiLeafIndex)
+{
+  if (uiLeafIndex == m_uiRootNode)
+  {
+    m_uiRootNode = plInvalidIndex;
+    return;
+  }
+
+  const plUInt32 uiParentIndex = m_Nodes[uiLeafIndex].m_uiParent;
+  const Node& parent = m_Nodes[uiParentIndex];
+  const plUInt32 uiGrandParentIndex = parent.m_uiParent;
+  const plUInt32 uiSiblingIndex = parent.m_uiChildren[0] == uiLeafIndex ? parent.m_uiChildren[1] : parent.m_uiChildren[0];
+
+  if (uiGrandParentIndex != plInvalidIndex)
+  {
+    // Replace the parent with the sibling
+    Node& grandParent = m_Nodes[uiGrandParentIndex];
+    grandParent.m_uiChildren[grandParent.m_uiChildren[0] == uiParentIndex ? 0 : 1] = uiSiblingIndex;
+    m_Nodes[uiSiblingIndex].m_uiParent = uiGrandParentIndex;
+    FreeNode(uiParentIndex);
+
+    plUInt32 uiNodeIndex = uiGrandParentIndex;
+    while (uiNodeIndex != plInvalidIndex)
+    {
+      UpdateNodeFromChildren(uiNodeIndex);
+      uiNodeIndex = Balance(uiNodeIndex);
+
+      uiNodeIndex = m_Nodes[uiNodeIndex].m_uiParent;
+    }
+  }
+  else
+  {
+    m_uiRootNode = uiSiblingIndex;
+    m_Nodes[uiSiblingIndex].m_uiParent = plInvalidIndex;
+    FreeNode(uiParentIndex);
+  }
+
+  m_Nodes[uiLeafIndex].m_uiParent = plInvalidIndex;
+}
+
+void plSpatialSystem_Bvh::RefitAncestors(plUInt32 uiNodeIndex)
+{
+  while (uiNodeIndex != plInvalidIndex)
+  {
+    Node& node = m_Nodes[uiNodeIndex];
+    const plSimdBBox oldBox = node.m_Box;
+
+    UpdateNodeFromChildren(uiNodeIndex);
+
+    // Nothing changes further up the tree
+    if (node.m_Box == oldBox)
+      break;
+
+    uiNodeIndex = node.m_uiParent;
+  }
+}
+
+void plSpatialSystem_Bvh::UpdateNodeFromChildren(plUInt32 uiNodeIndex)
+{
+  Node& node = m_Nodes[uiNodeIndex];
+  const Node& child0 = m_Nodes[node.m_uiChildren[0]];
+  const Node& child1 = m_Nodes[node.m_uiChildren[1]];
+
+  node.m_Box = GetUnion(child0.m_Box, child1.m_Box);
+  node.m_uiCategoryBitmask = child0.m_uiCategoryBitmask | child1.m_uiCategoryBitmask;
+  node.m_uiHeight = 1 + plMath::Max(child0.m_uiHeight, child1.m_uiHeight);
+}
+
+plUInt32 plSpatialSystem_Bvh::Balance(plUInt32 uiIndexA)
+{
+  // Performs a left or right rotation if node A is imbalanced. Returns the new root index of the subtree.
+  // Expects the height of A to be up to date.
+  Node& a = m_Nodes[uiIndexA];
+  if (a.IsLeaf() || a.m_uiHeight < 2)
+    return uiIndexA;
+
+  const plUInt32 uiIndexB = a.m_uiChildren[0];
+  const plUInt32 uiIndexC = a.m_uiChildren[1];
+  const plInt32 iBalance = plInt32(m_Nodes[uiIndexC].m_uiHeight) - plInt32(m_Nodes[uiIndexB].m_uiHeight);
+
+  if (iBalance >= -1 && iBalance <= 1)
+    return uiIndexA;
+
+  // The higher child is rotated up, it has to be an interior node since the height difference is at least 2
+  const plUInt32 uiChildSlot = iBalance > 1 ? 1 : 0;
+  const plUInt32 uiIndexUp = a.m_uiChildren[uiChildSlot];
+  Node& up = m_Nodes[uiIndexUp];
+
+  const plUInt32 uiIndexF = up.m_uiChildren[0];
+  const plUInt32 uiIndexG = up.m_uiChildren[1];
+
+  // Swap A and the rotated child
+  up.m_uiChildren[0] = uiIndexA;
+  up.m_uiParent = a.m_uiParent;
+  a.m_uiParent = uiIndexUp;
+
+  if (up.m_uiParent != plInvalidIndex)
+  {
+    Node& parent = m_Nodes[up.m_uiParent];
+    parent.m_uiChildren[parent.m_uiChildren[0] == uiIndexA ? 0 : 1] = uiIndexUp;
+  }
+  else
+  {
+    m_uiRootNode = uiIndexUp;
+  }
+
+  // The higher grandchild stays with the rotated child, the other one moves to A
+  const bool bKeepF = m_Nodes[uiIndexF].m_uiHeight > m_Nodes[uiIndexG].m_uiHeight;
+  const plUInt32 uiIndexKeep = bKeepF ? uiIndexF : uiIndexG;
+  const plUInt32 uiIndexMove = bKeepF ? uiIndexG : uiIndexF;
+
+  up.m_uiChildren[1] = uiIndexKeep;
+  a.m_uiChildren[uiChildSlot] = uiIndexMove;
+  m_Nodes[uiIndexMove].m_uiParent = uiIndexA;
+
+  UpdateNodeFromChildren(uiIndexA);
+  UpdateNodeFromChildren(uiIndexUp);
+
+  return uiIndexUp;
+}
+
+plSimdBBox plSpatialSystem_Bvh::ComputeLeafBox(const plSimdBBoxSphere& bounds, plUInt32 uiCategoryBitmask) const
+{
+  plSimdBBox box = bounds.GetBox();
+
+  plUInt32 uiBitmask = uiCategoryBitmask;
+  while (uiBitmask > 0)
+  {
+    const plUInt32 uiCategoryIndex = plMath::FirstBitLow(uiBitmask);
+    uiBitmask &= uiBitmask - 1;
+
+    if (plSpatialData::GetCategoryFlags(plSpatialData::Category(static_cast<plUInt16>(uiCategoryIndex))).IsSet(plSpatialData::Flags::FrequentChanges))
+    {
+      box.Grow(bounds.m_BoxHalfExtents * m_fLooseness);
+      break;
+    }
+  }
+
+  return box;
+}
+
+
+PL_STATICLINK_FILE(Core, Core_World_Implementation_SpatialSystem_Bvh);
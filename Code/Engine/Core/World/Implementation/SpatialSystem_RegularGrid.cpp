@@ -501,7 +501,8 @@ namespace plInternal
 
       if constexpr (UseOcclusionCallback)
       {
-        if (pQueryData->m_IsOccludedCB(cell.m_Bounds.GetBox()))
+        const plSimdBBox cellBox = cell.m_Bounds.GetBox();
+        if (pQueryData->m_IsOccludedCB(plMakeArrayPtr(&cellBox, 1)) != 0)
         {
           return plVisitorExecution::Continue;
         }
@@ -519,12 +520,14 @@ namespace plInternal
       plUInt32 currentIndex = 0;
       const plUInt64 uiFrameIdxAndType = (pQueryData->m_uiFrameCounter << 4) | static_cast<plUInt64>(visType);
 
+      // objects are processed in batches of 32, the bits in the mask represent the objects that are still considered visible
       while (currentIndex < numSpheres)
       {
-        if (numSpheres - currentIndex >= 32)
-        {
-          plUInt32 mask = 0;
+        const plUInt32 uiBatchSize = plMath::Min(numSpheres - currentIndex, 32u);
+        plUInt32 mask = 0;
 
+        if (uiBatchSize == 32)
+        {
           for (plUInt32 i = 0; i < 32; i += 2)
           {
             auto& objectSphereA = boundingSpheres[currentIndex + i + 0];
@@ -532,70 +535,74 @@ namespace plInternal
 
             mask |= SphereFrustumIntersect(objectSphereA, objectSphereB, planeData) << i;
           }
-
-          while (mask > 0)
-          {
-            plUInt32 i = plMath::FirstBitLow(mask) + currentIndex;
-            mask &= mask - 1;
-
-            if constexpr (UseTagsFilter)
-            {
-              if (FilterByTags(tagSets[i], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
-              {
-                ref_stats.m_uiNumObjectsFiltered++;
-                continue;
-              }
-            }
-
-            if constexpr (UseOcclusionCallback)
-            {
-              const plSimdBBox bbox = plSimdBBox::MakeFromCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
-              if (pQueryData->m_IsOccludedCB(bbox))
-              {
-                continue;
-              }
-            }
-
-            lastVisibleFrameIdxAndVisType[i].Max(uiFrameIdxAndType);
-            pQueryData->m_pOutObjects->PushBack(objectPointers[i]);
-
-            ref_stats.m_uiNumObjectsPassed++;
-          }
-
-          currentIndex += 32;
         }
         else
         {
-          plUInt32 i = currentIndex;
-          ++currentIndex;
-
-          if (!SphereFrustumIntersect(boundingSpheres[i], planeData))
-            continue;
+          for (plUInt32 i = 0; i < uiBatchSize; ++i)
+          {
+            mask |= (SphereFrustumIntersect(boundingSpheres[currentIndex + i], planeData) ? 1u : 0u) << i;
+          }
+        }
 
-          if constexpr (UseTagsFilter)
+        if constexpr (UseTagsFilter)
+        {
+          plUInt32 remainingMask = mask;
+          while (remainingMask > 0)
           {
-            if (FilterByTags(tagSets[i], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+            const plUInt32 uiBit = plMath::FirstBitLow(remainingMask);
+            remainingMask &= remainingMask - 1;
+
+            if (FilterByTags(tagSets[currentIndex + uiBit], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
             {
               ref_stats.m_uiNumObjectsFiltered++;
-              continue;
+              mask &= ~(1u << uiBit);
             }
           }
+        }
 
-          if constexpr (UseOcclusionCallback)
+        if constexpr (UseOcclusionCallback)
+        {
+          if (mask != 0)
           {
-            const plSimdBBox bbox = plSimdBBox::MakeFromCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
+            plSimdBBox boxes[32];
+            plUInt8 boxBits[32];
+            plUInt32 uiNumBoxes = 0;
+
+            plUInt32 remainingMask = mask;
+            while (remainingMask > 0)
+            {
+              const plUInt32 uiBit = plMath::FirstBitLow(remainingMask);
+              remainingMask &= remainingMask - 1;
 
-            if (pQueryData->m_IsOccludedCB(bbox))
+              const plUInt32 i = currentIndex + uiBit;
+              boxes[uiNumBoxes] = plSimdBBox::MakeFromCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
+              boxBits[uiNumBoxes] = static_cast<plUInt8>(uiBit);
+              ++uiNumBoxes;
+            }
+
+            plUInt32 occludedMask = pQueryData->m_IsOccludedCB(plMakeArrayPtr(boxes, uiNumBoxes));
+            while (occludedMask > 0)
             {
-              continue;
+              const plUInt32 uiBox = plMath::FirstBitLow(occludedMask);
+              occludedMask &= occludedMask - 1;
+
+              mask &= ~(1u << boxBits[uiBox]);
             }
           }
+        }
+
+        while (mask > 0)
+        {
+          plUInt32 i = plMath::FirstBitLow(mask) + currentIndex;
+          mask &= mask - 1;
 
           lastVisibleFrameIdxAndVisType[i].Max(uiFrameIdxAndType);
           pQueryData->m_pOutObjects->PushBack(objectPointers[i]);
 
           ref_stats.m_uiNumObjectsPassed++;
         }
+
+        currentIndex += uiBatchSize;
       }
 
       return plVisitorExecution::Continue;
@@ -764,11 +771,29 @@ void plSpatialSystem_RegularGrid::UpdateSpatialDataBounds(const plSpatialDataHan
   Data* pData = nullptr;
   PL_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
 
+  UpdateSpatialDataBounds(*pData, hData, bounds);
+}
+
+void plSpatialSystem_RegularGrid::UpdateSpatialDataBoundsBatch(plArrayPtr<const BoundsUpdate> updates)
+{
+  PL_PROFILE_SCOPE("UpdateSpatialDataBoundsBatch");
+
+  for (const BoundsUpdate& update : updates)
+  {
+    Data* pData = nullptr;
+    PL_VERIFY(m_DataTable.TryGetValue(update.m_hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+    UpdateSpatialDataBounds(*pData, update.m_hData, update.m_Bounds);
+  }
+}
+
+PL_FORCE_INLINE void plSpatialSystem_RegularGrid::UpdateSpatialDataBounds(const Data& data, const plSpatialDataHandle& hData, const plSimdBBoxSphere& bounds)
+{
   // No need to update bounds for always visible data
-  if (IsAlwaysVisibleData(*pData))
+  if (IsAlwaysVisibleData(data))
     return;
 
-  ForEachGrid(*pData, hData,
+  ForEachGrid(data, hData,
     [&](Grid& ref_grid, const CellDataMapping& mapping) {
       auto& pOldCell = ref_grid.m_Cells[mapping.m_uiCellIndex];
 
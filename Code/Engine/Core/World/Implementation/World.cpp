@@ -1007,7 +1007,6 @@ void plWorld::RegisterUpdateFunction(const plComponentManagerBase::UpdateFunctio
   CheckForWriteAccess();
 
   PL_ASSERT_DEV(desc.m_Phase == plComponentManagerBase::UpdateFunctionDesc::Phase::Async || desc.m_uiGranularity == 0, "Granularity must be 0 for synchronous update functions");
-  PL_ASSERT_DEV(desc.m_Phase != plComponentManagerBase::UpdateFunctionDesc::Phase::Async || desc.m_DependsOn.GetCount() == 0, "Asynchronous update functions must not have dependencies");
   PL_ASSERT_DEV(desc.m_Function.IsComparable(), "Delegates with captures are not allowed as plWorld update functions.");
 
   m_Data.m_UpdateFunctionsToRegister.PushBack(desc);
@@ -1078,17 +1077,46 @@ void plWorld::UpdateSynchronous(const plArrayPtr<plInternal::WorldData::Register
 
 void plWorld::UpdateAsynchronous()
 {
-  plTaskGroupID taskGroupId = plTaskSystem::CreateTaskGroup(plTaskPriority::EarlyThisFrame);
-
   plDynamicArrayBase<plInternal::WorldData::RegisteredUpdateFunction>& updateFunctions = m_Data.m_UpdateFunctions[plComponentManagerBase::UpdateFunctionDesc::Phase::Async];
 
+  // Every update function gets its own task group, which only waits for the groups of the functions it depends on.
+  // Thus independent functions never wait for each other and dependent functions start as soon as their inputs are ready.
+  plHybridArray<plTaskGroupID, 32> taskGroups;
+  taskGroups.SetCount(updateFunctions.GetCount());
+
+  plHybridArray<plTaskGroupID, 32> taskGroupsToStart;
+  plHybridArray<plTaskGroupDependency, 32> taskGroupDependencies;
+
   plUInt32 uiCurrentTaskIndex = 0;
 
-  for (auto& updateFunction : updateFunctions)
+  for (plUInt32 uiFunctionIndex = 0; uiFunctionIndex < updateFunctions.GetCount(); ++uiFunctionIndex)
   {
+    auto& updateFunction = updateFunctions[uiFunctionIndex];
+
     if (updateFunction.m_bOnlyUpdateWhenSimulating && !m_Data.m_bSimulateWorld)
       continue;
 
+    plTaskGroupID taskGroupId = plTaskSystem::CreateTaskGroup(plTaskPriority::EarlyThisFrame);
+    taskGroups[uiFunctionIndex] = taskGroupId;
+    taskGroupsToStart.PushBack(taskGroupId);
+
+    // dependencies are always registered before the functions that depend on them
+    for (const plHashedString& sDependency : updateFunction.m_DependsOn)
+    {
+      for (plUInt32 i = 0; i < uiFunctionIndex; ++i)
+      {
+        if (updateFunctions[i].m_sFunctionName == sDependency)
+        {
+          // skipped functions have no task group
+          if (taskGroups[i].IsValid())
+          {
+            taskGroupDependencies.PushBack({taskGroupId, taskGroups[i]});
+          }
+          break;
+        }
+      }
+    }
+
     plWorldModule* pModule = static_cast<plWorldModule*>(updateFunction.m_Function.GetClassInstance());
     plComponentManagerBase* pManager = plDynamicCast<plComponentManagerBase*>(pModule);
 
@@ -1121,8 +1149,13 @@ void plWorld::UpdateAsynchronous()
     }
   }
 
-  plTaskSystem::StartTaskGroup(taskGroupId);
-  plTaskSystem::WaitForGroup(taskGroupId);
+  plTaskSystem::AddTaskGroupDependencyBatch(taskGroupDependencies);
+  plTaskSystem::StartTaskGroupBatch(taskGroupsToStart);
+
+  for (const plTaskGroupID& taskGroupId : taskGroupsToStart)
+  {
+    plTaskSystem::WaitForGroup(taskGroupId);
+  }
 }
 
 bool plWorld::ProcessInitializationBatch(plInternal::WorldData::InitBatch& batch, plTime endTime)
@@ -341,21 +341,17 @@ namespace plInternal
 
     struct RootLevelWithSpatialData
     {
-      PL_ALWAYS_INLINE static plVisitorExecution::Enum Visit(plGameObject::TransformationData* pData, void* pUserData0)
+      PL_ALWAYS_INLINE static bool Visit(plGameObject::TransformationData* pData, plUInt32 uiUpdateCounter)
       {
-        auto pUserData = static_cast<UserData*>(pUserData0);
-        WorldData::UpdateGlobalTransformAndSpatialData(pData, pUserData->m_uiUpdateCounter, *pUserData->m_pSpatialSystem);
-        return plVisitorExecution::Continue;
+        return WorldData::UpdateGlobalTransformAndCheckSpatialData(pData, uiUpdateCounter);
       }
     };
 
     struct WithParentWithSpatialData
     {
-      PL_ALWAYS_INLINE static plVisitorExecution::Enum Visit(plGameObject::TransformationData* pData, void* pUserData0)
+      PL_ALWAYS_INLINE static bool Visit(plGameObject::TransformationData* pData, plUInt32 uiUpdateCounter)
       {
-        auto pUserData = static_cast<UserData*>(pUserData0);
-        WorldData::UpdateGlobalTransformWithParentAndSpatialData(pData, pUserData->m_uiUpdateCounter, *pUserData->m_pSpatialSystem);
-        return plVisitorExecution::Continue;
+        return WorldData::UpdateGlobalTransformWithParentAndCheckSpatialData(pData, uiUpdateCounter);
       }
     };
 
@@ -364,8 +360,8 @@ namespace plInternal
     {
       auto dataPtr = hierarchy.m_Data.GetData();
 
-      // If we have no spatial system, we perform multi-threaded update as we do not
-      // have to acquire a write lock in the process.
+      // Each hierarchy level is processed in parallel, the parallel-for acts as a barrier between the levels,
+      // so the parent transforms are always up-to-date when a level is processed.
       if (m_pSpatialSystem == nullptr)
       {
         TraverseHierarchyLevelMultiThreaded<RootLevel>(*dataPtr[0], &userData);
@@ -377,11 +373,28 @@ namespace plInternal
       }
       else
       {
-        TraverseHierarchyLevel<RootLevelWithSpatialData>(*dataPtr[0], &userData);
+        // The spatial system can't be updated from multiple threads, so every task collects the bounds updates for its blocks
+        // and they are applied afterwards in a batch.
+        plDynamicArray<SpatialDataUpdateBatch> batches(m_StackAllocator.GetCurrentAllocator());
+
+        TraverseHierarchyLevelMultiThreadedWithSpatialData<RootLevelWithSpatialData>(*dataPtr[0], 0, batches);
 
         for (plUInt32 i = 1; i < hierarchy.m_Data.GetCount(); ++i)
         {
-          TraverseHierarchyLevel<WithParentWithSpatialData>(*dataPtr[i], &userData);
+          TraverseHierarchyLevelMultiThreadedWithSpatialData<WithParentWithSpatialData>(*dataPtr[i], i, batches);
+        }
+
+        // the tasks finish in arbitrary order, sort the batches so that the spatial system is always updated in the same order
+        batches.Sort([](const SpatialDataUpdateBatch& lhs, const SpatialDataUpdateBatch& rhs) -> bool {
+          if (lhs.m_uiHierarchyLevel != rhs.m_uiHierarchyLevel)
+            return lhs.m_uiHierarchyLevel < rhs.m_uiHierarchyLevel;
+
+          return lhs.m_uiFirstBlock < rhs.m_uiFirstBlock;
+        });
+
+        for (const SpatialDataUpdateBatch& batch : batches)
+        {
+          m_pSpatialSystem->UpdateSpatialDataBoundsBatch(batch.m_Updates);
         }
       }
     }
@@ -137,8 +137,21 @@ namespace plInternal
     static void UpdateGlobalTransform(plGameObject::TransformationData* pData, plUInt32 uiUpdateCounter);
     static void UpdateGlobalTransformWithParent(plGameObject::TransformationData* pData, plUInt32 uiUpdateCounter);
 
-    static void UpdateGlobalTransformAndSpatialData(plGameObject::TransformationData* pData, plUInt32 uiUpdateCounter, plSpatialSystem& spatialSystem);
-    static void UpdateGlobalTransformWithParentAndSpatialData(plGameObject::TransformationData* pData, plUInt32 uiUpdateCounter, plSpatialSystem& spatialSystem);
+    /// \brief Updates the global transform and bounds. Returns true, if the spatial data needs to be updated with the new global bounds.
+    static bool UpdateGlobalTransformAndCheckSpatialData(plGameObject::TransformationData* pData, plUInt32 uiUpdateCounter);
+    static bool UpdateGlobalTransformWithParentAndCheckSpatialData(plGameObject::TransformationData* pData, plUInt32 uiUpdateCounter);
+
+    /// \brief The spatial data updates of one parallel-for slice of a hierarchy level.
+    struct SpatialDataUpdateBatch
+    {
+      plUInt32 m_uiHierarchyLevel = 0;
+      plUInt32 m_uiFirstBlock = 0;
+      plArrayPtr<const plSpatialSystem::BoundsUpdate> m_Updates;
+    };
+
+    /// \brief Like TraverseHierarchyLevelMultiThreaded, but collects the required spatial data updates per task instead of applying them.
+    template <typename VISITOR>
+    void TraverseHierarchyLevelMultiThreadedWithSpatialData(Hierarchy::DataBlockArray& blocks, plUInt32 uiHierarchyLevel, plDynamicArray<SpatialDataUpdateBatch>& out_batches);
 
     void UpdateGlobalTransforms();
 
@@ -178,6 +191,7 @@ namespace plInternal
     {
       plWorldModule::UpdateFunction m_Function;
       plHashedString m_sFunctionName;
+      plHybridArray<plHashedString, 4> m_DependsOn;
       float m_fPriority;
       plUInt16 m_uiGranularity;
       bool m_bOnlyUpdateWhenSimulating;
@@ -73,18 +73,74 @@ namespace plInternal
     pData->UpdateGlobalBounds();
   }
 
+  template <typename VISITOR>
+  void WorldData::TraverseHierarchyLevelMultiThreadedWithSpatialData(
+    Hierarchy::DataBlockArray& blocks, plUInt32 uiHierarchyLevel, plDynamicArray<SpatialDataUpdateBatch>& out_batches)
+  {
+    plParallelForParams parallelForParams;
+    parallelForParams.m_uiBinSize = 100;
+    parallelForParams.m_uiMaxTasksPerThread = 2;
+    parallelForParams.m_pTaskAllocator = m_StackAllocator.GetCurrentAllocator();
+
+    const WorldData::Hierarchy::DataBlock* pFirstBlock = blocks.GetData();
+    const plUInt32 uiUpdateCounter = m_uiUpdateCounter;
+    plAllocator* pBatchAllocator = m_StackAllocator.GetCurrentAllocator();
+    plMutex batchMutex;
+
+    plTaskSystem::ParallelFor(
+      blocks.GetArrayPtr(),
+      [&](plArrayPtr<WorldData::Hierarchy::DataBlock> blocksSlice)
+      {
+        plHybridArray<plSpatialSystem::BoundsUpdate, 64> updates;
+
+        for (WorldData::Hierarchy::DataBlock& block : blocksSlice)
+        {
+          plGameObject::TransformationData* pCurrentData = block.m_pData;
+          plGameObject::TransformationData* pEndData = block.m_pData + block.m_uiCount;
+
+          while (pCurrentData < pEndData)
+          {
+            if (VISITOR::Visit(pCurrentData, uiUpdateCounter))
+            {
+              auto& update = updates.ExpandAndGetRef();
+              update.m_Bounds = pCurrentData->m_globalBounds;
+              update.m_hData = pCurrentData->m_hSpatialData;
+            }
+
+            ++pCurrentData;
+          }
+        }
+
+        if (updates.IsEmpty())
+          return;
+
+        // the stack allocator is thread-safe and reset every other frame, so the updates don't need to be freed
+        auto batchUpdates = PL_NEW_ARRAY(pBatchAllocator, plSpatialSystem::BoundsUpdate, updates.GetCount());
+        batchUpdates.CopyFrom(updates);
+
+        SpatialDataUpdateBatch batch;
+        batch.m_uiHierarchyLevel = uiHierarchyLevel;
+        batch.m_uiFirstBlock = static_cast<plUInt32>(blocksSlice.GetPtr() - pFirstBlock);
+        batch.m_Updates = batchUpdates;
+
+        PL_LOCK(batchMutex);
+        out_batches.PushBack(batch);
+      },
+      "World DataBlock Traversal Task", parallelForParams);
+  }
+
   // static
-  PL_FORCE_INLINE void WorldData::UpdateGlobalTransformAndSpatialData(plGameObject::TransformationData* pData, plUInt32 uiUpdateCounter, plSpatialSystem& spatialSystem)
+  PL_FORCE_INLINE bool WorldData::UpdateGlobalTransformAndCheckSpatialData(plGameObject::TransformationData* pData, plUInt32 uiUpdateCounter)
   {
     pData->UpdateGlobalTransformWithoutParent(uiUpdateCounter);
-    pData->UpdateGlobalBoundsAndSpatialData(spatialSystem);
+    return pData->UpdateGlobalBoundsAndCheckSpatialData();
   }
 
   // static
-  PL_FORCE_INLINE void WorldData::UpdateGlobalTransformWithParentAndSpatialData(plGameObject::TransformationData* pData, plUInt32 uiUpdateCounter, plSpatialSystem& spatialSystem)
+  PL_FORCE_INLINE bool WorldData::UpdateGlobalTransformWithParentAndCheckSpatialData(plGameObject::TransformationData* pData, plUInt32 uiUpdateCounter)
   {
     pData->UpdateGlobalTransformWithParent(uiUpdateCounter);
-    pData->UpdateGlobalBoundsAndSpatialData(spatialSystem);
+    return pData->UpdateGlobalBoundsAndCheckSpatialData();
   }
 
   ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -195,6 +251,7 @@ namespace plInternal
   {
     m_Function = desc.m_Function;
     m_sFunctionName = desc.m_sFunctionName;
+    m_DependsOn = desc.m_DependsOn;
     m_fPriority = desc.m_fPriority;
     m_uiGranularity = desc.m_uiGranularity;
     m_bOnlyUpdateWhenSimulating = desc.m_bOnlyUpdateWhenSimulating;
@@ -27,6 +27,17 @@ public:
   virtual void UpdateSpatialDataBounds(const plSpatialDataHandle& hData, const plSimdBBoxSphere& bounds) = 0;
   virtual void UpdateSpatialDataObject(const plSpatialDataHandle& hData, plGameObject* pObject) = 0;
 
+  struct BoundsUpdate
+  {
+    plSimdBBoxSphere m_Bounds;
+    plSpatialDataHandle m_hData;
+  };
+
+  /// \brief Updates the bounds of many spatial data entries at once, in the given order.
+  ///
+  /// The default implementation calls UpdateSpatialDataBounds() for every entry.
+  virtual void UpdateSpatialDataBoundsBatch(plArrayPtr<const BoundsUpdate> updates);
+
   ///@}
   /// \name Simple Queries
   ///@{
@@ -63,7 +74,12 @@ public:
   /// \name Visibility Queries
   ///@{
 
-  using IsOccludedFunc = plDelegate<bool(const plSimdBBox&)>;
+  /// \brief Tests a batch of bounding boxes for occlusion. Returns a bitmask in which bit i is set if boxes[i] is fully occluded.
+  ///
+  /// The spatial systems gather candidate objects and pass at most MaxOcclusionBatchSize boxes per call,
+  /// so that the implementation can test several boxes at once.
+  using IsOccludedFunc = plDelegate<plUInt32(plArrayPtr<const plSimdBBox> boxes)>;
+  static constexpr plUInt32 MaxOcclusionBatchSize = 32;
 
   virtual void FindVisibleObjects(const plFrustum& frustum, const QueryParams& queryParams, plDynamicArray<const plGameObject*>& out_objects, IsOccludedFunc isOccluded, plVisibilityState visType) const = 0;
 
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <Core/World/SpatialSystem.h>
+#include <Foundation/Containers/IdTable.h>
+
+namespace plInternal
+{
+  struct BvhQueryHelper;
+}
+
+/// \brief A spatial system that stores all spatial data in one dynamic bounding volume hierarchy.
+///
+/// Every object is a leaf in a binary AABB tree that is kept balanced with tree rotations on insertion and removal.
+/// Interior nodes store the union of the category bitmasks of their subtree, so queries skip whole subtrees that don't contain
+/// any of the requested categories. Node tests against frustums are done with SIMD plane data, and subtrees that are completely
+/// inside the frustum are accepted without testing the individual objects against the planes.
+///
+/// Shape queries test objects against both their bounding box and their bounding sphere, so they report fewer false positives
+/// than plSpatialSystem_RegularGrid, which only uses the sphere.
+///
+/// Objects in categories with plSpatialData::Flags::FrequentChanges get an enlarged leaf box. As long as the object stays inside
+/// that box, bounds updates don't modify the tree at all. Small movements beyond it refit the leaf and its ancestors in place,
+/// only objects that leave the box of their parent node are removed and re-inserted.
+///
+/// Compared to plSpatialSystem_RegularGrid there is no limit on the world extents and no cell size to tune, which makes it a good fit
+/// for worlds with very uneven object distribution. To use it for a world, set plWorldDesc::m_pSpatialSystem.
+class PL_CORE_DLL plSpatialSystem_Bvh : public plSpatialSystem
+{
+  PL_ADD_DYNAMIC_REFLECTION(plSpatialSystem_Bvh, plSpatialSystem);
+
+public:
+  /// \param fLooseness Fraction of the half extents by which leaf boxes of frequently changing objects are enlarged.
+  plSpatialSystem_Bvh(float fLooseness = 0.25f);
+  ~plSpatialSystem_Bvh();
+
+  /// \brief Returns the bounding boxes of all tree nodes that contain data of the given category. Useful for debug visualizations.
+  void GetAllNodeBoxes(plDynamicArray<plBoundingBox>& out_boundingBoxes, plSpatialData::Category filterCategory = plInvalidSpatialDataCategory) const;
+
+private:
+  friend plInternal::BvhQueryHelper;
+
+  // plSpatialSystem implementation
+  plSpatialDataHandle CreateSpatialData(const plSimdBBoxSphere& bounds, plGameObject* pObject, plUInt32 uiCategoryBitmask, const plTagSet& tags) override;
+  plSpatialDataHandle CreateSpatialDataAlwaysVisible(plGameObject* pObject, plUInt32 uiCategoryBitmask, const plTagSet& tags) override;
+
+  void DeleteSpatialData(const plSpatialDataHandle& hData) override;
+
+  void UpdateSpatialDataBounds(const plSpatialDataHandle& hData, const plSimdBBoxSphere& bounds) override;
+  void UpdateSpatialDataObject(const plSpatialDataHandle& hData, plGameObject* pObject) override;
+
+  void FindObjectsInSphere(const plBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const override;
+  void FindObjectsInBox(const plBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const override;
+
+  void FindVisibleObjects(const plFrustum& frustum, const QueryParams& queryParams, plDynamicArray<const plGameObject*>& out_Objects, plSpatialSystem::IsOccludedFunc IsOccluded, plVisibilityState visType) const override;
+
+  plVisibilityState GetVisibilityState(const plSpatialDataHandle& hData, plUInt32 uiNumFramesBeforeInvisible) const override;
+
+#if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
+  virtual void GetInternalStats(plStringBuilder& sb) const override;
+#endif
+
+  struct Node
+  {
+    PL_DECLARE_POD_TYPE();
+
+    PL_ALWAYS_INLINE bool IsLeaf() const { return m_uiChildren[0] == plInvalidIndex; }
+
+    plSimdBBox m_Box;
+    plUInt32 m_uiParent;      ///< Next free node for nodes in the free list
+    plUInt32 m_uiChildren[2]; ///< Both invalid for leaves
+    plUInt32 m_uiCategoryBitmask;
+    plUInt32 m_uiHeight;      ///< 0 for leaves
+    plUInt32 m_uiDataIndex;   ///< Instance index of the spatial data for leaves
+  };
+
+  struct Data
+  {
+    PL_DECLARE_POD_TYPE();
+
+    plUInt32 m_uiNodeIndex; ///< plInvalidIndex for always visible data
+    plUInt32 m_uiCategoryBitmask;
+  };
+
+  plUInt32 AllocateNode();
+  void FreeNode(plUInt32 uiNodeIndex);
+
+  void InsertLeaf(plUInt32 uiLeafIndex);
+  void RemoveLeaf(plUInt32 uiLeafIndex);
+  void RefitAncestors(plUInt32 uiNodeIndex);
+  void UpdateNodeFromChildren(plUInt32 uiNodeIndex);
+  plUInt32 Balance(plUInt32 uiNodeIndex);
+
+  plSimdBBox ComputeLeafBox(const plSimdBBoxSphere& bounds, plUInt32 uiCategoryBitmask) const;
+
+  plProxyAllocator m_AlignedAllocator;
+  plSimdFloat m_fLooseness;
+
+  plDynamicArray<Node> m_Nodes;
+  plUInt32 m_uiRootNode = plInvalidIndex;
+  plUInt32 m_uiFirstFreeNode = plInvalidIndex;
+
+  plIdTable<plSpatialDataId, Data, plLocalAllocatorWrapper> m_DataTable;
+
+  // object data, indexed by the instance index of the spatial data id
+  plDynamicArray<plSimdBSphere> m_BoundingSpheres;
+  plDynamicArray<plSimdVec4f> m_BoundingBoxHalfExtents;
+  plDynamicArray<plTagSet> m_TagSets;
+  plDynamicArray<plGameObject*> m_ObjectPointers;
+  mutable plDynamicArray<plAtomicInteger64> m_LastVisibleFrameIdxAndVisType;
+
+  plDynamicArray<plUInt32> m_AlwaysVisibleData;
+};
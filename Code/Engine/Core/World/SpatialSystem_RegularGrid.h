@@ -36,6 +36,7 @@ private:
   void DeleteSpatialData(const plSpatialDataHandle& hData) override;
 
   void UpdateSpatialDataBounds(const plSpatialDataHandle& hData, const plSimdBBoxSphere& bounds) override;
+  void UpdateSpatialDataBoundsBatch(plArrayPtr<const BoundsUpdate> updates) override;
   void UpdateSpatialDataObject(const plSpatialDataHandle& hData, plGameObject* pObject) override;
 
   void FindObjectsInSphere(const plBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const override;
@@ -79,6 +80,8 @@ private:
 
   bool IsAlwaysVisibleData(const Data& data) const;
 
+  void UpdateSpatialDataBounds(const Data& data, const plSpatialDataHandle& hData, const plSimdBBoxSphere& bounds);
+
   plSpatialDataHandle AddSpatialDataToGrids(const plSimdBBoxSphere& bounds, plGameObject* pObject, plUInt32 uiCategoryBitmask, const plTagSet& tags, bool bAlwaysVisible);
 
   template <typename Functor>
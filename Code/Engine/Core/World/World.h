@@ -11,8 +11,8 @@ class plEventMessageHandlerComponent;
 /// in memory. Thus it is not allowed to store pointers to objects. They should be referenced by handles.\n The world has a multi-phase
 /// update mechanism which is divided in the following phases:\n
 /// * Pre-async phase: The corresponding component manager update functions are called synchronously in the order of their dependencies.
-/// * Async phase: The update functions are called in batches asynchronously on multiple threads. There is absolutely no guarantee in which
-/// order the functions are called.
+/// * Async phase: The update functions are called in batches asynchronously on multiple threads. Apart from the declared dependencies
+/// there is absolutely no guarantee in which order the functions are called. A function only waits for the functions it depends on, not for the whole phase.
 ///   Thus it is not allowed to access any data other than the components own data during that phase.
 /// * Post-async phase: Another synchronous phase like the pre-async phase.
 /// * Actual deletion of dead objects and components are done now.
@@ -19,7 +19,7 @@ struct plWorldDesc
   plHashedString m_sName;
   plUInt64 m_uiRandomNumberGeneratorSeed = 0;
 
-  plUniquePtr<plSpatialSystem> m_pSpatialSystem;
+  plUniquePtr<plSpatialSystem> m_pSpatialSystem; ///< e.g. plSpatialSystem_RegularGrid (the default) or plSpatialSystem_Bvh
   bool m_bAutoCreateSpatialSystem = true; ///< automatically create a default spatial system if none is set
 
   plSharedPtr<plCoordinateSystemProvider> m_pCoordinateSystemProvider;
@@ -67,7 +67,8 @@ protected:
     plHashedString m_sFunctionName;               ///< Name of the function. Use the PL_CREATE_MODULE_UPDATE_FUNCTION_DESC macro to create a description
                                                   ///< with the correct name.
     plHybridArray<plHashedString, 4> m_DependsOn; ///< Array of other functions on which this function depends on. This function will be
-                                                  ///< called after all its dependencies have been called.
+                                                  ///< called after all its dependencies have been called. Dependencies must be in the same phase.
+                                                  ///< In the async phase this function is scheduled as soon as all its dependencies have finished.
     plEnum<Phase> m_Phase;                        ///< The update phase in which this update function should be called. See plWorld for a description on the
                                                   ///< different phases.
     bool m_bOnlyUpdateWhenSimulating = false;     ///< The update function is only called when the world simulation is enabled.
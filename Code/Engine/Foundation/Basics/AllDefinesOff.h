@@ -69,10 +69,12 @@
 
 // Allocators
 #define PL_ALLOC_GUARD_ALLOCATIONS PL_OFF
+#define PL_ALLOC_THREAD_CACHING PL_OFF
 #define PL_ALLOC_TRACKING_DEFAULT plAllocatorTrackingMode::Nothing
 
 // Other Features
 #define PL_USE_PROFILING PL_OFF
+#define PL_EXPRESSIONVM_WIDE_SIMD PL_OFF
 
 // Hashed String
 /// \brief Ref counting on hashed strings adds the possibility to cleanup unused strings. Since ref counting has a performance overhead it is disabled
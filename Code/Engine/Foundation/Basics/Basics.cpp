@@ -6,6 +6,10 @@
 using DefaultHeapType = plGuardingAllocator;
 using DefaultAlignedHeapType = plGuardingAllocator;
 using DefaultStaticsHeapType = plAllocatorWithPolicy<plAllocPolicyGuarding, plAllocatorTrackingMode::AllocationStatsIgnoreLeaks>;
+#elif PL_ENABLED(PL_ALLOC_THREAD_CACHING)
+using DefaultHeapType = plThreadCachingHeapAllocator;
+using DefaultAlignedHeapType = plThreadCachingHeapAllocator;
+using DefaultStaticsHeapType = plAllocatorWithPolicy<plAllocPolicyHeap, plAllocatorTrackingMode::AllocationStatsIgnoreLeaks>;
 #else
 using DefaultHeapType = plHeapAllocator;
 using DefaultAlignedHeapType = plAlignedHeapAllocator;
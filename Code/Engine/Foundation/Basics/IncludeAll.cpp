@@ -123,6 +123,7 @@
 #include <Foundation/Memory/Policies/AllocPolicyHeap.h>
 #include <Foundation/Memory/Policies/AllocPolicyProxy.h>
 #include <Foundation/Memory/Policies/AllocPolicyStack.h>
+#include <Foundation/Memory/Policies/AllocPolicyThreadCaching.h>
 
 #include <Foundation/Profiling/Profiling.h>
 
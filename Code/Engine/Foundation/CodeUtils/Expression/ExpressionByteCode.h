@@ -210,6 +210,11 @@ public:
 
   void Disassemble(plStringBuilder& out_sDisassembly) const;
 
+  /// \brief Returns a hash of the instructions and the input, output and function declarations. Stable across processes and platforms.
+  ///
+  /// The hash is computed once when the byte code is created or loaded.
+  plUInt64 GetHash() const { return m_uiHash; }
+
   plResult Save(plStreamWriter& inout_stream) const;
   plResult Load(plStreamReader& inout_stream, plByteArrayPtr externalMemory = plByteArrayPtr());
 
@@ -219,6 +224,7 @@ private:
   friend class plExpressionCompiler;
 
   void Init(plArrayPtr<const StorageType> byteCode, plArrayPtr<const plExpression::StreamDesc> inputs, plArrayPtr<const plExpression::StreamDesc> outputs, plArrayPtr<const plExpression::FunctionDesc> functions, plUInt32 uiNumTempRegisters, plUInt32 uiNumInstructions);
+  plUInt64 CalculateHash() const;
 
   plBlob m_Data;
 
@@ -234,10 +240,12 @@ private:
 
   plUInt16 m_uiNumTempRegisters = 0;
   plUInt32 m_uiNumInstructions = 0;
+
+  plUInt64 m_uiHash = 0;
 };
 
 #if PL_ENABLED(PL_PLATFORM_64BIT)
-static_assert(sizeof(plExpressionByteCode) == 64);
+static_assert(sizeof(plExpressionByteCode) == 72);
 #endif
 
 PL_DECLARE_REFLECTABLE_TYPE(PL_FOUNDATION_DLL, plExpressionByteCode);
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Foundation/CodeUtils/Expression/ExpressionByteCode.h>
+#include <Foundation/Utilities/EnumerableClass.h>
+
+class plStringBuilder;
+
+/// \brief Everything natively compiled expression code needs to access during execution.
+struct plExpressionNativeContext
+{
+  plUInt32 m_uiNumInstances = 0;
+  plExpression::Register* m_pTempRegisters = nullptr; ///< NumTempRegisters * plExpressionNativeCode::BlockSize registers
+  plArrayPtr<const plProcessingStream*> m_Inputs;
+  plArrayPtr<plProcessingStream*> m_Outputs;
+  plArrayPtr<const plExpressionFunction*> m_Functions;
+  const plExpression::GlobalData* m_pGlobalData = nullptr;
+};
+
+using plExpressionNativeFunc = void (*)(const plExpressionNativeContext& context);
+
+/// \brief Natively compiled code for one specific expression byte code.
+///
+/// GenerateCpp() turns a byte code into C++ code that executes all instructions back to back without the dispatch loop of plExpressionVM.
+/// The generated code processes blocks of BlockSize registers, so temp registers stay in the cache, and uses the same SIMD operations
+/// as the VM, so the results are bit-identical. The generated file contains a static instance of this class, which means the code is registered
+/// as soon as the library that it was compiled into is loaded. plExpressionVM::Execute looks up the native code by the hash of the byte code
+/// (plExpressionByteCode::GetHash()) and falls back to interpreting the byte code if there is none.
+class PL_FOUNDATION_DLL plExpressionNativeCode : public plEnumerable<plExpressionNativeCode>
+{
+  PL_DECLARE_ENUMERABLE_CLASS(plExpressionNativeCode);
+
+public:
+  static constexpr plUInt32 BlockSize = 64;
+
+  plExpressionNativeCode(plUInt64 uiByteCodeHash, plExpressionNativeFunc func);
+
+  plUInt64 GetByteCodeHash() const { return m_uiByteCodeHash; }
+  plExpressionNativeFunc GetFunction() const { return m_Func; }
+
+  /// \brief Returns the registered native code for the given byte code hash or nullptr if there is none.
+  static plExpressionNativeFunc FindFunction(plUInt64 uiByteCodeHash);
+
+  /// \brief Returns true if any native code is registered. plExpressionVM::Execute uses it to skip the lookup when there is nothing to find.
+  static bool HasAnyFunctions() { return GetFirstInstance() != nullptr; }
+
+  /// \brief Writes a C++ file that implements the given byte code and registers it under the byte code hash.
+  ///
+  /// sFunctionName has to be a valid C++ identifier. The generated file only depends on Foundation and can be compiled into any plugin.
+  static plResult GenerateCpp(const plExpressionByteCode& byteCode, plStringView sFunctionName, plStringBuilder& out_sCode);
+
+  /// \name Helpers used by generated code
+  ///@{
+
+  static plExpression::Register MakeConstant(plUInt32 uiRawValue);
+
+  static void LoadF(const plExpressionNativeContext& context, plUInt32 uiInputIndex, plUInt32 uiFirstInstance, plUInt32 uiNumInstances, plExpression::Register* r);
+  static void LoadI(const plExpressionNativeContext& context, plUInt32 uiInputIndex, plUInt32 uiFirstInstance, plUInt32 uiNumInstances, plExpression::Register* r);
+  static void StoreF(const plExpressionNativeContext& context, plUInt32 uiOutputIndex, plUInt32 uiFirstInstance, plUInt32 uiNumInstances, const plExpression::Register* r);
+  static void StoreI(const plExpressionNativeContext& context, plUInt32 uiOutputIndex, plUInt32 uiFirstInstance, plUInt32 uiNumInstances, const plExpression::Register* r);
+
+  static void Call(const plExpressionNativeContext& context, plUInt32 uiFunctionIndex, plArrayPtr<const plExpression::Register* const> args, plUInt32 uiNumRegisters, plExpression::Register* r);
+
+  ///@}
+
+private:
+  plUInt64 m_uiByteCodeHash = 0;
+  plExpressionNativeFunc m_Func = nullptr;
+};
+
+PL_ALWAYS_INLINE plExpression::Register plExpressionNativeCode::MakeConstant(plUInt32 uiRawValue)
+{
+  plExpression::Register r;
+  r.i = plSimdVec4i(uiRawValue);
+  return r;
+}
@@ -20,6 +20,7 @@ public:
     {
       MapStreamsByName = PL_BIT(0),
       ScalarizeStreams = PL_BIT(1),
+      DisableNativeCode = PL_BIT(2), ///< Always interpret the byte code, even if native code is registered for it. See plExpressionNativeCode.
 
       UserFriendly = MapStreamsByName | ScalarizeStreams,
       BestPerformance = 0,
@@ -31,9 +32,34 @@ public:
     {
       StorageType MapStreamsByName : 1;
       StorageType ScalarizeStreams : 1;
+      StorageType DisableNativeCode : 1;
     };
   };
 
+  /// \brief How many instances are processed per operation.
+  ///
+  /// The wide variants use AVX2 (8 instances) or AVX-512 (16 instances) and are only available on x86 builds with PL_EXPRESSIONVM_WIDE_SIMD enabled.
+  /// Execute uses the widest variant that is allowed by SetMaxSimdWidth() and supported by the CPU. The results are the same for all widths.
+  struct SimdWidth
+  {
+    using StorageType = plUInt8;
+
+    enum Enum
+    {
+      Simd4 = 4,
+      Simd8 = 8,
+      Simd16 = 16,
+
+      Default = Simd16
+    };
+  };
+
+  void SetMaxSimdWidth(SimdWidth::Enum width) { m_MaxSimdWidth = width; }
+  SimdWidth::Enum GetMaxSimdWidth() const { return m_MaxSimdWidth; }
+
+  /// \brief Returns the widest SIMD width that this build and the CPU it runs on support.
+  static SimdWidth::Enum GetSupportedSimdWidth();
+
   plResult Execute(const plExpressionByteCode& byteCode, plArrayPtr<const plProcessingStream> inputs, plArrayPtr<plProcessingStream> outputs, plUInt32 uiNumInstances, const plExpression::GlobalData& globalData = plExpression::GlobalData(), plBitflags<Flags> flags = Flags::Default);
 
 private:
@@ -47,6 +73,8 @@ private:
   static plResult MapStreams(plArrayPtr<const plExpression::StreamDesc> streamDescs, plArrayPtr<T> streams, plStringView sStreamType, plUInt32 uiNumInstances, plBitflags<Flags> flags, plDynamicArray<T*>& out_MappedStreams);
   plResult MapFunctions(plArrayPtr<const plExpression::FunctionDesc> functionDescs, const plExpression::GlobalData& globalData);
 
+  plEnum<SimdWidth> m_MaxSimdWidth;
+
   plDynamicArray<plExpression::Register, plAlignedAllocatorWrapper> m_Registers;
 
   plDynamicArray<plProcessingStream> m_ScalarizedInputs;
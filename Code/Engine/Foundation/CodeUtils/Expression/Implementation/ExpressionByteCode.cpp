@@ -240,6 +240,8 @@ void plExpressionByteCode::Clear()
   m_uiNumTempRegisters = 0;
   m_uiNumInstructions = 0;
 
+  m_uiHash = 0;
+
   m_Data.Clear();
 }
 
@@ -390,6 +392,42 @@ void plExpressionByteCode::Disassemble(plStringBuilder& out_sDisassembly) const
   }
 }
 
+plUInt64 plExpressionByteCode::CalculateHash() const
+{
+  plUInt64 uiHash = plHashingUtils::xxHash64(m_pByteCode, m_uiByteCodeCount * sizeof(StorageType));
+
+  auto AddToHash = [&](plUInt64 uiValue)
+  {
+    uiHash = plHashingUtils::xxHash64(&uiValue, sizeof(uiValue), uiHash);
+  };
+
+  AddToHash(m_uiNumTempRegisters);
+
+  for (auto& streamDesc : GetInputs())
+  {
+    AddToHash(streamDesc.m_sName.GetHash());
+    AddToHash(static_cast<plUInt64>(streamDesc.m_DataType));
+  }
+
+  for (auto& streamDesc : GetOutputs())
+  {
+    AddToHash(streamDesc.m_sName.GetHash());
+    AddToHash(static_cast<plUInt64>(streamDesc.m_DataType));
+  }
+
+  for (auto& functionDesc : GetFunctions())
+  {
+    AddToHash(functionDesc.m_sName.GetHash());
+    AddToHash(functionDesc.m_OutputType);
+    for (auto inputType : functionDesc.m_InputTypes)
+    {
+      AddToHash(inputType);
+    }
+  }
+
+  return uiHash;
+}
+
 static constexpr plTypeVersion s_uiByteCodeVersion = 6;
 
 plResult plExpressionByteCode::Save(plStreamWriter& inout_stream) const
@@ -513,6 +551,8 @@ plResult plExpressionByteCode::Load(plStreamReader& inout_stream, plByteArrayPtr
   inout_stream >> m_uiNumTempRegisters;
   inout_stream >> m_uiNumInstructions;
 
+  m_uiHash = CalculateHash();
+
   return PL_SUCCESS;
 }
 
@@ -562,4 +602,6 @@ void plExpressionByteCode::Init(plArrayPtr<const StorageType> byteCode, plArrayP
   PL_ASSERT_DEV(uiNumTempRegisters < plSmallInvalidIndex, "Too many temp registers");
   m_uiNumTempRegisters = static_cast<plUInt16>(uiNumTempRegisters);
   m_uiNumInstructions = uiNumInstructions;
+
+  m_uiHash = CalculateHash();
 }
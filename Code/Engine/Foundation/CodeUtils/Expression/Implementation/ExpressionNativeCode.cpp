@@ -0,0 +1,455 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/CodeUtils/Expression/ExpressionNativeCode.h>
+#include <Foundation/CodeUtils/Expression/Implementation/ExpressionVMOperations.h>
+
+PL_ENUMERABLE_CLASS_IMPLEMENTATION(plExpressionNativeCode);
+
+namespace
+{
+  // C++ code for one instruction. {0} is the target register, {1} to {3} are the operands. Needs to match ExpressionVMOperations.h exactly.
+  static const char* s_szOpCodeCpp[] = {
+    nullptr, // Nop,
+
+    nullptr, // FirstUnary,
+
+    "{0}.f = {1}.f.Abs()",     // AbsF_R,
+    "{0}.i = {1}.i.Abs()",     // AbsI_R,
+    "{0}.f = {1}.f.GetSqrt()", // SqrtF_R,
+
+    "{0}.f = plSimdMath::Exp({1}.f)",   // ExpF_R,
+    "{0}.f = plSimdMath::Ln({1}.f)",    // LnF_R,
+    "{0}.f = plSimdMath::Log2({1}.f)",  // Log2F_R,
+    "{0}.i = plSimdMath::Log2i({1}.i)", // Log2I_R,
+    "{0}.f = plSimdMath::Log10({1}.f)", // Log10F_R,
+    "{0}.f = plSimdMath::Pow2({1}.f)",  // Pow2F_R,
+
+    "{0}.f = plSimdMath::Sin({1}.f)", // SinF_R,
+    "{0}.f = plSimdMath::Cos({1}.f)", // CosF_R,
+    "{0}.f = plSimdMath::Tan({1}.f)", // TanF_R,
+
+    "{0}.f = plSimdMath::ASin({1}.f)", // ASinF_R,
+    "{0}.f = plSimdMath::ACos({1}.f)", // ACosF_R,
+    "{0}.f = plSimdMath::ATan({1}.f)", // ATanF_R,
+
+    "{0}.f = {1}.f.Round()", // RoundF_R,
+    "{0}.f = {1}.f.Floor()", // FloorF_R,
+    "{0}.f = {1}.f.Ceil()",  // CeilF_R,
+    "{0}.f = {1}.f.Trunc()", // TruncF_R,
+
+    "{0}.i = ~{1}.i", // NotI_R,
+    "{0}.b = !{1}.b", // NotB_R,
+
+    "{0}.f = {1}.i.ToFloat()",              // IToF_R,
+    "{0}.i = plSimdVec4i::Truncate({1}.f)", // FToI_R,
+
+    nullptr, // LastUnary,
+    nullptr, // FirstBinary,
+
+    "{0}.f = {1}.f + {2}.f", // AddF_RR,
+    "{0}.i = {1}.i + {2}.i", // AddI_RR,
+
+    "{0}.f = {1}.f - {2}.f", // SubF_RR,
+    "{0}.i = {1}.i - {2}.i", // SubI_RR,
+
+    "{0}.f = {1}.f.CompMul({2}.f)", // MulF_RR,
+    "{0}.i = {1}.i.CompMul({2}.i)", // MulI_RR,
+
+    "{0}.f = {1}.f.CompDiv({2}.f)", // DivF_RR,
+    "{0}.i = {1}.i.CompDiv({2}.i)", // DivI_RR,
+
+    "{0}.f = {1}.f.CompMin({2}.f)", // MinF_RR,
+    "{0}.i = {1}.i.CompMin({2}.i)", // MinI_RR,
+
+    "{0}.f = {1}.f.CompMax({2}.f)", // MaxF_RR,
+    "{0}.i = {1}.i.CompMax({2}.i)", // MaxI_RR,
+
+    "{0}.i = {1}.i << {2}.i", // ShlI_RR,
+    "{0}.i = {1}.i >> {2}.i", // ShrI_RR,
+    "{0}.i = {1}.i & {2}.i",  // AndI_RR,
+    "{0}.i = {1}.i ^ {2}.i",  // XorI_RR,
+    "{0}.i = {1}.i | {2}.i",  // OrI_RR,
+
+    "{0}.b = {1}.f == {2}.f", // EqF_RR,
+    "{0}.b = {1}.i == {2}.i", // EqI_RR,
+    "{0}.b = {1}.b == {2}.b", // EqB_RR,
+
+    "{0}.b = {1}.f != {2}.f", // NEqF_RR,
+    "{0}.b = {1}.i != {2}.i", // NEqI_RR,
+    "{0}.b = {1}.b != {2}.b", // NEqB_RR,
+
+    "{0}.b = {1}.f < {2}.f", // LtF_RR,
+    "{0}.b = {1}.i < {2}.i", // LtI_RR,
+
+    "{0}.b = {1}.f <= {2}.f", // LEqF_RR,
+    "{0}.b = {1}.i <= {2}.i", // LEqI_RR,
+
+    "{0}.b = {1}.f > {2}.f", // GtF_RR,
+    "{0}.b = {1}.i > {2}.i", // GtI_RR,
+
+    "{0}.b = {1}.f >= {2}.f", // GEqF_RR,
+    "{0}.b = {1}.i >= {2}.i", // GEqI_RR,
+
+    "{0}.b = {1}.b && {2}.b", // AndB_RR,
+    "{0}.b = {1}.b || {2}.b", // OrB_RR,
+
+    nullptr, // LastBinary,
+    nullptr, // FirstBinaryWithConstant,
+
+    "{0}.f = {1}.f + {2}.f", // AddF_RC,
+    "{0}.i = {1}.i + {2}.i", // AddI_RC,
+
+    "{0}.f = {1}.f - {2}.f", // SubF_RC,
+    "{0}.i = {1}.i - {2}.i", // SubI_RC,
+
+    "{0}.f = {1}.f.CompMul({2}.f)", // MulF_RC,
+    "{0}.i = {1}.i.CompMul({2}.i)", // MulI_RC,
+
+    "{0}.f = {1}.f.CompDiv({2}.f)", // DivF_RC,
+    "{0}.i = {1}.i.CompDiv({2}.i)", // DivI_RC,
+
+    "{0}.f = {1}.f.CompMin({2}.f)", // MinF_RC,
+    "{0}.i = {1}.i.CompMin({2}.i)", // MinI_RC,
+
+    "{0}.f = {1}.f.CompMax({2}.f)", // MaxF_RC,
+    "{0}.i = {1}.i.CompMax({2}.i)", // MaxI_RC,
+
+    "{0}.i = {1}.i << {2}Raw", // ShlI_RC,
+    "{0}.i = {1}.i >> {2}Raw", // ShrI_RC,
+    "{0}.i = {1}.i & {2}.i",   // AndI_RC,
+    "{0}.i = {1}.i ^ {2}.i",   // XorI_RC,
+    "{0}.i = {1}.i | {2}.i",   // OrI_RC,
+
+    "{0}.b = {1}.f == {2}.f", // EqF_RC,
+    "{0}.b = {1}.i == {2}.i", // EqI_RC,
+    "{0}.b = {1}.b == {2}.b", // EqB_RC
+
+    "{0}.b = {1}.f != {2}.f", // NEqF_RC,
+    "{0}.b = {1}.i != {2}.i", // NEqI_RC,
+    "{0}.b = {1}.b != {2}.b", // NEqB_RC
+
+    "{0}.b = {1}.f < {2}.f", // LtF_RC,
+    "{0}.b = {1}.i < {2}.i", // LtI_RC
+
+    "{0}.b = {1}.f <= {2}.f", // LEqF_RC,
+    "{0}.b = {1}.i <= {2}.i", // LEqI_RC
+
+    "{0}.b = {1}.f > {2}.f", // GtF_RC,
+    "{0}.b = {1}.i > {2}.i", // GtI_RC
+
+    "{0}.b = {1}.f >= {2}.f", // GEqF_RC,
+    "{0}.b = {1}.i >= {2}.i", // GEqI_RC
+
+    "{0}.b = {1}.b && {2}.b", // AndB_RC,
+    "{0}.b = {1}.b || {2}.b", // OrB_RC,
+
+    nullptr, // LastBinaryWithConstant,
+    nullptr, // FirstTernary,
+
+    "{0}.f = plSimdVec4f::Select({1}.b, {2}.f, {3}.f)", // SelF_RRR,
+    "{0}.i = plSimdVec4i::Select({1}.b, {2}.i, {3}.i)", // SelI_RRR,
+    "{0}.b = plSimdVec4b::Select({1}.b, {2}.b, {3}.b)", // SelB_RRR,
+
+    nullptr, // LastTernary,
+    nullptr, // FirstSpecial,
+
+    "{0}.i = {1}.i", // MovX_R,
+    "{0}.i = {1}.i", // MovX_C,
+    nullptr,         // LoadF,
+    nullptr,         // LoadI,
+    nullptr,         // StoreF,
+    nullptr,         // StoreI,
+
+    nullptr, // Call,
+
+    nullptr, // LastSpecial,
+  };
+
+  static_assert(PL_ARRAY_SIZE(s_szOpCodeCpp) == plExpressionByteCode::OpCode::Count);
+} // namespace
+
+plExpressionNativeCode::plExpressionNativeCode(plUInt64 uiByteCodeHash, plExpressionNativeFunc func)
+  : m_uiByteCodeHash(uiByteCodeHash)
+  , m_Func(func)
+{
+}
+
+// static
+plExpressionNativeFunc plExpressionNativeCode::FindFunction(plUInt64 uiByteCodeHash)
+{
+  for (plExpressionNativeCode* pCode = GetFirstInstance(); pCode != nullptr; pCode = pCode->GetNextInstance())
+  {
+    if (pCode->m_uiByteCodeHash == uiByteCodeHash)
+      return pCode->m_Func;
+  }
+
+  return nullptr;
+}
+
+// static
+plResult plExpressionNativeCode::GenerateCpp(const plExpressionByteCode& byteCode, plStringView sFunctionName, plStringBuilder& out_sCode)
+{
+  using OpCode = plExpressionByteCode::OpCode;
+
+  plStringBuilder sDisassembly;
+  byteCode.Disassemble(sDisassembly);
+
+  out_sCode.Clear();
+  out_sCode.Append("// Generated by plExpressionNativeCode::GenerateCpp(). Do not edit, regenerate it from the byte code instead.\n\n");
+
+  // Keep the disassembly as a comment so it is easy to see what the generated code does
+  plHybridArray<plStringView, 64> disassemblyLines;
+  sDisassembly.Split(false, disassemblyLines, "\n");
+  for (plStringView sLine : disassemblyLines)
+  {
+    out_sCode.Append(sLine.StartsWith("//") ? "" : "// ", sLine, "\n");
+  }
+  out_sCode.Append("\n");
+  out_sCode.Append("#include <Foundation/CodeUtils/Expression/ExpressionNativeCode.h>\n");
+  out_sCode.Append("#include <Foundation/SimdMath/SimdMath.h>\n\n");
+  out_sCode.Append("namespace\n{\n");
+  out_sCode.AppendFormat("  void {}(const plExpressionNativeContext& context)\n", sFunctionName);
+  out_sCode.Append("  {\n");
+
+  for (plUInt32 i = 0; i < byteCode.GetNumTempRegisters(); ++i)
+  {
+    out_sCode.AppendFormat("    plExpression::Register* r{0} = context.m_pTempRegisters + {0} * plExpressionNativeCode::BlockSize;\n", i);
+  }
+
+  plStringBuilder sConstants;
+  plStringBuilder sBlock;
+  plStringBuilder sTmp;
+  plStringBuilder sOperands[4];
+  plUInt32 uiNumConstants = 0;
+
+  auto RegisterOperand = [](plUInt32 uiIndex, plStringBuilder& out_sOperand)
+  {
+    out_sOperand.SetFormat("r{}[i]", uiIndex);
+  };
+
+  auto ConstantOperand = [&](plUInt32 uiRawValue, plStringBuilder& out_sOperand)
+  {
+    out_sOperand.SetFormat("c{}", uiNumConstants);
+    sConstants.AppendFormat("    const plUInt32 c{0}Raw = 0x{1}u;\n", uiNumConstants, plArgU(uiRawValue, 8, true, 16));
+    sConstants.AppendFormat("    const plExpression::Register c{0} = plExpressionNativeCode::MakeConstant(c{0}Raw);\n", uiNumConstants);
+    ++uiNumConstants;
+  };
+
+  auto AppendLoop = [&](const char* szCode, plUInt32 uiNumOperands)
+  {
+    sTmp.SetFormat(szCode, sOperands[0], sOperands[1], uiNumOperands > 2 ? sOperands[2].GetView() : "", uiNumOperands > 3 ? sOperands[3].GetView() : "");
+    sBlock.AppendFormat("      for (plUInt32 i = 0; i < uiNumRegisters; ++i)\n        {};\n", sTmp);
+  };
+
+  const plExpressionByteCode::StorageType* pByteCode = byteCode.GetByteCodeStart();
+  const plExpressionByteCode::StorageType* pByteCodeEnd = byteCode.GetByteCodeEnd();
+
+  while (pByteCode < pByteCodeEnd)
+  {
+    const OpCode::Enum opCode = plExpressionByteCode::GetOpCode(pByteCode);
+    sBlock.AppendFormat("\n      // {}\n", OpCode::GetName(opCode));
+
+    if (opCode > OpCode::FirstUnary && opCode < OpCode::LastUnary)
+    {
+      RegisterOperand(plExpressionByteCode::GetRegisterIndex(pByteCode), sOperands[0]);
+      RegisterOperand(plExpressionByteCode::GetRegisterIndex(pByteCode), sOperands[1]);
+      AppendLoop(s_szOpCodeCpp[opCode], 2);
+    }
+    else if (opCode > OpCode::FirstBinary && opCode < OpCode::LastBinary)
+    {
+      RegisterOperand(plExpressionByteCode::GetRegisterIndex(pByteCode), sOperands[0]);
+      RegisterOperand(plExpressionByteCode::GetRegisterIndex(pByteCode), sOperands[1]);
+      RegisterOperand(plExpressionByteCode::GetRegisterIndex(pByteCode), sOperands[2]);
+      AppendLoop(s_szOpCodeCpp[opCode], 3);
+    }
+    else if (opCode > OpCode::FirstBinaryWithConstant && opCode < OpCode::LastBinaryWithConstant)
+    {
+      RegisterOperand(plExpressionByteCode::GetRegisterIndex(pByteCode), sOperands[0]);
+      RegisterOperand(plExpressionByteCode::GetRegisterIndex(pByteCode), sOperands[1]);
+      ConstantOperand(*pByteCode, sOperands[2]);
+      ++pByteCode;
+      AppendLoop(s_szOpCodeCpp[opCode], 3);
+    }
+    else if (opCode > OpCode::FirstTernary && opCode < OpCode::LastTernary)
+    {
+      RegisterOperand(plExpressionByteCode::GetRegisterIndex(pByteCode), sOperands[0]);
+      RegisterOperand(plExpressionByteCode::GetRegisterIndex(pByteCode), sOperands[1]);
+      RegisterOperand(plExpressionByteCode::GetRegisterIndex(pByteCode), sOperands[2]);
+      RegisterOperand(plExpressionByteCode::GetRegisterIndex(pByteCode), sOperands[3]);
+      AppendLoop(s_szOpCodeCpp[opCode], 4);
+    }
+    else if (opCode == OpCode::MovX_R)
+    {
+      RegisterOperand(plExpressionByteCode::GetRegisterIndex(pByteCode), sOperands[0]);
+      RegisterOperand(plExpressionByteCode::GetRegisterIndex(pByteCode), sOperands[1]);
+      AppendLoop(s_szOpCodeCpp[opCode], 2);
+    }
+    else if (opCode == OpCode::MovX_C)
+    {
+      RegisterOperand(plExpressionByteCode::GetRegisterIndex(pByteCode), sOperands[0]);
+      ConstantOperand(*pByteCode, sOperands[1]);
+      ++pByteCode;
+      AppendLoop(s_szOpCodeCpp[opCode], 2);
+    }
+    else if (opCode == OpCode::LoadF || opCode == OpCode::LoadI)
+    {
+      const plUInt32 r = plExpressionByteCode::GetRegisterIndex(pByteCode);
+      const plUInt32 uiInputIndex = plExpressionByteCode::GetRegisterIndex(pByteCode);
+      sBlock.AppendFormat("      plExpressionNativeCode::{}(context, {}, uiFirstInstance, uiNumInstances, r{});\n", opCode == OpCode::LoadF ? "LoadF" : "LoadI", uiInputIndex, r);
+    }
+    else if (opCode == OpCode::StoreF || opCode == OpCode::StoreI)
+    {
+      const plUInt32 uiOutputIndex = plExpressionByteCode::GetRegisterIndex(pByteCode);
+      const plUInt32 r = plExpressionByteCode::GetRegisterIndex(pByteCode);
+      sBlock.AppendFormat("      plExpressionNativeCode::{}(context, {}, uiFirstInstance, uiNumInstances, r{});\n", opCode == OpCode::StoreF ? "StoreF" : "StoreI", uiOutputIndex, r);
+    }
+    else if (opCode == OpCode::Call)
+    {
+      const plUInt32 uiFunctionIndex = plExpressionByteCode::GetFunctionIndex(pByteCode);
+      const plUInt32 r = plExpressionByteCode::GetRegisterIndex(pByteCode);
+      const plUInt32 uiNumArgs = plExpressionByteCode::GetFunctionArgCount(pByteCode);
+
+      sTmp.Clear();
+      for (plUInt32 uiArgIndex = 0; uiArgIndex < uiNumArgs; ++uiArgIndex)
+      {
+        sTmp.AppendWithSeparator(", ", "r");
+        sTmp.AppendFormat("{}", plExpressionByteCode::GetRegisterIndex(pByteCode));
+      }
+
+      if (uiNumArgs > 0)
+      {
+        sBlock.AppendFormat("      {\n        const plExpression::Register* args[] = { {} };\n", sTmp);
+        sBlock.AppendFormat("        plExpressionNativeCode::Call(context, {}, plMakeArrayPtr(args), uiNumRegisters, r{});\n      }\n", uiFunctionIndex, r);
+      }
+      else
+      {
+        sBlock.AppendFormat("      plExpressionNativeCode::Call(context, {}, plArrayPtr<const plExpression::Register* const>(), uiNumRegisters, r{});\n", uiFunctionIndex, r);
+      }
+    }
+    else
+    {
+      plLog::Error("Can't generate native code for unknown OpCode '{}'.", opCode);
+      return PL_FAILURE;
+    }
+  }
+
+  out_sCode.Append(sConstants, "\n");
+  out_sCode.Append("    for (plUInt32 uiFirstInstance = 0; uiFirstInstance < context.m_uiNumInstances; uiFirstInstance += plExpressionNativeCode::BlockSize * 4)\n    {\n");
+  out_sCode.Append("      const plUInt32 uiNumInstances = plMath::Min(context.m_uiNumInstances - uiFirstInstance, plExpressionNativeCode::BlockSize * 4);\n");
+  out_sCode.Append("      const plUInt32 uiNumRegisters = (uiNumInstances + 3) / 4;\n");
+  out_sCode.Append(sBlock);
+  out_sCode.Append("    }\n  }\n\n");
+  out_sCode.AppendFormat("  static plExpressionNativeCode s_{0}(0x{1}ull, &{0});\n", sFunctionName, plArgU(byteCode.GetHash(), 16, true, 16));
+  out_sCode.Append("} // namespace\n");
+
+  return PL_SUCCESS;
+}
+
+// static
+void plExpressionNativeCode::LoadF(const plExpressionNativeContext& context, plUInt32 uiInputIndex, plUInt32 uiFirstInstance, plUInt32 uiNumInstances, plExpression::Register* r)
+{
+  const plProcessingStream& input = *context.m_Inputs[uiInputIndex];
+  const plUInt8* pInputData = input.GetData<plUInt8>() + uiFirstInstance * input.GetElementStride();
+  const plUInt32 uiNumRemainderInstances = uiNumInstances & 0x3;
+
+  plSimdVec4f* pr = reinterpret_cast<plSimdVec4f*>(r);
+  plSimdVec4f* pre = pr + uiNumInstances / 4;
+
+  if (input.GetDataType() == plProcessingStream::DataType::Float)
+  {
+    LoadInput<plSimdVec4f, float, float>(pr, pre, pInputData, input.GetElementStride(), uiNumRemainderInstances);
+  }
+  else
+  {
+    PL_ASSERT_DEBUG(input.GetDataType() == plProcessingStream::DataType::Half, "Unsupported input type '{}' for LoadF instruction", plProcessingStream::GetDataTypeName(input.GetDataType()));
+    LoadInput<plSimdVec4f, float, plFloat16>(pr, pre, pInputData, input.GetElementStride(), uiNumRemainderInstances);
+  }
+}
+
+// static
+void plExpressionNativeCode::LoadI(const plExpressionNativeContext& context, plUInt32 uiInputIndex, plUInt32 uiFirstInstance, plUInt32 uiNumInstances, plExpression::Register* r)
+{
+  const plProcessingStream& input = *context.m_Inputs[uiInputIndex];
+  const plUInt8* pInputData = input.GetData<plUInt8>() + uiFirstInstance * input.GetElementStride();
+  const plUInt32 uiNumRemainderInstances = uiNumInstances & 0x3;
+
+  plSimdVec4i* pr = reinterpret_cast<plSimdVec4i*>(r);
+  plSimdVec4i* pre = pr + uiNumInstances / 4;
+
+  if (input.GetDataType() == plProcessingStream::DataType::Int)
+  {
+    LoadInput<plSimdVec4i, int, int>(pr, pre, pInputData, input.GetElementStride(), uiNumRemainderInstances);
+  }
+  else if (input.GetDataType() == plProcessingStream::DataType::Short)
+  {
+    LoadInput<plSimdVec4i, int, plInt16>(pr, pre, pInputData, input.GetElementStride(), uiNumRemainderInstances);
+  }
+  else
+  {
+    PL_ASSERT_DEBUG(input.GetDataType() == plProcessingStream::DataType::Byte, "Unsupported input type '{}' for LoadI instruction", plProcessingStream::GetDataTypeName(input.GetDataType()));
+    LoadInput<plSimdVec4i, int, plInt8>(pr, pre, pInputData, input.GetElementStride(), uiNumRemainderInstances);
+  }
+}
+
+// static
+void plExpressionNativeCode::StoreF(const plExpressionNativeContext& context, plUInt32 uiOutputIndex, plUInt32 uiFirstInstance, plUInt32 uiNumInstances, const plExpression::Register* r)
+{
+  plProcessingStream& output = *context.m_Outputs[uiOutputIndex];
+  plUInt8* pOutputData = output.GetWritableData<plUInt8>() + uiFirstInstance * output.GetElementStride();
+  const plUInt32 uiNumRemainderInstances = uiNumInstances & 0x3;
+
+  const plSimdVec4f* pr = reinterpret_cast<const plSimdVec4f*>(r);
+  const plSimdVec4f* pre = pr + uiNumInstances / 4;
+
+  if (output.GetDataType() == plProcessingStream::DataType::Float)
+  {
+    StoreOutput<const plSimdVec4f, float, float>(pr, pre, pOutputData, output.GetElementStride(), uiNumRemainderInstances);
+  }
+  else
+  {
+    PL_ASSERT_DEBUG(output.GetDataType() == plProcessingStream::DataType::Half, "Unsupported input type '{}' for StoreF instruction", plProcessingStream::GetDataTypeName(output.GetDataType()));
+    StoreOutput<const plSimdVec4f, float, plFloat16>(pr, pre, pOutputData, output.GetElementStride(), uiNumRemainderInstances);
+  }
+}
+
+// static
+void plExpressionNativeCode::StoreI(const plExpressionNativeContext& context, plUInt32 uiOutputIndex, plUInt32 uiFirstInstance, plUInt32 uiNumInstances, const plExpression::Register* r)
+{
+  plProcessingStream& output = *context.m_Outputs[uiOutputIndex];
+  plUInt8* pOutputData = output.GetWritableData<plUInt8>() + uiFirstInstance * output.GetElementStride();
+  const plUInt32 uiNumRemainderInstances = uiNumInstances & 0x3;
+
+  const plSimdVec4i* pr = reinterpret_cast<const plSimdVec4i*>(r);
+  const plSimdVec4i* pre = pr + uiNumInstances / 4;
+
+  if (output.GetDataType() == plProcessingStream::DataType::Int)
+  {
+    StoreOutput<const plSimdVec4i, int, int>(pr, pre, pOutputData, output.GetElementStride(), uiNumRemainderInstances);
+  }
+  else if (output.GetDataType() == plProcessingStream::DataType::Short)
+  {
+    StoreOutput<const plSimdVec4i, int, plInt16>(pr, pre, pOutputData, output.GetElementStride(), uiNumRemainderInstances);
+  }
+  else
+  {
+    PL_ASSERT_DEBUG(output.GetDataType() == plProcessingStream::DataType::Byte, "Unsupported input type '{}' for StoreI instruction", plProcessingStream::GetDataTypeName(output.GetDataType()));
+    StoreOutput<const plSimdVec4i, int, plInt8>(pr, pre, pOutputData, output.GetElementStride(), uiNumRemainderInstances);
+  }
+}
+
+// static
+void plExpressionNativeCode::Call(const plExpressionNativeContext& context, plUInt32 uiFunctionIndex, plArrayPtr<const plExpression::Register* const> args, plUInt32 uiNumRegisters, plExpression::Register* r)
+{
+  auto& function = *context.m_Functions[uiFunctionIndex];
+
+  plHybridArray<plArrayPtr<const plExpression::Register>, 32> inputs;
+  inputs.Reserve(args.GetCount());
+  for (const plExpression::Register* pArg : args)
+  {
+    inputs.PushBack(plMakeArrayPtr(pArg, uiNumRegisters));
+  }
+
+  plExpression::Output output = plMakeArrayPtr(r, uiNumRegisters);
+
+  function.m_Func(inputs, output, *context.m_pGlobalData);
+}
@@ -2,9 +2,11 @@
 
 #include <Foundation/CodeUtils/Expression/ExpressionAST.h>
 #include <Foundation/CodeUtils/Expression/ExpressionByteCode.h>
+#include <Foundation/CodeUtils/Expression/ExpressionNativeCode.h>
 #include <Foundation/CodeUtils/Expression/ExpressionVM.h>
 #include <Foundation/CodeUtils/Expression/Implementation/ExpressionVMOperations.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/System/SystemInformation.h>
 
 plExpressionVM::plExpressionVM()
 {
@@ -59,6 +61,25 @@ plResult plExpressionVM::Execute(const plExpressionByteCode& byteCode, plArrayPt
 
   PL_SUCCEED_OR_RETURN(MapFunctions(byteCode.GetFunctions(), globalData));
 
+  if (!flags.IsSet(Flags::DisableNativeCode) && plExpressionNativeCode::HasAnyFunctions())
+  {
+    if (plExpressionNativeFunc nativeFunc = plExpressionNativeCode::FindFunction(byteCode.GetHash()))
+    {
+      m_Registers.SetCountUninitialized(plMath::Max(byteCode.GetNumTempRegisters(), 1u) * plExpressionNativeCode::BlockSize);
+
+      plExpressionNativeContext context;
+      context.m_uiNumInstances = uiNumInstances;
+      context.m_pTempRegisters = m_Registers.GetData();
+      context.m_Inputs = m_MappedInputs;
+      context.m_Outputs = m_MappedOutputs;
+      context.m_Functions = m_MappedFunctions;
+      context.m_pGlobalData = &globalData;
+
+      nativeFunc(context);
+      return PL_SUCCESS;
+    }
+  }
+
   const plUInt32 uiTotalNumRegisters = byteCode.GetNumTempRegisters() * ((uiNumInstances + 3) / 4);
   m_Registers.SetCountUninitialized(uiTotalNumRegisters);
 
@@ -75,11 +96,24 @@ plResult plExpressionVM::Execute(const plExpressionByteCode& byteCode, plArrayPt
   context.m_Functions = m_MappedFunctions;
   context.m_pGlobalData = &globalData;
 
+  const OpFunc* pFuncs = s_Simd4Funcs;
+#if PL_ENABLED(PL_EXPRESSIONVM_WIDE_OPS)
+  const plUInt32 uiSimdWidth = plMath::Min<plUInt32>(m_MaxSimdWidth, GetSupportedSimdWidth());
+  if (uiSimdWidth == SimdWidth::Simd16)
+  {
+    pFuncs = Avx512::s_Funcs.m_Funcs;
+  }
+  else if (uiSimdWidth == SimdWidth::Simd8)
+  {
+    pFuncs = Avx2::s_Funcs.m_Funcs;
+  }
+#endif
+
   while (pByteCode < pByteCodeEnd)
   {
     plExpressionByteCode::OpCode::Enum opCode = plExpressionByteCode::GetOpCode(pByteCode);
 
-    OpFunc func = s_Simd4Funcs[opCode];
+    OpFunc func = pFuncs[opCode];
     if (func != nullptr)
     {
       func(pByteCode, context);
@@ -95,6 +129,21 @@ plResult plExpressionVM::Execute(const plExpressionByteCode& byteCode, plArrayPt
   return PL_SUCCESS;
 }
 
+// static
+plExpressionVM::SimdWidth::Enum plExpressionVM::GetSupportedSimdWidth()
+{
+#if PL_ENABLED(PL_EXPRESSIONVM_WIDE_OPS)
+  const plCpuFeatures& cpuFeatures = plSystemInformation::Get().GetCpuFeatures();
+  if (cpuFeatures.IsAvx512Available())
+    return SimdWidth::Simd16;
+
+  if (cpuFeatures.IsAvx2Available())
+    return SimdWidth::Simd8;
+#endif
+
+  return SimdWidth::Simd4;
+}
+
 void plExpressionVM::RegisterDefaultFunctions()
 {
   RegisterFunction(plDefaultExpressionFunctions::s_RandomFunc);
@@ -226,11 +226,8 @@ namespace
   }
 
   template <typename RegisterType, typename ValueType, typename StreamType>
-  void LoadInput(RegisterType* r, RegisterType* pRe, const plProcessingStream& input, plUInt32 uiNumRemainderInstances)
+  void LoadInput(RegisterType* r, RegisterType* pRe, const plUInt8* pInputData, plUInt32 uiByteStride, plUInt32 uiNumRemainderInstances)
   {
-    const plUInt8* pInputData = input.GetData<plUInt8>();
-    const plUInt32 uiByteStride = input.GetElementStride();
-
     if (uiByteStride == sizeof(ValueType) && std::is_same<ValueType, StreamType>::value)
     {
       while (r != pRe)
@@ -276,11 +273,8 @@ namespace
   }
 
   template <typename RegisterType, typename ValueType, typename StreamType>
-  void StoreOutput(RegisterType* r, RegisterType* pRe, plProcessingStream& ref_output, plUInt32 uiNumRemainderInstances)
+  void StoreOutput(RegisterType* r, RegisterType* pRe, plUInt8* pOutputData, plUInt32 uiByteStride, plUInt32 uiNumRemainderInstances)
   {
-    plUInt8* pOutputData = ref_output.GetWritableData<plUInt8>();
-    const plUInt32 uiByteStride = ref_output.GetElementStride();
-
     if (uiByteStride == sizeof(ValueType) && std::is_same<ValueType, StreamType>::value)
     {
       while (r != pRe)
@@ -332,12 +326,12 @@ namespace
 
     if (input.GetDataType() == plProcessingStream::DataType::Float)
     {
-      LoadInput<plSimdVec4f, float, float>(reinterpret_cast<plSimdVec4f*>(r), reinterpret_cast<plSimdVec4f*>(re), input, uiNumRemainderInstances);
+      LoadInput<plSimdVec4f, float, float>(reinterpret_cast<plSimdVec4f*>(r), reinterpret_cast<plSimdVec4f*>(re), input.GetData<plUInt8>(), input.GetElementStride(), uiNumRemainderInstances);
     }
     else
     {
       PL_ASSERT_DEBUG(input.GetDataType() == plProcessingStream::DataType::Half, "Unsupported input type '{}' for LoadF instruction", plProcessingStream::GetDataTypeName(input.GetDataType()));
-      LoadInput<plSimdVec4f, float, plFloat16>(reinterpret_cast<plSimdVec4f*>(r), reinterpret_cast<plSimdVec4f*>(re), input, uiNumRemainderInstances);
+      LoadInput<plSimdVec4f, float, plFloat16>(reinterpret_cast<plSimdVec4f*>(r), reinterpret_cast<plSimdVec4f*>(re), input.GetData<plUInt8>(), input.GetElementStride(), uiNumRemainderInstances);
     }
   }
 
@@ -354,16 +348,16 @@ namespace
 
     if (input.GetDataType() == plProcessingStream::DataType::Int)
     {
-      LoadInput<plSimdVec4i, int, int>(reinterpret_cast<plSimdVec4i*>(r), reinterpret_cast<plSimdVec4i*>(re), input, uiNumRemainderInstances);
+      LoadInput<plSimdVec4i, int, int>(reinterpret_cast<plSimdVec4i*>(r), reinterpret_cast<plSimdVec4i*>(re), input.GetData<plUInt8>(), input.GetElementStride(), uiNumRemainderInstances);
     }
     else if (input.GetDataType() == plProcessingStream::DataType::Short)
     {
-      LoadInput<plSimdVec4i, int, plInt16>(reinterpret_cast<plSimdVec4i*>(r), reinterpret_cast<plSimdVec4i*>(re), input, uiNumRemainderInstances);
+      LoadInput<plSimdVec4i, int, plInt16>(reinterpret_cast<plSimdVec4i*>(r), reinterpret_cast<plSimdVec4i*>(re), input.GetData<plUInt8>(), input.GetElementStride(), uiNumRemainderInstances);
     }
     else
     {
       PL_ASSERT_DEBUG(input.GetDataType() == plProcessingStream::DataType::Byte, "Unsupported input type '{}' for LoadI instruction", plProcessingStream::GetDataTypeName(input.GetDataType()));
-      LoadInput<plSimdVec4i, int, plInt8>(reinterpret_cast<plSimdVec4i*>(r), reinterpret_cast<plSimdVec4i*>(re), input, uiNumRemainderInstances);
+      LoadInput<plSimdVec4i, int, plInt8>(reinterpret_cast<plSimdVec4i*>(r), reinterpret_cast<plSimdVec4i*>(re), input.GetData<plUInt8>(), input.GetElementStride(), uiNumRemainderInstances);
     }
   }
 
@@ -381,12 +375,12 @@ namespace
 
     if (output.GetDataType() == plProcessingStream::DataType::Float)
     {
-      StoreOutput<plSimdVec4f, float, float>(reinterpret_cast<plSimdVec4f*>(r), reinterpret_cast<plSimdVec4f*>(re), output, uiNumRemainderInstances);
+      StoreOutput<plSimdVec4f, float, float>(reinterpret_cast<plSimdVec4f*>(r), reinterpret_cast<plSimdVec4f*>(re), output.GetWritableData<plUInt8>(), output.GetElementStride(), uiNumRemainderInstances);
     }
     else
     {
       PL_ASSERT_DEBUG(output.GetDataType() == plProcessingStream::DataType::Half, "Unsupported input type '{}' for StoreF instruction", plProcessingStream::GetDataTypeName(output.GetDataType()));
-      StoreOutput<plSimdVec4f, float, plFloat16>(reinterpret_cast<plSimdVec4f*>(r), reinterpret_cast<plSimdVec4f*>(re), output, uiNumRemainderInstances);
+      StoreOutput<plSimdVec4f, float, plFloat16>(reinterpret_cast<plSimdVec4f*>(r), reinterpret_cast<plSimdVec4f*>(re), output.GetWritableData<plUInt8>(), output.GetElementStride(), uiNumRemainderInstances);
     }
   }
 
@@ -404,16 +398,16 @@ namespace
 
     if (output.GetDataType() == plProcessingStream::DataType::Int)
     {
-      StoreOutput<plSimdVec4i, int, int>(reinterpret_cast<plSimdVec4i*>(r), reinterpret_cast<plSimdVec4i*>(re), output, uiNumRemainderInstances);
+      StoreOutput<plSimdVec4i, int, int>(reinterpret_cast<plSimdVec4i*>(r), reinterpret_cast<plSimdVec4i*>(re), output.GetWritableData<plUInt8>(), output.GetElementStride(), uiNumRemainderInstances);
     }
     else if (output.GetDataType() == plProcessingStream::DataType::Short)
     {
-      StoreOutput<plSimdVec4i, int, plInt16>(reinterpret_cast<plSimdVec4i*>(r), reinterpret_cast<plSimdVec4i*>(re), output, uiNumRemainderInstances);
+      StoreOutput<plSimdVec4i, int, plInt16>(reinterpret_cast<plSimdVec4i*>(r), reinterpret_cast<plSimdVec4i*>(re), output.GetWritableData<plUInt8>(), output.GetElementStride(), uiNumRemainderInstances);
     }
     else
     {
       PL_ASSERT_DEBUG(output.GetDataType() == plProcessingStream::DataType::Byte, "Unsupported input type '{}' for StoreI instruction", plProcessingStream::GetDataTypeName(output.GetDataType()));
-      StoreOutput<plSimdVec4i, int, plInt8>(reinterpret_cast<plSimdVec4i*>(r), reinterpret_cast<plSimdVec4i*>(re), output, uiNumRemainderInstances);
+      StoreOutput<plSimdVec4i, int, plInt8>(reinterpret_cast<plSimdVec4i*>(r), reinterpret_cast<plSimdVec4i*>(re), output.GetWritableData<plUInt8>(), output.GetElementStride(), uiNumRemainderInstances);
     }
   }
 
@@ -604,6 +598,8 @@ namespace
 
 } // namespace
 
+#include <Foundation/CodeUtils/Expression/Implementation/ExpressionVMOperationsWide.h>
+
 #undef DEFINE_TARGET_REGISTER
 #undef DEFINE_OP_REGISTER
 #undef DEFINE_CONSTANT
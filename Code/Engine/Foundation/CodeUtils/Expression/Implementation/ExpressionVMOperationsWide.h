@@ -0,0 +1,315 @@
+#pragma once
+
+// Wide variants of the VM operations. They work on the same register memory as the 4-wide operations but treat 2 (AVX2) or 4 (AVX-512)
+// consecutive plExpression::Register as one vector. Registers at the end of a register block that don't fill a whole wide vector
+// are processed with the regular 4-wide code, so the partial last register that LoadInput creates for the remainder instances is handled
+// exactly like in the 4-wide VM. Operations that don't have a wide variant (transcendental math, integer division, loads, stores and
+// function calls) use the 4-wide function, which is possible because the register layout is identical.
+
+#if PL_ENABLED(PL_EXPRESSIONVM_WIDE_SIMD) && PL_SIMD_IMPLEMENTATION == PL_SIMD_IMPLEMENTATION_SSE
+#  define PL_EXPRESSIONVM_WIDE_OPS PL_ON
+#else
+#  define PL_EXPRESSIONVM_WIDE_OPS PL_OFF
+#endif
+
+#if PL_ENABLED(PL_EXPRESSIONVM_WIDE_OPS)
+
+#  include <immintrin.h>
+
+#  if PL_ENABLED(PL_COMPILER_MSVC_PURE)
+#    define PL_EXPRESSIONVM_TARGET_AVX2
+#    define PL_EXPRESSIONVM_TARGET_AVX512
+#  else
+#    define PL_EXPRESSIONVM_TARGET_AVX2 __attribute__((target("avx2")))
+#    define PL_EXPRESSIONVM_TARGET_AVX512 __attribute__((target("avx512f")))
+#  endif
+
+namespace
+{
+  struct WideFuncTable
+  {
+    OpFunc m_Funcs[plExpressionByteCode::OpCode::Count];
+  };
+
+  // All functions need to carry the target attribute, otherwise GCC and Clang refuse to inline the intrinsics.
+#  define WIDE_FUNC static PL_ALWAYS_INLINE PL_EXPRESSIONVM_TARGET_AVX2
+
+  struct WideTraitsAvx2
+  {
+    using Float = __m256;
+    using Int = __m256i;
+
+    static constexpr plUInt32 NumRegisters = 2;
+
+    WIDE_FUNC Float LoadF(const plExpression::Register* p) { return _mm256_loadu_ps(reinterpret_cast<const float*>(p)); }
+    WIDE_FUNC Int LoadI(const plExpression::Register* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    WIDE_FUNC Float LoadB(const plExpression::Register* p) { return LoadF(p); }
+
+    WIDE_FUNC Float BroadcastF(const plExpression::Register& c) { return _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&c)); }
+    WIDE_FUNC Int BroadcastI(const plExpression::Register& c) { return _mm256_castps_si256(BroadcastF(c)); }
+    WIDE_FUNC Float BroadcastB(const plExpression::Register& c) { return BroadcastF(c); }
+
+    WIDE_FUNC void Store(plExpression::Register* p, Float v) { _mm256_storeu_ps(reinterpret_cast<float*>(p), v); }
+    WIDE_FUNC void Store(plExpression::Register* p, Int v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+
+    WIDE_FUNC Float AbsF(Float a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    WIDE_FUNC Float SqrtF(Float a) { return _mm256_sqrt_ps(a); }
+    WIDE_FUNC Float RoundF(Float a) { return _mm256_round_ps(a, _MM_FROUND_NINT); }
+    WIDE_FUNC Float FloorF(Float a) { return _mm256_round_ps(a, _MM_FROUND_FLOOR); }
+    WIDE_FUNC Float CeilF(Float a) { return _mm256_round_ps(a, _MM_FROUND_CEIL); }
+    WIDE_FUNC Float TruncF(Float a) { return _mm256_round_ps(a, _MM_FROUND_TRUNC); }
+
+    WIDE_FUNC Float AddF(Float a, Float b) { return _mm256_add_ps(a, b); }
+    WIDE_FUNC Float SubF(Float a, Float b) { return _mm256_sub_ps(a, b); }
+    WIDE_FUNC Float MulF(Float a, Float b) { return _mm256_mul_ps(a, b); }
+    WIDE_FUNC Float DivF(Float a, Float b) { return _mm256_div_ps(a, b); }
+    WIDE_FUNC Float MinF(Float a, Float b) { return _mm256_min_ps(a, b); }
+    WIDE_FUNC Float MaxF(Float a, Float b) { return _mm256_max_ps(a, b); }
+
+    WIDE_FUNC Int AbsI(Int a) { return _mm256_abs_epi32(a); }
+    WIDE_FUNC Int NotI(Int a) { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+    WIDE_FUNC Int AddI(Int a, Int b) { return _mm256_add_epi32(a, b); }
+    WIDE_FUNC Int SubI(Int a, Int b) { return _mm256_sub_epi32(a, b); }
+    WIDE_FUNC Int MulI(Int a, Int b) { return _mm256_mullo_epi32(a, b); }
+    WIDE_FUNC Int MinI(Int a, Int b) { return _mm256_min_epi32(a, b); }
+    WIDE_FUNC Int MaxI(Int a, Int b) { return _mm256_max_epi32(a, b); }
+    // The 4-wide operations shift every lane with a scalar shift, which only uses the lower 5 bits of the count on x86.
+    // The variable AVX shifts would return 0 or the sign instead, so the count is masked to get the same result for any count.
+    WIDE_FUNC Int ShlI(Int a, Int b) { return _mm256_sllv_epi32(a, _mm256_and_si256(b, _mm256_set1_epi32(31))); }
+    WIDE_FUNC Int ShrI(Int a, Int b) { return _mm256_srav_epi32(a, _mm256_and_si256(b, _mm256_set1_epi32(31))); }
+    WIDE_FUNC Int ShlI_C(Int a, plUInt32 uiShift) { return _mm256_sll_epi32(a, _mm_cvtsi32_si128(uiShift)); }
+    WIDE_FUNC Int ShrI_C(Int a, plUInt32 uiShift) { return _mm256_sra_epi32(a, _mm_cvtsi32_si128(uiShift)); }
+    WIDE_FUNC Int AndI(Int a, Int b) { return _mm256_and_si256(a, b); }
+    WIDE_FUNC Int XorI(Int a, Int b) { return _mm256_xor_si256(a, b); }
+    WIDE_FUNC Int OrI(Int a, Int b) { return _mm256_or_si256(a, b); }
+
+    WIDE_FUNC Float IToF(Int a) { return _mm256_cvtepi32_ps(a); }
+    WIDE_FUNC Int FToI(Float a) { return _mm256_cvttps_epi32(a); }
+
+    // Same predicates as the SSE comparisons used by plSimdVec4f
+    WIDE_FUNC Float EqF(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    WIDE_FUNC Float NEqF(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+    WIDE_FUNC Float LtF(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OS); }
+    WIDE_FUNC Float LEqF(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LE_OS); }
+    WIDE_FUNC Float GtF(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OS); }
+    WIDE_FUNC Float GEqF(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GE_OS); }
+
+    WIDE_FUNC Float NotB(Float a) { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+    WIDE_FUNC Float AndB(Float a, Float b) { return _mm256_and_ps(a, b); }
+    WIDE_FUNC Float OrB(Float a, Float b) { return _mm256_or_ps(a, b); }
+    WIDE_FUNC Float EqB(Float a, Float b) { return NotB(_mm256_xor_ps(a, b)); }
+    WIDE_FUNC Float NEqB(Float a, Float b) { return _mm256_xor_ps(a, b); }
+
+    WIDE_FUNC Float EqI(Int a, Int b) { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)); }
+    WIDE_FUNC Float NEqI(Int a, Int b) { return NotB(EqI(a, b)); }
+    WIDE_FUNC Float LtI(Int a, Int b) { return _mm256_castsi256_ps(_mm256_cmpgt_epi32(b, a)); }
+    WIDE_FUNC Float LEqI(Int a, Int b) { return NotB(GtI(a, b)); }
+    WIDE_FUNC Float GtI(Int a, Int b) { return _mm256_castsi256_ps(_mm256_cmpgt_epi32(a, b)); }
+    WIDE_FUNC Float GEqI(Int a, Int b) { return NotB(LtI(a, b)); }
+
+    WIDE_FUNC Float SelF(Float cmp, Float a, Float b) { return _mm256_blendv_ps(b, a, cmp); }
+    WIDE_FUNC Int SelI(Float cmp, Int a, Int b) { return _mm256_castps_si256(SelF(cmp, _mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+    WIDE_FUNC Float SelB(Float cmp, Float a, Float b) { return SelF(cmp, a, b); }
+  };
+
+#  undef WIDE_FUNC
+#  define WIDE_FUNC static PL_ALWAYS_INLINE PL_EXPRESSIONVM_TARGET_AVX512
+
+  struct WideTraitsAvx512
+  {
+    using Float = __m512;
+    using Int = __m512i;
+
+    static constexpr plUInt32 NumRegisters = 4;
+
+    WIDE_FUNC Float LoadF(const plExpression::Register* p) { return _mm512_loadu_ps(p); }
+    WIDE_FUNC Int LoadI(const plExpression::Register* p) { return _mm512_loadu_si512(p); }
+    WIDE_FUNC Float LoadB(const plExpression::Register* p) { return LoadF(p); }
+
+    WIDE_FUNC Float BroadcastF(const plExpression::Register& c) { return _mm512_broadcast_f32x4(_mm_loadu_ps(reinterpret_cast<const float*>(&c))); }
+    WIDE_FUNC Int BroadcastI(const plExpression::Register& c) { return _mm512_castps_si512(BroadcastF(c)); }
+    WIDE_FUNC Float BroadcastB(const plExpression::Register& c) { return BroadcastF(c); }
+
+    WIDE_FUNC void Store(plExpression::Register* p, Float v) { _mm512_storeu_ps(p, v); }
+    WIDE_FUNC void Store(plExpression::Register* p, Int v) { _mm512_storeu_si512(p, v); }
+
+    // Bool registers hold all bits set or cleared per lane, like plSimdVec4b. Selects only look at the sign bit, like blendv does.
+    WIDE_FUNC Float FromMask(__mmask16 m) { return _mm512_castsi512_ps(_mm512_maskz_set1_epi32(m, -1)); }
+    WIDE_FUNC __mmask16 ToMask(Float a) { return _mm512_cmplt_epi32_mask(_mm512_castps_si512(a), _mm512_setzero_si512()); }
+
+    WIDE_FUNC Float AbsF(Float a) { return _mm512_castsi512_ps(_mm512_andnot_si512(_mm512_castps_si512(_mm512_set1_ps(-0.0f)), _mm512_castps_si512(a))); }
+    WIDE_FUNC Float SqrtF(Float a) { return _mm512_sqrt_ps(a); }
+    WIDE_FUNC Float RoundF(Float a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT); }
+    WIDE_FUNC Float FloorF(Float a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF); }
+    WIDE_FUNC Float CeilF(Float a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_POS_INF); }
+    WIDE_FUNC Float TruncF(Float a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_ZERO); }
+
+    WIDE_FUNC Float AddF(Float a, Float b) { return _mm512_add_ps(a, b); }
+    WIDE_FUNC Float SubF(Float a, Float b) { return _mm512_sub_ps(a, b); }
+    WIDE_FUNC Float MulF(Float a, Float b) { return _mm512_mul_ps(a, b); }
+    WIDE_FUNC Float DivF(Float a, Float b) { return _mm512_div_ps(a, b); }
+    WIDE_FUNC Float MinF(Float a, Float b) { return _mm512_min_ps(a, b); }
+    WIDE_FUNC Float MaxF(Float a, Float b) { return _mm512_max_ps(a, b); }
+
+    WIDE_FUNC Int AbsI(Int a) { return _mm512_abs_epi32(a); }
+    WIDE_FUNC Int NotI(Int a) { return _mm512_xor_si512(a, _mm512_set1_epi32(-1)); }
+    WIDE_FUNC Int AddI(Int a, Int b) { return _mm512_add_epi32(a, b); }
+    WIDE_FUNC Int SubI(Int a, Int b) { return _mm512_sub_epi32(a, b); }
+    WIDE_FUNC Int MulI(Int a, Int b) { return _mm512_mullo_epi32(a, b); }
+    WIDE_FUNC Int MinI(Int a, Int b) { return _mm512_min_epi32(a, b); }
+    WIDE_FUNC Int MaxI(Int a, Int b) { return _mm512_max_epi32(a, b); }
+    // see the AVX2 variant for why the count is masked
+    WIDE_FUNC Int ShlI(Int a, Int b) { return _mm512_sllv_epi32(a, _mm512_and_si512(b, _mm512_set1_epi32(31))); }
+    WIDE_FUNC Int ShrI(Int a, Int b) { return _mm512_srav_epi32(a, _mm512_and_si512(b, _mm512_set1_epi32(31))); }
+    WIDE_FUNC Int ShlI_C(Int a, plUInt32 uiShift) { return _mm512_sll_epi32(a, _mm_cvtsi32_si128(uiShift)); }
+    WIDE_FUNC Int ShrI_C(Int a, plUInt32 uiShift) { return _mm512_sra_epi32(a, _mm_cvtsi32_si128(uiShift)); }
+    WIDE_FUNC Int AndI(Int a, Int b) { return _mm512_and_si512(a, b); }
+    WIDE_FUNC Int XorI(Int a, Int b) { return _mm512_xor_si512(a, b); }
+    WIDE_FUNC Int OrI(Int a, Int b) { return _mm512_or_si512(a, b); }
+
+    WIDE_FUNC Float IToF(Int a) { return _mm512_cvtepi32_ps(a); }
+    WIDE_FUNC Int FToI(Float a) { return _mm512_cvttps_epi32(a); }
+
+    WIDE_FUNC Float EqF(Float a, Float b) { return FromMask(_mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ)); }
+    WIDE_FUNC Float NEqF(Float a, Float b) { return FromMask(_mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ)); }
+    WIDE_FUNC Float LtF(Float a, Float b) { return FromMask(_mm512_cmp_ps_mask(a, b, _CMP_LT_OS)); }
+    WIDE_FUNC Float LEqF(Float a, Float b) { return FromMask(_mm512_cmp_ps_mask(a, b, _CMP_LE_OS)); }
+    WIDE_FUNC Float GtF(Float a, Float b) { return FromMask(_mm512_cmp_ps_mask(a, b, _CMP_GT_OS)); }
+    WIDE_FUNC Float GEqF(Float a, Float b) { return FromMask(_mm512_cmp_ps_mask(a, b, _CMP_GE_OS)); }
+
+    WIDE_FUNC Float NotB(Float a) { return _mm512_castsi512_ps(NotI(_mm512_castps_si512(a))); }
+    WIDE_FUNC Float AndB(Float a, Float b) { return _mm512_castsi512_ps(AndI(_mm512_castps_si512(a), _mm512_castps_si512(b))); }
+    WIDE_FUNC Float OrB(Float a, Float b) { return _mm512_castsi512_ps(OrI(_mm512_castps_si512(a), _mm512_castps_si512(b))); }
+    WIDE_FUNC Float EqB(Float a, Float b) { return NotB(NEqB(a, b)); }
+    WIDE_FUNC Float NEqB(Float a, Float b) { return _mm512_castsi512_ps(XorI(_mm512_castps_si512(a), _mm512_castps_si512(b))); }
+
+    WIDE_FUNC Float EqI(Int a, Int b) { return FromMask(_mm512_cmpeq_epi32_mask(a, b)); }
+    WIDE_FUNC Float NEqI(Int a, Int b) { return FromMask(_mm512_cmpneq_epi32_mask(a, b)); }
+    WIDE_FUNC Float LtI(Int a, Int b) { return FromMask(_mm512_cmplt_epi32_mask(a, b)); }
+    WIDE_FUNC Float LEqI(Int a, Int b) { return FromMask(_mm512_cmple_epi32_mask(a, b)); }
+    WIDE_FUNC Float GtI(Int a, Int b) { return FromMask(_mm512_cmpgt_epi32_mask(a, b)); }
+    WIDE_FUNC Float GEqI(Int a, Int b) { return FromMask(_mm512_cmpge_epi32_mask(a, b)); }
+
+    WIDE_FUNC Float SelF(Float cmp, Float a, Float b) { return _mm512_mask_blend_ps(ToMask(cmp), b, a); }
+    WIDE_FUNC Int SelI(Float cmp, Int a, Int b) { return _mm512_mask_blend_epi32(ToMask(cmp), b, a); }
+    WIDE_FUNC Float SelB(Float cmp, Float a, Float b) { return SelF(cmp, a, b); }
+  };
+
+#  undef WIDE_FUNC
+
+#  define DEFINE_WIDE_END() \
+    plExpression::Register* reWide = r + (context.m_uiNumSimd4Instances & ~(W::NumRegisters - 1));
+
+#  define DEFINE_WIDE_UNARY_OP(name, type, wideCode, code)                                  \
+    PL_EXPRESSIONVM_WIDE_TARGET void name(const ByteCodeType*& pByteCode, ExecutionContext& context) \
+    {                                                                                        \
+      DEFINE_TARGET_REGISTER();                                                              \
+      DEFINE_WIDE_END();                                                                     \
+      DEFINE_OP_REGISTER(a);                                                                 \
+      while (r != reWide)                                                                    \
+      {                                                                                      \
+        const auto wa = W::PL_CONCAT(Load, type)(a);                                         \
+        W::Store(r, wideCode);                                                               \
+        r += W::NumRegisters;                                                                \
+        a += W::NumRegisters;                                                                \
+      }                                                                                      \
+      while (r != re)                                                                        \
+      {                                                                                      \
+        UNARY_OP_INNER_LOOP(code)                                                            \
+      }                                                                                      \
+    }
+
+#  define DEFINE_WIDE_BINARY_OP(name, type, wideCode, code)                                                              \
+    template <bool RightIsConstant>                                                                                       \
+    PL_EXPRESSIONVM_WIDE_TARGET void name(const ByteCodeType*& pByteCode, ExecutionContext& context)                     \
+    {                                                                                                                     \
+      DEFINE_TARGET_REGISTER();                                                                                           \
+      DEFINE_WIDE_END();                                                                                                  \
+      DEFINE_OP_REGISTER(a);                                                                                              \
+      plUInt32 bRaw;                                                                                                      \
+      PL_IGNORE_UNUSED(bRaw);                                                                                             \
+      plExpression::Register bConstant;                                                                                   \
+      const plExpression::Register* b;                                                                                    \
+      if constexpr (RightIsConstant)                                                                                      \
+      {                                                                                                                   \
+        bRaw = *pByteCode;                                                                                                \
+        bConstant = plExpressionByteCode::GetConstant(pByteCode);                                                         \
+        b = &bConstant;                                                                                                   \
+        const auto wb = W::PL_CONCAT(Broadcast, type)(bConstant);                                                         \
+        PL_IGNORE_UNUSED(wb);                                                                                             \
+        while (r != reWide)                                                                                               \
+        {                                                                                                                 \
+          const auto wa = W::PL_CONCAT(Load, type)(a);                                                                    \
+          W::Store(r, wideCode);                                                                                          \
+          r += W::NumRegisters;                                                                                           \
+          a += W::NumRegisters;                                                                                           \
+        }                                                                                                                 \
+      }                                                                                                                   \
+      else                                                                                                                \
+      {                                                                                                                   \
+        b = context.m_pRegisters + plExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiNumSimd4Instances;     \
+        while (r != reWide)                                                                                               \
+        {                                                                                                                 \
+          const auto wa = W::PL_CONCAT(Load, type)(a);                                                                    \
+          const auto wb = W::PL_CONCAT(Load, type)(b);                                                                    \
+          W::Store(r, wideCode);                                                                                          \
+          r += W::NumRegisters;                                                                                           \
+          a += W::NumRegisters;                                                                                           \
+          b += W::NumRegisters;                                                                                           \
+        }                                                                                                                 \
+      }                                                                                                                   \
+      while (r != re)                                                                                                     \
+      {                                                                                                                   \
+        BINARY_OP_INNER_LOOP(code)                                                                                        \
+      }                                                                                                                   \
+    }
+
+#  define DEFINE_WIDE_TERNARY_OP(name, type, wideCode, code)                                \
+    PL_EXPRESSIONVM_WIDE_TARGET void name(const ByteCodeType*& pByteCode, ExecutionContext& context) \
+    {                                                                                        \
+      DEFINE_TARGET_REGISTER();                                                              \
+      DEFINE_WIDE_END();                                                                     \
+      DEFINE_OP_REGISTER(a);                                                                 \
+      DEFINE_OP_REGISTER(b);                                                                 \
+      DEFINE_OP_REGISTER(c);                                                                 \
+      while (r != reWide)                                                                    \
+      {                                                                                      \
+        const auto wa = W::LoadB(a);                                                         \
+        const auto wb = W::PL_CONCAT(Load, type)(b);                                         \
+        const auto wc = W::PL_CONCAT(Load, type)(c);                                         \
+        W::Store(r, wideCode);                                                               \
+        r += W::NumRegisters;                                                                \
+        a += W::NumRegisters;                                                                \
+        b += W::NumRegisters;                                                                \
+        c += W::NumRegisters;                                                                \
+      }                                                                                      \
+      while (r != re)                                                                        \
+      {                                                                                      \
+        TERNARY_OP_INNER_LOOP(code)                                                          \
+      }                                                                                      \
+    }
+
+  namespace Avx2
+  {
+    using W = WideTraitsAvx2;
+#  define PL_EXPRESSIONVM_WIDE_TARGET PL_EXPRESSIONVM_TARGET_AVX2
+#  include <Foundation/CodeUtils/Expression/Implementation/ExpressionVMOperationsWide_inl.h>
+#  undef PL_EXPRESSIONVM_WIDE_TARGET
+  } // namespace Avx2
+
+  namespace Avx512
+  {
+    using W = WideTraitsAvx512;
+#  define PL_EXPRESSIONVM_WIDE_TARGET PL_EXPRESSIONVM_TARGET_AVX512
+#  include <Foundation/CodeUtils/Expression/Implementation/ExpressionVMOperationsWide_inl.h>
+#  undef PL_EXPRESSIONVM_WIDE_TARGET
+  } // namespace Avx512
+
+} // namespace
+
+#  undef DEFINE_WIDE_END
+#  undef DEFINE_WIDE_UNARY_OP
+#  undef DEFINE_WIDE_BINARY_OP
+#  undef DEFINE_WIDE_TERNARY_OP
+
+#endif
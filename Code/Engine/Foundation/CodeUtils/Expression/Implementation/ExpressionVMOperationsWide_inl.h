@@ -0,0 +1,209 @@
+// Included once per instruction set by ExpressionVMOperationsWide.h, with W being the vector traits and PL_EXPRESSIONVM_WIDE_TARGET the target attribute.
+
+DEFINE_WIDE_UNARY_OP(AbsF, F, W::AbsF(wa), r->f = a->f.Abs());
+DEFINE_WIDE_UNARY_OP(AbsI, I, W::AbsI(wa), r->i = a->i.Abs());
+DEFINE_WIDE_UNARY_OP(SqrtF, F, W::SqrtF(wa), r->f = a->f.GetSqrt());
+
+DEFINE_WIDE_UNARY_OP(RoundF, F, W::RoundF(wa), r->f = a->f.Round());
+DEFINE_WIDE_UNARY_OP(FloorF, F, W::FloorF(wa), r->f = a->f.Floor());
+DEFINE_WIDE_UNARY_OP(CeilF, F, W::CeilF(wa), r->f = a->f.Ceil());
+DEFINE_WIDE_UNARY_OP(TruncF, F, W::TruncF(wa), r->f = a->f.Trunc());
+
+DEFINE_WIDE_UNARY_OP(NotI, I, W::NotI(wa), r->i = ~a->i);
+DEFINE_WIDE_UNARY_OP(NotB, B, W::NotB(wa), r->b = !a->b);
+
+DEFINE_WIDE_UNARY_OP(IToF, I, W::IToF(wa), r->f = a->i.ToFloat());
+DEFINE_WIDE_UNARY_OP(FToI, F, W::FToI(wa), r->i = plSimdVec4i::Truncate(a->f));
+
+DEFINE_WIDE_BINARY_OP(AddF, F, W::AddF(wa, wb), r->f = a->f + b->f);
+DEFINE_WIDE_BINARY_OP(AddI, I, W::AddI(wa, wb), r->i = a->i + b->i);
+
+DEFINE_WIDE_BINARY_OP(SubF, F, W::SubF(wa, wb), r->f = a->f - b->f);
+DEFINE_WIDE_BINARY_OP(SubI, I, W::SubI(wa, wb), r->i = a->i - b->i);
+
+DEFINE_WIDE_BINARY_OP(MulF, F, W::MulF(wa, wb), r->f = a->f.CompMul(b->f));
+DEFINE_WIDE_BINARY_OP(MulI, I, W::MulI(wa, wb), r->i = a->i.CompMul(b->i));
+
+DEFINE_WIDE_BINARY_OP(DivF, F, W::DivF(wa, wb), r->f = a->f.CompDiv(b->f));
+
+DEFINE_WIDE_BINARY_OP(MinF, F, W::MinF(wa, wb), r->f = a->f.CompMin(b->f));
+DEFINE_WIDE_BINARY_OP(MinI, I, W::MinI(wa, wb), r->i = a->i.CompMin(b->i));
+
+DEFINE_WIDE_BINARY_OP(MaxF, F, W::MaxF(wa, wb), r->f = a->f.CompMax(b->f));
+DEFINE_WIDE_BINARY_OP(MaxI, I, W::MaxI(wa, wb), r->i = a->i.CompMax(b->i));
+
+DEFINE_WIDE_BINARY_OP(ShlI, I, W::ShlI(wa, wb), r->i = a->i << b->i);
+DEFINE_WIDE_BINARY_OP(ShrI, I, W::ShrI(wa, wb), r->i = a->i >> b->i);
+DEFINE_WIDE_BINARY_OP(ShlI_C, I, W::ShlI_C(wa, bRaw), r->i = a->i << bRaw);
+DEFINE_WIDE_BINARY_OP(ShrI_C, I, W::ShrI_C(wa, bRaw), r->i = a->i >> bRaw);
+DEFINE_WIDE_BINARY_OP(AndI, I, W::AndI(wa, wb), r->i = a->i & b->i);
+DEFINE_WIDE_BINARY_OP(XorI, I, W::XorI(wa, wb), r->i = a->i ^ b->i);
+DEFINE_WIDE_BINARY_OP(OrI, I, W::OrI(wa, wb), r->i = a->i | b->i);
+
+DEFINE_WIDE_BINARY_OP(EqF, F, W::EqF(wa, wb), r->b = a->f == b->f);
+DEFINE_WIDE_BINARY_OP(EqI, I, W::EqI(wa, wb), r->b = a->i == b->i);
+DEFINE_WIDE_BINARY_OP(EqB, B, W::EqB(wa, wb), r->b = a->b == b->b);
+
+DEFINE_WIDE_BINARY_OP(NEqF, F, W::NEqF(wa, wb), r->b = a->f != b->f);
+DEFINE_WIDE_BINARY_OP(NEqI, I, W::NEqI(wa, wb), r->b = a->i != b->i);
+DEFINE_WIDE_BINARY_OP(NEqB, B, W::NEqB(wa, wb), r->b = a->b != b->b);
+
+DEFINE_WIDE_BINARY_OP(LtF, F, W::LtF(wa, wb), r->b = a->f < b->f);
+DEFINE_WIDE_BINARY_OP(LtI, I, W::LtI(wa, wb), r->b = a->i < b->i);
+
+DEFINE_WIDE_BINARY_OP(LEqF, F, W::LEqF(wa, wb), r->b = a->f <= b->f);
+DEFINE_WIDE_BINARY_OP(LEqI, I, W::LEqI(wa, wb), r->b = a->i <= b->i);
+
+DEFINE_WIDE_BINARY_OP(GtF, F, W::GtF(wa, wb), r->b = a->f > b->f);
+DEFINE_WIDE_BINARY_OP(GtI, I, W::GtI(wa, wb), r->b = a->i > b->i);
+
+DEFINE_WIDE_BINARY_OP(GEqF, F, W::GEqF(wa, wb), r->b = a->f >= b->f);
+DEFINE_WIDE_BINARY_OP(GEqI, I, W::GEqI(wa, wb), r->b = a->i >= b->i);
+
+DEFINE_WIDE_BINARY_OP(AndB, B, W::AndB(wa, wb), r->b = a->b && b->b);
+DEFINE_WIDE_BINARY_OP(OrB, B, W::OrB(wa, wb), r->b = a->b || b->b);
+
+DEFINE_WIDE_TERNARY_OP(SelF, F, W::SelF(wa, wb, wc), r->f = plSimdVec4f::Select(a->b, b->f, c->f));
+DEFINE_WIDE_TERNARY_OP(SelI, I, W::SelI(wa, wb, wc), r->i = plSimdVec4i::Select(a->b, b->i, c->i));
+DEFINE_WIDE_TERNARY_OP(SelB, B, W::SelB(wa, wb, wc), r->b = plSimdVec4b::Select(a->b, b->b, c->b));
+
+PL_EXPRESSIONVM_WIDE_TARGET void VM_MovX_R(const ByteCodeType*& pByteCode, ExecutionContext& context)
+{
+  DEFINE_TARGET_REGISTER();
+  DEFINE_WIDE_END();
+  DEFINE_OP_REGISTER(a);
+  while (r != reWide)
+  {
+    W::Store(r, W::LoadI(a));
+    r += W::NumRegisters;
+    a += W::NumRegisters;
+  }
+  while (r != re)
+  {
+    r->i = a->i;
+    ++r;
+    ++a;
+  }
+}
+
+PL_EXPRESSIONVM_WIDE_TARGET void VM_MovX_C(const ByteCodeType*& pByteCode, ExecutionContext& context)
+{
+  DEFINE_TARGET_REGISTER();
+  DEFINE_WIDE_END();
+  const plExpression::Register a = plExpressionByteCode::GetConstant(pByteCode);
+  const auto wa = W::BroadcastI(a);
+  while (r != reWide)
+  {
+    W::Store(r, wa);
+    r += W::NumRegisters;
+  }
+  while (r != re)
+  {
+    r->i = a.i;
+    ++r;
+  }
+}
+
+// Opcodes without a wide variant keep the 4-wide function
+constexpr WideFuncTable MakeFuncTable()
+{
+  using OpCode = plExpressionByteCode::OpCode;
+
+  WideFuncTable table = {};
+  for (plUInt32 i = 0; i < OpCode::Count; ++i)
+  {
+    table.m_Funcs[i] = s_Simd4Funcs[i];
+  }
+
+  table.m_Funcs[OpCode::AbsF_R] = &AbsF;
+  table.m_Funcs[OpCode::AbsI_R] = &AbsI;
+  table.m_Funcs[OpCode::SqrtF_R] = &SqrtF;
+
+  table.m_Funcs[OpCode::RoundF_R] = &RoundF;
+  table.m_Funcs[OpCode::FloorF_R] = &FloorF;
+  table.m_Funcs[OpCode::CeilF_R] = &CeilF;
+  table.m_Funcs[OpCode::TruncF_R] = &TruncF;
+
+  table.m_Funcs[OpCode::NotI_R] = &NotI;
+  table.m_Funcs[OpCode::NotB_R] = &NotB;
+
+  table.m_Funcs[OpCode::IToF_R] = &IToF;
+  table.m_Funcs[OpCode::FToI_R] = &FToI;
+
+  table.m_Funcs[OpCode::AddF_RR] = &AddF<false>;
+  table.m_Funcs[OpCode::AddI_RR] = &AddI<false>;
+  table.m_Funcs[OpCode::SubF_RR] = &SubF<false>;
+  table.m_Funcs[OpCode::SubI_RR] = &SubI<false>;
+  table.m_Funcs[OpCode::MulF_RR] = &MulF<false>;
+  table.m_Funcs[OpCode::MulI_RR] = &MulI<false>;
+  table.m_Funcs[OpCode::DivF_RR] = &DivF<false>;
+  table.m_Funcs[OpCode::MinF_RR] = &MinF<false>;
+  table.m_Funcs[OpCode::MinI_RR] = &MinI<false>;
+  table.m_Funcs[OpCode::MaxF_RR] = &MaxF<false>;
+  table.m_Funcs[OpCode::MaxI_RR] = &MaxI<false>;
+  table.m_Funcs[OpCode::ShlI_RR] = &ShlI<false>;
+  table.m_Funcs[OpCode::ShrI_RR] = &ShrI<false>;
+  table.m_Funcs[OpCode::AndI_RR] = &AndI<false>;
+  table.m_Funcs[OpCode::XorI_RR] = &XorI<false>;
+  table.m_Funcs[OpCode::OrI_RR] = &OrI<false>;
+  table.m_Funcs[OpCode::EqF_RR] = &EqF<false>;
+  table.m_Funcs[OpCode::EqI_RR] = &EqI<false>;
+  table.m_Funcs[OpCode::EqB_RR] = &EqB<false>;
+  table.m_Funcs[OpCode::NEqF_RR] = &NEqF<false>;
+  table.m_Funcs[OpCode::NEqI_RR] = &NEqI<false>;
+  table.m_Funcs[OpCode::NEqB_RR] = &NEqB<false>;
+  table.m_Funcs[OpCode::LtF_RR] = &LtF<false>;
+  table.m_Funcs[OpCode::LtI_RR] = &LtI<false>;
+  table.m_Funcs[OpCode::LEqF_RR] = &LEqF<false>;
+  table.m_Funcs[OpCode::LEqI_RR] = &LEqI<false>;
+  table.m_Funcs[OpCode::GtF_RR] = &GtF<false>;
+  table.m_Funcs[OpCode::GtI_RR] = &GtI<false>;
+  table.m_Funcs[OpCode::GEqF_RR] = &GEqF<false>;
+  table.m_Funcs[OpCode::GEqI_RR] = &GEqI<false>;
+  table.m_Funcs[OpCode::AndB_RR] = &AndB<false>;
+  table.m_Funcs[OpCode::OrB_RR] = &OrB<false>;
+
+  table.m_Funcs[OpCode::AddF_RC] = &AddF<true>;
+  table.m_Funcs[OpCode::AddI_RC] = &AddI<true>;
+  table.m_Funcs[OpCode::SubF_RC] = &SubF<true>;
+  table.m_Funcs[OpCode::SubI_RC] = &SubI<true>;
+  table.m_Funcs[OpCode::MulF_RC] = &MulF<true>;
+  table.m_Funcs[OpCode::MulI_RC] = &MulI<true>;
+  table.m_Funcs[OpCode::DivF_RC] = &DivF<true>;
+  table.m_Funcs[OpCode::MinF_RC] = &MinF<true>;
+  table.m_Funcs[OpCode::MinI_RC] = &MinI<true>;
+  table.m_Funcs[OpCode::MaxF_RC] = &MaxF<true>;
+  table.m_Funcs[OpCode::MaxI_RC] = &MaxI<true>;
+  table.m_Funcs[OpCode::ShlI_RC] = &ShlI_C<true>;
+  table.m_Funcs[OpCode::ShrI_RC] = &ShrI_C<true>;
+  table.m_Funcs[OpCode::AndI_RC] = &AndI<true>;
+  table.m_Funcs[OpCode::XorI_RC] = &XorI<true>;
+  table.m_Funcs[OpCode::OrI_RC] = &OrI<true>;
+  table.m_Funcs[OpCode::EqF_RC] = &EqF<true>;
+  table.m_Funcs[OpCode::EqI_RC] = &EqI<true>;
+  table.m_Funcs[OpCode::EqB_RC] = &EqB<true>;
+  table.m_Funcs[OpCode::NEqF_RC] = &NEqF<true>;
+  table.m_Funcs[OpCode::NEqI_RC] = &NEqI<true>;
+  table.m_Funcs[OpCode::NEqB_RC] = &NEqB<true>;
+  table.m_Funcs[OpCode::LtF_RC] = &LtF<true>;
+  table.m_Funcs[OpCode::LtI_RC] = &LtI<true>;
+  table.m_Funcs[OpCode::LEqF_RC] = &LEqF<true>;
+  table.m_Funcs[OpCode::LEqI_RC] = &LEqI<true>;
+  table.m_Funcs[OpCode::GtF_RC] = &GtF<true>;
+  table.m_Funcs[OpCode::GtI_RC] = &GtI<true>;
+  table.m_Funcs[OpCode::GEqF_RC] = &GEqF<true>;
+  table.m_Funcs[OpCode::GEqI_RC] = &GEqI<true>;
+  table.m_Funcs[OpCode::AndB_RC] = &AndB<true>;
+  table.m_Funcs[OpCode::OrB_RC] = &OrB<true>;
+
+  table.m_Funcs[OpCode::SelF_RRR] = &SelF;
+  table.m_Funcs[OpCode::SelI_RRR] = &SelI;
+  table.m_Funcs[OpCode::SelB_RRR] = &SelB;
+
+  table.m_Funcs[OpCode::MovX_R] = &VM_MovX_R;
+  table.m_Funcs[OpCode::MovX_C] = &VM_MovX_C;
+
+  return table;
+}
+
+static constexpr WideFuncTable s_Funcs = MakeFuncTable();
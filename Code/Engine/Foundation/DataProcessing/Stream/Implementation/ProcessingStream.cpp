@@ -54,7 +54,8 @@ plProcessingStream::~plProcessingStream()
 
 void plProcessingStream::SetSize(plUInt64 uiNumElements)
 {
-  plUInt64 uiNewDataSize = uiNumElements * m_uiTypeSize;
+  // Pad to a multiple of four elements, so SIMD code can always process whole groups of four without a scalar loop for the remainder
+  plUInt64 uiNewDataSize = plMemoryUtils::AlignSize<plUInt64>(uiNumElements, 4) * m_uiTypeSize;
   if (m_uiDataSize == uiNewDataSize)
     return;
 
@@ -6,6 +6,7 @@
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Memory/MemoryUtils.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 plProcessingStreamGroup::plProcessingStreamGroup()
 {
@@ -161,10 +162,24 @@ void plProcessingStreamGroup::Process()
 {
   EnsureStreamAssignmentValid();
 
-  // TODO: Identify which processors work on which streams and find independent groups and use separate tasks for them?
-  for (plProcessingStreamProcessor* pStreamProcessor : m_Processors)
+  for (plUInt32 i = 0; i < m_Processors.GetCount();)
   {
-    pStreamProcessor->Process(m_uiNumActiveElements);
+    if (!m_Processors[i]->CanProcessInParallel())
+    {
+      m_Processors[i]->Process(m_uiNumActiveElements);
+      ++i;
+      continue;
+    }
+
+    // find all consecutive processors that can work on ranges, so that each chunk of elements is passed through all of them while it is in the cache
+    plUInt32 uiEnd = i + 1;
+    while (uiEnd < m_Processors.GetCount() && m_Processors[uiEnd]->CanProcessInParallel())
+    {
+      ++uiEnd;
+    }
+
+    ProcessRanges(m_Processors.GetArrayPtr().GetSubArray(i, uiEnd - i));
+    i = uiEnd;
   }
 
   // Run any pending deletions which happened due to stream processor execution
@@ -176,6 +191,45 @@ void plProcessingStreamGroup::Process()
 }
 
 
+void plProcessingStreamGroup::ProcessRanges(plArrayPtr<plProcessingStreamProcessor* const> processors)
+{
+  const plUInt64 uiNumElements = m_uiNumActiveElements;
+
+  // chunks have to start at multiples of four, since processors may work on groups of four elements
+  const plUInt64 uiChunkSize = plMemoryUtils::AlignSize<plUInt64>(plMath::Max(m_uiMinElementsPerTask, 1u), 4);
+  const plUInt64 uiNumChunks = (uiNumElements + uiChunkSize - 1) / uiChunkSize;
+
+  if (m_uiMinElementsPerTask == 0 || uiNumChunks < 2)
+  {
+    for (plProcessingStreamProcessor* pStreamProcessor : processors)
+    {
+      pStreamProcessor->ProcessRange(0, uiNumElements);
+    }
+
+    return;
+  }
+
+  plParallelForParams params;
+  params.m_uiBinSize = 1;
+
+  plTaskSystem::ParallelForIndexed(
+    0u, static_cast<plUInt32>(uiNumChunks),
+    [&](plUInt32 uiFirstChunk, plUInt32 uiEndChunk)
+    {
+      for (plUInt32 uiChunk = uiFirstChunk; uiChunk < uiEndChunk; ++uiChunk)
+      {
+        const plUInt64 uiStartIndex = uiChunk * uiChunkSize;
+        const plUInt64 uiNumChunkElements = plMath::Min(uiChunkSize, uiNumElements - uiStartIndex);
+
+        for (plProcessingStreamProcessor* pStreamProcessor : processors)
+        {
+          pStreamProcessor->ProcessRange(uiStartIndex, uiNumChunkElements);
+        }
+      }
+    },
+    "Stream Group Process Range", plTaskNesting::Maybe, params);
+}
+
 void plProcessingStreamGroup::RunPendingDeletions()
 {
   plStreamGroupElementRemovedEvent e;
@@ -4,6 +4,10 @@
 #include <Foundation/Strings/HashedString.h>
 
 /// \brief A single stream in a stream group holding contiguous data of a given type.
+///
+/// Streams that are allocated by a stream group are aligned to 16 bytes and padded to a multiple of four elements.
+/// Processors can therefore always read and write whole groups of four elements, e.g. with plSimdVec4f, even if the element count is not a multiple of four.
+/// The content of the elements beyond the element count is undefined.
 class PL_FOUNDATION_DLL plProcessingStream
 {
 public:
@@ -67,6 +67,16 @@ public:
   /// \brief Runs the stream processors which have been added to the stream group.
   void Process();
 
+  /// \brief Allows Process() to split the elements into chunks of (at least) the given size and to process them on multiple threads.
+  ///
+  /// Only consecutive processors that return true from plProcessingStreamProcessor::CanProcessInParallel() are split, each chunk is passed through
+  /// all of them in order. Since these processors don't depend on other elements, the result is the same as with serial processing.
+  /// Chunks are only used when there are at least two of them. 0 disables parallel processing, which is the default.
+  void SetMinElementsPerTask(plUInt32 uiMinElementsPerTask) { m_uiMinElementsPerTask = uiMinElementsPerTask; }
+
+  /// \brief Returns the value set with SetMinElementsPerTask().
+  plUInt32 GetMinElementsPerTask() const { return m_uiMinElementsPerTask; }
+
   /// \brief Returns the number of elements the streams store.
   inline plUInt64 GetNumElements() const { return m_uiNumElements; }
 
@@ -89,6 +99,8 @@ private:
 
   void SortProcessorsByPriority();
 
+  void ProcessRanges(plArrayPtr<plProcessingStreamProcessor* const> processors);
+
   plHybridArray<plProcessingStreamProcessor*, 8> m_Processors;
 
   plHybridArray<plProcessingStream*, 8> m_DataStreams;
@@ -103,5 +115,7 @@ private:
 
   plUInt64 m_uiHighestNumActiveElements;
 
+  plUInt32 m_uiMinElementsPerTask = 0;
+
   bool m_bStreamAssignmentDirty;
 };
@@ -35,6 +35,23 @@ protected:
   /// \brief The actual method which processes the data, will be called with the number of elements to process.
   virtual void Process(plUInt64 uiNumElements) = 0;
 
+  /// \brief Return true if the processor only reads and writes the elements it is asked to process and doesn't modify any other shared state.
+  ///
+  /// Such processors are executed through ProcessRange() instead of Process() and the stream group may process different ranges
+  /// on multiple threads at the same time (see plProcessingStreamGroup::SetMinElementsPerTask()).
+  virtual bool CanProcessInParallel() const { return false; }
+
+  /// \brief Processes uiNumElements elements starting at uiStartIndex.
+  ///
+  /// uiStartIndex is always a multiple of four, so processors can work on groups of four elements.
+  /// The default implementation forwards to Process(). That is only correct for processors that return false from CanProcessInParallel(),
+  /// since those are always asked to process all elements at once, so every processor that can process in parallel has to override this.
+  virtual void ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements)
+  {
+    PL_ASSERT_DEV(!CanProcessInParallel() && uiStartIndex == 0, "Stream processors that can process in parallel have to override ProcessRange().");
+    Process(uiNumElements);
+  }
+
   /// \brief Back pointer to the stream group - will be set to the owner stream group when adding the stream processor to the group.
   /// Can be used to get stream pointers in UpdateStreamBindings();
   plProcessingStreamGroup* m_pStreamGroup = nullptr;
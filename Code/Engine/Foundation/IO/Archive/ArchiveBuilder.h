@@ -22,6 +22,13 @@ public:
   // all the source files from disk that should be put into the plArchive
   plDeque<SourceEntry> m_Entries;
 
+  /// \brief Limits how many bytes of source files may be compressed ahead of writing them, and thus the peak memory usage of WriteArchive().
+  ///
+  /// WriteArchive() compresses entries in parallel on the plTaskSystem and keeps the results in memory, until they can be written in order.
+  /// A single file that is larger than this limit is still compressed, but nothing else is compressed in parallel to it.
+  /// Set this to 0 to compress all entries one after another on the calling thread.
+  plUInt64 m_uiMaxParallelCompressionBytes = 512ull * 1024 * 1024;
+
   enum class InclusionMode
   {
     Exclude,               ///< Do not add this file to the archive
@@ -46,6 +53,9 @@ public:
   plResult WriteArchive(plStringView sFile) const;
 
   /// \brief Writes the previously gathered files to the file stream
+  ///
+  /// The entries are always written in the order of m_Entries, the result does not depend on how many of them were compressed in parallel.
+  /// All callbacks are executed on the calling thread.
   plResult WriteArchive(plStreamWriter& inout_stream) const;
 
 protected:
@@ -33,6 +33,12 @@ public:
   /// \brief Creates a reader that will decompress the given file entry.
   plUniquePtr<plStreamReader> CreateEntryReader(plUInt32 uiEntryIdx) const;
 
+  /// \brief Returns the data of the given entry directly from the memory mapped archive, without copying it.
+  ///
+  /// This only works for entries that are stored uncompressed (and are smaller than 4 GB). For all other entries an empty array is returned
+  /// and CreateEntryReader() has to be used instead. The memory stays valid as long as the archive is open.
+  plArrayPtr<const plUInt8> GetUncompressedEntryData(plUInt32 uiEntryIdx) const;
+
 protected:
   /// \brief Called by ExtractAllFiles() for progress reporting. Return false to abort.
   virtual bool ExtractNextFileCallback(plUInt32 uiCurEntry, plUInt32 uiMaxEntries, plStringView sSourceFile) const;
@@ -10,6 +10,7 @@ class plMemoryMappedFile;
 class plArchiveTOC;
 class plArchiveEntry;
 class plRawMemoryStreamReader;
+class plDefaultMemoryStreamStorage;
 
 /// \brief Utilities for working with plArchive files
 namespace plArchiveUtils
@@ -51,6 +52,26 @@ namespace plArchiveUtils
     plArchiveCompressionMode compression, plInt32 iCompressionLevel, plArchiveEntry& ref_tocEntry, plUInt64& inout_uiCurrentStreamPosition,
     FileWriteProgressCallback progress = FileWriteProgressCallback());
 
+  /// \brief Compresses a single file into memory, so that it can be written with WriteCompressedEntry() later.
+  ///
+  /// This allows to compress multiple entries in parallel and still write them to the archive in a fixed order.
+  /// Like WriteEntryOptimal(), this checks whether compression makes enough of a difference. If not, \a out_storage is cleared and
+  /// \a out_tocEntry is set to plArchiveCompressionMode::Uncompressed.
+  /// \a uiMaxNumWorkerThreads is passed on to the compressor, use 1 when many entries are compressed in parallel anyway.
+  /// Any value above 0 produces the same output as WriteEntry(), 0 switches zstd to its single-threaded mode, which produces different output.
+  /// The progress callback is executed from the calling thread for every couple of KB of data that were compressed.
+  PL_FOUNDATION_DLL plResult CompressEntry(plStringView sAbsSourcePath, plArchiveCompressionMode compression, plInt32 iCompressionLevel,
+    plUInt32 uiMaxNumWorkerThreads, plArchiveEntry& out_tocEntry, plDefaultMemoryStreamStorage& out_storage,
+    FileWriteProgressCallback progress = FileWriteProgressCallback());
+
+  /// \brief Writes an entry that was prepared with CompressEntry() to the stream.
+  ///
+  /// Updates \a ref_tocEntry and \a inout_uiCurrentStreamPosition the same way as WriteEntry().
+  /// If CompressEntry() decided to store the file uncompressed, the file is read from \a sAbsSourcePath again.
+  PL_FOUNDATION_DLL plResult WriteCompressedEntry(plStreamWriter& inout_stream, plStringView sAbsSourcePath, plUInt32 uiPathStringOffset,
+    const plDefaultMemoryStreamStorage& storage, plArchiveEntry& ref_tocEntry, plUInt64& inout_uiCurrentStreamPosition,
+    FileWriteProgressCallback progress = FileWriteProgressCallback());
+
   /// \brief Configures \a memReader as a view into the data stored for \a entry in the archive file.
   ///
   /// The raw memory stream may be compressed or uncompressed. This only creates a view for the stored data, it does not interpret it.
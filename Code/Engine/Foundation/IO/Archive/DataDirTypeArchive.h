@@ -63,6 +63,7 @@ namespace plDataDirectory
 
     virtual plUInt64 Read(void* pBuffer, plUInt64 uiBytes) override;
     virtual plUInt64 GetFileSize() const override;
+    virtual plArrayPtr<const plUInt8> GetMappedFileContent() const override;
 
   protected:
     virtual plResult InternalOpen(plFileShareMode::Enum FileShareMode) override;
@@ -73,6 +74,7 @@ namespace plDataDirectory
     plUInt64 m_uiUncompressedSize = 0;
     plUInt64 m_uiCompressedSize = 0;
     plRawMemoryStreamReader m_MemStreamReader;
+    plArrayPtr<const plUInt8> m_MappedContent; // only set for uncompressed entries
   };
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
@@ -5,7 +5,10 @@
 #include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/IO/OSFile.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Stopwatch.h>
 
 void plArchiveBuilder::AddFolder(plStringView sAbsFolderPath, plArchiveCompressionMode defaultMode /*= plArchiveCompressionMode::Uncompressed*/, InclusionCallback callback /*= InclusionCallback()*/)
@@ -94,6 +97,39 @@ plResult plArchiveBuilder::WriteArchive(plStringView sFile) const
   return WriteArchive(file);
 }
 
+namespace
+{
+  /// \brief An entry that is compressed on another thread, before it is written to the archive.
+  struct PrecompressedEntry
+  {
+    const plArchiveBuilder::SourceEntry* m_pSource = nullptr;
+    plUInt64 m_uiSourceSize = 0;
+    plUInt32 m_uiMaxNumWorkerThreads = 0;
+    plTaskGroupID m_TaskGroup;
+
+    plArchiveEntry m_TocEntry;
+    plDefaultMemoryStreamStorage m_Storage;
+    plTime m_Duration;
+    plResult m_Result = PL_FAILURE;
+    plAtomicInteger64 m_iBytesCompressed;
+
+    void Compress()
+    {
+      plStopwatch sw;
+      m_Result = plArchiveUtils::CompressEntry(m_pSource->m_sAbsSourcePath, m_pSource->m_CompressionMode, m_pSource->m_iCompressionLevel, m_uiMaxNumWorkerThreads, m_TocEntry, m_Storage, plMakeDelegate(&PrecompressedEntry::CompressProgress, this));
+      m_Duration = sw.GetRunningTotal();
+    }
+
+    bool CompressProgress(plUInt64 uiBytesRead, plUInt64 uiBytesTotal)
+    {
+      m_iBytesCompressed.Set(static_cast<plInt64>(uiBytesRead));
+      return true;
+    }
+  };
+
+  constexpr plUInt64 CompressionProgressStep = 256 * 1024;
+} // namespace
+
 plResult plArchiveBuilder::WriteArchive(plStreamWriter& inout_stream) const
 {
   PL_SUCCEED_OR_RETURN(plArchiveUtils::WriteHeader(inout_stream));
@@ -107,8 +143,67 @@ plResult plArchiveBuilder::WriteArchive(plStreamWriter& inout_stream) const
 
   plStopwatch sw;
 
+  // Compressed entries are compressed ahead of time on the task system, as long as the memory budget allows it.
+  // Uncompressed entries are streamed directly from the source file, when it is their turn.
+  plDynamicArray<plUniquePtr<PrecompressedEntry>> precompressed;
+  precompressed.SetCount(m_uiMaxParallelCompressionBytes > 0 ? uiNumEntries : 0);
+
+  plUInt32 uiNextEntryToCompress = 0;
+  plUInt64 uiBytesInFlight = 0;
+
+  auto StartCompressionTasks = [&]()
+  {
+    for (; uiNextEntryToCompress < precompressed.GetCount(); ++uiNextEntryToCompress)
+    {
+      const SourceEntry& e = m_Entries[uiNextEntryToCompress];
+
+      if (e.m_CompressionMode == plArchiveCompressionMode::Uncompressed)
+        continue;
+
+      plUInt64 uiSourceSize = 0;
+      {
+        plOSFile file;
+        if (file.Open(e.m_sAbsSourcePath, plFileOpenMode::Read).Succeeded())
+        {
+          uiSourceSize = file.GetFileSize();
+        }
+      }
+
+      if (uiBytesInFlight > 0 && uiBytesInFlight + uiSourceSize > m_uiMaxParallelCompressionBytes)
+        break;
+
+      plUniquePtr<PrecompressedEntry> pEntry = PL_DEFAULT_NEW(PrecompressedEntry);
+      pEntry->m_pSource = &e;
+      pEntry->m_uiSourceSize = uiSourceSize;
+
+      // Files that take up the whole budget are compressed alone, so let the compressor use multiple threads for them.
+      // Never use 0 here, zstd only produces the same output as plArchiveUtils::WriteEntry() when it runs in multi-threaded mode,
+      // the number of worker threads doesn't affect the output.
+      pEntry->m_uiMaxNumWorkerThreads = (uiSourceSize * 2 > m_uiMaxParallelCompressionBytes) ? 12u : 1u;
+
+      plSharedPtr<plTask> pTask = PL_DEFAULT_NEW(plDelegateTask<void>, "CompressArchiveEntry", plTaskNesting::Never, plMakeDelegate(&PrecompressedEntry::Compress, pEntry.Borrow()));
+      pEntry->m_TaskGroup = plTaskSystem::StartSingleTask(pTask, plTaskPriority::LongRunning);
+
+      uiBytesInFlight += uiSourceSize;
+      precompressed[uiNextEntryToCompress] = std::move(pEntry);
+    }
+  };
+
+  auto WaitForCompressionTasks = [&]()
+  {
+    for (auto& pEntry : precompressed)
+    {
+      if (pEntry != nullptr)
+      {
+        plTaskSystem::WaitForGroup(pEntry->m_TaskGroup);
+      }
+    }
+  };
+
   for (plUInt32 i = 0; i < uiNumEntries; ++i)
   {
+    StartCompressionTasks();
+
     const SourceEntry& e = m_Entries[i];
 
     const plUInt32 uiPathStringOffset = toc.m_AllPathStrings.GetCount();
@@ -120,13 +215,64 @@ plResult plArchiveBuilder::WriteArchive(plStreamWriter& inout_stream) const
     toc.m_PathToEntryIndex[plArchiveStoredString(plHashingUtils::StringHash(sHashablePath), uiPathStringOffset)] = toc.m_Entries.GetCount();
 
     if (!WriteNextFileCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath))
+    {
+      WaitForCompressionTasks();
       return PL_FAILURE;
+    }
 
     plArchiveEntry& tocEntry = toc.m_Entries.ExpandAndGetRef();
 
-    PL_SUCCEED_OR_RETURN(plArchiveUtils::WriteEntryOptimal(inout_stream, e.m_sAbsSourcePath, uiPathStringOffset, e.m_CompressionMode, e.m_iCompressionLevel, tocEntry, uiStreamSize, plMakeDelegate(&plArchiveBuilder::WriteFileProgressCallback, this)));
+    plResult res = PL_SUCCESS;
+    plTime duration;
+
+    if (i < precompressed.GetCount() && precompressed[i] != nullptr)
+    {
+      plUniquePtr<PrecompressedEntry> pEntry = std::move(precompressed[i]);
+
+      // report the progress of the entry while it is still being compressed
+      plUInt64 uiBytesReported = 0;
+      auto IsDoneOrProgressed = [&]()
+      { return plTaskSystem::IsTaskGroupFinished(pEntry->m_TaskGroup) || static_cast<plUInt64>(pEntry->m_iBytesCompressed) >= uiBytesReported + CompressionProgressStep; };
+
+      while (!plTaskSystem::IsTaskGroupFinished(pEntry->m_TaskGroup))
+      {
+        plTaskSystem::WaitForCondition(IsDoneOrProgressed);
+
+        uiBytesReported = static_cast<plUInt64>(pEntry->m_iBytesCompressed);
+        if (!WriteFileProgressCallback(uiBytesReported, pEntry->m_uiSourceSize))
+        {
+          // pEntry isn't in precompressed anymore, so it has to be waited for separately before it gets destroyed
+          plTaskSystem::WaitForGroup(pEntry->m_TaskGroup);
+          WaitForCompressionTasks();
+          return PL_FAILURE;
+        }
+      }
+
+      sw.Checkpoint();
+
+      res = pEntry->m_Result;
+      if (res.Succeeded())
+      {
+        tocEntry = pEntry->m_TocEntry;
+        res = plArchiveUtils::WriteCompressedEntry(inout_stream, e.m_sAbsSourcePath, uiPathStringOffset, pEntry->m_Storage, tocEntry, uiStreamSize, plMakeDelegate(&plArchiveBuilder::WriteFileProgressCallback, this));
+      }
+
+      uiBytesInFlight -= pEntry->m_uiSourceSize;
+      duration = pEntry->m_Duration + sw.Checkpoint();
+    }
+    else
+    {
+      res = plArchiveUtils::WriteEntryOptimal(inout_stream, e.m_sAbsSourcePath, uiPathStringOffset, e.m_CompressionMode, e.m_iCompressionLevel, tocEntry, uiStreamSize, plMakeDelegate(&plArchiveBuilder::WriteFileProgressCallback, this));
+      duration = sw.Checkpoint();
+    }
+
+    if (res.Failed())
+    {
+      WaitForCompressionTasks();
+      return PL_FAILURE;
+    }
 
-    WriteFileResultCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath, tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiStoredDataSize, sw.Checkpoint());
+    WriteFileResultCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath, tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiStoredDataSize, duration);
   }
 
   PL_SUCCEED_OR_RETURN(plArchiveUtils::AppendTOC(inout_stream, toc));
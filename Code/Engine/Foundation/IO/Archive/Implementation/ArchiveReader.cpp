@@ -109,6 +109,17 @@ plUniquePtr<plStreamReader> plArchiveReader::CreateEntryReader(plUInt32 uiEntryI
   return plArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart);
 }
 
+plArrayPtr<const plUInt8> plArchiveReader::GetUncompressedEntryData(plUInt32 uiEntryIdx) const
+{
+  const plArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+
+  if (entry.m_CompressionMode != plArchiveCompressionMode::Uncompressed || entry.m_uiStoredDataSize > plMath::MaxValue<plUInt32>())
+    return {};
+
+  const plUInt8* pData = static_cast<const plUInt8*>(plMemoryUtils::AddByteOffset(m_pDataStart, static_cast<std::ptrdiff_t>(entry.m_uiDataStartOffset)));
+  return plArrayPtr<const plUInt8>(pData, static_cast<plUInt32>(entry.m_uiStoredDataSize));
+}
+
 plResult plArchiveReader::ExtractFile(plUInt32 uiEntryIdx, plStringView sTargetFolder) const
 {
   plStringView sFilePath = m_ArchiveTOC.GetEntryPathString(uiEntryIdx);
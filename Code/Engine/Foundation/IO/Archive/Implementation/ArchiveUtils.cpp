@@ -86,9 +86,9 @@ plResult plArchiveUtils::ReadHeader(plStreamReader& inout_stream, plUInt8& out_u
   return PL_SUCCESS;
 }
 
-plResult plArchiveUtils::WriteEntry(
-  plStreamWriter& inout_stream, plStringView sAbsSourcePath, plUInt32 uiPathStringOffset, plArchiveCompressionMode compression,
-  plInt32 iCompressionLevel, plArchiveEntry& inout_tocEntry, plUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
+static plResult WriteEntryImpl(plStreamWriter& inout_stream, plStringView sAbsSourcePath, plUInt32 uiPathStringOffset, plArchiveCompressionMode compression,
+  plInt32 iCompressionLevel, plUInt32 uiMaxNumWorkerThreads, plArchiveEntry& inout_tocEntry, plUInt64& inout_uiCurrentStreamPosition,
+  plArchiveUtils::FileWriteProgressCallback progress)
 {
   plFileReader file;
   PL_SUCCEED_OR_RETURN(file.Open(sAbsSourcePath, 1024 * 1024));
@@ -115,7 +115,6 @@ plResult plArchiveUtils::WriteEntry(
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
     case plArchiveCompressionMode::Compressed_zstd:
     {
-      constexpr plUInt32 uiMaxNumWorkerThreads = 12u;
       zstdWriter.SetOutputStream(&inout_stream, uiMaxNumWorkerThreads, (plCompressedStreamWriterZstd::Compression)iCompressionLevel);
       pWriter = &zstdWriter;
     }
@@ -169,6 +168,14 @@ plResult plArchiveUtils::WriteEntry(
   return PL_SUCCESS;
 }
 
+plResult plArchiveUtils::WriteEntry(
+  plStreamWriter& inout_stream, plStringView sAbsSourcePath, plUInt32 uiPathStringOffset, plArchiveCompressionMode compression,
+  plInt32 iCompressionLevel, plArchiveEntry& inout_tocEntry, plUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
+{
+  constexpr plUInt32 uiMaxNumWorkerThreads = 12u;
+  return WriteEntryImpl(inout_stream, sAbsSourcePath, uiPathStringOffset, compression, iCompressionLevel, uiMaxNumWorkerThreads, inout_tocEntry, inout_uiCurrentStreamPosition, progress);
+}
+
 plResult plArchiveUtils::WriteEntryOptimal(plStreamWriter& inout_stream, plStringView sAbsSourcePath, plUInt32 uiPathStringOffset, plArchiveCompressionMode compression, plInt32 iCompressionLevel, plArchiveEntry& ref_tocEntry, plUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
 {
   if (compression == plArchiveCompressionMode::Uncompressed)
@@ -198,6 +205,63 @@ plResult plArchiveUtils::WriteEntryOptimal(plStreamWriter& inout_stream, plStrin
   }
 }
 
+plResult plArchiveUtils::CompressEntry(plStringView sAbsSourcePath, plArchiveCompressionMode compression, plInt32 iCompressionLevel, plUInt32 uiMaxNumWorkerThreads, plArchiveEntry& out_tocEntry, plDefaultMemoryStreamStorage& out_storage, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
+{
+  out_storage.Clear();
+
+  if (compression == plArchiveCompressionMode::Uncompressed)
+  {
+    out_tocEntry.m_CompressionMode = plArchiveCompressionMode::Uncompressed;
+    return PL_SUCCESS;
+  }
+
+  plMemoryStreamWriter writer(&out_storage);
+
+  plUInt64 streamPos = 0;
+  PL_SUCCEED_OR_RETURN(WriteEntryImpl(writer, sAbsSourcePath, 0, compression, iCompressionLevel, uiMaxNumWorkerThreads, out_tocEntry, streamPos, progress));
+
+  if (out_tocEntry.m_CompressionMode != plArchiveCompressionMode::Uncompressed && out_tocEntry.m_uiStoredDataSize * 12 >= out_tocEntry.m_uiUncompressedDataSize * 10)
+  {
+    // less than 20% size saving -> go uncompressed
+    out_tocEntry.m_CompressionMode = plArchiveCompressionMode::Uncompressed;
+    out_tocEntry.m_uiStoredDataSize = out_tocEntry.m_uiUncompressedDataSize;
+  }
+
+  if (out_tocEntry.m_CompressionMode == plArchiveCompressionMode::Uncompressed)
+  {
+    // the data is read from the source file again when it is written
+    out_storage.Clear();
+    out_storage.Compact();
+  }
+
+  return PL_SUCCESS;
+}
+
+plResult plArchiveUtils::WriteCompressedEntry(plStreamWriter& inout_stream, plStringView sAbsSourcePath, plUInt32 uiPathStringOffset, const plDefaultMemoryStreamStorage& storage, plArchiveEntry& ref_tocEntry, plUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
+{
+  if (ref_tocEntry.m_CompressionMode == plArchiveCompressionMode::Uncompressed)
+  {
+    return WriteEntry(inout_stream, sAbsSourcePath, uiPathStringOffset, plArchiveCompressionMode::Uncompressed, 0, ref_tocEntry, inout_uiCurrentStreamPosition, progress);
+  }
+
+  PL_ASSERT_DEV(storage.GetStorageSize64() == ref_tocEntry.m_uiStoredDataSize, "The storage doesn't contain the compressed data for this entry.");
+
+  ref_tocEntry.m_uiPathStringOffset = uiPathStringOffset;
+  ref_tocEntry.m_uiDataStartOffset = inout_uiCurrentStreamPosition;
+
+  PL_SUCCEED_OR_RETURN(storage.CopyToStream(inout_stream));
+
+  if (progress.IsValid())
+  {
+    if (!progress(ref_tocEntry.m_uiUncompressedDataSize, ref_tocEntry.m_uiUncompressedDataSize))
+      return PL_FAILURE;
+  }
+
+  inout_uiCurrentStreamPosition += ref_tocEntry.m_uiStoredDataSize;
+
+  return PL_SUCCESS;
+}
+
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
 
 class plCompressedStreamReaderZstdWithSource : public plCompressedStreamReaderZstd
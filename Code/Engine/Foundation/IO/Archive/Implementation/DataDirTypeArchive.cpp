@@ -98,6 +98,7 @@ plDataDirectoryReader* plDataDirectory::ArchiveType::OpenFileToRead(plStringView
   pReader->m_uiCompressedSize = pEntry->m_uiStoredDataSize;
 
   m_ArchiveReader.ConfigureRawMemoryStreamReader(uiEntryIndex, pReader->m_MemStreamReader);
+  pReader->m_MappedContent = m_ArchiveReader.GetUncompressedEntryData(uiEntryIndex);
 
   if (pReader->Open(sArchivePath, this, FileShareMode).Failed())
   {
@@ -246,6 +247,11 @@ plUInt64 plDataDirectory::ArchiveReaderUncompressed::GetFileSize() const
   return m_uiUncompressedSize;
 }
 
+plArrayPtr<const plUInt8> plDataDirectory::ArchiveReaderUncompressed::GetMappedFileContent() const
+{
+  return m_MappedContent;
+}
+
 plResult plDataDirectory::ArchiveReaderUncompressed::InternalOpen(plFileShareMode::Enum FileShareMode)
 {
   PL_ASSERT_DEBUG(FileShareMode != plFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
@@ -256,7 +262,7 @@ plResult plDataDirectory::ArchiveReaderUncompressed::InternalOpen(plFileShareMod
 
 void plDataDirectory::ArchiveReaderUncompressed::InternalClose()
 {
-  // nothing to do
+  m_MappedContent.Clear();
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Map.h>
+#include <Foundation/IO/DirectoryWatcher.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
 #include <Foundation/IO/OSFile.h>
+#include <Foundation/Types/UniquePtr.h>
 
 namespace plDataDirectory
 {
@@ -34,6 +37,15 @@ namespace plDataDirectory
     /// access.
     static plString s_sRedirectionPrefix;
 
+#if PL_ENABLED(PL_SUPPORTS_DIRECTORY_WATCHER)
+    /// If enabled, folder data directories that are mounted afterwards remember to which file a requested path was redirected and whether
+    /// that file exists. This speeds up ExistsFile() and especially the failed attempts to open a file, which happen a lot when many data
+    /// directories are mounted. The cache is cleared whenever a plDirectoryWatcher reports that files were added, removed or renamed in the
+    /// data directory, when the redirection file is reloaded and whenever a file is written or deleted through the data directory.
+    /// Changes by other processes may be noticed with a short delay.
+    static bool s_bCacheResolvedFiles;
+#endif
+
     /// \brief When s_sRedirectionFile and s_sRedirectionPrefix are used to enable file redirection, this will reload those config files.
     virtual void ReloadExternalConfigs() override;
 
@@ -61,6 +73,14 @@ namespace plDataDirectory
 
     void LoadRedirectionFile();
 
+    /// \brief Applies the asset redirection to \a sFile and returns whether the resulting file exists.
+    ///
+    /// \a out_sRedirectedFile is relative to this data directory. Uses the resolved file cache, if it is enabled.
+    bool ResolveFile(plStringView sFile, plStringBuilder& out_sRedirectedFile);
+
+    /// \brief Clears the resolved file cache, if it is enabled.
+    void InvalidateResolvedFileCache();
+
     mutable plMutex m_ReaderWriterMutex; ///< Locks m_Readers / m_Writers as well as the m_bIsInUse flag of each reader / writer.
     plHybridArray<plDataDirectory::FolderReader*, 4> m_Readers;
     plHybridArray<plDataDirectory::FolderWriter*, 4> m_Writers;
@@ -68,6 +88,24 @@ namespace plDataDirectory
     mutable plMutex m_RedirectionMutex;
     plMap<plString, plString> m_FileRedirection;
     plString128 m_sRedirectedDataDirPath;
+
+#if PL_ENABLED(PL_SUPPORTS_DIRECTORY_WATCHER)
+    void PollFileCacheWatcher();
+
+    struct ResolvedFile
+    {
+      plString m_sRedirectedFile;
+      bool m_bExists = false;
+    };
+
+    plUniquePtr<plDirectoryWatcher> m_pFileCacheWatcher; ///< Only set, if the resolved file cache is enabled for this data directory.
+    plMutex m_FileCacheWatcherMutex;                     ///< Locks m_pFileCacheWatcher and m_NextFileCacheWatcherPoll.
+    plTime m_NextFileCacheWatcherPoll;
+
+    plMutex m_ResolvedFileCacheMutex;                        ///< Locks m_ResolvedFileCache and m_uiResolvedFileCacheGeneration.
+    plHashTable<plString, ResolvedFile> m_ResolvedFileCache; ///< Maps the requested path to the redirected path and whether that file exists.
+    plUInt32 m_uiResolvedFileCacheGeneration = 0;
+#endif
   };
 
 
@@ -23,6 +23,8 @@ public:
 
   /// \brief Opens the given file for reading. Returns PL_SUCCESS if the file could be opened. A cache is created to speed up small reads.
   ///
+  /// If the data directory provides the file content directly (see GetMappedFileContent()), no cache is created and all reads copy straight from that memory.
+  ///
   /// You should typically not disable bAllowFileEvents, unless you need to prevent recursive file events,
   /// which is only the case, if you are doing file accesses from within a File Event Handler.
   plResult Open(plStringView sFile, plUInt32 uiCacheSize = 1024 * 64, plFileShareMode::Enum fileShareMode = plFileShareMode::Default,
@@ -38,7 +40,11 @@ public:
   ///
   /// \note This is not 100% accurate, it does not guarantee that if it returns false, that the next read will return any data.
   bool IsEOF() const { return m_bEOF; }
+
 private:
+  plUInt64 ReadBytesFromMappedContent(void* pReadBuffer, plUInt64 uiBytesToRead);
+
+  plArrayPtr<const plUInt8> m_MappedContent;
   plUInt64 m_uiBytesCached = 0;
   plUInt64 m_uiCacheReadPosition = 0;
   plDynamicArray<plUInt8> m_Cache;
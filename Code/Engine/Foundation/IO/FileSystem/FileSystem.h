@@ -5,6 +5,7 @@
 #include <Foundation/Containers/Map.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
 #include <Foundation/IO/OSFile.h>
+#include <Foundation/Threading/AtomicInteger.h>
 #include <Foundation/Threading/Mutex.h>
 
 /// \brief The plFileSystem provides high-level functionality to manage files in a virtual file system.
@@ -34,11 +35,12 @@
 /// This allows to hook into the system and implement stuff like automatic asset transformations before/after certain
 /// file accesses, checking out files from revision control systems, or simply logging all file activity.
 ///
-/// All operations that go through the plFileSystem are protected by a mutex, which means that opening, closing, deleting
-/// files, as well as adding or removing data directories etc. will be synchronized and cannot happen in parallel.
+/// Adding or removing data directories, opening files for writing and deleting files is protected by a mutex and cannot happen in parallel.
+/// The list of data directories is published as an immutable snapshot though, so all read-only operations (opening files for reading,
+/// ExistsFile(), ResolvePath() etc.) never lock the file system mutex and can run on many threads in parallel.
 /// Reading/writing file streams can happen in parallel, only the administrative tasks need to be protected.
 /// File events are broadcast as they occur, that means they will be executed on whichever thread triggered them.
-/// Since they are executed from within the filesystem mutex, they cannot occur in parallel.
+/// The event itself is protected by a mutex, so event handlers are never executed in parallel.
 class PL_FOUNDATION_DLL plFileSystem
 {
 public:
@@ -65,8 +67,9 @@ public:
 
   /// \name Data Directory Modifications
   ///
-  /// All functions that add / remove data directories are not thread safe and require that this is done
-  /// on a single thread with no other thread accessing anything in plFileSystem simultaneously.
+  /// Adding and removing data directories may happen while other threads read files. A removed data directory is only deleted
+  /// once no other thread is inside a plFileSystem function anymore. However, it is not allowed to remove a data directory
+  /// while files in it are still open.
   ///@{
 
   /// \brief This factory creates a data directory type, if it can handle the given data directory. Otherwise it returns nullptr.
@@ -189,6 +192,9 @@ public:
 
   /// \brief Returns the (recursive) mutex that is used internally by the file system which can be used to guard bundled operations on the file
   /// system.
+  ///
+  /// \note Only operations that modify the file system (adding / removing data directories, writing and deleting files) lock this mutex.
+  /// Read-only operations do not, so locking it does not prevent other threads from reading files.
   static plMutex& GetMutex();
 
 #if PL_ENABLED(PL_SUPPORTS_FILE_ITERATORS)
@@ -307,11 +313,44 @@ private:
     plDataDirFactory m_Factory;
   };
 
+  /// \brief An immutable copy of the list of data directories, which can be accessed without locking.
+  struct DataDirSnapshot
+  {
+    plHybridArray<DataDirectory, 16> m_DataDirectories;
+    DataDirSnapshot* m_pNextRetired = nullptr;
+  };
+
+  /// \brief Gives access to the current DataDirSnapshot and prevents that it (or any data directory in it) gets deleted in the meantime.
+  class SnapshotReadScope
+  {
+    PL_DISALLOW_COPY_AND_ASSIGN(SnapshotReadScope);
+
+  public:
+    SnapshotReadScope();
+    ~SnapshotReadScope();
+
+    const DataDirSnapshot* operator->() const { return m_pSnapshot; }
+
+  private:
+    const DataDirSnapshot* m_pSnapshot = nullptr;
+    plUInt32 m_uiReaderSlot = 0;
+  };
+
   struct FileSystemData
   {
     plHybridArray<Factory, 4> m_DataDirFactories;
+
+    // the authoritative list of data directories, only accessed while m_FsMutex is locked
+    // every modification is published through m_iSnapshot, which is what all readers use
     plHybridArray<DataDirectory, 16> m_DataDirectories;
 
+    plAtomicInteger64 m_iSnapshot;         // pointer to the current DataDirSnapshot
+    plAtomicInteger32 m_iReaderEpoch;      // the lowest bit selects the m_iActiveReaders slot that new readers use, see FreeRetiredData()
+    plAtomicInteger32 m_iActiveReaders[2];
+    DataDirSnapshot* m_pRetiredSnapshots = nullptr;
+    plHybridArray<plDataDirectoryType*, 4> m_RetiredDataDirectories;
+
+    plAtomicInteger32 m_iNumEventHandlers;
     plEvent<const FileEvent&, plMutex> m_Event;
     plMutex m_FsMutex;
   };
@@ -320,9 +359,20 @@ private:
   static plStringView ExtractRootName(plStringView sFile, plString& rootName);
 
   /// \brief Returns the given path relative to its data directory. The path must be inside the given data directory.
-  static plStringView GetDataDirRelativePath(plStringView sFile, plUInt32 uiDataDir);
+  static plStringView GetDataDirRelativePath(plStringView sFile, const DataDirectory& dataDir);
+
+  static const DataDirectory* GetDataDirForRoot(const plArrayPtr<const DataDirectory>& dataDirs, const plString& sRoot);
+
+  /// \brief Publishes m_DataDirectories as the new snapshot. Must be called with m_FsMutex locked.
+  static void PublishSnapshot();
+
+  /// \brief Waits until no reader can access the retired snapshots and removed data directories anymore and deletes them.
+  ///
+  /// Must be called with m_FsMutex locked. With \a bForce, the data is deleted without waiting for readers.
+  static void FreeRetiredData(bool bForce);
 
-  static DataDirectory* GetDataDirForRoot(const plString& sRoot);
+  /// \brief Broadcasts the event, if anyone is listening. Avoids that all threads serialize on the event mutex for nothing.
+  static void BroadcastEvent(const FileEvent& fileEvent);
 
   static void CleanUpRootName(plStringBuilder& sRoot);
 
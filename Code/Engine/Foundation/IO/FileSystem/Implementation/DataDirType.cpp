@@ -33,7 +33,7 @@ void plDataDirectoryReaderWriterBase::Close()
   fe.m_EventType = plFileSystem::FileEventType::CloseFile;
   fe.m_sFileOrDirectory = GetFilePath();
   fe.m_pDataDir = m_pDataDirectory;
-  plFileSystem::s_pData->m_Event.Broadcast(fe);
+  plFileSystem::BroadcastEvent(fe);
 
   m_pDataDirectory->OnReaderWriterClose(this);
 }
@@ -2,6 +2,7 @@
 
 #include <Foundation/Basics.h>
 #include <Foundation/IO/FileEnums.h>
+#include <Foundation/Types/ArrayPtr.h>
 #include <Foundation/Strings/String.h>
 
 class plDataDirectoryReaderWriterBase;
@@ -163,6 +164,13 @@ public:
   }
 
   virtual plUInt64 Read(void* pBuffer, plUInt64 uiBytes) = 0;
+
+  /// \brief Returns the entire file content, if the data directory already has it in (memory mapped) memory.
+  ///
+  /// This allows to access the data without copying it through Read(). Returns an empty array, if the data directory
+  /// does not support this for the file (e.g. because it is compressed or read from disk). In that case Read() has to be used.
+  /// The returned memory stays valid as long as this reader is open. It is independent of the current read position.
+  virtual plArrayPtr<const plUInt8> GetMappedFileContent() const { return {}; }
 };
 
 /// \brief A base class for writers that handle writing to a (virtual) file inside a data directory.
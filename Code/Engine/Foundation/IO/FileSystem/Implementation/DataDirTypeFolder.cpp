@@ -24,6 +24,10 @@ namespace plDataDirectory
   plString FolderType::s_sRedirectionFile;
   plString FolderType::s_sRedirectionPrefix;
 
+#if PL_ENABLED(PL_SUPPORTS_DIRECTORY_WATCHER)
+  bool FolderType::s_bCacheResolvedFiles = false;
+#endif
+
   plResult FolderReader::InternalOpen(plFileShareMode::Enum FileShareMode)
   {
     plStringBuilder sPath = ((plDataDirectory::FolderType*)GetDataDirectory())->GetRedirectedDataDirectoryPath();
@@ -105,6 +109,7 @@ namespace plDataDirectory
     sPath.AppendPath(sFile);
 
     plOSFile::DeleteFile(sPath.GetData()).IgnoreResult();
+    InvalidateResolvedFileCache();
   }
 
   FolderType::~FolderType()
@@ -120,6 +125,7 @@ namespace plDataDirectory
   void FolderType::ReloadExternalConfigs()
   {
     LoadRedirectionFile();
+    InvalidateResolvedFileCache();
   }
 
   void FolderType::LoadRedirectionFile()
@@ -183,11 +189,7 @@ namespace plDataDirectory
   bool FolderType::ExistsFile(plStringView sFile, bool bOneSpecificDataDir)
   {
     plStringBuilder sRedirectedAsset;
-    ResolveAssetRedirection(sFile, sRedirectedAsset);
-
-    plStringBuilder sPath = GetRedirectedDataDirectoryPath();
-    sPath.AppendPath(sRedirectedAsset);
-    return plOSFile::ExistsFile(sPath);
+    return ResolveFile(sFile, sRedirectedAsset);
   }
 
   plResult FolderType::GetFileStats(plStringView sFileOrFolder, bool bOneSpecificDataDir, plFileStats& out_Stats)
@@ -238,9 +240,111 @@ namespace plDataDirectory
 
     ReloadExternalConfigs();
 
+#if PL_ENABLED(PL_SUPPORTS_DIRECTORY_WATCHER)
+    if (s_bCacheResolvedFiles)
+    {
+      m_pFileCacheWatcher = PL_DEFAULT_NEW(plDirectoryWatcher);
+
+      const plBitflags<plDirectoryWatcher::Watch> whatToWatch = plDirectoryWatcher::Watch::Creates | plDirectoryWatcher::Watch::Deletes | plDirectoryWatcher::Watch::Renames | plDirectoryWatcher::Watch::Subdirectories;
+      if (m_pFileCacheWatcher->OpenDirectory(m_sRedirectedDataDirPath, whatToWatch).Failed())
+      {
+        // without a watcher, the cache could never be invalidated
+        plLog::Warning("Could not watch data directory '{}', resolved file cache is disabled for it.", m_sRedirectedDataDirPath.GetView());
+        m_pFileCacheWatcher.Clear();
+      }
+    }
+#endif
+
     return PL_SUCCESS;
   }
 
+  bool FolderType::ResolveFile(plStringView sFile, plStringBuilder& out_sRedirectedFile)
+  {
+#if PL_ENABLED(PL_SUPPORTS_DIRECTORY_WATCHER)
+    plUInt32 uiGeneration = 0;
+
+    if (m_pFileCacheWatcher != nullptr)
+    {
+      PollFileCacheWatcher();
+
+      PL_LOCK(m_ResolvedFileCacheMutex);
+
+      if (const ResolvedFile* pResolved = m_ResolvedFileCache.GetValue(sFile))
+      {
+        out_sRedirectedFile = pResolved->m_sRedirectedFile;
+        return pResolved->m_bExists;
+      }
+
+      uiGeneration = m_uiResolvedFileCacheGeneration;
+    }
+#endif
+
+    ResolveAssetRedirection(sFile, out_sRedirectedFile);
+
+    plStringBuilder sPath = GetRedirectedDataDirectoryPath();
+    sPath.AppendPath(out_sRedirectedFile);
+    const bool bExists = plOSFile::ExistsFile(sPath);
+
+#if PL_ENABLED(PL_SUPPORTS_DIRECTORY_WATCHER)
+    if (m_pFileCacheWatcher != nullptr)
+    {
+      PL_LOCK(m_ResolvedFileCacheMutex);
+
+      // if the cache was cleared in the meantime, the result may already be outdated
+      if (uiGeneration == m_uiResolvedFileCacheGeneration)
+      {
+        ResolvedFile& resolved = m_ResolvedFileCache[sFile];
+        resolved.m_sRedirectedFile = out_sRedirectedFile;
+        resolved.m_bExists = bExists;
+      }
+    }
+#endif
+
+    return bExists;
+  }
+
+  void FolderType::InvalidateResolvedFileCache()
+  {
+#if PL_ENABLED(PL_SUPPORTS_DIRECTORY_WATCHER)
+    if (m_pFileCacheWatcher != nullptr)
+    {
+      PL_LOCK(m_ResolvedFileCacheMutex);
+      m_ResolvedFileCache.Clear();
+      ++m_uiResolvedFileCacheGeneration;
+    }
+#endif
+  }
+
+#if PL_ENABLED(PL_SUPPORTS_DIRECTORY_WATCHER)
+  void FolderType::PollFileCacheWatcher()
+  {
+    // if another thread is polling right now, don't wait for it
+    if (m_FileCacheWatcherMutex.TryLock().Failed())
+      return;
+
+    const plTime now = plTime::Now();
+
+    if (now >= m_NextFileCacheWatcherPoll)
+    {
+      m_NextFileCacheWatcherPoll = now + plTime::MakeFromMilliseconds(50);
+
+      bool bFilesChanged = false;
+      m_pFileCacheWatcher->EnumerateChanges([&bFilesChanged](plStringView sFilename, plDirectoryWatcherAction action, plDirectoryWatcherType type) {
+        // a modified file still exists, everything else may change which files exist
+        if (action != plDirectoryWatcherAction::Modified)
+          bFilesChanged = true;
+      });
+
+      if (bFilesChanged)
+      {
+        InvalidateResolvedFileCache();
+      }
+    }
+
+    m_FileCacheWatcherMutex.Unlock();
+  }
+#endif
+
   void FolderType::OnReaderWriterClose(plDataDirectoryReaderWriterBase* pClosed)
   {
     PL_LOCK(m_ReaderWriterMutex);
@@ -269,7 +373,19 @@ namespace plDataDirectory
   plDataDirectoryReader* FolderType::OpenFileToRead(plStringView sFile, plFileShareMode::Enum FileShareMode, bool bSpecificallyThisDataDir)
   {
     plStringBuilder sFileToOpen;
-    ResolveAssetRedirection(sFile, sFileToOpen);
+
+#if PL_ENABLED(PL_SUPPORTS_DIRECTORY_WATCHER)
+    if (m_pFileCacheWatcher != nullptr)
+    {
+      // with the cache, this is much cheaper than a failed attempt to open the file
+      if (!ResolveFile(sFile, sFileToOpen))
+        return nullptr;
+    }
+    else
+#endif
+    {
+      ResolveAssetRedirection(sFile, sFileToOpen);
+    }
 
     // we know that these files cannot be opened, so don't even try
     if (plConversionUtils::IsStringUuid(sFileToOpen))
@@ -360,6 +476,9 @@ namespace plDataDirectory
       return nullptr;
     }
 
+    // the file may have been created just now
+    InvalidateResolvedFileCache();
+
     // if it succeeds, we return the reader
     return pWriter;
   }
@@ -14,6 +14,17 @@ plResult plFileReader::Open(plStringView sFile, plUInt32 uiCacheSize /*= 1024 *
   if (!m_pDataDirReader)
     return PL_FAILURE;
 
+  m_MappedContent = m_pDataDirReader->GetMappedFileContent();
+
+  if (!m_MappedContent.IsEmpty())
+  {
+    // the data is already in memory, no need to go through the cache
+    m_uiCacheReadPosition = 0;
+    m_uiBytesCached = 0;
+    m_bEOF = false;
+    return PL_SUCCESS;
+  }
+
   m_Cache.SetCountUninitialized(uiCacheSize);
 
   m_uiCacheReadPosition = 0;
@@ -29,6 +40,7 @@ void plFileReader::Close()
     m_pDataDirReader->Close();
 
   m_pDataDirReader = nullptr;
+  m_MappedContent.Clear();
   m_bEOF = true;
 }
 
@@ -38,6 +50,9 @@ plUInt64 plFileReader::ReadBytes(void* pReadBuffer, plUInt64 uiBytesToRead)
   if (m_bEOF)
     return 0;
 
+  if (!m_MappedContent.IsEmpty())
+    return ReadBytesFromMappedContent(pReadBuffer, uiBytesToRead);
+
   plUInt64 uiBufferPosition = 0; // how much was read, yet
   plUInt8* pBuffer = (plUInt8*)pReadBuffer;
 
@@ -111,4 +126,22 @@ plUInt64 plFileReader::ReadBytes(void* pReadBuffer, plUInt64 uiBytesToRead)
   return uiBufferPosition;
 }
 
+plUInt64 plFileReader::ReadBytesFromMappedContent(void* pReadBuffer, plUInt64 uiBytesToRead)
+{
+  // m_uiCacheReadPosition is used as the read position into the mapped content
+  const plUInt64 uiBytesLeft = m_MappedContent.GetCount() - m_uiCacheReadPosition;
+  const plUInt64 uiBytesToCopy = plMath::Min(uiBytesToRead, uiBytesLeft);
 
+  if (uiBytesToCopy > 0)
+  {
+    plMemoryUtils::Copy(static_cast<plUInt8*>(pReadBuffer), m_MappedContent.GetPtr() + m_uiCacheReadPosition, static_cast<size_t>(uiBytesToCopy));
+    m_uiCacheReadPosition += uiBytesToCopy;
+  }
+
+  if (uiBytesToCopy < uiBytesToRead || m_uiCacheReadPosition >= m_MappedContent.GetCount())
+  {
+    m_bEOF = true;
+  }
+
+  return uiBytesToCopy;
+}
@@ -36,6 +36,12 @@ public:
   /// \brief Returns the current total size of the file.
   plUInt64 GetFileSize() const { return m_pDataDirReader->GetFileSize(); }
 
+  /// \brief Returns the entire file content without copying it, if the data directory has it in memory anyway (e.g. uncompressed archive entries).
+  ///
+  /// Returns an empty array, if that is not possible for this file. The memory stays valid as long as the file is open.
+  /// The result does not depend on (or change) the current read position.
+  plArrayPtr<const plUInt8> GetMappedFileContent() const { return m_pDataDirReader->GetMappedFileContent(); }
+
 protected:
   plDataDirectoryReader* GetFileReader(plStringView sFile, plFileShareMode::Enum FileShareMode, bool bAllowFileEvents)
   {
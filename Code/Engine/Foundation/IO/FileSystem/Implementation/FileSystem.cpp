@@ -6,6 +6,7 @@
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Strings/Implementation/StringIterator.h>
 #include <Foundation/Strings/StringView.h>
+#include <Foundation/Threading/ThreadUtils.h>
 
 // clang-format off
 PL_BEGIN_SUBSYSTEM_DECLARATION(Foundation, FileSystem)
@@ -27,6 +28,9 @@ plFileSystem::FileSystemData* plFileSystem::s_pData = nullptr;
 plString plFileSystem::s_sSdkRootDir;
 plMap<plString, plString> plFileSystem::s_SpecialDirectories;
 
+// the number of SnapshotReadScope instances that are alive on this thread
+static thread_local plUInt32 tl_uiNumSnapshotReadScopes = 0;
+
 
 void plFileSystem::RegisterDataDirectoryFactory(plDataDirFactory factory, float fPriority /*= 0*/)
 {
@@ -41,6 +45,7 @@ plEventSubscriptionID plFileSystem::RegisterEventHandler(plEvent<const FileEvent
 {
   PL_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
 
+  s_pData->m_iNumEventHandlers.Increment();
   return s_pData->m_Event.AddEventHandler(handler);
 }
 
@@ -49,6 +54,7 @@ void plFileSystem::UnregisterEventHandler(plEvent<const FileEvent&>::Handler han
   PL_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
 
   s_pData->m_Event.RemoveEventHandler(handler);
+  s_pData->m_iNumEventHandlers.Decrement();
 }
 
 void plFileSystem::UnregisterEventHandler(plEventSubscriptionID subscriptionId)
@@ -56,6 +62,93 @@ void plFileSystem::UnregisterEventHandler(plEventSubscriptionID subscriptionId)
   PL_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
 
   s_pData->m_Event.RemoveEventHandler(subscriptionId);
+  s_pData->m_iNumEventHandlers.Decrement();
+}
+
+void plFileSystem::BroadcastEvent(const FileEvent& fileEvent)
+{
+  if (s_pData->m_iNumEventHandlers > 0)
+  {
+    s_pData->m_Event.Broadcast(fileEvent);
+  }
+}
+
+plFileSystem::SnapshotReadScope::SnapshotReadScope()
+{
+  // The reader has to be registered before the snapshot is read, see FreeRetiredData().
+  // If a writer switched the slot in between, the writer may not wait for this slot, so register again in the new one.
+  while (true)
+  {
+    m_uiReaderSlot = s_pData->m_iReaderEpoch & 1;
+    s_pData->m_iActiveReaders[m_uiReaderSlot].Increment();
+
+    if ((s_pData->m_iReaderEpoch & 1) == (plInt32)m_uiReaderSlot)
+      break;
+
+    s_pData->m_iActiveReaders[m_uiReaderSlot].Decrement();
+  }
+
+  ++tl_uiNumSnapshotReadScopes;
+  m_pSnapshot = reinterpret_cast<const DataDirSnapshot*>(static_cast<std::intptr_t>((plInt64)s_pData->m_iSnapshot));
+}
+
+plFileSystem::SnapshotReadScope::~SnapshotReadScope()
+{
+  --tl_uiNumSnapshotReadScopes;
+  s_pData->m_iActiveReaders[m_uiReaderSlot].Decrement();
+}
+
+void plFileSystem::PublishSnapshot()
+{
+  DataDirSnapshot* pSnapshot = PL_DEFAULT_NEW(DataDirSnapshot);
+  pSnapshot->m_DataDirectories = s_pData->m_DataDirectories;
+
+  const plInt64 iOldSnapshot = s_pData->m_iSnapshot.Set(static_cast<plInt64>(reinterpret_cast<std::intptr_t>(pSnapshot)));
+
+  if (DataDirSnapshot* pOldSnapshot = reinterpret_cast<DataDirSnapshot*>(static_cast<std::intptr_t>(iOldSnapshot)))
+  {
+    pOldSnapshot->m_pNextRetired = s_pData->m_pRetiredSnapshots;
+    s_pData->m_pRetiredSnapshots = pOldSnapshot;
+  }
+
+  FreeRetiredData(false);
+}
+
+void plFileSystem::FreeRetiredData(bool bForce)
+{
+  if (s_pData->m_pRetiredSnapshots == nullptr && s_pData->m_RetiredDataDirectories.IsEmpty())
+    return;
+
+  if (!bForce)
+  {
+    // A thread that modifies the data directories from inside a read scope (e.g. in a file event handler) would wait for itself.
+    // In that case the retired data stays around until the next modification.
+    if (tl_uiNumSnapshotReadScopes > 0)
+      return;
+
+    // The new snapshot has been published before the slot is switched here, so readers that register from now on can only see the new
+    // snapshot. The readers in the old slot may still access retired data, but since no new readers join that slot, their number only goes down
+    // and the wait is bounded, even while other threads read constantly. The previous call has already drained the other slot.
+    const plUInt32 uiOldSlot = s_pData->m_iReaderEpoch.PostIncrement() & 1;
+
+    while (s_pData->m_iActiveReaders[uiOldSlot] > 0)
+    {
+      plThreadUtils::YieldTimeSlice();
+    }
+  }
+
+  while (DataDirSnapshot* pSnapshot = s_pData->m_pRetiredSnapshots)
+  {
+    s_pData->m_pRetiredSnapshots = pSnapshot->m_pNextRetired;
+    PL_DEFAULT_DELETE(pSnapshot);
+  }
+
+  for (plDataDirectoryType* pDataDir : s_pData->m_RetiredDataDirectories)
+  {
+    pDataDir->RemoveDataDirectory();
+  }
+
+  s_pData->m_RetiredDataDirectories.Clear();
 }
 
 void plFileSystem::CleanUpRootName(plStringBuilder& sRoot)
@@ -115,6 +208,7 @@ plResult plFileSystem::AddDataDirectory(plStringView sDataDirectory, plStringVie
         dd.m_sGroup = sGroup;
 
         s_pData->m_DataDirectories.PushBack(dd);
+        PublishSnapshot();
 
         {
           // Broadcast that a data directory was added
@@ -123,7 +217,7 @@ plResult plFileSystem::AddDataDirectory(plStringView sDataDirectory, plStringVie
           fe.m_sFileOrDirectory = sPath;
           fe.m_sOther = sCleanRootName;
           fe.m_pDataDir = pDataDir;
-          s_pData->m_Event.Broadcast(fe);
+          BroadcastEvent(fe);
         }
 
         return PL_SUCCESS;
@@ -137,7 +231,7 @@ plResult plFileSystem::AddDataDirectory(plStringView sDataDirectory, plStringVie
     fe.m_EventType = FileEventType::AddDataDirectoryFailed;
     fe.m_sFileOrDirectory = sPath;
     fe.m_sOther = sCleanRootName;
-    s_pData->m_Event.Broadcast(fe);
+    BroadcastEvent(fe);
   }
 
   plLog::Error("Adding Data Directory '{0}' failed.", plArgSensitive(sDataDirectory, "Path"));
@@ -165,11 +259,12 @@ bool plFileSystem::RemoveDataDirectory(plStringView sRootName)
         fe.m_sFileOrDirectory = directory.m_pDataDirectory->GetDataDirectoryPath();
         fe.m_sOther = directory.m_sRootName;
         fe.m_pDataDir = directory.m_pDataDirectory;
-        s_pData->m_Event.Broadcast(fe);
+        BroadcastEvent(fe);
       }
 
-      directory.m_pDataDirectory->RemoveDataDirectory();
+      s_pData->m_RetiredDataDirectories.PushBack(directory.m_pDataDirectory);
       s_pData->m_DataDirectories.RemoveAtAndCopy(i);
+      PublishSnapshot();
 
       return true;
     }
@@ -200,18 +295,23 @@ plUInt32 plFileSystem::RemoveDataDirectoryGroup(plStringView sGroup)
         fe.m_sFileOrDirectory = s_pData->m_DataDirectories[i].m_pDataDirectory->GetDataDirectoryPath();
         fe.m_sOther = s_pData->m_DataDirectories[i].m_sRootName;
         fe.m_pDataDir = s_pData->m_DataDirectories[i].m_pDataDirectory;
-        s_pData->m_Event.Broadcast(fe);
+        BroadcastEvent(fe);
       }
 
       ++uiRemoved;
 
-      s_pData->m_DataDirectories[i].m_pDataDirectory->RemoveDataDirectory();
+      s_pData->m_RetiredDataDirectories.PushBack(s_pData->m_DataDirectories[i].m_pDataDirectory);
       s_pData->m_DataDirectories.RemoveAtAndCopy(i);
     }
     else
       ++i;
   }
 
+  if (uiRemoved > 0)
+  {
+    PublishSnapshot();
+  }
+
   return uiRemoved;
 }
 
@@ -230,13 +330,14 @@ void plFileSystem::ClearAllDataDirectories()
       fe.m_sFileOrDirectory = s_pData->m_DataDirectories[i].m_pDataDirectory->GetDataDirectoryPath();
       fe.m_sOther = s_pData->m_DataDirectories[i].m_sRootName;
       fe.m_pDataDir = s_pData->m_DataDirectories[i].m_pDataDirectory;
-      s_pData->m_Event.Broadcast(fe);
+      BroadcastEvent(fe);
     }
 
-    s_pData->m_DataDirectories[i].m_pDataDirectory->RemoveDataDirectory();
+    s_pData->m_RetiredDataDirectories.PushBack(s_pData->m_DataDirectories[i].m_pDataDirectory);
   }
 
   s_pData->m_DataDirectories.Clear();
+  PublishSnapshot();
 }
 
 plDataDirectoryType* plFileSystem::FindDataDirectoryWithRoot(plStringView sRootName)
@@ -244,9 +345,9 @@ plDataDirectoryType* plFileSystem::FindDataDirectoryWithRoot(plStringView sRootN
   if (sRootName.IsEmpty())
     return nullptr;
 
-  PL_LOCK(s_pData->m_FsMutex);
+  SnapshotReadScope snapshot;
 
-  for (const auto& dd : s_pData->m_DataDirectories)
+  for (const auto& dd : snapshot->m_DataDirectories)
   {
     if (dd.m_sRootName.IsEqual_NoCase(sRootName))
     {
@@ -261,26 +362,26 @@ plUInt32 plFileSystem::GetNumDataDirectories()
 {
   PL_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
 
-  return s_pData->m_DataDirectories.GetCount();
+  SnapshotReadScope snapshot;
+  return snapshot->m_DataDirectories.GetCount();
 }
 
 plDataDirectoryType* plFileSystem::GetDataDirectory(plUInt32 uiDataDirIndex)
 {
   PL_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
 
-  return s_pData->m_DataDirectories[uiDataDirIndex].m_pDataDirectory;
+  SnapshotReadScope snapshot;
+  return snapshot->m_DataDirectories[uiDataDirIndex].m_pDataDirectory;
 }
 
-plStringView plFileSystem::GetDataDirRelativePath(plStringView sPath, plUInt32 uiDataDir)
+plStringView plFileSystem::GetDataDirRelativePath(plStringView sPath, const DataDirectory& dataDir)
 {
-  PL_LOCK(s_pData->m_FsMutex);
-
   // if an absolute path is given, this will check whether the absolute path would fall into this data directory
   // if yes, the prefix path is removed and then only the relative path is given to the data directory type
   // otherwise the data directory would prepend its own path and thus create an invalid path to work with
 
   // first check the redirected directory
-  const plString128& sRedDirPath = s_pData->m_DataDirectories[uiDataDir].m_pDataDirectory->GetRedirectedDataDirectoryPath();
+  const plString128& sRedDirPath = dataDir.m_pDataDirectory->GetRedirectedDataDirectoryPath();
 
   if (!sRedDirPath.IsEmpty() && sPath.StartsWith_NoCase(sRedDirPath))
   {
@@ -296,7 +397,7 @@ plStringView plFileSystem::GetDataDirRelativePath(plStringView sPath, plUInt32 u
   }
 
   // then check the original mount path
-  const plString128& sDirPath = s_pData->m_DataDirectories[uiDataDir].m_pDataDirectory->GetDataDirectoryPath();
+  const plString128& sDirPath = dataDir.m_pDataDirectory->GetDataDirectoryPath();
 
   // If the data dir is empty we return the paths as is or the code below would remove the '/' in front of an
   // absolute path.
@@ -317,14 +418,12 @@ plStringView plFileSystem::GetDataDirRelativePath(plStringView sPath, plUInt32 u
 }
 
 
-plFileSystem::DataDirectory* plFileSystem::GetDataDirForRoot(const plString& sRoot)
+const plFileSystem::DataDirectory* plFileSystem::GetDataDirForRoot(const plArrayPtr<const DataDirectory>& dataDirs, const plString& sRoot)
 {
-  PL_LOCK(s_pData->m_FsMutex);
-
-  for (plInt32 i = (plInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  for (plInt32 i = (plInt32)dataDirs.GetCount() - 1; i >= 0; --i)
   {
-    if (s_pData->m_DataDirectories[i].m_sRootName == sRoot)
-      return &s_pData->m_DataDirectories[i];
+    if (dataDirs[i].m_sRootName == sRoot)
+      return &dataDirs[i];
   }
 
   return nullptr;
@@ -360,7 +459,7 @@ void plFileSystem::DeleteFile(plStringView sFile)
     if (s_pData->m_DataDirectories[i].m_sRootName != sRootName)
       continue;
 
-    plStringView sRelPath = GetDataDirRelativePath(sFile, i);
+    plStringView sRelPath = GetDataDirRelativePath(sFile, s_pData->m_DataDirectories[i]);
 
     {
       // Broadcast that a file is about to be deleted
@@ -370,7 +469,7 @@ void plFileSystem::DeleteFile(plStringView sFile)
       fe.m_sFileOrDirectory = sRelPath;
       fe.m_pDataDir = s_pData->m_DataDirectories[i].m_pDataDirectory;
       fe.m_sOther = sRootName;
-      s_pData->m_Event.Broadcast(fe);
+      BroadcastEvent(fe);
     }
 
     s_pData->m_DataDirectories[i].m_pDataDirectory->DeleteFile(sRelPath);
@@ -386,16 +485,17 @@ bool plFileSystem::ExistsFile(plStringView sFile)
 
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
 
-  PL_LOCK(s_pData->m_FsMutex);
+  SnapshotReadScope snapshot;
+  const auto& dataDirs = snapshot->m_DataDirectories;
 
-  for (plInt32 i = (plInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  for (plInt32 i = (plInt32)dataDirs.GetCount() - 1; i >= 0; --i)
   {
-    if (!sRootName.IsEmpty() && s_pData->m_DataDirectories[i].m_sRootName != sRootName)
+    if (!sRootName.IsEmpty() && dataDirs[i].m_sRootName != sRootName)
       continue;
 
-    plStringView sRelPath = GetDataDirRelativePath(sFile, i);
+    plStringView sRelPath = GetDataDirRelativePath(sFile, dataDirs[i]);
 
-    if (s_pData->m_DataDirectories[i].m_pDataDirectory->ExistsFile(sRelPath, bOneSpecificDataDir))
+    if (dataDirs[i].m_pDataDirectory->ExistsFile(sRelPath, bOneSpecificDataDir))
       return true;
   }
 
@@ -407,21 +507,22 @@ plResult plFileSystem::GetFileStats(plStringView sFileOrFolder, plFileStats& out
 {
   PL_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
 
-  PL_LOCK(s_pData->m_FsMutex);
-
   plString sRootName;
   sFileOrFolder = ExtractRootName(sFileOrFolder, sRootName);
 
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
 
-  for (plInt32 i = (plInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  SnapshotReadScope snapshot;
+  const auto& dataDirs = snapshot->m_DataDirectories;
+
+  for (plInt32 i = (plInt32)dataDirs.GetCount() - 1; i >= 0; --i)
   {
-    if (!sRootName.IsEmpty() && s_pData->m_DataDirectories[i].m_sRootName != sRootName)
+    if (!sRootName.IsEmpty() && dataDirs[i].m_sRootName != sRootName)
       continue;
 
-    plStringView sRelPath = GetDataDirRelativePath(sFileOrFolder, i);
+    plStringView sRelPath = GetDataDirRelativePath(sFileOrFolder, dataDirs[i]);
 
-    if (s_pData->m_DataDirectories[i].m_pDataDirectory->GetFileStats(sRelPath, bOneSpecificDataDir, out_stats).Succeeded())
+    if (dataDirs[i].m_pDataDirectory->GetFileStats(sRelPath, bOneSpecificDataDir, out_stats).Succeeded())
       return PL_SUCCESS;
   }
 
@@ -462,8 +563,6 @@ plDataDirectoryReader* plFileSystem::GetFileReader(plStringView sFile, plFileSha
   if (sFile.IsEmpty())
     return nullptr;
 
-  PL_LOCK(s_pData->m_FsMutex);
-
   plString sRootName;
   sFile = ExtractRootName(sFile, sRootName);
 
@@ -473,14 +572,17 @@ plDataDirectoryReader* plFileSystem::GetFileReader(plStringView sFile, plFileSha
 
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
 
+  SnapshotReadScope snapshot;
+  const auto& dataDirs = snapshot->m_DataDirectories;
+
   // the last added data directory has the highest priority
-  for (plInt32 i = (plInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  for (plInt32 i = (plInt32)dataDirs.GetCount() - 1; i >= 0; --i)
   {
     // if a root is used, ignore all directories that do not have the same root name
-    if (bOneSpecificDataDir && s_pData->m_DataDirectories[i].m_sRootName != sRootName)
+    if (bOneSpecificDataDir && dataDirs[i].m_sRootName != sRootName)
       continue;
 
-    plStringView sRelPath = GetDataDirRelativePath(sPath, i);
+    plStringView sRelPath = GetDataDirRelativePath(sPath, dataDirs[i]);
 
     if (bAllowFileEvents)
     {
@@ -490,12 +592,12 @@ plDataDirectoryReader* plFileSystem::GetFileReader(plStringView sFile, plFileSha
       fe.m_EventType = FileEventType::OpenFileAttempt;
       fe.m_sFileOrDirectory = sRelPath;
       fe.m_sOther = sRootName;
-      fe.m_pDataDir = s_pData->m_DataDirectories[i].m_pDataDirectory;
-      s_pData->m_Event.Broadcast(fe);
+      fe.m_pDataDir = dataDirs[i].m_pDataDirectory;
+      BroadcastEvent(fe);
     }
 
     // Let the data directory try to open the file.
-    plDataDirectoryReader* pReader = s_pData->m_DataDirectories[i].m_pDataDirectory->OpenFileToRead(sRelPath, FileShareMode, bOneSpecificDataDir);
+    plDataDirectoryReader* pReader = dataDirs[i].m_pDataDirectory->OpenFileToRead(sRelPath, FileShareMode, bOneSpecificDataDir);
 
     if (bAllowFileEvents && pReader != nullptr)
     {
@@ -504,8 +606,8 @@ plDataDirectoryReader* plFileSystem::GetFileReader(plStringView sFile, plFileSha
       fe.m_EventType = FileEventType::OpenFileSucceeded;
       fe.m_sFileOrDirectory = sRelPath;
       fe.m_sOther = sRootName;
-      fe.m_pDataDir = s_pData->m_DataDirectories[i].m_pDataDirectory;
-      s_pData->m_Event.Broadcast(fe);
+      fe.m_pDataDir = dataDirs[i].m_pDataDirectory;
+      BroadcastEvent(fe);
 
       return pReader;
     }
@@ -517,7 +619,7 @@ plDataDirectoryReader* plFileSystem::GetFileReader(plStringView sFile, plFileSha
     FileEvent fe;
     fe.m_EventType = FileEventType::OpenFileFailed;
     fe.m_sFileOrDirectory = sPath;
-    s_pData->m_Event.Broadcast(fe);
+    BroadcastEvent(fe);
   }
 
   return nullptr;
@@ -557,7 +659,7 @@ plDataDirectoryWriter* plFileSystem::GetFileWriter(plStringView sFile, plFileSha
     if (s_pData->m_DataDirectories[i].m_sRootName != sRootName)
       continue;
 
-    plStringView sRelPath = GetDataDirRelativePath(sPath, i);
+    plStringView sRelPath = GetDataDirRelativePath(sPath, s_pData->m_DataDirectories[i]);
 
     if (bAllowFileEvents)
     {
@@ -568,7 +670,7 @@ plDataDirectoryWriter* plFileSystem::GetFileWriter(plStringView sFile, plFileSha
       fe.m_sFileOrDirectory = sRelPath;
       fe.m_sOther = sRootName;
       fe.m_pDataDir = s_pData->m_DataDirectories[i].m_pDataDirectory;
-      s_pData->m_Event.Broadcast(fe);
+      BroadcastEvent(fe);
     }
 
     plDataDirectoryWriter* pWriter = s_pData->m_DataDirectories[i].m_pDataDirectory->OpenFileToWrite(sRelPath, FileShareMode);
@@ -581,7 +683,7 @@ plDataDirectoryWriter* plFileSystem::GetFileWriter(plStringView sFile, plFileSha
       fe.m_sFileOrDirectory = sRelPath;
       fe.m_sOther = sRootName;
       fe.m_pDataDir = s_pData->m_DataDirectories[i].m_pDataDirectory;
-      s_pData->m_Event.Broadcast(fe);
+      BroadcastEvent(fe);
 
       return pWriter;
     }
@@ -593,7 +695,7 @@ plDataDirectoryWriter* plFileSystem::GetFileWriter(plStringView sFile, plFileSha
     FileEvent fe;
     fe.m_EventType = FileEventType::CreateFileFailed;
     fe.m_sFileOrDirectory = sPath;
-    s_pData->m_Event.Broadcast(fe);
+    BroadcastEvent(fe);
   }
 
   return nullptr;
@@ -603,7 +705,7 @@ plResult plFileSystem::ResolvePath(plStringView sPath, plStringBuilder* out_pAbs
 {
   PL_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
 
-  PL_LOCK(s_pData->m_FsMutex);
+  SnapshotReadScope snapshot;
 
   plStringBuilder absPath, relPath;
 
@@ -613,7 +715,7 @@ plResult plFileSystem::ResolvePath(plStringView sPath, plStringBuilder* out_pAbs
     plString sRootName;
     ExtractRootName(sPath, sRootName);
 
-    DataDirectory* pDataDir = GetDataDirForRoot(sRootName);
+    const DataDirectory* pDataDir = GetDataDirForRoot(snapshot->m_DataDirectories, sRootName);
 
     if (pDataDir == nullptr)
       return PL_FAILURE;
@@ -631,9 +733,9 @@ plResult plFileSystem::ResolvePath(plStringView sPath, plStringBuilder* out_pAbs
     absPath = sPath;
     absPath.MakeCleanPath();
 
-    for (plUInt32 dd = s_pData->m_DataDirectories.GetCount(); dd > 0; --dd)
+    for (plUInt32 dd = snapshot->m_DataDirectories.GetCount(); dd > 0; --dd)
     {
-      auto& dir = s_pData->m_DataDirectories[dd - 1];
+      const auto& dir = snapshot->m_DataDirectories[dd - 1];
 
       if (plPathUtils::IsSubPath(dir.m_pDataDirectory->GetRedirectedDataDirectoryPath(), absPath))
       {
@@ -762,9 +864,9 @@ plResult plFileSystem::FindFolderWithSubPath(plStringBuilder& out_sResult, plStr
 
 bool plFileSystem::ResolveAssetRedirection(plStringView sPathOrAssetGuid, plStringBuilder& out_sRedirection)
 {
-  PL_LOCK(s_pData->m_FsMutex);
+  SnapshotReadScope snapshot;
 
-  for (auto& dd : s_pData->m_DataDirectories)
+  for (const auto& dd : snapshot->m_DataDirectories)
   {
     if (dd.m_pDataDirectory->ResolveAssetRedirection(sPathOrAssetGuid, out_sRedirection))
       return true;
@@ -831,6 +933,9 @@ void plFileSystem::ReloadAllExternalDataDirectoryConfigs()
 void plFileSystem::Startup()
 {
   s_pData = PL_DEFAULT_NEW(FileSystemData);
+
+  PL_LOCK(s_pData->m_FsMutex);
+  PublishSnapshot();
 }
 
 void plFileSystem::Shutdown()
@@ -841,6 +946,13 @@ void plFileSystem::Shutdown()
     s_pData->m_DataDirFactories.Clear();
 
     ClearAllDataDirectories();
+
+    PL_ASSERT_DEV(s_pData->m_iActiveReaders[0] == 0 && s_pData->m_iActiveReaders[1] == 0, "The file system is shut down while other threads still access it.");
+
+    DataDirSnapshot* pSnapshot = reinterpret_cast<DataDirSnapshot*>(static_cast<std::intptr_t>(s_pData->m_iSnapshot.Set(0)));
+    PL_DEFAULT_DELETE(pSnapshot);
+
+    FreeRetiredData(true);
   }
 
   PL_DEFAULT_DELETE(s_pData);
@@ -979,12 +1091,12 @@ plMutex& plFileSystem::GetMutex()
 
 void plFileSystem::StartSearch(plFileSystemIterator& ref_iterator, plStringView sSearchTerm, plBitflags<plFileSystemIteratorFlags> flags /*= plFileSystemIteratorFlags::Default*/)
 {
-  PL_LOCK(s_pData->m_FsMutex);
+  SnapshotReadScope snapshot;
 
   plHybridArray<plString, 16> folders;
   plStringBuilder sDdPath;
 
-  for (const auto& dd : s_pData->m_DataDirectories)
+  for (const auto& dd : snapshot->m_DataDirectories)
   {
     sDdPath = dd.m_pDataDirectory->GetRedirectedDataDirectoryPath();
 
@@ -9,6 +9,7 @@
 #include <Foundation/Memory/Policies/AllocPolicyGuarding.h>
 #include <Foundation/Memory/Policies/AllocPolicyHeap.h>
 #include <Foundation/Memory/Policies/AllocPolicyProxy.h>
+#include <Foundation/Memory/Policies/AllocPolicyThreadCaching.h>
 
 
 /// \brief Default heap allocator
@@ -17,6 +18,9 @@ using plAlignedHeapAllocator = plAllocatorWithPolicy<plAllocPolicyAlignedHeap>;
 /// \brief Default heap allocator
 using plHeapAllocator = plAllocatorWithPolicy<plAllocPolicyHeap>;
 
+/// \brief Heap allocator with thread-local caches for small allocations, see plAllocPolicyThreadCaching
+using plThreadCachingHeapAllocator = plAllocatorWithPolicy<plAllocPolicyThreadCaching>;
+
 /// \brief Guarded allocator
 using plGuardingAllocator = plAllocatorWithPolicy<plAllocPolicyGuarding>;
 
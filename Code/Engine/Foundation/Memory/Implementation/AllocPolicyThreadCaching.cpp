@@ -0,0 +1,549 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Memory/Policies/AllocPolicyThreadCaching.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Lock.h>
+
+namespace
+{
+  constexpr size_t SpanSize = 64 * 1024;
+  constexpr size_t SegmentShift = 20;
+  constexpr size_t SegmentSize = size_t(1) << SegmentShift; // 16 spans
+  constexpr plUInt32 SpansPerSegment = static_cast<plUInt32>(SegmentSize / SpanSize);
+
+  // segment map: the upper bits of an address select a bitmap of 64k segments (1 MB each), this covers a 48 bit address space
+  constexpr plUInt32 SegmentMapLevel1Shift = 36;
+  constexpr plUInt32 SegmentMapLevel1Count = 1u << (48 - SegmentMapLevel1Shift);
+  constexpr plUInt32 SegmentMapLevel2Count = 1u << (SegmentMapLevel1Shift - SegmentShift);
+
+  constexpr plUInt32 NumSizeClasses = plAllocPolicyThreadCaching::NumSizeClasses;
+  constexpr plUInt32 MaxInstances = 16;
+
+  /// \brief Sizes up to 128 bytes use 16 byte steps, above that every power of two range is split into 4 size classes.
+  PL_ALWAYS_INLINE plUInt32 GetSizeClass(size_t uiSize)
+  {
+    if (uiSize <= 128)
+      return static_cast<plUInt32>((uiSize - 1) >> 4);
+
+    const plUInt32 uiLog = plMath::Log2i(static_cast<plUInt32>(uiSize - 1));
+    return 8 + (uiLog - 7) * 4 + (static_cast<plUInt32>((uiSize - 1) >> (uiLog - 2)) & 3);
+  }
+
+  plUInt32 GetBlockSize(plUInt32 uiSizeClass)
+  {
+    if (uiSizeClass < 8)
+      return (uiSizeClass + 1) * 16;
+
+    const plUInt32 uiRange = (uiSizeClass - 8) / 4;
+    const plUInt32 uiStep = (uiSizeClass - 8) % 4;
+    return (128u << uiRange) + (uiStep + 1) * (32u << uiRange);
+  }
+} // namespace
+
+namespace plInternal
+{
+  struct plThreadCachingFreeBlock
+  {
+    plThreadCachingFreeBlock* m_pNext;
+  };
+
+  /// \brief Header at the start of every span. The slots follow directly after it.
+  struct alignas(64) plThreadCachingSpan
+  {
+    // only accessed by the owning thread (or under the allocator mutex while the span has no owner)
+    plThreadCachingThreadCache* m_pOwner = nullptr;
+    plThreadCachingSpan* m_pPrev = nullptr;
+    plThreadCachingSpan* m_pNext = nullptr;
+    plThreadCachingFreeBlock* m_pLocalFreeList = nullptr;
+    plUInt8* m_pNextUnused = nullptr;
+    plUInt8* m_pEnd = nullptr;
+    plUInt32 m_uiBlockSize = 0;
+    plUInt32 m_uiSizeClass = 0;
+    plUInt32 m_uiNumUsed = 0; ///< Includes the blocks that are on the remote free list.
+
+    // pushed to by other threads, so keep it on a separate cache line
+    alignas(64) plAtomicInteger64 m_iRemoteFreeList;
+
+    void Initialize(plUInt32 uiSizeClass)
+    {
+      const plUInt32 uiBlockSize = GetBlockSize(uiSizeClass);
+      plUInt8* pFirst = reinterpret_cast<plUInt8*>(this) + sizeof(plThreadCachingSpan);
+
+      m_pPrev = nullptr;
+      m_pNext = nullptr;
+      m_pLocalFreeList = nullptr;
+      m_pNextUnused = pFirst;
+      m_pEnd = pFirst + ((SpanSize - sizeof(plThreadCachingSpan)) / uiBlockSize) * uiBlockSize;
+      m_uiBlockSize = uiBlockSize;
+      m_uiSizeClass = uiSizeClass;
+      m_uiNumUsed = 0;
+      m_iRemoteFreeList = 0;
+    }
+
+    PL_ALWAYS_INLINE bool HasFreeBlocks() const { return m_pLocalFreeList != nullptr || m_pNextUnused < m_pEnd; }
+
+    PL_ALWAYS_INLINE void* AllocateBlock()
+    {
+      ++m_uiNumUsed;
+
+      if (plThreadCachingFreeBlock* pBlock = m_pLocalFreeList)
+      {
+        m_pLocalFreeList = pBlock->m_pNext;
+        return pBlock;
+      }
+
+      void* pBlock = m_pNextUnused;
+      m_pNextUnused += m_uiBlockSize;
+      return pBlock;
+    }
+
+    /// \brief Moves all blocks that were freed by other threads to the local free list. Must only be called by the owner.
+    void CollectRemoteFrees()
+    {
+      plThreadCachingFreeBlock* pBlock = reinterpret_cast<plThreadCachingFreeBlock*>(static_cast<std::intptr_t>(m_iRemoteFreeList.Set(0)));
+
+      while (pBlock != nullptr)
+      {
+        plThreadCachingFreeBlock* pNext = pBlock->m_pNext;
+        pBlock->m_pNext = m_pLocalFreeList;
+        m_pLocalFreeList = pBlock;
+        --m_uiNumUsed;
+        pBlock = pNext;
+      }
+    }
+
+    void PushRemoteFree(void* pPtr)
+    {
+      plThreadCachingFreeBlock* pBlock = static_cast<plThreadCachingFreeBlock*>(pPtr);
+
+      // the owner only ever takes the whole list, so there is no ABA problem
+      plInt64 iHead;
+      do
+      {
+        iHead = m_iRemoteFreeList;
+        pBlock->m_pNext = reinterpret_cast<plThreadCachingFreeBlock*>(static_cast<std::intptr_t>(iHead));
+      } while (!m_iRemoteFreeList.TestAndSet(iHead, reinterpret_cast<std::intptr_t>(pBlock)));
+    }
+  };
+
+  /// \brief The spans of one thread. Per size class they form a circular list, the first span is the one that is allocated from.
+  struct plThreadCachingThreadCache
+  {
+    plThreadCachingSpan* m_Spans[NumSizeClasses] = {};
+    plThreadCachingThreadCache* m_pNext = nullptr;
+
+    void PushFront(plThreadCachingSpan* pSpan)
+    {
+      plThreadCachingSpan*& pHead = m_Spans[pSpan->m_uiSizeClass];
+
+      if (pHead == nullptr)
+      {
+        pSpan->m_pPrev = pSpan;
+        pSpan->m_pNext = pSpan;
+      }
+      else
+      {
+        pSpan->m_pPrev = pHead->m_pPrev;
+        pSpan->m_pNext = pHead;
+        pHead->m_pPrev->m_pNext = pSpan;
+        pHead->m_pPrev = pSpan;
+      }
+
+      pHead = pSpan;
+    }
+
+    void Remove(plThreadCachingSpan* pSpan)
+    {
+      plThreadCachingSpan*& pHead = m_Spans[pSpan->m_uiSizeClass];
+
+      if (pSpan->m_pNext == pSpan)
+      {
+        pHead = nullptr;
+      }
+      else
+      {
+        pSpan->m_pPrev->m_pNext = pSpan->m_pNext;
+        pSpan->m_pNext->m_pPrev = pSpan->m_pPrev;
+
+        if (pHead == pSpan)
+          pHead = pSpan->m_pNext;
+      }
+
+      pSpan->m_pPrev = nullptr;
+      pSpan->m_pNext = nullptr;
+    }
+  };
+
+  struct plThreadCachingThreadCacheSlot
+  {
+    plThreadCachingThreadCache* m_pCache = nullptr;
+    plUInt32 m_uiGeneration = 0;
+  };
+
+  /// \brief Per thread, the caches of all allocator instances. Hands the caches back to their allocators when the thread exits.
+  struct plThreadCachingThreadCacheSlots
+  {
+    plThreadCachingThreadCacheSlot m_Slots[MaxInstances];
+
+    ~plThreadCachingThreadCacheSlots();
+  };
+} // namespace plInternal
+
+using namespace plInternal;
+
+namespace
+{
+  thread_local plThreadCachingThreadCacheSlots tl_ThreadCaches;
+
+  // the default allocator is created during static initialization, so these must not depend on constructors
+  plAllocPolicyThreadCaching* s_Instances[MaxInstances];
+  plUInt32 s_uiInstanceGenerations[MaxInstances];
+
+  plMutex& GetInstancesMutex()
+  {
+    // intentionally never destroyed, threads may still exit after the static destructors ran
+    alignas(plMutex) static plUInt8 s_MutexStorage[sizeof(plMutex)];
+    static plMutex* s_pMutex = new (s_MutexStorage) plMutex();
+    return *s_pMutex;
+  }
+} // namespace
+
+plThreadCachingThreadCacheSlots::~plThreadCachingThreadCacheSlots()
+{
+  PL_LOCK(GetInstancesMutex());
+
+  for (plUInt32 i = 0; i < MaxInstances; ++i)
+  {
+    plThreadCachingThreadCacheSlot& slot = m_Slots[i];
+
+    // if the generation doesn't match, the allocator was already destroyed and took the cache with it
+    if (slot.m_pCache != nullptr && s_Instances[i] != nullptr && s_uiInstanceGenerations[i] == slot.m_uiGeneration)
+    {
+      s_Instances[i]->ReleaseThreadCache(slot.m_pCache);
+    }
+
+    slot.m_pCache = nullptr;
+  }
+}
+
+plAllocPolicyThreadCaching::plAllocPolicyThreadCaching(plAllocator* pParent)
+  : m_FallbackAllocator(pParent)
+{
+  PL_LOCK(GetInstancesMutex());
+
+  for (plUInt32 i = 0; i < MaxInstances; ++i)
+  {
+    if (s_Instances[i] == nullptr)
+    {
+      s_Instances[i] = this;
+      m_uiInstanceSlot = i;
+      m_uiInstanceGeneration = ++s_uiInstanceGenerations[i];
+      break;
+    }
+  }
+
+  // if all slots are taken, m_uiInstanceGeneration stays zero and everything is forwarded to the fallback allocator
+}
+
+plAllocPolicyThreadCaching::~plAllocPolicyThreadCaching()
+{
+  PL_LOCK(GetInstancesMutex());
+
+  if (m_uiInstanceGeneration != 0)
+  {
+    s_Instances[m_uiInstanceSlot] = nullptr;
+  }
+
+  while (m_pThreadCaches != nullptr)
+  {
+    ThreadCache* pNext = m_pThreadCaches->m_pNext;
+    m_FallbackAllocator.Deallocate(m_pThreadCaches);
+    m_pThreadCaches = pNext;
+  }
+
+  if (SegmentMapEntry* pSegmentMap = m_pSegmentMap.load(std::memory_order_acquire))
+  {
+    for (plUInt32 uiLevel1 = 0; uiLevel1 < SegmentMapLevel1Count; ++uiLevel1)
+    {
+      SegmentBitmap* pLevel2 = pSegmentMap[uiLevel1].load(std::memory_order_acquire);
+      if (pLevel2 == nullptr)
+        continue;
+
+      for (plUInt32 uiLevel2 = 0; uiLevel2 < SegmentMapLevel2Count; ++uiLevel2)
+      {
+        if ((pLevel2[uiLevel2 / 64].load(std::memory_order_relaxed) & (1ull << (uiLevel2 % 64))) != 0)
+        {
+          const plUInt64 uiAddress = (static_cast<plUInt64>(uiLevel1) << SegmentMapLevel1Shift) | (static_cast<plUInt64>(uiLevel2) << SegmentShift);
+          m_FallbackAllocator.Deallocate(reinterpret_cast<void*>(static_cast<size_t>(uiAddress)));
+        }
+      }
+
+      m_FallbackAllocator.Deallocate(pLevel2);
+    }
+
+    m_FallbackAllocator.Deallocate(pSegmentMap);
+  }
+}
+
+void* plAllocPolicyThreadCaching::Allocate(size_t uiSize, size_t uiAlign)
+{
+  if (uiSize <= MaxSmallAllocationSize && uiAlign <= MaxSmallAllocationAlignment)
+  {
+    if (ThreadCache* pCache = GetThreadCache(true))
+    {
+      const plUInt32 uiSizeClass = GetSizeClass(uiSize);
+
+      Span* pSpan = pCache->m_Spans[uiSizeClass];
+      if (pSpan != nullptr && pSpan->HasFreeBlocks())
+        return pSpan->AllocateBlock();
+
+      if (void* pPtr = AllocateSlow(pCache, uiSizeClass))
+        return pPtr;
+    }
+  }
+
+  return m_FallbackAllocator.Allocate(uiSize, uiAlign);
+}
+
+void plAllocPolicyThreadCaching::Deallocate(void* pPtr)
+{
+  if (!IsSmallAllocation(pPtr))
+  {
+    m_FallbackAllocator.Deallocate(pPtr);
+    return;
+  }
+
+  Span* pSpan = reinterpret_cast<Span*>(reinterpret_cast<size_t>(pPtr) & ~(SpanSize - 1));
+
+  // only this thread can make itself the owner of a span or give up the ownership,
+  // so the check is reliable even while other threads adopt or orphan other spans
+  ThreadCache* pCache = GetThreadCache(false);
+  if (pCache == nullptr || pSpan->m_pOwner != pCache)
+  {
+    pSpan->PushRemoteFree(pPtr);
+    return;
+  }
+
+  const bool bWasFull = !pSpan->HasFreeBlocks();
+
+  plThreadCachingFreeBlock* pBlock = static_cast<plThreadCachingFreeBlock*>(pPtr);
+  pBlock->m_pNext = pSpan->m_pLocalFreeList;
+  pSpan->m_pLocalFreeList = pBlock;
+  --pSpan->m_uiNumUsed;
+
+  if (pCache->m_Spans[pSpan->m_uiSizeClass] == pSpan)
+    return;
+
+  if (pSpan->m_uiNumUsed == 0)
+  {
+    // hand empty spans back, so that other size classes and threads can use them
+    pCache->Remove(pSpan);
+    ReleaseSpan(pSpan);
+  }
+  else if (bWasFull)
+  {
+    // make sure the freed blocks are found right away
+    pCache->Remove(pSpan);
+    pCache->PushFront(pSpan);
+  }
+}
+
+plAllocPolicyThreadCaching::ThreadCache* plAllocPolicyThreadCaching::GetThreadCache(bool bCreate)
+{
+  plThreadCachingThreadCacheSlot& slot = tl_ThreadCaches.m_Slots[m_uiInstanceSlot];
+
+  if (slot.m_uiGeneration == m_uiInstanceGeneration && slot.m_pCache != nullptr)
+    return slot.m_pCache;
+
+  if (!bCreate || m_uiInstanceGeneration == 0)
+    return nullptr;
+
+  ThreadCache* pCache = new (m_FallbackAllocator.Allocate(sizeof(ThreadCache), alignof(ThreadCache))) ThreadCache();
+
+  {
+    PL_LOCK(m_Mutex);
+    pCache->m_pNext = m_pThreadCaches;
+    m_pThreadCaches = pCache;
+  }
+
+  slot.m_pCache = pCache;
+  slot.m_uiGeneration = m_uiInstanceGeneration;
+  return pCache;
+}
+
+void plAllocPolicyThreadCaching::ReleaseThreadCache(ThreadCache* pCache)
+{
+  PL_LOCK(m_Mutex);
+
+  for (plUInt32 uiSizeClass = 0; uiSizeClass < NumSizeClasses; ++uiSizeClass)
+  {
+    while (Span* pSpan = pCache->m_Spans[uiSizeClass])
+    {
+      pCache->Remove(pSpan);
+      pSpan->m_pOwner = nullptr;
+
+      if (pSpan->m_uiNumUsed == 0)
+      {
+        pSpan->m_pNext = m_pFreeSpans;
+        m_pFreeSpans = pSpan;
+      }
+      else
+      {
+        // still has blocks in use, those will be freed as remote frees and collected by the thread that adopts the span
+        pSpan->m_pNext = m_OrphanedSpans[uiSizeClass];
+        m_OrphanedSpans[uiSizeClass] = pSpan;
+      }
+    }
+  }
+
+  for (ThreadCache** ppCache = &m_pThreadCaches; *ppCache != nullptr; ppCache = &(*ppCache)->m_pNext)
+  {
+    if (*ppCache == pCache)
+    {
+      *ppCache = pCache->m_pNext;
+      break;
+    }
+  }
+
+  m_FallbackAllocator.Deallocate(pCache);
+}
+
+void* plAllocPolicyThreadCaching::AllocateSlow(ThreadCache* pCache, plUInt32 uiSizeClass)
+{
+  // look at a few of the other spans of this size class, they may have gotten blocks back from other threads
+  // the full spans are rotated to the back, so over time all of them are looked at
+  constexpr plUInt32 MaxSpansToCheck = 8;
+
+  Span* pFirst = pCache->m_Spans[uiSizeClass];
+  for (plUInt32 i = 0; pFirst != nullptr && i < MaxSpansToCheck; ++i)
+  {
+    Span* pSpan = pCache->m_Spans[uiSizeClass];
+    pSpan->CollectRemoteFrees();
+
+    if (pSpan->HasFreeBlocks())
+      return pSpan->AllocateBlock();
+
+    pCache->m_Spans[uiSizeClass] = pSpan->m_pNext;
+
+    if (pSpan->m_pNext == pFirst)
+      break;
+  }
+
+  // adopted spans may still be full, fresh spans never are
+  while (Span* pSpan = AcquireSpan(pCache, uiSizeClass))
+  {
+    pCache->PushFront(pSpan);
+    pSpan->CollectRemoteFrees();
+
+    if (pSpan->HasFreeBlocks())
+      return pSpan->AllocateBlock();
+  }
+
+  return nullptr;
+}
+
+plAllocPolicyThreadCaching::Span* plAllocPolicyThreadCaching::AcquireSpan(ThreadCache* pCache, plUInt32 uiSizeClass)
+{
+  PL_LOCK(m_Mutex);
+
+  Span* pSpan = m_OrphanedSpans[uiSizeClass];
+  if (pSpan != nullptr)
+  {
+    m_OrphanedSpans[uiSizeClass] = pSpan->m_pNext;
+    pSpan->m_pNext = nullptr;
+    pSpan->m_pOwner = pCache;
+    return pSpan;
+  }
+
+  if (m_pFreeSpans == nullptr && !AddSegment())
+    return nullptr;
+
+  pSpan = m_pFreeSpans;
+  m_pFreeSpans = pSpan->m_pNext;
+
+  pSpan->Initialize(uiSizeClass);
+  pSpan->m_pOwner = pCache;
+  return pSpan;
+}
+
+void plAllocPolicyThreadCaching::ReleaseSpan(Span* pSpan)
+{
+  PL_LOCK(m_Mutex);
+
+  pSpan->m_pOwner = nullptr;
+  pSpan->m_pNext = m_pFreeSpans;
+  m_pFreeSpans = pSpan;
+}
+
+bool plAllocPolicyThreadCaching::IsSmallAllocation(const void* pPtr) const
+{
+  const plUInt64 uiAddress = reinterpret_cast<size_t>(pPtr);
+  const plUInt64 uiLevel1 = uiAddress >> SegmentMapLevel1Shift;
+
+  if (uiLevel1 >= SegmentMapLevel1Count)
+    return false;
+
+  // AddSegment publishes the tables and bits with release semantics while holding m_Mutex,
+  // the acquire loads make sure we never see a table pointer before its zero-initialized content
+  const SegmentMapEntry* pSegmentMap = m_pSegmentMap.load(std::memory_order_acquire);
+  if (pSegmentMap == nullptr)
+    return false;
+
+  const SegmentBitmap* pLevel2 = pSegmentMap[uiLevel1].load(std::memory_order_acquire);
+  if (pLevel2 == nullptr)
+    return false;
+
+  const plUInt64 uiLevel2 = (uiAddress >> SegmentShift) & (SegmentMapLevel2Count - 1);
+  return (pLevel2[uiLevel2 / 64].load(std::memory_order_acquire) & (1ull << (uiLevel2 % 64))) != 0;
+}
+
+bool plAllocPolicyThreadCaching::AddSegment()
+{
+  // m_Mutex is held by the caller
+
+  plUInt8* pSegment = static_cast<plUInt8*>(m_FallbackAllocator.Allocate(SegmentSize, SegmentSize));
+
+  const plUInt64 uiAddress = reinterpret_cast<size_t>(pSegment);
+  const plUInt64 uiLevel1 = uiAddress >> SegmentMapLevel1Shift;
+
+  if (uiLevel1 >= SegmentMapLevel1Count)
+  {
+    // outside of the address range covered by the segment map, just use the fallback allocator
+    m_FallbackAllocator.Deallocate(pSegment);
+    return false;
+  }
+
+  // only this function modifies the segment map and m_Mutex serializes it, but other threads read it concurrently in IsSmallAllocation,
+  // so new tables are fully initialized before they are published
+  SegmentMapEntry* pSegmentMap = m_pSegmentMap.load(std::memory_order_relaxed);
+  if (pSegmentMap == nullptr)
+  {
+    pSegmentMap = static_cast<SegmentMapEntry*>(m_FallbackAllocator.Allocate(SegmentMapLevel1Count * sizeof(SegmentMapEntry), alignof(SegmentMapEntry)));
+    for (plUInt32 i = 0; i < SegmentMapLevel1Count; ++i)
+      new (&pSegmentMap[i]) SegmentMapEntry(nullptr);
+
+    m_pSegmentMap.store(pSegmentMap, std::memory_order_release);
+  }
+
+  SegmentBitmap* pLevel2 = pSegmentMap[uiLevel1].load(std::memory_order_relaxed);
+  if (pLevel2 == nullptr)
+  {
+    pLevel2 = static_cast<SegmentBitmap*>(m_FallbackAllocator.Allocate((SegmentMapLevel2Count / 64) * sizeof(SegmentBitmap), alignof(SegmentBitmap)));
+    for (plUInt32 i = 0; i < SegmentMapLevel2Count / 64; ++i)
+      new (&pLevel2[i]) SegmentBitmap(0);
+
+    pSegmentMap[uiLevel1].store(pLevel2, std::memory_order_release);
+  }
+
+  const plUInt64 uiLevel2 = (uiAddress >> SegmentShift) & (SegmentMapLevel2Count - 1);
+  pLevel2[uiLevel2 / 64].fetch_or(1ull << (uiLevel2 % 64), std::memory_order_release);
+
+  for (plUInt32 i = 0; i < SpansPerSegment; ++i)
+  {
+    Span* pSpan = new (pSegment + i * SpanSize) Span();
+    pSpan->m_pNext = m_pFreeSpans;
+    m_pFreeSpans = pSpan;
+  }
+
+  return true;
+}
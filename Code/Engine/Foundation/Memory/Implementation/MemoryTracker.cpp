@@ -23,6 +23,20 @@ namespace
   };
 
 
+  using AllocationTable = plHashTable<const void*, plMemoryTracker::AllocationInfo, plHashHelper<const void*>, TrackerDataAllocatorWrapper>;
+
+  /// \brief The allocations of one allocator are spread over several shards with their own lock, so that threads rarely have to wait for each other.
+  struct AllocationShard
+  {
+    plMutex m_Mutex;
+    AllocationTable m_Allocations;
+    plAllocator::Stats m_Stats;
+
+    plUInt8 m_Padding[64]; // keep the mutexes of different shards on separate cache lines
+  };
+
+  static constexpr plUInt32 s_uiNumAllocationShards = 16;
+
   struct AllocatorData
   {
     PL_ALWAYS_INLINE AllocatorData() = default;
@@ -30,13 +44,54 @@ namespace
     plHybridString<32, TrackerDataAllocatorWrapper> m_sName;
     plAllocatorTrackingMode m_TrackingMode;
 
+    plAllocatorId m_Id;
     plAllocatorId m_ParentId;
 
-    plAllocator::Stats m_Stats;
+    plAllocator::Stats m_Stats;     ///< The combined stats of all shards, see UpdateStats().
+    plAllocator::Stats m_BaseStats; ///< Stats that were set directly through SetAllocatorStats().
+
+    AllocationShard m_Shards[s_uiNumAllocationShards];
+
+    PL_FORCE_INLINE AllocationShard& GetShard(const void* pPtr)
+    {
+      // the low bits are mostly zero due to alignment, Fibonacci hashing spreads the rest evenly
+      const plUInt64 uiHash = (static_cast<plUInt64>(reinterpret_cast<size_t>(pPtr)) >> 4) * 0x9E3779B97F4A7C15ull;
+      return m_Shards[uiHash >> 60];
+    }
+
+    plUInt32 GetNumAllocations()
+    {
+      plUInt32 uiNumAllocations = 0;
+      for (AllocationShard& shard : m_Shards)
+      {
+        PL_LOCK(shard.m_Mutex);
+        uiNumAllocations += shard.m_Allocations.GetCount();
+      }
+
+      return uiNumAllocations;
+    }
 
-    plHashTable<const void*, plMemoryTracker::AllocationInfo, plHashHelper<const void*>, TrackerDataAllocatorWrapper> m_Allocations;
+    const plAllocator::Stats& UpdateStats()
+    {
+      plAllocator::Stats stats = m_BaseStats;
+
+      for (AllocationShard& shard : m_Shards)
+      {
+        PL_LOCK(shard.m_Mutex);
+        stats.m_uiNumAllocations += shard.m_Stats.m_uiNumAllocations;
+        stats.m_uiNumDeallocations += shard.m_Stats.m_uiNumDeallocations;
+        stats.m_uiAllocationSize += shard.m_Stats.m_uiAllocationSize;
+        stats.m_uiPerFrameAllocationSize += shard.m_Stats.m_uiPerFrameAllocationSize;
+        stats.m_PerFrameAllocationTime += shard.m_Stats.m_PerFrameAllocationTime;
+      }
+
+      m_Stats = stats;
+      return m_Stats;
+    }
   };
 
+  static_assert(s_uiNumAllocationShards == 16, "GetShard() uses the upper 4 bits of the hash");
+
   struct TrackerData
   {
     PL_ALWAYS_INLINE void Lock() { m_Mutex.Lock(); }
@@ -44,14 +99,46 @@ namespace
 
     plMutex m_Mutex;
 
-    using AllocatorTable = plIdTable<plAllocatorId, AllocatorData, TrackerDataAllocatorWrapper>;
+    using AllocatorTable = plIdTable<plAllocatorId, AllocatorData*, TrackerDataAllocatorWrapper>;
     AllocatorTable m_AllocatorData;
+
+    // Allows to look up the allocator data without locking m_Mutex, which would otherwise be taken for every allocation.
+    // The entries are only written while m_Mutex is locked and the chunks are never freed.
+    static constexpr plUInt32 s_uiChunkSize = 256;
+    static constexpr plUInt32 s_uiMaxChunks = 1024;
+    AllocatorData** m_AllocatorDataChunks[s_uiMaxChunks] = {};
+
+    void SetAllocatorData(plAllocatorId allocatorId, AllocatorData* pData)
+    {
+      const plUInt32 uiIndex = allocatorId.m_InstanceIndex;
+      PL_ASSERT_DEV(uiIndex < s_uiChunkSize * s_uiMaxChunks, "Too many allocators");
+
+      AllocatorData**& pChunk = m_AllocatorDataChunks[uiIndex / s_uiChunkSize];
+      if (pChunk == nullptr)
+      {
+        pChunk = PL_NEW_RAW_BUFFER(s_pTrackerDataAllocator, AllocatorData*, s_uiChunkSize);
+        plMemoryUtils::ZeroFill(pChunk, s_uiChunkSize);
+      }
+
+      pChunk[uiIndex % s_uiChunkSize] = pData;
+    }
+
+    PL_FORCE_INLINE AllocatorData& GetAllocatorData(plAllocatorId allocatorId) const
+    {
+      const plUInt32 uiIndex = allocatorId.m_InstanceIndex;
+      AllocatorData* pData = m_AllocatorDataChunks[uiIndex / s_uiChunkSize][uiIndex % s_uiChunkSize];
+      PL_ASSERT_DEBUG(pData != nullptr && pData->m_Id == allocatorId, "Invalid allocator id");
+      return *pData;
+    }
   };
 
   static TrackerData* s_pTrackerData;
   static bool s_bIsInitialized = false;
   static bool s_bIsInitializing = false;
 
+  static plUInt32 s_uiStackTraceSampleRate = 64;
+  thread_local plUInt32 tl_uiAllocationsSinceLastSample = 0;
+
   static void Initialize()
   {
     if (s_bIsInitialized)
@@ -105,17 +192,19 @@ plAllocatorId plMemoryTracker::Iterator::Id() const
 
 plStringView plMemoryTracker::Iterator::Name() const
 {
-  return CAST_ITER(m_pData)->Value().m_sName;
+  return CAST_ITER(m_pData)->Value()->m_sName;
 }
 
 plAllocatorId plMemoryTracker::Iterator::ParentId() const
 {
-  return CAST_ITER(m_pData)->Value().m_ParentId;
+  return CAST_ITER(m_pData)->Value()->m_ParentId;
 }
 
 const plAllocator::Stats& plMemoryTracker::Iterator::Stats() const
 {
-  return CAST_ITER(m_pData)->Value().m_Stats;
+  PL_LOCK(*s_pTrackerData);
+
+  return CAST_ITER(m_pData)->Value()->UpdateStats();
 }
 
 void plMemoryTracker::Iterator::Next()
@@ -143,12 +232,15 @@ plAllocatorId plMemoryTracker::RegisterAllocator(plStringView sName, plAllocator
 
   PL_LOCK(*s_pTrackerData);
 
-  AllocatorData data;
-  data.m_sName = sName;
-  data.m_TrackingMode = mode;
-  data.m_ParentId = parentId;
+  AllocatorData* pData = PL_NEW(s_pTrackerDataAllocator, AllocatorData);
+  pData->m_sName = sName;
+  pData->m_TrackingMode = mode;
+  pData->m_ParentId = parentId;
+  pData->m_Id = s_pTrackerData->m_AllocatorData.Insert(pData);
+
+  s_pTrackerData->SetAllocatorData(pData->m_Id, pData);
 
-  return s_pTrackerData->m_AllocatorData.Insert(data);
+  return pData->m_Id;
 }
 
 // static
@@ -156,20 +248,28 @@ void plMemoryTracker::DeregisterAllocator(plAllocatorId allocatorId)
 {
   PL_LOCK(*s_pTrackerData);
 
-  const AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+  AllocatorData* pData = &s_pTrackerData->GetAllocatorData(allocatorId);
 
-  plUInt32 uiLiveAllocations = data.m_Allocations.GetCount();
+  plUInt32 uiLiveAllocations = pData->GetNumAllocations();
   if (uiLiveAllocations != 0)
   {
-    for (auto it = data.m_Allocations.GetIterator(); it.IsValid(); ++it)
+    for (AllocationShard& shard : pData->m_Shards)
     {
-      DumpLeak(it.Value(), data.m_sName.GetData());
+      PL_LOCK(shard.m_Mutex);
+
+      for (auto it = shard.m_Allocations.GetIterator(); it.IsValid(); ++it)
+      {
+        DumpLeak(it.Value(), pData->m_sName.GetData());
+      }
     }
 
-    PL_REPORT_FAILURE("Allocator '{0}' leaked {1} allocation(s)", data.m_sName.GetData(), uiLiveAllocations);
+    PL_REPORT_FAILURE("Allocator '{0}' leaked {1} allocation(s)", pData->m_sName.GetData(), uiLiveAllocations);
   }
 
+  s_pTrackerData->SetAllocatorData(allocatorId, nullptr);
   s_pTrackerData->m_AllocatorData.Remove(allocatorId);
+
+  PL_DELETE(s_pTrackerDataAllocator, pData);
 }
 
 // static
@@ -177,8 +277,15 @@ void plMemoryTracker::AddAllocation(plAllocatorId allocatorId, plAllocatorTracki
 {
   PL_ASSERT_DEV(uiAlign < 0xFFFF, "Alignment too big");
 
+  bool bRecordStackTrace = mode == plAllocatorTrackingMode::AllocationStatsAndStacktraces;
+  if (mode == plAllocatorTrackingMode::AllocationStatsAndSampledStacktraces && ++tl_uiAllocationsSinceLastSample >= s_uiStackTraceSampleRate)
+  {
+    tl_uiAllocationsSinceLastSample = 0;
+    bRecordStackTrace = true;
+  }
+
   plArrayPtr<void*> stackTrace;
-  if (mode >= plAllocatorTrackingMode::AllocationStatsAndStacktraces)
+  if (bRecordStackTrace)
   {
     void* pBuffer[64];
     plArrayPtr<void*> tempTrace(pBuffer);
@@ -189,15 +296,15 @@ void plMemoryTracker::AddAllocation(plAllocatorId allocatorId, plAllocatorTracki
   }
 
   {
-    PL_LOCK(*s_pTrackerData);
+    AllocationShard& shard = s_pTrackerData->GetAllocatorData(allocatorId).GetShard(pPtr);
+    PL_LOCK(shard.m_Mutex);
 
-    AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
-    data.m_Stats.m_uiNumAllocations++;
-    data.m_Stats.m_uiAllocationSize += uiSize;
-    data.m_Stats.m_uiPerFrameAllocationSize += uiSize;
-    data.m_Stats.m_PerFrameAllocationTime += allocationTime;
+    shard.m_Stats.m_uiNumAllocations++;
+    shard.m_Stats.m_uiAllocationSize += uiSize;
+    shard.m_Stats.m_uiPerFrameAllocationSize += uiSize;
+    shard.m_Stats.m_PerFrameAllocationTime += allocationTime;
 
-    auto pInfo = &data.m_Allocations[pPtr];
+    auto pInfo = &shard.m_Allocations[pPtr];
     pInfo->m_uiSize = uiSize;
     pInfo->m_uiAlignment = (plUInt16)uiAlign;
     pInfo->SetStackTrace(stackTrace);
@@ -210,15 +317,14 @@ void plMemoryTracker::RemoveAllocation(plAllocatorId allocatorId, const void* pP
   plArrayPtr<void*> stackTrace;
 
   {
-    PL_LOCK(*s_pTrackerData);
-
-    AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+    AllocationShard& shard = s_pTrackerData->GetAllocatorData(allocatorId).GetShard(pPtr);
+    PL_LOCK(shard.m_Mutex);
 
     AllocationInfo info;
-    if (data.m_Allocations.Remove(pPtr, &info))
+    if (shard.m_Allocations.Remove(pPtr, &info))
     {
-      data.m_Stats.m_uiNumDeallocations++;
-      data.m_Stats.m_uiAllocationSize -= info.m_uiSize;
+      shard.m_Stats.m_uiNumDeallocations++;
+      shard.m_Stats.m_uiAllocationSize -= info.m_uiSize;
 
       stackTrace = info.GetStackTrace();
     }
@@ -234,17 +340,21 @@ void plMemoryTracker::RemoveAllocation(plAllocatorId allocatorId, const void* pP
 // static
 void plMemoryTracker::RemoveAllAllocations(plAllocatorId allocatorId)
 {
-  PL_LOCK(*s_pTrackerData);
-  AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
-  for (auto it = data.m_Allocations.GetIterator(); it.IsValid(); ++it)
+  AllocatorData& data = s_pTrackerData->GetAllocatorData(allocatorId);
+  for (AllocationShard& shard : data.m_Shards)
   {
-    auto& info = it.Value();
-    data.m_Stats.m_uiNumDeallocations++;
-    data.m_Stats.m_uiAllocationSize -= info.m_uiSize;
+    PL_LOCK(shard.m_Mutex);
 
-    PL_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
+    for (auto it = shard.m_Allocations.GetIterator(); it.IsValid(); ++it)
+    {
+      auto& info = it.Value();
+      shard.m_Stats.m_uiNumDeallocations++;
+      shard.m_Stats.m_uiAllocationSize -= info.m_uiSize;
+
+      PL_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
+    }
+    shard.m_Allocations.Clear();
   }
-  data.m_Allocations.Clear();
 }
 
 // static
@@ -252,7 +362,14 @@ void plMemoryTracker::SetAllocatorStats(plAllocatorId allocatorId, const plAlloc
 {
   PL_LOCK(*s_pTrackerData);
 
-  s_pTrackerData->m_AllocatorData[allocatorId].m_Stats = stats;
+  AllocatorData& data = s_pTrackerData->GetAllocatorData(allocatorId);
+  data.m_BaseStats = stats;
+
+  for (AllocationShard& shard : data.m_Shards)
+  {
+    PL_LOCK(shard.m_Mutex);
+    shard.m_Stats = plAllocator::Stats();
+  }
 }
 
 // static
@@ -262,9 +379,16 @@ void plMemoryTracker::ResetPerFrameAllocatorStats()
 
   for (auto it = s_pTrackerData->m_AllocatorData.GetIterator(); it.IsValid(); ++it)
   {
-    AllocatorData& data = it.Value();
-    data.m_Stats.m_uiPerFrameAllocationSize = 0;
-    data.m_Stats.m_PerFrameAllocationTime = plTime::MakeZero();
+    AllocatorData& data = *it.Value();
+    data.m_BaseStats.m_uiPerFrameAllocationSize = 0;
+    data.m_BaseStats.m_PerFrameAllocationTime = plTime::MakeZero();
+
+    for (AllocationShard& shard : data.m_Shards)
+    {
+      PL_LOCK(shard.m_Mutex);
+      shard.m_Stats.m_uiPerFrameAllocationSize = 0;
+      shard.m_Stats.m_PerFrameAllocationTime = plTime::MakeZero();
+    }
   }
 }
 
@@ -273,7 +397,7 @@ plStringView plMemoryTracker::GetAllocatorName(plAllocatorId allocatorId)
 {
   PL_LOCK(*s_pTrackerData);
 
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_sName;
+  return s_pTrackerData->GetAllocatorData(allocatorId).m_sName;
 }
 
 // static
@@ -281,7 +405,7 @@ const plAllocator::Stats& plMemoryTracker::GetAllocatorStats(plAllocatorId alloc
 {
   PL_LOCK(*s_pTrackerData);
 
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_Stats;
+  return s_pTrackerData->GetAllocatorData(allocatorId).UpdateStats();
 }
 
 // static
@@ -289,17 +413,17 @@ plAllocatorId plMemoryTracker::GetAllocatorParentId(plAllocatorId allocatorId)
 {
   PL_LOCK(*s_pTrackerData);
 
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_ParentId;
+  return s_pTrackerData->GetAllocatorData(allocatorId).m_ParentId;
 }
 
 // static
 const plMemoryTracker::AllocationInfo& plMemoryTracker::GetAllocationInfo(plAllocatorId allocatorId, const void* pPtr)
 {
-  PL_LOCK(*s_pTrackerData);
+  AllocationShard& shard = s_pTrackerData->GetAllocatorData(allocatorId).GetShard(pPtr);
+  PL_LOCK(shard.m_Mutex);
 
-  const AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
   const AllocationInfo* info = nullptr;
-  if (data.m_Allocations.TryGetValue(pPtr, info))
+  if (shard.m_Allocations.TryGetValue(pPtr, info))
   {
     return *info;
   }
@@ -332,19 +456,24 @@ plUInt32 plMemoryTracker::PrintMemoryLeaks(PrintFunc printfunc)
   // first collect all leaks
   for (auto it = s_pTrackerData->m_AllocatorData.GetIterator(); it.IsValid(); ++it)
   {
-    const AllocatorData& data = it.Value();
-    for (auto it2 = data.m_Allocations.GetIterator(); it2.IsValid(); ++it2)
+    AllocatorData& data = *it.Value();
+    for (AllocationShard& shard : data.m_Shards)
     {
-      LeakInfo leak;
-      leak.m_AllocatorId = it.Id();
-      leak.m_uiSize = it2.Value().m_uiSize;
+      PL_LOCK(shard.m_Mutex);
 
-      if (data.m_TrackingMode == plAllocatorTrackingMode::AllocationStatsIgnoreLeaks)
+      for (auto it2 = shard.m_Allocations.GetIterator(); it2.IsValid(); ++it2)
       {
-        leak.m_bIsRootLeak = false;
-      }
+        LeakInfo leak;
+        leak.m_AllocatorId = it.Id();
+        leak.m_uiSize = it2.Value().m_uiSize;
+
+        if (data.m_TrackingMode == plAllocatorTrackingMode::AllocationStatsIgnoreLeaks)
+        {
+          leak.m_bIsRootLeak = false;
+        }
 
-      leakTable.Insert(it2.Key(), leak);
+        leakTable.Insert(it2.Key(), leak);
+      }
     }
   }
 
@@ -381,7 +510,7 @@ plUInt32 plMemoryTracker::PrintMemoryLeaks(PrintFunc printfunc)
 
     if (leak.m_bIsRootLeak)
     {
-      const AllocatorData& data = s_pTrackerData->m_AllocatorData[leak.m_AllocatorId];
+      AllocatorData& data = s_pTrackerData->GetAllocatorData(leak.m_AllocatorId);
 
       if (data.m_TrackingMode != plAllocatorTrackingMode::AllocationStatsIgnoreLeaks)
       {
@@ -393,7 +522,11 @@ plUInt32 plMemoryTracker::PrintMemoryLeaks(PrintFunc printfunc)
         }
 
         plMemoryTracker::AllocationInfo info;
-        data.m_Allocations.TryGetValue(ptr, info);
+        {
+          AllocationShard& shard = data.GetShard(ptr);
+          PL_LOCK(shard.m_Mutex);
+          shard.m_Allocations.TryGetValue(ptr, info);
+        }
 
         DumpLeak(info, data.m_sName.GetData());
 
@@ -433,3 +566,17 @@ plMemoryTracker::Iterator plMemoryTracker::GetIterator()
   auto pInnerIt = PL_NEW(s_pTrackerDataAllocator, TrackerData::AllocatorTable::Iterator, s_pTrackerData->m_AllocatorData.GetIterator());
   return Iterator(pInnerIt);
 }
+
+// static
+void plMemoryTracker::SetStackTraceSampleRate(plUInt32 uiSampleRate)
+{
+  PL_ASSERT_DEV(uiSampleRate > 0, "The sample rate must be at least 1");
+
+  s_uiStackTraceSampleRate = plMath::Max(uiSampleRate, 1u);
+}
+
+// static
+plUInt32 plMemoryTracker::GetStackTraceSampleRate()
+{
+  return s_uiStackTraceSampleRate;
+}
@@ -6,11 +6,12 @@
 
 enum class plAllocatorTrackingMode : plUInt32
 {
-  Nothing,                       ///< The allocator doesn't track anything. Use this for best performance.
-  Basics,                        ///< The allocator will be known to the system, so it can show up in debugging tools, but barely anything more.
-  AllocationStats,               ///< The allocator keeps track of how many allocations and deallocations it did and how large its memory usage is.
-  AllocationStatsIgnoreLeaks,    ///< Same as AllocationStats, but any remaining allocations at shutdown are not reported as leaks.
-  AllocationStatsAndStacktraces, ///< The allocator will record stack traces for each allocation, which can be used to find memory leaks.
+  Nothing,                              ///< The allocator doesn't track anything. Use this for best performance.
+  Basics,                               ///< The allocator will be known to the system, so it can show up in debugging tools, but barely anything more.
+  AllocationStats,                      ///< The allocator keeps track of how many allocations and deallocations it did and how large its memory usage is.
+  AllocationStatsIgnoreLeaks,           ///< Same as AllocationStats, but any remaining allocations at shutdown are not reported as leaks.
+  AllocationStatsAndStacktraces,        ///< The allocator will record stack traces for each allocation, which can be used to find memory leaks.
+  AllocationStatsAndSampledStacktraces, ///< Same as AllocationStats, but additionally records the stack trace of every Nth allocation, see plMemoryTracker::SetStackTraceSampleRate().
 
   Default = PL_ALLOC_TRACKING_DEFAULT,
 };
@@ -87,6 +88,13 @@ public:
 
   static Iterator GetIterator();
 
+  /// \brief Sets for how many allocations one stack trace is recorded by allocators that use plAllocatorTrackingMode::AllocationStatsAndSampledStacktraces.
+  ///
+  /// The default is 64. A value of 1 records the stack trace of every allocation.
+  /// Stack traces are by far the most expensive part of the tracking, sampling them keeps leak detection affordable in long running processes.
+  static void SetStackTraceSampleRate(plUInt32 uiSampleRate);
+  static plUInt32 GetStackTraceSampleRate();
+
   /// \brief Callback for printing strings.
   using PrintFunc = void (*)(const char* szLine);
 
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Foundation/Memory/Policies/AllocPolicyAlignedHeap.h>
+#include <Foundation/Threading/Mutex.h>
+
+#include <atomic>
+
+namespace plInternal
+{
+  struct plThreadCachingSpan;
+  struct plThreadCachingThreadCache;
+  struct plThreadCachingThreadCacheSlots;
+} // namespace plInternal
+
+/// \brief Heap allocation policy that serves small allocations from thread-local caches.
+///
+/// Allocations of up to MaxSmallAllocationSize bytes with an alignment of at most 16 are rounded up to one of a few size classes.
+/// Every thread owns its own spans (64 KB blocks of equally sized slots) per size class, so allocating and freeing on the same thread
+/// never takes a lock. Memory freed on another thread is pushed onto a lock-free list of the owning span and picked up by the owner
+/// the next time it runs out of free slots. Spans of threads that exit are handed over to the next thread that needs that size class.
+///
+/// All other allocations are forwarded to plAllocPolicyAlignedHeap, so this policy can be used for the default heap allocator
+/// as well as for the aligned heap allocator. See PL_ALLOC_THREAD_CACHING and plThreadCachingHeapAllocator.
+///
+/// \note Span memory is reused for all size classes, but it is only returned to the system when the allocator is destroyed.
+///
+/// \see plAllocatorWithPolicy
+class PL_FOUNDATION_DLL plAllocPolicyThreadCaching
+{
+public:
+  enum
+  {
+    MaxSmallAllocationSize = 1024,
+    MaxSmallAllocationAlignment = 16,
+    NumSizeClasses = 20,
+  };
+
+  plAllocPolicyThreadCaching(plAllocator* pParent);
+  ~plAllocPolicyThreadCaching();
+
+  void* Allocate(size_t uiSize, size_t uiAlign);
+  void Deallocate(void* pPtr);
+
+  PL_ALWAYS_INLINE plAllocator* GetParent() const { return nullptr; }
+
+private:
+  friend struct plInternal::plThreadCachingThreadCacheSlots;
+
+  using Span = plInternal::plThreadCachingSpan;
+  using ThreadCache = plInternal::plThreadCachingThreadCache;
+  using SegmentBitmap = std::atomic<plUInt64>;
+  using SegmentMapEntry = std::atomic<SegmentBitmap*>;
+
+  ThreadCache* GetThreadCache(bool bCreate);
+  void ReleaseThreadCache(ThreadCache* pCache);
+
+  void* AllocateSlow(ThreadCache* pCache, plUInt32 uiSizeClass);
+  Span* AcquireSpan(ThreadCache* pCache, plUInt32 uiSizeClass);
+  void ReleaseSpan(Span* pSpan);
+
+  bool IsSmallAllocation(const void* pPtr) const;
+  bool AddSegment();
+
+  plAllocPolicyAlignedHeap m_FallbackAllocator;
+
+  plMutex m_Mutex;
+  plUInt32 m_uiInstanceSlot = 0;
+  plUInt32 m_uiInstanceGeneration = 0;
+
+  // two level bitmap of all segments that belong to this allocator, used to tell small allocations apart from fallback allocations.
+  // Only written while m_Mutex is held, but read without a lock by every thread that frees memory.
+  std::atomic<SegmentMapEntry*> m_pSegmentMap = nullptr;
+
+  Span* m_pFreeSpans = nullptr;
+  Span* m_OrphanedSpans[NumSizeClasses] = {};
+  ThreadCache* m_pThreadCaches = nullptr;
+};
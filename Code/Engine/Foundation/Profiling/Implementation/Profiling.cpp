@@ -4,11 +4,18 @@
 #include <Foundation/Communication/DataTransfer.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Configuration/Startup.h>
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/HashSet.h>
 #include <Foundation/Containers/IdTable.h>
 #include <Foundation/Containers/StaticRingBuffer.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/JSONWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/IO/OSFile.h>
 #include <Foundation/Memory/CommonAllocators.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
 #include <Foundation/Threading/ThreadUtils.h>
 
 #if PL_ENABLED(PL_USE_PROFILING)
@@ -33,8 +40,17 @@ static plProfileCaptureDataTransfer s_ProfileCaptureDataTransfer;
 namespace
 {
   static plEventSubscriptionID s_PluginEventSubscription = 0;
+  void FlushContinuousCapture();
+
   void PluginEvent(const plPluginEvent& e)
   {
+    if (e.m_EventType == plPluginEvent::BeforeUnloading)
+    {
+      // The continuous capture only stores pointers to function names until they are written,
+      // so everything has to be written out while the plugin is still loaded.
+      FlushContinuousCapture();
+    }
+
     if (e.m_EventType == plPluginEvent::AfterUnloading)
     {
       // When a plugin is unloaded we need to clear all profiling data
@@ -63,6 +79,7 @@ PL_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ProfilingSystem)
   {
     s_ProfileCaptureDataTransfer.DisableDataTransfer();
     plPlugin::Events().RemoveEventHandler(s_PluginEventSubscription);
+    plProfilingSystem::StopContinuousCapture();
     plProfilingSystem::Reset();
   }
 
@@ -92,6 +109,9 @@ namespace
 
     plUInt64 m_uiThreadId = 0;
     bool IsMainThread() const { return m_uiThreadId == s_MainThreadId; }
+
+    plMutex m_ContinuousCaptureMutex;
+    plDynamicArray<plProfilingSystem::CPUScope> m_ContinuousCaptureData; ///< Scopes that the continuous capture writer hasn't picked up yet
   };
 
   template <plUInt32 SizeInBytes>
@@ -134,6 +154,411 @@ namespace
   static plDynamicArray<plUniquePtr<GPUScopesBuffer>> s_GPUScopes;
 } // namespace
 
+//////////////////////////////////////////////////////////////////////////
+// Continuous capture
+//
+// File layout: magic, version, process id, followed by records that each start with a ContinuousCaptureRecord byte.
+// Scope and thread names are written once as String records and afterwards referenced by their index.
+// Timestamps are stored in nanoseconds as variable length integers, begin times relative to the previous scope in the same record.
+
+namespace
+{
+  enum
+  {
+    CONTINUOUS_CAPTURE_MAGIC = 0x50435050, // 'PPCP'
+    CONTINUOUS_CAPTURE_VERSION = 1,
+    CONTINUOUS_CAPTURE_MAX_PENDING_SCOPES = 64 * 1024, ///< Per thread and per GPU, scopes beyond this are dropped until the writer catches up
+  };
+
+  struct ContinuousCaptureRecord
+  {
+    enum Enum : plUInt8
+    {
+      End = 0,
+      String,
+      Thread,
+      CPUScopes,
+      GPUScopes,
+      Frames,
+      DroppedScopes,
+    };
+  };
+
+  static plAtomicBool s_bContinuousCaptureActive;
+  static plAtomicInteger32 s_iContinuousCaptureDroppedScopes;
+  static plThreadSignal s_ContinuousCaptureWakeUp;
+
+  // frames and GPU scopes are added rarely enough that they can share one mutex
+  static plMutex s_ContinuousCaptureMutex;
+  static plDynamicArray<plTime> s_ContinuousCaptureFrameStartTimes;
+  static plUInt64 s_uiContinuousCaptureFirstFrame = 0;
+  static plDynamicArray<plDynamicArray<plProfilingSystem::GPUScope>> s_ContinuousCaptureGPUScopes;
+
+  void WriteVarUInt(plStreamWriter& inout_stream, plUInt64 uiValue)
+  {
+    plUInt8 bytes[10];
+    plUInt32 uiNumBytes = 0;
+
+    do
+    {
+      bytes[uiNumBytes] = static_cast<plUInt8>(uiValue & 0x7F);
+      uiValue >>= 7;
+
+      if (uiValue != 0)
+      {
+        bytes[uiNumBytes] |= 0x80;
+      }
+
+      ++uiNumBytes;
+    } while (uiValue != 0);
+
+    inout_stream.WriteBytes(bytes, uiNumBytes).IgnoreResult();
+  }
+
+  void WriteVarInt(plStreamWriter& inout_stream, plInt64 iValue)
+  {
+    // zig-zag encoding, so that small negative deltas stay small
+    WriteVarUInt(inout_stream, (static_cast<plUInt64>(iValue) << 1) ^ static_cast<plUInt64>(iValue >> 63));
+  }
+
+  plResult ReadVarUInt(plStreamReader& inout_stream, plUInt64& out_uiValue)
+  {
+    out_uiValue = 0;
+
+    for (plUInt32 uiShift = 0; uiShift < 64; uiShift += 7)
+    {
+      plUInt8 uiByte = 0;
+      if (inout_stream.ReadBytes(&uiByte, 1) != 1)
+        return PL_FAILURE;
+
+      out_uiValue |= static_cast<plUInt64>(uiByte & 0x7F) << uiShift;
+
+      if ((uiByte & 0x80) == 0)
+        return PL_SUCCESS;
+    }
+
+    return PL_FAILURE;
+  }
+
+  plResult ReadVarInt(plStreamReader& inout_stream, plInt64& out_iValue)
+  {
+    plUInt64 uiValue = 0;
+    PL_SUCCEED_OR_RETURN(ReadVarUInt(inout_stream, uiValue));
+
+    out_iValue = static_cast<plInt64>(uiValue >> 1) ^ -static_cast<plInt64>(uiValue & 1);
+    return PL_SUCCESS;
+  }
+
+  PL_ALWAYS_INLINE plInt64 ToNanoseconds(plTime t)
+  {
+    return static_cast<plInt64>(t.GetNanoseconds());
+  }
+
+  /// Picks up the pending scopes of all threads in regular intervals and writes them to the capture file.
+  class ContinuousCaptureWriter : public plThread
+  {
+  public:
+    ContinuousCaptureWriter()
+      : plThread("Profiling Capture Writer")
+      , m_Stream(&m_Storage)
+    {
+    }
+
+    plResult Open(plStringView sFile)
+    {
+      // The file is written through plOSFile, so that the capture doesn't depend on the file system staying up until it is stopped.
+      plStringBuilder sAbsolutePath = sFile;
+      if (!plPathUtils::IsAbsolutePath(sFile))
+      {
+        PL_SUCCEED_OR_RETURN(plFileSystem::ResolvePath(sFile, &sAbsolutePath, nullptr));
+      }
+
+      PL_SUCCEED_OR_RETURN(m_File.Open(sAbsolutePath, plFileOpenMode::Write));
+
+      plUInt32 uiMagic = CONTINUOUS_CAPTURE_MAGIC;
+      plUInt8 uiVersion = CONTINUOUS_CAPTURE_VERSION;
+#  if PL_ENABLED(PL_SUPPORTS_PROCESSES)
+      plUInt32 uiProcessID = plProcess::GetCurrentProcessID();
+#  else
+      plUInt32 uiProcessID = 0;
+#  endif
+
+      m_Stream << uiMagic;
+      m_Stream << uiVersion;
+      m_Stream << uiProcessID;
+
+      return PL_SUCCESS;
+    }
+
+    void RequestStop()
+    {
+      m_bStop = true;
+      s_ContinuousCaptureWakeUp.RaiseSignal();
+    }
+
+    void Flush()
+    {
+      PL_LOCK(m_FlushMutex);
+
+      WriteNewThreads();
+      WriteCPUScopes();
+      WriteGPUScopesAndFrames();
+
+      const plInt32 iDroppedScopes = s_iContinuousCaptureDroppedScopes.Set(0);
+      if (iDroppedScopes > 0)
+      {
+        m_uiTotalDroppedScopes += iDroppedScopes;
+
+        WriteRecordType(ContinuousCaptureRecord::DroppedScopes);
+        WriteVarUInt(m_Stream, static_cast<plUInt64>(iDroppedScopes));
+      }
+
+      WriteToFile();
+    }
+
+    plUInt64 GetTotalDroppedScopes() const { return m_uiTotalDroppedScopes; }
+
+  private:
+    virtual plUInt32 Run() override
+    {
+      while (!m_bStop)
+      {
+        s_ContinuousCaptureWakeUp.WaitForSignal(plTime::MakeFromMilliseconds(100));
+
+        Flush();
+      }
+
+      Flush();
+
+      WriteRecordType(ContinuousCaptureRecord::End);
+      WriteToFile();
+      m_File.Close();
+
+      return 0;
+    }
+
+    void WriteToFile()
+    {
+      if (m_Storage.GetStorageSize64() == 0)
+        return;
+
+      if (m_File.Write(m_Storage.GetData(), m_Storage.GetStorageSize64()).Failed())
+      {
+        plLog::Error("Failed to write the profiling capture.");
+      }
+
+      m_Storage.Clear();
+      m_Stream.SetStorage(&m_Storage);
+    }
+
+    void WriteRecordType(ContinuousCaptureRecord::Enum type)
+    {
+      plUInt8 uiType = type;
+      m_Stream << uiType;
+    }
+
+    plUInt32 InternName(plStringView sName)
+    {
+      plUInt32 uiIndex = 0;
+      if (m_NameIndices.TryGetValue(sName, uiIndex))
+        return uiIndex;
+
+      uiIndex = m_NameIndices.GetCount();
+      m_NameIndices.Insert(plString(sName), uiIndex);
+
+      WriteRecordType(ContinuousCaptureRecord::String);
+      m_Stream.WriteString(sName).IgnoreResult();
+
+      return uiIndex;
+    }
+
+    void WriteNewThreads()
+    {
+      PL_LOCK(s_ThreadInfosMutex);
+
+      for (const auto& threadInfo : s_ThreadInfos)
+      {
+        // the OS may reuse the id of a dead thread, so the name is written again when it changed
+        plString* pWrittenName = nullptr;
+        if (m_WrittenThreadNames.TryGetValue(threadInfo.m_uiThreadId, pWrittenName) && *pWrittenName == threadInfo.m_sName)
+          continue;
+
+        m_WrittenThreadNames[threadInfo.m_uiThreadId] = threadInfo.m_sName;
+
+        WriteRecordType(ContinuousCaptureRecord::Thread);
+        m_Stream << threadInfo.m_uiThreadId;
+        m_Stream.WriteString(threadInfo.m_sName).IgnoreResult();
+      }
+    }
+
+    void WriteCPUScopes()
+    {
+      {
+        PL_LOCK(s_AllCpuScopesMutex);
+
+        m_PendingCPUScopes.SetCount(s_AllCpuScopes.GetCount());
+        for (plUInt32 i = 0; i < s_AllCpuScopes.GetCount(); ++i)
+        {
+          CpuScopesBufferBase* pEventBuffer = s_AllCpuScopes[i];
+
+          // swapping hands our empty array back to the thread, so it doesn't need to allocate again
+          PL_LOCK(pEventBuffer->m_ContinuousCaptureMutex);
+          m_PendingCPUScopes[i].m_uiThreadId = pEventBuffer->m_uiThreadId;
+          m_PendingCPUScopes[i].m_Data.Swap(pEventBuffer->m_ContinuousCaptureData);
+        }
+      }
+
+      for (auto& eventBuffer : m_PendingCPUScopes)
+      {
+        if (eventBuffer.m_Data.IsEmpty())
+          continue;
+
+        // names have to be written before the record that references them
+        m_NameIndexScratch.Clear();
+        for (const auto& scope : eventBuffer.m_Data)
+        {
+          m_NameIndexScratch.PushBack(InternName(static_cast<const char*>(scope.m_szName)));
+          m_NameIndexScratch.PushBack(scope.m_szFunctionName != nullptr ? InternName(scope.m_szFunctionName) + 1 : 0);
+        }
+
+        WriteRecordType(ContinuousCaptureRecord::CPUScopes);
+        m_Stream << eventBuffer.m_uiThreadId;
+        WriteVarUInt(m_Stream, eventBuffer.m_Data.GetCount());
+
+        plInt64 iPrevBegin = 0;
+        for (plUInt32 i = 0; i < eventBuffer.m_Data.GetCount(); ++i)
+        {
+          const auto& scope = eventBuffer.m_Data[i];
+          const plInt64 iBegin = ToNanoseconds(scope.m_BeginTime);
+
+          WriteVarUInt(m_Stream, m_NameIndexScratch[i * 2 + 0]);
+          WriteVarUInt(m_Stream, m_NameIndexScratch[i * 2 + 1]);
+          WriteVarInt(m_Stream, iBegin - iPrevBegin);
+          WriteVarUInt(m_Stream, static_cast<plUInt64>(plMath::Max<plInt64>(ToNanoseconds(scope.m_EndTime) - iBegin, 0)));
+
+          iPrevBegin = iBegin;
+        }
+
+        eventBuffer.m_Data.Clear();
+      }
+    }
+
+    void WriteGPUScopesAndFrames()
+    {
+      plUInt64 uiFirstFrame = 0;
+
+      {
+        PL_LOCK(s_ContinuousCaptureMutex);
+
+        uiFirstFrame = s_uiContinuousCaptureFirstFrame;
+        m_PendingFrameStartTimes.Swap(s_ContinuousCaptureFrameStartTimes);
+
+        m_PendingGPUScopes.SetCount(s_ContinuousCaptureGPUScopes.GetCount());
+        for (plUInt32 i = 0; i < s_ContinuousCaptureGPUScopes.GetCount(); ++i)
+        {
+          m_PendingGPUScopes[i].Swap(s_ContinuousCaptureGPUScopes[i]);
+        }
+      }
+
+      for (plUInt32 uiGpuIndex = 0; uiGpuIndex < m_PendingGPUScopes.GetCount(); ++uiGpuIndex)
+      {
+        auto& gpuScopes = m_PendingGPUScopes[uiGpuIndex];
+        if (gpuScopes.IsEmpty())
+          continue;
+
+        m_NameIndexScratch.Clear();
+        for (const auto& scope : gpuScopes)
+        {
+          m_NameIndexScratch.PushBack(InternName(static_cast<const char*>(scope.m_szName)));
+        }
+
+        WriteRecordType(ContinuousCaptureRecord::GPUScopes);
+        WriteVarUInt(m_Stream, uiGpuIndex);
+        WriteVarUInt(m_Stream, gpuScopes.GetCount());
+
+        plInt64 iPrevBegin = 0;
+        for (plUInt32 i = 0; i < gpuScopes.GetCount(); ++i)
+        {
+          const plInt64 iBegin = ToNanoseconds(gpuScopes[i].m_BeginTime);
+
+          WriteVarUInt(m_Stream, m_NameIndexScratch[i]);
+          WriteVarInt(m_Stream, iBegin - iPrevBegin);
+          WriteVarUInt(m_Stream, static_cast<plUInt64>(plMath::Max<plInt64>(ToNanoseconds(gpuScopes[i].m_EndTime) - iBegin, 0)));
+
+          iPrevBegin = iBegin;
+        }
+
+        gpuScopes.Clear();
+      }
+
+      if (!m_PendingFrameStartTimes.IsEmpty())
+      {
+        WriteRecordType(ContinuousCaptureRecord::Frames);
+        WriteVarUInt(m_Stream, uiFirstFrame);
+        WriteVarUInt(m_Stream, m_PendingFrameStartTimes.GetCount());
+
+        plInt64 iPrevStart = 0;
+        for (plTime startTime : m_PendingFrameStartTimes)
+        {
+          const plInt64 iStart = ToNanoseconds(startTime);
+          WriteVarInt(m_Stream, iStart - iPrevStart);
+          iPrevStart = iStart;
+        }
+
+        m_PendingFrameStartTimes.Clear();
+      }
+    }
+
+    plAtomicBool m_bStop;
+    plMutex m_FlushMutex;
+    plOSFile m_File;
+    plMemoryStreamContainerStorage<plDynamicArray<plUInt8>> m_Storage; ///< Everything of one flush is encoded here first and then written at once
+    plMemoryStreamWriter m_Stream;
+    plUInt64 m_uiTotalDroppedScopes = 0;
+
+    plHashTable<plString, plUInt32> m_NameIndices;
+    plHashTable<plUInt64, plString> m_WrittenThreadNames;
+
+    plDynamicArray<plProfilingSystem::CPUScopesBufferFlat> m_PendingCPUScopes;
+    plDynamicArray<plDynamicArray<plProfilingSystem::GPUScope>> m_PendingGPUScopes;
+    plDynamicArray<plTime> m_PendingFrameStartTimes;
+    plDynamicArray<plUInt32> m_NameIndexScratch;
+  };
+
+  static plMutex s_ContinuousCaptureWriterMutex;
+  static ContinuousCaptureWriter* s_pContinuousCaptureWriter = nullptr;
+
+  void FlushContinuousCapture()
+  {
+    PL_LOCK(s_ContinuousCaptureWriterMutex);
+
+    if (s_pContinuousCaptureWriter != nullptr)
+    {
+      s_pContinuousCaptureWriter->Flush();
+    }
+  }
+
+  void AddToContinuousCapture(CpuScopesBufferBase* pScopes, const plProfilingSystem::CPUScope& scope)
+  {
+    PL_LOCK(pScopes->m_ContinuousCaptureMutex);
+
+    const plUInt32 uiCount = pScopes->m_ContinuousCaptureData.GetCount();
+    if (uiCount >= CONTINUOUS_CAPTURE_MAX_PENDING_SCOPES)
+    {
+      s_iContinuousCaptureDroppedScopes.Increment();
+      return;
+    }
+
+    pScopes->m_ContinuousCaptureData.PushBack(scope);
+
+    // wake up the writer early when a thread produces scopes faster than usual
+    if (uiCount + 1 == CONTINUOUS_CAPTURE_MAX_PENDING_SCOPES / 2)
+    {
+      s_ContinuousCaptureWakeUp.RaiseSignal();
+    }
+  }
+} // namespace
+
 void plProfilingSystem::ProfilingData::Clear()
 {
   m_uiFramesThreadID = 0;
@@ -570,6 +995,12 @@ void plProfilingSystem::Clear()
 // static
 void plProfilingSystem::Capture(plProfilingSystem::ProfilingData& ref_profilingData, bool bClearAfterCapture)
 {
+  // clearing removes the thread names, so the continuous capture has to pick them up first
+  if (bClearAfterCapture && s_bContinuousCaptureActive)
+  {
+    FlushContinuousCapture();
+  }
+
   ref_profilingData.Clear();
 
   ref_profilingData.m_uiFramesThreadID = 0;
@@ -680,7 +1111,20 @@ void plProfilingSystem::StartNewFrame()
     s_FrameStartTimes.PopFront();
   }
 
-  s_FrameStartTimes.PushBack(plTime::Now());
+  const plTime now = plTime::Now();
+  s_FrameStartTimes.PushBack(now);
+
+  if (s_bContinuousCaptureActive)
+  {
+    PL_LOCK(s_ContinuousCaptureMutex);
+
+    if (s_ContinuousCaptureFrameStartTimes.IsEmpty())
+    {
+      s_uiContinuousCaptureFirstFrame = s_uiFrameCount;
+    }
+
+    s_ContinuousCaptureFrameStartTimes.PushBack(now);
+  }
 }
 
 // static
@@ -741,6 +1185,11 @@ void plProfilingSystem::AddCPUScope(plStringView sName, const char* szFunctionNa
     pOtherThreadBuffer->m_Data.PushBack(scope);
   }
 
+  if (s_bContinuousCaptureActive)
+  {
+    AddToContinuousCapture(pScopes, scope);
+  }
+
   if (scopeTimeout.IsPositive() && duration > scopeTimeout && s_ScopeTimeoutCallback.IsValid())
   {
     s_ScopeTimeoutCallback(sName, szFunctionName, duration);
@@ -758,11 +1207,27 @@ void plProfilingSystem::Initialize()
 // static
 void plProfilingSystem::Reset()
 {
+  plHybridArray<plUInt64, 16> deadThreadIDs;
+  {
+    PL_LOCK(s_ThreadInfosMutex);
+    deadThreadIDs.Swap(s_DeadThreadIDs);
+  }
+
+  if (deadThreadIDs.IsEmpty())
+    return;
+
+  // These threads can't record scopes anymore, so flushing now writes their last scopes and names into the capture before they are deleted.
+  // Threads that die in the meantime are only cleaned up by the next call.
+  if (s_bContinuousCaptureActive)
+  {
+    FlushContinuousCapture();
+  }
+
   PL_LOCK(s_ThreadInfosMutex);
   PL_LOCK(s_AllCpuScopesMutex);
-  for (plUInt32 i = 0; i < s_DeadThreadIDs.GetCount(); i++)
+  for (plUInt32 i = 0; i < deadThreadIDs.GetCount(); i++)
   {
-    plUInt64 uiThreadId = s_DeadThreadIDs[i];
+    plUInt64 uiThreadId = deadThreadIDs[i];
     for (plUInt32 k = 0; k < s_ThreadInfos.GetCount(); k++)
     {
       if (s_ThreadInfos[k].m_uiThreadId == uiThreadId)
@@ -785,7 +1250,6 @@ void plProfilingSystem::Reset()
       }
     }
   }
-  s_DeadThreadIDs.Clear();
 }
 
 // static
@@ -842,6 +1306,286 @@ void plProfilingSystem::AddGPUScope(plStringView sName, plTime beginTime, plTime
   plStringUtils::Copy(scope.m_szName, PL_ARRAY_SIZE(scope.m_szName), sName.GetStartPointer(), sName.GetEndPointer());
 
   s_GPUScopes[uiGpuIndex]->PushBack(scope);
+
+  if (s_bContinuousCaptureActive)
+  {
+    PL_LOCK(s_ContinuousCaptureMutex);
+
+    if (s_ContinuousCaptureGPUScopes.GetCount() <= uiGpuIndex)
+    {
+      s_ContinuousCaptureGPUScopes.SetCount(uiGpuIndex + 1);
+    }
+
+    auto& gpuScopes = s_ContinuousCaptureGPUScopes[uiGpuIndex];
+    if (gpuScopes.GetCount() < CONTINUOUS_CAPTURE_MAX_PENDING_SCOPES)
+    {
+      gpuScopes.PushBack(scope);
+    }
+    else
+    {
+      s_iContinuousCaptureDroppedScopes.Increment();
+    }
+  }
+}
+
+// static
+plResult plProfilingSystem::StartContinuousCapture(plStringView sFile)
+{
+  PL_LOCK(s_ContinuousCaptureWriterMutex);
+
+  if (s_pContinuousCaptureWriter != nullptr)
+  {
+    plLog::Error("A continuous profiling capture is already running.");
+    return PL_FAILURE;
+  }
+
+  ContinuousCaptureWriter* pWriter = PL_DEFAULT_NEW(ContinuousCaptureWriter);
+  if (pWriter->Open(sFile).Failed())
+  {
+    plLog::Error("Failed to open '{}' for writing the profiling capture.", sFile);
+    PL_DEFAULT_DELETE(pWriter);
+    return PL_FAILURE;
+  }
+
+  // throw away anything that was added after the previous capture was stopped
+  {
+    PL_LOCK(s_AllCpuScopesMutex);
+    for (auto pEventBuffer : s_AllCpuScopes)
+    {
+      PL_LOCK(pEventBuffer->m_ContinuousCaptureMutex);
+      pEventBuffer->m_ContinuousCaptureData.Clear();
+    }
+  }
+  {
+    PL_LOCK(s_ContinuousCaptureMutex);
+    s_ContinuousCaptureFrameStartTimes.Clear();
+    for (auto& gpuScopes : s_ContinuousCaptureGPUScopes)
+    {
+      gpuScopes.Clear();
+    }
+  }
+  s_iContinuousCaptureDroppedScopes = 0;
+
+  s_pContinuousCaptureWriter = pWriter;
+  s_bContinuousCaptureActive = true;
+  pWriter->Start();
+
+  return PL_SUCCESS;
+}
+
+// static
+void plProfilingSystem::StopContinuousCapture()
+{
+  PL_LOCK(s_ContinuousCaptureWriterMutex);
+
+  if (s_pContinuousCaptureWriter == nullptr)
+    return;
+
+  s_bContinuousCaptureActive = false;
+
+  s_pContinuousCaptureWriter->RequestStop();
+  s_pContinuousCaptureWriter->Join();
+
+  if (s_pContinuousCaptureWriter->GetTotalDroppedScopes() > 0)
+  {
+    plLog::Warning("{} profiling scopes were dropped during the continuous capture, because the writer couldn't keep up.", s_pContinuousCaptureWriter->GetTotalDroppedScopes());
+  }
+
+  PL_DEFAULT_DELETE(s_pContinuousCaptureWriter);
+}
+
+// static
+bool plProfilingSystem::IsContinuousCaptureActive()
+{
+  return s_bContinuousCaptureActive;
+}
+
+// static
+plResult plProfilingSystem::ConvertContinuousCaptureToJSON(plStreamReader& ref_inputStream, plStreamWriter& ref_outputStream)
+{
+  plUInt32 uiMagic = 0;
+  plUInt8 uiVersion = 0;
+  plUInt32 uiProcessID = 0;
+  ref_inputStream >> uiMagic;
+  ref_inputStream >> uiVersion;
+  ref_inputStream >> uiProcessID;
+
+  if (uiMagic != CONTINUOUS_CAPTURE_MAGIC || uiVersion == 0 || uiVersion > CONTINUOUS_CAPTURE_VERSION)
+  {
+    plLog::Error("Input is not a supported continuous profiling capture.");
+    return PL_FAILURE;
+  }
+
+  ProfilingData data;
+  data.m_uiProcessID = uiProcessID;
+
+  // a deque, since the function names of the scopes point into it
+  plDeque<plString> names;
+  plHashTable<plUInt64, plUInt32> threadIdToEventBuffer;
+  plUInt64 uiDroppedScopes = 0;
+
+  auto ReadRecord = [&](plUInt8 uiType) -> plResult {
+    switch (uiType)
+    {
+      case ContinuousCaptureRecord::String:
+      {
+        PL_SUCCEED_OR_RETURN(ref_inputStream.ReadString(names.ExpandAndGetRef()));
+        return PL_SUCCESS;
+      }
+
+      case ContinuousCaptureRecord::Thread:
+      {
+        ThreadInfo& threadInfo = data.m_ThreadInfos.ExpandAndGetRef();
+        ref_inputStream >> threadInfo.m_uiThreadId;
+        return ref_inputStream.ReadString(threadInfo.m_sName);
+      }
+
+      case ContinuousCaptureRecord::CPUScopes:
+      {
+        plUInt64 uiThreadId = 0;
+        plUInt64 uiCount = 0;
+        ref_inputStream >> uiThreadId;
+        PL_SUCCEED_OR_RETURN(ReadVarUInt(ref_inputStream, uiCount));
+
+        plUInt32 uiEventBuffer = 0;
+        if (!threadIdToEventBuffer.TryGetValue(uiThreadId, uiEventBuffer))
+        {
+          uiEventBuffer = data.m_AllEventBuffers.GetCount();
+          data.m_AllEventBuffers.ExpandAndGetRef().m_uiThreadId = uiThreadId;
+          threadIdToEventBuffer.Insert(uiThreadId, uiEventBuffer);
+        }
+
+        auto& events = data.m_AllEventBuffers[uiEventBuffer].m_Data;
+
+        plInt64 iBegin = 0;
+        for (plUInt64 i = 0; i < uiCount; ++i)
+        {
+          plUInt64 uiNameIndex = 0;
+          plUInt64 uiFunctionNameIndex = 0;
+          plInt64 iBeginDelta = 0;
+          plUInt64 uiDuration = 0;
+          PL_SUCCEED_OR_RETURN(ReadVarUInt(ref_inputStream, uiNameIndex));
+          PL_SUCCEED_OR_RETURN(ReadVarUInt(ref_inputStream, uiFunctionNameIndex));
+          PL_SUCCEED_OR_RETURN(ReadVarInt(ref_inputStream, iBeginDelta));
+          PL_SUCCEED_OR_RETURN(ReadVarUInt(ref_inputStream, uiDuration));
+
+          if (uiNameIndex >= names.GetCount() || uiFunctionNameIndex > names.GetCount())
+            return PL_FAILURE;
+
+          iBegin += iBeginDelta;
+
+          CPUScope& scope = events.ExpandAndGetRef();
+          scope.m_szFunctionName = uiFunctionNameIndex > 0 ? names[static_cast<plUInt32>(uiFunctionNameIndex - 1)].GetData() : nullptr;
+          scope.m_BeginTime = plTime::MakeFromNanoseconds(static_cast<double>(iBegin));
+          scope.m_EndTime = plTime::MakeFromNanoseconds(static_cast<double>(iBegin + static_cast<plInt64>(uiDuration)));
+          plStringUtils::Copy(scope.m_szName, CPUScope::NAME_SIZE, names[static_cast<plUInt32>(uiNameIndex)].GetData());
+        }
+
+        return PL_SUCCESS;
+      }
+
+      case ContinuousCaptureRecord::GPUScopes:
+      {
+        plUInt64 uiGpuIndex = 0;
+        plUInt64 uiCount = 0;
+        PL_SUCCEED_OR_RETURN(ReadVarUInt(ref_inputStream, uiGpuIndex));
+        PL_SUCCEED_OR_RETURN(ReadVarUInt(ref_inputStream, uiCount));
+
+        if (uiGpuIndex >= 256)
+          return PL_FAILURE;
+
+        if (data.m_GPUScopes.GetCount() <= uiGpuIndex)
+        {
+          data.m_GPUScopes.SetCount(static_cast<plUInt32>(uiGpuIndex) + 1);
+        }
+
+        auto& events = data.m_GPUScopes[static_cast<plUInt32>(uiGpuIndex)];
+
+        plInt64 iBegin = 0;
+        for (plUInt64 i = 0; i < uiCount; ++i)
+        {
+          plUInt64 uiNameIndex = 0;
+          plInt64 iBeginDelta = 0;
+          plUInt64 uiDuration = 0;
+          PL_SUCCEED_OR_RETURN(ReadVarUInt(ref_inputStream, uiNameIndex));
+          PL_SUCCEED_OR_RETURN(ReadVarInt(ref_inputStream, iBeginDelta));
+          PL_SUCCEED_OR_RETURN(ReadVarUInt(ref_inputStream, uiDuration));
+
+          if (uiNameIndex >= names.GetCount())
+            return PL_FAILURE;
+
+          iBegin += iBeginDelta;
+
+          GPUScope& scope = events.ExpandAndGetRef();
+          scope.m_BeginTime = plTime::MakeFromNanoseconds(static_cast<double>(iBegin));
+          scope.m_EndTime = plTime::MakeFromNanoseconds(static_cast<double>(iBegin + static_cast<plInt64>(uiDuration)));
+          plStringUtils::Copy(scope.m_szName, GPUScope::NAME_SIZE, names[static_cast<plUInt32>(uiNameIndex)].GetData());
+        }
+
+        return PL_SUCCESS;
+      }
+
+      case ContinuousCaptureRecord::Frames:
+      {
+        plUInt64 uiFirstFrame = 0;
+        plUInt64 uiCount = 0;
+        PL_SUCCEED_OR_RETURN(ReadVarUInt(ref_inputStream, uiFirstFrame));
+        PL_SUCCEED_OR_RETURN(ReadVarUInt(ref_inputStream, uiCount));
+
+        plInt64 iStart = 0;
+        for (plUInt64 i = 0; i < uiCount; ++i)
+        {
+          plInt64 iStartDelta = 0;
+          PL_SUCCEED_OR_RETURN(ReadVarInt(ref_inputStream, iStartDelta));
+
+          iStart += iStartDelta;
+          data.m_FrameStartTimes.PushBack(plTime::MakeFromNanoseconds(static_cast<double>(iStart)));
+          data.m_uiFrameCount = uiFirstFrame + i;
+        }
+
+        return PL_SUCCESS;
+      }
+
+      case ContinuousCaptureRecord::DroppedScopes:
+      {
+        plUInt64 uiCount = 0;
+        PL_SUCCEED_OR_RETURN(ReadVarUInt(ref_inputStream, uiCount));
+
+        uiDroppedScopes += uiCount;
+        return PL_SUCCESS;
+      }
+
+      default:
+        return PL_FAILURE;
+    }
+  };
+
+  bool bComplete = false;
+
+  plUInt8 uiType = 0;
+  while (ref_inputStream.ReadBytes(&uiType, 1) == 1)
+  {
+    if (uiType == ContinuousCaptureRecord::End)
+    {
+      bComplete = true;
+      break;
+    }
+
+    if (ReadRecord(uiType).Failed())
+      break;
+  }
+
+  if (!bComplete)
+  {
+    plLog::Warning("The profiling capture is incomplete, it was probably not stopped properly.");
+  }
+
+  if (uiDroppedScopes > 0)
+  {
+    plLog::Warning("{} profiling scopes were dropped during the capture.", uiDroppedScopes);
+  }
+
+  return data.Write(ref_outputStream);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -924,6 +1668,23 @@ void plProfilingSystem::InitializeGPUData(plUInt32 gpuCount) {}
 
 void plProfilingSystem::AddGPUScope(plStringView sName, plTime beginTime, plTime endTime, plUInt32 gpuIndex) {}
 
+plResult plProfilingSystem::StartContinuousCapture(plStringView sFile)
+{
+  return PL_FAILURE;
+}
+
+void plProfilingSystem::StopContinuousCapture() {}
+
+bool plProfilingSystem::IsContinuousCaptureActive()
+{
+  return false;
+}
+
+plResult plProfilingSystem::ConvertContinuousCaptureToJSON(plStreamReader& inputStream, plStreamWriter& outputStream)
+{
+  return PL_FAILURE;
+}
+
 void plProfilingSystem::ProfilingData::Merge(ProfilingData& out_Merged, plArrayPtr<const ProfilingData*> inputs) {}
 
 #endif
@@ -23,6 +23,7 @@
 #endif
 #include <Foundation/Time/Time.h>
 
+class plStreamReader;
 class plStreamWriter;
 class plThread;
 
@@ -158,6 +159,29 @@ public:
   /// \brief Get current frame counter
   static plUInt64 GetFrameCount();
 
+  /// \brief Starts recording all CPU scopes, GPU scopes and frame times into the given file until StopContinuousCapture() is called.
+  ///
+  /// Capture() only returns what is still stored in the fixed size ring buffers, so it can't be used to profile long sessions.
+  /// A continuous capture instead hands the scopes of every thread to a background thread, which writes them to the file in a compact
+  /// binary format with interned scope names and delta encoded timestamps. Memory usage stays bounded: if the writer can't keep up,
+  /// scopes of threads that already have too many scopes queued are dropped and a warning is logged when the capture is stopped.
+  ///
+  /// Use ConvertContinuousCaptureToJSON() to turn the file into the JSON format of ProfilingData::Write().
+  ///
+  /// \param sFile Either an absolute path or a path that plFileSystem can resolve, e.g. ":appdata/Profiling/Capture.plprof".
+  static plResult StartContinuousCapture(plStringView sFile);
+
+  /// \brief Writes all pending data of the continuous capture and closes the file.
+  static void StopContinuousCapture();
+
+  /// \brief Returns whether a continuous capture is currently running.
+  static bool IsContinuousCaptureActive();
+
+  /// \brief Reads a file written by a continuous capture and writes its content as JSON, see ProfilingData::Write().
+  ///
+  /// Files of captures that were never stopped, e.g. because the application crashed, are converted up to the point where they end.
+  static plResult ConvertContinuousCaptureToJSON(plStreamReader& ref_inputStream, plStreamWriter& ref_outputStream);
+
 private:
   PL_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, ProfilingSystem);
   friend plUInt32 RunThread(plThread* pThread);
@@ -84,6 +84,7 @@ struct plCpuFeatures
 
   bool IsAvx1Available() const { return OS_AVX && HW_AVX; }
   bool IsAvx2Available() const { return OS_AVX && HW_AVX2; }
+  bool IsAvx512Available() const { return OS_AVX512 && HW_AVX512_F; }
 #endif
 
   void Detect();
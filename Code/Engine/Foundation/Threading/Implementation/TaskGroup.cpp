@@ -28,6 +28,7 @@ void plTaskGroup::Reuse(plTaskPriority::Enum priority, plOnTaskGroupFinishedCall
   m_Tasks.Clear();
   m_DependsOnGroups.Clear();
   m_OthersDependingOnMe.Clear();
+  m_iScheduleState = ScheduleState::NotScheduled;
   m_Priority = priority;
   m_OnFinishedCallback = callback;
 }
@@ -27,6 +27,16 @@ private:
   void WaitForFinish(plTaskGroupID group) const;
   void Reuse(plTaskPriority::Enum priority, plOnTaskGroupFinishedCallback callback);
 
+  struct ScheduleState
+  {
+    enum Enum
+    {
+      NotScheduled,
+      Canceling,
+      Scheduled,
+    };
+  };
+
   bool m_bInUse = true;
   bool m_bStartedByUser = false;
   plUInt16 m_uiTaskGroupIndex = 0xFFFF; // only there as a debugging aid
@@ -36,6 +46,7 @@ private:
   plHybridArray<plTaskGroupID, 8> m_OthersDependingOnMe;
   plAtomicInteger32 m_iNumActiveDependencies;
   plAtomicInteger32 m_iNumRemainingTasks;
+  plAtomicInteger32 m_iScheduleState; ///< ScheduleState, keeps CancelTask() from modifying m_Tasks while the group gets scheduled
   plOnTaskGroupFinishedCallback m_OnFinishedCallback;
   plTaskPriority::Enum m_Priority = plTaskPriority::ThisFrame;
   mutable plConditionVariable m_CondVarGroupFinished;
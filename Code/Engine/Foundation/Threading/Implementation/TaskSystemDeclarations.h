@@ -10,6 +10,7 @@
 class plTask;
 class plTaskGroup;
 class plTaskWorkerThread;
+class plTaskWorkerDeque;
 class plTaskSystemState;
 class plTaskSystemThreadState;
 class plDGMLGraph;
@@ -82,6 +83,21 @@ struct plOnTaskRunning
   };
 };
 
+/// \brief Selects how the plTaskSystem distributes scheduled tasks among its worker threads.
+///
+/// \see plTaskSystem::SetSchedulingMode()
+struct plTaskSchedulingMode
+{
+  enum Enum : plUInt8
+  {
+    GlobalQueue,  ///< All scheduled tasks are stored in one list per priority, which all threads access through a single mutex.
+    WorkStealing, ///< Every worker thread owns a lock-free deque per priority that it executes. Workers that run out of work steal tasks
+                  ///< from the deques of other workers. Scales better when many small tasks are scheduled from within tasks.
+
+    Default = GlobalQueue
+  };
+};
+
 /// \internal Enum that lists the different task worker thread types.
 struct plWorkerThreadType
 {
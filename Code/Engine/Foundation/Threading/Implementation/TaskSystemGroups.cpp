@@ -80,50 +80,76 @@ void plTaskSystem::StartTaskGroup(plTaskGroupID groupID)
 
   plTaskGroup::DebugCheckTaskGroup(groupID, s_TaskSystemMutex);
 
-  plInt32 iActiveDependencies = 0;
+  bool bCanBeScheduled = false;
 
   {
     PL_LOCK(s_TaskSystemMutex);
+    bCanBeScheduled = RegisterWithDependencies(groupID);
+  }
 
-    plTaskGroup& tg = *groupID.m_pTaskGroup;
-
-    tg.m_bStartedByUser = true;
+  // scheduling only needs the mutex of the task list, so it is done after the dependency bookkeeping
+  if (bCanBeScheduled)
+  {
+    ScheduleGroupTasks(groupID.m_pTaskGroup, false);
+  }
+}
 
-    for (plUInt32 i = 0; i < tg.m_DependsOnGroups.GetCount(); ++i)
-    {
-      if (!IsTaskGroupFinished(tg.m_DependsOnGroups[i]))
-      {
-        plTaskGroup& Dependency = *tg.m_DependsOnGroups[i].m_pTaskGroup;
+void plTaskSystem::StartTaskGroupBatch(plArrayPtr<const plTaskGroupID> batch)
+{
+  PL_ASSERT_DEV(s_pThreadState->m_Workers[plWorkerThreadType::ShortTasks].GetCount() > 0, "No worker threads started.");
 
-        // add this task group to the list of dependencies, such that when that group finishes, this task group can get woken up
-        Dependency.m_OthersDependingOnMe.PushBack(groupID);
+  plHybridArray<plTaskGroup*, 32> groupsToSchedule;
 
-        // count how many other groups need to finish before this task group can be executed
-        ++iActiveDependencies;
-      }
-    }
+  {
+    // lock once for the dependency bookkeeping of the whole batch
+    PL_LOCK(s_TaskSystemMutex);
 
-    if (iActiveDependencies != 0)
+    for (const plTaskGroupID& group : batch)
     {
-      // atomic integers are quite slow, so do not use them in the loop, where they are not yet needed
-      tg.m_iNumActiveDependencies = iActiveDependencies;
+      plTaskGroup::DebugCheckTaskGroup(group, s_TaskSystemMutex);
+
+      if (RegisterWithDependencies(group))
+      {
+        groupsToSchedule.PushBack(group.m_pTaskGroup);
+      }
     }
   }
 
-  if (iActiveDependencies == 0)
+  for (plTaskGroup* pGroup : groupsToSchedule)
   {
-    ScheduleGroupTasks(groupID.m_pTaskGroup, false);
+    ScheduleGroupTasks(pGroup, false);
   }
 }
 
-void plTaskSystem::StartTaskGroupBatch(plArrayPtr<const plTaskGroupID> batch)
+bool plTaskSystem::RegisterWithDependencies(plTaskGroupID groupID)
 {
-  PL_LOCK(s_TaskSystemMutex);
+  plTaskGroup& tg = *groupID.m_pTaskGroup;
+
+  tg.m_bStartedByUser = true;
+
+  plInt32 iActiveDependencies = 0;
+
+  for (plUInt32 i = 0; i < tg.m_DependsOnGroups.GetCount(); ++i)
+  {
+    if (!IsTaskGroupFinished(tg.m_DependsOnGroups[i]))
+    {
+      plTaskGroup& Dependency = *tg.m_DependsOnGroups[i].m_pTaskGroup;
 
-  for (const plTaskGroupID& group : batch)
+      // add this task group to the list of dependencies, such that when that group finishes, this task group can get woken up
+      Dependency.m_OthersDependingOnMe.PushBack(groupID);
+
+      // count how many other groups need to finish before this task group can be executed
+      ++iActiveDependencies;
+    }
+  }
+
+  if (iActiveDependencies != 0)
   {
-    StartTaskGroup(group);
+    // atomic integers are quite slow, so do not use them in the loop, where they are not yet needed
+    tg.m_iNumActiveDependencies = iActiveDependencies;
   }
+
+  return iActiveDependencies == 0;
 }
 
 bool plTaskSystem::IsTaskGroupFinished(plTaskGroupID group)
@@ -134,6 +160,12 @@ bool plTaskSystem::IsTaskGroupFinished(plTaskGroupID group)
 
 void plTaskSystem::ScheduleGroupTasks(plTaskGroup* pGroup, bool bHighPriority)
 {
+  // CancelTask() may currently remove a task from this group, which is the only modification of a group that can race with scheduling it
+  while (!pGroup->m_iScheduleState.TestAndSet(plTaskGroup::ScheduleState::NotScheduled, plTaskGroup::ScheduleState::Scheduled))
+  {
+    plThreadUtils::YieldTimeSlice();
+  }
+
   if (pGroup->m_Tasks.IsEmpty())
   {
     pGroup->m_iNumRemainingTasks = 1;
@@ -143,85 +175,118 @@ void plTaskSystem::ScheduleGroupTasks(plTaskGroup* pGroup, bool bHighPriority)
     return;
   }
 
+  const plTaskPriority::Enum priority = pGroup->m_Priority;
+
+  // store how many tasks from this groups still need to be processed
   plInt32 iRemainingTasks = 0;
 
-  // add all the tasks to the task list, so that they will be processed
+  for (auto pTask : pGroup->m_Tasks)
   {
-    PL_LOCK(s_TaskSystemMutex);
-
+    iRemainingTasks += plMath::Max(1u, pTask->m_uiMultiplicity);
+    pTask->m_iRemainingRuns = plMath::Max(1u, pTask->m_uiMultiplicity);
+  }
 
-    // store how many tasks from this groups still need to be processed
+  pGroup->m_iNumRemainingTasks = iRemainingTasks;
 
-    for (auto pTask : pGroup->m_Tasks)
-    {
-      iRemainingTasks += plMath::Max(1u, pTask->m_uiMultiplicity);
-      pTask->m_iRemainingRuns = plMath::Max(1u, pTask->m_uiMultiplicity);
-    }
+  // in work-stealing mode, worker threads queue the tasks in their own deque, from where the other workers steal them
+  plTaskWorkerDeque* pDeque = nullptr;
+  if (s_pState->m_SchedulingMode == plTaskSchedulingMode::WorkStealing && tl_TaskWorkerInfo.m_pWorkerThread != nullptr)
+  {
+    pDeque = tl_TaskWorkerInfo.m_pWorkerThread->GetDeque(priority);
+  }
 
-    pGroup->m_iNumRemainingTasks = iRemainingTasks;
+  // all tasks that don't fit into a deque are added to the global list at once, so its mutex is locked only once per group
+  plHybridArray<TaskData, 16> globalTasks;
 
+  for (plUInt32 task = 0; task < pGroup->m_Tasks.GetCount(); ++task)
+  {
+    auto& pTask = pGroup->m_Tasks[task];
+    pTask->m_bTaskIsScheduled = true;
 
-    for (plUInt32 task = 0; task < pGroup->m_Tasks.GetCount(); ++task)
+    for (plUInt32 mult = 0; mult < plMath::Max(1u, pTask->m_uiMultiplicity); ++mult)
     {
-      auto& pTask = pGroup->m_Tasks[task];
-
-      for (plUInt32 mult = 0; mult < plMath::Max(1u, pTask->m_uiMultiplicity); ++mult)
+      if (pDeque != nullptr)
       {
-        TaskData td;
-        td.m_pBelongsToGroup = pGroup;
-        td.m_pTask = pTask;
-        td.m_pTask->m_bTaskIsScheduled = true;
-        td.m_uiInvocation = mult;
-
-        if (bHighPriority)
-          s_pState->m_Tasks[pGroup->m_Priority].PushFront(td);
-        else
-          s_pState->m_Tasks[pGroup->m_Priority].PushBack(td);
+        plTaskWorkerDeque::Entry entry;
+        entry.m_pGroup = pGroup;
+        entry.m_uiTaskIndex = task;
+        entry.m_uiInvocation = mult;
+        entry.m_bNeverWaits = pTask->m_NestingMode == plTaskNesting::Never;
+
+        // the counter has to be incremented after the task is visible, see GetNextTask()
+        if (pDeque->Push(entry))
+        {
+          s_pState->m_iNumQueuedTasks[priority].Increment();
+          continue;
+        }
+
+        // the deque is full, use the global list instead
       }
+
+      TaskData& td = globalTasks.ExpandAndGetRef();
+      td.m_pBelongsToGroup = pGroup;
+      td.m_pTask = pTask;
+      td.m_uiInvocation = mult;
     }
+  }
 
-    // send the proper thread signal, to make sure one of the correct worker threads is awake
-    switch (pGroup->m_Priority)
+  if (!globalTasks.IsEmpty())
+  {
+    PL_LOCK(s_pState->m_TasksMutex[priority]);
+
+    for (const TaskData& td : globalTasks)
     {
-      case plTaskPriority::EarlyThisFrame:
-      case plTaskPriority::ThisFrame:
-      case plTaskPriority::LateThisFrame:
-      case plTaskPriority::EarlyNextFrame:
-      case plTaskPriority::NextFrame:
-      case plTaskPriority::LateNextFrame:
-      case plTaskPriority::In2Frames:
-      case plTaskPriority::In3Frames:
-      case plTaskPriority::In4Frames:
-      case plTaskPriority::In5Frames:
-      case plTaskPriority::In6Frames:
-      case plTaskPriority::In7Frames:
-      case plTaskPriority::In8Frames:
-      case plTaskPriority::In9Frames:
-      {
-        WakeUpThreads(plWorkerThreadType::ShortTasks, iRemainingTasks);
-        break;
-      }
+      if (bHighPriority)
+        s_pState->m_Tasks[priority].PushFront(td);
+      else
+        s_pState->m_Tasks[priority].PushBack(td);
+    }
 
-      case plTaskPriority::LongRunning:
-      case plTaskPriority::LongRunningHighPriority:
-      {
-        WakeUpThreads(plWorkerThreadType::LongTasks, iRemainingTasks);
-        break;
-      }
+    s_pState->m_iNumGlobalTasks[priority].Add(globalTasks.GetCount());
+    s_pState->m_iNumQueuedTasks[priority].Add(globalTasks.GetCount());
+  }
 
-      case plTaskPriority::FileAccess:
-      case plTaskPriority::FileAccessHighPriority:
-      {
-        WakeUpThreads(plWorkerThreadType::FileAccess, iRemainingTasks);
-        break;
-      }
+  // send the proper thread signal, to make sure one of the correct worker threads is awake
+  switch (priority)
+  {
+    case plTaskPriority::EarlyThisFrame:
+    case plTaskPriority::ThisFrame:
+    case plTaskPriority::LateThisFrame:
+    case plTaskPriority::EarlyNextFrame:
+    case plTaskPriority::NextFrame:
+    case plTaskPriority::LateNextFrame:
+    case plTaskPriority::In2Frames:
+    case plTaskPriority::In3Frames:
+    case plTaskPriority::In4Frames:
+    case plTaskPriority::In5Frames:
+    case plTaskPriority::In6Frames:
+    case plTaskPriority::In7Frames:
+    case plTaskPriority::In8Frames:
+    case plTaskPriority::In9Frames:
+    {
+      WakeUpThreads(plWorkerThreadType::ShortTasks, iRemainingTasks);
+      break;
+    }
 
-      case plTaskPriority::SomeFrameMainThread:
-      case plTaskPriority::ThisFrameMainThread:
-      case plTaskPriority::ENUM_COUNT:
-        // nothing to do for these enum values
-        break;
+    case plTaskPriority::LongRunning:
+    case plTaskPriority::LongRunningHighPriority:
+    {
+      WakeUpThreads(plWorkerThreadType::LongTasks, iRemainingTasks);
+      break;
     }
+
+    case plTaskPriority::FileAccess:
+    case plTaskPriority::FileAccessHighPriority:
+    {
+      WakeUpThreads(plWorkerThreadType::FileAccess, iRemainingTasks);
+      break;
+    }
+
+    case plTaskPriority::SomeFrameMainThread:
+    case plTaskPriority::ThisFrameMainThread:
+    case plTaskPriority::ENUM_COUNT:
+      // nothing to do for these enum values
+      break;
   }
 }
 
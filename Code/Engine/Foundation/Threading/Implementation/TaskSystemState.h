@@ -30,5 +30,19 @@ private:
   plDeque<plTaskGroup> m_TaskGroups;
 
   // The lists of all scheduled tasks, for each priority.
+  // In plTaskSchedulingMode::WorkStealing this only holds the tasks that could not be put into a worker deque.
   plList<plTaskSystem::TaskData> m_Tasks[plTaskPriority::ENUM_COUNT];
+
+  // Protects m_Tasks of the same priority. When two of these are locked, the one with the lower index has to be locked first.
+  // None of them may be held while locking s_TaskSystemMutex.
+  plMutex m_TasksMutex[plTaskPriority::ENUM_COUNT];
+
+  // How tasks are distributed among the worker threads. Only changes while no worker threads are running.
+  plTaskSchedulingMode::Enum m_SchedulingMode = plTaskSchedulingMode::Default;
+
+  // The number of tasks in m_Tasks for each priority, so that workers can skip empty lists without taking the mutex.
+  plAtomicInteger32 m_iNumGlobalTasks[plTaskPriority::ENUM_COUNT];
+
+  // The number of tasks that are queued anywhere (m_Tasks and all worker deques), for each priority.
+  plAtomicInteger32 m_iNumQueuedTasks[plTaskPriority::ENUM_COUNT];
 };
@@ -58,16 +58,22 @@ void plTaskSystem::TaskHasFinished(plSharedPtr<plTask>&& pTask, plTaskGroup* pGr
       pGroup->m_uiGroupCounter += 2;
     }
 
+    plHybridArray<plTaskGroupID, 8> othersDependingOnMe;
+
     {
       PL_LOCK(s_TaskSystemMutex);
 
       // unless an outside reference is held onto a task, this will deallocate the tasks
       pGroup->m_Tasks.Clear();
 
-      for (plUInt32 dep = 0; dep < pGroup->m_OthersDependingOnMe.GetCount(); ++dep)
-      {
-        DependencyHasFinished(pGroup->m_OthersDependingOnMe[dep].m_pTaskGroup);
-      }
+      // the group counter has already been incremented, so no further dependencies can be added to this group
+      othersDependingOnMe.Swap(pGroup->m_OthersDependingOnMe);
+    }
+
+    // scheduling the dependent groups only needs the mutex of their task lists
+    for (plUInt32 dep = 0; dep < othersDependingOnMe.GetCount(); ++dep)
+    {
+      DependencyHasFinished(othersDependingOnMe[dep].m_pTaskGroup);
     }
 
     // wake up all threads that are waiting for this group
@@ -94,29 +100,205 @@ plTaskSystem::TaskData plTaskSystem::GetNextTask(plTaskPriority::Enum FirstPrior
   PL_ASSERT_DEV(FirstPriority >= plTaskPriority::EarlyThisFrame && LastPriority < plTaskPriority::ENUM_COUNT, "Priority Range is invalid: {0} to {1}",
     FirstPriority, LastPriority);
 
-  PL_LOCK(s_TaskSystemMutex);
+  // only worker threads in plTaskSchedulingMode::WorkStealing own deques, for everyone else this only looks at the global lists
+  plTaskWorkerThread* pOwnWorker = s_pState->m_SchedulingMode == plTaskSchedulingMode::WorkStealing ? tl_TaskWorkerInfo.m_pWorkerThread : nullptr;
+  const plTaskGroup* pWaitingForGroup = WaitingForGroup.m_pTaskGroup;
 
-  // go through all the task lists that this thread is willing to work on
-  for (plUInt32 prio = FirstPriority; prio <= (plUInt32)LastPriority; ++prio)
+  auto filter = [=](const plTaskWorkerDeque::Entry& entry)
+  {
+    return !bOnlyTasksThatNeverWait || entry.m_bNeverWaits || entry.m_pGroup == pWaitingForGroup;
+  };
+
+  TaskData td;
+
+  while (true)
   {
-    for (auto it = s_pState->m_Tasks[prio].GetIterator(); it.IsValid(); ++it)
+    for (plUInt32 prio = FirstPriority; prio <= (plUInt32)LastPriority; ++prio)
     {
-      if (!bOnlyTasksThatNeverWait || (it->m_pTask->m_NestingMode == plTaskNesting::Never) || it->m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup)
+      // skip priorities without any work, without touching any of the queues
+      if (s_pState->m_iNumQueuedTasks[prio] <= 0)
+        continue;
+
+      // prefer the tasks that this thread queued itself, their data is most likely still in the cache
+      if (pOwnWorker != nullptr)
+      {
+        plTaskWorkerDeque::Entry entry;
+        plTaskWorkerDeque* pDeque = pOwnWorker->GetDeque((plTaskPriority::Enum)prio);
+
+        if (pDeque != nullptr && pDeque->Pop(entry, filter))
+        {
+          // the group holds a reference to the task until all its tasks are finished
+          td.m_pTask = entry.m_pGroup->m_Tasks[entry.m_uiTaskIndex];
+          td.m_pBelongsToGroup = entry.m_pGroup;
+          td.m_uiInvocation = entry.m_uiInvocation;
+
+          s_pState->m_iNumQueuedTasks[prio].Decrement();
+          return td;
+        }
+
+        if (bOnlyTasksThatNeverWait && pDeque != nullptr && !pDeque->IsEmpty())
+        {
+          // The bottom entry was filtered out, but tasks of the group that we wait for may still sit below it, where only we can reach them.
+          // Move everything into the global lists, where any entry can be taken.
+          PL_LOCK(s_pState->m_TasksMutex[prio]);
+
+          MoveDequeToGlobalQueue(pDeque, (plTaskPriority::Enum)prio);
+
+          if (TakeTaskFromGlobalQueue(prio, bOnlyTasksThatNeverWait, WaitingForGroup, td))
+            return td;
+        }
+      }
+
+      if (s_pState->m_iNumGlobalTasks[prio] > 0)
       {
-        TaskData td = *it;
+        PL_LOCK(s_pState->m_TasksMutex[prio]);
+
+        if (TakeTaskFromGlobalQueue(prio, bOnlyTasksThatNeverWait, WaitingForGroup, td))
+          return td;
+      }
 
-        s_pState->m_Tasks[prio].Remove(it);
+      if (StealTask((plTaskPriority::Enum)prio, pOwnWorker, bOnlyTasksThatNeverWait, WaitingForGroup, td))
         return td;
+    }
+
+    if (pWorkerState == nullptr)
+      return TaskData();
+
+    PL_VERIFY(pWorkerState->Set((int)plTaskWorkerState::Idle) == (int)plTaskWorkerState::Active, "Corrupt Worker State");
+
+    // No mutex is held, so a task may have been queued after we looked at the queues, but before we went idle,
+    // in which case the scheduling thread may not have seen us as idle and thus did not wake us up.
+    // Since we set our state before checking the counters and the scheduling thread increments the counters before checking our state,
+    // at least one of us is guaranteed to see the other.
+    if (!HasQueuedTasks(FirstPriority, LastPriority))
+      return TaskData();
+
+    if (!pWorkerState->TestAndSet((int)plTaskWorkerState::Idle, (int)plTaskWorkerState::Active))
+    {
+      // someone else has woken us up in the mean time, so the wake-up signal is raised and WaitForWork() will return right away
+      return TaskData();
+    }
+  }
+}
+
+bool plTaskSystem::TakeTaskFromGlobalQueue(plUInt32 uiPriority, bool bOnlyTasksThatNeverWait, const plTaskGroupID& WaitingForGroup, TaskData& out_task)
+{
+  for (auto it = s_pState->m_Tasks[uiPriority].GetIterator(); it.IsValid(); ++it)
+  {
+    if (!bOnlyTasksThatNeverWait || (it->m_pTask->m_NestingMode == plTaskNesting::Never) || it->m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup)
+    {
+      out_task = *it;
+
+      s_pState->m_Tasks[uiPriority].Remove(it);
+      s_pState->m_iNumGlobalTasks[uiPriority].Decrement();
+      s_pState->m_iNumQueuedTasks[uiPriority].Decrement();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool plTaskSystem::StealTask(plTaskPriority::Enum priority, plTaskWorkerThread* pOwnWorker, bool bOnlyTasksThatNeverWait, const plTaskGroupID& WaitingForGroup, TaskData& out_task)
+{
+  const plTaskGroup* pWaitingForGroup = WaitingForGroup.m_pTaskGroup;
+
+  auto filter = [=](const plTaskWorkerDeque::Entry& entry)
+  {
+    return !bOnlyTasksThatNeverWait || entry.m_bNeverWaits || entry.m_pGroup == pWaitingForGroup;
+  };
+
+  // start with the next worker after ourselves, so that not all threads try to steal from the same victim
+  const plUInt32 uiStartIdx = tl_TaskWorkerInfo.m_iWorkerIndex >= 0 ? tl_TaskWorkerInfo.m_iWorkerIndex + 1 : 0;
+
+  for (plUInt32 type = plWorkerThreadType::ShortTasks; type < plWorkerThreadType::ENUM_COUNT; ++type)
+  {
+    const plUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[type];
+
+    // all workers of the same type own deques for the same priorities
+    if (uiNumWorkers == 0 || s_pThreadState->m_Workers[type][0]->GetDeque(priority) == nullptr)
+      continue;
+
+    for (plUInt32 i = 0; i < uiNumWorkers; ++i)
+    {
+      plTaskWorkerThread* pVictim = s_pThreadState->m_Workers[type][(uiStartIdx + i) % uiNumWorkers];
+
+      if (pVictim == pOwnWorker)
+        continue;
+
+      plTaskWorkerDeque::Entry entry;
+      if (pVictim->GetDeque(priority)->Steal(entry, filter))
+      {
+        out_task.m_pTask = entry.m_pGroup->m_Tasks[entry.m_uiTaskIndex];
+        out_task.m_pBelongsToGroup = entry.m_pGroup;
+        out_task.m_uiInvocation = entry.m_uiInvocation;
+
+        s_pState->m_iNumQueuedTasks[priority].Decrement();
+        return true;
       }
     }
+
+    // only one type of worker owns deques for any given priority
+    return false;
   }
 
-  if (pWorkerState)
+  return false;
+}
+
+bool plTaskSystem::HasQueuedTasks(plTaskPriority::Enum FirstPriority, plTaskPriority::Enum LastPriority)
+{
+  for (plUInt32 prio = FirstPriority; prio <= (plUInt32)LastPriority; ++prio)
   {
-    PL_VERIFY(pWorkerState->Set((int)plTaskWorkerState::Idle) == (int)plTaskWorkerState::Active, "Corrupt Worker State");
+    if (s_pState->m_iNumQueuedTasks[prio] > 0)
+      return true;
   }
 
-  return TaskData();
+  return false;
+}
+
+void plTaskSystem::MoveWorkerDequesToGlobalQueue()
+{
+  for (plUInt32 type = plWorkerThreadType::ShortTasks; type < plWorkerThreadType::ENUM_COUNT; ++type)
+  {
+    const plUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[type];
+
+    for (plUInt32 i = 0; i < uiNumWorkers; ++i)
+    {
+      for (plUInt32 prio = 0; prio < plTaskPriority::ENUM_COUNT; ++prio)
+      {
+        plTaskWorkerDeque* pDeque = s_pThreadState->m_Workers[type][i]->GetDeque((plTaskPriority::Enum)prio);
+
+        if (pDeque != nullptr)
+        {
+          PL_LOCK(s_pState->m_TasksMutex[prio]);
+          MoveDequeToGlobalQueue(pDeque, (plTaskPriority::Enum)prio);
+        }
+      }
+    }
+  }
+}
+
+void plTaskSystem::MoveDequeToGlobalQueue(plTaskWorkerDeque* pDeque, plTaskPriority::Enum priority)
+{
+  auto acceptAll = [](const plTaskWorkerDeque::Entry&)
+  { return true; };
+
+  // other threads may still steal concurrently, so Steal() may fail without the deque being empty
+  while (!pDeque->IsEmpty())
+  {
+    plTaskWorkerDeque::Entry entry;
+    if (pDeque->Steal(entry, acceptAll))
+    {
+      TaskData td;
+      td.m_pTask = entry.m_pGroup->m_Tasks[entry.m_uiTaskIndex];
+      td.m_pBelongsToGroup = entry.m_pGroup;
+      td.m_uiInvocation = entry.m_uiInvocation;
+
+      // the task stays queued, so only the global counter changes
+      s_pState->m_Tasks[priority].PushBack(td);
+      s_pState->m_iNumGlobalTasks[priority].Increment();
+    }
+  }
 }
 
 bool plTaskSystem::ExecuteTask(plTaskPriority::Enum FirstPriority, plTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
@@ -166,38 +348,59 @@ plResult plTaskSystem::CancelTask(const plSharedPtr<plTask>& pTask, plOnTaskRunn
     PL_LOCK(s_TaskSystemMutex);
 
     // if the task is still in the queue of its group, it had not yet been scheduled
-    if (!pTask->m_bTaskIsScheduled && pTask->m_BelongsToGroup.m_pTaskGroup->m_Tasks.RemoveAndSwap(pTask))
+    // the group can't be scheduled while its tasks are modified, see ScheduleGroupTasks()
+    plTaskGroup* pGroup = pTask->m_BelongsToGroup.m_pTaskGroup;
+    if (!pTask->m_bTaskIsScheduled && pGroup->m_iScheduleState.TestAndSet(plTaskGroup::ScheduleState::NotScheduled, plTaskGroup::ScheduleState::Canceling))
     {
-      // we set the task to finished, even though it was not executed
-      pTask->m_iRemainingRuns = 0;
-      return PL_SUCCESS;
-    }
+      const bool bRemoved = pGroup->m_Tasks.RemoveAndSwap(pTask);
+      pGroup->m_iScheduleState = plTaskGroup::ScheduleState::NotScheduled;
 
-    // check if the task has already been scheduled for execution
-    // if so, remove it from the work queue
-    {
-      for (plUInt32 i = 0; i < plTaskPriority::ENUM_COUNT; ++i)
+      if (bRemoved)
       {
-        auto it = s_pState->m_Tasks[i].GetIterator();
+        // we set the task to finished, even though it was not executed
+        pTask->m_iRemainingRuns = 0;
+        return PL_SUCCESS;
+      }
+    }
+  }
 
-        while (it.IsValid())
-        {
-          if (it->m_pTask == pTask)
-          {
-            // we set the task to finished, even though it was not executed
-            pTask->m_iRemainingRuns = 0;
+  // check if the task has already been scheduled for execution
+  // if so, remove it from the work queue
+  // tasks in worker deques (plTaskSchedulingMode::WorkStealing) can't be removed and are treated as if they were already running
+  for (plUInt32 i = 0; i < plTaskPriority::ENUM_COUNT; ++i)
+  {
+    if (s_pState->m_iNumGlobalTasks[i] <= 0)
+      continue;
+
+    TaskData td;
 
-            // tell the system that one task of that group is 'finished', to ensure its dependencies will get scheduled
-            TaskHasFinished(std::move(it->m_pTask), it->m_pBelongsToGroup);
+    {
+      PL_LOCK(s_pState->m_TasksMutex[i]);
 
-            s_pState->m_Tasks[i].Remove(it);
-            return PL_SUCCESS;
-          }
+      for (auto it = s_pState->m_Tasks[i].GetIterator(); it.IsValid(); ++it)
+      {
+        if (it->m_pTask == pTask)
+        {
+          td = *it;
 
-          ++it;
+          s_pState->m_Tasks[i].Remove(it);
+          s_pState->m_iNumGlobalTasks[i].Decrement();
+          s_pState->m_iNumQueuedTasks[i].Decrement();
+          break;
         }
       }
     }
+
+    if (td.m_pTask != nullptr)
+    {
+      // we set the task to finished, even though it was not executed
+      pTask->m_iRemainingRuns = 0;
+
+      // tell the system that one task of that group is 'finished', to ensure its dependencies will get scheduled
+      // this is done without holding the mutex of the list, since it may schedule other groups
+      TaskHasFinished(std::move(td.m_pTask), td.m_pBelongsToGroup);
+      return PL_SUCCESS;
+    }
   }
 
   // if we made it here, the task was already running
@@ -226,56 +429,54 @@ bool plTaskSystem::HelpExecutingTasks(const plTaskGroupID& WaitingForGroup)
 
 void plTaskSystem::ReprioritizeFrameTasks()
 {
-  // There should usually be no 'this frame tasks' left at this time
-  // however, while we waited to enter the lock, such tasks might have appeared
-  // In this case we move them into the highest-priority 'this frame' queue, to ensure they will be executed asap
-  for (plUInt32 i = (plUInt32)plTaskPriority::ThisFrame; i <= (plUInt32)plTaskPriority::LateThisFrame; ++i)
+  auto MoveTasks = [](plUInt32 uiFromPriority, plUInt32 uiToPriority)
   {
-    auto it = s_pState->m_Tasks[i].GetIterator();
+    // tasks only move to higher priorities, which have lower indices, so the locks are always taken in the same order
+    PL_ASSERT_DEBUG(uiToPriority < uiFromPriority, "Tasks can only be moved to a higher priority");
+    PL_LOCK(s_pState->m_TasksMutex[uiToPriority]);
+    PL_LOCK(s_pState->m_TasksMutex[uiFromPriority]);
 
-    // move all 'this frame' tasks into the 'early this frame' queue
-    while (it.IsValid())
-    {
-      s_pState->m_Tasks[plTaskPriority::EarlyThisFrame].PushBack(*it);
+    const plInt32 iNumTasks = static_cast<plInt32>(s_pState->m_Tasks[uiFromPriority].GetCount());
+
+    if (iNumTasks == 0)
+      return;
 
-      ++it;
+    for (auto it = s_pState->m_Tasks[uiFromPriority].GetIterator(); it.IsValid(); ++it)
+    {
+      s_pState->m_Tasks[uiToPriority].PushBack(*it);
     }
 
     // remove the tasks from their current queue
-    s_pState->m_Tasks[i].Clear();
+    s_pState->m_Tasks[uiFromPriority].Clear();
+
+    // increment first, so that the tasks never appear to be missing to a worker checking the counters
+    s_pState->m_iNumGlobalTasks[uiToPriority].Add(iNumTasks);
+    s_pState->m_iNumQueuedTasks[uiToPriority].Add(iNumTasks);
+    s_pState->m_iNumGlobalTasks[uiFromPriority].Subtract(iNumTasks);
+    s_pState->m_iNumQueuedTasks[uiFromPriority].Subtract(iNumTasks);
+  };
+
+  // There should usually be no 'this frame tasks' left at this time
+  // however, while we waited to enter the lock, such tasks might have appeared
+  // In this case we move them into the highest-priority 'this frame' queue, to ensure they will be executed asap
+  // (tasks in worker deques stay where they are, they get executed this frame anyway)
+  for (plUInt32 i = (plUInt32)plTaskPriority::ThisFrame; i <= (plUInt32)plTaskPriority::LateThisFrame; ++i)
+  {
+    // move all 'this frame' tasks into the 'early this frame' queue
+    MoveTasks(i, plTaskPriority::EarlyThisFrame);
   }
 
   for (plUInt32 i = (plUInt32)plTaskPriority::EarlyNextFrame; i <= (plUInt32)plTaskPriority::LateNextFrame; ++i)
   {
-    auto it = s_pState->m_Tasks[i].GetIterator();
-
     // move all 'next frame' tasks into the 'this frame' queues
-    while (it.IsValid())
-    {
-      s_pState->m_Tasks[i - 3].PushBack(*it);
-
-      ++it;
-    }
-
-    // remove the tasks from their current queue
-    s_pState->m_Tasks[i].Clear();
+    MoveTasks(i, i - 3);
   }
 
   for (plUInt32 i = (plUInt32)plTaskPriority::In2Frames; i <= (plUInt32)plTaskPriority::In9Frames; ++i)
   {
-    auto it = s_pState->m_Tasks[i].GetIterator();
-
     // move all 'in N frames' tasks into the 'in N-1 frames' queues
     // moves 'In2Frames' into 'LateNextFrame'
-    while (it.IsValid())
-    {
-      s_pState->m_Tasks[i - 1].PushBack(*it);
-
-      ++it;
-    }
-
-    // remove the tasks from their current queue
-    s_pState->m_Tasks[i].Clear();
+    MoveTasks(i, i - 1);
   }
 }
 
@@ -316,7 +517,7 @@ void plTaskSystem::ExecuteSomeFrameTasks(plTime smoothFrameTime)
   plUInt32 uiNumTasksTodo = 0;
 
   {
-    PL_LOCK(s_TaskSystemMutex);
+    PL_LOCK(s_pState->m_TasksMutex[plTaskPriority::SomeFrameMainThread]);
     uiNumTasksTodo = s_pState->m_Tasks[plTaskPriority::SomeFrameMainThread].GetCount();
   }
 
@@ -381,11 +582,7 @@ void plTaskSystem::FinishFrameTasks()
 
   // all the important tasks for this frame should be finished or worked on by now
   // so we can now re-prioritize the tasks for the next frame
-  {
-    PL_LOCK(s_TaskSystemMutex);
-
-    ReprioritizeFrameTasks();
-  }
+  ReprioritizeFrameTasks();
 
   ExecuteSomeFrameTasks(s_pState->m_TargetFrameTime);
 
@@ -86,6 +86,9 @@ void plTaskSystem::StopWorkerThreads()
     plThreadUtils::YieldTimeSlice();
   }
 
+  // the deques are destroyed together with the workers, but tasks that are still queued in them must not get lost
+  MoveWorkerDequesToGlobalQueue();
+
   for (plUInt32 type = 0; type < plWorkerThreadType::ENUM_COUNT; ++type)
   {
     const plUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[type];
@@ -112,8 +115,10 @@ void plTaskSystem::AllocateThreads(plWorkerThreadType::Enum type, plUInt32 uiAdd
 
     plUInt32 uiNextThreadIdx = s_pThreadState->m_iAllocatedWorkers[type];
 
-    PL_ASSERT_ALWAYS(uiNextThreadIdx + uiAddThreads <= s_pThreadState->m_Workers[type].GetCount(), "Max number of worker threads ({}) exceeded.",
-      s_pThreadState->m_Workers[type].GetCount());
+    // WakeUpThreads() runs without the mutex, so another thread may have allocated some of the requested workers in the meantime
+    uiAddThreads = plMath::Min(uiAddThreads, s_pThreadState->m_Workers[type].GetCount() - uiNextThreadIdx);
+    if (uiAddThreads == 0)
+      return;
 
     for (plUInt32 i = 0; i < uiAddThreads; ++i)
     {
@@ -180,6 +185,30 @@ void plTaskSystem::WakeUpThreads(plWorkerThreadType::Enum type, plUInt32 uiNumTh
   }
 }
 
+void plTaskSystem::SetSchedulingMode(plTaskSchedulingMode::Enum mode)
+{
+  if (s_pState->m_SchedulingMode == mode)
+    return;
+
+  const plUInt32 uiShortTasks = s_pThreadState->m_uiMaxWorkersToUse[plWorkerThreadType::ShortTasks];
+  const plUInt32 uiLongTasks = s_pThreadState->m_uiMaxWorkersToUse[plWorkerThreadType::LongTasks];
+
+  // the worker deques are set up when a worker thread is created, so all workers need to be recreated
+  StopWorkerThreads();
+
+  {
+    PL_LOCK(s_TaskSystemMutex);
+    s_pState->m_SchedulingMode = mode;
+  }
+
+  SetWorkerThreadCount(uiShortTasks, uiLongTasks);
+}
+
+plTaskSchedulingMode::Enum plTaskSystem::GetSchedulingMode()
+{
+  return s_pState->m_SchedulingMode;
+}
+
 plWorkerThreadType::Enum plTaskSystem::GetCurrentThreadWorkerType()
 {
   return tl_TaskWorkerInfo.m_WorkerType;
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Threading/AtomicInteger.h>
+
+class plTaskGroup;
+
+/// \internal Fixed-capacity, lock-free work-stealing deque (Chase-Lev), used by plTaskSchedulingMode::WorkStealing.
+///
+/// Only the owning worker thread may call Push() and Pop(), any thread may call Steal().
+/// The owner works on the bottom end (LIFO, which is good for cache locality), thieves take from the top end (FIFO).
+///
+/// Entries are stored in atomic 64 bit slots, so a thief may read an entry that is concurrently overwritten by the owner
+/// without running into undefined behavior. That only happens when the entry has already been taken by someone else,
+/// in which case the CAS on m_iTop fails and the read data is discarded.
+class plTaskWorkerDeque
+{
+  PL_DISALLOW_COPY_AND_ASSIGN(plTaskWorkerDeque);
+
+public:
+  struct Entry
+  {
+    plTaskGroup* m_pGroup = nullptr;
+    plUInt32 m_uiTaskIndex = 0;
+    plUInt32 m_uiInvocation = 0;
+    bool m_bNeverWaits = false;
+  };
+
+  plTaskWorkerDeque() = default;
+
+  /// \brief Allocates the ring buffer. \a uiCapacity must be a power of two.
+  void Initialize(plUInt32 uiCapacity)
+  {
+    PL_ASSERT_DEV(plMath::IsPowerOf2(uiCapacity), "Capacity must be a power of two");
+
+    m_Slots.SetCount(uiCapacity);
+    m_uiMask = uiCapacity - 1;
+  }
+
+  bool IsInitialized() const { return !m_Slots.IsEmpty(); }
+
+  /// \brief Returns whether the deque currently appears to be empty. Only a snapshot, the state may change at any time.
+  bool IsEmpty() const { return (plInt64)m_iBottom <= (plInt64)m_iTop; }
+
+  /// \brief Adds an entry at the bottom. Returns false, if the deque is full. Must only be called by the owner.
+  bool Push(const Entry& entry)
+  {
+    const plInt64 b = m_iBottom;
+    const plInt64 t = m_iTop;
+
+    if (b - t >= (plInt64)m_Slots.GetCount())
+      return false;
+
+    Slot& slot = m_Slots[static_cast<plUInt32>(b & m_uiMask)];
+    slot.m_iGroup = reinterpret_cast<plInt64>(entry.m_pGroup);
+    slot.m_iPayload = PackPayload(entry);
+
+    // publishes the entry to the thieves
+    m_iBottom = b + 1;
+    return true;
+  }
+
+  /// \brief Removes the bottom-most entry, if it passes \a filter. Must only be called by the owner.
+  template <typename Filter>
+  bool Pop(Entry& out_entry, Filter filter)
+  {
+    plInt64 b = m_iBottom;
+    plInt64 t = m_iTop;
+
+    if (b <= t)
+      return false;
+
+    // only the owner writes slots, so peeking at the bottom entry before reserving it is safe
+    if (!filter(ReadSlot(b - 1)))
+      return false;
+
+    b = b - 1;
+    m_iBottom = b;
+
+    // m_iBottom is written with full barrier semantics, so the read of m_iTop below can't be reordered before it
+    t = m_iTop;
+
+    if (t > b)
+    {
+      // a thief took the last entry
+      m_iBottom = b + 1;
+      return false;
+    }
+
+    out_entry = ReadSlot(b);
+
+    if (t == b)
+    {
+      // this was the last entry, race against the thieves for it
+      const bool bWon = m_iTop.TestAndSet(t, t + 1);
+      m_iBottom = b + 1;
+      return bWon;
+    }
+
+    return true;
+  }
+
+  /// \brief Removes the top-most entry, if it passes \a filter. May be called from any thread.
+  ///
+  /// Returns false if the deque is empty, the entry did not pass the filter or another thread was faster.
+  template <typename Filter>
+  bool Steal(Entry& out_entry, Filter filter)
+  {
+    const plInt64 t = m_iTop;
+    const plInt64 b = m_iBottom;
+
+    if (t >= b)
+      return false;
+
+    const Entry entry = ReadSlot(t);
+
+    // if the entry is stale, the filter result is meaningless, but then the CAS below would fail anyway
+    if (!filter(entry))
+      return false;
+
+    if (!m_iTop.TestAndSet(t, t + 1))
+      return false;
+
+    out_entry = entry;
+    return true;
+  }
+
+private:
+  struct Slot
+  {
+    plAtomicInteger64 m_iGroup;
+    plAtomicInteger64 m_iPayload;
+  };
+
+  static plInt64 PackPayload(const Entry& entry)
+  {
+    PL_ASSERT_DEBUG(entry.m_uiTaskIndex < 0x7FFFFFFF, "Too many tasks in one group");
+
+    plUInt64 uiPayload = entry.m_uiInvocation;
+    uiPayload |= static_cast<plUInt64>(entry.m_uiTaskIndex) << 32;
+    uiPayload |= entry.m_bNeverWaits ? (1ull << 63) : 0ull;
+    return static_cast<plInt64>(uiPayload);
+  }
+
+  Entry ReadSlot(plInt64 iIndex) const
+  {
+    const Slot& slot = m_Slots[static_cast<plUInt32>(iIndex & m_uiMask)];
+    const plUInt64 uiPayload = static_cast<plUInt64>((plInt64)slot.m_iPayload);
+
+    Entry entry;
+    entry.m_pGroup = reinterpret_cast<plTaskGroup*>((plInt64)slot.m_iGroup);
+    entry.m_uiInvocation = static_cast<plUInt32>(uiPayload & 0xFFFFFFFFull);
+    entry.m_uiTaskIndex = static_cast<plUInt32>((uiPayload >> 32) & 0x7FFFFFFFull);
+    entry.m_bNeverWaits = (uiPayload >> 63) != 0;
+    return entry;
+  }
+
+  plDynamicArray<Slot> m_Slots;
+  plUInt64 m_uiMask = 0;
+
+  // m_iTop is modified by the thieves, m_iBottom only by the owner, keep them on separate cache lines
+  plAtomicInteger64 m_iTop;
+  plUInt8 m_Padding[64 - sizeof(plAtomicInteger64)];
+  plAtomicInteger64 m_iBottom;
+};
@@ -19,6 +19,36 @@ plTaskWorkerThread::plTaskWorkerThread(plWorkerThreadType::Enum threadType, plUI
 {
   m_WorkerType = threadType;
   m_uiWorkerThreadNumber = uiThreadNumber & 0xFFFF;
+
+  if (plTaskSystem::GetSchedulingMode() == plTaskSchedulingMode::WorkStealing)
+  {
+    // only the 'this frame' style priorities get a deque, everything that needs reprioritization stays in the global lists
+    switch (threadType)
+    {
+      case plWorkerThreadType::ShortTasks:
+        m_FirstDequePriority = plTaskPriority::EarlyThisFrame;
+        m_uiNumDeques = 3; // EarlyThisFrame, ThisFrame, LateThisFrame
+        break;
+
+      case plWorkerThreadType::LongTasks:
+        m_FirstDequePriority = plTaskPriority::LongRunningHighPriority;
+        m_uiNumDeques = 2; // LongRunningHighPriority, LongRunning
+        break;
+
+      case plWorkerThreadType::FileAccess:
+        m_FirstDequePriority = plTaskPriority::FileAccessHighPriority;
+        m_uiNumDeques = 2; // FileAccessHighPriority, FileAccess
+        break;
+
+      default:
+        break;
+    }
+
+    for (plUInt32 i = 0; i < m_uiNumDeques; ++i)
+    {
+      m_Deques[i].Initialize(DequeCapacity);
+    }
+  }
 }
 
 plTaskWorkerThread::~plTaskWorkerThread() = default;
@@ -49,6 +79,7 @@ plUInt32 plTaskWorkerThread::Run()
   tl_TaskWorkerInfo.m_WorkerType = m_WorkerType;
   tl_TaskWorkerInfo.m_iWorkerIndex = m_uiWorkerThreadNumber;
   tl_TaskWorkerInfo.m_pWorkerState = &m_iWorkerState;
+  tl_TaskWorkerInfo.m_pWorkerThread = this;
 
   const bool bIsReserve = m_uiWorkerThreadNumber >= plTaskSystem::s_pThreadState->m_uiMaxWorkersToUse[m_WorkerType];
 
@@ -93,6 +124,14 @@ plUInt32 plTaskWorkerThread::Run()
   return 0;
 }
 
+plTaskWorkerDeque* plTaskWorkerThread::GetDeque(plTaskPriority::Enum priority)
+{
+  if (priority < m_FirstDequePriority || static_cast<plUInt32>(priority - m_FirstDequePriority) >= m_uiNumDeques)
+    return nullptr;
+
+  return &m_Deques[priority - m_FirstDequePriority];
+}
+
 void plTaskWorkerThread::WaitForWork()
 {
   // m_bIsIdle usually will be true here, but may also already have been reset to false
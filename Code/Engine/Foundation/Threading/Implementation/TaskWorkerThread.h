@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
+#include <Foundation/Threading/Implementation/TaskWorkerDeque.h>
 
 #include <Foundation/Threading/Thread.h>
 #include <Foundation/Threading/ThreadSignal.h>
@@ -53,6 +54,25 @@ private:
 
   ///@}
 
+  /// \name Work Stealing
+  ///@{
+
+public:
+  /// \brief Returns the deque in which this worker queues tasks of the given priority, or nullptr if it has none for that priority.
+  ///
+  /// Deques only exist in plTaskSchedulingMode::WorkStealing and only for the 'this frame' priorities that the worker type executes.
+  plTaskWorkerDeque* GetDeque(plTaskPriority::Enum priority);
+
+private:
+  static constexpr plUInt32 MaxDeques = 3;
+  static constexpr plUInt32 DequeCapacity = 1024;
+
+  plTaskPriority::Enum m_FirstDequePriority = plTaskPriority::EarlyThisFrame;
+  plUInt32 m_uiNumDeques = 0;
+  plTaskWorkerDeque m_Deques[MaxDeques];
+
+  ///@}
+
   /// \name Idle State
   ///@{
 
@@ -85,6 +105,7 @@ struct plTaskWorkerInfo
   plInt32 m_iWorkerIndex = -1;
   const char* m_szTaskName = nullptr;
   plAtomicInteger32* m_pWorkerState = nullptr;
+  plTaskWorkerThread* m_pWorkerThread = nullptr;
 };
 
 extern thread_local plTaskWorkerInfo tl_TaskWorkerInfo;
@@ -83,9 +83,26 @@ public:
 
 private:
   /// \brief Searches for a task of priority between \a FirstPriority and \a LastPriority (inclusive).
+  ///
+  /// Only locks the mutex of a global task list, if that list contains tasks.
   static TaskData GetNextTask(plTaskPriority::Enum FirstPriority, plTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
     const plTaskGroupID& WaitingForGroup, plAtomicInteger32* pWorkerState);
 
+  /// \brief Removes the first suitable task of the given priority from the global lists. The mutex of that list must be locked.
+  static bool TakeTaskFromGlobalQueue(plUInt32 uiPriority, bool bOnlyTasksThatNeverWait, const plTaskGroupID& WaitingForGroup, TaskData& out_task);
+
+  /// \brief Tries to take a task of the given priority out of the deque of any worker thread (other than \a pOwnWorker).
+  static bool StealTask(plTaskPriority::Enum priority, plTaskWorkerThread* pOwnWorker, bool bOnlyTasksThatNeverWait, const plTaskGroupID& WaitingForGroup, TaskData& out_task);
+
+  /// \brief Returns whether any tasks of priority between \a FirstPriority and \a LastPriority (inclusive) are queued anywhere.
+  static bool HasQueuedTasks(plTaskPriority::Enum FirstPriority, plTaskPriority::Enum LastPriority);
+
+  /// \brief Moves all tasks that are still queued in worker deques into the global lists. Used before worker threads get destroyed.
+  static void MoveWorkerDequesToGlobalQueue();
+
+  /// \brief Moves all tasks of the given deque into the global list of the given priority. The mutex of that list must be locked.
+  static void MoveDequeToGlobalQueue(plTaskWorkerDeque* pDeque, plTaskPriority::Enum priority);
+
   /// \brief Executes some task of priority between \a FirstPriority and \a LastPriority (inclusive). Returns true, if any such task was available.
   static bool ExecuteTask(plTaskPriority::Enum FirstPriority, plTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
     const plTaskGroupID& WaitingForGroup, plAtomicInteger32* pWorkerState);
@@ -170,7 +187,14 @@ public:
   static void WaitForCondition(plDelegate<bool()> condition);
 
 private:
+  /// \brief Marks the group as started and adds it to its unfinished dependencies. Returns true, if the group can be scheduled right away.
+  ///
+  /// s_TaskSystemMutex must be locked.
+  static bool RegisterWithDependencies(plTaskGroupID groupID);
+
   /// \brief Takes all the tasks in the given group and schedules them for execution, by inserting them into the proper task lists.
+  ///
+  /// Doesn't lock s_TaskSystemMutex, only the mutex of the global task list, if any tasks don't go into a worker deque.
   static void ScheduleGroupTasks(plTaskGroup* pGroup, bool bHighPriority);
 
   /// \brief Is called whenever a dependency of pGroup has finished. Once all dependencies are finished, the group's tasks will get scheduled.
@@ -208,6 +232,21 @@ public:
   /// \brief Returns the (thread local) type of tasks that would be executed on this thread
   static plWorkerThreadType::Enum GetCurrentThreadWorkerType();
 
+  /// \brief Selects how scheduled tasks are distributed among the worker threads. See plTaskSchedulingMode.
+  ///
+  /// In plTaskSchedulingMode::WorkStealing every worker thread queues the tasks that it schedules itself in its own lock-free deques,
+  /// which the other workers steal from, once they run out of work. Tasks that are scheduled from other threads (e.g. the main thread)
+  /// or that have a priority that needs reprioritization at the end of a frame ('next frame' and 'in N frames') still go through the
+  /// global lists.
+  /// Priorities are respected in the same way as with the global queue, though tasks of the same priority are not necessarily executed
+  /// in the order in which they were scheduled. Also CancelTask() can't remove tasks from worker deques and treats them like running tasks.
+  ///
+  /// Changing the mode restarts all worker threads, so this should be done at startup, similar to SetWorkerThreadCount().
+  static void SetSchedulingMode(plTaskSchedulingMode::Enum mode);
+
+  /// \brief Returns the currently used scheduling mode.
+  static plTaskSchedulingMode::Enum GetSchedulingMode();
+
   /// \brief Returns the utilization (0.0 to 1.0) of the given thread. Note: This will only be valid, if FinishFrameTasks() is called once
   /// per frame.
   ///
@@ -307,7 +346,7 @@ private:
   static void Shutdown();
 
 private:
-  /// One mutex to rule them all.
+  /// Protects the task groups, their dependencies and the worker thread allocation. The task lists have their own mutexes.
   static plMutex s_TaskSystemMutex;
 
   static plUniquePtr<plTaskSystemState> s_pState;
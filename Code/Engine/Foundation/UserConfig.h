@@ -50,6 +50,14 @@
 #endif
 
 
+/// Whether the default heap allocators serve small allocations from thread-local caches (see plAllocPolicyThreadCaching) instead of going to malloc directly
+#undef PL_ALLOC_THREAD_CACHING
+#define PL_ALLOC_THREAD_CACHING PL_OFF
+
+/// Whether plExpressionVM may execute bytecode on 8 (AVX2) or 16 (AVX-512) instances per operation when the CPU supports it. Only has an effect with the SSE SIMD implementation.
+#undef PL_EXPRESSIONVM_WIDE_SIMD
+#define PL_EXPRESSIONVM_WIDE_SIMD PL_ON
+
 /// Whether game objects compute and store their velocity since the last frame (increases object size)
 #define PL_GAMEOBJECT_VELOCITY PL_ON
 
@@ -69,6 +69,10 @@ public:
 protected:
   void OnAnimationPoseUpdated(plMsgAnimationPoseUpdated& msg);     // [ msg handler ]
   void OnQueryAnimationSkeleton(plMsgQueryAnimationSkeleton& msg); // [ msg handler ]
+  void OnQueryAnimationSkinning(plMsgQueryAnimationSkinning& msg); // [ msg handler ]
+
+  /// \brief Computes the skinning matrices and the pose bounds. Called by plAnimController from the pose generation job, see plMsgQueryAnimationSkinning.
+  void ComputeSkinning(const plSkeleton& skeleton, plArrayPtr<const plMat4> modelTransforms);
 
   void InitializeAnimationPose();
 
@@ -78,6 +82,9 @@ protected:
   plBoundingBox m_MaxBounds;
   plSkinningState m_SkinningState;
   plSkeletonResourceHandle m_hDefaultSkeleton;
+
+  const plMat4* m_pSkinnedPose = nullptr; ///< The pose for which ComputeSkinning() computed m_SkinningState, until it is sent through plMsgAnimationPoseUpdated.
+  plBoundingBox m_SkinnedPoseBounds;
 };
 
 
@@ -11,7 +11,24 @@
 using plSkeletonResourceHandle = plTypedResourceHandle<class plSkeletonResource>;
 using plAnimGraphResourceHandle = plTypedResourceHandle<class plAnimGraphResource>;
 
-using plAnimationControllerComponentManager = plComponentManagerSimple<class plAnimationControllerComponent, plComponentUpdateType::WhenSimulating, plBlockStorageType::FreeList>;
+/// \brief Updates all plAnimationControllerComponent's in batches.
+///
+/// Evaluating the animation graphs and sending the resulting poses accesses the game objects and is done serially.
+/// Sampling, blending, converting the poses to model space and computing the skinning matrices (see plMsgQueryAnimationSkinning)
+/// is done for all controllers at once, in parallel on the plTaskSystem.
+class PL_GAMEENGINE_DLL plAnimationControllerComponentManager : public plComponentManager<class plAnimationControllerComponent, plBlockStorageType::FreeList>
+{
+public:
+  plAnimationControllerComponentManager(plWorld* pWorld);
+  ~plAnimationControllerComponentManager();
+
+  virtual void Initialize() override;
+
+private:
+  void Update(const plWorldModule::UpdateContext& context);
+
+  plDynamicArray<plAnimationControllerComponent*> m_ComponentsToUpdate;
+};
 
 /// \brief Evaluates an plAnimGraphResource and provides the result through the plMsgAnimationPoseUpdated.
 ///
@@ -49,7 +66,11 @@ public:
   plEnum<plAnimationInvisibleUpdateRate> m_InvisibleUpdateRate; // [ property ]
 
 protected:
-  void Update();
+  /// \brief Evaluates the animation graph, if the animation needs to be updated this frame. Returns false otherwise.
+  bool EvaluateGraph();
+
+  /// \brief Sends the new pose and applies the root motion.
+  void ApplyPose();
 
   plEnum<plRootMotionMode> m_RootMotionMode;
 
@@ -38,6 +38,7 @@ PL_BEGIN_COMPONENT_TYPE(plAnimatedMeshComponent, 13, plComponentMode::Dynamic);
   {
     PL_MESSAGE_HANDLER(plMsgAnimationPoseUpdated, OnAnimationPoseUpdated),
     PL_MESSAGE_HANDLER(plMsgQueryAnimationSkeleton, OnQueryAnimationSkeleton),
+    PL_MESSAGE_HANDLER(plMsgQueryAnimationSkinning, OnQueryAnimationSkinning),
   }
   PL_END_MESSAGEHANDLERS;
 }
@@ -76,6 +77,7 @@ void plAnimatedMeshComponent::OnActivated()
 void plAnimatedMeshComponent::OnDeactivated()
 {
   m_SkinningState.Clear();
+  m_pSkinnedPose = nullptr;
 
   SUPER::OnDeactivated();
 }
@@ -201,11 +203,22 @@ void plAnimatedMeshComponent::OnAnimationPoseUpdated(plMsgAnimationPoseUpdated&
 
   m_RootTransform = *msg.m_pRootTransform;
 
-  plResourceLock<plMeshResource> pMesh(m_hMesh, plResourceAcquireMode::BlockTillLoaded);
-
   plBoundingBox poseBounds;
-  poseBounds = plBoundingBox::MakeInvalid();
-  MapModelSpacePoseToSkinningSpace(pMesh->m_Bones, *msg.m_pSkeleton, msg.m_ModelTransforms, &poseBounds);
+
+  if (m_pSkinnedPose != nullptr && m_pSkinnedPose == msg.m_ModelTransforms.GetPtr())
+  {
+    // the skinning matrices for this pose were already computed in ComputeSkinning()
+    poseBounds = m_SkinnedPoseBounds;
+  }
+  else
+  {
+    plResourceLock<plMeshResource> pMesh(m_hMesh, plResourceAcquireMode::BlockTillLoaded);
+
+    poseBounds = plBoundingBox::MakeInvalid();
+    MapModelSpacePoseToSkinningSpace(pMesh->m_Bones, *msg.m_pSkeleton, msg.m_ModelTransforms, &poseBounds);
+  }
+
+  m_pSkinnedPose = nullptr;
 
   if (poseBounds.IsValid() && (!m_MaxBounds.IsValid() || !m_MaxBounds.Contains(poseBounds)))
   {
@@ -221,6 +234,24 @@ void plAnimatedMeshComponent::OnAnimationPoseUpdated(plMsgAnimationPoseUpdated&
   m_SkinningState.TransformsChanged();
 }
 
+void plAnimatedMeshComponent::OnQueryAnimationSkinning(plMsgQueryAnimationSkinning& msg)
+{
+  if (m_hMesh.IsValid())
+  {
+    msg.m_SkinningDelegates.PushBack(plMakeDelegate(&plAnimatedMeshComponent::ComputeSkinning, this));
+  }
+}
+
+void plAnimatedMeshComponent::ComputeSkinning(const plSkeleton& skeleton, plArrayPtr<const plMat4> modelTransforms)
+{
+  plResourceLock<plMeshResource> pMesh(m_hMesh, plResourceAcquireMode::BlockTillLoaded);
+
+  m_SkinnedPoseBounds = plBoundingBox::MakeInvalid();
+  MapModelSpacePoseToSkinningSpace(pMesh->m_Bones, skeleton, modelTransforms, &m_SkinnedPoseBounds);
+
+  m_pSkinnedPose = modelTransforms.GetPtr();
+}
+
 void plAnimatedMeshComponent::OnQueryAnimationSkeleton(plMsgQueryAnimationSkeleton& msg)
 {
   if (!msg.m_hSkeleton.IsValid() && m_hMesh.IsValid())
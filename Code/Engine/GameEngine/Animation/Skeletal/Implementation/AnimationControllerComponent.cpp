@@ -3,7 +3,9 @@
 #include <Core/Input/InputManager.h>
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <GameEngine/Animation/Skeletal/AnimatedMeshComponent.h>
 #include <GameEngine/Animation/Skeletal/AnimationControllerComponent.h>
 #include <GameEngine/Gameplay/BlackboardComponent.h>
@@ -32,6 +34,8 @@ PL_BEGIN_COMPONENT_TYPE(plAnimationControllerComponent, 2, plComponentMode::Stat
 PL_END_COMPONENT_TYPE
 // clang-format on
 
+static constexpr plUInt32 s_uiControllersPerTask = 8;
+
 plAnimationControllerComponent::plAnimationControllerComponent() = default;
 plAnimationControllerComponent::~plAnimationControllerComponent() = default;
 
@@ -98,7 +102,7 @@ void plAnimationControllerComponent::OnSimulationStarted()
   m_AnimController.AddAnimGraph(m_hAnimGraph);
 }
 
-void plAnimationControllerComponent::Update()
+bool plAnimationControllerComponent::EvaluateGraph()
 {
   plTime tMinStep = plTime::MakeFromSeconds(0);
   plVisibilityState visType = GetOwner()->GetVisibilityState();
@@ -106,7 +110,7 @@ void plAnimationControllerComponent::Update()
   if (visType != plVisibilityState::Direct)
   {
     if (m_InvisibleUpdateRate == plAnimationInvisibleUpdateRate::Pause && visType == plVisibilityState::Invisible)
-      return;
+      return false;
 
     tMinStep = plAnimationInvisibleUpdateRate::GetTimeStep(m_InvisibleUpdateRate);
   }
@@ -114,11 +118,18 @@ void plAnimationControllerComponent::Update()
   m_ElapsedTimeSinceUpdate += GetWorld()->GetClock().GetTimeDiff();
 
   if (m_ElapsedTimeSinceUpdate < tMinStep)
-    return;
+    return false;
 
-  m_AnimController.Update(m_ElapsedTimeSinceUpdate, GetOwner());
+  m_AnimController.EvaluateGraphs(m_ElapsedTimeSinceUpdate, GetOwner());
   m_ElapsedTimeSinceUpdate = plTime::MakeZero();
 
+  return true;
+}
+
+void plAnimationControllerComponent::ApplyPose()
+{
+  m_AnimController.SendPoseUpdate(GetOwner());
+
   plVec3 translation;
   plAngle rotationX;
   plAngle rotationY;
@@ -128,4 +139,95 @@ void plAnimationControllerComponent::Update()
   plRootMotionMode::Apply(m_RootMotionMode, GetOwner(), translation, rotationX, rotationY, rotationZ);
 }
 
+//////////////////////////////////////////////////////////////////////////
+
+plAnimationControllerComponentManager::plAnimationControllerComponentManager(plWorld* pWorld)
+  : plComponentManager<ComponentType, plBlockStorageType::FreeList>(pWorld)
+{
+}
+
+plAnimationControllerComponentManager::~plAnimationControllerComponentManager() = default;
+
+void plAnimationControllerComponentManager::Initialize()
+{
+  auto desc = PL_CREATE_MODULE_UPDATE_FUNCTION_DESC(plAnimationControllerComponentManager::Update, this);
+  desc.m_bOnlyUpdateWhenSimulating = true;
+
+  RegisterUpdateFunction(desc);
+}
+
+void plAnimationControllerComponentManager::Update(const plWorldModule::UpdateContext& context)
+{
+  m_ComponentsToUpdate.Clear();
+
+  {
+    PL_PROFILE_SCOPE("Anim Graph Evaluation");
+
+    for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+    {
+      ComponentType* pComponent = it;
+      if (pComponent->IsActiveAndInitialized() && pComponent->EvaluateGraph())
+      {
+        m_ComponentsToUpdate.PushBack(pComponent);
+      }
+    }
+  }
+
+  if (m_ComponentsToUpdate.IsEmpty())
+    return;
+
+  plParallelForParams params;
+  params.m_uiBinSize = s_uiControllersPerTask;
+
+  {
+    PL_PROFILE_SCOPE("Anim Local Poses");
+
+    plTaskSystem::ParallelForIndexed(
+      0u, m_ComponentsToUpdate.GetCount(),
+      [this](plUInt32 uiStartIndex, plUInt32 uiEndIndex)
+      {
+        for (plUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          m_ComponentsToUpdate[i]->m_AnimController.GenerateLocalPoses();
+        }
+      },
+      "Anim Local Poses", plTaskNesting::Maybe, params);
+  }
+
+  {
+    PL_PROFILE_SCOPE("Anim Local Pose Messages");
+
+    for (ComponentType* pComponent : m_ComponentsToUpdate)
+    {
+      pComponent->m_AnimController.SendLocalPoseMessages(pComponent->GetOwner());
+    }
+  }
+
+  {
+    PL_PROFILE_SCOPE("Anim Model Poses");
+
+    plTaskSystem::ParallelForIndexed(
+      0u, m_ComponentsToUpdate.GetCount(),
+      [this](plUInt32 uiStartIndex, plUInt32 uiEndIndex)
+      {
+        for (plUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          m_ComponentsToUpdate[i]->m_AnimController.GenerateModelPoses();
+        }
+      },
+      "Anim Model Poses", plTaskNesting::Maybe, params);
+  }
+
+  {
+    PL_PROFILE_SCOPE("Anim Apply Poses");
+
+    for (ComponentType* pComponent : m_ComponentsToUpdate)
+    {
+      pComponent->ApplyPose();
+    }
+  }
+
+  m_ComponentsToUpdate.Clear();
+}
+
 PL_STATICLINK_FILE(GameEngine, GameEngine_Animation_Skeletal_Implementation_AnimationControllerComponent);
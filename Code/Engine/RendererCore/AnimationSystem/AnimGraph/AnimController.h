@@ -11,6 +11,7 @@
 #include <Foundation/Types/UniquePtr.h>
 #include <RendererCore/AnimationSystem/AnimGraph/AnimGraphNode.h>
 #include <RendererCore/AnimationSystem/AnimPoseGenerator.h>
+#include <RendererCore/AnimationSystem/Declarations.h>
 
 class plGameObject;
 class plAnimGraph;
@@ -58,8 +59,36 @@ public:
 
   void Initialize(const plSkeletonResourceHandle& hSkeleton, plAnimPoseGenerator& ref_poseGenerator, const plSharedPtr<plBlackboard>& pBlackboard = nullptr);
 
+  /// \brief Evaluates the animation graphs, generates the new pose and sends it to pTarget. Same as calling all update phases below in order.
   void Update(plTime diff, plGameObject* pTarget);
 
+  /// \name Update phases
+  ///
+  /// Update() can be split up into these phases, so that the pose generation of many controllers can be batched
+  /// and executed in parallel (see plAnimationControllerComponentManager). The phases have to be called in the order in which they are declared.
+  /// Only GenerateLocalPoses() and GenerateModelPoses() may be called from other threads, the other phases access the game objects.
+  ///@{
+
+  /// \brief Evaluates the animation graphs and sets up the pose generator commands.
+  ///
+  /// Also queries pTarget and its children for skinning delegates through plMsgQueryAnimationSkinning. The skeleton stays acquired
+  /// until SendPoseUpdate(), so that it can't be reloaded while the pose is generated.
+  void EvaluateGraphs(plTime diff, plGameObject* pTarget);
+
+  /// \brief Samples and blends the animation clips. See plAnimPoseGenerator::GenerateLocalPoses().
+  void GenerateLocalPoses();
+
+  /// \brief See plAnimPoseGenerator::SendLocalPoseMessages().
+  void SendLocalPoseMessages(plGameObject* pTarget);
+
+  /// \brief Converts the local poses to model space (see plAnimPoseGenerator::GenerateModelPoses()) and calls the skinning delegates with the result.
+  void GenerateModelPoses();
+
+  /// \brief Sends the generated pose to pTarget and its children through plMsgAnimationPoseUpdated.
+  void SendPoseUpdate(plGameObject* pTarget);
+
+  ///@}
+
   void GetRootMotion(plVec3& ref_vTranslation, plAngle& ref_rotationX, plAngle& ref_rotationY, plAngle& ref_rotationZ) const;
 
   const plSharedPtr<plBlackboard>& GetBlackboard() { return m_pBlackboard; }
@@ -89,9 +118,13 @@ public:
 
 private:
   void GenerateLocalResultProcessors(const plSkeletonResource* pSkeleton);
+  void ReleaseSkeleton();
 
   plSkeletonResourceHandle m_hSkeleton;
+  plSkeletonResource* m_pSkeleton = nullptr; ///< Acquired from EvaluateGraphs() until SendPoseUpdate().
+  plHybridArray<plMsgQueryAnimationSkinning::SkinningDelegate, 2> m_SkinningDelegates;
   plAnimGraphPinDataModelTransforms* m_pCurrentModelTransforms = nullptr;
+  bool m_bGeneratePose = false;
 
   plVec3 m_vRootMotion = plVec3::MakeZero();
   plAngle m_RootRotationX;
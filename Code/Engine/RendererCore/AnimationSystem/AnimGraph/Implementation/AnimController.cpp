@@ -14,7 +14,11 @@ plMutex plAnimController::s_SharedDataMutex;
 plHashTable<plString, plSharedPtr<plAnimGraphSharedBoneWeights>> plAnimController::s_SharedBoneWeights;
 
 plAnimController::plAnimController() = default;
-plAnimController::~plAnimController() = default;
+
+plAnimController::~plAnimController()
+{
+  ReleaseSkeleton();
+}
 
 void plAnimController::Initialize(const plSkeletonResourceHandle& hSkeleton, plAnimPoseGenerator& ref_poseGenerator, const plSharedPtr<plBlackboard>& pBlackboard /*= nullptr*/)
 {
@@ -33,12 +37,33 @@ void plAnimController::GetRootMotion(plVec3& ref_vTranslation, plAngle& ref_rota
 
 void plAnimController::Update(plTime diff, plGameObject* pTarget)
 {
+  EvaluateGraphs(diff, pTarget);
+  GenerateLocalPoses();
+  SendLocalPoseMessages(pTarget);
+  GenerateModelPoses();
+  SendPoseUpdate(pTarget);
+}
+
+void plAnimController::EvaluateGraphs(plTime diff, plGameObject* pTarget)
+{
+  m_bGeneratePose = false;
+
+  // in case the previous update was not finished
+  ReleaseSkeleton();
+
   if (!m_hSkeleton.IsValid())
     return;
 
-  plResourceLock<plSkeletonResource> pSkeleton(m_hSkeleton, plResourceAcquireMode::BlockTillLoaded_NeverFail);
-  if (pSkeleton.GetAcquireResult() != plResourceAcquireResult::Final)
+  // the pose generator uses the skeleton until the pose is sent, possibly on other threads, so it stays acquired until SendPoseUpdate()
+  plResourceAcquireResult acquireResult = plResourceAcquireResult::None;
+  m_pSkeleton = plResourceManager::BeginAcquireResource(m_hSkeleton, plResourceAcquireMode::BlockTillLoaded_NeverFail, plSkeletonResourceHandle(), &acquireResult);
+  if (acquireResult != plResourceAcquireResult::Final)
+  {
+    ReleaseSkeleton();
     return;
+  }
+
+  const plSkeletonResource* pSkeleton = m_pSkeleton;
 
   m_pCurrentModelTransforms = nullptr;
 
@@ -49,7 +74,7 @@ void plAnimController::Update(plTime diff, plGameObject* pTarget)
   m_RootRotationY = {};
   m_RootRotationZ = {};
 
-  m_pPoseGenerator->Reset(pSkeleton.GetPointer());
+  m_pPoseGenerator->Reset(pSkeleton);
 
   m_PinDataBoneWeights.Clear();
   m_PinDataLocalTransforms.Clear();
@@ -59,13 +84,65 @@ void plAnimController::Update(plTime diff, plGameObject* pTarget)
 
   for (auto& inst : m_Instances)
   {
-    inst.m_pInstance->Update(*this, diff, pTarget, pSkeleton.GetPointer());
+    inst.m_pInstance->Update(*this, diff, pTarget, pSkeleton);
+  }
+
+  GenerateLocalResultProcessors(pSkeleton);
+
+  m_pPoseGenerator->PrepareGeneratePose(pTarget);
+  m_bGeneratePose = true;
+
+  plMsgQueryAnimationSkinning msg;
+  pTarget->SendMessageRecursive(msg);
+  m_SkinningDelegates = msg.m_SkinningDelegates;
+}
+
+void plAnimController::GenerateLocalPoses()
+{
+  if (m_bGeneratePose)
+  {
+    m_pPoseGenerator->GenerateLocalPoses();
+  }
+}
+
+void plAnimController::SendLocalPoseMessages(plGameObject* pTarget)
+{
+  if (m_bGeneratePose)
+  {
+    m_pPoseGenerator->SendLocalPoseMessages(pTarget);
   }
+}
+
+void plAnimController::GenerateModelPoses()
+{
+  if (!m_bGeneratePose)
+    return;
 
-  GenerateLocalResultProcessors(pSkeleton.GetPointer());
+  m_pPoseGenerator->GenerateModelPoses();
 
-  if (auto newPose = GetPoseGenerator().GeneratePose(pTarget); !newPose.IsEmpty())
+  if (auto newPose = m_pPoseGenerator->GetOutputPose(); !newPose.IsEmpty())
   {
+    const plSkeleton& skeleton = m_pSkeleton->GetDescriptor().m_Skeleton;
+
+    for (const auto& skinning : m_SkinningDelegates)
+    {
+      skinning(skeleton, newPose);
+    }
+  }
+}
+
+void plAnimController::SendPoseUpdate(plGameObject* pTarget)
+{
+  if (!m_bGeneratePose)
+    return;
+
+  m_bGeneratePose = false;
+  m_SkinningDelegates.Clear();
+
+  if (auto newPose = m_pPoseGenerator->GetOutputPose(); !newPose.IsEmpty())
+  {
+    const plSkeletonResource* pSkeleton = m_pSkeleton;
+
     plMsgAnimationPoseUpdated msg;
     msg.m_pSkeleton = &pSkeleton->GetDescriptor().m_Skeleton;
     msg.m_ModelTransforms = newPose;
@@ -77,6 +154,17 @@ void plAnimController::Update(plTime diff, plGameObject* pTarget)
     // for example bone attachments
     pTarget->SendMessageRecursive(msg);
   }
+
+  ReleaseSkeleton();
+}
+
+void plAnimController::ReleaseSkeleton()
+{
+  if (m_pSkeleton != nullptr)
+  {
+    plResourceManager::EndAcquireResource(m_pSkeleton);
+    m_pSkeleton = nullptr;
+  }
 }
 
 void plAnimController::SetOutputModelTransform(plAnimGraphPinDataModelTransforms* pModelTransform)
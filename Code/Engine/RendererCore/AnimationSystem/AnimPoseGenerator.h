@@ -191,25 +191,56 @@ public:
   const plAnimPoseGeneratorCommand& GetCommand(plAnimPoseGeneratorCommandID id) const;
   plAnimPoseGeneratorCommand& GetCommand(plAnimPoseGeneratorCommandID id);
 
+  /// \brief Executes all phases below in order and returns the final model space pose.
   plArrayPtr<plMat4> GeneratePose(const plGameObject* pSendAnimationEventsTo);
 
+  /// \name Pose generation phases
+  ///
+  /// GeneratePose() can be split up into these phases, so that the expensive work of many pose generators can be batched and
+  /// executed in parallel. The phases have to be called in the order in which they are declared.
+  /// Only GenerateLocalPoses() and GenerateModelPoses() are thread-safe (with respect to other pose generators),
+  /// the other phases send messages and thus have to be called on the thread that updates the world.
+  ///@{
+
+  /// \brief Validates the commands, determines the order in which they are executed and samples the event tracks.
+  void PrepareGeneratePose(const plGameObject* pSendAnimationEventsTo);
+
+  /// \brief Samples the animation clips and blends the local space poses.
+  void GenerateLocalPoses();
+
+  /// \brief Sends plMsgAnimationPosePreparing, so that the local space poses can be modified before they are converted to model space.
+  void SendLocalPoseMessages(const plGameObject* pSendAnimationEventsTo);
+
+  /// \brief Converts the local space poses to model space and returns the final pose.
+  plArrayPtr<plMat4> GenerateModelPoses();
+
+  ///@}
+
+  const plSkeletonResource* GetSkeleton() const { return m_pSkeleton; }
+
+  /// \brief Returns the pose that was generated by the last call to GeneratePose() or GenerateModelPoses().
+  plArrayPtr<plMat4> GetOutputPose() const { return m_OutputPose; }
+
 private:
   void Validate() const;
 
-  void Execute(plAnimPoseGeneratorCommand& cmd, const plGameObject* pSendAnimationEventsTo);
-  void ExecuteCmd(plAnimPoseGeneratorCommandSampleTrack& cmd, const plGameObject* pSendAnimationEventsTo);
+  void AddToExecutionOrder(plAnimPoseGeneratorCommand& cmd);
+  void ExecuteCmd(plAnimPoseGeneratorCommandSampleTrack& cmd);
   void ExecuteCmd(plAnimPoseGeneratorCommandRestPose& cmd);
   void ExecuteCmd(plAnimPoseGeneratorCommandCombinePoses& cmd);
-  void ExecuteCmd(plAnimPoseGeneratorCommandLocalToModelPose& cmd, const plGameObject* pSendAnimationEventsTo);
+  void ExecuteCmd(plAnimPoseGeneratorCommandLocalToModelPose& cmd);
   void ExecuteCmd(plAnimPoseGeneratorCommandModelPoseToOutput& cmd);
-  void ExecuteCmd(plAnimPoseGeneratorCommandSampleEventTrack& cmd, const plGameObject* pSendAnimationEventsTo);
-  void SampleEventTrack(const plAnimationClipResource* pResource, plAnimPoseEventTrackSampleMode mode, const plGameObject* pSendAnimationEventsTo, float fPrevPos, float fCurPos);
+  void SampleEventTrack(const plAnimationClipResourceHandle& hAnimationClip, plAnimPoseEventTrackSampleMode mode, const plGameObject* pSendAnimationEventsTo, float fPrevPos, float fCurPos);
 
+  plAnimPoseGeneratorLocalPoseID GetLocalPoseOutput(plAnimPoseGeneratorCommandID id) const;
   plArrayPtr<ozz::math::SoaTransform> AcquireLocalPoseTransforms(plAnimPoseGeneratorLocalPoseID id);
   plArrayPtr<plMat4> AcquireModelPoseTransforms(plAnimPoseGeneratorModelPoseID id);
 
   const plSkeletonResource* m_pSkeleton = nullptr;
 
+  // all commands that are (indirectly) connected to the output, in the order in which they have to be executed
+  plHybridArray<plAnimPoseGeneratorCommandID, 16> m_ExecutionOrder;
+
   plAnimPoseGeneratorLocalPoseID m_LocalPoseCounter = 0;
   plAnimPoseGeneratorModelPoseID m_ModelPoseCounter = 0;
 
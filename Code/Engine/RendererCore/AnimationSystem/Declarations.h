@@ -2,6 +2,8 @@
 
 #include <Core/ResourceManager/ResourceHandle.h>
 #include <Foundation/Communication/Message.h>
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Types/Delegate.h>
 #include <RendererCore/RendererCoreDLL.h>
 #include <ozz/base/maths/soa_transform.h>
 
@@ -68,6 +70,20 @@ struct PL_RENDERERCORE_DLL plMsgAnimationPoseUpdated : public plMessage
   bool m_bContinueAnimating = true;
 };
 
+/// \brief Sent by plAnimController before a new pose is generated, to find the components that compute skinning matrices from it.
+///
+/// The pose may be generated on another thread, in parallel with the poses of other animated objects. The delegates that are added here
+/// are called from there, right after the model space pose was computed, so that the skinning matrices are computed in parallel as well.
+/// A delegate may only modify its own component. plMsgAnimationPoseUpdated is still sent afterwards, on the thread that updates the world.
+struct PL_RENDERERCORE_DLL plMsgQueryAnimationSkinning : public plMessage
+{
+  PL_DECLARE_MESSAGE_TYPE(plMsgQueryAnimationSkinning, plMessage);
+
+  using SkinningDelegate = plDelegate<void(const plSkeleton&, plArrayPtr<const plMat4>)>;
+
+  plHybridArray<SkinningDelegate, 2> m_SkinningDelegates;
+};
+
 /// \brief Used by components that do rope simulation and rendering.
 ///
 /// The rope simulation component sends this message to components attached to the same game object,
@@ -209,67 +209,134 @@ plAnimPoseGeneratorCommand& plAnimPoseGenerator::GetCommand(plAnimPoseGeneratorC
 }
 
 plArrayPtr<plMat4> plAnimPoseGenerator::GeneratePose(const plGameObject* pSendAnimationEventsTo /*= nullptr*/)
+{
+  PrepareGeneratePose(pSendAnimationEventsTo);
+  GenerateLocalPoses();
+  SendLocalPoseMessages(pSendAnimationEventsTo);
+  return GenerateModelPoses();
+}
+
+void plAnimPoseGenerator::PrepareGeneratePose(const plGameObject* pSendAnimationEventsTo)
 {
   Validate();
 
+  m_ExecutionOrder.Clear();
+
   for (auto& cmd : m_CommandsModelPoseToOutput)
   {
-    Execute(cmd, pSendAnimationEventsTo);
+    AddToExecutionOrder(cmd);
   }
 
-  auto pPose = m_OutputPose;
-
-  // TODO: clear temp data
+  // event tracks are sampled up front, because sending the event messages isn't thread-safe
+  for (auto id : m_ExecutionOrder)
+  {
+    const auto& cmd = GetCommand(id);
 
-  return pPose;
+    if (cmd.GetType() == plAnimPoseGeneratorCommandType::SampleTrack)
+    {
+      const auto& cmdSample = static_cast<const plAnimPoseGeneratorCommandSampleTrack&>(cmd);
+      SampleEventTrack(cmdSample.m_hAnimationClip, cmdSample.m_EventSampling, pSendAnimationEventsTo, cmdSample.m_fPreviousNormalizedSamplePos, cmdSample.m_fNormalizedSamplePos);
+    }
+    else if (cmd.GetType() == plAnimPoseGeneratorCommandType::SampleEventTrack)
+    {
+      const auto& cmdSample = static_cast<const plAnimPoseGeneratorCommandSampleEventTrack&>(cmd);
+      SampleEventTrack(cmdSample.m_hAnimationClip, cmdSample.m_EventSampling, pSendAnimationEventsTo, cmdSample.m_fPreviousNormalizedSamplePos, cmdSample.m_fNormalizedSamplePos);
+    }
+  }
 }
 
-void plAnimPoseGenerator::Execute(plAnimPoseGeneratorCommand& cmd, const plGameObject* pSendAnimationEventsTo)
+void plAnimPoseGenerator::GenerateLocalPoses()
 {
-  if (cmd.m_bExecuted)
-    return;
+  for (auto id : m_ExecutionOrder)
+  {
+    auto& cmd = GetCommand(id);
 
-  // TODO: validate for circular dependencies
-  cmd.m_bExecuted = true;
+    switch (cmd.GetType())
+    {
+      case plAnimPoseGeneratorCommandType::SampleTrack:
+        ExecuteCmd(static_cast<plAnimPoseGeneratorCommandSampleTrack&>(cmd));
+        break;
 
-  for (auto id : cmd.m_Inputs)
-  {
-    Execute(GetCommand(id), pSendAnimationEventsTo);
+      case plAnimPoseGeneratorCommandType::RestPose:
+        ExecuteCmd(static_cast<plAnimPoseGeneratorCommandRestPose&>(cmd));
+        break;
+
+      case plAnimPoseGeneratorCommandType::CombinePoses:
+        ExecuteCmd(static_cast<plAnimPoseGeneratorCommandCombinePoses&>(cmd));
+        break;
+
+      default:
+        break;
+    }
   }
+}
+
+void plAnimPoseGenerator::SendLocalPoseMessages(const plGameObject* pSendAnimationEventsTo)
+{
+  for (auto id : m_ExecutionOrder)
+  {
+    if (GetCommandType(id) != plAnimPoseGeneratorCommandType::LocalToModelPose)
+      continue;
 
-  // TODO: build a task graph and execute multi-threaded
+    const auto& cmd = static_cast<const plAnimPoseGeneratorCommandLocalToModelPose&>(GetCommand(id));
 
-  switch (cmd.GetType())
+    if (cmd.m_pSendLocalPoseMsgTo || pSendAnimationEventsTo)
+    {
+      plMsgAnimationPosePreparing msg;
+      msg.m_pSkeleton = &m_pSkeleton->GetDescriptor().m_Skeleton;
+      msg.m_LocalTransforms = AcquireLocalPoseTransforms(GetLocalPoseOutput(cmd.m_Inputs[0]));
+
+      if (pSendAnimationEventsTo)
+        pSendAnimationEventsTo->SendMessageRecursive(msg);
+      else
+        cmd.m_pSendLocalPoseMsgTo->SendMessageRecursive(msg);
+    }
+  }
+}
+
+plArrayPtr<plMat4> plAnimPoseGenerator::GenerateModelPoses()
+{
+  for (auto id : m_ExecutionOrder)
   {
-    case plAnimPoseGeneratorCommandType::SampleTrack:
-      ExecuteCmd(static_cast<plAnimPoseGeneratorCommandSampleTrack&>(cmd), pSendAnimationEventsTo);
-      break;
+    auto& cmd = GetCommand(id);
 
-    case plAnimPoseGeneratorCommandType::RestPose:
-      ExecuteCmd(static_cast<plAnimPoseGeneratorCommandRestPose&>(cmd));
-      break;
+    switch (cmd.GetType())
+    {
+      case plAnimPoseGeneratorCommandType::LocalToModelPose:
+        ExecuteCmd(static_cast<plAnimPoseGeneratorCommandLocalToModelPose&>(cmd));
+        break;
 
-    case plAnimPoseGeneratorCommandType::CombinePoses:
-      ExecuteCmd(static_cast<plAnimPoseGeneratorCommandCombinePoses&>(cmd));
-      break;
+      case plAnimPoseGeneratorCommandType::ModelPoseToOutput:
+        ExecuteCmd(static_cast<plAnimPoseGeneratorCommandModelPoseToOutput&>(cmd));
+        break;
 
-    case plAnimPoseGeneratorCommandType::LocalToModelPose:
-      ExecuteCmd(static_cast<plAnimPoseGeneratorCommandLocalToModelPose&>(cmd), pSendAnimationEventsTo);
-      break;
+      default:
+        break;
+    }
+  }
 
-    case plAnimPoseGeneratorCommandType::ModelPoseToOutput:
-      ExecuteCmd(static_cast<plAnimPoseGeneratorCommandModelPoseToOutput&>(cmd));
-      break;
+  // TODO: clear temp data
 
-    case plAnimPoseGeneratorCommandType::SampleEventTrack:
-      ExecuteCmd(static_cast<plAnimPoseGeneratorCommandSampleEventTrack&>(cmd), pSendAnimationEventsTo);
-      break;
+  return m_OutputPose;
+}
 
-      PL_DEFAULT_CASE_NOT_IMPLEMENTED;
+void plAnimPoseGenerator::AddToExecutionOrder(plAnimPoseGeneratorCommand& cmd)
+{
+  if (cmd.m_bExecuted)
+    return;
+
+  // TODO: validate for circular dependencies
+  cmd.m_bExecuted = true;
+
+  for (auto id : cmd.m_Inputs)
+  {
+    AddToExecutionOrder(GetCommand(id));
   }
+
+  m_ExecutionOrder.PushBack(cmd.GetCommandID());
 }
 
-void plAnimPoseGenerator::ExecuteCmd(plAnimPoseGeneratorCommandSampleTrack& cmd, const plGameObject* pSendAnimationEventsTo)
+void plAnimPoseGenerator::ExecuteCmd(plAnimPoseGeneratorCommandSampleTrack& cmd)
 {
   plResourceLock<plAnimationClipResource> pResource(cmd.m_hAnimationClip, plResourceAcquireMode::BlockTillLoaded);
 
@@ -302,8 +369,6 @@ void plAnimPoseGenerator::ExecuteCmd(plAnimPoseGeneratorCommandSampleTrack& cmd,
 
   PL_ASSERT_DEBUG(job.Validate(), "");
   job.Run();
-
-  SampleEventTrack(pResource.GetPointer(), cmd.m_EventSampling, pSendAnimationEventsTo, cmd.m_fPreviousNormalizedSamplePos, cmd.m_fNormalizedSamplePos);
 }
 
 void plAnimPoseGenerator::ExecuteCmd(plAnimPoseGeneratorCommandRestPose& cmd)
@@ -388,52 +453,13 @@ void plAnimPoseGenerator::ExecuteCmd(plAnimPoseGeneratorCommandCombinePoses& cmd
   job.Run();
 }
 
-void plAnimPoseGenerator::ExecuteCmd(plAnimPoseGeneratorCommandLocalToModelPose& cmd, const plGameObject* pSendAnimationEventsTo)
+void plAnimPoseGenerator::ExecuteCmd(plAnimPoseGeneratorCommandLocalToModelPose& cmd)
 {
-  ozz::animation::LocalToModelJob job;
-
-  const auto& cmdIn = GetCommand(cmd.m_Inputs[0]);
-
-  switch (cmdIn.GetType())
-  {
-    case plAnimPoseGeneratorCommandType::SampleTrack:
-    {
-      auto transform = AcquireLocalPoseTransforms(static_cast<const plAnimPoseGeneratorCommandSampleTrack&>(cmdIn).m_LocalPoseOutput);
-      job.input = ozz::span<const ozz::math::SoaTransform>(transform.GetPtr(), transform.GetCount());
-    }
-    break;
-
-    case plAnimPoseGeneratorCommandType::RestPose:
-    {
-      auto transform = AcquireLocalPoseTransforms(static_cast<const plAnimPoseGeneratorCommandRestPose&>(cmdIn).m_LocalPoseOutput);
-      job.input = ozz::span<const ozz::math::SoaTransform>(transform.GetPtr(), transform.GetCount());
-    }
-    break;
-
-    case plAnimPoseGeneratorCommandType::CombinePoses:
-    {
-      auto transform = AcquireLocalPoseTransforms(static_cast<const plAnimPoseGeneratorCommandCombinePoses&>(cmdIn).m_LocalPoseOutput);
-      job.input = ozz::span<const ozz::math::SoaTransform>(transform.GetPtr(), transform.GetCount());
-    }
-    break;
-
-      PL_DEFAULT_CASE_NOT_IMPLEMENTED;
-  }
-
-  if (cmd.m_pSendLocalPoseMsgTo || pSendAnimationEventsTo)
-  {
-    plMsgAnimationPosePreparing msg;
-    msg.m_pSkeleton = &m_pSkeleton->GetDescriptor().m_Skeleton;
-    msg.m_LocalTransforms = plMakeArrayPtr(const_cast<ozz::math::SoaTransform*>(job.input.data()), (plUInt32)job.input.size());
-
-    if (pSendAnimationEventsTo)
-      pSendAnimationEventsTo->SendMessageRecursive(msg);
-    else
-      cmd.m_pSendLocalPoseMsgTo->SendMessageRecursive(msg);
-  }
-
+  auto input = AcquireLocalPoseTransforms(GetLocalPoseOutput(cmd.m_Inputs[0]));
   auto transforms = AcquireModelPoseTransforms(cmd.m_ModelPoseOutput);
 
+  ozz::animation::LocalToModelJob job;
+  job.input = ozz::span<const ozz::math::SoaTransform>(input.GetPtr(), input.GetCount());
   job.output = ozz::span<ozz::math::Float4x4>(reinterpret_cast<ozz::math::Float4x4*>(transforms.GetPtr()), transforms.GetCount());
   job.skeleton = &m_pSkeleton->GetDescriptor().m_Skeleton.GetOzzSkeleton();
   PL_ASSERT_DEBUG(job.Validate(), "");
@@ -454,18 +480,16 @@ void plAnimPoseGenerator::ExecuteCmd(plAnimPoseGeneratorCommandModelPoseToOutput
   }
 }
 
-void plAnimPoseGenerator::ExecuteCmd(plAnimPoseGeneratorCommandSampleEventTrack& cmd, const plGameObject* pSendAnimationEventsTo)
+void plAnimPoseGenerator::SampleEventTrack(const plAnimationClipResourceHandle& hAnimationClip, plAnimPoseEventTrackSampleMode mode, const plGameObject* pSendAnimationEventsTo, float fPrevPos, float fCurPos)
 {
-  plResourceLock<plAnimationClipResource> pResource(cmd.m_hAnimationClip, plResourceAcquireMode::BlockTillLoaded);
+  if (mode == plAnimPoseEventTrackSampleMode::None)
+    return;
 
-  SampleEventTrack(pResource.GetPointer(), cmd.m_EventSampling, pSendAnimationEventsTo, cmd.m_fPreviousNormalizedSamplePos, cmd.m_fNormalizedSamplePos);
-}
+  plResourceLock<plAnimationClipResource> pResource(hAnimationClip, plResourceAcquireMode::BlockTillLoaded);
 
-void plAnimPoseGenerator::SampleEventTrack(const plAnimationClipResource* pResource, plAnimPoseEventTrackSampleMode mode, const plGameObject* pSendAnimationEventsTo, float fPrevPos, float fCurPos)
-{
   const auto& et = pResource->GetDescriptor().m_EventTrack;
 
-  if (mode == plAnimPoseEventTrackSampleMode::None || et.IsEmpty())
+  if (et.IsEmpty())
     return;
 
   const plTime duration = pResource->GetDescriptor().GetDuration();
@@ -516,6 +540,27 @@ void plAnimPoseGenerator::SampleEventTrack(const plAnimationClipResource* pResou
   }
 }
 
+plAnimPoseGeneratorLocalPoseID plAnimPoseGenerator::GetLocalPoseOutput(plAnimPoseGeneratorCommandID id) const
+{
+  const auto& cmd = GetCommand(id);
+
+  switch (cmd.GetType())
+  {
+    case plAnimPoseGeneratorCommandType::SampleTrack:
+      return static_cast<const plAnimPoseGeneratorCommandSampleTrack&>(cmd).m_LocalPoseOutput;
+
+    case plAnimPoseGeneratorCommandType::RestPose:
+      return static_cast<const plAnimPoseGeneratorCommandRestPose&>(cmd).m_LocalPoseOutput;
+
+    case plAnimPoseGeneratorCommandType::CombinePoses:
+      return static_cast<const plAnimPoseGeneratorCommandCombinePoses&>(cmd).m_LocalPoseOutput;
+
+      PL_DEFAULT_CASE_NOT_IMPLEMENTED;
+  }
+
+  return plInvalidIndex;
+}
+
 plArrayPtr<ozz::math::SoaTransform> plAnimPoseGenerator::AcquireLocalPoseTransforms(plAnimPoseGeneratorLocalPoseID id)
 {
   m_UsedLocalTransforms.EnsureCount(id + 1);
@@ -27,6 +27,17 @@ PL_BEGIN_DYNAMIC_REFLECTED_TYPE(plMsgAnimationPoseUpdated, 1, plRTTIDefaultAlloc
 }
 PL_END_DYNAMIC_REFLECTED_TYPE;
 
+PL_IMPLEMENT_MESSAGE_TYPE(plMsgQueryAnimationSkinning);
+PL_BEGIN_DYNAMIC_REFLECTED_TYPE(plMsgQueryAnimationSkinning, 1, plRTTIDefaultAllocator<plMsgQueryAnimationSkinning>)
+{
+  PL_BEGIN_ATTRIBUTES
+  {
+    new plExcludeFromScript()
+  }
+  PL_END_ATTRIBUTES;
+}
+PL_END_DYNAMIC_REFLECTED_TYPE;
+
 PL_IMPLEMENT_MESSAGE_TYPE(plMsgRopePoseUpdated);
 PL_BEGIN_DYNAMIC_REFLECTED_TYPE(plMsgRopePoseUpdated, 1, plRTTIDefaultAllocator<plMsgRopePoseUpdated>)
 {
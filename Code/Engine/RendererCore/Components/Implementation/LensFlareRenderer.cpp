@@ -8,6 +8,7 @@
 #include <RendererCore/Pipeline/RenderDataBatch.h>
 #include <RendererCore/RenderContext/RenderContext.h>
 #include <RendererCore/Shader/ShaderResource.h>
+#include <RendererCore/Textures/TextureStreaming.h>
 #include <RendererFoundation/Shader/ShaderUtils.h>
 
 #include <Shaders/Materials/LensFlareData.h>
@@ -48,6 +49,12 @@ void plLensFlareRenderer::RenderBatch(const plRenderViewContext& renderViewConte
   pContext->BindBuffer("lensFlareData", pDevice->GetDefaultResourceView(hLensFlareData));
   pContext->BindTexture2D("LensFlareTexture", pRenderData->m_hTexture);
 
+  if (plTextureStreaming::ShouldReportUsage(renderViewContext))
+  {
+    // lens flares are sized in screen space and can cover the entire view
+    plTextureStreaming::ReportTextureUsage(pRenderData->m_hTexture, renderViewContext.m_pViewData->m_ViewPortRect.height);
+  }
+
   FillLensFlareData(batch);
 
   if (m_LensFlareData.GetCount() > 0) // Instance data might be empty if all render data was filtered.
@@ -8,6 +8,7 @@
 #include <RendererCore/Pipeline/RenderDataBatch.h>
 #include <RendererCore/RenderContext/RenderContext.h>
 #include <RendererCore/Shader/ShaderResource.h>
+#include <RendererCore/Textures/TextureStreaming.h>
 #include <RendererFoundation/Shader/ShaderUtils.h>
 
 #include <Shaders/Materials/SpriteData.h>
@@ -52,6 +53,21 @@ void plSpriteRenderer::RenderBatch(const plRenderViewContext& renderViewContext,
   pContext->BindBuffer("spriteData", pDevice->GetDefaultResourceView(hSpriteData));
   pContext->BindTexture2D("SpriteTexture", pRenderData->m_hTexture);
 
+  if (plTextureStreaming::ShouldReportUsage(renderViewContext))
+  {
+    // sprites never get larger than their max screen size, and may only show a part of their texture
+    const plTextureStreamingScreenSize screenSize(renderViewContext);
+
+    float fScreenSize = 0.0f;
+    for (auto it = batch.GetIterator<plSpriteRenderData>(); it.IsValid(); ++it)
+    {
+      const float fSpriteSize = plMath::Min(screenSize.Compute(it->m_GlobalBounds), it->m_fMaxScreenSize);
+      fScreenSize = plMath::Max(fScreenSize, fSpriteSize / plMath::Max(plMath::Abs(it->m_texCoordScale.y), 0.01f));
+    }
+
+    plTextureStreaming::ReportTextureUsage(pRenderData->m_hTexture, fScreenSize);
+  }
+
   pContext->SetShaderPermutationVariable("BLEND_MODE", plSpriteBlendMode::GetPermutationValue(pRenderData->m_BlendMode));
   pContext->SetShaderPermutationVariable("SHAPE_ICON", pRenderData->m_BlendMode == plSpriteBlendMode::ShapeIcon ? plMakeHashedString("TRUE") : plMakeHashedString("FALSE"));
 
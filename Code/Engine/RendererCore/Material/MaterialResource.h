@@ -112,6 +112,7 @@ private:
   plMaterialResourceDescriptor m_mDesc;
 
   friend class plRenderContext;
+  friend class plTextureStreaming;
   PL_MAKE_SUBSYSTEM_STARTUP_FRIEND(RendererCore, MaterialResource);
 
   plEvent<const plMaterialResource*, plMutex> m_ModifiedEvent;
@@ -13,6 +13,7 @@
 #include <RendererCore/Pipeline/RenderPipeline.h>
 #include <RendererCore/Pipeline/RenderPipelinePass.h>
 #include <RendererCore/RenderContext/RenderContext.h>
+#include <RendererCore/Textures/TextureStreaming.h>
 #include <RendererFoundation/Device/Device.h>
 
 // clang-format off
@@ -320,6 +321,8 @@ void plCustomMeshRenderer::RenderBatch(const plRenderViewContext& renderViewCont
 
   pRenderContext->SetShaderPermutationVariable("VERTEX_SKINNING", "FALSE");
 
+  const bool bReportTextureUsage = plTextureStreaming::ShouldReportUsage(renderViewContext);
+
   for (auto it = batch.GetIterator<plCustomMeshRenderData>(0, batch.GetCount()); it.IsValid(); ++it)
   {
     const plCustomMeshRenderData* pRenderData = it;
@@ -328,6 +331,11 @@ void plCustomMeshRenderer::RenderBatch(const plRenderViewContext& renderViewCont
 
     pRenderContext->BindMaterial(pRenderData->m_hMaterial);
 
+    if (bReportTextureUsage)
+    {
+      plTextureStreaming::ReportMaterialUsage(pRenderData->m_hMaterial, plTextureStreaming::ComputeScreenSize(pRenderData->m_GlobalBounds, renderViewContext));
+    }
+
     plUInt32 uiInstanceDataOffset = 0;
     plArrayPtr<plPerInstanceData> instanceData = pInstanceData->GetInstanceData(1, uiInstanceDataOffset);
 
@@ -8,6 +8,7 @@
 #include <RendererCore/Pipeline/RenderPipeline.h>
 #include <RendererCore/Pipeline/RenderPipelinePass.h>
 #include <RendererCore/RenderContext/RenderContext.h>
+#include <RendererCore/Textures/TextureStreaming.h>
 
 // clang-format off
 PL_BEGIN_DYNAMIC_REFLECTED_TYPE(plMeshRenderer, 1, plRTTIDefaultAllocator<plMeshRenderer>)
@@ -73,6 +74,12 @@ void plMeshRenderer::RenderBatch(const plRenderViewContext& renderViewContext, c
   pContext->BindMaterial(hMaterial);
   pContext->BindMeshBuffer(pMesh->GetMeshBuffer());
 
+  // cached render data doesn't go through extraction again, so the texture detail is reported here, once for the entire batch
+  if (plTextureStreaming::ShouldReportUsage(renderViewContext))
+  {
+    plTextureStreaming::ReportMaterialUsage(hMaterial, plTextureStreamingScreenSize(renderViewContext).ComputeMax<plMeshRenderData>(batch));
+  }
+
   SetAdditionalData(renderViewContext, pRenderData);
 
   if (!bHasExplicitInstanceData)
@@ -32,6 +32,11 @@ public:
   void AddRenderData(const plRenderData* pRenderData, plRenderData::Category category);
   void AddFrameData(const plRenderData* pFrameData);
 
+  /// \brief Moves all render data and frame data of \a ref_other into this object, e.g. to combine data that was extracted on multiple threads.
+  ///
+  /// The sorting keys are taken over as they are, so \a ref_other needs to use the same camera. Call this before SortAndBatch().
+  void MergeRenderData(plExtractedRenderData& ref_other);
+
   void SortAndBatch();
 
   void Clear();
@@ -52,8 +57,11 @@ private:
   {
     plDynamicArray<plRenderDataBatch> m_Batches;
     plDynamicArray<plRenderDataBatch::SortableRenderData> m_SortableRenderData;
+    plDynamicArray<plRenderDataBatch::SortableRenderData> m_SortScratch;
   };
 
+  static void SortAndBatch(DataPerCategory& ref_dataPerCategory);
+
   plCamera m_Camera;
   plCamera m_LodCamera; // Temporary until we have a real LOD system
   plViewData m_ViewData;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Types/UniquePtr.h>
 #include <RendererCore/Pipeline/RenderData.h>
 
 class plStreamWriter;
@@ -32,6 +34,8 @@ protected:
   bool FilterByViewTags(const plView& view, const plGameObject* pObject) const;
 
   /// \brief extracts the render data for the given object.
+  ///
+  /// This may be called from multiple threads at the same time, as long as every thread uses its own \a msg and \a extractedRenderData.
   void ExtractRenderData(const plView& view, const plGameObject* pObject, plMsgExtractRenderData& msg, plExtractedRenderData& extractedRenderData) const;
 
 private:
@@ -45,12 +49,17 @@ protected:
   plHybridArray<plHashedString, 4> m_DependsOn;
 
 #if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
-  mutable plUInt32 m_uiNumCachedRenderData;
-  mutable plUInt32 m_uiNumUncachedRenderData;
+  mutable plAtomicInteger32 m_iNumCachedRenderData;
+  mutable plAtomicInteger32 m_iNumUncachedRenderData;
 #endif
 };
 
 
+/// \brief Extracts the render data of all visible objects.
+///
+/// For views with many visible objects the extraction is split across the plTaskSystem worker threads.
+/// Every task extracts a contiguous range of objects into its own plExtractedRenderData shard, and the shards are merged
+/// in order afterwards, so the result is the same as with serial extraction.
 class PL_RENDERERCORE_DLL plVisibleObjectsExtractor : public plExtractor
 {
   PL_ADD_DYNAMIC_REFLECTION(plVisibleObjectsExtractor, plExtractor);
@@ -62,6 +71,10 @@ public:
   virtual void Extract(const plView& view, const plDynamicArray<const plGameObject*>& visibleObjects, plExtractedRenderData& ref_extractedRenderData) override;
   virtual plResult Serialize(plStreamWriter& inout_stream) const override;
   virtual plResult Deserialize(plStreamReader& inout_stream) override;
+
+private:
+  // kept alive between frames, so that the shards don't need to allocate again
+  plDynamicArray<plUniquePtr<plExtractedRenderData>> m_Shards;
 };
 
 class PL_RENDERERCORE_DLL plSelectedObjectsExtractorBase : public plExtractor
@@ -1,8 +1,95 @@
 #include <RendererCore/RendererCorePCH.h>
 
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 
+namespace
+{
+  enum
+  {
+    MinRadixSortCount = 64,              ///< Below this insertion sort is faster than building the histograms
+    MinParallelSortAndBatchCount = 4096, ///< Sorting categories in parallel only pays off with enough render data
+  };
+
+  template <typename SortableRenderData>
+  struct RenderDataComparer
+  {
+    PL_ALWAYS_INLINE bool Less(const SortableRenderData& a, const SortableRenderData& b) const
+    {
+      if (a.m_uiSortingKey == b.m_uiSortingKey)
+      {
+        return a.m_uiBatchId < b.m_uiBatchId;
+      }
+
+      return a.m_uiSortingKey < b.m_uiSortingKey;
+    }
+  };
+
+  /// Stable LSD radix sort by sorting key and then batch id, with 8 bit digits.
+  /// The batch id is the least significant part, so its 4 digits are sorted first, followed by the 8 digits of the sorting key.
+  template <typename SortableRenderData>
+  void RadixSort(plDynamicArray<SortableRenderData>& inout_data, plDynamicArray<SortableRenderData>& inout_scratch)
+  {
+    constexpr plUInt32 NumPasses = 12;
+
+    const plUInt32 uiCount = inout_data.GetCount();
+
+    auto GetDigit = [](const SortableRenderData& data, plUInt32 uiPass) -> plUInt32 {
+      if (uiPass < 4)
+        return (data.m_uiBatchId >> (uiPass * 8)) & 0xFF;
+
+      return static_cast<plUInt32>(data.m_uiSortingKey >> ((uiPass - 4) * 8)) & 0xFF;
+    };
+
+    // build all histograms in one pass over the data
+    plUInt32 histograms[NumPasses][256] = {};
+    for (const auto& data : inout_data)
+    {
+      for (plUInt32 uiPass = 0; uiPass < NumPasses; ++uiPass)
+      {
+        ++histograms[uiPass][GetDigit(data, uiPass)];
+      }
+    }
+
+    inout_scratch.SetCountUninitialized(uiCount);
+
+    SortableRenderData* pSource = inout_data.GetData();
+    SortableRenderData* pTarget = inout_scratch.GetData();
+    bool bResultInScratch = false;
+
+    for (plUInt32 uiPass = 0; uiPass < NumPasses; ++uiPass)
+    {
+      plUInt32* pHistogram = histograms[uiPass];
+
+      // typically most digits are the same for all elements, e.g. the upper bytes of the batch ids, those passes can be skipped
+      if (pHistogram[GetDigit(pSource[0], uiPass)] == uiCount)
+        continue;
+
+      plUInt32 uiOffset = 0;
+      for (plUInt32 i = 0; i < 256; ++i)
+      {
+        const plUInt32 uiDigitCount = pHistogram[i];
+        pHistogram[i] = uiOffset;
+        uiOffset += uiDigitCount;
+      }
+
+      for (plUInt32 i = 0; i < uiCount; ++i)
+      {
+        pTarget[pHistogram[GetDigit(pSource[i], uiPass)]++] = pSource[i];
+      }
+
+      plMath::Swap(pSource, pTarget);
+      bResultInScratch = !bResultInScratch;
+    }
+
+    if (bResultInScratch)
+    {
+      inout_data.Swap(inout_scratch);
+    }
+  }
+} // namespace
+
 plExtractedRenderData::plExtractedRenderData() = default;
 
 void plExtractedRenderData::AddRenderData(const plRenderData* pRenderData, plRenderData::Category category)
@@ -12,6 +99,8 @@ void plExtractedRenderData::AddRenderData(const plRenderData* pRenderData, plRen
   auto& sortableRenderData = m_DataPerCategory[category.m_uiValue].m_SortableRenderData.ExpandAndGetRef();
   sortableRenderData.m_pRenderData = pRenderData;
   sortableRenderData.m_uiSortingKey = pRenderData->GetCategorySortingKey(category, m_Camera);
+  sortableRenderData.m_pRenderDataType = pRenderData->GetDynamicRTTI();
+  sortableRenderData.m_uiBatchId = pRenderData->m_uiBatchId;
 }
 
 void plExtractedRenderData::AddFrameData(const plRenderData* pFrameData)
@@ -19,54 +108,91 @@ void plExtractedRenderData::AddFrameData(const plRenderData* pFrameData)
   m_FrameData.PushBack(pFrameData);
 }
 
+void plExtractedRenderData::MergeRenderData(plExtractedRenderData& ref_other)
+{
+  m_DataPerCategory.EnsureCount(ref_other.m_DataPerCategory.GetCount());
+
+  for (plUInt32 uiCategory = 0; uiCategory < ref_other.m_DataPerCategory.GetCount(); ++uiCategory)
+  {
+    auto& otherData = ref_other.m_DataPerCategory[uiCategory].m_SortableRenderData;
+    if (otherData.IsEmpty())
+      continue;
+
+    m_DataPerCategory[uiCategory].m_SortableRenderData.PushBackRange(otherData);
+    otherData.Clear();
+  }
+
+  m_FrameData.PushBackRange(ref_other.m_FrameData);
+  ref_other.m_FrameData.Clear();
+}
+
 void plExtractedRenderData::SortAndBatch()
 {
   PL_PROFILE_SCOPE("SortAndBatch");
 
-  struct RenderDataComparer
+  plUInt32 uiTotalCount = 0;
+  plUInt32 uiNumNonEmptyCategories = 0;
+  for (auto& dataPerCategory : m_DataPerCategory)
   {
-    PL_FORCE_INLINE bool Less(const plRenderDataBatch::SortableRenderData& a, const plRenderDataBatch::SortableRenderData& b) const
-    {
-      if (a.m_uiSortingKey == b.m_uiSortingKey)
+    uiTotalCount += dataPerCategory.m_SortableRenderData.GetCount();
+    uiNumNonEmptyCategories += dataPerCategory.m_SortableRenderData.IsEmpty() ? 0 : 1;
+  }
+
+  if (uiTotalCount >= MinParallelSortAndBatchCount && uiNumNonEmptyCategories > 1)
+  {
+    plTaskSystem::ParallelForIndexed(0, m_DataPerCategory.GetCount(), [this](plUInt32 uiStartIndex, plUInt32 uiEndIndex) {
+      for (plUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
       {
-        return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
+        SortAndBatch(m_DataPerCategory[i]);
       }
-
-      return a.m_uiSortingKey < b.m_uiSortingKey;
+    },
+      "SortAndBatchCategory");
+  }
+  else
+  {
+    for (auto& dataPerCategory : m_DataPerCategory)
+    {
+      SortAndBatch(dataPerCategory);
     }
-  };
+  }
+}
 
-  for (auto& dataPerCategory : m_DataPerCategory)
-  {
-    if (dataPerCategory.m_SortableRenderData.IsEmpty())
-      continue;
+// static
+void plExtractedRenderData::SortAndBatch(DataPerCategory& ref_dataPerCategory)
+{
+  if (ref_dataPerCategory.m_SortableRenderData.IsEmpty())
+    return;
 
-    auto& data = dataPerCategory.m_SortableRenderData;
+  auto& data = ref_dataPerCategory.m_SortableRenderData;
 
-    // Sort
-    data.Sort(RenderDataComparer());
+  // Sort
+  if (data.GetCount() < MinRadixSortCount)
+  {
+    plSorting::InsertionSort(data, RenderDataComparer<plRenderDataBatch::SortableRenderData>());
+  }
+  else
+  {
+    RadixSort(data, ref_dataPerCategory.m_SortScratch);
+  }
 
-    // Find batches
-    plUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
-    plUInt32 uiCurrentBatchStartIndex = 0;
-    const plRTTI* pCurrentBatchType = data[0].m_pRenderData->GetDynamicRTTI();
+  // Find batches
+  plUInt32 uiCurrentBatchId = data[0].m_uiBatchId;
+  plUInt32 uiCurrentBatchStartIndex = 0;
+  const plRTTI* pCurrentBatchType = data[0].m_pRenderDataType;
 
-    for (plUInt32 i = 1; i < data.GetCount(); ++i)
+  for (plUInt32 i = 1; i < data.GetCount(); ++i)
+  {
+    if (data[i].m_uiBatchId != uiCurrentBatchId || data[i].m_pRenderDataType != pCurrentBatchType)
     {
-      auto pRenderData = data[i].m_pRenderData;
+      ref_dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = plMakeArrayPtr(&data[uiCurrentBatchStartIndex], i - uiCurrentBatchStartIndex);
 
-      if (pRenderData->m_uiBatchId != uiCurrentBatchId || pRenderData->GetDynamicRTTI() != pCurrentBatchType)
-      {
-        dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = plMakeArrayPtr(&data[uiCurrentBatchStartIndex], i - uiCurrentBatchStartIndex);
-
-        uiCurrentBatchId = pRenderData->m_uiBatchId;
-        uiCurrentBatchStartIndex = i;
-        pCurrentBatchType = pRenderData->GetDynamicRTTI();
-      }
+      uiCurrentBatchId = data[i].m_uiBatchId;
+      uiCurrentBatchStartIndex = i;
+      pCurrentBatchType = data[i].m_pRenderDataType;
     }
-
-    dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = plMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex);
   }
+
+  ref_dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = plMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex);
 }
 
 void plExtractedRenderData::Clear()
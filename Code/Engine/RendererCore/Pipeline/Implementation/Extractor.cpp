@@ -4,6 +4,8 @@
 #include <Core/World/World.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/IO/TypeVersionContext.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/Extractor.h>
@@ -21,8 +23,15 @@ plCVarString cvar_SpatialVisDataOnlyObject("Spatial.VisData.OnlyObject", "", plC
 plCVarBool cvar_SpatialExtractionShowStats("Spatial.Extraction.ShowStats", false, plCVarFlags::Default, "Display some stats of the render data extraction");
 #endif
 
+plCVarBool cvar_RenderingParallelExtraction("Rendering.ParallelExtraction", true, plCVarFlags::Default, "Extract the render data of views with many visible objects on multiple threads");
+
 namespace
 {
+  enum
+  {
+    MinObjectsPerExtractionShard = 256,
+  };
+
 #if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
   void VisualizeSpatialData(const plView& view)
   {
@@ -108,11 +117,6 @@ plExtractor::plExtractor(const char* szName)
 {
   m_bActive = true;
   m_sName.Assign(szName);
-
-#if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
-  m_uiNumCachedRenderData = 0;
-  m_uiNumUncachedRenderData = 0;
-#endif
 }
 
 plExtractor::~plExtractor() = default;
@@ -143,6 +147,12 @@ bool plExtractor::FilterByViewTags(const plView& view, const plGameObject* pObje
 
 void plExtractor::ExtractRenderData(const plView& view, const plGameObject* pObject, plMsgExtractRenderData& msg, plExtractedRenderData& extractedRenderData) const
 {
+#if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
+  // counted locally, to only touch the shared counters once per object
+  plInt32 iNumCachedRenderData = 0;
+  plInt32 iNumUncachedRenderData = 0;
+#endif
+
   auto AddRenderDataFromMessage = [&](const plMsgExtractRenderData& msg) {
     if (msg.m_OverrideCategory != plInvalidRenderDataCategory)
     {
@@ -160,7 +170,7 @@ void plExtractor::ExtractRenderData(const plView& view, const plGameObject* pObj
     }
 
 #if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
-    m_uiNumUncachedRenderData += msg.m_ExtractedRenderData.GetCount();
+    iNumUncachedRenderData += msg.m_ExtractedRenderData.GetCount();
 #endif
   };
 
@@ -196,7 +206,7 @@ void plExtractor::ExtractRenderData(const plView& view, const plGameObject* pObj
           extractedRenderData.AddRenderData(cacheEntry.m_pRenderData, msg.m_OverrideCategory != plInvalidRenderDataCategory ? msg.m_OverrideCategory : plRenderData::Category(cacheEntry.m_uiCategory));
 
 #if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
-          ++m_uiNumCachedRenderData;
+          ++iNumCachedRenderData;
 #endif
         }
         ++uiCacheIndex;
@@ -256,6 +266,13 @@ void plExtractor::ExtractRenderData(const plView& view, const plGameObject* pObj
 
     AddRenderDataFromMessage(msg);
   }
+
+#if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
+  if (iNumCachedRenderData > 0)
+    m_iNumCachedRenderData.Add(iNumCachedRenderData);
+  if (iNumUncachedRenderData > 0)
+    m_iNumUncachedRenderData.Add(iNumUncachedRenderData);
+#endif
 }
 
 void plExtractor::Extract(const plView& view, const plDynamicArray<const plGameObject*>& visibleObjects, plExtractedRenderData& ref_extractedRenderData)
@@ -301,24 +318,92 @@ plVisibleObjectsExtractor::~plVisibleObjectsExtractor() = default;
 void plVisibleObjectsExtractor::Extract(
   const plView& view, const plDynamicArray<const plGameObject*>& visibleObjects, plExtractedRenderData& ref_extractedRenderData)
 {
-  plMsgExtractRenderData msg;
-  msg.m_pView = &view;
-
   PL_LOCK(view.GetWorld()->GetReadMarker());
 
 #if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
+  plStopwatch extractionTimer;
+
   VisualizeSpatialData(view);
 
-  m_uiNumCachedRenderData = 0;
-  m_uiNumUncachedRenderData = 0;
+  m_iNumCachedRenderData = 0;
+  m_iNumUncachedRenderData = 0;
 #endif
 
-  for (auto pObject : visibleObjects)
+  const plUInt32 uiNumObjects = visibleObjects.GetCount();
+
+  plUInt32 uiNumShards = 1;
+  if (cvar_RenderingParallelExtraction)
   {
-    ExtractRenderData(view, pObject, msg, ref_extractedRenderData);
+    // a few more shards than threads, so that the task system can balance objects with very different extraction costs
+    const plUInt32 uiMaxShards = (plTaskSystem::GetWorkerThreadCount(plWorkerThreadType::ShortTasks) + 1) * 2;
+    uiNumShards = plMath::Clamp(uiNumObjects / MinObjectsPerExtractionShard, 1u, uiMaxShards);
+  }
+
+  if (uiNumShards == 1)
+  {
+    plMsgExtractRenderData msg;
+    msg.m_pView = &view;
+
+    for (auto pObject : visibleObjects)
+    {
+      ExtractRenderData(view, pObject, msg, ref_extractedRenderData);
+    }
+  }
+  else
+  {
+    while (m_Shards.GetCount() < uiNumShards)
+    {
+      m_Shards.PushBack(PL_DEFAULT_NEW(plExtractedRenderData));
+    }
+
+    for (plUInt32 uiShard = 0; uiShard < uiNumShards; ++uiShard)
+    {
+      // the camera is needed for the sorting keys
+      m_Shards[uiShard]->SetCamera(ref_extractedRenderData.GetCamera());
+    }
+
+    auto ExtractShards = [&](plUInt32 uiStartShard, plUInt32 uiEndShard) {
+      plMsgExtractRenderData msg;
+      msg.m_pView = &view;
+
+      for (plUInt32 uiShard = uiStartShard; uiShard < uiEndShard; ++uiShard)
+      {
+        const plUInt32 uiStartObject = static_cast<plUInt32>((plUInt64(uiNumObjects) * uiShard) / uiNumShards);
+        const plUInt32 uiEndObject = static_cast<plUInt32>((plUInt64(uiNumObjects) * (uiShard + 1)) / uiNumShards);
+
+        plExtractedRenderData& shard = *m_Shards[uiShard];
+        for (plUInt32 i = uiStartObject; i < uiEndObject; ++i)
+        {
+          ExtractRenderData(view, visibleObjects[i], msg, shard);
+        }
+      }
+    };
+
+    // Extraction can wait for resources to be loaded, so the tasks need to allow nesting.
+    plParallelForParams params;
+    params.m_uiBinSize = 1;
+    params.m_uiMaxTasksPerThread = 2;
+    params.m_NestingMode = plTaskNesting::Maybe;
+
+    plTaskSystem::ParallelForIndexed(0, uiNumShards, ExtractShards, "ExtractVisibleObjects", plTaskNesting::Maybe, params);
+
+    {
+      PL_PROFILE_SCOPE("MergeShards");
+
+      for (plUInt32 uiShard = 0; uiShard < uiNumShards; ++uiShard)
+      {
+        ref_extractedRenderData.MergeRenderData(*m_Shards[uiShard]);
+      }
+    }
+  }
 
 #if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
-    if (cvar_SpatialVisBounds || cvar_SpatialVisLocalBBox || cvar_SpatialVisData)
+  const plTime extractionTime = extractionTimer.GetRunningTotal();
+
+  // the debug renderer calls stay on this thread, so that the draw order doesn't depend on the task scheduling
+  if (cvar_SpatialVisBounds || cvar_SpatialVisLocalBBox || cvar_SpatialVisData)
+  {
+    for (auto pObject : visibleObjects)
     {
       if ((cvar_SpatialVisDataOnlyObject.GetValue().IsEmpty() ||
             pObject->GetName().FindSubString_NoCase(cvar_SpatialVisDataOnlyObject.GetValue()) != nullptr) &&
@@ -327,10 +412,8 @@ void plVisibleObjectsExtractor::Extract(
         VisualizeObject(view, pObject);
       }
     }
-#endif
   }
 
-#if PL_ENABLED(PL_COMPILE_FOR_DEVELOPMENT)
   const bool bIsMainView = (view.GetCameraUsageHint() == plCameraUsageHint::MainView || view.GetCameraUsageHint() == plCameraUsageHint::EditorView);
 
   if (cvar_SpatialExtractionShowStats && bIsMainView)
@@ -341,10 +424,16 @@ void plVisibleObjectsExtractor::Extract(
 
     plDebugRenderer::DrawInfoText(hView, plDebugTextPlacement::TopLeft, "ExtractionStats", "Extraction Stats:");
 
-    sb.SetFormat("Num Cached Render Data: {0}", m_uiNumCachedRenderData);
+    sb.SetFormat("Num Cached Render Data: {0}", static_cast<plInt32>(m_iNumCachedRenderData));
+    plDebugRenderer::DrawInfoText(hView, plDebugTextPlacement::TopLeft, "ExtractionStats", sb);
+
+    sb.SetFormat("Num Uncached Render Data: {0}", static_cast<plInt32>(m_iNumUncachedRenderData));
+    plDebugRenderer::DrawInfoText(hView, plDebugTextPlacement::TopLeft, "ExtractionStats", sb);
+
+    sb.SetFormat("Num Extraction Shards: {0}", uiNumShards);
     plDebugRenderer::DrawInfoText(hView, plDebugTextPlacement::TopLeft, "ExtractionStats", sb);
 
-    sb.SetFormat("Num Uncached Render Data: {0}", m_uiNumUncachedRenderData);
+    sb.SetFormat("Extraction Time: {0} ms", plArgF(extractionTime.GetMilliseconds(), 2));
     plDebugRenderer::DrawInfoText(hView, plDebugTextPlacement::TopLeft, "ExtractionStats", sb);
   }
 #endif
@@ -1011,14 +1011,17 @@ void plRenderPipeline::FindVisibleObjects(const plView& view)
   {
     PL_PROFILE_SCOPE("Occlusion::FindVisibleObjects");
 
-    auto IsOccluded = [=](const plSimdBBox& aabb) {
-      // grow the bbox by some percent to counter the lower precision of the occlusion buffer
+    auto IsOccluded = [=](plArrayPtr<const plSimdBBox> boxes) {
+      // grow the bboxes by some percent to counter the lower precision of the occlusion buffer
+      const plSimdVec4f vScale(1.0f + cvar_SpatialCullingOcclusionBoundsInlation);
 
-      const plSimdVec4f c = aabb.GetCenter();
-      const plSimdVec4f e = aabb.GetHalfExtents();
-      const plSimdBBox aabb2 = plSimdBBox::MakeFromCenterAndHalfExtents(c, e.CompMul(plSimdVec4f(1.0f + cvar_SpatialCullingOcclusionBoundsInlation)));
+      plSimdBBox inflatedBoxes[plSpatialSystem::MaxOcclusionBatchSize];
+      for (plUInt32 i = 0; i < boxes.GetCount(); ++i)
+      {
+        inflatedBoxes[i] = plSimdBBox::MakeFromCenterAndHalfExtents(boxes[i].GetCenter(), boxes[i].GetHalfExtents().CompMul(vScale));
+      }
 
-      return !pRasterizer->IsVisible(aabb2);
+      return pRasterizer->GetOccludedMask(plMakeArrayPtr(inflatedBoxes, boxes.GetCount()));
     };
 
     m_VisibleObjects.Clear();
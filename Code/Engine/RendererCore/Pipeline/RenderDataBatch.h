@@ -11,6 +11,10 @@ private:
 
     const plRenderData* m_pRenderData;
     plUInt64 m_uiSortingKey;
+
+    // copies of render data members, so that sorting and batching doesn't need to access the render data itself
+    const plRTTI* m_pRenderDataType;
+    plUInt32 m_uiBatchId;
   };
 
 public:
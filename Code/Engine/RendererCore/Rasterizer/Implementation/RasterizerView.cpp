@@ -5,13 +5,17 @@
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/SimdMath/SimdBBox.h>
 #include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Rasterizer/RasterizerObject.h>
 #include <RendererCore/Rasterizer/RasterizerView.h>
 #include <RendererCore/Rasterizer/Thirdparty/Occluder.h>
 #include <RendererCore/Rasterizer/Thirdparty/Rasterizer.h>
 
 plCVarInt cvar_SpatialCullingOcclusionMaxResolution("Spatial.Occlusion.MaxResolution", 512, plCVarFlags::Default, "Max resolution for occlusion buffers.");
-plCVarInt cvar_SpatialCullingOcclusionMaxOccluders("Spatial.Occlusion.MaxOccluders", 64, plCVarFlags::Default, "Max number of occluders to rasterize per frame.");
+plCVarInt cvar_SpatialCullingOcclusionMaxOccluders("Spatial.Occlusion.MaxOccluders", 64, plCVarFlags::Default, "Max number of occluders to rasterize per frame. With parallel rasterization every screen band gets an equal share.");
+plCVarBool cvar_SpatialCullingOcclusionParallelRasterization("Spatial.Occlusion.ParallelRasterization", true, plCVarFlags::Default, "Rasterize occluders in horizontal screen bands on multiple threads.");
+
+static constexpr plUInt32 s_uiMinBlockRowsPerBand = 2;
 
 plRasterizerView::plRasterizerView() = default;
 plRasterizerView::~plRasterizerView() = default;
@@ -69,6 +73,11 @@ void plRasterizerView::EndScene()
   m_Instances.Clear();
 
   m_pRasterizer->setModelViewProjection(m_mViewProjection.m_fElementsCM);
+
+  if (m_bAnyOccludersRasterized)
+  {
+    m_pRasterizer->buildHiZHierarchy();
+  }
 }
 
 void plRasterizerView::RasterizeObjects(plUInt32 uiMaxObjects)
@@ -77,31 +86,91 @@ void plRasterizerView::RasterizeObjects(plUInt32 uiMaxObjects)
 
   PL_PROFILE_SCOPE("Occlusion::RasterizeObjects");
 
-  for (const Instance& inst : m_Instances)
+  // compute all matrices up front, so that the bands don't need to modify any rasterizer state
+  m_BakedModelViewProjections.SetCountUninitialized(m_Instances.GetCount());
+  for (plUInt32 i = 0; i < m_Instances.GetCount(); ++i)
   {
-    ApplyModelViewProjectionMatrix(inst.m_Transform);
+    const plMat4 mMVP = m_mViewProjection * m_Instances[i].m_Transform.GetAsMat4();
+    m_pRasterizer->bakeModelViewProjection(mMVP.m_fElementsCM, m_BakedModelViewProjections[i].m_fElementsCM);
+  }
+
+  const plUInt32 uiBlocksY = m_pRasterizer->getBlocksY();
+
+  plUInt32 uiNumBands = 1;
+  if (cvar_SpatialCullingOcclusionParallelRasterization)
+  {
+    const plUInt32 uiNumThreads = plTaskSystem::GetWorkerThreadCount(plWorkerThreadType::ShortTasks) + 1;
+    uiNumBands = plMath::Clamp(uiBlocksY / s_uiMinBlockRowsPerBand, 1u, uiNumThreads);
+  }
+
+  if (uiNumBands == 1)
+  {
+    m_bAnyOccludersRasterized = RasterizeBand(0, uiBlocksY, uiMaxObjects);
+    return;
+  }
+
+  // every band owns its rows of the depth buffer, so the bands can be rasterized concurrently without any synchronization
+  plAtomicInteger32 iNumBandsWithOccluders;
+
+  // the budget is meant for the whole frame, an occluder that covers several bands counts once in each of them
+  const plUInt32 uiMaxObjectsPerBand = plMath::Max(1u, (uiMaxObjects + uiNumBands - 1) / uiNumBands);
+
+  plParallelForParams params;
+  params.m_uiBinSize = 1;
+  params.m_uiMaxTasksPerThread = 1;
+
+  plTaskSystem::ParallelForIndexed(0, uiNumBands, [&](plUInt32 uiStartIndex, plUInt32 uiEndIndex) {
+    for (plUInt32 uiBand = uiStartIndex; uiBand < uiEndIndex; ++uiBand)
+    {
+      const plUInt32 uiBlockMinY = uiBand * uiBlocksY / uiNumBands;
+      const plUInt32 uiBlockMaxY = (uiBand + 1) * uiBlocksY / uiNumBands;
+
+      if (RasterizeBand(uiBlockMinY, uiBlockMaxY, uiMaxObjectsPerBand))
+      {
+        iNumBandsWithOccluders.Increment();
+      }
+    }
+  },
+    "Occlusion::RasterizeBand", plTaskNesting::Maybe, params);
+
+  m_bAnyOccludersRasterized = iNumBandsWithOccluders > 0;
+#endif
+}
+
+bool plRasterizerView::RasterizeBand(plUInt32 uiBlockMinY, plUInt32 uiBlockMaxY, plUInt32 uiMaxObjects)
+{
+  bool bAnyOccludersRasterized = false;
+
+#if PL_ENABLED(PL_RASTERIZER_SUPPORTED)
+
+  for (plUInt32 i = 0; i < m_Instances.GetCount(); ++i)
+  {
+    const float* pMVP = m_BakedModelViewProjections[i].m_fElementsCM;
 
     bool bNeedsClipping;
-    const Occluder& occluder = inst.m_pObject->m_Occluder;
+    const Occluder& occluder = m_Instances[i].m_pObject->m_Occluder;
 
-    if (m_pRasterizer->queryVisibility(occluder.m_boundsMin, occluder.m_boundsMax, bNeedsClipping))
+    // objects are sorted front to back, so this skips occluders that are already hidden by closer ones in this band
+    if (m_pRasterizer->queryVisibility(occluder.m_boundsMin, occluder.m_boundsMax, bNeedsClipping, pMVP, uiBlockMinY, uiBlockMaxY))
     {
-      m_bAnyOccludersRasterized = true;
+      bAnyOccludersRasterized = true;
 
       if (bNeedsClipping)
       {
-        m_pRasterizer->rasterize<true>(occluder);
+        m_pRasterizer->rasterize<true>(occluder, pMVP, uiBlockMinY, uiBlockMaxY);
       }
       else
       {
-        m_pRasterizer->rasterize<false>(occluder);
+        m_pRasterizer->rasterize<false>(occluder, pMVP, uiBlockMinY, uiBlockMaxY);
       }
 
       if (--uiMaxObjects == 0)
-        return;
+        break;
     }
   }
 #endif
+
+  return bAnyOccludersRasterized;
 }
 
 void plRasterizerView::UpdateViewProjectionMatrix()
@@ -112,14 +181,6 @@ void plRasterizerView::UpdateViewProjectionMatrix()
   m_mViewProjection = mProjection * m_pCamera->GetViewMatrix();
 }
 
-void plRasterizerView::ApplyModelViewProjectionMatrix(const plTransform& modelTransform)
-{
-  const plMat4 mModel = modelTransform.GetAsMat4();
-  const plMat4 mMVP = m_mViewProjection * mModel;
-
-  m_pRasterizer->setModelViewProjection(mMVP.m_fElementsCM);
-}
-
 void plRasterizerView::SortObjectsFrontToBack()
 {
 #if PL_ENABLED(PL_RASTERIZER_SUPPORTED)
@@ -158,6 +219,40 @@ bool plRasterizerView::IsVisible(const plSimdBBox& aabb) const
 #endif
 }
 
+plUInt32 plRasterizerView::GetOccludedMask(plArrayPtr<const plSimdBBox> boxes) const
+{
+  PL_ASSERT_DEBUG(boxes.GetCount() <= 32, "Too many boxes, at most 32 can be tested at once.");
+
+#if PL_ENABLED(PL_RASTERIZER_SUPPORTED)
+  if (!m_bAnyOccludersRasterized || boxes.IsEmpty())
+    return 0; // assume that people already do frustum culling anyway
+
+  PL_PROFILE_SCOPE("Occlusion::GetOccludedMask");
+
+  __m128 boundsMin[32];
+  __m128 boundsMax[32];
+
+  for (plUInt32 i = 0; i < boxes.GetCount(); ++i)
+  {
+    plSimdVec4f vmin = boxes[i].m_Min;
+    plSimdVec4f vmax = boxes[i].m_Max;
+
+    // plSimdBBox makes no guarantees what's in the W component
+    // but the SW rasterizer requires them to be 1
+    vmin.SetW(1);
+    vmax.SetW(1);
+
+    boundsMin[i] = vmin.m_v;
+    boundsMax[i] = vmax.m_v;
+  }
+
+  const plUInt32 uiAllBoxesMask = boxes.GetCount() < 32 ? (1u << boxes.GetCount()) - 1 : 0xFFFFFFFFu;
+  return ~m_pRasterizer->queryVisibilityBatch(boundsMin, boundsMax, boxes.GetCount()) & uiAllBoxesMask;
+#else
+  return 0;
+#endif
+}
+
 plRasterizerView* plRasterizerViewPool::GetRasterizerView(plUInt32 uiWidth, plUInt32 uiHeight, float fAspectRatio)
 {
   PL_PROFILE_SCOPE("Occlusion::GetViewFromPool");
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Math/Transform.h>
 #include <Foundation/Threading/Mutex.h>
 #include <Foundation/Types/ArrayPtr.h>
@@ -56,6 +57,12 @@ public:
   /// Note: This only works after EndScene().
   bool IsVisible(const plSimdBBox& aabb) const;
 
+  /// \brief Checks up to 32 boxes at once. Returns a bitmask in which bit i is set if boxes[i] is fully occluded.
+  ///
+  /// The boxes are transformed eight at a time with SIMD and big boxes are rejected early using a coarse level of the hierarchical depth buffer.
+  /// Note: This only works after EndScene().
+  plUInt32 GetOccludedMask(plArrayPtr<const plSimdBBox> boxes) const;
+
   /// \brief Wether any occluder was actually added and also rasterized. If not, no need to do any visibility checks.
   bool HasRasterizedAnyOccluders() const
   {
@@ -65,8 +72,8 @@ public:
 private:
   void SortObjectsFrontToBack();
   void RasterizeObjects(plUInt32 uiMaxObjects);
+  bool RasterizeBand(plUInt32 uiBlockMinY, plUInt32 uiBlockMaxY, plUInt32 uiMaxObjects);
   void UpdateViewProjectionMatrix();
-  void ApplyModelViewProjectionMatrix(const plTransform& modelTransform);
 
   bool m_bAnyOccludersRasterized = false;
   const plCamera* m_pCamera = nullptr;
@@ -83,6 +90,7 @@ private:
 
   plDeque<Instance> m_Instances;
   plMat4 m_mViewProjection;
+  plDynamicArray<plMat4> m_BakedModelViewProjections; ///< Per instance, in the format the rasterizer uses internally
 };
 
 class plRasterizerViewPool
@@ -293,11 +293,14 @@ Rasterizer::Rasterizer(uint32_t width, uint32_t height)
   , m_height(height)
   , m_blocksX(width / 8)
   , m_blocksY(height / 8)
+  , m_coarseBlocksX((width / 8 + 3) / 4)
+  , m_coarseBlocksY((height / 8 + 3) / 4)
 {
   assert(width % 8 == 0 && height % 8 == 0);
 
   m_depthBuffer.resize(width * height / 8);
   m_hiZ.resize(m_blocksX * m_blocksY + 8, 0); // Add some extra padding to support out-of-bounds reads
+  m_hiZCoarse.resize(m_coarseBlocksX * m_coarseBlocksY, 0);
 
   precomputeRasterizationTable();
 }
@@ -317,6 +320,18 @@ void Rasterizer::setModelViewProjection(const float* matrix)
   _mm_storeu_ps(m_modelViewProjectionRaw + 8, mat2);
   _mm_storeu_ps(m_modelViewProjectionRaw + 12, mat3);
 
+  bakeModelViewProjection(matrix, m_modelViewProjection);
+}
+
+void Rasterizer::bakeModelViewProjection(const float* matrix, float* bakedMatrix) const
+{
+  __m128 mat0 = _mm_loadu_ps(matrix + 0);
+  __m128 mat1 = _mm_loadu_ps(matrix + 4);
+  __m128 mat2 = _mm_loadu_ps(matrix + 8);
+  __m128 mat3 = _mm_loadu_ps(matrix + 12);
+
+  _MM_TRANSPOSE4_PS(mat0, mat1, mat2, mat3);
+
   // Bake viewport transform into matrix and 6shift by half a block
   mat0 = _mm_mul_ps(_mm_add_ps(mat0, mat3), _mm_set1_ps(m_width * 0.5f - 4.0f));
   mat1 = _mm_mul_ps(_mm_add_ps(mat1, mat3), _mm_set1_ps(m_height * 0.5f - 4.0f));
@@ -327,10 +342,10 @@ void Rasterizer::setModelViewProjection(const float* matrix)
   _MM_TRANSPOSE4_PS(mat0, mat1, mat2, mat3);
 
   // Store prebaked cols
-  _mm_storeu_ps(m_modelViewProjection + 0, mat0);
-  _mm_storeu_ps(m_modelViewProjection + 4, mat1);
-  _mm_storeu_ps(m_modelViewProjection + 8, mat2);
-  _mm_storeu_ps(m_modelViewProjection + 12, mat3);
+  _mm_storeu_ps(bakedMatrix + 0, mat0);
+  _mm_storeu_ps(bakedMatrix + 4, mat1);
+  _mm_storeu_ps(bakedMatrix + 8, mat2);
+  _mm_storeu_ps(bakedMatrix + 12, mat3);
 }
 
 void Rasterizer::clear()
@@ -347,9 +362,47 @@ void Rasterizer::clear()
     _mm_storeu_si128(pHiZ, clearValue);
     pHiZ++;
   }
+
+  m_hiZCoarseValid = false;
+}
+
+void Rasterizer::buildHiZHierarchy()
+{
+  for (uint32_t coarseY = 0; coarseY < m_coarseBlocksY; ++coarseY)
+  {
+    const uint32_t blockMinY = coarseY * 4;
+    const uint32_t blockMaxY = std::min(blockMinY + 4, m_blocksY);
+
+    for (uint32_t coarseX = 0; coarseX < m_coarseBlocksX; ++coarseX)
+    {
+      const uint32_t blockMinX = coarseX * 4;
+      const uint32_t blockMaxX = std::min(blockMinX + 4, m_blocksX);
+
+      uint16_t minZ = 0xFFFF;
+      for (uint32_t blockY = blockMinY; blockY < blockMaxY; ++blockY)
+      {
+        for (uint32_t blockX = blockMinX; blockX < blockMaxX; ++blockX)
+        {
+          const uint16_t hiZ = m_hiZ[blockY * m_blocksX + blockX];
+
+          // cleared blocks don't occlude anything
+          minZ = std::min<uint16_t>(minZ, hiZ == 1 ? 0 : hiZ);
+        }
+      }
+
+      m_hiZCoarse[coarseY * m_coarseBlocksX + coarseX] = minZ;
+    }
+  }
+
+  m_hiZCoarseValid = true;
 }
 
 bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needsClipping)
+{
+  return queryVisibility(boundsMin, boundsMax, needsClipping, m_modelViewProjection, 0, m_blocksY);
+}
+
+bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needsClipping, const float* bakedMatrix, uint32_t blockMinY, uint32_t blockMaxY) const
 {
   // Frustum culling is not necessary, because PL only calls this functions for objects that are definitely inside the frustum
   //
@@ -398,10 +451,10 @@ bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needs
   // }
 
   // Load prebaked projection matrix
-  __m128 col0 = _mm_loadu_ps(m_modelViewProjection + 0);
-  __m128 col1 = _mm_loadu_ps(m_modelViewProjection + 4);
-  __m128 col2 = _mm_loadu_ps(m_modelViewProjection + 8);
-  __m128 col3 = _mm_loadu_ps(m_modelViewProjection + 12);
+  __m128 col0 = _mm_loadu_ps(bakedMatrix + 0);
+  __m128 col1 = _mm_loadu_ps(bakedMatrix + 4);
+  __m128 col2 = _mm_loadu_ps(bakedMatrix + 8);
+  __m128 col3 = _mm_loadu_ps(bakedMatrix + 12);
 
   // Transform edges
   __m128 egde0 = _mm_mul_ps(col0, _mm_broadcastss_ps(extents));
@@ -502,8 +555,14 @@ bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needs
 
   uint32_t minX = bounds[0];
   uint32_t maxX = bounds[1];
-  uint32_t minY = bounds[2];
-  uint32_t maxY = bounds[3];
+  uint32_t minY = std::max<uint32_t>(bounds[2], blockMinY * 8);
+  uint32_t maxY = std::min<uint32_t>(bounds[3], blockMaxY * 8 - 1);
+
+  // No intersection with the tested rows
+  if (minY > maxY)
+  {
+    return false;
+  }
 
   __m128i depth = packDepthPremultiplied(corners[2], corners[6]);
 
@@ -517,6 +576,138 @@ bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needs
   return true;
 }
 
+uint32_t Rasterizer::queryVisibilityBatch(const __m128* boundsMin, const __m128* boundsMax, uint32_t count) const
+{
+  assert(count <= 32);
+
+  uint32_t visibleMask = 0;
+
+  for (uint32_t firstBox = 0; firstBox < count; firstBox += 8)
+  {
+    const uint32_t numBoxes = std::min(count - firstBox, 8u);
+
+    // Transpose boxes into SoA, unused lanes repeat the last box
+    alignas(32) float mins[3][8];
+    alignas(32) float extents[3][8];
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+      const uint32_t boxIdx = firstBox + std::min(i, numBoxes - 1);
+
+      alignas(16) float bmin[4];
+      alignas(16) float bmax[4];
+      _mm_store_ps(bmin, boundsMin[boxIdx]);
+      _mm_store_ps(bmax, boundsMax[boxIdx]);
+
+      for (uint32_t c = 0; c < 3; ++c)
+      {
+        mins[c][i] = bmin[c];
+        extents[c][i] = bmax[c] - bmin[c];
+      }
+    }
+
+    // One lane per box, transform all 8 corners like queryVisibility() does
+    __m256 base[4];
+    __m256 edges[3][4];
+    for (uint32_t j = 0; j < 4; ++j)
+    {
+      __m256 col0 = _mm256_broadcast_ss(m_modelViewProjection + 0 + j);
+      __m256 col1 = _mm256_broadcast_ss(m_modelViewProjection + 4 + j);
+      __m256 col2 = _mm256_broadcast_ss(m_modelViewProjection + 8 + j);
+      __m256 col3 = _mm256_broadcast_ss(m_modelViewProjection + 12 + j);
+
+      base[j] = _mm256_fmadd_ps(col0, _mm256_load_ps(mins[0]), _mm256_fmadd_ps(col1, _mm256_load_ps(mins[1]), _mm256_fmadd_ps(col2, _mm256_load_ps(mins[2]), col3)));
+
+      edges[0][j] = _mm256_mul_ps(col0, _mm256_load_ps(extents[0]));
+      edges[1][j] = _mm256_mul_ps(col1, _mm256_load_ps(extents[1]));
+      edges[2][j] = _mm256_mul_ps(col2, _mm256_load_ps(extents[2]));
+    }
+
+    __m256 maxExtent = _mm256_max_ps(_mm256_max_ps(_mm256_load_ps(extents[0]), _mm256_load_ps(extents[1])), _mm256_load_ps(extents[2]));
+    __m256 nearPlaneEpsilon = _mm256_mul_ps(maxExtent, _mm256_set1_ps(0.001f));
+
+    __m256 closeToNearPlane = _mm256_setzero_ps();
+    __m256 minsX = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    __m256 minsY = minsX;
+    __m256 maxsX = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+    __m256 maxsY = maxsX;
+    __m256 maxsZ = maxsX;
+
+    for (uint32_t corner = 0; corner < 8; ++corner)
+    {
+      __m256 c[4];
+      for (uint32_t j = 0; j < 4; ++j)
+      {
+        c[j] = base[j];
+        if (corner & 1)
+          c[j] = _mm256_add_ps(c[j], edges[0][j]);
+        if (corner & 2)
+          c[j] = _mm256_add_ps(c[j], edges[1][j]);
+        if (corner & 4)
+          c[j] = _mm256_add_ps(c[j], edges[2][j]);
+      }
+
+      closeToNearPlane = _mm256_or_ps(closeToNearPlane, _mm256_cmp_ps(c[3], nearPlaneEpsilon, _CMP_LT_OQ));
+
+      // Perspective division
+      __m256 invW = _mm256_rcp_ps(c[3]);
+      __m256 x = _mm256_mul_ps(c[0], invW);
+      __m256 y = _mm256_mul_ps(c[1], invW);
+      __m256 z = _mm256_mul_ps(c[2], invW);
+
+      minsX = _mm256_min_ps(minsX, x);
+      maxsX = _mm256_max_ps(maxsX, x);
+      minsY = _mm256_min_ps(minsY, y);
+      maxsY = _mm256_max_ps(maxsY, y);
+      maxsZ = _mm256_max_ps(maxsZ, z);
+    }
+
+    // Inflate, clamp and round the same way as queryVisibility()
+    const __m256 inc = _mm256_set1_ps(2.0f);
+    minsX = _mm256_max_ps(_mm256_sub_ps(minsX, inc), _mm256_setzero_ps());
+    minsY = _mm256_max_ps(_mm256_sub_ps(minsY, inc), _mm256_setzero_ps());
+    maxsX = _mm256_min_ps(_mm256_add_ps(maxsX, inc), _mm256_set1_ps(float(m_width - 1)));
+    maxsY = _mm256_min_ps(_mm256_add_ps(maxsY, inc), _mm256_set1_ps(float(m_height - 1)));
+
+    alignas(32) int32_t boundsMinX[8];
+    alignas(32) int32_t boundsMaxX[8];
+    alignas(32) int32_t boundsMinY[8];
+    alignas(32) int32_t boundsMaxY[8];
+    alignas(32) int32_t boundsMaxZ[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(boundsMinX), _mm256_cvttps_epi32(_mm256_round_ps(minsX, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(boundsMaxX), _mm256_cvttps_epi32(_mm256_round_ps(maxsX, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC)));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(boundsMinY), _mm256_cvttps_epi32(_mm256_round_ps(minsY, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(boundsMaxY), _mm256_cvttps_epi32(_mm256_round_ps(maxsY, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC)));
+
+    // Same packing as packDepthPremultiplied()
+    __m256i packedZ = _mm256_srai_epi32(_mm256_castps_si256(maxsZ), 12);
+    packedZ = _mm256_min_epi32(_mm256_max_epi32(packedZ, _mm256_setzero_si256()), _mm256_set1_epi32(0xFFFF));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(boundsMaxZ), packedZ);
+
+    const uint32_t needsClippingMask = _mm256_movemask_ps(closeToNearPlane);
+
+    for (uint32_t i = 0; i < numBoxes; ++i)
+    {
+      bool visible;
+      if (needsClippingMask & (1u << i))
+      {
+        visible = true;
+      }
+      else if (boundsMinX[i] >= boundsMaxX[i] || boundsMinY[i] >= boundsMaxY[i])
+      {
+        visible = false;
+      }
+      else
+      {
+        visible = query2D(boundsMinX[i], boundsMaxX[i], boundsMinY[i], boundsMaxY[i], boundsMaxZ[i]);
+      }
+
+      visibleMask |= uint32_t(visible) << (firstBox + i);
+    }
+  }
+
+  return visibleMask;
+}
+
 bool Rasterizer::query2D(uint32_t minX, uint32_t maxX, uint32_t minY, uint32_t maxY, uint32_t maxZ) const
 {
   const uint16_t* pHiZBuffer = &*m_hiZ.begin();
@@ -528,6 +719,31 @@ bool Rasterizer::query2D(uint32_t minX, uint32_t maxX, uint32_t minY, uint32_t m
   uint32_t blockMinY = minY / 8;
   uint32_t blockMaxY = maxY / 8;
 
+  // Pretest against the coarse Hi Z level, if all coarse blocks occlude the query region, it is not visible
+  if (m_hiZCoarseValid)
+  {
+    bool allCoarseBlocksOcclude = true;
+
+    for (uint32_t coarseY = blockMinY / 4; allCoarseBlocksOcclude && coarseY <= blockMaxY / 4; ++coarseY)
+    {
+      const uint16_t* pCoarseHiZ = &m_hiZCoarse[coarseY * m_coarseBlocksX];
+
+      for (uint32_t coarseX = blockMinX / 4; coarseX <= blockMaxX / 4; ++coarseX)
+      {
+        if (maxZ > pCoarseHiZ[coarseX])
+        {
+          allCoarseBlocksOcclude = false;
+          break;
+        }
+      }
+    }
+
+    if (allCoarseBlocksOcclude)
+    {
+      return false;
+    }
+  }
+
   __m128i maxZV = _mm_set1_epi16(uint16_t(maxZ));
 
   // Pretest against Hi-Z
@@ -854,6 +1070,12 @@ void Rasterizer::precomputeRasterizationTable()
 
 template <bool possiblyNearClipped>
 void Rasterizer::rasterize(const Occluder& occluder)
+{
+  rasterize<possiblyNearClipped>(occluder, m_modelViewProjection, 0, m_blocksY);
+}
+
+template <bool possiblyNearClipped>
+void Rasterizer::rasterize(const Occluder& occluder, const float* bakedMatrix, uint32_t blockMinY, uint32_t blockMaxY)
 {
   const __m256i* vertexData = occluder.m_vertexData;
   size_t packetCount = occluder.m_packetCount;
@@ -862,10 +1084,10 @@ void Rasterizer::rasterize(const Occluder& occluder)
   __m256i maskZ = _mm256_set1_epi32(1023);
 
   // Note that unaligned loads do not have a latency penalty on CPUs with SSE4 support
-  __m128 mat0 = _mm_loadu_ps(m_modelViewProjection + 0);
-  __m128 mat1 = _mm_loadu_ps(m_modelViewProjection + 4);
-  __m128 mat2 = _mm_loadu_ps(m_modelViewProjection + 8);
-  __m128 mat3 = _mm_loadu_ps(m_modelViewProjection + 12);
+  __m128 mat0 = _mm_loadu_ps(bakedMatrix + 0);
+  __m128 mat1 = _mm_loadu_ps(bakedMatrix + 4);
+  __m128 mat2 = _mm_loadu_ps(bakedMatrix + 8);
+  __m128 mat3 = _mm_loadu_ps(bakedMatrix + 12);
 
   __m128 boundsMin = occluder.m_refMin;
   __m128 boundsExtents = _mm_sub_ps(occluder.m_refMax, boundsMin);
@@ -1170,9 +1392,9 @@ void Rasterizer::rasterize(const Occluder& occluder)
     // Clamp and round
     __m256i minX, minY, maxX, maxY;
     minX = _mm256_max_epi32(_mm256_cvttps_epi32(_mm256_add_ps(minFx, _mm256_set1_ps(4.9999f / 8.0f))), _mm256_setzero_si256());
-    minY = _mm256_max_epi32(_mm256_cvttps_epi32(_mm256_add_ps(minFy, _mm256_set1_ps(4.9999f / 8.0f))), _mm256_setzero_si256());
+    minY = _mm256_max_epi32(_mm256_cvttps_epi32(_mm256_add_ps(minFy, _mm256_set1_ps(4.9999f / 8.0f))), _mm256_set1_epi32(blockMinY));
     maxX = _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_add_ps(maxFx, _mm256_set1_ps(11.0f / 8.0f))), _mm256_set1_epi32(m_blocksX));
-    maxY = _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_add_ps(maxFy, _mm256_set1_ps(11.0f / 8.0f))), _mm256_set1_epi32(m_blocksY));
+    maxY = _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_add_ps(maxFy, _mm256_set1_ps(11.0f / 8.0f))), _mm256_set1_epi32(blockMaxY));
 
     // Check overlap between bounding box and frustum
     __m256i inFrustum = _mm256_and_si256(_mm256_cmpgt_epi32(maxX, minX), _mm256_cmpgt_epi32(maxY, minY));
@@ -1546,6 +1768,8 @@ void Rasterizer::rasterize(const Occluder& occluder)
 // Force template instantiations
 template void Rasterizer::rasterize<true>(const Occluder& occluder);
 template void Rasterizer::rasterize<false>(const Occluder& occluder);
+template void Rasterizer::rasterize<true>(const Occluder& occluder, const float* bakedMatrix, uint32_t blockMinY, uint32_t blockMaxY);
+template void Rasterizer::rasterize<false>(const Occluder& occluder, const float* bakedMatrix, uint32_t blockMinY, uint32_t blockMaxY);
 
 #endif
 
@@ -17,13 +17,31 @@ public:
   void setModelViewProjection(const float* matrix);
   void clear();
 
+  // Computes the prebaked matrix that setModelViewProjection() would use, so that several threads can rasterize with different matrices.
+  void bakeModelViewProjection(const float* matrix, float* bakedMatrix) const;
+
   template <bool possiblyNearClipped>
   void rasterize(const Occluder& occluder);
 
+  // Only writes to the block rows [blockMinY, blockMaxY). Different row ranges can be rasterized concurrently.
+  template <bool possiblyNearClipped>
+  void rasterize(const Occluder& occluder, const float* bakedMatrix, uint32_t blockMinY, uint32_t blockMaxY);
+
   bool queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needsClipping);
 
+  // Only tests the block rows [blockMinY, blockMaxY).
+  bool queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needsClipping, const float* bakedMatrix, uint32_t blockMinY, uint32_t blockMaxY) const;
+
+  // Tests up to 32 boxes, 8 at a time, and returns a bitmask of the visible ones.
+  uint32_t queryVisibilityBatch(const __m128* boundsMin, const __m128* boundsMax, uint32_t count) const;
+
   bool query2D(uint32_t minX, uint32_t maxX, uint32_t minY, uint32_t maxY, uint32_t maxZ) const;
 
+  // Builds a coarse level on top of the Hi Z buffer that query2D() uses to reject big query regions early. Invalidated by clear().
+  void buildHiZHierarchy();
+
+  uint32_t getBlocksY() const { return m_blocksY; }
+
   void readBackDepth(void* target) const;
 #else
   Rasterizer(uint32_t width, uint32_t height)
@@ -33,21 +51,37 @@ public:
   void setModelViewProjection(const float* pMatrix) {}
   void clear() {}
 
+  void bakeModelViewProjection(const float* pMatrix, float* pBakedMatrix) const {}
+
   template <bool possiblyNearClipped>
   void rasterize(const Occluder& occluder)
   {
   }
 
-  bool queryVisibility(...)
+  template <bool possiblyNearClipped>
+  void rasterize(const Occluder& occluder, const float* pBakedMatrix, uint32_t blockMinY, uint32_t blockMaxY)
+  {
+  }
+
+  bool queryVisibility(...) const
   {
     return true;
   }
 
+  uint32_t queryVisibilityBatch(const void* pBoundsMin, const void* pBoundsMax, uint32_t count) const
+  {
+    return count < 32 ? (1u << count) - 1 : 0xFFFFFFFFu;
+  }
+
   bool query2D(uint32_t minX, uint32_t maxX, uint32_t minY, uint32_t maxY, uint32_t maxZ) const
   {
     return true;
   }
 
+  void buildHiZHierarchy() {}
+
+  uint32_t getBlocksY() const { return 1; }
+
   void readBackDepth(void* pTarget) const {}
 #endif
 
@@ -81,10 +115,14 @@ private:
   static std::vector<int64_t> m_precomputedRasterTables;
   std::vector<__m128i> m_depthBuffer;
   std::vector<uint16_t> m_hiZ;
+  std::vector<uint16_t> m_hiZCoarse; // min of 4x4 Hi Z blocks
+  bool m_hiZCoarseValid = false;
 
   uint32_t m_width;
   uint32_t m_height;
   uint32_t m_blocksX;
   uint32_t m_blocksY;
+  uint32_t m_coarseBlocksX;
+  uint32_t m_coarseBlocksY;
 #endif
 };
@@ -129,5 +129,6 @@ PL_STATICLINK_LIBRARY(RendererCore)
   PL_STATICLINK_REFERENCE(RendererCore_Textures_Texture3DResource);
   PL_STATICLINK_REFERENCE(RendererCore_Textures_TextureCubeResource);
   PL_STATICLINK_REFERENCE(RendererCore_Textures_TextureLoader);
+  PL_STATICLINK_REFERENCE(RendererCore_Textures_TextureStreaming);
   PL_STATICLINK_REFERENCE(RendererCore_Utils_Implementation_WorldGeoExtractionUtil);
 }
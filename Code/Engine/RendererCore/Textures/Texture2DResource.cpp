@@ -259,6 +259,8 @@ PL_RESOURCE_IMPLEMENT_CREATEABLE(plTexture2DResource, plTexture2DResourceDescrip
 
   pDevice->GetTexture(m_hGALTexture[m_uiLoadedTextures])->SetDebugName(GetResourceDescription());
 
+  m_uiResolution[m_uiLoadedTextures] = plMath::Max(m_uiWidth, m_uiHeight);
+
   if (!m_hSamplerState.IsInvalidated())
   {
     pDevice->DestroySamplerState(m_hSamplerState);
@@ -330,6 +332,8 @@ PL_RESOURCE_IMPLEMENT_CREATEABLE(plRenderToTexture2DResource, plRenderToTexture2
 
   pDevice->GetTexture(m_hGALTexture[m_uiLoadedTextures])->SetDebugName(GetResourceDescription());
 
+  m_uiResolution[m_uiLoadedTextures] = plMath::Max(m_uiWidth, m_uiHeight);
+
   if (!m_hSamplerState.IsInvalidated())
   {
     pDevice->DestroySamplerState(m_hSamplerState);
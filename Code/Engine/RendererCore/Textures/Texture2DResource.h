@@ -53,6 +53,9 @@ public:
   const plGALTextureHandle& GetGALTexture() const { return m_hGALTexture[m_uiLoadedTextures - 1]; }
   const plGALSamplerStateHandle& GetGALSamplerState() const { return m_hSamplerState; }
 
+  /// \brief Returns the larger dimension of the top mip level of the given loaded quality level. Quality level 0 is the lowest one.
+  plUInt32 GetQualityLevelResolution(plUInt32 uiQualityLevel) const { return uiQualityLevel < m_uiLoadedTextures ? m_uiResolution[uiQualityLevel] : 0; }
+
 protected:
   virtual plResourceLoadDesc UnloadData(Unload WhatToUnload) override;
   virtual plResourceLoadDesc UpdateContent(plStreamReader* Stream) override;
@@ -63,6 +66,7 @@ protected:
   plUInt8 m_uiLoadedTextures = 0;
   plGALTextureHandle m_hGALTexture[2];
   plUInt32 m_uiMemoryGPU[2] = {0, 0};
+  plUInt32 m_uiResolution[2] = {0, 0};
 
   plGALTextureType::Enum m_Type = plGALTextureType::Invalid;
   plGALResourceFormat::Enum m_Format = plGALResourceFormat::Invalid;
@@ -0,0 +1,383 @@
+#include <RendererCore/RendererCorePCH.h>
+
+#include <Core/Graphics/Camera.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Utilities/Stats.h>
+#include <RendererCore/Pipeline/ViewData.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererCore/Textures/TextureStreaming.h>
+
+plCVarBool cvar_StreamingTextures("Streaming.Textures", true, plCVarFlags::Default, "Load and discard texture quality levels depending on how large the textures appear on screen");
+plCVarFloat cvar_StreamingTextureMipBias("Streaming.TextureMipBias", 0.0f, plCVarFlags::Default, "Positive values reduce the texture resolution that is considered necessary, negative values increase it");
+plCVarInt cvar_StreamingTextureLoadsPerFrame("Streaming.TextureLoadsPerFrame", 4, plCVarFlags::Default, "How many texture quality levels may be requested for loading per frame");
+plCVarInt cvar_StreamingTextureDiscardsPerFrame("Streaming.TextureDiscardsPerFrame", 4, plCVarFlags::Default, "How many texture quality levels may be discarded per frame");
+plCVarFloat cvar_StreamingTextureDiscardDelay("Streaming.TextureDiscardDelay", 5.0f, plCVarFlags::Default, "How many seconds a texture quality level has to be unnecessary before it gets discarded");
+
+// clang-format off
+PL_BEGIN_SUBSYSTEM_DECLARATION(RendererCore, TextureStreaming)
+  BEGIN_SUBSYSTEM_DEPENDENCIES
+    "Foundation",
+    "Core",
+    "RenderWorld"
+  END_SUBSYSTEM_DEPENDENCIES
+
+  ON_HIGHLEVELSYSTEMS_STARTUP
+  {
+    plTextureStreaming::OnEngineStartup();
+  }
+
+  ON_HIGHLEVELSYSTEMS_SHUTDOWN
+  {
+    plTextureStreaming::OnEngineShutdown();
+  }
+PL_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+struct plTextureStreaming::Data
+{
+  struct TrackedTexture
+  {
+    float m_fRequiredResolution = 0.0f;
+    plTime m_tLastUsed;
+    plTime m_tLastHighDetailUse; ///< The last time the highest loaded quality level was actually needed.
+  };
+
+  struct Candidate
+  {
+    plTexture2DResourceHandle m_hTexture;
+    float m_fPriority = 0.0f;
+  };
+
+  // filled by the renderers, only accessed on the rendering thread
+  plHashTable<plMaterialResourceHandle, float> m_RenderMaterialReports;
+  plHashTable<plTexture2DResourceHandle, float> m_RenderTextureReports;
+
+  plMutex m_Mutex;
+
+  // handed over from the rendering thread once per frame, protected by m_Mutex
+  plHashTable<plMaterialResourceHandle, float> m_MaterialReports;
+  plHashTable<plTexture2DResourceHandle, float> m_TextureReports;
+
+  // only accessed during Update()
+  plHashTable<plMaterialResourceHandle, float> m_MaterialUsage;
+  plHashTable<plTexture2DResourceHandle, float> m_TextureUsage;
+  plHashTable<plTexture2DResourceHandle, TrackedTexture> m_TrackedTextures;
+  plDynamicArray<Candidate> m_LoadCandidates;
+  plDynamicArray<Candidate> m_DiscardCandidates;
+
+  plUInt32 m_uiNumLoadedQualityLevels = 0;
+  plUInt32 m_uiNumDiscardedQualityLevels = 0;
+};
+
+plTextureStreaming::Data* plTextureStreaming::s_pData = nullptr;
+
+namespace
+{
+  template <typename KeyType>
+  void AddUsage(plHashTable<KeyType, float>& ref_usage, const KeyType& hResource, float fScreenSize)
+  {
+    bool bExisted = false;
+    float& fMaxScreenSize = ref_usage.FindOrAdd(hResource, &bExisted);
+    fMaxScreenSize = bExisted ? plMath::Max(fMaxScreenSize, fScreenSize) : fScreenSize;
+  }
+
+  template <typename KeyType>
+  void MergeUsage(plHashTable<KeyType, float>& ref_usage, plHashTable<KeyType, float>& ref_reports)
+  {
+    if (ref_usage.IsEmpty())
+    {
+      ref_usage.Swap(ref_reports);
+      return;
+    }
+
+    for (auto it = ref_reports.GetIterator(); it.IsValid(); ++it)
+    {
+      AddUsage(ref_usage, it.Key(), it.Value());
+    }
+
+    ref_reports.Clear();
+  }
+} // namespace
+
+// static
+bool plTextureStreaming::ShouldReportUsage(const plRenderViewContext& renderViewContext)
+{
+  return cvar_StreamingTextures && renderViewContext.m_pViewData->m_CameraUsageHint != plCameraUsageHint::Shadow;
+}
+
+// static
+void plTextureStreaming::ReportMaterialUsage(const plMaterialResourceHandle& hMaterial, float fScreenSize)
+{
+  if (!hMaterial.IsValid() || s_pData == nullptr)
+    return;
+
+  PL_ASSERT_DEBUG(plRenderWorld::IsRenderingThread(), "Texture usage must be reported on the rendering thread");
+  AddUsage(s_pData->m_RenderMaterialReports, hMaterial, fScreenSize);
+}
+
+// static
+void plTextureStreaming::ReportTextureUsage(const plTexture2DResourceHandle& hTexture, float fScreenSize)
+{
+  if (!hTexture.IsValid() || s_pData == nullptr)
+    return;
+
+  PL_ASSERT_DEBUG(plRenderWorld::IsRenderingThread(), "Texture usage must be reported on the rendering thread");
+  AddUsage(s_pData->m_RenderTextureReports, hTexture, fScreenSize);
+}
+
+// static
+float plTextureStreaming::ComputeScreenSize(const plBoundingBoxSphere& bounds, const plRenderViewContext& renderViewContext)
+{
+  return plTextureStreamingScreenSize(renderViewContext).Compute(bounds);
+}
+
+// static
+void plTextureStreaming::OnEngineStartup()
+{
+  s_pData = PL_DEFAULT_NEW(plTextureStreaming::Data);
+
+  plRenderWorld::GetExtractionEvent().AddEventHandler(OnExtractionEvent);
+  plRenderWorld::GetRenderEvent().AddEventHandler(OnRenderEvent);
+}
+
+// static
+void plTextureStreaming::OnEngineShutdown()
+{
+  plRenderWorld::GetExtractionEvent().RemoveEventHandler(OnExtractionEvent);
+  plRenderWorld::GetRenderEvent().RemoveEventHandler(OnRenderEvent);
+
+  PL_DEFAULT_DELETE(s_pData);
+}
+
+// static
+void plTextureStreaming::OnExtractionEvent(const plRenderWorldExtractionEvent& e)
+{
+  if (e.m_Type != plRenderWorldExtractionEvent::Type::EndExtraction)
+    return;
+
+  if (!cvar_StreamingTextures)
+  {
+    StopStreaming();
+    return;
+  }
+
+  Update();
+}
+
+// static
+void plTextureStreaming::OnRenderEvent(const plRenderWorldRenderEvent& e)
+{
+  if (e.m_Type != plRenderWorldRenderEvent::Type::EndRender)
+    return;
+
+  if (s_pData->m_RenderMaterialReports.IsEmpty() && s_pData->m_RenderTextureReports.IsEmpty())
+    return;
+
+  // everything that was rendered this frame is handed over at once, so the renderers never have to lock
+  PL_LOCK(s_pData->m_Mutex);
+  MergeUsage(s_pData->m_MaterialReports, s_pData->m_RenderMaterialReports);
+  MergeUsage(s_pData->m_TextureReports, s_pData->m_RenderTextureReports);
+}
+
+// static
+void plTextureStreaming::Update()
+{
+  PL_PROFILE_SCOPE("Texture Streaming Update");
+
+  {
+    PL_LOCK(s_pData->m_Mutex);
+    s_pData->m_MaterialUsage.Swap(s_pData->m_MaterialReports);
+    s_pData->m_TextureUsage.Swap(s_pData->m_TextureReports);
+  }
+
+  // resolve the textures of all used materials
+  for (auto it = s_pData->m_MaterialUsage.GetIterator(); it.IsValid(); ++it)
+  {
+    plResourceLock<plMaterialResource> pMaterial(it.Key(), plResourceAcquireMode::PointerOnly);
+
+    if (pMaterial->GetLoadingState() != plResourceState::Loaded)
+      continue;
+
+    for (auto itTexture = pMaterial->GetOrUpdateCachedValues()->m_Texture2DBindings.GetIterator(); itTexture.IsValid(); ++itTexture)
+    {
+      if (itTexture.Value().IsValid())
+      {
+        AddUsage(s_pData->m_TextureUsage, itTexture.Value(), it.Value());
+      }
+    }
+  }
+
+  s_pData->m_MaterialUsage.Clear();
+
+  const plTime tNow = plTime::Now();
+  const plTime tDiscardDelay = plTime::MakeFromSeconds(plMath::Max(0.0f, cvar_StreamingTextureDiscardDelay.GetValue()));
+  const float fMipBiasScale = plMath::Pow(2.0f, -cvar_StreamingTextureMipBias);
+
+  for (auto it = s_pData->m_TextureUsage.GetIterator(); it.IsValid(); ++it)
+  {
+    bool bExisted = false;
+    Data::TrackedTexture& tracked = s_pData->m_TrackedTextures.FindOrAdd(it.Key(), &bExisted);
+
+    if (!bExisted)
+    {
+      plResourceManager::SetQualityLevelStreaming(it.Key(), true);
+      tracked.m_tLastHighDetailUse = tNow;
+    }
+
+    tracked.m_fRequiredResolution = it.Value() * fMipBiasScale;
+    tracked.m_tLastUsed = tNow;
+  }
+
+  s_pData->m_TextureUsage.Clear();
+
+  // decide which textures need more or less detail
+  for (auto it = s_pData->m_TrackedTextures.GetIterator(); it.IsValid();)
+  {
+    Data::TrackedTexture& tracked = it.Value();
+    const bool bUnused = tNow - tracked.m_tLastUsed > tDiscardDelay;
+    const float fRequiredResolution = bUnused ? 0.0f : tracked.m_fRequiredResolution;
+
+    bool bKeepTracking = true;
+
+    {
+      plResourceLock<plTexture2DResource> pTexture(it.Key(), plResourceAcquireMode::PointerOnly);
+      const plUInt32 uiLoadedLevels = pTexture->GetNumQualityLevelsDiscardable();
+
+      if (pTexture->GetLoadingState() != plResourceState::Loaded || uiLoadedLevels == 0)
+      {
+        // acquiring the texture takes care of loading the first quality level
+        bKeepTracking = !bUnused;
+      }
+      else if (pTexture->GetBaseResourceFlags().IsSet(plResourceFlags::IsQueuedForLoading))
+      {
+        // already loading
+      }
+      else
+      {
+        const float fResolution = static_cast<float>(pTexture->GetQualityLevelResolution(uiLoadedLevels - 1));
+
+        if (fRequiredResolution > fResolution && pTexture->GetNumQualityLevelsLoadable() > 0)
+        {
+          tracked.m_tLastHighDetailUse = tNow;
+
+          // the blurrier the texture currently looks, the more important the next quality level is
+          s_pData->m_LoadCandidates.PushBack({it.Key(), fRequiredResolution / plMath::Max(fResolution, 1.0f)});
+        }
+        else if (uiLoadedLevels > 1)
+        {
+          if (fRequiredResolution > static_cast<float>(pTexture->GetQualityLevelResolution(uiLoadedLevels - 2)))
+          {
+            tracked.m_tLastHighDetailUse = tNow;
+          }
+          else if (tNow - tracked.m_tLastHighDetailUse > tDiscardDelay)
+          {
+            s_pData->m_DiscardCandidates.PushBack({it.Key(), static_cast<float>((tNow - tracked.m_tLastHighDetailUse).GetSeconds())});
+          }
+        }
+        else
+        {
+          // only the lowest quality level is left, stop tracking unused textures, so that the resource manager can unload them entirely
+          bKeepTracking = !bUnused;
+        }
+      }
+    }
+
+    if (bKeepTracking)
+    {
+      ++it;
+    }
+    else
+    {
+      // whoever acquires the texture without reporting it, gets the default behavior again
+      plResourceManager::SetQualityLevelStreaming(it.Key(), false);
+      it = s_pData->m_TrackedTextures.Remove(it);
+    }
+  }
+
+  auto SortByPriority = [](const Data::Candidate& lhs, const Data::Candidate& rhs)
+  { return lhs.m_fPriority > rhs.m_fPriority; };
+
+  {
+    s_pData->m_LoadCandidates.Sort(SortByPriority);
+
+    const plUInt32 uiNumLoads = plMath::Min(s_pData->m_LoadCandidates.GetCount(), static_cast<plUInt32>(plMath::Max(0, cvar_StreamingTextureLoadsPerFrame.GetValue())));
+    for (plUInt32 i = 0; i < uiNumLoads; ++i)
+    {
+      // with quality level streaming enabled, this only loads one more quality level
+      plResourceManager::PreloadResource(s_pData->m_LoadCandidates[i].m_hTexture);
+    }
+
+    s_pData->m_uiNumLoadedQualityLevels += uiNumLoads;
+    s_pData->m_LoadCandidates.Clear();
+  }
+
+  {
+    s_pData->m_DiscardCandidates.Sort(SortByPriority);
+
+    const plUInt32 uiNumDiscards = plMath::Min(s_pData->m_DiscardCandidates.GetCount(), static_cast<plUInt32>(plMath::Max(0, cvar_StreamingTextureDiscardsPerFrame.GetValue())));
+    for (plUInt32 i = 0; i < uiNumDiscards; ++i)
+    {
+      if (plResourceManager::DiscardQualityLevel(s_pData->m_DiscardCandidates[i].m_hTexture).Succeeded())
+      {
+        ++s_pData->m_uiNumDiscardedQualityLevels;
+      }
+    }
+
+    s_pData->m_DiscardCandidates.Clear();
+  }
+
+  plStats::SetStat("Texture Streaming/Tracked Textures", s_pData->m_TrackedTextures.GetCount());
+  plStats::SetStat("Texture Streaming/Loaded Quality Levels", s_pData->m_uiNumLoadedQualityLevels);
+  plStats::SetStat("Texture Streaming/Discarded Quality Levels", s_pData->m_uiNumDiscardedQualityLevels);
+}
+
+// static
+void plTextureStreaming::StopStreaming()
+{
+  {
+    PL_LOCK(s_pData->m_Mutex);
+    s_pData->m_MaterialReports.Clear();
+    s_pData->m_TextureReports.Clear();
+  }
+
+  if (s_pData->m_TrackedTextures.IsEmpty())
+    return;
+
+  // hand the textures back to the resource manager, which loads them to full quality again
+  for (auto it = s_pData->m_TrackedTextures.GetIterator(); it.IsValid(); ++it)
+  {
+    plResourceManager::SetQualityLevelStreaming(it.Key(), false);
+    plResourceManager::PreloadResource(it.Key());
+  }
+
+  s_pData->m_TrackedTextures.Clear();
+
+  plStats::SetStat("Texture Streaming/Tracked Textures", 0);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+plTextureStreamingScreenSize::plTextureStreamingScreenSize(const plRenderViewContext& renderViewContext)
+{
+  const plRectFloat& viewport = renderViewContext.m_pViewData->m_ViewPortRect;
+  const plCamera& camera = *renderViewContext.m_pCamera;
+  const float fAspectRatio = viewport.width / plMath::Max(viewport.height, 1.0f);
+
+  m_vCameraPosition = camera.GetPosition();
+  m_fViewportHeight = viewport.height;
+  m_bPerspective = camera.IsPerspective();
+
+  // the diameter relative to the view height at the distance of the bounds, in pixels
+  if (m_bPerspective)
+  {
+    m_fScale = viewport.height / plMath::Max(plMath::Tan(camera.GetFovY(fAspectRatio) * 0.5f), plMath::SmallEpsilon<float>());
+  }
+  else
+  {
+    m_fScale = 2.0f * viewport.height / plMath::Max(camera.GetDimensionY(fAspectRatio), plMath::SmallEpsilon<float>());
+  }
+}
+
+PL_STATICLINK_FILE(RendererCore, RendererCore_Textures_TextureStreaming);
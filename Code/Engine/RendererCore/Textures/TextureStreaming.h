@@ -0,0 +1,121 @@
+#pragma once
+
+#include <Foundation/Math/BoundingBoxSphere.h>
+#include <RendererCore/Material/MaterialResource.h>
+#include <RendererCore/Pipeline/RenderDataBatch.h>
+#include <RendererCore/Textures/Texture2DResource.h>
+
+struct plRenderViewContext;
+struct plRenderWorldExtractionEvent;
+struct plRenderWorldRenderEvent;
+
+/// \brief Decides how many quality levels of 2D textures are loaded, based on how large they actually appear on screen.
+///
+/// Renderers report the materials and textures that they use, together with the projected size of the rendered objects in pixels.
+/// At the end of every extraction the reports are turned into the texture resolution that is needed. Textures that are too blurry get
+/// one more quality level loaded, textures that haven't needed their highest quality level for a while discard it again.
+/// The number of loads and discards per frame is limited by the 'Streaming.TextureLoadsPerFrame' and 'Streaming.TextureDiscardsPerFrame' cvars.
+///
+/// Reports are only allowed on the rendering thread. They are gathered there without any locking and handed over to the streaming update once per frame.
+///
+/// Once a texture has been reported, acquiring it doesn't automatically load its highest quality level anymore,
+/// see plResourceManager::SetQualityLevelStreaming().
+class PL_RENDERERCORE_DLL plTextureStreaming
+{
+public:
+  /// \brief Returns whether renderers should report texture usage while rendering the given view.
+  ///
+  /// This is false when streaming is disabled and for shadow views, since shadows don't sample the textures of materials.
+  /// Every renderer that binds materials or 2D textures that can be streamed should report them, otherwise textures that it shares with other
+  /// renderers only get the detail those others need.
+  static bool ShouldReportUsage(const plRenderViewContext& renderViewContext);
+
+  /// \brief Reports that the 2D textures of the given material are used on objects that cover roughly fScreenSize pixels.
+  static void ReportMaterialUsage(const plMaterialResourceHandle& hMaterial, float fScreenSize);
+
+  /// \brief Reports that the given texture is used on objects that cover roughly fScreenSize pixels.
+  static void ReportTextureUsage(const plTexture2DResourceHandle& hTexture, float fScreenSize);
+
+  /// \brief Computes how many pixels the given bounds cover vertically in the given view. Invalid bounds are treated as covering the entire view.
+  ///
+  /// Use plTextureStreamingScreenSize instead when computing this for many bounds in the same view.
+  static float ComputeScreenSize(const plBoundingBoxSphere& bounds, const plRenderViewContext& renderViewContext);
+
+private:
+  PL_MAKE_SUBSYSTEM_STARTUP_FRIEND(RendererCore, TextureStreaming);
+
+  static void OnEngineStartup();
+  static void OnEngineShutdown();
+
+  static void OnExtractionEvent(const plRenderWorldExtractionEvent& e);
+  static void OnRenderEvent(const plRenderWorldRenderEvent& e);
+  static void Update();
+  static void StopStreaming();
+
+  struct Data;
+  static Data* s_pData;
+};
+
+/// \brief Computes the screen size of many bounds in the same view, see plTextureStreaming::ComputeScreenSize().
+///
+/// The view dependent values are computed once in the constructor, so this is cheap enough to be used for every instance of a batch.
+class PL_RENDERERCORE_DLL plTextureStreamingScreenSize
+{
+public:
+  explicit plTextureStreamingScreenSize(const plRenderViewContext& renderViewContext);
+
+  /// \brief Returns how many pixels the given bounds cover vertically. Invalid bounds are treated as covering the entire view.
+  float Compute(const plBoundingBoxSphere& bounds) const
+  {
+    float fMaxSize = 0.0f;
+    AddToMax(bounds, fMaxSize);
+    return ToScreenSize(fMaxSize);
+  }
+
+  /// \brief Returns the largest Compute() result of all render data in the batch.
+  template <typename RenderDataType>
+  float ComputeMax(const plRenderDataBatch& batch) const
+  {
+    float fMaxSize = 0.0f;
+    for (auto it = batch.GetIterator<RenderDataType>(); it.IsValid(); ++it)
+    {
+      AddToMax(it->m_GlobalBounds, fMaxSize);
+    }
+    return ToScreenSize(fMaxSize);
+  }
+
+private:
+  // Perspective views compare the squared ratio of radius to distance, orthographic views the radius, so that no instance needs a square root.
+  // Invalid bounds set the maximum to infinity, which is clamped to the viewport height.
+  PL_ALWAYS_INLINE void AddToMax(const plBoundingBoxSphere& bounds, float& inout_fMaxSize) const
+  {
+    if (!bounds.IsValid())
+    {
+      inout_fMaxSize = plMath::Infinity<float>();
+    }
+    else if (m_bPerspective)
+    {
+      // the camera may be inside the bounds, which would result in arbitrarily large sizes
+      const float fRadiusSquared = bounds.m_fSphereRadius * bounds.m_fSphereRadius;
+      const float fDistanceSquared = plMath::Max((bounds.m_vCenter - m_vCameraPosition).GetLengthSquared(), fRadiusSquared);
+      inout_fMaxSize = plMath::Max(inout_fMaxSize, fRadiusSquared / plMath::Max(fDistanceSquared, plMath::SmallEpsilon<float>()));
+    }
+    else
+    {
+      inout_fMaxSize = plMath::Max(inout_fMaxSize, bounds.m_fSphereRadius);
+    }
+  }
+
+  PL_ALWAYS_INLINE float ToScreenSize(float fMaxSize) const
+  {
+    if (fMaxSize == plMath::Infinity<float>())
+      return m_fViewportHeight;
+
+    return m_fScale * (m_bPerspective ? plMath::Sqrt(fMaxSize) : fMaxSize);
+  }
+
+  plVec3 m_vCameraPosition;
+  float m_fScale = 0.0f;
+  float m_fViewportHeight = 0.0f;
+  bool m_bPerspective = true;
+};
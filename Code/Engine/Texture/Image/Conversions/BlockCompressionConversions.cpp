@@ -0,0 +1,1179 @@
+#include <Texture/TexturePCH.h>
+
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Texture/Image/Conversions/DXTConversions.h>
+#include <Texture/Image/Conversions/PixelConversions.h>
+#include <Texture/Image/ImageConversion.h>
+
+plCVarInt cvar_TextureBlockCompressionQuality("Texture.BlockCompressionQuality", 1, plCVarFlags::Default, "Quality preset of the native block compressor: 0 = fastest, 1 = balanced, 2 = best quality");
+plCVarBool cvar_TextureNativeBlockCompression("Texture.NativeBlockCompression", true, plCVarFlags::RequiresRestart, "Prefer the native block compressor over the DirectXTex software encoders");
+plCVarBool cvar_TextureNativeBC7Compression("Texture.NativeBC7Compression", true, plCVarFlags::RequiresRestart, "Also use the native block compressor for BC7. With the fastest quality preset it only uses mode 6 and has a noticeably lower quality than the DirectXTex encoder");
+
+// The native compressor encodes every 4x4 block independently, so the result doesn't depend on how the blocks are distributed across
+// threads. All formats use the same approach: the endpoints are initialized as the extent of the block along its principal axis and are then
+// improved with a few least squares iterations over the chosen indices. BC7 blocks are always tried in mode 6 (single subset, RGBA endpoints
+// with p-bits and 4 bit indices), which handles smooth color and alpha gradients well. Blocks with several distinct colors need two subsets,
+// so the balanced and best presets additionally try the most promising partitions with modes 1 and 3 (opaque) or mode 7 (alpha).
+
+namespace
+{
+  struct CompressionSettings
+  {
+    plUInt32 m_uiPowerIterations = 0;     ///< Iterations used to find the principal axis of a block.
+    plUInt32 m_uiRefinementSteps = 0;     ///< Number of least squares endpoint refinements.
+    bool m_bExhaustiveBC7Indices = false; ///< Select BC7 indices by the distance to all palette entries instead of by projection.
+    bool m_bTryBC4SixValueMode = false;   ///< Also try the BC4 mode with explicit 0 and 255 entries.
+    plUInt32 m_uiBC7Partitions = 0;       ///< How many of the most promising two subset partitions are tried with BC7 modes 1, 3 and 7.
+  };
+
+  CompressionSettings GetCompressionSettings()
+  {
+    CompressionSettings settings;
+
+    switch (plMath::Clamp<int>(cvar_TextureBlockCompressionQuality, 0, 2))
+    {
+      case 0:
+        settings.m_uiPowerIterations = 2;
+        break;
+
+      case 1:
+        settings.m_uiPowerIterations = 4;
+        settings.m_uiRefinementSteps = 1;
+        settings.m_bExhaustiveBC7Indices = true;
+        settings.m_uiBC7Partitions = 4;
+        break;
+
+      default:
+        settings.m_uiPowerIterations = 8;
+        settings.m_uiRefinementSteps = 4;
+        settings.m_bExhaustiveBC7Indices = true;
+        settings.m_bTryBC4SixValueMode = true;
+        settings.m_uiBC7Partitions = 16;
+        break;
+    }
+
+    return settings;
+  }
+
+  PL_ALWAYS_INLINE plSimdVec4f ClampColor(const plSimdVec4f& v)
+  {
+    return v.CompMax(plSimdVec4f::MakeZero()).CompMin(plSimdVec4f(255.0f));
+  }
+
+  PL_ALWAYS_INLINE plUInt32 QuantizeChannel(float fValue, plUInt32 uiMaxValue)
+  {
+    return static_cast<plUInt32>(plMath::Clamp(fValue * uiMaxValue / 255.0f + 0.5f, 0.0f, static_cast<float>(uiMaxValue)));
+  }
+
+  /// \brief Finds the initial endpoints of a block as its extent along the principal axis of the pixel colors.
+  void FindEndpoints(const plSimdVec4f* pPixels, plUInt32 uiNumPixels, const CompressionSettings& settings, plSimdVec4f& out_v0, plSimdVec4f& out_v1)
+  {
+    plSimdVec4f vMin = pPixels[0];
+    plSimdVec4f vMax = pPixels[0];
+    plSimdVec4f vSum = plSimdVec4f::MakeZero();
+
+    for (plUInt32 i = 0; i < uiNumPixels; ++i)
+    {
+      vMin = vMin.CompMin(pPixels[i]);
+      vMax = vMax.CompMax(pPixels[i]);
+      vSum += pPixels[i];
+    }
+
+    const plSimdVec4f vMean = vSum / plSimdFloat(static_cast<float>(uiNumPixels));
+
+    plSimdVec4f vAxis = vMax - vMin;
+    if (vAxis.IsZero<4>(plSimdFloat(0.5f)))
+    {
+      out_v0 = vMean;
+      out_v1 = vMean;
+      return;
+    }
+
+    // power iteration on the covariance matrix, starting with the diagonal of the bounding box
+    plSimdVec4f vCovariance[4] = {plSimdVec4f::MakeZero(), plSimdVec4f::MakeZero(), plSimdVec4f::MakeZero(), plSimdVec4f::MakeZero()};
+    for (plUInt32 i = 0; i < uiNumPixels; ++i)
+    {
+      const plSimdVec4f d = pPixels[i] - vMean;
+      vCovariance[0] = plSimdVec4f::MulAdd(d, d.x(), vCovariance[0]);
+      vCovariance[1] = plSimdVec4f::MulAdd(d, d.y(), vCovariance[1]);
+      vCovariance[2] = plSimdVec4f::MulAdd(d, d.z(), vCovariance[2]);
+      vCovariance[3] = plSimdVec4f::MulAdd(d, d.w(), vCovariance[3]);
+    }
+
+    vAxis.Normalize<4>();
+    for (plUInt32 uiIteration = 0; uiIteration < settings.m_uiPowerIterations; ++uiIteration)
+    {
+      plSimdVec4f vNext = vCovariance[0] * vAxis.x();
+      vNext = plSimdVec4f::MulAdd(vCovariance[1], vAxis.y(), vNext);
+      vNext = plSimdVec4f::MulAdd(vCovariance[2], vAxis.z(), vNext);
+      vNext = plSimdVec4f::MulAdd(vCovariance[3], vAxis.w(), vNext);
+
+      if (vNext.IsZero<4>(plSimdFloat(plMath::SmallEpsilon<float>())))
+        break;
+
+      vAxis = vNext.GetNormalized<4>();
+    }
+
+    plSimdFloat fMinT = plMath::MaxValue<float>();
+    plSimdFloat fMaxT = -plMath::MaxValue<float>();
+
+    for (plUInt32 i = 0; i < uiNumPixels; ++i)
+    {
+      const plSimdFloat t = (pPixels[i] - vMean).Dot<4>(vAxis);
+      fMinT = fMinT.Min(t);
+      fMaxT = fMaxT.Max(t);
+    }
+
+    out_v0 = ClampColor(plSimdVec4f::MulAdd(vAxis, fMinT, vMean));
+    out_v1 = ClampColor(plSimdVec4f::MulAdd(vAxis, fMaxT, vMean));
+  }
+
+  /// \brief Computes the endpoints that minimize the squared error for the given interpolation weights of the pixels.
+  plResult RefineEndpoints(const plSimdVec4f* pPixels, const float* pWeights, plUInt32 uiNumPixels, plSimdVec4f& out_v0, plSimdVec4f& out_v1)
+  {
+    float a = 0.0f;
+    float b = 0.0f;
+    float c = 0.0f;
+    plSimdVec4f x = plSimdVec4f::MakeZero();
+    plSimdVec4f y = plSimdVec4f::MakeZero();
+
+    for (plUInt32 i = 0; i < uiNumPixels; ++i)
+    {
+      const float w = pWeights[i];
+      const float iw = 1.0f - w;
+
+      a += iw * iw;
+      b += iw * w;
+      c += w * w;
+      x = plSimdVec4f::MulAdd(pPixels[i], plSimdFloat(iw), x);
+      y = plSimdVec4f::MulAdd(pPixels[i], plSimdFloat(w), y);
+    }
+
+    const float fDeterminant = a * c - b * b;
+    if (fDeterminant < 0.0001f)
+      return PL_FAILURE;
+
+    const plSimdFloat fInvDeterminant = 1.0f / fDeterminant;
+    out_v0 = ClampColor((x * plSimdFloat(c) - y * plSimdFloat(b)) * fInvDeterminant);
+    out_v1 = ClampColor((y * plSimdFloat(a) - x * plSimdFloat(b)) * fInvDeterminant);
+    return PL_SUCCESS;
+  }
+
+  plUInt16 QuantizeB5G6R5(const plSimdVec4f& vColor)
+  {
+    float rgba[4];
+    vColor.Store<4>(rgba);
+
+    return static_cast<plUInt16>((QuantizeChannel(rgba[0], 31) << 11) | (QuantizeChannel(rgba[1], 63) << 5) | QuantizeChannel(rgba[2], 31));
+  }
+
+  plSimdVec4f ToSimd(const plColorBaseUB& color)
+  {
+    return plSimdVec4f(color.r, color.g, color.b, color.a);
+  }
+
+  /// \brief Encodes the color part of a BC1, BC2 or BC3 block.
+  ///
+  /// If bTransparent is set, pixels with an alpha below 128 are encoded as transparent, which requires the three color mode of BC1.
+  void EncodeColorBlock(const plSimdVec4f* pBlock, bool bTransparent, const CompressionSettings& settings, plUInt8* pTarget)
+  {
+    plSimdVec4f pixels[16];
+    plUInt32 pixelIndices[16];
+    plUInt32 uiNumPixels = 0;
+    bool bHasTransparentPixels = false;
+
+    const plSimdVec4f vRgbMask(1.0f, 1.0f, 1.0f, 0.0f);
+
+    for (plUInt32 i = 0; i < 16; ++i)
+    {
+      if (bTransparent && pBlock[i].w() < plSimdFloat(128.0f))
+      {
+        bHasTransparentPixels = true;
+        continue;
+      }
+
+      pixels[uiNumPixels] = pBlock[i].CompMul(vRgbMask);
+      pixelIndices[uiNumPixels] = i;
+      ++uiNumPixels;
+    }
+
+    plUInt8 indices[16];
+
+    if (uiNumPixels == 0)
+    {
+      plMemoryUtils::ZeroFill(pTarget, 4);
+      plMemoryUtils::PatternFill(pTarget + 4, 0xFF, 4);
+      return;
+    }
+
+    const bool bThreeColorMode = bHasTransparentPixels;
+    const plUInt32 uiNumColors = bThreeColorMode ? 3 : 4;
+    const float fourColorWeights[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+    const float threeColorWeights[3] = {0.0f, 1.0f, 0.5f};
+    const float* pColorWeights = bThreeColorMode ? threeColorWeights : fourColorWeights;
+
+    plSimdVec4f v0, v1;
+    FindEndpoints(pixels, uiNumPixels, settings, v0, v1);
+
+    plUInt16 uiBestColor0 = 0;
+    plUInt16 uiBestColor1 = 0;
+    plUInt8 bestIndices[16] = {};
+    float fBestError = plMath::MaxValue<float>();
+
+    for (plUInt32 uiStep = 0; uiStep <= settings.m_uiRefinementSteps; ++uiStep)
+    {
+      const plUInt16 uiColor0 = QuantizeB5G6R5(v0);
+      const plUInt16 uiColor1 = QuantizeB5G6R5(v1);
+
+      // the palette is computed exactly like plDecompressBlockBC1 does it
+      const plColorBaseUB c0 = plDecompressB5G6R5(uiColor0);
+      const plColorBaseUB c1 = plDecompressB5G6R5(uiColor1);
+
+      plSimdVec4f palette[4];
+      palette[0] = ToSimd(c0);
+      palette[1] = ToSimd(c1);
+
+      if (bThreeColorMode)
+      {
+        palette[2] = ToSimd(plColorBaseUB((c0.r + c1.r) / 2, (c0.g + c1.g) / 2, (c0.b + c1.b) / 2, 0));
+      }
+      else
+      {
+        palette[2] = ToSimd(plColorBaseUB((2 * c0.r + c1.r + 1) / 3, (2 * c0.g + c1.g + 1) / 3, (2 * c0.b + c1.b + 1) / 3, 0));
+        palette[3] = ToSimd(plColorBaseUB((c0.r + 2 * c1.r + 1) / 3, (c0.g + 2 * c1.g + 1) / 3, (c0.b + 2 * c1.b + 1) / 3, 0));
+      }
+
+      float fError = 0.0f;
+      for (plUInt32 i = 0; i < uiNumPixels; ++i)
+      {
+        plSimdFloat fBestDistance = (pixels[i] - palette[0]).GetLengthSquared<3>();
+        indices[i] = 0;
+
+        for (plUInt32 uiColor = 1; uiColor < uiNumColors; ++uiColor)
+        {
+          const plSimdFloat fDistance = (pixels[i] - palette[uiColor]).GetLengthSquared<3>();
+          if (fDistance < fBestDistance)
+          {
+            fBestDistance = fDistance;
+            indices[i] = static_cast<plUInt8>(uiColor);
+          }
+        }
+
+        fError += fBestDistance;
+      }
+
+      if (fError < fBestError)
+      {
+        fBestError = fError;
+        uiBestColor0 = uiColor0;
+        uiBestColor1 = uiColor1;
+        plMemoryUtils::Copy(bestIndices, indices, uiNumPixels);
+      }
+
+      if (uiStep == settings.m_uiRefinementSteps || fError == 0.0f)
+        break;
+
+      float weights[16];
+      for (plUInt32 i = 0; i < uiNumPixels; ++i)
+      {
+        weights[i] = pColorWeights[indices[i]];
+      }
+
+      if (RefineEndpoints(pixels, weights, uiNumPixels, v0, v1).Failed())
+        break;
+    }
+
+    // the order of the endpoints selects the mode, swapping them requires remapping the indices
+    bool bSwap = false;
+    if (bThreeColorMode)
+    {
+      bSwap = uiBestColor0 > uiBestColor1;
+    }
+    else
+    {
+      bSwap = uiBestColor0 < uiBestColor1;
+
+      if (uiBestColor0 == uiBestColor1)
+      {
+        // equal endpoints would decode in three color mode, but the block is uniform anyway
+        plMemoryUtils::ZeroFill(bestIndices, uiNumPixels);
+      }
+    }
+
+    if (bSwap)
+    {
+      plMath::Swap(uiBestColor0, uiBestColor1);
+
+      for (plUInt32 i = 0; i < uiNumPixels; ++i)
+      {
+        if (!bThreeColorMode || bestIndices[i] < 2)
+        {
+          bestIndices[i] ^= 1;
+        }
+      }
+    }
+
+    plUInt32 uiIndexBits = 0;
+    if (bThreeColorMode)
+    {
+      // transparent pixels use index 3
+      uiIndexBits = 0xFFFFFFFF;
+      for (plUInt32 i = 0; i < uiNumPixels; ++i)
+      {
+        uiIndexBits &= ~(3u << (2 * pixelIndices[i]));
+      }
+    }
+
+    for (plUInt32 i = 0; i < uiNumPixels; ++i)
+    {
+      uiIndexBits |= bestIndices[i] << (2 * pixelIndices[i]);
+    }
+
+    pTarget[0] = static_cast<plUInt8>(uiBestColor0);
+    pTarget[1] = static_cast<plUInt8>(uiBestColor0 >> 8);
+    pTarget[2] = static_cast<plUInt8>(uiBestColor1);
+    pTarget[3] = static_cast<plUInt8>(uiBestColor1 >> 8);
+    pTarget[4] = static_cast<plUInt8>(uiIndexBits);
+    pTarget[5] = static_cast<plUInt8>(uiIndexBits >> 8);
+    pTarget[6] = static_cast<plUInt8>(uiIndexBits >> 16);
+    pTarget[7] = static_cast<plUInt8>(uiIndexBits >> 24);
+  }
+
+  /// \brief Chooses the closest palette entry for every value and returns the squared error of the block.
+  plUInt32 FindIndicesBC4(const plUInt8* pValues, plUInt32 ui0, plUInt32 ui1, plUInt8* pIndices)
+  {
+    plUInt32 palette[8];
+    plUnpackPaletteBC4(ui0, ui1, palette);
+
+    plUInt32 uiError = 0;
+    for (plUInt32 i = 0; i < 16; ++i)
+    {
+      plUInt32 uiBestDistance = plMath::MaxValue<plUInt32>();
+
+      for (plUInt32 uiEntry = 0; uiEntry < 8; ++uiEntry)
+      {
+        const plInt32 iDifference = static_cast<plInt32>(pValues[i]) - static_cast<plInt32>(palette[uiEntry]);
+        const plUInt32 uiDistance = static_cast<plUInt32>(iDifference * iDifference);
+
+        if (uiDistance < uiBestDistance)
+        {
+          uiBestDistance = uiDistance;
+          pIndices[i] = static_cast<plUInt8>(uiEntry);
+        }
+      }
+
+      uiError += uiBestDistance;
+    }
+
+    return uiError;
+  }
+
+  /// \brief Encodes a single channel BC4 block. Signed data has to be biased into the unsigned range by the caller.
+  void EncodeBlockBC4(const plUInt8* pValues, bool bAllowSixValueMode, const CompressionSettings& settings, plUInt8* pTarget)
+  {
+    plUInt32 uiMin = 255;
+    plUInt32 uiMax = 0;
+    plUInt32 uiInnerMin = 255;
+    plUInt32 uiInnerMax = 0;
+
+    for (plUInt32 i = 0; i < 16; ++i)
+    {
+      uiMin = plMath::Min<plUInt32>(uiMin, pValues[i]);
+      uiMax = plMath::Max<plUInt32>(uiMax, pValues[i]);
+
+      if (pValues[i] != 0 && pValues[i] != 255)
+      {
+        uiInnerMin = plMath::Min<plUInt32>(uiInnerMin, pValues[i]);
+        uiInnerMax = plMath::Max<plUInt32>(uiInnerMax, pValues[i]);
+      }
+    }
+
+    plUInt32 uiBest0 = uiMax;
+    plUInt32 uiBest1 = uiMin;
+    plUInt8 bestIndices[16] = {};
+    plUInt32 uiBestError = 0;
+
+    if (uiMin != uiMax)
+    {
+      // eight value mode, requires the first endpoint to be larger
+      plUInt8 indices[16];
+      plUInt32 ui0 = uiMax;
+      plUInt32 ui1 = uiMin;
+
+      uiBestError = FindIndicesBC4(pValues, ui0, ui1, bestIndices);
+
+      for (plUInt32 uiStep = 0; uiStep < settings.m_uiRefinementSteps && uiBestError > 0; ++uiStep)
+      {
+        float a = 0.0f;
+        float b = 0.0f;
+        float c = 0.0f;
+        float x = 0.0f;
+        float y = 0.0f;
+
+        for (plUInt32 i = 0; i < 16; ++i)
+        {
+          const plUInt8 uiIndex = (uiStep == 0) ? bestIndices[i] : indices[i];
+          const float w = (uiIndex <= 1) ? static_cast<float>(uiIndex) : (uiIndex - 1) / 7.0f;
+          const float iw = 1.0f - w;
+
+          a += iw * iw;
+          b += iw * w;
+          c += w * w;
+          x += iw * pValues[i];
+          y += w * pValues[i];
+        }
+
+        const float fDeterminant = a * c - b * b;
+        if (fDeterminant < 0.0001f)
+          break;
+
+        plUInt32 uiNew0 = static_cast<plUInt32>(plMath::Clamp((c * x - b * y) / fDeterminant + 0.5f, 0.0f, 255.0f));
+        plUInt32 uiNew1 = static_cast<plUInt32>(plMath::Clamp((a * y - b * x) / fDeterminant + 0.5f, 0.0f, 255.0f));
+
+        if (uiNew0 == uiNew1)
+          break;
+
+        if (uiNew0 < uiNew1)
+        {
+          plMath::Swap(uiNew0, uiNew1);
+        }
+
+        if (uiNew0 == ui0 && uiNew1 == ui1)
+          break;
+
+        ui0 = uiNew0;
+        ui1 = uiNew1;
+
+        const plUInt32 uiError = FindIndicesBC4(pValues, ui0, ui1, indices);
+        if (uiError < uiBestError)
+        {
+          uiBestError = uiError;
+          uiBest0 = ui0;
+          uiBest1 = ui1;
+          plMemoryUtils::Copy(bestIndices, indices, 16);
+        }
+      }
+
+      if (bAllowSixValueMode && uiBestError > 0 && (uiMin == 0 || uiMax == 255))
+      {
+        // six value mode with explicit 0 and 255 entries, requires the first endpoint to be smaller or equal
+        ui0 = (uiInnerMin <= uiInnerMax) ? uiInnerMin : 0;
+        ui1 = (uiInnerMin <= uiInnerMax) ? uiInnerMax : 0;
+
+        const plUInt32 uiError = FindIndicesBC4(pValues, ui0, ui1, indices);
+        if (uiError < uiBestError)
+        {
+          uiBestError = uiError;
+          uiBest0 = ui0;
+          uiBest1 = ui1;
+          plMemoryUtils::Copy(bestIndices, indices, 16);
+        }
+      }
+    }
+
+    plUInt64 uiIndexBits = 0;
+    for (plUInt32 i = 0; i < 16; ++i)
+    {
+      uiIndexBits |= static_cast<plUInt64>(bestIndices[i]) << (3 * i);
+    }
+
+    pTarget[0] = static_cast<plUInt8>(uiBest0);
+    pTarget[1] = static_cast<plUInt8>(uiBest1);
+
+    for (plUInt32 i = 0; i < 6; ++i)
+    {
+      pTarget[2 + i] = static_cast<plUInt8>(uiIndexBits >> (8 * i));
+    }
+  }
+
+  class BitWriter
+  {
+  public:
+    BitWriter(plUInt8* pTarget, plUInt32 uiNumBytes)
+      : m_pTarget(pTarget)
+    {
+      plMemoryUtils::ZeroFill(pTarget, uiNumBytes);
+    }
+
+    void Write(plUInt32 uiValue, plUInt32 uiNumBits)
+    {
+      for (plUInt32 i = 0; i < uiNumBits; ++i, ++m_uiPosition)
+      {
+        m_pTarget[m_uiPosition / 8] |= static_cast<plUInt8>(((uiValue >> i) & 1) << (m_uiPosition % 8));
+      }
+    }
+
+  private:
+    plUInt8* m_pTarget = nullptr;
+    plUInt32 m_uiPosition = 0;
+  };
+
+  struct BC7Mode
+  {
+    plUInt32 m_uiMode = 0;
+    plUInt32 m_uiNumSubsets = 1;
+    plUInt32 m_uiColorBits = 0;
+    plUInt32 m_uiAlphaBits = 0; ///< Zero for the modes without alpha, those always decode to an alpha of 255.
+    plUInt32 m_uiIndexBits = 0;
+    bool m_bSharedPBit = false; ///< Both endpoints of a subset use the same p-bit.
+  };
+
+  constexpr BC7Mode s_BC7Mode1 = {1, 2, 6, 0, 3, true};
+  constexpr BC7Mode s_BC7Mode3 = {3, 2, 7, 0, 2, false};
+  constexpr BC7Mode s_BC7Mode6 = {6, 1, 7, 7, 4, false};
+  constexpr BC7Mode s_BC7Mode7 = {7, 2, 5, 5, 2, false};
+
+  constexpr plUInt32 s_BC7Weights2[4] = {0, 21, 43, 64};
+  constexpr plUInt32 s_BC7Weights3[8] = {0, 9, 18, 27, 37, 46, 55, 64};
+  constexpr plUInt32 s_BC7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+  /// \brief The pixels that belong to the second subset of each two subset partition, one bit per pixel.
+  constexpr plUInt16 s_BC7Partitions2[64] = {
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80, 0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE, 0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A, 0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C, 0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22};
+
+  /// \brief The pixel of the second subset whose index has an implicit zero as its most significant bit, for each two subset partition.
+  constexpr plUInt8 s_BC7Anchors2[64] = {
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 2, 8, 2, 2, 8, 8, 15, 2, 8, 2, 2, 8, 8, 2, 2,
+    15, 15, 6, 8, 2, 8, 15, 15, 2, 8, 2, 2, 2, 15, 15, 6, 6, 2, 6, 8, 15, 15, 2, 2, 15, 15, 15, 15, 15, 2, 2, 15};
+
+  const plUInt32* GetBC7Weights(plUInt32 uiIndexBits)
+  {
+    return uiIndexBits == 2 ? s_BC7Weights2 : (uiIndexBits == 3 ? s_BC7Weights3 : s_BC7Weights4);
+  }
+
+  /// \brief The quantized endpoints of one subset, together with the colors that the decoder reconstructs from them.
+  struct BC7Endpoints
+  {
+    plUInt32 m_Channels[2][4] = {};
+    plUInt32 m_PBits[2] = {};
+    plSimdVec4f m_vDecoded[2];
+  };
+
+  /// \brief Quantizes an endpoint with the given p-bit and returns the squared error of the value that the decoder reconstructs.
+  float QuantizeEndpointBC7(const BC7Mode& mode, const float* pRGBA, plUInt32 uiPBit, plUInt32* pChannels, float* pDecoded)
+  {
+    float fError = 0.0f;
+
+    for (plUInt32 c = 0; c < 4; ++c)
+    {
+      const plUInt32 uiBits = c < 3 ? mode.m_uiColorBits : mode.m_uiAlphaBits;
+
+      if (uiBits == 0)
+      {
+        pChannels[c] = 0;
+        pDecoded[c] = 255.0f;
+      }
+      else
+      {
+        // the channel and the p-bit form a value with one more bit, which is expanded to 8 bits by replicating its upper bits
+        const plUInt32 uiTotalBits = uiBits + 1;
+        const float fScale = static_cast<float>((1u << uiTotalBits) - 1) / 255.0f;
+        pChannels[c] = static_cast<plUInt32>(plMath::Clamp((pRGBA[c] * fScale - uiPBit) * 0.5f + 0.5f, 0.0f, static_cast<float>((1u << uiBits) - 1)));
+
+        const plUInt32 uiValue = (pChannels[c] << 1) | uiPBit;
+        pDecoded[c] = static_cast<float>(((uiValue << (8 - uiTotalBits)) | (uiValue >> (2 * uiTotalBits - 8))) & 0xFF);
+      }
+
+      const float fDifference = pDecoded[c] - pRGBA[c];
+      fError += fDifference * fDifference;
+    }
+
+    return fError;
+  }
+
+  /// \brief Quantizes both endpoints of a subset, choosing the p-bits with the smallest error.
+  void QuantizeEndpointsBC7(const BC7Mode& mode, const plSimdVec4f& v0, const plSimdVec4f& v1, bool bOpaque, BC7Endpoints& out_endpoints)
+  {
+    float rgba[2][4];
+    v0.Store<4>(rgba[0]);
+    v1.Store<4>(rgba[1]);
+
+    // opaque blocks need the p-bit to be set to represent an alpha of exactly 255, unless the mode has no alpha at all
+    const plUInt32 uiFirstPBit = (bOpaque && mode.m_uiAlphaBits > 0) ? 1 : 0;
+
+    float decoded[2][4];
+
+    if (mode.m_bSharedPBit)
+    {
+      float fBestError = plMath::MaxValue<float>();
+
+      for (plUInt32 uiPBit = uiFirstPBit; uiPBit < 2; ++uiPBit)
+      {
+        plUInt32 channels[2][4];
+        float candidate[2][4];
+        const float fError = QuantizeEndpointBC7(mode, rgba[0], uiPBit, channels[0], candidate[0]) + QuantizeEndpointBC7(mode, rgba[1], uiPBit, channels[1], candidate[1]);
+
+        if (fError < fBestError)
+        {
+          fBestError = fError;
+          out_endpoints.m_PBits[0] = uiPBit;
+          out_endpoints.m_PBits[1] = uiPBit;
+          plMemoryUtils::Copy(&out_endpoints.m_Channels[0][0], &channels[0][0], 8);
+          plMemoryUtils::Copy(&decoded[0][0], &candidate[0][0], 8);
+        }
+      }
+    }
+    else
+    {
+      for (plUInt32 e = 0; e < 2; ++e)
+      {
+        float fBestError = plMath::MaxValue<float>();
+
+        for (plUInt32 uiPBit = uiFirstPBit; uiPBit < 2; ++uiPBit)
+        {
+          plUInt32 channels[4];
+          float candidate[4];
+          const float fError = QuantizeEndpointBC7(mode, rgba[e], uiPBit, channels, candidate);
+
+          if (fError < fBestError)
+          {
+            fBestError = fError;
+            out_endpoints.m_PBits[e] = uiPBit;
+            plMemoryUtils::Copy(out_endpoints.m_Channels[e], channels, 4);
+            plMemoryUtils::Copy(decoded[e], candidate, 4);
+          }
+        }
+      }
+    }
+
+    out_endpoints.m_vDecoded[0].Load<4>(decoded[0]);
+    out_endpoints.m_vDecoded[1].Load<4>(decoded[1]);
+  }
+
+  /// \brief Finds the endpoints and indices for the pixels of one subset and returns the squared error.
+  float EncodeSubsetBC7(const BC7Mode& mode, const plSimdVec4f* pPixels, plUInt32 uiNumPixels, bool bOpaque, const CompressionSettings& settings, BC7Endpoints& out_endpoints, plUInt8* out_pIndices)
+  {
+    const plUInt32 uiNumEntries = 1u << mode.m_uiIndexBits;
+    const plUInt32* pWeights = GetBC7Weights(mode.m_uiIndexBits);
+
+    plSimdVec4f v0, v1;
+    FindEndpoints(pPixels, uiNumPixels, settings, v0, v1);
+
+    float fBestError = plMath::MaxValue<float>();
+
+    for (plUInt32 uiStep = 0; uiStep <= settings.m_uiRefinementSteps; ++uiStep)
+    {
+      BC7Endpoints endpoints;
+      QuantizeEndpointsBC7(mode, v0, v1, bOpaque, endpoints);
+
+      // the palette is computed exactly like the decoder does it
+      plSimdVec4f palette[16];
+      {
+        float e0[4];
+        float e1[4];
+        endpoints.m_vDecoded[0].Store<4>(e0);
+        endpoints.m_vDecoded[1].Store<4>(e1);
+
+        for (plUInt32 uiEntry = 0; uiEntry < uiNumEntries; ++uiEntry)
+        {
+          const plUInt32 w = pWeights[uiEntry];
+          float entry[4];
+          for (plUInt32 c = 0; c < 4; ++c)
+          {
+            entry[c] = static_cast<float>(((64 - w) * static_cast<plUInt32>(e0[c]) + w * static_cast<plUInt32>(e1[c]) + 32) >> 6);
+          }
+          palette[uiEntry].Load<4>(entry);
+        }
+      }
+
+      plUInt8 indices[16];
+      float fError = 0.0f;
+
+      if (settings.m_bExhaustiveBC7Indices)
+      {
+        for (plUInt32 i = 0; i < uiNumPixels; ++i)
+        {
+          plSimdFloat fBestDistance = (pPixels[i] - palette[0]).GetLengthSquared<4>();
+          indices[i] = 0;
+
+          for (plUInt32 uiEntry = 1; uiEntry < uiNumEntries; ++uiEntry)
+          {
+            const plSimdFloat fDistance = (pPixels[i] - palette[uiEntry]).GetLengthSquared<4>();
+            if (fDistance < fBestDistance)
+            {
+              fBestDistance = fDistance;
+              indices[i] = static_cast<plUInt8>(uiEntry);
+            }
+          }
+
+          fError += fBestDistance;
+        }
+      }
+      else
+      {
+        const plSimdVec4f vAxis = palette[uiNumEntries - 1] - palette[0];
+        const plSimdFloat fAxisLengthSquared = vAxis.GetLengthSquared<4>();
+        const plSimdFloat fScale = fAxisLengthSquared > plSimdFloat(0.0f) ? plSimdFloat(static_cast<float>(uiNumEntries - 1)) / fAxisLengthSquared : plSimdFloat(0.0f);
+
+        for (plUInt32 i = 0; i < uiNumPixels; ++i)
+        {
+          const float t = (pPixels[i] - palette[0]).Dot<4>(vAxis) * fScale;
+          indices[i] = static_cast<plUInt8>(plMath::Clamp(t + 0.5f, 0.0f, static_cast<float>(uiNumEntries - 1)));
+
+          fError += (pPixels[i] - palette[indices[i]]).GetLengthSquared<4>();
+        }
+      }
+
+      if (fError < fBestError)
+      {
+        fBestError = fError;
+        out_endpoints = endpoints;
+        plMemoryUtils::Copy(out_pIndices, indices, uiNumPixels);
+      }
+
+      if (uiStep == settings.m_uiRefinementSteps || fError == 0.0f)
+        break;
+
+      float weights[16];
+      for (plUInt32 i = 0; i < uiNumPixels; ++i)
+      {
+        weights[i] = pWeights[indices[i]] / 64.0f;
+      }
+
+      if (RefineEndpoints(pPixels, weights, uiNumPixels, v0, v1).Failed())
+        break;
+    }
+
+    return fBestError;
+  }
+
+  /// \brief The result of encoding a block in one BC7 mode.
+  struct BC7Block
+  {
+    const BC7Mode* m_pMode = nullptr;
+    plUInt32 m_uiPartition = 0;
+    BC7Endpoints m_Endpoints[2];
+    plUInt8 m_Indices[16] = {};
+    float m_fError = plMath::MaxValue<float>();
+  };
+
+  /// \brief Encodes the block in the given mode and partition. The partition is ignored for single subset modes.
+  void EncodeBlockModeBC7(const BC7Mode& mode, plUInt32 uiPartition, const plSimdVec4f* pPixels, bool bOpaque, const CompressionSettings& settings, BC7Block& out_block)
+  {
+    out_block.m_pMode = &mode;
+    out_block.m_uiPartition = uiPartition;
+    out_block.m_fError = 0.0f;
+
+    const plUInt32 uiMask = mode.m_uiNumSubsets == 2 ? s_BC7Partitions2[uiPartition] : 0;
+
+    for (plUInt32 uiSubset = 0; uiSubset < mode.m_uiNumSubsets; ++uiSubset)
+    {
+      plSimdVec4f subsetPixels[16];
+      plUInt8 subsetIndices[16];
+      plUInt32 uiNumPixels = 0;
+
+      for (plUInt32 i = 0; i < 16; ++i)
+      {
+        if (((uiMask >> i) & 1) == uiSubset)
+        {
+          subsetPixels[uiNumPixels++] = pPixels[i];
+        }
+      }
+
+      out_block.m_fError += EncodeSubsetBC7(mode, subsetPixels, uiNumPixels, bOpaque, settings, out_block.m_Endpoints[uiSubset], subsetIndices);
+
+      uiNumPixels = 0;
+      for (plUInt32 i = 0; i < 16; ++i)
+      {
+        if (((uiMask >> i) & 1) == uiSubset)
+        {
+          out_block.m_Indices[i] = subsetIndices[uiNumPixels++];
+        }
+      }
+    }
+  }
+
+  /// \brief Estimates for every two subset partition how well the pixels of each subset fit on a line, and returns the most promising ones.
+  ///
+  /// The estimate is the squared distance of the pixels to the principal axis of their subset, which ignores quantization, but ranks the
+  /// partitions well enough to only encode the best few of them.
+  plUInt32 FindBestPartitionsBC7(const plSimdVec4f* pPixels, plUInt32 uiMaxPartitions, plUInt32* out_pPartitions)
+  {
+    struct Candidate
+    {
+      float m_fError;
+      plUInt32 m_uiPartition;
+    };
+
+    Candidate candidates[64];
+
+    for (plUInt32 uiPartition = 0; uiPartition < 64; ++uiPartition)
+    {
+      const plUInt32 uiMask = s_BC7Partitions2[uiPartition];
+      float fError = 0.0f;
+
+      for (plUInt32 uiSubset = 0; uiSubset < 2; ++uiSubset)
+      {
+        plSimdVec4f vSum = plSimdVec4f::MakeZero();
+        plSimdVec4f vSumSquares[4] = {plSimdVec4f::MakeZero(), plSimdVec4f::MakeZero(), plSimdVec4f::MakeZero(), plSimdVec4f::MakeZero()};
+        plUInt32 uiNumPixels = 0;
+
+        for (plUInt32 i = 0; i < 16; ++i)
+        {
+          if (((uiMask >> i) & 1) != uiSubset)
+            continue;
+
+          const plSimdVec4f& p = pPixels[i];
+          vSum += p;
+          vSumSquares[0] = plSimdVec4f::MulAdd(p, p.x(), vSumSquares[0]);
+          vSumSquares[1] = plSimdVec4f::MulAdd(p, p.y(), vSumSquares[1]);
+          vSumSquares[2] = plSimdVec4f::MulAdd(p, p.z(), vSumSquares[2]);
+          vSumSquares[3] = plSimdVec4f::MulAdd(p, p.w(), vSumSquares[3]);
+          ++uiNumPixels;
+        }
+
+        // scatter matrix of the subset, its trace minus its largest eigenvalue is the squared distance of the pixels to the best fitting line
+        const plSimdFloat fInvNumPixels = 1.0f / static_cast<float>(uiNumPixels);
+        const plSimdVec4f vMean = vSum * fInvNumPixels;
+        const plSimdVec4f vScatter[4] = {
+          vSumSquares[0] - vSum * vMean.x(),
+          vSumSquares[1] - vSum * vMean.y(),
+          vSumSquares[2] - vSum * vMean.z(),
+          vSumSquares[3] - vSum * vMean.w(),
+        };
+
+        const float fTrace = vScatter[0].x() + vScatter[1].y() + vScatter[2].z() + vScatter[3].w();
+
+        plSimdVec4f vAxis = vScatter[0] + vScatter[1] + vScatter[2] + vScatter[3];
+        float fLargestEigenvalue = 0.0f;
+
+        for (plUInt32 uiIteration = 0; uiIteration < 3 && !vAxis.IsZero<4>(plSimdFloat(plMath::SmallEpsilon<float>())); ++uiIteration)
+        {
+          vAxis.Normalize<4>();
+
+          plSimdVec4f vNext = vScatter[0] * vAxis.x();
+          vNext = plSimdVec4f::MulAdd(vScatter[1], vAxis.y(), vNext);
+          vNext = plSimdVec4f::MulAdd(vScatter[2], vAxis.z(), vNext);
+          vNext = plSimdVec4f::MulAdd(vScatter[3], vAxis.w(), vNext);
+
+          fLargestEigenvalue = vNext.Dot<4>(vAxis);
+          vAxis = vNext;
+        }
+
+        fError += plMath::Max(fTrace - fLargestEigenvalue, 0.0f);
+      }
+
+      candidates[uiPartition] = {fError, uiPartition};
+    }
+
+    const plUInt32 uiNumPartitions = plMath::Min(uiMaxPartitions, 64u);
+
+    // partial selection sort, only a few partitions are needed
+    for (plUInt32 i = 0; i < uiNumPartitions; ++i)
+    {
+      plUInt32 uiBest = i;
+      for (plUInt32 j = i + 1; j < 64; ++j)
+      {
+        if (candidates[j].m_fError < candidates[uiBest].m_fError)
+        {
+          uiBest = j;
+        }
+      }
+
+      plMath::Swap(candidates[i], candidates[uiBest]);
+      out_pPartitions[i] = candidates[i].m_uiPartition;
+    }
+
+    return uiNumPartitions;
+  }
+
+  void WriteBlockBC7(BC7Block& ref_block, plUInt8* pTarget)
+  {
+    const BC7Mode& mode = *ref_block.m_pMode;
+    const plUInt32 uiMask = mode.m_uiNumSubsets == 2 ? s_BC7Partitions2[ref_block.m_uiPartition] : 0;
+    const plUInt32 uiHighestIndexBit = 1u << (mode.m_uiIndexBits - 1);
+    const plUInt32 uiMaxIndex = (1u << mode.m_uiIndexBits) - 1;
+
+    plUInt32 anchors[2] = {0, 0};
+    if (mode.m_uiNumSubsets == 2)
+    {
+      anchors[1] = s_BC7Anchors2[ref_block.m_uiPartition];
+    }
+
+    // the most significant bit of the first index of every subset is implicitly zero
+    for (plUInt32 uiSubset = 0; uiSubset < mode.m_uiNumSubsets; ++uiSubset)
+    {
+      if ((ref_block.m_Indices[anchors[uiSubset]] & uiHighestIndexBit) == 0)
+        continue;
+
+      BC7Endpoints& endpoints = ref_block.m_Endpoints[uiSubset];
+      for (plUInt32 c = 0; c < 4; ++c)
+      {
+        plMath::Swap(endpoints.m_Channels[0][c], endpoints.m_Channels[1][c]);
+      }
+
+      plMath::Swap(endpoints.m_PBits[0], endpoints.m_PBits[1]);
+
+      for (plUInt32 i = 0; i < 16; ++i)
+      {
+        if (((uiMask >> i) & 1) == uiSubset)
+        {
+          ref_block.m_Indices[i] = static_cast<plUInt8>(uiMaxIndex - ref_block.m_Indices[i]);
+        }
+      }
+    }
+
+    BitWriter writer(pTarget, 16);
+    writer.Write(1u << mode.m_uiMode, mode.m_uiMode + 1);
+
+    if (mode.m_uiNumSubsets == 2)
+    {
+      writer.Write(ref_block.m_uiPartition, 6);
+    }
+
+    for (plUInt32 c = 0; c < 4; ++c)
+    {
+      const plUInt32 uiBits = c < 3 ? mode.m_uiColorBits : mode.m_uiAlphaBits;
+
+      for (plUInt32 uiSubset = 0; uiSubset < mode.m_uiNumSubsets; ++uiSubset)
+      {
+        writer.Write(ref_block.m_Endpoints[uiSubset].m_Channels[0][c], uiBits);
+        writer.Write(ref_block.m_Endpoints[uiSubset].m_Channels[1][c], uiBits);
+      }
+    }
+
+    for (plUInt32 uiSubset = 0; uiSubset < mode.m_uiNumSubsets; ++uiSubset)
+    {
+      writer.Write(ref_block.m_Endpoints[uiSubset].m_PBits[0], 1);
+
+      if (!mode.m_bSharedPBit)
+      {
+        writer.Write(ref_block.m_Endpoints[uiSubset].m_PBits[1], 1);
+      }
+    }
+
+    for (plUInt32 i = 0; i < 16; ++i)
+    {
+      const bool bIsAnchor = i == anchors[0] || (mode.m_uiNumSubsets == 2 && i == anchors[1]);
+      writer.Write(ref_block.m_Indices[i], bIsAnchor ? mode.m_uiIndexBits - 1 : mode.m_uiIndexBits);
+    }
+  }
+
+  /// \brief Encodes an RGBA block in BC7.
+  ///
+  /// Mode 6 is always tried. Depending on the preset, the most promising two subset partitions are additionally tried with modes 1 and 3
+  /// for opaque blocks and with mode 7 for blocks with alpha, and the mode with the smallest error is written.
+  void EncodeBlockBC7(const plSimdVec4f* pPixels, const CompressionSettings& settings, plUInt8* pTarget)
+  {
+    bool bOpaque = true;
+    for (plUInt32 i = 0; i < 16; ++i)
+    {
+      bOpaque &= pPixels[i].w() >= plSimdFloat(255.0f);
+    }
+
+    BC7Block best;
+    EncodeBlockModeBC7(s_BC7Mode6, 0, pPixels, bOpaque, settings, best);
+
+    if (settings.m_uiBC7Partitions > 0 && best.m_fError > 0.0f)
+    {
+      plUInt32 partitions[64];
+      const plUInt32 uiNumPartitions = FindBestPartitionsBC7(pPixels, settings.m_uiBC7Partitions, partitions);
+
+      // modes 1 and 3 can't store alpha, mode 7 has too few bits to be worth it for opaque blocks
+      const BC7Mode* modes[2] = {&s_BC7Mode1, &s_BC7Mode3};
+      plUInt32 uiNumModes = 2;
+
+      if (!bOpaque)
+      {
+        modes[0] = &s_BC7Mode7;
+        uiNumModes = 1;
+      }
+
+      for (plUInt32 i = 0; i < uiNumPartitions; ++i)
+      {
+        for (plUInt32 uiMode = 0; uiMode < uiNumModes; ++uiMode)
+        {
+          BC7Block block;
+          EncodeBlockModeBC7(*modes[uiMode], partitions[i], pPixels, bOpaque, settings, block);
+
+          if (block.m_fError < best.m_fError)
+          {
+            best = block;
+          }
+        }
+      }
+    }
+
+    WriteBlockBC7(best, pTarget);
+  }
+
+  plImageConversionEntry s_NativeCompressionConversions[] = {
+    plImageConversionEntry(plImageFormat::R8G8B8A8_UNORM, plImageFormat::BC1_UNORM, plImageConversionFlags::Default),
+    plImageConversionEntry(plImageFormat::R8G8B8A8_UNORM, plImageFormat::BC3_UNORM, plImageConversionFlags::Default),
+    plImageConversionEntry(plImageFormat::R8G8B8A8_UNORM, plImageFormat::BC7_UNORM, plImageConversionFlags::Default),
+
+    plImageConversionEntry(plImageFormat::R8G8B8A8_UNORM_SRGB, plImageFormat::BC1_UNORM_SRGB, plImageConversionFlags::Default),
+    plImageConversionEntry(plImageFormat::R8G8B8A8_UNORM_SRGB, plImageFormat::BC3_UNORM_SRGB, plImageConversionFlags::Default),
+    plImageConversionEntry(plImageFormat::R8G8B8A8_UNORM_SRGB, plImageFormat::BC7_UNORM_SRGB, plImageConversionFlags::Default),
+
+    plImageConversionEntry(plImageFormat::R8_UNORM, plImageFormat::BC4_UNORM, plImageConversionFlags::Default),
+    plImageConversionEntry(plImageFormat::R8_SNORM, plImageFormat::BC4_SNORM, plImageConversionFlags::Default),
+    plImageConversionEntry(plImageFormat::R8G8_UNORM, plImageFormat::BC4_UNORM, plImageConversionFlags::Default),
+    plImageConversionEntry(plImageFormat::R8G8_SNORM, plImageFormat::BC4_SNORM, plImageConversionFlags::Default),
+    plImageConversionEntry(plImageFormat::R8G8B8A8_UNORM, plImageFormat::BC4_UNORM, plImageConversionFlags::Default),
+    plImageConversionEntry(plImageFormat::R8G8B8A8_SNORM, plImageFormat::BC4_SNORM, plImageConversionFlags::Default),
+
+    plImageConversionEntry(plImageFormat::R8G8_UNORM, plImageFormat::BC5_UNORM, plImageConversionFlags::Default),
+    plImageConversionEntry(plImageFormat::R8G8_SNORM, plImageFormat::BC5_SNORM, plImageConversionFlags::Default),
+    plImageConversionEntry(plImageFormat::R8G8B8A8_UNORM, plImageFormat::BC5_UNORM, plImageConversionFlags::Default),
+    plImageConversionEntry(plImageFormat::R8G8B8A8_SNORM, plImageFormat::BC5_SNORM, plImageConversionFlags::Default),
+  };
+
+  /// \brief Multithreaded BC1, BC3, BC4, BC5 and BC7 compressor that is available on all platforms.
+  ///
+  /// The quality preset is selected with the 'Texture.BlockCompressionQuality' cvar.
+  class plImageConversion_CompressBlocksNative : public plImageConversionStepCompressBlocks
+  {
+  public:
+    plImageConversion_CompressBlocksNative()
+    {
+      // the cvars are defined above, so they are already constructed
+      UpdatePenalties();
+      m_NativeBlockCompressionSubscription = cvar_TextureNativeBlockCompression.m_CVarEvents.AddEventHandler(&plImageConversion_CompressBlocksNative::OnCVarEvent);
+      m_NativeBC7CompressionSubscription = cvar_TextureNativeBC7Compression.m_CVarEvents.AddEventHandler(&plImageConversion_CompressBlocksNative::OnCVarEvent);
+    }
+
+    ~plImageConversion_CompressBlocksNative()
+    {
+      cvar_TextureNativeBlockCompression.m_CVarEvents.RemoveEventHandler(m_NativeBlockCompressionSubscription);
+      cvar_TextureNativeBC7Compression.m_CVarEvents.RemoveEventHandler(m_NativeBC7CompressionSubscription);
+    }
+
+    virtual plArrayPtr<const plImageConversionEntry> GetSupportedConversions() const override
+    {
+      return s_NativeCompressionConversions;
+    }
+
+    virtual plResult CompressBlocks(plConstByteBlobPtr source, plByteBlobPtr target, plUInt32 numBlocksX, plUInt32 numBlocksY,
+      plImageFormat::Enum sourceFormat, plImageFormat::Enum targetFormat) const override
+    {
+      const plImageFormat::Enum linearTargetFormat = plImageFormat::AsLinear(targetFormat);
+
+      if (linearTargetFormat != plImageFormat::BC1_UNORM && linearTargetFormat != plImageFormat::BC3_UNORM &&
+          linearTargetFormat != plImageFormat::BC4_UNORM && linearTargetFormat != plImageFormat::BC4_SNORM &&
+          linearTargetFormat != plImageFormat::BC5_UNORM && linearTargetFormat != plImageFormat::BC5_SNORM &&
+          linearTargetFormat != plImageFormat::BC7_UNORM)
+      {
+        return PL_FAILURE;
+      }
+
+      const CompressionSettings settings = GetCompressionSettings();
+      const plUInt32 uiStride = plImageFormat::GetBitsPerPixel(sourceFormat) / 8;
+      const plUInt64 uiRowPitch = plImageFormat::GetRowPitch(sourceFormat, 4 * numBlocksX);
+      const plUInt32 uiBlockSize = plImageFormat::GetBitsPerBlock(targetFormat) / 8;
+
+      // Bias to shift signed data into unsigned range so we can treat it the same as unsigned
+      const plUInt8 uiBias = (plImageFormat::GetDataType(sourceFormat) == plImageFormatDataType::SNORM) ? 128 : 0;
+
+      plParallelForParams params;
+      params.m_uiBinSize = 64;
+
+      plTaskSystem::ParallelForIndexed(
+        0u, numBlocksX * numBlocksY,
+        [&](plUInt32 uiStartBlock, plUInt32 uiEndBlock)
+        {
+          for (plUInt32 uiBlock = uiStartBlock; uiBlock < uiEndBlock; ++uiBlock)
+          {
+            const plUInt32 blockX = uiBlock % numBlocksX;
+            const plUInt32 blockY = uiBlock / numBlocksX;
+
+            const plUInt8* pSource = static_cast<const plUInt8*>(source.GetPtr()) + 4 * blockY * uiRowPitch + 4 * blockX * uiStride;
+            plUInt8* pTarget = static_cast<plUInt8*>(target.GetPtr()) + uiBlock * uiBlockSize;
+
+            if (linearTargetFormat == plImageFormat::BC4_UNORM || linearTargetFormat == plImageFormat::BC4_SNORM ||
+                linearTargetFormat == plImageFormat::BC5_UNORM || linearTargetFormat == plImageFormat::BC5_SNORM)
+            {
+              const plUInt32 uiNumChannels = (linearTargetFormat == plImageFormat::BC5_UNORM || linearTargetFormat == plImageFormat::BC5_SNORM) ? 2 : 1;
+
+              for (plUInt32 uiChannel = 0; uiChannel < uiNumChannels; ++uiChannel)
+              {
+                plUInt8 values[16];
+                for (plUInt32 i = 0; i < 16; ++i)
+                {
+                  values[i] = pSource[(i / 4) * uiRowPitch + (i % 4) * uiStride + uiChannel] + uiBias;
+                }
+
+                // the explicit 0 and 255 entries don't map to the signed range, so that mode is only used for unsigned data
+                EncodeBlockBC4(values, settings.m_bTryBC4SixValueMode && uiBias == 0, settings, pTarget + 8 * uiChannel);
+
+                // Undo biasing for signed formats by shifting palette upper and lower bound back into signed range
+                pTarget[8 * uiChannel + 0] -= uiBias;
+                pTarget[8 * uiChannel + 1] -= uiBias;
+              }
+
+              continue;
+            }
+
+            plSimdVec4f pixels[16];
+            for (plUInt32 i = 0; i < 16; ++i)
+            {
+              const plUInt8* pPixel = pSource + (i / 4) * uiRowPitch + (i % 4) * uiStride;
+              pixels[i] = plSimdVec4f(pPixel[0], pPixel[1], pPixel[2], pPixel[3]);
+            }
+
+            if (linearTargetFormat == plImageFormat::BC1_UNORM)
+            {
+              EncodeColorBlock(pixels, true, settings, pTarget);
+            }
+            else if (linearTargetFormat == plImageFormat::BC3_UNORM)
+            {
+              plUInt8 alpha[16];
+              for (plUInt32 i = 0; i < 16; ++i)
+              {
+                alpha[i] = pSource[(i / 4) * uiRowPitch + (i % 4) * uiStride + 3];
+              }
+
+              EncodeBlockBC4(alpha, settings.m_bTryBC4SixValueMode, settings, pTarget);
+              EncodeColorBlock(pixels, false, settings, pTarget + 8);
+            }
+            else
+            {
+              EncodeBlockBC7(pixels, settings, pTarget);
+            }
+          }
+        },
+        "plImageConversion_CompressBlocksNative", plTaskNesting::Maybe, params);
+
+      return PL_SUCCESS;
+    }
+
+  private:
+    static void OnCVarEvent(const plCVarEvent& e)
+    {
+      if (e.m_EventType == plCVarEvent::ValueChanged)
+      {
+        UpdatePenalties();
+        InvalidateConversionTable();
+      }
+    }
+
+    static void UpdatePenalties()
+    {
+      // The penalty makes DirectX hardware conversions and the SSE BC4 / BC5 compressors win over this step, but it is preferred over the
+      // DirectXTex software encoders. Disabling it through the cvars turns it into a last resort.
+      const float fPenalty = cvar_TextureNativeBlockCompression ? 1.0f : 2000.0f;
+      const float fPenaltyBC7 = (cvar_TextureNativeBlockCompression && cvar_TextureNativeBC7Compression) ? 1.0f : 2000.0f;
+
+      for (auto& entry : s_NativeCompressionConversions)
+      {
+        const bool bIsBC7 = plImageFormat::AsLinear(entry.m_targetFormat) == plImageFormat::BC7_UNORM;
+        entry.m_additionalPenalty = bIsBC7 ? fPenaltyBC7 : fPenalty;
+      }
+    }
+
+    plEventSubscriptionID m_NativeBlockCompressionSubscription = 0;
+    plEventSubscriptionID m_NativeBC7CompressionSubscription = 0;
+  };
+} // namespace
+
+// PL_STATICLINK_FORCE
+static plImageConversion_CompressBlocksNative s_conversion_compressBlocksNative;
+
+
+
+PL_STATICLINK_FILE(Texture, Texture_Image_Conversions_BlockCompressionConversions);
@@ -5,8 +5,12 @@
 #  include <Texture/DirectXTex/BC.h>
 #  include <Texture/Image/ImageConversion.h>
 
+#  include <Foundation/Configuration/CVar.h>
 #  include <Foundation/Threading/TaskSystem.h>
 
+extern plCVarBool cvar_TextureNativeBlockCompression;
+extern plCVarBool cvar_TextureNativeBC7Compression;
+
 
 plImageConversionEntry g_DXTexCpuConversions[] = {
   plImageConversionEntry(plImageFormat::R32G32B32A32_FLOAT, plImageFormat::BC6H_UF16, plImageConversionFlags::Default),
@@ -23,9 +27,51 @@ class plImageConversion_CompressDxTexCpu : public plImageConversionStepCompressB
 public:
   virtual plArrayPtr<const plImageConversionEntry> GetSupportedConversions() const override
   {
+    // the cvars are defined in another file and may not be constructed yet when this step is, so the penalties are set up on first use
+    static const bool s_bPenaltiesInitialized = []()
+    {
+      UpdatePenalties();
+      cvar_TextureNativeBlockCompression.m_CVarEvents.AddEventHandler(&plImageConversion_CompressDxTexCpu::OnCVarEvent);
+      cvar_TextureNativeBC7Compression.m_CVarEvents.AddEventHandler(&plImageConversion_CompressDxTexCpu::OnCVarEvent);
+      return true;
+    }();
+    PL_IGNORE_UNUSED(s_bPenaltiesInitialized);
+
     return g_DXTexCpuConversions;
   }
 
+private:
+  static void OnCVarEvent(const plCVarEvent& e)
+  {
+    if (e.m_EventType == plCVarEvent::ValueChanged)
+    {
+      UpdatePenalties();
+      InvalidateConversionTable();
+    }
+  }
+
+  static void UpdatePenalties()
+  {
+    // The native block compressor is much faster, so it is preferred unless it is disabled. BC6H is always encoded here.
+    const bool bNativeBC1 = cvar_TextureNativeBlockCompression;
+    const bool bNativeBC7 = cvar_TextureNativeBlockCompression && cvar_TextureNativeBC7Compression;
+
+    for (auto& entry : g_DXTexCpuConversions)
+    {
+      const plImageFormat::Enum linearTargetFormat = plImageFormat::AsLinear(entry.m_targetFormat);
+
+      if (linearTargetFormat == plImageFormat::BC1_UNORM)
+      {
+        entry.m_additionalPenalty = bNativeBC1 ? 2.0f : 0.0f;
+      }
+      else if (linearTargetFormat == plImageFormat::BC7_UNORM)
+      {
+        entry.m_additionalPenalty = bNativeBC7 ? 2.0f : 0.0f;
+      }
+    }
+  }
+
+public:
   virtual plResult CompressBlocks(plConstByteBlobPtr source, plByteBlobPtr target, plUInt32 numBlocksX, plUInt32 numBlocksY,
     plImageFormat::Enum sourceFormat, plImageFormat::Enum targetFormat) const override
   {
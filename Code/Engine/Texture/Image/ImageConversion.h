@@ -41,10 +41,13 @@ protected:
   plImageConversionStep();
   virtual ~plImageConversionStep();
 
+  /// \brief Has to be called when the penalties of the entries returned by GetSupportedConversions() change, so that the conversion paths are rebuilt.
+  static void InvalidateConversionTable();
+
 public:
   /// \brief Returns an array pointer of supported conversions.
   ///
-  /// \note The returned array must have the same entries each time this method is called.
+  /// \note The returned array must have the same entries each time this method is called. Only their penalties may change, see InvalidateConversionTable().
   virtual plArrayPtr<const plImageConversionEntry> GetSupportedConversions() const = 0;
 };
 
@@ -92,6 +92,12 @@ public:
   /// Genererates the mip maps for the image. The input texture must be in plImageFormat::R32_G32_B32_A32_FLOAT
   static void GenerateMipMaps(const plImageView& source, plImage& ref_target, const MipMapOptions& options);
 
+  /// \brief Enables or disables distributing the work of GenerateMipMaps() and Scale3D() over the task system. Enabled by default.
+  ///
+  /// The output is identical either way, disabling it is meant for comparing results and timings against serial processing.
+  static void SetMultithreading(bool bEnable);
+  static bool IsMultithreadingEnabled();
+
   /// Assumes that the Red and Green components of an image contain XY of an unit length normal and reconstructs the Z component into B
   static void ReconstructNormalZ(plImage& ref_source);
 
@@ -153,6 +153,12 @@ plImageConversionStep::~plImageConversionStep()
   s_conversionTableValid = false;
 }
 
+void plImageConversionStep::InvalidateConversionTable()
+{
+  PL_LOCK(s_conversionTableLock);
+  s_conversionTableValid = false;
+}
+
 plResult plImageConversion::BuildPath(plImageFormat::Enum sourceFormat, plImageFormat::Enum targetFormat, bool bSourceEqualsTarget,
   plHybridArray<plImageConversion::ConversionPathNode, 16>& ref_path_out, plUInt32& ref_uiNumScratchBuffers_out)
 {
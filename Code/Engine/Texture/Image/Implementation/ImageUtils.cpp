@@ -5,6 +5,7 @@
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/SimdMath/SimdVec4f.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Timestamp.h>
 #include <Texture/Image/ImageConversion.h>
 #include <Texture/Image/ImageEnums.h>
@@ -738,6 +739,32 @@ inline static void FilterLine(
   }
 }
 
+static bool s_bImageUtilsMultithreading = true;
+
+void plImageUtils::SetMultithreading(bool bEnable)
+{
+  s_bImageUtilsMultithreading = bEnable;
+}
+
+bool plImageUtils::IsMultithreadingEnabled()
+{
+  return s_bImageUtilsMultithreading;
+}
+
+/// \brief Calls filterLines for ranges of the lines of one Scale3D pass, distributed over the task system.
+///
+/// Every line is filtered independently of all others, so the result does not depend on how the lines are distributed.
+/// uiLineLength is used to keep small images on the calling thread, where the task overhead would dominate.
+static void FilterLinesParallel(plUInt32 uiNumLines, plUInt32 uiLineLength, plParallelForIndexedFunction32 filterLines)
+{
+  constexpr plUInt32 uiMinPixelsPerTask = 16 * 1024;
+
+  plParallelForParams params;
+  params.m_uiBinSize = s_bImageUtilsMultithreading ? plMath::Max(1u, uiMinPixelsPerTask / plMath::Max(1u, uiLineLength)) : plMath::Max(1u, uiNumLines);
+
+  plTaskSystem::ParallelForIndexed(0u, uiNumLines, std::move(filterLines), "plImageUtils::Scale3D", plTaskNesting::Maybe, params);
+}
+
 static void DownScaleFastLine(plUInt32 uiPixelStride, const plUInt8* pSrc, plUInt8* pDest, plUInt32 uiLengthIn, plUInt32 uiStrideIn, plUInt32 uiLengthOut, plUInt32 uiStrideOut)
 {
   const plUInt32 downScaleFactor = uiLengthIn / uiLengthOut;
@@ -1005,6 +1032,8 @@ plResult plImageUtils::Scale3D(const plImageView& source, plImage& ref_target, p
   plHybridArray<plInt32, 256> firstSampleIndices;
   firstSampleIndices.Reserve(plMath::Max(uiWidth, uiHeight, uiDepth));
 
+  const plSimdVec4f vBorderColor(borderColor.r, borderColor.g, borderColor.b, borderColor.a);
+
   if (uiWidth != originalWidth)
   {
     plImageFilterWeights weights(*pFilter, originalWidth, uiWidth);
@@ -1028,21 +1057,22 @@ plResult plImageUtils::Scale3D(const plImageView& source, plImage& ref_target, p
     stepHeader.SetWidth(uiWidth);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (plUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (plUInt32 face = 0; face < numFaces; ++face)
+    // one line per row of every depth slice, face and array element
+    FilterLinesParallel(numArrayElements * numFaces * originalDepth * originalHeight, originalWidth,
+      [&](plUInt32 uiStartLine, plUInt32 uiEndLine)
       {
-        for (plUInt32 z = 0; z < originalDepth; ++z)
+        for (plUInt32 uiLine = uiStartLine; uiLine < uiEndLine; ++uiLine)
         {
-          for (plUInt32 y = 0; y < originalHeight; ++y)
-          {
-            const plSimdVec4f* filterSource = stepSource->GetPixelPointer<plSimdVec4f>(0, face, arrayIndex, 0, y, z);
-            plSimdVec4f* filterTarget = stepTarget->GetPixelPointer<plSimdVec4f>(0, face, arrayIndex, 0, y, z);
-            FilterLine(originalWidth, filterSource, filterTarget, 1, weights, firstSampleIndices, addressModeU, plSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
+          const plUInt32 y = uiLine % originalHeight;
+          const plUInt32 z = (uiLine / originalHeight) % originalDepth;
+          const plUInt32 face = (uiLine / (originalHeight * originalDepth)) % numFaces;
+          const plUInt32 arrayIndex = uiLine / (originalHeight * originalDepth * numFaces);
+
+          const plSimdVec4f* filterSource = stepSource->GetPixelPointer<plSimdVec4f>(0, face, arrayIndex, 0, y, z);
+          plSimdVec4f* filterTarget = stepTarget->GetPixelPointer<plSimdVec4f>(0, face, arrayIndex, 0, y, z);
+          FilterLine(originalWidth, filterSource, filterTarget, 1, weights, firstSampleIndices, addressModeU, vBorderColor);
         }
-      }
-    }
+      });
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -1071,21 +1101,22 @@ plResult plImageUtils::Scale3D(const plImageView& source, plImage& ref_target, p
     stepHeader.SetHeight(uiHeight);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (plUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (plUInt32 face = 0; face < numFaces; ++face)
+    // one line per column of every depth slice, face and array element
+    FilterLinesParallel(numArrayElements * numFaces * originalDepth * uiWidth, originalHeight,
+      [&](plUInt32 uiStartLine, plUInt32 uiEndLine)
       {
-        for (plUInt32 z = 0; z < originalDepth; ++z)
+        for (plUInt32 uiLine = uiStartLine; uiLine < uiEndLine; ++uiLine)
         {
-          for (plUInt32 x = 0; x < uiWidth; ++x)
-          {
-            const plSimdVec4f* filterSource = stepSource->GetPixelPointer<plSimdVec4f>(0, face, arrayIndex, x, 0, z);
-            plSimdVec4f* filterTarget = stepTarget->GetPixelPointer<plSimdVec4f>(0, face, arrayIndex, x, 0, z);
-            FilterLine(originalHeight, filterSource, filterTarget, uiWidth, weights, firstSampleIndices, addressModeV, plSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
+          const plUInt32 x = uiLine % uiWidth;
+          const plUInt32 z = (uiLine / uiWidth) % originalDepth;
+          const plUInt32 face = (uiLine / (uiWidth * originalDepth)) % numFaces;
+          const plUInt32 arrayIndex = uiLine / (uiWidth * originalDepth * numFaces);
+
+          const plSimdVec4f* filterSource = stepSource->GetPixelPointer<plSimdVec4f>(0, face, arrayIndex, x, 0, z);
+          plSimdVec4f* filterTarget = stepTarget->GetPixelPointer<plSimdVec4f>(0, face, arrayIndex, x, 0, z);
+          FilterLine(originalHeight, filterSource, filterTarget, uiWidth, weights, firstSampleIndices, addressModeV, vBorderColor);
         }
-      }
-    }
+      });
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -1114,21 +1145,22 @@ plResult plImageUtils::Scale3D(const plImageView& source, plImage& ref_target, p
     stepHeader.SetDepth(uiDepth);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (plUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (plUInt32 face = 0; face < numFaces; ++face)
+    // one line per pixel of every face and array element
+    FilterLinesParallel(numArrayElements * numFaces * uiHeight * uiWidth, originalDepth,
+      [&](plUInt32 uiStartLine, plUInt32 uiEndLine)
       {
-        for (plUInt32 y = 0; y < uiHeight; ++y)
+        for (plUInt32 uiLine = uiStartLine; uiLine < uiEndLine; ++uiLine)
         {
-          for (plUInt32 x = 0; x < uiWidth; ++x)
-          {
-            const plSimdVec4f* filterSource = stepSource->GetPixelPointer<plSimdVec4f>(0, face, arrayIndex, x, y, 0);
-            plSimdVec4f* filterTarget = stepTarget->GetPixelPointer<plSimdVec4f>(0, face, arrayIndex, x, y, 0);
-            FilterLine(originalHeight, filterSource, filterTarget, uiWidth * uiHeight, weights, firstSampleIndices, addressModeW, plSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
+          const plUInt32 x = uiLine % uiWidth;
+          const plUInt32 y = (uiLine / uiWidth) % uiHeight;
+          const plUInt32 face = (uiLine / (uiWidth * uiHeight)) % numFaces;
+          const plUInt32 arrayIndex = uiLine / (uiWidth * uiHeight * numFaces);
+
+          const plSimdVec4f* filterSource = stepSource->GetPixelPointer<plSimdVec4f>(0, face, arrayIndex, x, y, 0);
+          plSimdVec4f* filterTarget = stepTarget->GetPixelPointer<plSimdVec4f>(0, face, arrayIndex, x, y, 0);
+          FilterLine(originalDepth, filterSource, filterTarget, uiWidth * uiHeight, weights, firstSampleIndices, addressModeW, vBorderColor);
         }
-      }
-    }
+      });
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -1168,58 +1200,71 @@ void plImageUtils::GenerateMipMaps(const plImageView& source, plImage& ref_targe
 
   ref_target.ResetAndAlloc(header);
 
-  for (plUInt32 arrayIndex = 0; arrayIndex < source.GetNumArrayIndices(); arrayIndex++)
-  {
-    for (plUInt32 face = 0; face < source.GetNumFaces(); face++)
-    {
-      plImageHeader currentMipMapHeader = header;
-      currentMipMapHeader.SetNumMipLevels(1);
-      currentMipMapHeader.SetNumFaces(1);
-      currentMipMapHeader.SetNumArrayIndices(1);
-
-      auto sourceView = source.GetSubImageView(0, face, arrayIndex).GetByteBlobPtr();
-      auto targetView = ref_target.GetSubImageView(0, face, arrayIndex).GetByteBlobPtr();
-
-      memcpy(targetView.GetPtr(), sourceView.GetPtr(), static_cast<size_t>(targetView.GetCount()));
+  const plUInt32 numFaces = source.GetNumFaces();
+  const plUInt32 numSlices = source.GetNumArrayIndices() * numFaces;
 
-      float targetCoverage = 0.0f;
-      if (mipMapOptions.m_preserveCoverage)
-      {
-        targetCoverage = EvaluateAverageCoverage(source.GetSubImageView(0, face, arrayIndex).GetBlobPtr<plColor>(), mipMapOptions.m_alphaThreshold);
-      }
+  plParallelForParams params;
+  params.m_uiBinSize = s_bImageUtilsMultithreading ? 1u : numSlices;
 
-      for (plUInt32 mipMapLevel = 0; mipMapLevel < numMipMaps - 1; mipMapLevel++)
+  // every face and array element has its own mip chain, Scale3D additionally distributes the rows of each mip level over the task system
+  plTaskSystem::ParallelForIndexed(
+    0u, numSlices,
+    [&](plUInt32 uiStartSlice, plUInt32 uiEndSlice)
+    {
+      for (plUInt32 uiSlice = uiStartSlice; uiSlice < uiEndSlice; ++uiSlice)
       {
-        plImageHeader nextMipMapHeader = currentMipMapHeader;
-        nextMipMapHeader.SetWidth(plMath::Max(1u, nextMipMapHeader.GetWidth() / 2));
-        nextMipMapHeader.SetHeight(plMath::Max(1u, nextMipMapHeader.GetHeight() / 2));
-        nextMipMapHeader.SetDepth(plMath::Max(1u, nextMipMapHeader.GetDepth() / 2));
+        const plUInt32 arrayIndex = uiSlice / numFaces;
+        const plUInt32 face = uiSlice % numFaces;
 
-        auto sourceData = ref_target.GetSubImageView(mipMapLevel, face, arrayIndex).GetByteBlobPtr();
-        plImage currentMipMap;
-        currentMipMap.ResetAndUseExternalStorage(currentMipMapHeader, sourceData);
+        plImageHeader currentMipMapHeader = header;
+        currentMipMapHeader.SetNumMipLevels(1);
+        currentMipMapHeader.SetNumFaces(1);
+        currentMipMapHeader.SetNumArrayIndices(1);
 
-        auto dstData = ref_target.GetSubImageView(mipMapLevel + 1, face, arrayIndex).GetByteBlobPtr();
-        plImage nextMipMap;
-        nextMipMap.ResetAndUseExternalStorage(nextMipMapHeader, dstData);
+        auto sourceView = source.GetSubImageView(0, face, arrayIndex).GetByteBlobPtr();
+        auto targetView = ref_target.GetSubImageView(0, face, arrayIndex).GetByteBlobPtr();
 
-        plImageUtils::Scale3D(currentMipMap, nextMipMap, nextMipMapHeader.GetWidth(), nextMipMapHeader.GetHeight(), nextMipMapHeader.GetDepth(), mipMapOptions.m_filter, mipMapOptions.m_addressModeU, mipMapOptions.m_addressModeV, mipMapOptions.m_addressModeW, mipMapOptions.m_borderColor)
-          .IgnoreResult();
+        memcpy(targetView.GetPtr(), sourceView.GetPtr(), static_cast<size_t>(targetView.GetCount()));
 
+        float targetCoverage = 0.0f;
         if (mipMapOptions.m_preserveCoverage)
         {
-          NormalizeCoverage(nextMipMap.GetBlobPtr<plColor>(), mipMapOptions.m_alphaThreshold, targetCoverage);
+          targetCoverage = EvaluateAverageCoverage(source.GetSubImageView(0, face, arrayIndex).GetBlobPtr<plColor>(), mipMapOptions.m_alphaThreshold);
         }
 
-        if (mipMapOptions.m_renormalizeNormals)
+        for (plUInt32 mipMapLevel = 0; mipMapLevel < numMipMaps - 1; mipMapLevel++)
         {
-          RenormalizeNormalMap(nextMipMap);
-        }
+          plImageHeader nextMipMapHeader = currentMipMapHeader;
+          nextMipMapHeader.SetWidth(plMath::Max(1u, nextMipMapHeader.GetWidth() / 2));
+          nextMipMapHeader.SetHeight(plMath::Max(1u, nextMipMapHeader.GetHeight() / 2));
+          nextMipMapHeader.SetDepth(plMath::Max(1u, nextMipMapHeader.GetDepth() / 2));
 
-        currentMipMapHeader = nextMipMapHeader;
+          auto sourceData = ref_target.GetSubImageView(mipMapLevel, face, arrayIndex).GetByteBlobPtr();
+          plImage currentMipMap;
+          currentMipMap.ResetAndUseExternalStorage(currentMipMapHeader, sourceData);
+
+          auto dstData = ref_target.GetSubImageView(mipMapLevel + 1, face, arrayIndex).GetByteBlobPtr();
+          plImage nextMipMap;
+          nextMipMap.ResetAndUseExternalStorage(nextMipMapHeader, dstData);
+
+          plImageUtils::Scale3D(currentMipMap, nextMipMap, nextMipMapHeader.GetWidth(), nextMipMapHeader.GetHeight(), nextMipMapHeader.GetDepth(), mipMapOptions.m_filter, mipMapOptions.m_addressModeU, mipMapOptions.m_addressModeV, mipMapOptions.m_addressModeW, mipMapOptions.m_borderColor)
+            .IgnoreResult();
+
+          if (mipMapOptions.m_preserveCoverage)
+          {
+            NormalizeCoverage(nextMipMap.GetBlobPtr<plColor>(), mipMapOptions.m_alphaThreshold, targetCoverage);
+          }
+
+          if (mipMapOptions.m_renormalizeNormals)
+          {
+            RenormalizeNormalMap(nextMipMap);
+          }
+
+          currentMipMapHeader = nextMipMapHeader;
+        }
       }
-    }
-  }
+    },
+    "plImageUtils::GenerateMipMaps", plTaskNesting::Maybe, params);
 }
 
 void plImageUtils::ReconstructNormalZ(plImage& ref_image)
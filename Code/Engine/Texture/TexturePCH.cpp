@@ -5,6 +5,7 @@ PL_STATICLINK_LIBRARY(Texture)
   if (bReturn)
     return;
 
+  PL_STATICLINK_REFERENCE(Texture_Image_Conversions_BlockCompressionConversions);
   PL_STATICLINK_REFERENCE(Texture_Image_Conversions_DXTConversions);
   PL_STATICLINK_REFERENCE(Texture_Image_Conversions_DXTexConversions);
   PL_STATICLINK_REFERENCE(Texture_Image_Conversions_DXTexCpuConversions);
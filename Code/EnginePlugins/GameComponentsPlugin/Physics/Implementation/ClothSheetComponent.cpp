@@ -19,6 +19,7 @@
 #include <RendererCore/Pipeline/RenderPipeline.h>
 #include <RendererCore/Pipeline/RenderPipelinePass.h>
 #include <RendererCore/RenderContext/RenderContext.h>
+#include <RendererCore/Textures/TextureStreaming.h>
 #include <RendererFoundation/Device/Device.h>
 
 /* TODO:
@@ -488,6 +489,8 @@ void plClothSheetRenderer::RenderBatch(const plRenderViewContext& renderViewCont
 
   plResourceLock<plDynamicMeshBufferResource> pBuffer(m_hDynamicMeshBuffer, plResourceAcquireMode::BlockTillLoaded);
 
+  const bool bReportTextureUsage = plTextureStreaming::ShouldReportUsage(renderViewContext);
+
   for (auto it = batch.GetIterator<plClothSheetRenderData>(0, batch.GetCount()); it.IsValid(); ++it)
   {
     const plClothSheetRenderData* pRenderData = it;
@@ -496,6 +499,11 @@ void plClothSheetRenderer::RenderBatch(const plRenderViewContext& renderViewCont
 
     pRenderContext->BindMaterial(pRenderData->m_hMaterial);
 
+    if (bReportTextureUsage)
+    {
+      plTextureStreaming::ReportMaterialUsage(pRenderData->m_hMaterial, plTextureStreaming::ComputeScreenSize(pRenderData->m_GlobalBounds, renderViewContext));
+    }
+
     plUInt32 uiInstanceDataOffset = 0;
     plArrayPtr<plPerInstanceData> instanceData = pInstanceData->GetInstanceData(1, uiInstanceDataOffset);
 
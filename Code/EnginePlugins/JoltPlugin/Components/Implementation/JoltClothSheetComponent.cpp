@@ -29,6 +29,7 @@
 #include <RendererCore/Pipeline/RenderPipeline.h>
 #include <RendererCore/Pipeline/RenderPipelinePass.h>
 #include <RendererCore/RenderContext/RenderContext.h>
+#include <RendererCore/Textures/TextureStreaming.h>
 #include <RendererFoundation/Device/Device.h>
 
 // clang-format off
@@ -667,6 +668,8 @@ void plJoltClothSheetRenderer::RenderBatch(const plRenderViewContext& renderView
 
   plResourceLock<plDynamicMeshBufferResource> pBuffer(m_hDynamicMeshBuffer, plResourceAcquireMode::BlockTillLoaded);
 
+  const bool bReportTextureUsage = plTextureStreaming::ShouldReportUsage(renderViewContext);
+
   for (auto it = batch.GetIterator<plJoltClothSheetRenderData>(0, batch.GetCount()); it.IsValid(); ++it)
   {
     const plJoltClothSheetRenderData* pRenderData = it;
@@ -675,6 +678,11 @@ void plJoltClothSheetRenderer::RenderBatch(const plRenderViewContext& renderView
 
     pRenderContext->BindMaterial(pRenderData->m_hMaterial);
 
+    if (bReportTextureUsage)
+    {
+      plTextureStreaming::ReportMaterialUsage(pRenderData->m_hMaterial, plTextureStreaming::ComputeScreenSize(pRenderData->m_GlobalBounds, renderViewContext));
+    }
+
     plUInt32 uiInstanceDataOffset = 0;
     plArrayPtr<plPerInstanceData> instanceData = pInstanceData->GetInstanceData(1, uiInstanceDataOffset);
 
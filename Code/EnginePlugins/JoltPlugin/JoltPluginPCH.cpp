@@ -40,6 +40,7 @@ PL_STATICLINK_LIBRARY(JoltPlugin)
   PL_STATICLINK_REFERENCE(JoltPlugin_System_JoltContacts);
   PL_STATICLINK_REFERENCE(JoltPlugin_System_JoltCore);
   PL_STATICLINK_REFERENCE(JoltPlugin_System_JoltDebugRenderer);
+  PL_STATICLINK_REFERENCE(JoltPlugin_System_JoltJobSystem);
   PL_STATICLINK_REFERENCE(JoltPlugin_System_JoltQueries);
   PL_STATICLINK_REFERENCE(JoltPlugin_System_JoltWorldModule);
 }
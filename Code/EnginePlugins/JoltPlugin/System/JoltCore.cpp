@@ -12,6 +12,7 @@
 #include <JoltPlugin/Shapes/Implementation/JoltCustomShapeInfo.h>
 #include <JoltPlugin/System/JoltCore.h>
 #include <JoltPlugin/System/JoltDebugRenderer.h>
+#include <JoltPlugin/System/JoltJobSystem.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <stdarg.h>
 
@@ -37,6 +38,8 @@ PL_END_STATIC_REFLECTED_BITFLAGS;
 plJoltMaterial* plJoltCore::s_pDefaultMaterial = nullptr;
 std::unique_ptr<JPH::JobSystem> plJoltCore::s_pJobSystem;
 
+plCVarBool cvar_JoltUseTaskSystem("Jolt.UseTaskSystem", true, plCVarFlags::RequiresRestart, "Whether Jolt jobs run on the plTaskSystem or on a separate Jolt thread pool.");
+
 plUniquePtr<plProxyAllocator> plJoltCore::s_pAllocator;
 
 plJoltMaterial::plJoltMaterial() = default;
@@ -114,8 +117,14 @@ void plJoltCore::Startup()
 
   plJoltCustomShapeInfo::sRegister();
 
-  // TODO: custom job system
-  s_pJobSystem = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, std::thread::hardware_concurrency() - 1);
+  if (cvar_JoltUseTaskSystem)
+  {
+    s_pJobSystem = std::make_unique<plJoltJobSystem>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+  }
+  else
+  {
+    s_pJobSystem = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, std::thread::hardware_concurrency() - 1);
+  }
 
   s_pDefaultMaterial = new plJoltMaterial;
   s_pDefaultMaterial->AddRef();
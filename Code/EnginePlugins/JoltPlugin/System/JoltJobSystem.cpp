@@ -0,0 +1,136 @@
+#include <JoltPlugin/JoltPluginPCH.h>
+
+#include <Foundation/Threading/TaskSystem.h>
+#include <JoltPlugin/System/JoltJobSystem.h>
+
+/// \brief Executes a single Jolt job. Returns itself to the pool of its job system once it has finished.
+class plJoltJobSystem::JobTask final : public plTask
+{
+public:
+  JobTask(plJoltJobSystem* pJobSystem)
+  {
+    ConfigureTask("Jolt Job", plTaskNesting::Never, plMakeDelegate(&plJoltJobSystem::ReleaseTask, pJobSystem));
+  }
+
+  Job* m_pJob = nullptr;
+
+private:
+  virtual void Execute() override
+  {
+    // does nothing, if a thread that waits for a barrier already executed the job
+    m_pJob->Execute();
+
+    // release the reference that was added in QueueJob()
+    m_pJob->Release();
+    m_pJob = nullptr;
+  }
+};
+
+plJoltJobSystem::plJoltJobSystem(plUInt32 uiMaxJobs, plUInt32 uiMaxBarriers)
+  : JPH::JobSystemWithBarrier(uiMaxBarriers)
+{
+  m_Jobs.Init(uiMaxJobs, uiMaxJobs);
+}
+
+plJoltJobSystem::~plJoltJobSystem()
+{
+  // tasks call ReleaseTask() after their job is done, so wait until that has happened for all of them
+  plTaskSystem::WaitForCondition([this]()
+    {
+      PL_LOCK(m_TasksMutex);
+      return m_FreeTasks.GetCount() == m_uiNumTasks; });
+}
+
+int plJoltJobSystem::GetMaxConcurrency() const
+{
+  // the thread that waits for a barrier executes jobs as well
+  return static_cast<int>(plTaskSystem::GetWorkerThreadCount(plWorkerThreadType::ShortTasks)) + 1;
+}
+
+JPH::JobHandle plJoltJobSystem::CreateJob(const char* szName, JPH::ColorArg color, const JobFunction& jobFunction, JPH::uint32 uiNumDependencies)
+{
+  JPH::uint32 uiIndex = m_Jobs.ConstructObject(szName, color, this, jobFunction, uiNumDependencies);
+
+  if (uiIndex == AvailableJobs::cInvalidObjectIndex)
+  {
+    // jobs that a thread waiting for a barrier has executed itself stay allocated until their task has run
+    // when the worker threads fall behind, help them run those tasks until a job becomes available
+    plTaskSystem::WaitForCondition([&]()
+      {
+        uiIndex = m_Jobs.ConstructObject(szName, color, this, jobFunction, uiNumDependencies);
+        return uiIndex != AvailableJobs::cInvalidObjectIndex; });
+  }
+
+  Job* pJob = &m_Jobs.Get(uiIndex);
+
+  // the handle keeps a reference, the job may be executed and finished immediately after it was queued
+  JPH::JobHandle handle(pJob);
+
+  if (uiNumDependencies == 0)
+  {
+    QueueJob(pJob);
+  }
+
+  return handle;
+}
+
+void plJoltJobSystem::QueueJob(Job* pJob)
+{
+  plTaskSystem::StartSingleTask(AcquireTask(pJob), plTaskPriority::EarlyThisFrame);
+}
+
+void plJoltJobSystem::QueueJobs(Job** pJobs, JPH::uint uiNumJobs)
+{
+  // Jolt queues all jobs whose dependencies were resolved at the same time together, start them as one group
+  plTaskGroupID group = plTaskSystem::CreateTaskGroup(plTaskPriority::EarlyThisFrame);
+
+  for (JPH::uint i = 0; i < uiNumJobs; ++i)
+  {
+    plTaskSystem::AddTaskToGroup(group, AcquireTask(pJobs[i]));
+  }
+
+  plTaskSystem::StartTaskGroup(group);
+}
+
+void plJoltJobSystem::FreeJob(Job* pJob)
+{
+  m_Jobs.DestructObject(pJob);
+}
+
+plSharedPtr<plTask> plJoltJobSystem::AcquireTask(Job* pJob)
+{
+  // keeps the job alive until the task has run
+  pJob->AddRef();
+
+  plSharedPtr<plTask> pTask;
+
+  {
+    PL_LOCK(m_TasksMutex);
+
+    if (!m_FreeTasks.IsEmpty())
+    {
+      pTask = m_FreeTasks.PeekBack();
+      m_FreeTasks.PopBack();
+    }
+    else
+    {
+      ++m_uiNumTasks;
+    }
+  }
+
+  if (pTask == nullptr)
+  {
+    pTask = PL_DEFAULT_NEW(JobTask, this);
+  }
+
+  static_cast<JobTask*>(pTask.Borrow())->m_pJob = pJob;
+  return pTask;
+}
+
+void plJoltJobSystem::ReleaseTask(const plSharedPtr<plTask>& pTask)
+{
+  PL_LOCK(m_TasksMutex);
+  m_FreeTasks.PushBack(pTask);
+}
+
+PL_STATICLINK_FILE(JoltPlugin, JoltPlugin_System_JoltJobSystem);
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Types/SharedPtr.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+#include <JoltPlugin/JoltPluginDLL.h>
+
+class plTask;
+
+/// \brief Executes Jolt jobs as tasks of the plTaskSystem, so that the physics simulation shares the worker threads with the rest of the engine.
+///
+/// Every queued job becomes one task. The task objects are pooled and reused once they have finished, and all jobs that Jolt queues together
+/// are started as one task group. Barriers are implemented by JPH::JobSystemWithBarrier, whose Wait() executes all jobs of the barrier
+/// that are ready on the waiting thread. Therefore the simulation always makes progress, even when all worker threads are busy with other tasks.
+class PL_JOLTPLUGIN_DLL plJoltJobSystem final : public JPH::JobSystemWithBarrier
+{
+public:
+  JPH_OVERRIDE_NEW_DELETE
+
+  plJoltJobSystem(plUInt32 uiMaxJobs, plUInt32 uiMaxBarriers);
+  ~plJoltJobSystem();
+
+  virtual int GetMaxConcurrency() const override;
+  virtual JPH::JobHandle CreateJob(const char* szName, JPH::ColorArg color, const JobFunction& jobFunction, JPH::uint32 uiNumDependencies = 0) override;
+
+protected:
+  virtual void QueueJob(Job* pJob) override;
+  virtual void QueueJobs(Job** pJobs, JPH::uint uiNumJobs) override;
+  virtual void FreeJob(Job* pJob) override;
+
+private:
+  class JobTask;
+
+  plSharedPtr<plTask> AcquireTask(Job* pJob);
+  void ReleaseTask(const plSharedPtr<plTask>& pTask);
+
+  using AvailableJobs = JPH::FixedSizeFreeList<Job>;
+  AvailableJobs m_Jobs;
+
+  plMutex m_TasksMutex;
+  plDynamicArray<plSharedPtr<plTask>> m_FreeTasks;
+  plUInt32 m_uiNumTasks = 0;
+};
@@ -1,5 +1,6 @@
 #include <JoltPlugin/JoltPluginPCH.h>
 
+#include <Foundation/Threading/TaskSystem.h>
 #include <JoltPlugin/Actors/JoltActorComponent.h>
 #include <JoltPlugin/Resources/JoltMaterial.h>
 #include <JoltPlugin/Shapes/JoltShapeComponent.h>
@@ -38,6 +39,66 @@ void FillCastResult(plPhysicsCastResult& ref_result, const plVec3& vStart, const
   ref_result.m_pInternalPhysicsShape = reinterpret_cast<void*>(uiShapeId);
 }
 
+struct plJoltWorldModule::BatchShapes
+{
+  plHybridArray<JPH::TransformedShape, 32, plAlignedAllocatorWrapper> m_Shapes;
+  plHybridArray<JPH::AABox, 32, plAlignedAllocatorWrapper> m_Bounds;
+
+  /// \brief Calls func for every shape that overlaps the bounds of a single query, until the collector requests an early out.
+  template <typename Collector, typename Func>
+  void ForEachShape(const JPH::AABox& queryBounds, const Collector& collector, Func func) const
+  {
+    for (plUInt32 i = 0; i < m_Shapes.GetCount() && !collector.ShouldEarlyOut(); ++i)
+    {
+      if (m_Bounds[i].Overlaps(queryBounds))
+      {
+        func(m_Shapes[i]);
+      }
+    }
+  }
+};
+
+// above this, testing every query of a range against every shape gets more expensive than querying the broadphase per query
+static constexpr plUInt32 s_uiMaxBatchShapes = 128;
+
+bool plJoltWorldModule::CollectBatchShapes(const plBoundingBox& box, const QueryFilters& filters, BatchShapes& out_shapes) const
+{
+  class Collector : public JPH::TransformedShapeCollector
+  {
+  public:
+    Collector(BatchShapes& ref_shapes)
+      : m_Shapes(ref_shapes)
+    {
+    }
+
+    BatchShapes& m_Shapes;
+    bool m_bTooMany = false;
+
+    virtual void AddHit(const JPH::TransformedShape& shape) override
+    {
+      if (m_Shapes.m_Shapes.GetCount() >= s_uiMaxBatchShapes)
+      {
+        m_bTooMany = true;
+        ForceEarlyOut();
+        return;
+      }
+
+      m_Shapes.m_Shapes.PushBack(shape);
+      m_Shapes.m_Bounds.PushBack(shape.GetWorldSpaceBounds());
+    }
+  };
+
+  out_shapes.m_Shapes.Clear();
+  out_shapes.m_Bounds.Clear();
+
+  const JPH::AABox aabb(plJoltConversionUtils::ToVec3(box.m_vMin), plJoltConversionUtils::ToVec3(box.m_vMax));
+
+  Collector collector(out_shapes);
+  m_pSystem->GetNarrowPhaseQuery().CollectTransformedShapes(aabb, collector, filters.m_BroadPhaseFilter, filters.m_ObjectFilter, filters.m_BodyFilter);
+
+  return !collector.m_bTooMany;
+}
+
 class plRayCastCollector : public JPH::CastRayCollector
 {
 public:
@@ -61,6 +122,11 @@ public:
 };
 
 bool plJoltWorldModule::Raycast(plPhysicsCastResult& out_result, const plVec3& vStart, const plVec3& vDir, float fDistance, const plPhysicsQueryParameters& params, plPhysicsHitCollection collection /*= plPhysicsHitCollection::Closest*/) const
+{
+  return CastRay(out_result, vStart, vDir, fDistance, params, collection, QueryFilters(params));
+}
+
+bool plJoltWorldModule::CastRay(plPhysicsCastResult& out_result, const plVec3& vStart, const plVec3& vDir, float fDistance, const plPhysicsQueryParameters& params, plPhysicsHitCollection collection, const QueryFilters& filters, const BatchShapes* pShapes) const
 {
   if (fDistance <= 0.001f || vDir.IsZero())
     return false;
@@ -74,24 +140,37 @@ bool plJoltWorldModule::Raycast(plPhysicsCastResult& out_result, const plVec3& v
   plRayCastCollector collector;
   collector.m_bAnyHit = collection == plPhysicsHitCollection::Any;
 
-  plJoltBroadPhaseLayerFilter broadphaseFilter(params.m_ShapeTypes);
-  plJoltBodyFilter bodyFilter(params.m_uiIgnoreObjectFilterID);
-  plJoltObjectLayerFilter objectFilter(params.m_uiCollisionLayer);
-
   if (params.m_bIgnoreInitialOverlap)
   {
     JPH::RayCastSettings opt;
     opt.mBackFaceMode = JPH::EBackFaceMode::IgnoreBackFaces;
     opt.mTreatConvexAsSolid = false;
 
-    query.CastRay(ray, opt, collector, broadphaseFilter, objectFilter, bodyFilter);
+    if (pShapes != nullptr)
+    {
+      pShapes->ForEachShape(JPH::AABox::sFromTwoPoints(ray.mOrigin, ray.mOrigin + ray.mDirection), collector, [&](const JPH::TransformedShape& shape)
+        { shape.CastRay(ray, opt, collector); });
+    }
+    else
+    {
+      query.CastRay(ray, opt, collector, filters.m_BroadPhaseFilter, filters.m_ObjectFilter, filters.m_BodyFilter);
+    }
+
+    if (collector.m_bFoundAny == false)
+      return false;
+  }
+  else if (pShapes != nullptr)
+  {
+    // CastRay() only keeps hits that are closer than the current one, so after all shapes the closest hit is left
+    pShapes->ForEachShape(JPH::AABox::sFromTwoPoints(ray.mOrigin, ray.mOrigin + ray.mDirection), collector, [&](const JPH::TransformedShape& shape)
+      { collector.m_bFoundAny |= shape.CastRay(ray, collector.m_Result); });
 
     if (collector.m_bFoundAny == false)
       return false;
   }
   else
   {
-    if (!query.CastRay(ray, collector.m_Result, broadphaseFilter, objectFilter, bodyFilter))
+    if (!query.CastRay(ray, collector.m_Result, filters.m_BroadPhaseFilter, filters.m_ObjectFilter, filters.m_BodyFilter))
       return false;
   }
 
@@ -188,7 +267,7 @@ bool plJoltWorldModule::SweepTestSphere(plPhysicsCastResult& out_result, float f
 
   const JPH::SphereShape shape(fSphereRadius);
 
-  return SweepTest(out_result, shape, JPH::Mat44::sTranslation(plJoltConversionUtils::ToVec3(vStart)), vDir, fDistance, params, collection);
+  return SweepTest(out_result, shape, JPH::Mat44::sTranslation(plJoltConversionUtils::ToVec3(vStart)), vDir, fDistance, collection, QueryFilters(params));
 }
 
 bool plJoltWorldModule::SweepTestBox(plPhysicsCastResult& out_result, plVec3 vBoxExtends, const plTransform& transform, const plVec3& vDir, float fDistance, const plPhysicsQueryParameters& params, plPhysicsHitCollection collection) const
@@ -197,7 +276,7 @@ bool plJoltWorldModule::SweepTestBox(plPhysicsCastResult& out_result, plVec3 vBo
 
   const JPH::Mat44 trans = JPH::Mat44::sRotationTranslation(plJoltConversionUtils::ToQuat(transform.m_qRotation), plJoltConversionUtils::ToVec3(transform.m_vPosition));
 
-  return SweepTest(out_result, shape, trans, vDir, fDistance, params, collection);
+  return SweepTest(out_result, shape, trans, vDir, fDistance, collection, QueryFilters(params));
 }
 
 bool plJoltWorldModule::SweepTestCapsule(plPhysicsCastResult& out_result, float fCapsuleRadius, float fCapsuleHeight, const plTransform& transform, const plVec3& vDir, float fDistance, const plPhysicsQueryParameters& params, plPhysicsHitCollection collection) const
@@ -215,23 +294,32 @@ bool plJoltWorldModule::SweepTestCapsule(plPhysicsCastResult& out_result, float
 
   const JPH::Mat44 trans = JPH::Mat44::sRotationTranslation(plJoltConversionUtils::ToQuat(qRot), plJoltConversionUtils::ToVec3(transform.m_vPosition));
 
-  return SweepTest(out_result, shape, trans, vDir, fDistance, params, collection);
+  return SweepTest(out_result, shape, trans, vDir, fDistance, collection, QueryFilters(params));
 }
 
-bool plJoltWorldModule::SweepTest(plPhysicsCastResult& out_Result, const JPH::Shape& shape, const JPH::Mat44& transform, const plVec3& vDir, float fDistance, const plPhysicsQueryParameters& params, plPhysicsHitCollection collection) const
+bool plJoltWorldModule::SweepTest(plPhysicsCastResult& out_Result, const JPH::Shape& shape, const JPH::Mat44& transform, const plVec3& vDir, float fDistance, plPhysicsHitCollection collection, const QueryFilters& filters, const BatchShapes* pShapes) const
 {
   const JPH::NarrowPhaseQuery& query = m_pSystem->GetNarrowPhaseQuery();
 
-  plJoltBroadPhaseLayerFilter broadphaseFilter(params.m_ShapeTypes);
-  plJoltBodyFilter bodyFilter(params.m_uiIgnoreObjectFilterID);
-  plJoltObjectLayerFilter objectFilter(params.m_uiCollisionLayer);
-
   JPH::RShapeCast cast(&shape, JPH::Vec3(1, 1, 1), transform, plJoltConversionUtils::ToVec3(vDir * fDistance));
 
   plJoltShapeCastCollector collector;
   collector.m_bAnyHit = collection == plPhysicsHitCollection::Any;
 
-  query.CastShape(cast, {}, JPH::RVec3::sZero(), collector, broadphaseFilter, objectFilter, bodyFilter);
+  if (pShapes != nullptr)
+  {
+    JPH::AABox castBounds = cast.mShapeWorldBounds;
+    castBounds.Encapsulate(cast.mShapeWorldBounds.mMin + cast.mDirection);
+    castBounds.Encapsulate(cast.mShapeWorldBounds.mMax + cast.mDirection);
+
+    const JPH::ShapeCastSettings settings;
+    pShapes->ForEachShape(castBounds, collector, [&](const JPH::TransformedShape& target)
+      { target.CastShape(cast, settings, JPH::RVec3::sZero(), collector); });
+  }
+  else
+  {
+    query.CastShape(cast, {}, JPH::RVec3::sZero(), collector, filters.m_BroadPhaseFilter, filters.m_ObjectFilter, filters.m_BodyFilter);
+  }
 
   if (!collector.m_bFoundAny)
     return false;
@@ -281,7 +369,7 @@ bool plJoltWorldModule::OverlapTestSphere(float fSphereRadius, const plVec3& vPo
 
   const JPH::SphereShape shape(fSphereRadius);
 
-  return OverlapTest(shape, JPH::Mat44::sTranslation(plJoltConversionUtils::ToVec3(vPosition)), params);
+  return OverlapTest(shape, JPH::Mat44::sTranslation(plJoltConversionUtils::ToVec3(vPosition)), QueryFilters(params));
 }
 
 bool plJoltWorldModule::OverlapTestCapsule(float fCapsuleRadius, float fCapsuleHeight, const plTransform& transform, const plPhysicsQueryParameters& params) const
@@ -299,19 +387,25 @@ bool plJoltWorldModule::OverlapTestCapsule(float fCapsuleRadius, float fCapsuleH
 
   const JPH::Mat44 trans = JPH::Mat44::sRotationTranslation(plJoltConversionUtils::ToQuat(qRot), plJoltConversionUtils::ToVec3(transform.m_vPosition));
 
-  return OverlapTest(shape, trans, params);
+  return OverlapTest(shape, trans, QueryFilters(params));
 }
 
-bool plJoltWorldModule::OverlapTest(const JPH::Shape& shape, const JPH::Mat44& transform, const plPhysicsQueryParameters& params) const
+bool plJoltWorldModule::OverlapTest(const JPH::Shape& shape, const JPH::Mat44& transform, const QueryFilters& filters, const BatchShapes* pShapes) const
 {
   const JPH::NarrowPhaseQuery& query = m_pSystem->GetNarrowPhaseQuery();
 
-  plJoltBroadPhaseLayerFilter broadphaseFilter(params.m_ShapeTypes);
-  plJoltBodyFilter bodyFilter(params.m_uiIgnoreObjectFilterID);
-  plJoltObjectLayerFilter objectFilter(params.m_uiCollisionLayer);
-
   plJoltShapeCollectorAny collector;
-  query.CollideShape(&shape, JPH::Vec3(1, 1, 1), transform, {}, JPH::RVec3::sZero(), collector, broadphaseFilter, objectFilter, bodyFilter);
+
+  if (pShapes != nullptr)
+  {
+    const JPH::CollideShapeSettings settings;
+    pShapes->ForEachShape(shape.GetWorldSpaceBounds(transform, JPH::Vec3(1, 1, 1)), collector, [&](const JPH::TransformedShape& target)
+      { target.CollideShape(&shape, JPH::Vec3(1, 1, 1), transform, settings, JPH::RVec3::sZero(), collector); });
+  }
+  else
+  {
+    query.CollideShape(&shape, JPH::Vec3(1, 1, 1), transform, {}, JPH::RVec3::sZero(), collector, filters.m_BroadPhaseFilter, filters.m_ObjectFilter, filters.m_BodyFilter);
+  }
 
   return collector.m_bFoundAny;
 }
@@ -365,6 +459,174 @@ void plJoltWorldModule::QueryShapesInSphere(plPhysicsOverlapResultArray& out_res
   }
 }
 
+// each task processes a range of queries and runs a single broadphase query for all of them
+// batch queries usually come from spatially coherent sources (e.g. the particles of one effect), so the shapes around a range are few
+static constexpr plUInt32 s_uiQueriesPerBatchTask = 64;
+
+void plJoltWorldModule::RaycastBatch(plArrayPtr<const plPhysicsCastRequest> rays, plArrayPtr<plPhysicsCastResult> out_results, plArrayPtr<bool> out_hits, const plPhysicsQueryParameters& params, plPhysicsHitCollection collection) const
+{
+  PL_ASSERT_DEV(out_results.GetCount() == rays.GetCount() && out_hits.GetCount() == rays.GetCount(), "Result arrays must have the same size as the query array");
+
+  struct Batch
+  {
+    const plJoltWorldModule* m_pModule;
+    plArrayPtr<const plPhysicsCastRequest> m_Rays;
+    plArrayPtr<plPhysicsCastResult> m_Results;
+    plArrayPtr<bool> m_Hits;
+    const plPhysicsQueryParameters* m_pParams;
+    plPhysicsHitCollection m_Collection;
+  };
+
+  Batch batch = {this, rays, out_results, out_hits, &params, collection};
+
+  plParallelForParams parallelParams;
+  parallelParams.m_uiBinSize = s_uiQueriesPerBatchTask;
+
+  plTaskSystem::ParallelForIndexed(
+    0u, rays.GetCount(),
+    [&batch](plUInt32 uiStartIndex, plUInt32 uiEndIndex)
+    {
+      const QueryFilters filters(*batch.m_pParams);
+
+      plBoundingBox box = plBoundingBox::MakeInvalid();
+      for (plUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        const plPhysicsCastRequest& ray = batch.m_Rays[i];
+        box.ExpandToInclude(ray.m_vStart);
+        box.ExpandToInclude(ray.m_vStart + ray.m_vDir * ray.m_fDistance);
+      }
+
+      BatchShapes shapes;
+      const BatchShapes* pShapes = batch.m_pModule->CollectBatchShapes(box, filters, shapes) ? &shapes : nullptr;
+
+      for (plUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        const plPhysicsCastRequest& ray = batch.m_Rays[i];
+        batch.m_Hits[i] = batch.m_pModule->CastRay(batch.m_Results[i], ray.m_vStart, ray.m_vDir, ray.m_fDistance, *batch.m_pParams, batch.m_Collection, filters, pShapes);
+      }
+    },
+    "Jolt Raycast Batch", plTaskNesting::Maybe, parallelParams);
+}
+
+void plJoltWorldModule::SweepTestSphereBatch(float fSphereRadius, plArrayPtr<const plPhysicsCastRequest> sweeps, plArrayPtr<plPhysicsCastResult> out_results, plArrayPtr<bool> out_hits, const plPhysicsQueryParameters& params, plPhysicsHitCollection collection) const
+{
+  PL_ASSERT_DEV(out_results.GetCount() == sweeps.GetCount() && out_hits.GetCount() == sweeps.GetCount(), "Result arrays must have the same size as the query array");
+
+  if (fSphereRadius <= 0.0f)
+  {
+    for (bool& bHit : out_hits)
+    {
+      bHit = false;
+    }
+
+    return;
+  }
+
+  struct Batch
+  {
+    const plJoltWorldModule* m_pModule;
+    const JPH::SphereShape* m_pShape;
+    plArrayPtr<const plPhysicsCastRequest> m_Sweeps;
+    plArrayPtr<plPhysicsCastResult> m_Results;
+    plArrayPtr<bool> m_Hits;
+    const plPhysicsQueryParameters* m_pParams;
+    plPhysicsHitCollection m_Collection;
+  };
+
+  // the shape is shared by all sweeps
+  const JPH::SphereShape shape(fSphereRadius);
+
+  Batch batch = {this, &shape, sweeps, out_results, out_hits, &params, collection};
+
+  plParallelForParams parallelParams;
+  parallelParams.m_uiBinSize = s_uiQueriesPerBatchTask;
+
+  plTaskSystem::ParallelForIndexed(
+    0u, sweeps.GetCount(),
+    [&batch](plUInt32 uiStartIndex, plUInt32 uiEndIndex)
+    {
+      const QueryFilters filters(*batch.m_pParams);
+
+      plBoundingBox box = plBoundingBox::MakeInvalid();
+      for (plUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        const plPhysicsCastRequest& sweep = batch.m_Sweeps[i];
+        box.ExpandToInclude(sweep.m_vStart);
+        box.ExpandToInclude(sweep.m_vStart + sweep.m_vDir * sweep.m_fDistance);
+      }
+      box.Grow(plVec3(batch.m_pShape->GetRadius()));
+
+      BatchShapes shapes;
+      const BatchShapes* pShapes = batch.m_pModule->CollectBatchShapes(box, filters, shapes) ? &shapes : nullptr;
+
+      for (plUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        const plPhysicsCastRequest& sweep = batch.m_Sweeps[i];
+        batch.m_Hits[i] = batch.m_pModule->SweepTest(batch.m_Results[i], *batch.m_pShape, JPH::Mat44::sTranslation(plJoltConversionUtils::ToVec3(sweep.m_vStart)), sweep.m_vDir, sweep.m_fDistance, batch.m_Collection, filters, pShapes);
+      }
+    },
+    "Jolt Sweep Batch", plTaskNesting::Maybe, parallelParams);
+}
+
+void plJoltWorldModule::OverlapTestSphereBatch(plArrayPtr<const plBoundingSphere> spheres, plArrayPtr<bool> out_hits, const plPhysicsQueryParameters& params) const
+{
+  PL_ASSERT_DEV(out_hits.GetCount() == spheres.GetCount(), "Result array must have the same size as the query array");
+
+  struct Batch
+  {
+    const plJoltWorldModule* m_pModule;
+    plArrayPtr<const plBoundingSphere> m_Spheres;
+    plArrayPtr<bool> m_Hits;
+    const plPhysicsQueryParameters* m_pParams;
+  };
+
+  Batch batch = {this, spheres, out_hits, &params};
+
+  plParallelForParams parallelParams;
+  parallelParams.m_uiBinSize = s_uiQueriesPerBatchTask;
+
+  plTaskSystem::ParallelForIndexed(
+    0u, spheres.GetCount(),
+    [&batch](plUInt32 uiStartIndex, plUInt32 uiEndIndex)
+    {
+      const QueryFilters filters(*batch.m_pParams);
+
+      plBoundingBox box = plBoundingBox::MakeInvalid();
+      for (plUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        const plBoundingSphere& sphere = batch.m_Spheres[i];
+
+        if (sphere.m_fRadius > 0.0f)
+        {
+          box.ExpandToInclude(plBoundingBox::MakeFromCenterAndHalfExtents(sphere.m_vCenter, plVec3(sphere.m_fRadius)));
+        }
+      }
+
+      BatchShapes shapes;
+      const BatchShapes* pShapes = nullptr;
+
+      if (box.IsValid())
+      {
+        pShapes = batch.m_pModule->CollectBatchShapes(box, filters, shapes) ? &shapes : nullptr;
+      }
+
+      for (plUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        const plBoundingSphere& sphere = batch.m_Spheres[i];
+
+        if (sphere.m_fRadius <= 0.0f)
+        {
+          batch.m_Hits[i] = false;
+          continue;
+        }
+
+        const JPH::SphereShape shape(sphere.m_fRadius);
+        batch.m_Hits[i] = batch.m_pModule->OverlapTest(shape, JPH::Mat44::sTranslation(plJoltConversionUtils::ToVec3(sphere.m_vCenter)), filters, pShapes);
+      }
+    },
+    "Jolt Overlap Batch", plTaskNesting::Maybe, parallelParams);
+}
+
 void plJoltWorldModule::QueryGeometryInBox(const plPhysicsQueryParameters& params, plBoundingBox box, plDynamicArray<plPhysicsTriangle>& out_triangles) const
 {
   JPH::AABox aabb;
@@ -75,6 +75,12 @@ public:
 
   virtual void QueryGeometryInBox(const plPhysicsQueryParameters& params, plBoundingBox box, plDynamicArray<plPhysicsTriangle>& out_triangles) const override;
 
+  virtual void RaycastBatch(plArrayPtr<const plPhysicsCastRequest> rays, plArrayPtr<plPhysicsCastResult> out_results, plArrayPtr<bool> out_hits, const plPhysicsQueryParameters& params, plPhysicsHitCollection collection = plPhysicsHitCollection::Closest) const override;
+
+  virtual void SweepTestSphereBatch(float fSphereRadius, plArrayPtr<const plPhysicsCastRequest> sweeps, plArrayPtr<plPhysicsCastResult> out_results, plArrayPtr<bool> out_hits, const plPhysicsQueryParameters& params, plPhysicsHitCollection collection = plPhysicsHitCollection::Closest) const override;
+
+  virtual void OverlapTestSphereBatch(plArrayPtr<const plBoundingSphere> spheres, plArrayPtr<bool> out_hits, const plPhysicsQueryParameters& params) const override;
+
   virtual void AddStaticCollisionBox(plGameObject* pObject, plVec3 vBoxSize) override;
 
   virtual void AddFixedJointComponent(plGameObject* pOwner, const plPhysicsWorldModuleInterface::FixedJointConfig& cfg) override;
@@ -117,8 +123,32 @@ public:
 
 
 private:
-  bool SweepTest(plPhysicsCastResult& out_Result, const JPH::Shape& shape, const JPH::Mat44& transform, const plVec3& vDir, float fDistance, const plPhysicsQueryParameters& params, plPhysicsHitCollection collection) const;
-  bool OverlapTest(const JPH::Shape& shape, const JPH::Mat44& transform, const plPhysicsQueryParameters& params) const;
+  /// \brief The Jolt filters for one set of query parameters. Batch queries create these once per task and share them for all queries.
+  struct QueryFilters
+  {
+    QueryFilters(const plPhysicsQueryParameters& params)
+      : m_BroadPhaseFilter(params.m_ShapeTypes)
+      , m_ObjectFilter(params.m_uiCollisionLayer)
+      , m_BodyFilter(params.m_uiIgnoreObjectFilterID)
+    {
+    }
+
+    plJoltBroadPhaseLayerFilter m_BroadPhaseFilter;
+    plJoltObjectLayerFilter m_ObjectFilter;
+    plJoltBodyFilter m_BodyFilter;
+  };
+
+  /// \brief The leaf shapes that a range of batch queries may touch, found with a single broadphase query for the whole range.
+  ///
+  /// When passed to CastRay(), SweepTest() or OverlapTest(), those only run the narrow phase against these shapes instead of querying the broadphase again.
+  struct BatchShapes;
+
+  /// \brief Collects all shapes inside the given box. Returns false, if there are too many for batching to pay off.
+  bool CollectBatchShapes(const plBoundingBox& box, const QueryFilters& filters, BatchShapes& out_shapes) const;
+
+  bool CastRay(plPhysicsCastResult& out_result, const plVec3& vStart, const plVec3& vDir, float fDistance, const plPhysicsQueryParameters& params, plPhysicsHitCollection collection, const QueryFilters& filters, const BatchShapes* pShapes = nullptr) const;
+  bool SweepTest(plPhysicsCastResult& out_Result, const JPH::Shape& shape, const JPH::Mat44& transform, const plVec3& vDir, float fDistance, plPhysicsHitCollection collection, const QueryFilters& filters, const BatchShapes* pShapes = nullptr) const;
+  bool OverlapTest(const JPH::Shape& shape, const JPH::Mat44& transform, const QueryFilters& filters, const BatchShapes* pShapes = nullptr) const;
 
   void FreeUserDataAfterSimulationStep();
 
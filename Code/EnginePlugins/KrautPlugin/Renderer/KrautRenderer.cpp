@@ -11,6 +11,7 @@
 #include <RendererCore/Pipeline/RenderPipelinePass.h>
 #include <RendererCore/RenderContext/RenderContext.h>
 #include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererCore/Textures/TextureStreaming.h>
 
 #include <RendererCore/../../../Data/Base/Shaders/Common/ObjectConstants.h>
 
@@ -63,6 +64,11 @@ void plKrautRenderer::RenderBatch(const plRenderViewContext& renderViewContext,
   pRenderContext->BindMaterial(pMesh->GetMaterials()[subMesh.m_uiMaterialIndex]);
   pRenderContext->BindMeshBuffer(pMesh->GetMeshBuffer());
 
+  if (plTextureStreaming::ShouldReportUsage(renderViewContext))
+  {
+    plTextureStreaming::ReportMaterialUsage(pMesh->GetMaterials()[subMesh.m_uiMaterialIndex], plTextureStreamingScreenSize(renderViewContext).ComputeMax<plKrautRenderData>(batch));
+  }
+
   treeConstants.SetTreeData(pRenderData->m_vLeafCenter, renderViewContext.m_pViewData->m_CameraUsageHint == plCameraUsageHint::Shadow ? 1.0f : 0.0f);
 
   const plVec3 vLodCamPos = renderViewContext.m_pLodCamera->GetPosition();
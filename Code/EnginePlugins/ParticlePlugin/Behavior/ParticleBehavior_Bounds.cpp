@@ -95,7 +95,7 @@ void plParticleBehavior_Bounds::QueryOptionalStreams()
   m_pStreamLastPosition = GetOwnerSystem()->QueryStream("LastPosition", plProcessingStream::DataType::Float3);
 }
 
-void plParticleBehavior_Bounds::Process(plUInt64 uiNumElements)
+void plParticleBehavior_Bounds::ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements)
 {
   PL_PROFILE_SCOPE("PFX: Bounds");
 
@@ -107,7 +107,7 @@ void plParticleBehavior_Bounds::Process(plUInt64 uiNumElements)
   const plSimdVec4f halfExtPos = plSimdConversion::ToVec3(m_vBoxExtents) * 0.5f;
   const plSimdVec4f halfExtNeg = -halfExtPos;
 
-  plProcessingStreamIterator<plSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, 0);
+  plProcessingStreamIterator<plSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, uiStartIndex);
 
   if (m_OutOfBoundsMode == plParticleOutOfBoundsMode::Teleport)
   {
@@ -115,7 +115,7 @@ void plParticleBehavior_Bounds::Process(plUInt64 uiNumElements)
 
     if (m_pStreamLastPosition)
     {
-      pLastPosition = m_pStreamLastPosition->GetWritableData<plVec3>();
+      pLastPosition = m_pStreamLastPosition->GetWritableData<plVec3>() + uiStartIndex;
     }
 
     while (!itPosition.HasReachedEnd())
@@ -146,7 +146,7 @@ void plParticleBehavior_Bounds::Process(plUInt64 uiNumElements)
   }
   else
   {
-    plUInt32 idx = 0;
+    plUInt64 idx = uiStartIndex;
 
     while (!itPosition.HasReachedEnd())
     {
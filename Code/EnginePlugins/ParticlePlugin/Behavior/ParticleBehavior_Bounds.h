@@ -33,7 +33,9 @@ public:
   plEnum<plParticleOutOfBoundsMode> m_OutOfBoundsMode;
 
 protected:
-  virtual void Process(plUInt64 uiNumElements) override;
+  // removing elements (plParticleOutOfBoundsMode::Kill) is not thread-safe
+  virtual bool CanProcessInParallel() const override { return m_OutOfBoundsMode == plParticleOutOfBoundsMode::Teleport; }
+  virtual void ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements) override;
 
   virtual void CreateRequiredStreams() override;
   virtual void QueryOptionalStreams() override;
@@ -5,6 +5,7 @@
 #include <Foundation/Profiling/Profiling.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_ColorGradient.h>
 #include <ParticlePlugin/Effect/ParticleEffectInstance.h>
+#include <ParticlePlugin/Streams/ParticleStreamSimd.h>
 
 // clang-format off
 PL_BEGIN_DYNAMIC_REFLECTED_TYPE(plParticleBehaviorFactory_ColorGradient, 1, plRTTIDefaultAllocator<plParticleBehaviorFactory_ColorGradient>)
@@ -40,6 +41,7 @@ void plParticleBehaviorFactory_ColorGradient::CopyBehaviorProperties(plParticleB
 
   // the gradient resource may not be specified yet, so defer evaluation until an element is created
   pBehavior->m_InitColor = plColor::RebeccaPurple;
+  pBehavior->m_ColorLookupTable.Clear();
 }
 
 void plParticleBehaviorFactory_ColorGradient::Save(plStreamWriter& inout_stream) const
@@ -109,7 +111,7 @@ void plParticleBehavior_ColorGradient::CreateRequiredStreams()
   }
   else if (m_GradientMode == plParticleColorGradientMode::Speed)
   {
-    CreateStream("Velocity", plProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+    CreateStream("Velocity", plProcessingStream::DataType::Float4, &m_pStreamVelocity, false);
   }
 }
 
@@ -151,107 +153,101 @@ void plParticleBehavior_ColorGradient::InitializeElements(plUInt64 uiStartIndex,
   }
 }
 
-void plParticleBehavior_ColorGradient::Process(plUInt64 uiNumElements)
+void plParticleBehavior_ColorGradient::StepParticleSystem(const plTime& tDiff, plUInt32 uiNumNewParticles)
 {
+  SUPER::StepParticleSystem(tDiff, uiNumNewParticles);
+
   if (!GetOwnerEffect()->IsVisible())
-  {
-    // set the update interval such that once the effect becomes visible,
-    // all particles get fully updated
-    m_uiCurrentUpdateInterval = 1;
-    m_uiFirstToUpdate = 0;
     return;
-  }
 
   if (!m_hGradient.IsValid())
+  {
+    m_ColorLookupTable.Clear();
     return;
+  }
 
-  PL_PROFILE_SCOPE("PFX: Color Gradient");
-
-  plResourceLock<plColorGradientResource> pGradient(m_hGradient, plResourceAcquireMode::BlockTillLoaded);
-
-  if (pGradient.GetAcquireResult() == plResourceAcquireResult::MissingFallback)
-    return;
-
-  const plColorGradient& gradient = pGradient->GetDescriptor().m_Gradient;
-
-  plProcessingStreamIterator<plColorLinear16f> itColor(m_pStreamColor, uiNumElements, 0);
-
-  // skip the first n particles
-  itColor.Advance(m_uiFirstToUpdate);
-
-  if (m_GradientMode == plParticleColorGradientMode::Age)
   {
-    plProcessingStreamIterator<plFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, 0);
+    plResourceLock<plColorGradientResource> pGradient(m_hGradient, plResourceAcquireMode::BlockTillLoaded);
 
-    // skip the first n particles
-    itLifeTime.Advance(m_uiFirstToUpdate);
+    if (pGradient.GetAcquireResult() == plResourceAcquireResult::MissingFallback)
+    {
+      m_ColorLookupTable.Clear();
+      return;
+    }
 
-    while (!itLifeTime.HasReachedEnd())
+    // sampling the color gradient is expensive, so it is baked into a lookup table, which is only updated when the resource changes
+    if (m_ColorLookupTable.IsEmpty() || m_uiGradientResourceChangeCounter != pGradient->GetCurrentResourceChangeCounter())
     {
-      // if (itLifeTime.Current().y > 0)
+      m_uiGradientResourceChangeCounter = pGradient->GetCurrentResourceChangeCounter();
+
+      const plColorGradient& gradient = pGradient->GetDescriptor().m_Gradient;
+
+      m_ColorLookupTable.SetCountUninitialized(plParticleStreamSimd::LookupTableSize + 1);
+      for (plUInt32 i = 0; i <= plParticleStreamSimd::LookupTableSize; ++i)
       {
-        const float fLifeTimeFraction = itLifeTime.Current().x * itLifeTime.Current().y;
-        const float posx = 1.0f - fLifeTimeFraction;
+        const float posx = plMath::Min(1.0f, static_cast<float>(i) / (plParticleStreamSimd::LookupTableSize - 1));
 
         plColor rgba;
         plUInt8 alpha;
         gradient.EvaluateColor(posx, rgba);
         gradient.EvaluateAlpha(posx, alpha);
         rgba.a = plMath::ColorByteToFloat(alpha);
+        rgba *= m_TintColor;
 
-        itColor.Current() = rgba * m_TintColor;
+        m_ColorLookupTable[i].Load<4>(&rgba.r);
       }
-
-      // skip the next n items
-      // this is to reduce the number of particles that need to be fully evaluated,
-      // since sampling the color gradient is pretty expensive
-      itLifeTime.Advance(m_uiCurrentUpdateInterval);
-      itColor.Advance(m_uiCurrentUpdateInterval);
     }
   }
-  else if (m_GradientMode == plParticleColorGradientMode::Speed)
-  {
-    plProcessingStreamIterator<plVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+}
 
-    // skip the first n particles
-    itVelocity.Advance(m_uiFirstToUpdate);
+void plParticleBehavior_ColorGradient::ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements)
+{
+  if (!GetOwnerEffect()->IsVisible() || m_ColorLookupTable.IsEmpty())
+    return;
 
-    while (!itVelocity.HasReachedEnd())
-    {
-      // if (itLifeTime.Current().y > 0)
-      {
-        const float fSpeed = itVelocity.Current().GetLength();
-        const float posx = fSpeed / m_fMaxSpeed; // no need to clamp the range, the color lookup will already do that
+  PL_PROFILE_SCOPE("PFX: Color Gradient");
 
-        plColor rgba;
-        plUInt8 alpha;
-        gradient.EvaluateColor(posx, rgba);
-        gradient.EvaluateAlpha(posx, alpha);
-        rgba.a = plMath::ColorByteToFloat(alpha);
+  const plSimdVec4f* pColorTable = m_ColorLookupTable.GetData();
+  plColorLinear16f* pColor = m_pStreamColor->GetWritableData<plColorLinear16f>() + uiStartIndex;
+  const plUInt32 uiNumGroups = plParticleStreamSimd::GetNumGroups(uiNumElements);
 
-        itColor.Current() = rgba * m_TintColor;
-      }
+  auto StoreColors = [](plColorLinear16f* pColor, const plSimdVec4f* pValues)
+  {
+    plParticleStreamSimd::StoreColor(pColor + 0, pValues[0]);
+    plParticleStreamSimd::StoreColor(pColor + 1, pValues[1]);
+    plParticleStreamSimd::StoreColor(pColor + 2, pValues[2]);
+    plParticleStreamSimd::StoreColor(pColor + 3, pValues[3]);
+  };
 
-      // skip the next n items
-      // this is to reduce the number of particles that need to be fully evaluated,
-      // since sampling the color gradient is pretty expensive
-      itVelocity.Advance(m_uiCurrentUpdateInterval);
-      itColor.Advance(m_uiCurrentUpdateInterval);
-    }
-  }
+  plSimdVec4f values[4];
 
-  // adjust which index is the first to update
+  if (m_GradientMode == plParticleColorGradientMode::Age)
   {
-    ++m_uiFirstToUpdate;
-    if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
-      m_uiFirstToUpdate = 0;
+    const plFloat16Vec2* pLifeTime = m_pStreamLifeTime->GetData<plFloat16Vec2>() + uiStartIndex;
+    const plSimdVec4f vOne(1.0f);
+
+    for (plUInt32 uiGroup = 0; uiGroup < uiNumGroups; ++uiGroup, pLifeTime += 4, pColor += 4)
+    {
+      const plSimdVec4f vPos = vOne - plParticleStreamSimd::LoadLifeTimeFraction(pLifeTime);
+
+      plParticleStreamSimd::SampleLookupTable(pColorTable, vPos, values);
+      StoreColors(pColor, values);
+    }
   }
+  else if (m_GradientMode == plParticleColorGradientMode::Speed)
+  {
+    const plSimdVec4f* pVelocity = m_pStreamVelocity->GetData<plSimdVec4f>() + uiStartIndex;
+    const plSimdVec4f vInvMaxSpeed(1.0f / plMath::Max(m_fMaxSpeed, 0.0001f));
 
-  /// \todo Use level of detail to reduce the update interval further
-  /// up close, with a high interval, animations appear choppy, especially when fading stuff out at the end
+    for (plUInt32 uiGroup = 0; uiGroup < uiNumGroups; ++uiGroup, pVelocity += 4, pColor += 4)
+    {
+      const plSimdVec4f vSpeedSquared(pVelocity[0].Dot<3>(pVelocity[0]), pVelocity[1].Dot<3>(pVelocity[1]), pVelocity[2].Dot<3>(pVelocity[2]), pVelocity[3].Dot<3>(pVelocity[3]));
+      const plSimdVec4f vPos = vSpeedSquared.GetSqrt().CompMul(vInvMaxSpeed);
 
-  // reset the update interval to the default
-  m_uiCurrentUpdateInterval = 2;
+      plParticleStreamSimd::SampleLookupTable(pColorTable, vPos, values);
+      StoreColors(pColor, values);
+    }
+  }
 }
 
 
@@ -47,12 +47,16 @@ protected:
   friend class plParticleBehaviorFactory_ColorGradient;
 
   virtual void InitializeElements(plUInt64 uiStartIndex, plUInt64 uiNumElements) override;
-  virtual void Process(plUInt64 uiNumElements) override;
+  virtual bool CanProcessInParallel() const override { return true; }
+  virtual void StepParticleSystem(const plTime& tDiff, plUInt32 uiNumNewParticles) override;
+  virtual void ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements) override;
 
   plProcessingStream* m_pStreamLifeTime = nullptr;
   plProcessingStream* m_pStreamColor = nullptr;
   plProcessingStream* m_pStreamVelocity = nullptr;
   plColor m_InitColor;
-  plUInt8 m_uiFirstToUpdate = 0;
-  plUInt8 m_uiCurrentUpdateInterval = 8;
+
+  // tinted gradient colors over the gradient position, see plParticleStreamSimd::SampleLookupTable()
+  plDynamicArray<plSimdVec4f, plAlignedAllocatorWrapper> m_ColorLookupTable;
+  plUInt32 m_uiGradientResourceChangeCounter = 0;
 };
@@ -5,6 +5,7 @@
 #include <Foundation/Profiling/Profiling.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_FadeOut.h>
 #include <ParticlePlugin/Effect/ParticleEffectInstance.h>
+#include <ParticlePlugin/Streams/ParticleStreamSimd.h>
 
 // clang-format off
 PL_BEGIN_DYNAMIC_REFLECTED_TYPE(plParticleBehaviorFactory_FadeOut, 1, plRTTIDefaultAllocator<plParticleBehaviorFactory_FadeOut>)
@@ -33,6 +34,7 @@ void plParticleBehaviorFactory_FadeOut::CopyBehaviorProperties(plParticleBehavio
 
   pBehavior->m_fStartAlpha = m_fStartAlpha;
   pBehavior->m_fExponent = m_fExponent;
+  pBehavior->m_AlphaLookupTable.Clear();
 }
 
 void plParticleBehaviorFactory_FadeOut::Save(plStreamWriter& inout_stream) const
@@ -59,70 +61,48 @@ void plParticleBehavior_FadeOut::CreateRequiredStreams()
   CreateStream("Color", plProcessingStream::DataType::Half4, &m_pStreamColor, false);
 }
 
-void plParticleBehavior_FadeOut::Process(plUInt64 uiNumElements)
+void plParticleBehavior_FadeOut::StepParticleSystem(const plTime& tDiff, plUInt32 uiNumNewParticles)
 {
-  if (!GetOwnerEffect()->IsVisible())
+  SUPER::StepParticleSystem(tDiff, uiNumNewParticles);
+
+  if (m_AlphaLookupTable.IsEmpty())
   {
-    // set the update interval such that once the effect becomes visible,
-    // all particles get fully updated
-    m_uiCurrentUpdateInterval = 1;
-    m_uiFirstToUpdate = 0;
-    return;
+    BakeLookupTable();
   }
+}
+
+void plParticleBehavior_FadeOut::ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements)
+{
+  if (!GetOwnerEffect()->IsVisible())
+    return;
 
   PL_PROFILE_SCOPE("PFX: Fade Out");
 
-  plProcessingStreamIterator<plFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, 0);
-  plProcessingStreamIterator<plColorLinear16f> itColor(m_pStreamColor, uiNumElements, 0);
+  const float* pAlphaTable = m_AlphaLookupTable.GetData();
+  const plFloat16Vec2* pLifeTime = m_pStreamLifeTime->GetData<plFloat16Vec2>() + uiStartIndex;
+  plColorLinear16f* pColor = m_pStreamColor->GetWritableData<plColorLinear16f>() + uiStartIndex;
 
-  // skip the first n particles
+  const plUInt32 uiNumGroups = plParticleStreamSimd::GetNumGroups(uiNumElements);
+  for (plUInt32 uiGroup = 0; uiGroup < uiNumGroups; ++uiGroup, pLifeTime += 4, pColor += 4)
   {
-    for (plUInt32 i = 0; i < m_uiFirstToUpdate; ++i)
-    {
-      itLifeTime.Advance();
-      itColor.Advance();
-    }
-
-    ++m_uiFirstToUpdate;
-    if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
-      m_uiFirstToUpdate = 0;
-  }
+    const plSimdVec4f vLifeTimeFraction = plParticleStreamSimd::LoadLifeTimeFraction(pLifeTime);
+    const plSimdVec4f vAlpha = plParticleStreamSimd::SampleLookupTable(pAlphaTable, vLifeTimeFraction);
 
-  if (m_fStartAlpha <= 1.0f)
-  {
-    while (!itLifeTime.HasReachedEnd())
-    {
-      const float fLifeTimeFraction = itLifeTime.Current().x * itLifeTime.Current().y;
-      itColor.Current().a = m_fStartAlpha * plMath::Pow(fLifeTimeFraction, m_fExponent);
-
-      for (plUInt32 i = 0; i < m_uiCurrentUpdateInterval; ++i)
-      {
-        itLifeTime.Advance();
-        itColor.Advance();
-      }
-    }
-  }
-  else
-  {
-    // this case has to clamp alpha to 1
-    while (!itLifeTime.HasReachedEnd())
-    {
-      const float fLifeTimeFraction = itLifeTime.Current().x * itLifeTime.Current().y;
-      itColor.Current().a = plMath::Min(1.0f, m_fStartAlpha * plMath::Pow(fLifeTimeFraction, m_fExponent));
-
-      for (plUInt32 i = 0; i < m_uiCurrentUpdateInterval; ++i)
-      {
-        itLifeTime.Advance();
-        itColor.Advance();
-      }
-    }
+    plParticleStreamSimd::StoreAlpha(pColor, vAlpha);
   }
+}
 
-  /// \todo Use level of detail to reduce the update interval further
-  /// up close, with a high interval, animations appear choppy, especially when fading stuff out at the end
+void plParticleBehavior_FadeOut::BakeLookupTable()
+{
+  m_AlphaLookupTable.SetCountUninitialized(plParticleStreamSimd::LookupTableSize + 1);
+
+  for (plUInt32 i = 0; i <= plParticleStreamSimd::LookupTableSize; ++i)
+  {
+    const float fLifeTimeFraction = plMath::Min(1.0f, static_cast<float>(i) / (plParticleStreamSimd::LookupTableSize - 1));
 
-  // reset the update interval to the default
-  m_uiCurrentUpdateInterval = 2;
+    // alpha has to be clamped to 1, in case the start alpha is larger than that
+    m_AlphaLookupTable[i] = plMath::Min(1.0f, m_fStartAlpha * plMath::Pow(fLifeTimeFraction, m_fExponent));
+  }
 }
 
 
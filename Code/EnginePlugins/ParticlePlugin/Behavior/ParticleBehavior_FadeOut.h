@@ -31,10 +31,17 @@ public:
   virtual void CreateRequiredStreams() override;
 
 protected:
-  virtual void Process(plUInt64 uiNumElements) override;
+  friend class plParticleBehaviorFactory_FadeOut;
+
+  virtual bool CanProcessInParallel() const override { return true; }
+  virtual void StepParticleSystem(const plTime& tDiff, plUInt32 uiNumNewParticles) override;
+  virtual void ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements) override;
+
+  void BakeLookupTable();
 
   plProcessingStream* m_pStreamLifeTime = nullptr;
   plProcessingStream* m_pStreamColor = nullptr;
-  plUInt8 m_uiFirstToUpdate = 0;
-  plUInt8 m_uiCurrentUpdateInterval = 2;
+
+  // alpha over the remaining life time fraction, see plParticleStreamSimd::SampleLookupTable()
+  plDynamicArray<float> m_AlphaLookupTable;
 };
@@ -87,7 +87,7 @@ void plParticleBehaviorFactory_Flies::Load(plStreamReader& inout_stream)
 void plParticleBehavior_Flies::CreateRequiredStreams()
 {
   CreateStream("Position", plProcessingStream::DataType::Float4, &m_pStreamPosition, false);
-  CreateStream("Velocity", plProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+  CreateStream("Velocity", plProcessingStream::DataType::Float4, &m_pStreamVelocity, false);
 
   m_TimeToChangeDir = plTime::MakeZero();
 }
@@ -108,7 +108,7 @@ void plParticleBehavior_Flies::Process(plUInt64 uiNumElements)
   const float fMaxDistanceToEmitterSquared = plMath::Square(m_fMaxEmitterDistance);
 
   plProcessingStreamIterator<plVec4> itPosition(m_pStreamPosition, uiNumElements, 0);
-  plProcessingStreamIterator<plVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  plProcessingStreamIterator<plVec4> itVelocity(m_pStreamVelocity, uiNumElements, 0);
 
   plQuat qRot;
 
@@ -118,7 +118,7 @@ void plParticleBehavior_Flies::Process(plUInt64 uiNumElements)
 
     const plVec3 vPartToEm = vEmitterPos - itPosition.Current().GetAsVec3();
     const float fDist = vPartToEm.GetLengthSquared();
-    const plVec3 vVelocity = itVelocity.Current();
+    const plVec3 vVelocity = itVelocity.Current().GetAsVec3();
     plVec3 vDir = vVelocity;
     vDir.NormalizeIfNotZero().IgnoreResult();
 
@@ -130,11 +130,11 @@ void plParticleBehavior_Flies::Process(plUInt64 uiNumElements)
 
       qRot = plQuat::MakeFromAxisAndAngle(vPivot, m_MaxSteeringAngle);
 
-      itVelocity.Current() = qRot * vVelocity;
+      itVelocity.Current() = (qRot * vVelocity).GetAsVec4(0);
     }
     else
     {
-      itVelocity.Current() = plVec3::MakeRandomDeviation(GetRNG(), m_MaxSteeringAngle, vDir) * m_fSpeed;
+      itVelocity.Current() = (plVec3::MakeRandomDeviation(GetRNG(), m_MaxSteeringAngle, vDir) * m_fSpeed).GetAsVec4(0);
     }
 
     itPosition.Advance();
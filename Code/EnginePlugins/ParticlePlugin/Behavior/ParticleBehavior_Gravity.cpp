@@ -8,6 +8,7 @@
 #include <Foundation/Time/Clock.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Gravity.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer_ApplyVelocity.h>
+#include <ParticlePlugin/Streams/ParticleStreamSimd.h>
 #include <ParticlePlugin/System/ParticleSystemInstance.h>
 #include <ParticlePlugin/WorldModule/ParticleWorldModule.h>
 
@@ -70,25 +71,34 @@ void plParticleBehaviorFactory_Gravity::QueryFinalizerDependencies(plSet<const p
 
 void plParticleBehavior_Gravity::CreateRequiredStreams()
 {
-  CreateStream("Velocity", plProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+  CreateStream("Velocity", plProcessingStream::DataType::Float4, &m_pStreamVelocity, false);
 }
 
-void plParticleBehavior_Gravity::Process(plUInt64 uiNumElements)
+void plParticleBehavior_Gravity::StepParticleSystem(const plTime& tDiff, plUInt32 uiNumNewParticles)
 {
-  PL_PROFILE_SCOPE("PFX: Gravity");
+  SUPER::StepParticleSystem(tDiff, uiNumNewParticles);
 
   const plVec3 vGravity = m_pPhysicsModule != nullptr ? m_pPhysicsModule->GetGravity() : plVec3(0.0f, 0.0f, -10.0f);
 
-  const float tDiff = (float)m_TimeDiff.GetSeconds();
-  const plVec3 addGravity = vGravity * m_fGravityFactor * tDiff;
+  m_vAddGravity = vGravity * m_fGravityFactor * (float)tDiff.GetSeconds();
+}
 
-  plProcessingStreamIterator<plVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+void plParticleBehavior_Gravity::ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements)
+{
+  PL_PROFILE_SCOPE("PFX: Gravity");
 
-  while (!itVelocity.HasReachedEnd())
-  {
-    itVelocity.Current() += addGravity;
+  plSimdVec4f addGravity;
+  addGravity.Load<3>(&m_vAddGravity.x);
+
+  plSimdVec4f* pVelocity = m_pStreamVelocity->GetWritableData<plSimdVec4f>() + uiStartIndex;
+  plSimdVec4f* pVelocityEnd = pVelocity + plParticleStreamSimd::GetNumGroups(uiNumElements) * 4;
 
-    itVelocity.Advance();
+  for (; pVelocity < pVelocityEnd; pVelocity += 4)
+  {
+    pVelocity[0] += addGravity;
+    pVelocity[1] += addGravity;
+    pVelocity[2] += addGravity;
+    pVelocity[3] += addGravity;
   }
 }
 
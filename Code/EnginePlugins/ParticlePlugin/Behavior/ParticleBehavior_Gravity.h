@@ -36,11 +36,15 @@ public:
 protected:
   friend class plParticleBehaviorFactory_Gravity;
 
-  virtual void Process(plUInt64 uiNumElements) override;
+  virtual bool CanProcessInParallel() const override { return true; }
+  virtual void StepParticleSystem(const plTime& tDiff, plUInt32 uiNumNewParticles) override;
+  virtual void ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements) override;
 
   void RequestRequiredWorldModulesForCache(plParticleWorldModule* pParticleModule) override;
 
   plPhysicsWorldModuleInterface* m_pPhysicsModule;
 
+  plVec3 m_vAddGravity = plVec3::MakeZero();
+
   plProcessingStream* m_pStreamVelocity;
 };
@@ -73,14 +73,14 @@ void plParticleBehavior_PullAlong::CreateRequiredStreams()
   CreateStream("Position", plProcessingStream::DataType::Float4, &m_pStreamPosition, false);
 }
 
-void plParticleBehavior_PullAlong::Process(plUInt64 uiNumElements)
+void plParticleBehavior_PullAlong::ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements)
 {
   PL_PROFILE_SCOPE("PFX: PullAlong");
 
   if (m_vApplyPull.IsZero())
     return;
 
-  plProcessingStreamIterator<plSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, 0);
+  plProcessingStreamIterator<plSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, uiStartIndex);
   plSimdVec4f pull;
   pull.Load<3>(&m_vApplyPull.x);
 
@@ -31,7 +31,8 @@ public:
   float m_fStrength = 0.5;
 
 protected:
-  virtual void Process(plUInt64 uiNumElements) override;
+  virtual bool CanProcessInParallel() const override { return true; }
+  virtual void ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements) override;
   virtual void StepParticleSystem(const plTime& tDiff, plUInt32 uiNumNewParticles) override;
 
   bool m_bFirstTime = true;
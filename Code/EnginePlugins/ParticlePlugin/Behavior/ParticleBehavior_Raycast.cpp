@@ -124,87 +124,103 @@ void plParticleBehavior_Raycast::CreateRequiredStreams()
 {
   CreateStream("Position", plProcessingStream::DataType::Float4, &m_pStreamPosition, false);
   CreateStream("LastPosition", plProcessingStream::DataType::Float3, &m_pStreamLastPosition, false);
-  CreateStream("Velocity", plProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+  CreateStream("Velocity", plProcessingStream::DataType::Float4, &m_pStreamVelocity, false);
 }
 
 void plParticleBehavior_Raycast::Process(plUInt64 uiNumElements)
 {
+  if (m_pPhysicsModule == nullptr)
+    return;
+
   PL_PROFILE_SCOPE("PFX: Raycast");
 
   const float tDiff = (float)m_TimeDiff.GetSeconds();
 
-  plProcessingStreamIterator<plVec4> itPosition(m_pStreamPosition, uiNumElements, 0);
-  plProcessingStreamIterator<const plVec3> itLastPosition(m_pStreamLastPosition, uiNumElements, 0);
-  plProcessingStreamIterator<plVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  plVec4* pPosition = m_pStreamPosition->GetWritableData<plVec4>();
+  const plVec3* pLastPosition = m_pStreamLastPosition->GetData<plVec3>();
+  plVec4* pVelocity = m_pStreamVelocity->GetWritableData<plVec4>();
+
+  m_Rays.Clear();
+  m_RayElements.Clear();
+
+  // collect the rays of all particles that moved
+  for (plUInt32 i = 0; i < uiNumElements; ++i)
+  {
+    const plVec3 vLastPos = pLastPosition[i];
+    const plVec3 vCurPos = pPosition[i].GetAsVec3();
+
+    if (vLastPos.IsZero())
+      continue;
+
+    const plVec3 vChange = vCurPos - vLastPos;
+
+    if (vChange.IsZero(0.001f))
+      continue;
+
+    plPhysicsCastRequest& ray = m_Rays.ExpandAndGetRef();
+    ray.m_vStart = vLastPos;
+    ray.m_vDir = vChange;
+    ray.m_fDistance = ray.m_vDir.GetLengthAndNormalize();
+
+    m_RayElements.PushBack(i);
+  }
+
+  if (m_Rays.IsEmpty())
+    return;
 
-  plPhysicsCastResult hitResult;
+  m_RayResults.SetCount(m_Rays.GetCount());
+  m_RayHits.SetCount(m_Rays.GetCount());
 
-  plUInt32 i = 0;
-  while (!itPosition.HasReachedEnd())
+  plPhysicsQueryParameters query(m_uiCollisionLayer);
+  query.m_ShapeTypes = plPhysicsShapeType::Static | plPhysicsShapeType::Dynamic;
+
+  m_pPhysicsModule->RaycastBatch(m_Rays, m_RayResults, m_RayHits, query);
+
+  // apply the hits in element order, so that element removal and events are deterministic
+  for (plUInt32 uiRay = 0; uiRay < m_Rays.GetCount(); ++uiRay)
   {
-    const plVec3 vLastPos = itLastPosition.Current();
-    const plVec3 vCurPos = itPosition.Current().GetAsVec3();
+    if (!m_RayHits[uiRay])
+      continue;
+
+    const plUInt32 i = m_RayElements[uiRay];
+    const plPhysicsCastResult& hitResult = m_RayResults[uiRay];
 
-    if (!vLastPos.IsZero())
+    if (m_Reaction == plParticleRaycastHitReaction::Bounce)
     {
-      const plVec3 vChange = vCurPos - vLastPos;
+      const plVec3 vChange = pPosition[i].GetAsVec3() - pLastPosition[i];
+      const plVec3 vNewDir = vChange.GetReflectedVector(hitResult.m_vNormal) * m_fBounceFactor;
 
-      if (!vChange.IsZero(0.001f))
+      if (vNewDir.GetLengthSquared() < plMath::Square(0.01f))
       {
-        plVec3 vDirection = vChange;
-
-        const float fMaxLen = vDirection.GetLengthAndNormalize();
-
-        plPhysicsQueryParameters query(m_uiCollisionLayer);
-        query.m_ShapeTypes = plPhysicsShapeType::Static | plPhysicsShapeType::Dynamic;
-
-        if (m_pPhysicsModule != nullptr && m_pPhysicsModule->Raycast(hitResult, vLastPos, vDirection, fMaxLen, query))
-        {
-          if (m_Reaction == plParticleRaycastHitReaction::Bounce)
-          {
-            const plVec3 vNewDir = vChange.GetReflectedVector(hitResult.m_vNormal) * m_fBounceFactor;
-
-            if (vNewDir.GetLengthSquared() < plMath::Square(0.01f))
-            {
-              itPosition.Current() = hitResult.m_vPosition.GetAsPositionVec4();
-              itVelocity.Current().SetZero();
-            }
-            else
-            {
-              itPosition.Current() = plVec3(hitResult.m_vPosition + vNewDir).GetAsVec4(0);
-              itVelocity.Current() = vNewDir / tDiff;
-            }
-          }
-          else if (m_Reaction == plParticleRaycastHitReaction::Die)
-          {
-            /// \todo Get current element index from iterator ?
-            m_pStreamGroup->RemoveElement(i);
-          }
-          else if (m_Reaction == plParticleRaycastHitReaction::Stop)
-          {
-            itPosition.Current() = hitResult.m_vPosition.GetAsPositionVec4();
-            itVelocity.Current().SetZero();
-          }
-
-          if (!m_sOnCollideEvent.IsEmpty())
-          {
-            plParticleEvent e;
-            e.m_EventType = m_sOnCollideEvent;
-            e.m_vPosition = hitResult.m_vPosition;
-            e.m_vNormal = hitResult.m_vNormal;
-            e.m_vDirection = vDirection;
-
-            GetOwnerEffect()->AddParticleEvent(e);
-          }
-        }
+        pPosition[i] = hitResult.m_vPosition.GetAsPositionVec4();
+        pVelocity[i].SetZero();
+      }
+      else
+      {
+        pPosition[i] = plVec3(hitResult.m_vPosition + vNewDir).GetAsVec4(0);
+        pVelocity[i] = (vNewDir / tDiff).GetAsVec4(0);
       }
     }
+    else if (m_Reaction == plParticleRaycastHitReaction::Die)
+    {
+      m_pStreamGroup->RemoveElement(i);
+    }
+    else if (m_Reaction == plParticleRaycastHitReaction::Stop)
+    {
+      pPosition[i] = hitResult.m_vPosition.GetAsPositionVec4();
+      pVelocity[i].SetZero();
+    }
 
-    itPosition.Advance();
-    itLastPosition.Advance();
-    itVelocity.Advance();
+    if (!m_sOnCollideEvent.IsEmpty())
+    {
+      plParticleEvent e;
+      e.m_EventType = m_sOnCollideEvent;
+      e.m_vPosition = hitResult.m_vPosition;
+      e.m_vNormal = hitResult.m_vNormal;
+      e.m_vDirection = m_Rays[uiRay].m_vDir;
 
-    ++i;
+      GetOwnerEffect()->AddParticleEvent(e);
+    }
   }
 }
 
@@ -1,10 +1,9 @@
 #pragma once
 
+#include <Core/Interfaces/PhysicsWorldModule.h>
 #include <Foundation/Strings/String.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior.h>
 
-class plPhysicsWorldModuleInterface;
-
 struct PL_PARTICLEPLUGIN_DLL plParticleRaycastHitReaction
 {
   using StorageType = plUInt8;
@@ -70,4 +69,10 @@ protected:
   plProcessingStream* m_pStreamPosition = nullptr;
   plProcessingStream* m_pStreamLastPosition = nullptr;
   plProcessingStream* m_pStreamVelocity = nullptr;
+
+  // the raycasts of all particles are executed as one batch, these are only kept to reuse the memory
+  plDynamicArray<plPhysicsCastRequest> m_Rays;
+  plDynamicArray<plUInt32> m_RayElements;
+  plDynamicArray<plPhysicsCastResult> m_RayResults;
+  plDynamicArray<bool> m_RayHits;
 };
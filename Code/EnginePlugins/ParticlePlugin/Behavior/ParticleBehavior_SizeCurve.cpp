@@ -5,6 +5,7 @@
 #include <Foundation/Profiling/Profiling.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_SizeCurve.h>
 #include <ParticlePlugin/Effect/ParticleEffectInstance.h>
+#include <ParticlePlugin/Streams/ParticleStreamSimd.h>
 
 // clang-format off
 PL_BEGIN_DYNAMIC_REFLECTED_TYPE(plParticleBehaviorFactory_SizeCurve, 1, plRTTIDefaultAllocator<plParticleBehaviorFactory_SizeCurve>)
@@ -35,6 +36,7 @@ void plParticleBehaviorFactory_SizeCurve::CopyBehaviorProperties(plParticleBehav
   pBehavior->m_hCurve = m_hCurve;
   pBehavior->m_fBaseSize = m_fBaseSize;
   pBehavior->m_fCurveScale = m_fCurveScale;
+  pBehavior->m_CurveLookupTable.Clear();
 }
 
 void plParticleBehaviorFactory_SizeCurve::Save(plStreamWriter& inout_stream) const
@@ -95,8 +97,10 @@ void plParticleBehavior_SizeCurve::InitializeElements(plUInt64 uiStartIndex, plU
   }
 }
 
-void plParticleBehavior_SizeCurve::Process(plUInt64 uiNumElements)
+void plParticleBehavior_SizeCurve::StepParticleSystem(const plTime& tDiff, plUInt32 uiNumNewParticles)
 {
+  SUPER::StepParticleSystem(tDiff, uiNumNewParticles);
+
   if (!GetOwnerEffect()->IsVisible())
   {
     // reduce the update interval when the effect is not visible
@@ -104,64 +108,72 @@ void plParticleBehavior_SizeCurve::Process(plUInt64 uiNumElements)
   }
   else
   {
-    m_uiCurrentUpdateInterval = 2;
+    m_uiCurrentUpdateInterval = 1;
   }
 
+  ++m_uiFirstToUpdate;
+  if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
+    m_uiFirstToUpdate = 0;
+
   if (!m_hCurve.IsValid())
+  {
+    m_CurveLookupTable.Clear();
     return;
-
-  PL_PROFILE_SCOPE("PFX: Size Curve");
-
-  plProcessingStreamIterator<plFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, 0);
-  plProcessingStreamIterator<plFloat16> itSize(m_pStreamSize, uiNumElements, 0);
+  }
 
   plResourceLock<plCurve1DResource> pCurve(m_hCurve, plResourceAcquireMode::BlockTillLoaded);
 
-  if (pCurve.GetAcquireResult() == plResourceAcquireResult::MissingFallback)
-    return;
-
-  if (pCurve->GetDescriptor().m_Curves.IsEmpty())
+  if (pCurve.GetAcquireResult() == plResourceAcquireResult::MissingFallback || pCurve->GetDescriptor().m_Curves.IsEmpty())
+  {
+    m_CurveLookupTable.Clear();
     return;
+  }
 
-  auto& curve = pCurve->GetDescriptor().m_Curves[0];
+  // sampling the curve is expensive, so it is baked into a lookup table, which is only updated when the resource changes
+  if (m_CurveLookupTable.IsEmpty() || m_uiCurveResourceChangeCounter != pCurve->GetCurrentResourceChangeCounter())
+  {
+    m_uiCurveResourceChangeCounter = pCurve->GetCurrentResourceChangeCounter();
 
-  double fMinX, fMaxX;
-  curve.QueryExtents(fMinX, fMaxX);
+    auto& curve = pCurve->GetDescriptor().m_Curves[0];
 
-  // skip the first n particles
-  {
-    for (plUInt32 i = 0; i < m_uiFirstToUpdate; ++i)
+    m_CurveLookupTable.SetCountUninitialized(plParticleStreamSimd::LookupTableSize + 1);
+    for (plUInt32 i = 0; i <= plParticleStreamSimd::LookupTableSize; ++i)
     {
-      itLifeTime.Advance();
-      itSize.Advance();
+      const double fAgeFraction = plMath::Min(1.0, static_cast<double>(i) / (plParticleStreamSimd::LookupTableSize - 1));
+      m_CurveLookupTable[i] = (float)curve.NormalizeValue(curve.Evaluate(curve.ConvertNormalizedPos(fAgeFraction)));
     }
-
-    ++m_uiFirstToUpdate;
-    if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
-      m_uiFirstToUpdate = 0;
   }
+}
 
-  while (!itLifeTime.HasReachedEnd())
-  {
-    // if (itLifeTime.Current().y > 0)
-    {
-      const float fLifeTimeFraction = 1.0f - (itLifeTime.Current().x * itLifeTime.Current().y);
+void plParticleBehavior_SizeCurve::ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements)
+{
+  if (m_CurveLookupTable.IsEmpty())
+    return;
 
-      const double evalPos = curve.ConvertNormalizedPos(fLifeTimeFraction);
-      double val = curve.Evaluate(evalPos);
-      val = curve.NormalizeValue(val);
+  PL_PROFILE_SCOPE("PFX: Size Curve");
 
-      itSize.Current() = m_fBaseSize + (float)val * m_fCurveScale;
-    }
+  const float* pCurveTable = m_CurveLookupTable.GetData();
+  const plFloat16Vec2* pLifeTime = m_pStreamLifeTime->GetData<plFloat16Vec2>();
+  plFloat16* pSize = m_pStreamSize->GetWritableData<plFloat16>();
 
-    // skip the next n items
-    // this is to reduce the number of particles that need to be fully evaluated,
-    // since sampling the curve is expensive
-    for (plUInt32 i = 0; i < m_uiCurrentUpdateInterval; ++i)
-    {
-      itLifeTime.Advance();
-      itSize.Advance();
-    }
+  const plSimdVec4f vOne(1.0f);
+  const plSimdVec4f vBaseSize(m_fBaseSize);
+  const plSimdVec4f vCurveScale(m_fCurveScale);
+
+  // when the effect is not visible, only every n-th group of particles is updated per frame
+  // the group index is global, so that the same groups are updated, no matter how the elements are split into ranges
+  const plUInt32 uiFirstGroup = static_cast<plUInt32>(uiStartIndex / 4);
+  const plUInt32 uiEndGroup = uiFirstGroup + plParticleStreamSimd::GetNumGroups(uiNumElements);
+  const plUInt32 uiInterval = m_uiCurrentUpdateInterval;
+
+  for (plUInt32 uiGroup = uiFirstGroup + (m_uiFirstToUpdate + uiInterval - uiFirstGroup % uiInterval) % uiInterval; uiGroup < uiEndGroup; uiGroup += uiInterval)
+  {
+    const plUInt32 uiFirstElement = uiGroup * 4;
+
+    const plSimdVec4f vAgeFraction = vOne - plParticleStreamSimd::LoadLifeTimeFraction(pLifeTime + uiFirstElement);
+    const plSimdVec4f vCurveValue = plParticleStreamSimd::SampleLookupTable(pCurveTable, vAgeFraction);
+
+    plParticleStreamSimd::StoreHalf(pSize + uiFirstElement, vBaseSize + vCurveValue.CompMul(vCurveScale));
   }
 }
 
@@ -34,11 +34,19 @@ public:
   virtual void CreateRequiredStreams() override;
 
 protected:
+  friend class plParticleBehaviorFactory_SizeCurve;
+
   virtual void InitializeElements(plUInt64 uiStartIndex, plUInt64 uiNumElements) override;
-  virtual void Process(plUInt64 uiNumElements) override;
+  virtual bool CanProcessInParallel() const override { return true; }
+  virtual void StepParticleSystem(const plTime& tDiff, plUInt32 uiNumNewParticles) override;
+  virtual void ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements) override;
 
   plProcessingStream* m_pStreamLifeTime = nullptr;
   plProcessingStream* m_pStreamSize = nullptr;
   plUInt8 m_uiFirstToUpdate = 0;
   plUInt8 m_uiCurrentUpdateInterval = 8;
+
+  // normalized curve values over the age fraction, see plParticleStreamSimd::SampleLookupTable(), empty if the curve isn't available
+  plDynamicArray<float> m_CurveLookupTable;
+  plUInt32 m_uiCurveResourceChangeCounter = 0;
 };
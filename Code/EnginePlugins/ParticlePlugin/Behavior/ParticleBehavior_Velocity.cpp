@@ -9,6 +9,7 @@
 #include <Foundation/Time/Clock.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Velocity.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer_ApplyVelocity.h>
+#include <ParticlePlugin/Streams/ParticleStreamSimd.h>
 #include <ParticlePlugin/System/ParticleSystemInstance.h>
 #include <ParticlePlugin/WorldModule/ParticleWorldModule.h>
 #include <RendererCore/RenderWorld/RenderWorld.h>
@@ -98,16 +99,16 @@ void plParticleBehaviorFactory_Velocity::QueryFinalizerDependencies(plSet<const
 void plParticleBehavior_Velocity::CreateRequiredStreams()
 {
   CreateStream("Position", plProcessingStream::DataType::Float4, &m_pStreamPosition, false);
-  CreateStream("Velocity", plProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+  CreateStream("Velocity", plProcessingStream::DataType::Float4, &m_pStreamVelocity, false);
 }
 
-void plParticleBehavior_Velocity::Process(plUInt64 uiNumElements)
+void plParticleBehavior_Velocity::StepParticleSystem(const plTime& tDiff, plUInt32 uiNumNewParticles)
 {
-  PL_PROFILE_SCOPE("PFX: Velocity");
+  SUPER::StepParticleSystem(tDiff, uiNumNewParticles);
 
-  const float tDiff = (float)m_TimeDiff.GetSeconds();
+  const float fTimeDiff = (float)tDiff.GetSeconds();
   const plVec3 vDown = m_pPhysicsModule != nullptr ? m_pPhysicsModule->GetGravity().GetNormalized() : plVec3(0.0f, 0.0f, -1.0f);
-  const plVec3 vRise = vDown * tDiff * -m_fRiseSpeed;
+  const plVec3 vRise = vDown * fTimeDiff * -m_fRiseSpeed;
 
   auto pOwner = GetOwnerEffect();
   plVec3 vWind(0);
@@ -115,9 +116,9 @@ void plParticleBehavior_Velocity::Process(plUInt64 uiNumElements)
   if (m_iWindSampleIdx >= 0)
   {
     plVec3 vCurWind = pOwner->GetWindSampleResult(m_iWindSampleIdx);
-    vCurWind = plMath::Lerp(m_vLastWind, vCurWind, tDiff);
+    vCurWind = plMath::Lerp(m_vLastWind, vCurWind, fTimeDiff);
 
-    vWind = vCurWind * m_fWindInfluence * tDiff;
+    vWind = vCurWind * m_fWindInfluence * fTimeDiff;
 
     m_vLastWind = vCurWind;
 
@@ -129,24 +130,36 @@ void plParticleBehavior_Velocity::Process(plUInt64 uiNumElements)
     m_iWindSampleIdx = pOwner->AddWindSampleLocation(GetOwnerSystem()->GetTransform().m_vPosition);
   }
 
-  const plVec3 vAddPos0 = vRise + vWind;
+  m_vAddPosition = vRise + vWind;
+
+  const float fFriction = plMath::Clamp(m_fFriction, 0.0f, 100.0f);
+  m_fFrictionFactor = plMath::Pow(0.5f, fTimeDiff * fFriction);
+}
+
+void plParticleBehavior_Velocity::ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements)
+{
+  PL_PROFILE_SCOPE("PFX: Velocity");
 
   plSimdVec4f vAddPos;
-  vAddPos.Load<3>(&vAddPos0.x);
+  vAddPos.Load<3>(&m_vAddPosition.x);
 
-  const float fFriction = plMath::Clamp(m_fFriction, 0.0f, 100.0f);
-  const float fFrictionFactor = plMath::Pow(0.5f, tDiff * fFriction);
+  const plSimdFloat fFrictionFactor = m_fFrictionFactor;
 
-  plProcessingStreamIterator<plSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, 0);
-  plProcessingStreamIterator<plVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  plSimdVec4f* pPosition = m_pStreamPosition->GetWritableData<plSimdVec4f>() + uiStartIndex;
+  plSimdVec4f* pVelocity = m_pStreamVelocity->GetWritableData<plSimdVec4f>() + uiStartIndex;
+  plSimdVec4f* pPositionEnd = pPosition + plParticleStreamSimd::GetNumGroups(uiNumElements) * 4;
 
-  while (!itPosition.HasReachedEnd())
+  for (; pPosition < pPositionEnd; pPosition += 4, pVelocity += 4)
   {
-    itPosition.Current() += vAddPos;
-    itVelocity.Current() *= fFrictionFactor;
-
-    itPosition.Advance();
-    itVelocity.Advance();
+    pPosition[0] += vAddPos;
+    pPosition[1] += vAddPos;
+    pPosition[2] += vAddPos;
+    pPosition[3] += vAddPos;
+
+    pVelocity[0] *= fFrictionFactor;
+    pVelocity[1] *= fFrictionFactor;
+    pVelocity[2] *= fFrictionFactor;
+    pVelocity[3] *= fFrictionFactor;
   }
 }
 
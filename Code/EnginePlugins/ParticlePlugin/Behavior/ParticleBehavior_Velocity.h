@@ -41,7 +41,9 @@ public:
 protected:
   friend class plParticleBehaviorFactory_Velocity;
 
-  virtual void Process(plUInt64 uiNumElements) override;
+  virtual bool CanProcessInParallel() const override { return true; }
+  virtual void StepParticleSystem(const plTime& tDiff, plUInt32 uiNumNewParticles) override;
+  virtual void ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements) override;
 
   void RequestRequiredWorldModulesForCache(plParticleWorldModule* pParticleModule) override;
 
@@ -54,4 +56,8 @@ protected:
   plProcessingStream* m_pStreamVelocity;
 
   plVec3 m_vLastWind = plVec3::MakeZero();
+
+  // computed once per frame in StepParticleSystem()
+  plVec3 m_vAddPosition = plVec3::MakeZero();
+  float m_fFrictionFactor = 1.0f;
 };
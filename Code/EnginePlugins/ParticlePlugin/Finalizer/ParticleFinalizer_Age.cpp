@@ -65,7 +65,7 @@ void plParticleFinalizer_Age::CreateRequiredStreams()
   if (!m_sOnDeathEvent.IsEmpty())
   {
     CreateStream("Position", plProcessingStream::DataType::Float4, &m_pStreamPosition, false);
-    CreateStream("Velocity", plProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+    CreateStream("Velocity", plProcessingStream::DataType::Float4, &m_pStreamVelocity, false);
   }
 }
 
@@ -128,12 +128,12 @@ void plParticleFinalizer_Age::Process(plUInt64 uiNumElements)
 void plParticleFinalizer_Age::OnParticleDeath(const plStreamGroupElementRemovedEvent& e)
 {
   const plVec4* pPosition = m_pStreamPosition->GetData<plVec4>();
-  const plVec3* pVelocity = m_pStreamVelocity->GetData<plVec3>();
+  const plVec4* pVelocity = m_pStreamVelocity->GetData<plVec4>();
 
   plParticleEvent pe;
   pe.m_EventType = m_sOnDeathEvent;
   pe.m_vPosition = pPosition[e.m_uiElementIndex].GetAsVec3();
-  pe.m_vDirection = pVelocity[e.m_uiElementIndex];
+  pe.m_vDirection = pVelocity[e.m_uiElementIndex].GetAsVec3();
   pe.m_vNormal.SetZero();
 
   GetOwnerEffect()->AddParticleEvent(pe);
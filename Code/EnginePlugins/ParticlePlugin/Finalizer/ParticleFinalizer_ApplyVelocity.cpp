@@ -5,6 +5,7 @@
 #include <Foundation/Math/Declarations.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer_ApplyVelocity.h>
+#include <ParticlePlugin/Streams/ParticleStreamSimd.h>
 
 // clang-format off
 PL_BEGIN_DYNAMIC_REFLECTED_TYPE(plParticleFinalizerFactory_ApplyVelocity, 1, plRTTIDefaultAllocator<plParticleFinalizerFactory_ApplyVelocity>)
@@ -37,26 +38,26 @@ plParticleFinalizer_ApplyVelocity::~plParticleFinalizer_ApplyVelocity() = defaul
 void plParticleFinalizer_ApplyVelocity::CreateRequiredStreams()
 {
   CreateStream("Position", plProcessingStream::DataType::Float4, &m_pStreamPosition, false);
-  CreateStream("Velocity", plProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+  CreateStream("Velocity", plProcessingStream::DataType::Float4, &m_pStreamVelocity, false);
 }
 
-void plParticleFinalizer_ApplyVelocity::Process(plUInt64 uiNumElements)
+void plParticleFinalizer_ApplyVelocity::ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements)
 {
   PL_PROFILE_SCOPE("PFX: ApplyVelocity");
 
-  const float tDiff = (float)m_TimeDiff.GetSeconds();
+  const plSimdFloat tDiff = (float)m_TimeDiff.GetSeconds();
 
-  plProcessingStreamIterator<plVec4> itPosition(m_pStreamPosition, uiNumElements, 0);
-  plProcessingStreamIterator<plVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  // the w component of the velocity is always zero, so the w component of the position is preserved
+  plSimdVec4f* pPosition = m_pStreamPosition->GetWritableData<plSimdVec4f>() + uiStartIndex;
+  const plSimdVec4f* pVelocity = m_pStreamVelocity->GetData<plSimdVec4f>() + uiStartIndex;
+  plSimdVec4f* pPositionEnd = pPosition + plParticleStreamSimd::GetNumGroups(uiNumElements) * 4;
 
-  while (!itPosition.HasReachedEnd())
+  for (; pPosition < pPositionEnd; pPosition += 4, pVelocity += 4)
   {
-    plVec3& pos = reinterpret_cast<plVec3&>(itPosition.Current());
-
-    pos += itVelocity.Current() * tDiff;
-
-    itPosition.Advance();
-    itVelocity.Advance();
+    pPosition[0] += pVelocity[0] * tDiff;
+    pPosition[1] += pVelocity[1] * tDiff;
+    pPosition[2] += pVelocity[2] * tDiff;
+    pPosition[3] += pVelocity[3] * tDiff;
   }
 }
 
@@ -42,12 +42,12 @@ void plParticleFinalizer_LastPosition::CreateRequiredStreams()
   CreateStream("LastPosition", plProcessingStream::DataType::Float3, &m_pStreamLastPosition, false);
 }
 
-void plParticleFinalizer_LastPosition::Process(plUInt64 uiNumElements)
+void plParticleFinalizer_LastPosition::ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements)
 {
   PL_PROFILE_SCOPE("PFX: LastPosition");
 
-  plProcessingStreamIterator<plVec4> itPosition(m_pStreamPosition, uiNumElements, 0);
-  plProcessingStreamIterator<plVec3> itLastPosition(m_pStreamLastPosition, uiNumElements, 0);
+  plProcessingStreamIterator<plVec4> itPosition(m_pStreamPosition, uiNumElements, uiStartIndex);
+  plProcessingStreamIterator<plVec3> itLastPosition(m_pStreamLastPosition, uiNumElements, uiStartIndex);
 
   while (!itPosition.HasReachedEnd())
   {
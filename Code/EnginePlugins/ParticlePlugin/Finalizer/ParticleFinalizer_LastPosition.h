@@ -25,7 +25,8 @@ public:
   virtual void CreateRequiredStreams() override;
 
 protected:
-  virtual void Process(plUInt64 uiNumElements) override;
+  virtual bool CanProcessInParallel() const override { return true; }
+  virtual void ProcessRange(plUInt64 uiStartIndex, plUInt64 uiNumElements) override;
 
   plProcessingStream* m_pStreamPosition = nullptr;
   plProcessingStream* m_pStreamLastPosition = nullptr;
@@ -3,9 +3,11 @@
 #include <Foundation/DataProcessing/Stream/ProcessingStreamGroup.h>
 #include <Foundation/Math/Random.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/SimdMath/SimdRandom.h>
 #include <Foundation/SimdMath/SimdTransform.h>
 #include <Foundation/SimdMath/SimdVec4f.h>
 #include <ParticlePlugin/Initializer/ParticleInitializer_BoxPosition.h>
+#include <ParticlePlugin/Streams/ParticleStreamSimd.h>
 #include <ParticlePlugin/System/ParticleSystemInstance.h>
 
 // clang-format off
@@ -145,24 +147,39 @@ void plParticleInitializer_BoxPosition::InitializeElements(plUInt64 uiStartIndex
   {
     plTransform ownerTransform = GetOwnerSystem()->GetTransform();
 
-    plSimdVec4f pos;
     plSimdTransform transform;
     transform.m_Position.Load<3>(&ownerTransform.m_vPosition.x);
     transform.m_Rotation.m_v.Load<4>(&ownerTransform.m_qRotation.x);
     transform.m_Scale.Load<3>(&ownerTransform.m_vScale.x);
 
-    float p0[4];
-    p0[3] = 0;
+    const plSimdMat4f mTransform = transform.GetAsMat4();
 
-    for (plUInt64 i = uiStartIndex; i < uiStartIndex + uiNumElements; ++i)
+    const plVec3 vMin = m_vPositionOffset - m_vSize * 0.5f;
+    const plVec3 vMax = m_vPositionOffset + m_vSize * 0.5f;
+
+    // one random seed per axis, the random values are generated four at a time from the element index
+    const plSimdVec4u vSeedX(rng.UInt());
+    const plSimdVec4u vSeedY(rng.UInt());
+    const plSimdVec4u vSeedZ(rng.UInt());
+
+    plSimdVec4f pos[4];
+
+    for (plUInt64 i = 0; i < uiNumElements; i += 4)
     {
-      p0[0] = (float)(rng.DoubleMinMax(-m_vSize.x, m_vSize.x) * 0.5) + m_vPositionOffset.x;
-      p0[1] = (float)(rng.DoubleMinMax(-m_vSize.y, m_vSize.y) * 0.5) + m_vPositionOffset.y;
-      p0[2] = (float)(rng.DoubleMinMax(-m_vSize.z, m_vSize.z) * 0.5) + m_vPositionOffset.z;
+      const plSimdVec4i vIndex = plParticleStreamSimd::GetElementIndices(i);
+
+      const plSimdVec4f x = plSimdRandom::FloatMinMax(vIndex, plSimdVec4f(vMin.x), plSimdVec4f(vMax.x), vSeedX);
+      const plSimdVec4f y = plSimdRandom::FloatMinMax(vIndex, plSimdVec4f(vMin.y), plSimdVec4f(vMax.y), vSeedY);
+      const plSimdVec4f z = plSimdRandom::FloatMinMax(vIndex, plSimdVec4f(vMin.z), plSimdVec4f(vMax.z), vSeedZ);
 
-      pos.Load<4>(p0);
+      plParticleStreamSimd::TransformPositions(mTransform, x, y, z, pos);
 
-      pPosition[i] = transform.TransformPosition(pos);
+      // the start index is not necessarily a multiple of four, so only the requested elements may be written
+      const plUInt32 uiNumInGroup = static_cast<plUInt32>(plMath::Min<plUInt64>(4, uiNumElements - i));
+      for (plUInt32 j = 0; j < uiNumInGroup; ++j)
+      {
+        pPosition[uiStartIndex + i + j] = pos[j];
+      }
     }
   }
 }
@@ -5,8 +5,12 @@
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Serialization/AbstractObjectGraph.h>
 #include <Foundation/Serialization/GraphPatch.h>
+#include <Foundation/SimdMath/SimdMath.h>
+#include <Foundation/SimdMath/SimdRandom.h>
+#include <Foundation/SimdMath/SimdTransform.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer_ApplyVelocity.h>
 #include <ParticlePlugin/Initializer/ParticleInitializer_SpherePosition.h>
+#include <ParticlePlugin/Streams/ParticleStreamSimd.h>
 #include <ParticlePlugin/System/ParticleSystemInstance.h>
 
 // clang-format off
@@ -148,7 +152,7 @@ void plParticleInitializer_SpherePosition::CreateRequiredStreams()
 
   if (m_bSetVelocity)
   {
-    CreateStream("Velocity", plProcessingStream::DataType::Float3, &m_pStreamVelocity, true);
+    CreateStream("Velocity", plProcessingStream::DataType::Float4, &m_pStreamVelocity, true);
   }
 }
 
@@ -158,36 +162,99 @@ void plParticleInitializer_SpherePosition::InitializeElements(plUInt64 uiStartIn
 
   const plVec3 startVel = GetOwnerSystem()->GetParticleStartVelocity();
 
-  plVec4* pPosition = m_pStreamPosition->GetWritableData<plVec4>();
-  plVec3* pVelocity = m_bSetVelocity ? m_pStreamVelocity->GetWritableData<plVec3>() : nullptr;
+  plSimdVec4f* pPosition = m_pStreamPosition->GetWritableData<plSimdVec4f>();
+  plSimdVec4f* pVelocity = m_bSetVelocity ? m_pStreamVelocity->GetWritableData<plSimdVec4f>() : nullptr;
 
   plRandom& rng = GetRNG();
 
   const plTransform trans = GetOwnerSystem()->GetTransform();
 
-  for (plUInt64 i = uiStartIndex; i < uiStartIndex + uiNumElements; ++i)
+  plSimdTransform transform;
+  transform.m_Position.Load<3>(&trans.m_vPosition.x);
+  transform.m_Rotation.m_v.Load<4>(&trans.m_qRotation.x);
+  transform.m_Scale.Load<3>(&trans.m_vScale.x);
+
+  // the velocity is the rotated direction plus the start velocity, which is the same as a transformation without scale
+  plSimdTransform velocityTransform;
+  velocityTransform.m_Position.Load<3>(&startVel.x);
+  velocityTransform.m_Rotation = transform.m_Rotation;
+  velocityTransform.m_Scale = plSimdVec4f(1.0f);
+
+  const plSimdMat4f mTransform = transform.GetAsMat4();
+  const plSimdMat4f mVelocityTransform = velocityTransform.GetAsMat4();
+
+  // the random values are generated four at a time from the element index, with one random seed per value
+  const plSimdVec4u vSeed0(rng.UInt());
+  const plSimdVec4u vSeed1(rng.UInt());
+  const plSimdVec4u vSeed2(rng.UInt());
+  const plSimdVec4u vSeedSpeedDeviation(rng.UInt());
+  const plSimdVec4u vSeedSpeed(rng.UInt());
+
+  const plSimdVec4f vSpeed0(m_Speed.m_Value);
+  const plSimdVec4f vSpeedVariance(m_Speed.m_Value * m_Speed.m_fVariance);
+
+  const plSimdVec4f vOffsetX(m_vPositionOffset.x);
+  const plSimdVec4f vOffsetY(m_vPositionOffset.y);
+  const plSimdVec4f vOffsetZ(m_vPositionOffset.z);
+  const plSimdVec4f vRadius(m_fRadius);
+  const plSimdVec4f vOne(1.0f);
+
+  plSimdVec4f pos[4];
+  plSimdVec4f vel[4];
+
+  for (plUInt64 i = 0; i < uiNumElements; i += 4)
   {
-    plVec3 pos = plVec3::MakeRandomPointInSphere(rng) * m_fRadius;
-    plVec3 normalPos = pos;
+    const plSimdVec4i vIndex = plParticleStreamSimd::GetElementIndices(i);
 
-    if (m_bSpawnOnSurface || m_bSetVelocity)
+    // uniformly distributed direction
+    const plSimdVec4f vNormalZ = plSimdRandom::FloatMinMax(vIndex, -vOne, vOne, vSeed0);
+    const plSimdVec4f vAngle = plSimdRandom::FloatMinMax(vIndex, plSimdVec4f::MakeZero(), plSimdVec4f(2.0f * plMath::Pi<float>()), vSeed1);
+    const plSimdVec4f vRadiusXY = (vOne - vNormalZ.CompMul(vNormalZ)).CompMax(plSimdVec4f::MakeZero()).GetSqrt();
+    const plSimdVec4f vNormalX = vRadiusXY.CompMul(plSimdMath::Cos(vAngle));
+    const plSimdVec4f vNormalY = vRadiusXY.CompMul(plSimdMath::Sin(vAngle));
+
+    plSimdVec4f vDistance = vRadius;
+    if (!m_bSpawnOnSurface)
     {
-      normalPos.Normalize();
-    }
+      // the maximum of three uniform random values has the same distribution as the cube root of one,
+      // which is what is needed for uniformly distributed points inside the sphere
+      const plSimdVec4f vDistance0 = plSimdRandom::FloatZeroToOne(vIndex, vSeed2);
+      const plSimdVec4f vDistance1 = plSimdRandom::FloatZeroToOne(vIndex, vSeed2 + plSimdVec4u(1));
+      const plSimdVec4f vDistance2 = plSimdRandom::FloatZeroToOne(vIndex, vSeed2 + plSimdVec4u(2));
 
-    if (m_bSpawnOnSurface)
-      pos = normalPos * m_fRadius;
+      vDistance = vRadius.CompMul(vDistance0.CompMax(vDistance1).CompMax(vDistance2));
+    }
 
-    pos += m_vPositionOffset;
+    const plSimdVec4f x = vNormalX.CompMul(vDistance);
+    const plSimdVec4f y = vNormalY.CompMul(vDistance);
+    const plSimdVec4f z = vNormalZ.CompMul(vDistance);
 
     if (m_bSetVelocity)
     {
-      const float fSpeed = (float)rng.DoubleVariance(m_Speed.m_Value, m_Speed.m_fVariance);
+      // same distribution as plRandom::DoubleVariance()
+      const plSimdVec4f vDeviation = plSimdRandom::FloatZeroToOne(vIndex, vSeedSpeedDeviation);
+      const plSimdVec4f vSpeedOffset = vSpeedVariance.CompMul(vDeviation);
+      const plSimdVec4f vSpeed = plSimdRandom::FloatMinMax(vIndex, vSpeed0 - vSpeedOffset, vSpeed0 + vSpeedOffset, vSeedSpeed);
 
-      pVelocity[i] = startVel + trans.m_qRotation * normalPos * fSpeed;
+      plParticleStreamSimd::TransformPositions(mVelocityTransform, vNormalX.CompMul(vSpeed), vNormalY.CompMul(vSpeed), vNormalZ.CompMul(vSpeed), vel);
     }
 
-    pPosition[i] = (trans * pos).GetAsVec4(0);
+    plParticleStreamSimd::TransformPositions(mTransform, x + vOffsetX, y + vOffsetY, z + vOffsetZ, pos);
+
+    // the start index is not necessarily a multiple of four, so only the requested elements may be written
+    const plUInt32 uiNumInGroup = static_cast<plUInt32>(plMath::Min<plUInt64>(4, uiNumElements - i));
+    for (plUInt32 j = 0; j < uiNumInGroup; ++j)
+    {
+      pPosition[uiStartIndex + i + j] = pos[j];
+    }
+
+    if (m_bSetVelocity)
+    {
+      for (plUInt32 j = 0; j < uiNumInGroup; ++j)
+      {
+        pVelocity[uiStartIndex + i + j] = vel[j];
+      }
+    }
   }
 }
 
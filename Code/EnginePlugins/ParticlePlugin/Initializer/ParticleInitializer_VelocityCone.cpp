@@ -77,7 +77,7 @@ void plParticleInitializerFactory_VelocityCone::QueryFinalizerDependencies(plSet
 
 void plParticleInitializer_VelocityCone::CreateRequiredStreams()
 {
-  CreateStream("Velocity", plProcessingStream::DataType::Float3, &m_pStreamVelocity, true);
+  CreateStream("Velocity", plProcessingStream::DataType::Float4, &m_pStreamVelocity, true);
 }
 
 void plParticleInitializer_VelocityCone::InitializeElements(plUInt64 uiStartIndex, plUInt64 uiNumElements)
@@ -86,7 +86,7 @@ void plParticleInitializer_VelocityCone::InitializeElements(plUInt64 uiStartInde
 
   const plVec3 startVel = GetOwnerSystem()->GetParticleStartVelocity();
 
-  plVec3* pVelocity = m_pStreamVelocity->GetWritableData<plVec3>();
+  plVec4* pVelocity = m_pStreamVelocity->GetWritableData<plVec4>();
 
   plRandom& rng = GetRNG();
 
@@ -113,7 +113,7 @@ void plParticleInitializer_VelocityCone::InitializeElements(plUInt64 uiStartInde
 
     const float fSpeed = (float)rng.DoubleVariance(m_Speed.m_Value, m_Speed.m_fVariance);
 
-    pVelocity[i] = startVel + GetOwnerSystem()->GetTransform().m_qRotation * dir * fSpeed;
+    pVelocity[i] = (startVel + GetOwnerSystem()->GetTransform().m_qRotation * dir * fSpeed).GetAsVec4(0);
   }
 }
 
@@ -47,6 +47,11 @@ protected:
     m_pOwnerSystem->CreateStream(szName, Type, ppStream, m_StreamBinding, bWillInitializeStream);
   }
 
+  /// \brief Modules that return true from CanProcessInParallel() only implement ProcessRange(), all others have to override Process().
+  ///
+  /// Such modules must not modify any shared state in ProcessRange(). Per frame work (e.g. sampling resources) belongs into StepParticleSystem().
+  virtual void Process(plUInt64 uiNumElements) override { ProcessRange(0, uiNumElements); }
+
   virtual plResult UpdateStreamBindings() final override
   {
     m_StreamBinding.UpdateBindings(m_pStreamGroup);
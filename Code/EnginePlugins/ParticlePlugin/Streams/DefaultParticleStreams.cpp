@@ -113,7 +113,7 @@ PL_BEGIN_DYNAMIC_REFLECTED_TYPE(plParticleStream_Velocity, 1, plRTTIDefaultAlloc
 PL_END_DYNAMIC_REFLECTED_TYPE;
 
 plParticleStreamFactory_Velocity::plParticleStreamFactory_Velocity()
-  : plParticleStreamFactory("Velocity", plProcessingStream::DataType::Float3, plGetStaticRTTI<plParticleStream_Velocity>())
+  : plParticleStreamFactory("Velocity", plProcessingStream::DataType::Float4, plGetStaticRTTI<plParticleStream_Velocity>())
 {
 }
 
@@ -124,9 +124,9 @@ void plParticleStream_Velocity::Initialize(plParticleSystemInstance* pOwner)
 
 void plParticleStream_Velocity::InitializeElements(plUInt64 uiStartIndex, plUInt64 uiNumElements)
 {
-  plProcessingStreamIterator<plVec3> itData(m_pStream, uiNumElements, uiStartIndex);
+  plProcessingStreamIterator<plVec4> itData(m_pStream, uiNumElements, uiStartIndex);
 
-  const plVec3 startVel = m_pOwner->GetParticleStartVelocity();
+  const plVec4 startVel = m_pOwner->GetParticleStartVelocity().GetAsVec4(0);
 
   while (!itData.HasReachedEnd())
   {
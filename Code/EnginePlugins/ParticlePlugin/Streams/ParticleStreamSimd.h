@@ -0,0 +1,191 @@
+#pragma once
+
+#include <Foundation/Math/Color16f.h>
+#include <Foundation/Math/Float16.h>
+#include <Foundation/SimdMath/SimdMat4f.h>
+#include <Foundation/SimdMath/SimdVec4i.h>
+#include <ParticlePlugin/ParticlePluginDLL.h>
+
+/// \brief Helpers for behaviors and initializers that process particle streams four elements at a time.
+///
+/// Particle streams are 16 byte aligned and padded to a multiple of four elements (see plProcessingStream),
+/// so kernels always process whole groups of four and don't need a scalar loop for the remainder.
+/// Vector streams like Position and Velocity use a padded Float4 layout, so every element can be loaded directly as a plSimdVec4f.
+namespace plParticleStreamSimd
+{
+  /// \brief Number of entries in the lookup tables that curves and gradients are baked into, without the extra entry at the end.
+  ///
+  /// Color gradients are interpolated in gamma space, so they are not linear between their control points. With 256 entries the
+  /// interpolated values differ by less than 1% from the evaluated gradient, with 64 entries it was up to 3%.
+  static constexpr plUInt32 LookupTableSize = 256;
+
+  /// \brief Returns the number of groups of four elements that need to be processed to cover uiNumElements.
+  PL_ALWAYS_INLINE plUInt32 GetNumGroups(plUInt64 uiNumElements)
+  {
+    return static_cast<plUInt32>((uiNumElements + 3) / 4);
+  }
+
+  /// \brief Reinterprets the bits of a vector as integers or floats.
+  union Bits
+  {
+    Bits() {} // NOLINT: using = default doesn't work here.
+
+    plSimdVec4i i;
+    plSimdVec4f f;
+  };
+
+  /// \brief Converts four 16 bit floats, given in the lower 16 bits of each component, to 32 bit floats.
+  ///
+  /// The results are identical to the conversion of plFloat16, which is not inlined and dominated the behavior kernels.
+  PL_ALWAYS_INLINE plSimdVec4f HalfToFloat(const plSimdVec4i& vHalf)
+  {
+    const plSimdVec4i vAbs = vHalf & plSimdVec4i(0x7fff);
+    const plSimdVec4i vExponent = vAbs & plSimdVec4i(0x7c00);
+
+    // normalized numbers only need a different exponent bias, infinities and NaNs need the maximum exponent
+    Bits normal;
+    normal.i = (vAbs << 13) + plSimdVec4i((127 - 15) << 23);
+    const plSimdVec4i vInfNaN = normal.i + plSimdVec4i((127 - 15) << 23);
+
+    // denormalized numbers are the mantissa times 2^-24, which is always a normalized 32 bit float
+    Bits denormal;
+    denormal.f = vAbs.ToFloat() * plSimdFloat(1.0f / (1 << 24));
+
+    Bits result;
+    result.i = plSimdVec4i::Select(vExponent == plSimdVec4i::MakeZero(), denormal.i, plSimdVec4i::Select(vExponent == plSimdVec4i(0x7c00), vInfNaN, normal.i));
+    result.i |= (vHalf & plSimdVec4i(0x8000)) << 16;
+
+    return result.f;
+  }
+
+  /// \brief Converts four 32 bit floats to 16 bit floats, which are returned in the lower 16 bits of each component.
+  ///
+  /// The results are identical to the conversion of plFloat16, i.e. the mantissa is truncated and values that are too small become zero.
+  PL_ALWAYS_INLINE plSimdVec4i FloatToHalf(const plSimdVec4f& v)
+  {
+    Bits bits;
+    bits.f = v;
+
+    const plSimdVec4i vAbs = bits.i & plSimdVec4i(0x7fffffff);
+    const plSimdVec4i vBiasedExponent = vAbs >> 23;
+
+    // normalized half floats
+    const plSimdVec4i vNormal = (vAbs >> 13) - plSimdVec4i((127 - 15) << 10);
+
+    // denormalized half floats, the shift is at least 31 for zero and very small values, which results in zero
+    const plSimdVec4i vShift = (plSimdVec4i(127 - 15 + 1) - vBiasedExponent).CompMin(plSimdVec4i(31));
+    const plSimdVec4i vDenormal = ((vAbs & plSimdVec4i(0x007fffff)) | plSimdVec4i(0x00800000)) >> vShift >> 13;
+
+    // overflows and infinities become infinity, NaNs keep the upper bits of their mantissa, but at least one bit
+    const plSimdVec4i vNaNMantissa = ((vAbs >> 13) & plSimdVec4i(0x3ff)).CompMax(plSimdVec4i(1));
+    const plSimdVec4i vInfNaN = plSimdVec4i::Select(vAbs > plSimdVec4i(0x7f800000), plSimdVec4i(0x7c00) | vNaNMantissa, plSimdVec4i(0x7c00));
+
+    plSimdVec4i vResult = plSimdVec4i::Select(vBiasedExponent <= plSimdVec4i(127 - 15), vDenormal, vNormal);
+    vResult = plSimdVec4i::Select(vBiasedExponent > plSimdVec4i(127 + 15), vInfNaN, vResult);
+
+    // values that are too small become a positive zero, like in plFloat16
+    const plSimdVec4i vSign = plSimdVec4i::Select(vBiasedExponent < plSimdVec4i(127 - 15 - 10), plSimdVec4i::MakeZero(), (bits.i >> 16) & plSimdVec4i(0x8000));
+
+    return vResult | vSign;
+  }
+
+  /// \brief Stores four 16 bit floats, given in the lower 16 bits of each component.
+  PL_ALWAYS_INLINE void StoreHalfBits(plFloat16* pData, plUInt32 uiStride, const plSimdVec4i& vHalf)
+  {
+    plInt32 h[4];
+    vHalf.Store<4>(h);
+
+    pData[0].SetRawData(static_cast<plUInt16>(h[0]));
+    pData[uiStride].SetRawData(static_cast<plUInt16>(h[1]));
+    pData[uiStride * 2].SetRawData(static_cast<plUInt16>(h[2]));
+    pData[uiStride * 3].SetRawData(static_cast<plUInt16>(h[3]));
+  }
+
+  /// \brief Loads four plFloat16 values.
+  PL_ALWAYS_INLINE plSimdVec4f LoadHalf(const plFloat16* pData)
+  {
+    return HalfToFloat(plSimdVec4i(pData[0].GetRawData(), pData[1].GetRawData(), pData[2].GetRawData(), pData[3].GetRawData()));
+  }
+
+  /// \brief Stores four plFloat16 values.
+  PL_ALWAYS_INLINE void StoreHalf(plFloat16* pData, const plSimdVec4f& v)
+  {
+    StoreHalfBits(pData, 1, FloatToHalf(v));
+  }
+
+  /// \brief Stores the alpha of four colors.
+  PL_ALWAYS_INLINE void StoreAlpha(plColorLinear16f* pColor, const plSimdVec4f& vAlpha)
+  {
+    StoreHalfBits(&pColor->a, 4, FloatToHalf(vAlpha));
+  }
+
+  /// \brief Stores one color, given as r, g, b, a.
+  PL_ALWAYS_INLINE void StoreColor(plColorLinear16f* pColor, const plSimdVec4f& vColor)
+  {
+    StoreHalfBits(pColor->GetData(), 1, FloatToHalf(vColor));
+  }
+
+  /// \brief Loads the remaining fraction of the life time (x * y of the LifeTime stream) of four particles, 1 at spawn and 0 at death.
+  PL_ALWAYS_INLINE plSimdVec4f LoadLifeTimeFraction(const plFloat16Vec2* pLifeTime)
+  {
+    // every 32 bit component holds x in the lower and y in the upper 16 bits
+    plSimdVec4i vLifeTime;
+    vLifeTime.Load<4>(reinterpret_cast<const plInt32*>(pLifeTime));
+
+    return HalfToFloat(vLifeTime).CompMul(HalfToFloat(vLifeTime >> 16));
+  }
+
+  /// \brief Computes the lookup table indices and interpolation factors for four positions in [0; 1]. Positions outside that range are clamped.
+  PL_ALWAYS_INLINE void ComputeLookupTablePositions(const plSimdVec4f& vPos, plUInt32* out_pIndices, plSimdVec4f& out_vFraction)
+  {
+    const plSimdVec4f vScaledPos = vPos.CompMax(plSimdVec4f::MakeZero()).CompMin(plSimdVec4f(1.0f)) * static_cast<float>(LookupTableSize - 1);
+    const plSimdVec4i vIndex = plSimdVec4i::Truncate(vScaledPos);
+
+    out_vFraction = vScaledPos - vIndex.ToFloat();
+    vIndex.Store<4>(reinterpret_cast<plInt32*>(out_pIndices));
+  }
+
+  /// \brief Samples a lookup table with LookupTableSize + 1 entries at four positions in [0; 1] with linear interpolation.
+  PL_ALWAYS_INLINE plSimdVec4f SampleLookupTable(const float* pTable, const plSimdVec4f& vPos)
+  {
+    plUInt32 uiIndex[4];
+    plSimdVec4f vFraction;
+    ComputeLookupTablePositions(vPos, uiIndex, vFraction);
+
+    const plSimdVec4f a(pTable[uiIndex[0]], pTable[uiIndex[1]], pTable[uiIndex[2]], pTable[uiIndex[3]]);
+    const plSimdVec4f b(pTable[uiIndex[0] + 1], pTable[uiIndex[1] + 1], pTable[uiIndex[2] + 1], pTable[uiIndex[3] + 1]);
+
+    return plSimdVec4f::Lerp(a, b, vFraction);
+  }
+
+  /// \brief Samples a lookup table of vectors (e.g. colors) with LookupTableSize + 1 entries at four positions in [0; 1] with linear interpolation.
+  PL_ALWAYS_INLINE void SampleLookupTable(const plSimdVec4f* pTable, const plSimdVec4f& vPos, plSimdVec4f* out_pValues)
+  {
+    plUInt32 uiIndex[4];
+    plSimdVec4f vFraction;
+    ComputeLookupTablePositions(vPos, uiIndex, vFraction);
+
+    out_pValues[0] = plSimdVec4f::Lerp(pTable[uiIndex[0]], pTable[uiIndex[0] + 1], vFraction.Get<plSwizzle::XXXX>());
+    out_pValues[1] = plSimdVec4f::Lerp(pTable[uiIndex[1]], pTable[uiIndex[1] + 1], vFraction.Get<plSwizzle::YYYY>());
+    out_pValues[2] = plSimdVec4f::Lerp(pTable[uiIndex[2]], pTable[uiIndex[2] + 1], vFraction.Get<plSwizzle::ZZZZ>());
+    out_pValues[3] = plSimdVec4f::Lerp(pTable[uiIndex[3]], pTable[uiIndex[3] + 1], vFraction.Get<plSwizzle::WWWW>());
+  }
+
+  /// \brief Transforms four positions, given as separate x, y and z components, and writes them as padded Float4 elements with w = 0.
+  PL_ALWAYS_INLINE void TransformPositions(const plSimdMat4f& mTransform, const plSimdVec4f& x, const plSimdVec4f& y, const plSimdVec4f& z, plSimdVec4f* out_pPositions)
+  {
+    plSimdVec4f vTranslation = mTransform.m_col3;
+    vTranslation.SetW(plSimdFloat::MakeZero());
+
+    out_pPositions[0] = mTransform.m_col0 * x.x() + mTransform.m_col1 * y.x() + mTransform.m_col2 * z.x() + vTranslation;
+    out_pPositions[1] = mTransform.m_col0 * x.y() + mTransform.m_col1 * y.y() + mTransform.m_col2 * z.y() + vTranslation;
+    out_pPositions[2] = mTransform.m_col0 * x.z() + mTransform.m_col1 * y.z() + mTransform.m_col2 * z.z() + vTranslation;
+    out_pPositions[3] = mTransform.m_col0 * x.w() + mTransform.m_col1 * y.w() + mTransform.m_col2 * z.w() + vTranslation;
+  }
+
+  /// \brief Returns the element indices of a group of four, starting at uiFirstElement. Used as the position for plSimdRandom.
+  PL_ALWAYS_INLINE plSimdVec4i GetElementIndices(plUInt64 uiFirstElement)
+  {
+    return plSimdVec4i(static_cast<plInt32>(uiFirstElement)) + plSimdVec4i(0, 1, 2, 3);
+  }
+} // namespace plParticleStreamSimd
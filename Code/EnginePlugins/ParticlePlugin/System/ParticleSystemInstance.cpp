@@ -2,6 +2,7 @@
 
 #include <Core/Interfaces/PhysicsWorldModule.h>
 #include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/DataProcessing/Stream/DefaultImplementations/ZeroInitializer.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
@@ -18,6 +19,8 @@
 #include <ParticlePlugin/WorldModule/ParticleWorldModule.h>
 #include <RendererCore/RenderWorld/RenderWorld.h>
 
+plCVarInt cvar_ParticlesElementsPerTask("Particles.ElementsPerTask", 4096, plCVarFlags::Default, "Number of particles per task, when large particle systems update their behaviors on multiple threads. 0 disables this.");
+
 bool plParticleSystemInstance::HasActiveParticles() const
 {
   return m_StreamGroup.GetNumActiveElements() > 0;
@@ -448,6 +451,9 @@ plParticleSystemState::Enum plParticleSystemInstance::Update(const plTime& diff)
 
   {
     PL_PROFILE_SCOPE("PFX: System Process");
+
+    // behaviors that only work on individual particles are processed in chunks on multiple threads for very large systems
+    m_StreamGroup.SetMinElementsPerTask(static_cast<plUInt32>(plMath::Max(cvar_ParticlesElementsPerTask.GetValue(), 0)));
     m_StreamGroup.Process();
   }
 
@@ -4,6 +4,7 @@
 #include <ParticlePlugin/Type/Quad/QuadParticleRenderer.h>
 #include <RendererCore/Pipeline/RenderDataBatch.h>
 #include <RendererCore/RenderContext/RenderContext.h>
+#include <RendererCore/Textures/TextureStreaming.h>
 
 // clang-format off
 PL_BEGIN_DYNAMIC_REFLECTED_TYPE(plParticleQuadRenderData, 1, plRTTINoAllocator)
@@ -53,6 +54,8 @@ void plParticleQuadRenderer::RenderBatch(const plRenderViewContext& renderViewCo
     pRenderContext->BindBuffer("particleTangentQuadData", pDevice->GetDefaultResourceView(m_hTangentDataBuffer));
   }
 
+  const bool bReportTextureUsage = plTextureStreaming::ShouldReportUsage(renderViewContext);
+
   // now render all particle effects of type Quad
   for (auto it = batch.GetIterator<plParticleQuadRenderData>(0, batch.GetCount()); it.IsValid(); ++it)
   {
@@ -66,6 +69,12 @@ void plParticleQuadRenderer::RenderBatch(const plRenderViewContext& renderViewCo
 
     pRenderContext->BindTexture2D("ParticleTexture", pRenderData->m_hTexture);
 
+    if (bReportTextureUsage)
+    {
+      // particle render data has no bounds, so this requests the resolution of the entire view
+      plTextureStreaming::ReportTextureUsage(pRenderData->m_hTexture, plTextureStreaming::ComputeScreenSize(pRenderData->m_GlobalBounds, renderViewContext));
+    }
+
     ConfigureRenderMode(pRenderData, pRenderContext);
 
     systemConstants.SetGenericData(
@@ -6,6 +6,7 @@
 #include <RendererCore/Pipeline/RenderDataBatch.h>
 #include <RendererCore/RenderContext/RenderContext.h>
 #include <RendererCore/Shader/ShaderResource.h>
+#include <RendererCore/Textures/TextureStreaming.h>
 #include <RendererFoundation/Device/Device.h>
 
 #include <RendererCore/../../../Data/Base/Shaders/Particles/ParticleSystemConstants.h>
@@ -64,6 +65,8 @@ void plParticleTrailRenderer::RenderBatch(const plRenderViewContext& renderViewC
     pRenderContext->BindBuffer("particleTrailData", plGALDevice::GetDefaultDevice()->GetDefaultResourceView(m_hTrailDataBuffer));
   }
 
+  const bool bReportTextureUsage = plTextureStreaming::ShouldReportUsage(renderViewContext);
+
   // now render all particle effects of type Trail
   for (auto it = batch.GetIterator<plParticleTrailRenderData>(0, batch.GetCount()); it.IsValid(); ++it)
   {
@@ -88,6 +91,12 @@ void plParticleTrailRenderer::RenderBatch(const plRenderViewContext& renderViewC
 
     pRenderContext->BindTexture2D("ParticleTexture", pRenderData->m_hTexture);
 
+    if (bReportTextureUsage)
+    {
+      // particle render data has no bounds, so this requests the resolution of the entire view
+      plTextureStreaming::ReportTextureUsage(pRenderData->m_hTexture, plTextureStreaming::ComputeScreenSize(pRenderData->m_GlobalBounds, renderViewContext));
+    }
+
     systemConstants.SetGenericData(
       pRenderData->m_bApplyObjectTransform, pRenderData->m_GlobalTransform, pRenderData->m_TotalEffectLifeTime, pRenderData->m_uiNumVariationsX, pRenderData->m_uiNumVariationsY, pRenderData->m_uiNumFlipbookAnimationsX, pRenderData->m_uiNumFlipbookAnimationsY, pRenderData->m_fDistortionStrength);
     systemConstants.SetTrailData(pRenderData->m_fSnapshotFraction, pRenderData->m_uiMaxTrailPoints);
@@ -0,0 +1,249 @@
+#include <Foundation/Application/Application.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Types/UniquePtr.h>
+#include <Foundation/Utilities/CommandLineOptions.h>
+
+plCommandLineOptionInt opt_MaxThreads("_AllocatorBench", "-threads", "The benchmark runs with 1, 2, 4, ... threads up to this number.", 8, 1, 128);
+
+plCommandLineOptionBool opt_Tracking("_AllocatorBench", "-tracking", "Use the default tracking mode. Otherwise the allocators only do basic tracking, so that the allocation policies are measured.", false);
+
+plCommandLineOptionInt opt_Operations("_AllocatorBench", "-ops", "Number of allocations and frees per thread.", 200000, 1000, 100000000);
+
+namespace
+{
+  struct plBenchAllocation
+  {
+    PL_DECLARE_POD_TYPE();
+
+    void* m_pPtr;
+    plUInt32 m_uiSize;
+  };
+
+  /// \brief Allocations that are freed by another thread than the one that allocated them.
+  struct plRemoteFrees
+  {
+    plMutex m_Mutex;
+    plDynamicArray<plBenchAllocation> m_Allocations;
+  };
+
+  /// \brief Allocates and frees random sizes, mostly small ones, like component churn and string building do.
+  class plBenchThread : public plThread
+  {
+  public:
+    plAllocator* m_pAllocator = nullptr;
+    plRemoteFrees* m_pRemoteFrees = nullptr;
+    plUInt32 m_uiSeed = 0;
+    plUInt32 m_uiNumOperations = 0;
+    plUInt32 m_uiNumErrors = 0;
+
+    plBenchThread()
+      : plThread("AllocatorBench")
+    {
+    }
+
+    virtual plUInt32 Run() override
+    {
+      plDynamicArray<plBenchAllocation> live;
+      live.Reserve(m_uiNumOperations);
+
+      plUInt32 uiSeed = m_uiSeed;
+
+      for (plUInt32 i = 0; i < m_uiNumOperations; ++i)
+      {
+        uiSeed = uiSeed * 1103515245u + 12345u;
+
+        if (live.GetCount() < 512 || (uiSeed & 2) != 0)
+        {
+          // most allocations are small, some are bigger than what the thread caches handle
+          const plUInt32 uiSize = 1 + (uiSeed >> 8) % ((uiSeed & 1) != 0 ? 128 : 1500);
+          const plUInt32 uiAlign = (uiSeed & 4) != 0 ? 16 : 8;
+
+          plBenchAllocation& allocation = live.ExpandAndGetRef();
+          allocation.m_pPtr = m_pAllocator->Allocate(uiSize, uiAlign);
+          allocation.m_uiSize = uiSize;
+
+          plMemoryUtils::PatternFill(static_cast<plUInt8*>(allocation.m_pPtr), static_cast<plUInt8>(uiSize), uiSize);
+        }
+        else
+        {
+          const plUInt32 uiIndex = (uiSeed >> 4) % live.GetCount();
+          const plBenchAllocation allocation = live[uiIndex];
+          live.RemoveAtAndSwap(uiIndex);
+
+          // only check the first byte, a full check would dominate the timings
+          if (*static_cast<plUInt8*>(allocation.m_pPtr) != static_cast<plUInt8>(allocation.m_uiSize))
+          {
+            ++m_uiNumErrors;
+          }
+
+          if (m_pRemoteFrees != nullptr && (uiSeed & 8) != 0)
+          {
+            PL_LOCK(m_pRemoteFrees->m_Mutex);
+            m_pRemoteFrees->m_Allocations.PushBack(allocation);
+          }
+          else
+          {
+            m_pAllocator->Deallocate(allocation.m_pPtr);
+          }
+        }
+
+        // free what other threads allocated
+        if (m_pRemoteFrees != nullptr && (i % 64) == 0)
+        {
+          PL_LOCK(m_pRemoteFrees->m_Mutex);
+
+          for (const plBenchAllocation& allocation : m_pRemoteFrees->m_Allocations)
+          {
+            m_pAllocator->Deallocate(allocation.m_pPtr);
+          }
+
+          m_pRemoteFrees->m_Allocations.Clear();
+        }
+      }
+
+      for (const plBenchAllocation& allocation : live)
+      {
+        m_pAllocator->Deallocate(allocation.m_pPtr);
+      }
+
+      return 0;
+    }
+  };
+} // namespace
+
+/// \brief Measures the allocation and free throughput of the heap allocators with an increasing number of threads.
+///
+/// Every thread allocates and frees random sizes up to 1.5 KB. In the 'remote frees' runs, a part of the allocations is freed by other
+/// threads than the ones that allocated them. The thread caching allocator is measured directly and as the parent of a proxy allocator,
+/// which is how most engine systems use their allocators.
+class plAllocatorBench : public plApplication
+{
+public:
+  using SUPER = plApplication;
+
+  plAllocatorBench()
+    : plApplication("AllocatorBench")
+  {
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    plGlobalLog::AddLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::AddLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    plGlobalLog::RemoveLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::RemoveLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  /// \brief Returns the throughput in million operations per second.
+  double Measure(plAllocator* pAllocator, plStringView sName, plUInt32 uiNumThreads, bool bRemoteFrees)
+  {
+    const plUInt32 uiNumOperations = static_cast<plUInt32>(opt_Operations.GetOptionValue(plCommandLineOption::LogMode::Never));
+
+    plRemoteFrees remoteFrees;
+
+    plDynamicArray<plUniquePtr<plBenchThread>> threads;
+    for (plUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      plUniquePtr<plBenchThread> pThread = PL_DEFAULT_NEW(plBenchThread);
+      pThread->m_pAllocator = pAllocator;
+      pThread->m_pRemoteFrees = bRemoteFrees ? &remoteFrees : nullptr;
+      pThread->m_uiSeed = i * 7919 + 1;
+      pThread->m_uiNumOperations = uiNumOperations;
+      threads.PushBack(std::move(pThread));
+    }
+
+    const plTime start = plTime::Now();
+
+    for (auto& pThread : threads)
+    {
+      pThread->Start();
+    }
+
+    for (auto& pThread : threads)
+    {
+      pThread->Join();
+    }
+
+    const plTime duration = plTime::Now() - start;
+
+    for (const plBenchAllocation& allocation : remoteFrees.m_Allocations)
+    {
+      pAllocator->Deallocate(allocation.m_pPtr);
+    }
+
+    for (auto& pThread : threads)
+    {
+      if (pThread->m_uiNumErrors > 0)
+      {
+        plLog::Error("{}: {} allocations were overwritten", sName, pThread->m_uiNumErrors);
+        SetReturnCode(1);
+      }
+    }
+
+    return (static_cast<double>(uiNumOperations) * uiNumThreads) / duration.GetMicroseconds();
+  }
+
+  template <plAllocatorTrackingMode TrackingMode>
+  void MeasureAll()
+  {
+    const plUInt32 uiMaxThreads = static_cast<plUInt32>(opt_MaxThreads.GetOptionValue(plCommandLineOption::LogMode::Always));
+    opt_Operations.GetOptionValue(plCommandLineOption::LogMode::Always);
+
+    plAllocatorWithPolicy<plAllocPolicyHeap, TrackingMode> heap("Heap");
+    plAllocatorWithPolicy<plAllocPolicyThreadCaching, TrackingMode> threadCaching("ThreadCaching");
+    plAllocatorWithPolicy<plAllocPolicyProxy, TrackingMode> proxy("Proxy", &threadCaching);
+
+    for (bool bRemoteFrees : {false, true})
+    {
+      for (plUInt32 uiNumThreads = 1; uiNumThreads <= uiMaxThreads; uiNumThreads *= 2)
+      {
+        const double fHeap = Measure(&heap, "Heap", uiNumThreads, bRemoteFrees);
+        const double fThreadCaching = Measure(&threadCaching, "ThreadCaching", uiNumThreads, bRemoteFrees);
+        const double fProxy = Measure(&proxy, "Proxy", uiNumThreads, bRemoteFrees);
+
+        plLog::Info("{} threads{}: heap {} Mops/s, thread caching {} Mops/s, proxy to thread caching {} Mops/s", uiNumThreads,
+          bRemoteFrees ? ", remote frees" : "", plArgF(fHeap, 1), plArgF(fThreadCaching, 1), plArgF(fProxy, 1));
+      }
+    }
+  }
+
+  virtual Execution Run() override
+  {
+    {
+      plStringBuilder cmdHelp;
+      if (plCommandLineOption::LogAvailableOptionsToBuffer(cmdHelp, plCommandLineOption::LogAvailableModes::IfHelpRequested, "_AllocatorBench"))
+      {
+        plLog::Print(cmdHelp);
+        return plApplication::Execution::Quit;
+      }
+    }
+
+    if (opt_Tracking.GetOptionValue(plCommandLineOption::LogMode::Always))
+    {
+      MeasureAll<plAllocatorTrackingMode::Default>();
+    }
+    else
+    {
+      MeasureAll<plAllocatorTrackingMode::Basics>();
+    }
+
+    return plApplication::Execution::Quit;
+  }
+};
+
+PL_CONSOLEAPP_ENTRY_POINT(plAllocatorBench);
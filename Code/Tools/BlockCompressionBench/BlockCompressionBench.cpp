@@ -0,0 +1,216 @@
+#include <Foundation/Application/Application.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Utilities/CommandLineOptions.h>
+#include <Texture/Image/Image.h>
+#include <Texture/Image/ImageConversion.h>
+
+plCommandLineOptionPath opt_Input("_BlockCompressionBench", "-in", "Image to compress. If not given, a synthetic 256x256 image with gradients, noise and hard edges is used.", "");
+
+plCommandLineOptionInt opt_Runs("_BlockCompressionBench", "-runs", "How often every encoder is run. The fastest run is reported.", 1, 1, 100);
+
+/// \brief Compresses an image with every block compressor that is registered for the BC formats and prints the time and PSNR of each.
+///
+/// All compressors are measured, regardless of the cvars that decide which of them plImageConversion picks. The penalty printed next to
+/// every result is the one that is used for that choice, the compressor with the lowest penalty wins.
+class plBlockCompressionBench : public plApplication
+{
+public:
+  using SUPER = plApplication;
+
+  plBlockCompressionBench()
+    : plApplication("BlockCompressionBench")
+  {
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    // Add the empty data directory to access files via absolute paths
+    plFileSystem::AddDataDirectory("", "App", ":", plFileSystem::AllowWrites).IgnoreResult();
+
+    plGlobalLog::AddLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::AddLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+
+    // allows to compare the quality presets, e.g. with '-Texture.BlockCompressionQuality 2'
+    plCVar::LoadCVarsFromCommandLine();
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    plGlobalLog::RemoveLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::RemoveLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  void CreateSyntheticImage(plImage& ref_image)
+  {
+    const plUInt32 uiSize = 256;
+
+    plImageHeader header;
+    header.SetImageFormat(plImageFormat::R8G8B8A8_UNORM);
+    header.SetWidth(uiSize);
+    header.SetHeight(uiSize);
+    ref_image.ResetAndAlloc(header);
+
+    plUInt32 uiSeed = 99;
+
+    for (plUInt32 y = 0; y < uiSize; ++y)
+    {
+      for (plUInt32 x = 0; x < uiSize; ++x)
+      {
+        uiSeed = uiSeed * 1664525u + 1013904223u;
+        const plInt32 iNoise = plInt32((uiSeed >> 24) % 17) - 8;
+        const float fX = x / float(uiSize);
+        const float fY = y / float(uiSize);
+
+        plUInt8* pPixel = ref_image.GetPixelPointer<plUInt8>(0, 0, 0, x, y);
+        pPixel[0] = static_cast<plUInt8>(plMath::Clamp(plInt32(127 + 120 * plMath::Sin(plAngle::MakeFromRadian(fX * 20 + fY * 3))) + iNoise, 0, 255));
+        pPixel[1] = static_cast<plUInt8>(plMath::Clamp(plInt32(127 + 120 * plMath::Cos(plAngle::MakeFromRadian(fY * 13 + fX * 5))) + iNoise / 2, 0, 255));
+        pPixel[2] = ((x / 37 + y / 29) & 1) ? 200 : 40;
+        pPixel[3] = (x < uiSize / 2) ? 255 : static_cast<plUInt8>(255 * fY);
+      }
+    }
+  }
+
+  /// \brief Returns the PSNR over the channels that the given format stores. For BC1 pixels with an alpha below 128 are skipped, because
+  /// they may be encoded as transparent.
+  double ComputePSNR(const plImage& source, const plImage& decoded, plImageFormat::Enum format)
+  {
+    plUInt32 uiChannels = 4;
+    switch (plImageFormat::AsLinear(format))
+    {
+      case plImageFormat::BC1_UNORM:
+        uiChannels = 3;
+        break;
+      case plImageFormat::BC4_UNORM:
+        uiChannels = 1;
+        break;
+      case plImageFormat::BC5_UNORM:
+        uiChannels = 2;
+        break;
+      default:
+        break;
+    }
+
+    const bool bSkipTransparent = plImageFormat::AsLinear(format) == plImageFormat::BC1_UNORM;
+
+    double fSquaredError = 0.0;
+    plUInt64 uiNumValues = 0;
+
+    for (plUInt32 y = 0; y < source.GetHeight(); ++y)
+    {
+      for (plUInt32 x = 0; x < source.GetWidth(); ++x)
+      {
+        const plUInt8* pSource = source.GetPixelPointer<plUInt8>(0, 0, 0, x, y);
+        const plUInt8* pDecoded = decoded.GetPixelPointer<plUInt8>(0, 0, 0, x, y);
+
+        if (bSkipTransparent && pSource[3] < 128)
+          continue;
+
+        for (plUInt32 c = 0; c < uiChannels; ++c)
+        {
+          const double fError = double(pSource[c]) - double(pDecoded[c]);
+          fSquaredError += fError * fError;
+          ++uiNumValues;
+        }
+      }
+    }
+
+    const double fMeanSquaredError = plMath::Max(fSquaredError / plMath::Max<plUInt64>(uiNumValues, 1), 1e-9);
+    return 10.0 * plMath::Log10(255.0 * 255.0 / fMeanSquaredError);
+  }
+
+  void Measure(const plImage& source, const plImageConversionStep* pStep, const plImageConversionEntry& entry, plUInt32 uiStepIndex)
+  {
+    plImageHeader header = source.GetHeader();
+    header.SetImageFormat(entry.m_targetFormat);
+
+    plImage compressed;
+    compressed.ResetAndAlloc(header);
+
+    plTime fastest = plTime::MakeFromHours(1);
+
+    for (plUInt32 uiRun = 0; uiRun < plUInt32(opt_Runs.GetOptionValue(plCommandLineOption::LogMode::Never)); ++uiRun)
+    {
+      const plTime start = plTime::Now();
+
+      if (static_cast<const plImageConversionStepCompressBlocks*>(pStep)->CompressBlocks(source.GetByteBlobPtr(), compressed.GetByteBlobPtr(), header.GetNumBlocksX(), header.GetNumBlocksY(), entry.m_sourceFormat, entry.m_targetFormat).Failed())
+      {
+        plLog::Error("{}: compressor {} failed", plImageFormat::GetName(entry.m_targetFormat), uiStepIndex);
+        return;
+      }
+
+      fastest = plMath::Min(fastest, plTime::Now() - start);
+    }
+
+    plImage decoded;
+    if (plImageConversion::Convert(compressed, decoded, plImageFormat::R8G8B8A8_UNORM).Failed())
+    {
+      plLog::Error("{}: decompression failed", plImageFormat::GetName(entry.m_targetFormat));
+      return;
+    }
+
+    plLog::Info("{}: compressor {}, penalty {}: {} ms, PSNR {} dB", plImageFormat::GetName(entry.m_targetFormat), uiStepIndex, plArgF(entry.m_additionalPenalty, 1), plArgF(fastest.GetMilliseconds(), 1), plArgF(ComputePSNR(source, decoded, entry.m_targetFormat), 2));
+  }
+
+  virtual Execution Run() override
+  {
+    {
+      plStringBuilder cmdHelp;
+      if (plCommandLineOption::LogAvailableOptionsToBuffer(cmdHelp, plCommandLineOption::LogAvailableModes::IfHelpRequested, "_BlockCompressionBench"))
+      {
+        plLog::Print(cmdHelp);
+        return plApplication::Execution::Quit;
+      }
+    }
+
+    plImage source;
+
+    plStringBuilder sInput = opt_Input.GetOptionValue(plCommandLineOption::LogMode::Always);
+    if (sInput.IsEmpty())
+    {
+      CreateSyntheticImage(source);
+    }
+    else
+    {
+      sInput.MakeCleanPath();
+
+      if (source.LoadFrom(sInput).Failed() || plImageConversion::Convert(source, source, plImageFormat::R8G8B8A8_UNORM).Failed())
+      {
+        plLog::Error("Failed to load '{}'", sInput);
+        SetReturnCode(1);
+        return plApplication::Execution::Quit;
+      }
+
+      if (source.GetWidth() % 4 != 0 || source.GetHeight() % 4 != 0)
+      {
+        plLog::Error("The image size has to be a multiple of 4");
+        SetReturnCode(1);
+        return plApplication::Execution::Quit;
+      }
+    }
+
+    plUInt32 uiStepIndex = 0;
+    for (const plImageConversionStep* pStep = plImageConversionStep::GetFirstInstance(); pStep; pStep = pStep->GetNextInstance(), ++uiStepIndex)
+    {
+      for (const plImageConversionEntry& entry : pStep->GetSupportedConversions())
+      {
+        if (entry.m_sourceFormat == plImageFormat::R8G8B8A8_UNORM && plImageFormat::IsCompressed(entry.m_targetFormat))
+        {
+          Measure(source, pStep, entry, uiStepIndex);
+        }
+      }
+    }
+
+    return plApplication::Execution::Quit;
+  }
+};
+
+PL_CONSOLEAPP_ENTRY_POINT(plBlockCompressionBench);
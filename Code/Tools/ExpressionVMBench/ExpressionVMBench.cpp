@@ -0,0 +1,329 @@
+#include <Foundation/Application/Application.h>
+#include <Foundation/CodeUtils/Expression/ExpressionCompiler.h>
+#include <Foundation/CodeUtils/Expression/ExpressionNativeCode.h>
+#include <Foundation/CodeUtils/Expression/ExpressionParser.h>
+#include <Foundation/CodeUtils/Expression/ExpressionVM.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Utilities/CommandLineOptions.h>
+
+plCommandLineOptionInt opt_Runs("_ExpressionVMBench", "-runs", "Number of measured runs per expression, width and instance count. The fastest run is reported.", 20, 1, 10000);
+
+plCommandLineOptionInt opt_MaxInstances("_ExpressionVMBench", "-instances", "The benchmark runs with 64, 1024, 16384, ... instances up to this number.", 262144, 64, 16777216);
+
+plCommandLineOptionPath opt_Generate("_ExpressionVMBench", "-generate", "Writes the native code of all expressions to this folder and quits. Use it to update the NativeCode folder of this tool after the expression compiler changed.", "");
+
+namespace
+{
+  struct plBenchExpression
+  {
+    const char* m_szName;
+    const char* m_szCode;
+  };
+
+  // Expressions like the ones that ProcGen graphs compile for placement density, object scale and vertex colors.
+  static const plBenchExpression s_Expressions[] = {
+    {"Placement", "var h = pz * 0.01;\n"
+                  "var slope = 1 - saturate(nz);\n"
+                  "var d = smoothstep(0.2, 0.8, h) * (1 - saturate(slope * 2));\n"
+                  "d = clamp(d * 1.5 - 0.25, 0, 1);\n"
+                  "density = d * (PerlinNoise(px * 0.05, py * 0.05, 0, 3) * 0.5 + 0.5);\n"
+                  "value = index * 3 + 7;\n"},
+    {"Scale", "var r = Random(index);\n"
+              "var f = frac(px * 0.37 + py * 0.11);\n"
+              "density = lerp(0.8, 1.2, r) * max(0.1, min(1, floor(pz * 0.1) * 0.05)) + f * 0.1;\n"
+              "value = (index << 3) >> 1 | (index & 5);\n"},
+    {"VertexColor", "var n = normalize(vec3(px, py, pz));\n"
+                    "var l = length(vec3(px, py, pz));\n"
+                    "density = saturate(dot(n, vec3(0.3, 0.5, 0.8)) * 0.5 + 0.5) * exp(-l * 0.01) + sin(px) * cos(py) * 0.1;\n"
+                    "value = int(saturate(nz) * 255.0);\n"},
+  };
+
+  static plExpression::StreamDesc s_Inputs[] = {
+    {plMakeHashedString("px"), plProcessingStream::DataType::Float},
+    {plMakeHashedString("py"), plProcessingStream::DataType::Float},
+    {plMakeHashedString("pz"), plProcessingStream::DataType::Float},
+    {plMakeHashedString("nz"), plProcessingStream::DataType::Float},
+    {plMakeHashedString("index"), plProcessingStream::DataType::Int},
+  };
+
+  static plExpression::StreamDesc s_Outputs[] = {
+    {plMakeHashedString("density"), plProcessingStream::DataType::Float},
+    {plMakeHashedString("value"), plProcessingStream::DataType::Int},
+  };
+
+  /// \brief Input and output data for all instances, the float inputs contain a few NaNs and infinities.
+  struct plBenchData
+  {
+    plDynamicArray<float> m_Floats[4];
+    plDynamicArray<plInt32> m_Index;
+
+    plDynamicArray<float> m_Density;
+    plDynamicArray<plInt32> m_Value;
+
+    void Initialize(plUInt32 uiNumInstances)
+    {
+      plRandom rng;
+      rng.Initialize(42);
+
+      for (plUInt32 i = 0; i < PL_ARRAY_SIZE(m_Floats); ++i)
+      {
+        m_Floats[i].SetCountUninitialized(uiNumInstances);
+        for (float& f : m_Floats[i])
+        {
+          f = static_cast<float>(rng.DoubleMinMax(-100.0, 200.0));
+        }
+      }
+
+      m_Index.SetCountUninitialized(uiNumInstances);
+      for (plInt32& i : m_Index)
+      {
+        i = rng.IntMinMax(-1000, 100000);
+      }
+
+      for (plUInt32 i = 17; i < uiNumInstances; i += 997)
+      {
+        m_Floats[i % 4][i] = (i & 1) != 0 ? plMath::NaN<float>() : plMath::Infinity<float>();
+      }
+
+      m_Density.SetCount(uiNumInstances);
+      m_Value.SetCount(uiNumInstances);
+    }
+
+    plResult Execute(plExpressionVM& ref_vm, const plExpressionByteCode& byteCode, plUInt32 uiNumInstances, plBitflags<plExpressionVM::Flags> flags)
+    {
+      plProcessingStream inputs[] = {
+        plProcessingStream(s_Inputs[0].m_sName, m_Floats[0].GetArrayPtr().GetSubArray(0, uiNumInstances).ToByteArray(), plProcessingStream::DataType::Float),
+        plProcessingStream(s_Inputs[1].m_sName, m_Floats[1].GetArrayPtr().GetSubArray(0, uiNumInstances).ToByteArray(), plProcessingStream::DataType::Float),
+        plProcessingStream(s_Inputs[2].m_sName, m_Floats[2].GetArrayPtr().GetSubArray(0, uiNumInstances).ToByteArray(), plProcessingStream::DataType::Float),
+        plProcessingStream(s_Inputs[3].m_sName, m_Floats[3].GetArrayPtr().GetSubArray(0, uiNumInstances).ToByteArray(), plProcessingStream::DataType::Float),
+        plProcessingStream(s_Inputs[4].m_sName, m_Index.GetArrayPtr().GetSubArray(0, uiNumInstances).ToByteArray(), plProcessingStream::DataType::Int),
+      };
+
+      plProcessingStream outputs[] = {
+        plProcessingStream(s_Outputs[0].m_sName, m_Density.GetArrayPtr().GetSubArray(0, uiNumInstances).ToByteArray(), plProcessingStream::DataType::Float),
+        plProcessingStream(s_Outputs[1].m_sName, m_Value.GetArrayPtr().GetSubArray(0, uiNumInstances).ToByteArray(), plProcessingStream::DataType::Int),
+      };
+
+      return ref_vm.Execute(byteCode, inputs, outputs, uiNumInstances, plExpression::GlobalData(), flags);
+    }
+
+    bool HasSameOutputs(const plDynamicArray<float>& density, const plDynamicArray<plInt32>& value, plUInt32 uiNumInstances) const
+    {
+      return plMemoryUtils::RawByteCompare(density.GetData(), m_Density.GetData(), uiNumInstances * sizeof(float)) == 0 &&
+             plMemoryUtils::RawByteCompare(value.GetData(), m_Value.GetData(), uiNumInstances * sizeof(plInt32)) == 0;
+    }
+  };
+} // namespace
+
+/// \brief Measures how long plExpressionVM takes to execute expressions like the ones ProcGen graphs produce, with every SIMD width that the CPU supports
+/// and with the native code from plExpressionNativeCode.
+///
+/// The outputs of the wider variants and of the native code are compared with the ones of the 4 wide variant, they have to be bit-identical.
+/// The native code of the expressions is generated with -generate and compiled into this tool from the NativeCode folder.
+class plExpressionVMBench : public plApplication
+{
+public:
+  using SUPER = plApplication;
+
+  plExpressionVMBench()
+    : plApplication("ExpressionVMBench")
+  {
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    plGlobalLog::AddLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::AddLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    plGlobalLog::RemoveLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::RemoveLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  plResult Compile(const plBenchExpression& expression, plExpressionByteCode& out_byteCode)
+  {
+    plExpressionParser parser;
+    parser.RegisterFunction(plDefaultExpressionFunctions::s_RandomFunc.m_Desc);
+    parser.RegisterFunction(plDefaultExpressionFunctions::s_PerlinNoiseFunc.m_Desc);
+
+    plExpressionAST ast;
+    PL_SUCCEED_OR_RETURN(parser.Parse(expression.m_szCode, s_Inputs, s_Outputs, {}, ast));
+
+    plExpressionCompiler compiler;
+    return compiler.Compile(ast, out_byteCode);
+  }
+
+  /// \brief Returns the fastest of all runs.
+  plTime Measure(plBenchData& ref_data, const plExpressionByteCode& byteCode, plExpressionVM::SimdWidth::Enum width, plUInt32 uiNumInstances, plBitflags<plExpressionVM::Flags> flags)
+  {
+    const plUInt32 uiNumRuns = static_cast<plUInt32>(opt_Runs.GetOptionValue(plCommandLineOption::LogMode::Never));
+
+    plExpressionVM vm;
+    vm.SetMaxSimdWidth(width);
+
+    plTime fastest = plTime::MakeFromHours(1);
+
+    for (plUInt32 uiRun = 0; uiRun < uiNumRuns; ++uiRun)
+    {
+      const plTime start = plTime::Now();
+      ref_data.Execute(vm, byteCode, uiNumInstances, flags).AssertSuccess();
+      fastest = plMath::Min(fastest, plTime::Now() - start);
+    }
+
+    return fastest;
+  }
+
+  plResult GenerateNativeCode(const plBenchExpression& expression, const plExpressionByteCode& byteCode, plStringView sFolder)
+  {
+    plStringBuilder sFunctionName;
+    sFunctionName.SetFormat("ExpressionVMBench_{}", expression.m_szName);
+
+    plStringBuilder sCode;
+    PL_SUCCEED_OR_RETURN(plExpressionNativeCode::GenerateCpp(byteCode, sFunctionName, sCode));
+
+    plStringBuilder sFileName;
+    sFileName.SetFormat("{}/{}.cpp", sFolder, expression.m_szName);
+
+    plOSFile file;
+    PL_SUCCEED_OR_RETURN(file.Open(sFileName, plFileOpenMode::Write));
+    PL_SUCCEED_OR_RETURN(file.Write(sCode.GetData(), sCode.GetElementCount()));
+
+    plLog::Info("Native code of '{}' was written to: {}", expression.m_szName, sFileName);
+    return PL_SUCCESS;
+  }
+
+  /// \brief Compares the native code with the 4 wide VM for all instance counts around the native block size, where the remainder handling differs.
+  void CheckNativeCode(const plBenchExpression& expression, plBenchData& ref_data, const plExpressionByteCode& byteCode)
+  {
+    plExpressionVM vm;
+    vm.SetMaxSimdWidth(plExpressionVM::SimdWidth::Simd4);
+
+    plDynamicArray<float> referenceDensity;
+    plDynamicArray<plInt32> referenceValue;
+
+    for (plUInt32 uiNumInstances = 1; uiNumInstances <= plExpressionNativeCode::BlockSize * 3 + 1; ++uiNumInstances)
+    {
+      ref_data.Execute(vm, byteCode, uiNumInstances, plExpressionVM::Flags::DisableNativeCode).AssertSuccess();
+      referenceDensity = ref_data.m_Density;
+      referenceValue = ref_data.m_Value;
+
+      ref_data.Execute(vm, byteCode, uiNumInstances, plExpressionVM::Flags::BestPerformance).AssertSuccess();
+
+      if (!ref_data.HasSameOutputs(referenceDensity, referenceValue, uiNumInstances))
+      {
+        plLog::Error("'{}' with {} instances: the native code results differ from the VM results", expression.m_szName, uiNumInstances);
+        SetReturnCode(1);
+      }
+    }
+  }
+
+  virtual Execution Run() override
+  {
+    {
+      plStringBuilder cmdHelp;
+      if (plCommandLineOption::LogAvailableOptionsToBuffer(cmdHelp, plCommandLineOption::LogAvailableModes::IfHelpRequested, "_ExpressionVMBench"))
+      {
+        plLog::Print(cmdHelp);
+        return plApplication::Execution::Quit;
+      }
+    }
+
+    const plString sGenerateFolder = opt_Generate.GetOptionValue(plCommandLineOption::LogMode::Always);
+    opt_Runs.GetOptionValue(plCommandLineOption::LogMode::Always);
+    const plUInt32 uiMaxInstances = static_cast<plUInt32>(opt_MaxInstances.GetOptionValue(plCommandLineOption::LogMode::Always));
+
+    const plUInt32 uiSupportedWidth = plExpressionVM::GetSupportedSimdWidth();
+    plLog::Info("The CPU supports {} wide expression VM instructions", uiSupportedWidth);
+
+    plBenchData data;
+    data.Initialize(uiMaxInstances);
+
+    plDynamicArray<float> referenceDensity;
+    plDynamicArray<plInt32> referenceValue;
+
+    for (const plBenchExpression& expression : s_Expressions)
+    {
+      plExpressionByteCode byteCode;
+      if (Compile(expression, byteCode).Failed())
+      {
+        plLog::Error("Failed to compile the '{}' expression", expression.m_szName);
+        SetReturnCode(1);
+        continue;
+      }
+
+      if (!sGenerateFolder.IsEmpty())
+      {
+        if (GenerateNativeCode(expression, byteCode, sGenerateFolder).Failed())
+        {
+          plLog::Error("Failed to write the native code of the '{}' expression", expression.m_szName);
+          SetReturnCode(1);
+        }
+
+        continue;
+      }
+
+      const bool bNativeCode = plExpressionNativeCode::FindFunction(byteCode.GetHash()) != nullptr;
+      if (bNativeCode)
+      {
+        CheckNativeCode(expression, data, byteCode);
+      }
+      else
+      {
+        plLog::Warning("No native code is registered for '{}', it is out of date. Update it with -generate.", expression.m_szName);
+      }
+
+      for (plUInt32 uiNumInstances = 64; uiNumInstances <= uiMaxInstances; uiNumInstances *= 16)
+      {
+        plStringBuilder sTimings, sTiming;
+
+        for (plUInt32 uiWidth = plExpressionVM::SimdWidth::Simd4; uiWidth <= uiSupportedWidth; uiWidth *= 2)
+        {
+          const plTime duration = Measure(data, byteCode, static_cast<plExpressionVM::SimdWidth::Enum>(uiWidth), uiNumInstances, plExpressionVM::Flags::DisableNativeCode);
+          sTiming.SetFormat("{} wide {} us", uiWidth, plArgF(duration.GetMicroseconds(), 1));
+          sTimings.AppendWithSeparator(", ", sTiming);
+
+          if (uiWidth == plExpressionVM::SimdWidth::Simd4)
+          {
+            referenceDensity = data.m_Density;
+            referenceValue = data.m_Value;
+          }
+          else if (!data.HasSameOutputs(referenceDensity, referenceValue, uiNumInstances))
+          {
+            plLog::Error("'{}' with {} instances: the {} wide results differ from the 4 wide results", expression.m_szName, uiNumInstances, uiWidth);
+            SetReturnCode(1);
+          }
+        }
+
+        if (bNativeCode)
+        {
+          const plTime duration = Measure(data, byteCode, plExpressionVM::SimdWidth::Simd4, uiNumInstances, plExpressionVM::Flags::BestPerformance);
+          sTiming.SetFormat("native {} us", plArgF(duration.GetMicroseconds(), 1));
+          sTimings.AppendWithSeparator(", ", sTiming);
+
+          if (!data.HasSameOutputs(referenceDensity, referenceValue, uiNumInstances))
+          {
+            plLog::Error("'{}' with {} instances: the native code results differ from the 4 wide results", expression.m_szName, uiNumInstances);
+            SetReturnCode(1);
+          }
+        }
+
+        plLog::Info("{}, {} instances: {}", expression.m_szName, uiNumInstances, sTimings);
+      }
+    }
+
+    return plApplication::Execution::Quit;
+  }
+};
+
+PL_CONSOLEAPP_ENTRY_POINT(plExpressionVMBench);
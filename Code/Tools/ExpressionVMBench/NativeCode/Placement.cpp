@@ -0,0 +1,289 @@
+// Generated by plExpressionNativeCode::GenerateCpp(). Do not edit, regenerate it from the byte code instead.
+
+// Inputs:
+//  0: px(Float)
+//  1: py(Float)
+//  2: pz(Float)
+//  3: nz(Float)
+//  4: index(Int)
+// Outputs:
+//  0: density(Float)
+//  1: value(Int)
+// Functions:
+//  0: Float PerlinNoise_FFFI(Float, Float, Float, Int)
+// Temp Registers: 6
+// Instructions: 41
+// LoadI    r0 i4(index)
+// MulI_RC  r1 r0 0x00000003(0.000000)
+// AddI_RC  r1 r1 0x00000007(0.000000)
+// StoreI   o1(value) r1
+// MovX_C   r1 0xbf19999a(-0.600000)
+// LoadF    r2 i2(pz)
+// MulF_RC  r2 r2 0x3c23d70a(0.010000)
+// SubF_RC  r2 r2 0x3f4ccccd(0.800000)
+// DivF_RR  r1 r1 r2
+// MinF_RC  r1 r1 0x3f800000(1.000000)
+// MaxF_RC  r1 r1 0x00000000(0.000000)
+// MulF_RR  r4 r1 r1
+// MovX_C   r5 0x40400000(3.000000)
+// MulF_RC  r1 r1 0x40000000(2.000000)
+// SubF_RR  r5 r5 r1
+// MulF_RR  r4 r4 r5
+// MovX_C   r2 0x3f800000(1.000000)
+// LoadF    r5 i3(nz)
+// MinF_RC  r5 r5 0x3f800000(1.000000)
+// MaxF_RC  r5 r5 0x00000000(0.000000)
+// SubF_RR  r5 r2 r5
+// MulF_RC  r5 r5 0x40000000(2.000000)
+// MinF_RC  r5 r5 0x3f800000(1.000000)
+// MaxF_RC  r5 r5 0x00000000(0.000000)
+// SubF_RR  r5 r2 r5
+// MulF_RR  r4 r4 r5
+// MulF_RC  r4 r4 0x3fc00000(1.500000)
+// SubF_RC  r4 r4 0x3e800000(0.250000)
+// MinF_RC  r2 r4 0x3f800000(1.000000)
+// MaxF_RC  r2 r2 0x00000000(0.000000)
+// LoadF    r4 i0(px)
+// MulF_RC  r4 r4 0x3d4ccccd(0.050000)
+// LoadF    r5 i1(py)
+// MulF_RC  r5 r5 0x3d4ccccd(0.050000)
+// MovX_C   r3 0x00000000(0.000000)
+// MovX_C   r0 0x00000003(0.000000)
+// Call     0 r r4 r5 r3 r0
+// MulF_RC  r0 r0 0x3f000000(0.500000)
+// AddF_RC  r0 r0 0x3f000000(0.500000)
+// MulF_RR  r2 r2 r0
+// StoreF   o0(density) r2
+
+#include <Foundation/CodeUtils/Expression/ExpressionNativeCode.h>
+#include <Foundation/SimdMath/SimdMath.h>
+
+namespace
+{
+  void ExpressionVMBench_Placement(const plExpressionNativeContext& context)
+  {
+    plExpression::Register* r0 = context.m_pTempRegisters + 0 * plExpressionNativeCode::BlockSize;
+    plExpression::Register* r1 = context.m_pTempRegisters + 1 * plExpressionNativeCode::BlockSize;
+    plExpression::Register* r2 = context.m_pTempRegisters + 2 * plExpressionNativeCode::BlockSize;
+    plExpression::Register* r3 = context.m_pTempRegisters + 3 * plExpressionNativeCode::BlockSize;
+    plExpression::Register* r4 = context.m_pTempRegisters + 4 * plExpressionNativeCode::BlockSize;
+    plExpression::Register* r5 = context.m_pTempRegisters + 5 * plExpressionNativeCode::BlockSize;
+    const plUInt32 c0Raw = 0x00000003u;
+    const plExpression::Register c0 = plExpressionNativeCode::MakeConstant(c0Raw);
+    const plUInt32 c1Raw = 0x00000007u;
+    const plExpression::Register c1 = plExpressionNativeCode::MakeConstant(c1Raw);
+    const plUInt32 c2Raw = 0xbf19999au;
+    const plExpression::Register c2 = plExpressionNativeCode::MakeConstant(c2Raw);
+    const plUInt32 c3Raw = 0x3c23d70au;
+    const plExpression::Register c3 = plExpressionNativeCode::MakeConstant(c3Raw);
+    const plUInt32 c4Raw = 0x3f4ccccdu;
+    const plExpression::Register c4 = plExpressionNativeCode::MakeConstant(c4Raw);
+    const plUInt32 c5Raw = 0x3f800000u;
+    const plExpression::Register c5 = plExpressionNativeCode::MakeConstant(c5Raw);
+    const plUInt32 c6Raw = 0x00000000u;
+    const plExpression::Register c6 = plExpressionNativeCode::MakeConstant(c6Raw);
+    const plUInt32 c7Raw = 0x40400000u;
+    const plExpression::Register c7 = plExpressionNativeCode::MakeConstant(c7Raw);
+    const plUInt32 c8Raw = 0x40000000u;
+    const plExpression::Register c8 = plExpressionNativeCode::MakeConstant(c8Raw);
+    const plUInt32 c9Raw = 0x3f800000u;
+    const plExpression::Register c9 = plExpressionNativeCode::MakeConstant(c9Raw);
+    const plUInt32 c10Raw = 0x3f800000u;
+    const plExpression::Register c10 = plExpressionNativeCode::MakeConstant(c10Raw);
+    const plUInt32 c11Raw = 0x00000000u;
+    const plExpression::Register c11 = plExpressionNativeCode::MakeConstant(c11Raw);
+    const plUInt32 c12Raw = 0x40000000u;
+    const plExpression::Register c12 = plExpressionNativeCode::MakeConstant(c12Raw);
+    const plUInt32 c13Raw = 0x3f800000u;
+    const plExpression::Register c13 = plExpressionNativeCode::MakeConstant(c13Raw);
+    const plUInt32 c14Raw = 0x00000000u;
+    const plExpression::Register c14 = plExpressionNativeCode::MakeConstant(c14Raw);
+    const plUInt32 c15Raw = 0x3fc00000u;
+    const plExpression::Register c15 = plExpressionNativeCode::MakeConstant(c15Raw);
+    const plUInt32 c16Raw = 0x3e800000u;
+    const plExpression::Register c16 = plExpressionNativeCode::MakeConstant(c16Raw);
+    const plUInt32 c17Raw = 0x3f800000u;
+    const plExpression::Register c17 = plExpressionNativeCode::MakeConstant(c17Raw);
+    const plUInt32 c18Raw = 0x00000000u;
+    const plExpression::Register c18 = plExpressionNativeCode::MakeConstant(c18Raw);
+    const plUInt32 c19Raw = 0x3d4ccccdu;
+    const plExpression::Register c19 = plExpressionNativeCode::MakeConstant(c19Raw);
+    const plUInt32 c20Raw = 0x3d4ccccdu;
+    const plExpression::Register c20 = plExpressionNativeCode::MakeConstant(c20Raw);
+    const plUInt32 c21Raw = 0x00000000u;
+    const plExpression::Register c21 = plExpressionNativeCode::MakeConstant(c21Raw);
+    const plUInt32 c22Raw = 0x00000003u;
+    const plExpression::Register c22 = plExpressionNativeCode::MakeConstant(c22Raw);
+    const plUInt32 c23Raw = 0x3f000000u;
+    const plExpression::Register c23 = plExpressionNativeCode::MakeConstant(c23Raw);
+    const plUInt32 c24Raw = 0x3f000000u;
+    const plExpression::Register c24 = plExpressionNativeCode::MakeConstant(c24Raw);
+
+    for (plUInt32 uiFirstInstance = 0; uiFirstInstance < context.m_uiNumInstances; uiFirstInstance += plExpressionNativeCode::BlockSize * 4)
+    {
+      const plUInt32 uiNumInstances = plMath::Min(context.m_uiNumInstances - uiFirstInstance, plExpressionNativeCode::BlockSize * 4);
+      const plUInt32 uiNumRegisters = (uiNumInstances + 3) / 4;
+
+      // LoadI
+      plExpressionNativeCode::LoadI(context, 4, uiFirstInstance, uiNumInstances, r0);
+
+      // MulI_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].i = r0[i].i.CompMul(c0.i);
+
+      // AddI_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].i = r1[i].i + c1.i;
+
+      // StoreI
+      plExpressionNativeCode::StoreI(context, 1, uiFirstInstance, uiNumInstances, r1);
+
+      // MovX_C
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].i = c2.i;
+
+      // LoadF
+      plExpressionNativeCode::LoadF(context, 2, uiFirstInstance, uiNumInstances, r2);
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r2[i].f = r2[i].f.CompMul(c3.f);
+
+      // SubF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r2[i].f = r2[i].f - c4.f;
+
+      // DivF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r1[i].f.CompDiv(r2[i].f);
+
+      // MinF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r1[i].f.CompMin(c5.f);
+
+      // MaxF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r1[i].f.CompMax(c6.f);
+
+      // MulF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r4[i].f = r1[i].f.CompMul(r1[i].f);
+
+      // MovX_C
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].i = c7.i;
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r1[i].f.CompMul(c8.f);
+
+      // SubF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r5[i].f - r1[i].f;
+
+      // MulF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r4[i].f = r4[i].f.CompMul(r5[i].f);
+
+      // MovX_C
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r2[i].i = c9.i;
+
+      // LoadF
+      plExpressionNativeCode::LoadF(context, 3, uiFirstInstance, uiNumInstances, r5);
+
+      // MinF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r5[i].f.CompMin(c10.f);
+
+      // MaxF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r5[i].f.CompMax(c11.f);
+
+      // SubF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r2[i].f - r5[i].f;
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r5[i].f.CompMul(c12.f);
+
+      // MinF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r5[i].f.CompMin(c13.f);
+
+      // MaxF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r5[i].f.CompMax(c14.f);
+
+      // SubF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r2[i].f - r5[i].f;
+
+      // MulF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r4[i].f = r4[i].f.CompMul(r5[i].f);
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r4[i].f = r4[i].f.CompMul(c15.f);
+
+      // SubF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r4[i].f = r4[i].f - c16.f;
+
+      // MinF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r2[i].f = r4[i].f.CompMin(c17.f);
+
+      // MaxF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r2[i].f = r2[i].f.CompMax(c18.f);
+
+      // LoadF
+      plExpressionNativeCode::LoadF(context, 0, uiFirstInstance, uiNumInstances, r4);
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r4[i].f = r4[i].f.CompMul(c19.f);
+
+      // LoadF
+      plExpressionNativeCode::LoadF(context, 1, uiFirstInstance, uiNumInstances, r5);
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r5[i].f.CompMul(c20.f);
+
+      // MovX_C
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r3[i].i = c21.i;
+
+      // MovX_C
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r0[i].i = c22.i;
+
+      // Call
+      {
+        const plExpression::Register* args[] = { r4, r5, r3, r0 };
+        plExpressionNativeCode::Call(context, 0, plMakeArrayPtr(args), uiNumRegisters, r0);
+      }
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r0[i].f = r0[i].f.CompMul(c23.f);
+
+      // AddF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r0[i].f = r0[i].f + c24.f;
+
+      // MulF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r2[i].f = r2[i].f.CompMul(r0[i].f);
+
+      // StoreF
+      plExpressionNativeCode::StoreF(context, 0, uiFirstInstance, uiNumInstances, r2);
+    }
+  }
+
+  static plExpressionNativeCode s_ExpressionVMBench_Placement(0x889dec3ebc24a67dull, &ExpressionVMBench_Placement);
+} // namespace
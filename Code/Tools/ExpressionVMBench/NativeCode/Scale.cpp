@@ -0,0 +1,186 @@
+// Generated by plExpressionNativeCode::GenerateCpp(). Do not edit, regenerate it from the byte code instead.
+
+// Inputs:
+//  0: px(Float)
+//  1: py(Float)
+//  2: pz(Float)
+//  3: nz(Float)
+//  4: index(Int)
+// Outputs:
+//  0: density(Float)
+//  1: value(Int)
+// Functions:
+//  0: Float Random_II(Int, Int)
+// Temp Registers: 3
+// Instructions: 26
+// LoadI    r0 i4(index)
+// ShlI_RC  r1 r0 0x00000003(0.000000)
+// ShrI_RC  r1 r1 0x00000001(0.000000)
+// AndI_RC  r2 r0 0x00000005(0.000000)
+// OrI_RR   r1 r1 r2
+// StoreI   o1(value) r1
+// Call     0 r r0
+// MulF_RC  r0 r0 0x3eccccce(0.400000)
+// AddF_RC  r0 r0 0x3f4ccccd(0.800000)
+// LoadF    r1 i2(pz)
+// MulF_RC  r1 r1 0x3dcccccd(0.100000)
+// FloorF_R r1 r1
+// MulF_RC  r1 r1 0x3d4ccccd(0.050000)
+// MinF_RC  r1 r1 0x3f800000(1.000000)
+// MaxF_RC  r1 r1 0x3dcccccd(0.100000)
+// MulF_RR  r0 r0 r1
+// LoadF    r1 i0(px)
+// MulF_RC  r1 r1 0x3ebd70a4(0.370000)
+// LoadF    r2 i1(py)
+// MulF_RC  r2 r2 0x3de147ae(0.110000)
+// AddF_RR  r1 r1 r2
+// TruncF_R r2 r1
+// SubF_RR  r1 r1 r2
+// MulF_RC  r1 r1 0x3dcccccd(0.100000)
+// AddF_RR  r0 r0 r1
+// StoreF   o0(density) r0
+
+#include <Foundation/CodeUtils/Expression/ExpressionNativeCode.h>
+#include <Foundation/SimdMath/SimdMath.h>
+
+namespace
+{
+  void ExpressionVMBench_Scale(const plExpressionNativeContext& context)
+  {
+    plExpression::Register* r0 = context.m_pTempRegisters + 0 * plExpressionNativeCode::BlockSize;
+    plExpression::Register* r1 = context.m_pTempRegisters + 1 * plExpressionNativeCode::BlockSize;
+    plExpression::Register* r2 = context.m_pTempRegisters + 2 * plExpressionNativeCode::BlockSize;
+    const plUInt32 c0Raw = 0x00000003u;
+    const plExpression::Register c0 = plExpressionNativeCode::MakeConstant(c0Raw);
+    const plUInt32 c1Raw = 0x00000001u;
+    const plExpression::Register c1 = plExpressionNativeCode::MakeConstant(c1Raw);
+    const plUInt32 c2Raw = 0x00000005u;
+    const plExpression::Register c2 = plExpressionNativeCode::MakeConstant(c2Raw);
+    const plUInt32 c3Raw = 0x3eccccceu;
+    const plExpression::Register c3 = plExpressionNativeCode::MakeConstant(c3Raw);
+    const plUInt32 c4Raw = 0x3f4ccccdu;
+    const plExpression::Register c4 = plExpressionNativeCode::MakeConstant(c4Raw);
+    const plUInt32 c5Raw = 0x3dcccccdu;
+    const plExpression::Register c5 = plExpressionNativeCode::MakeConstant(c5Raw);
+    const plUInt32 c6Raw = 0x3d4ccccdu;
+    const plExpression::Register c6 = plExpressionNativeCode::MakeConstant(c6Raw);
+    const plUInt32 c7Raw = 0x3f800000u;
+    const plExpression::Register c7 = plExpressionNativeCode::MakeConstant(c7Raw);
+    const plUInt32 c8Raw = 0x3dcccccdu;
+    const plExpression::Register c8 = plExpressionNativeCode::MakeConstant(c8Raw);
+    const plUInt32 c9Raw = 0x3ebd70a4u;
+    const plExpression::Register c9 = plExpressionNativeCode::MakeConstant(c9Raw);
+    const plUInt32 c10Raw = 0x3de147aeu;
+    const plExpression::Register c10 = plExpressionNativeCode::MakeConstant(c10Raw);
+    const plUInt32 c11Raw = 0x3dcccccdu;
+    const plExpression::Register c11 = plExpressionNativeCode::MakeConstant(c11Raw);
+
+    for (plUInt32 uiFirstInstance = 0; uiFirstInstance < context.m_uiNumInstances; uiFirstInstance += plExpressionNativeCode::BlockSize * 4)
+    {
+      const plUInt32 uiNumInstances = plMath::Min(context.m_uiNumInstances - uiFirstInstance, plExpressionNativeCode::BlockSize * 4);
+      const plUInt32 uiNumRegisters = (uiNumInstances + 3) / 4;
+
+      // LoadI
+      plExpressionNativeCode::LoadI(context, 4, uiFirstInstance, uiNumInstances, r0);
+
+      // ShlI_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].i = r0[i].i << c0Raw;
+
+      // ShrI_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].i = r1[i].i >> c1Raw;
+
+      // AndI_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r2[i].i = r0[i].i & c2.i;
+
+      // OrI_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].i = r1[i].i | r2[i].i;
+
+      // StoreI
+      plExpressionNativeCode::StoreI(context, 1, uiFirstInstance, uiNumInstances, r1);
+
+      // Call
+      {
+        const plExpression::Register* args[] = { r0 };
+        plExpressionNativeCode::Call(context, 0, plMakeArrayPtr(args), uiNumRegisters, r0);
+      }
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r0[i].f = r0[i].f.CompMul(c3.f);
+
+      // AddF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r0[i].f = r0[i].f + c4.f;
+
+      // LoadF
+      plExpressionNativeCode::LoadF(context, 2, uiFirstInstance, uiNumInstances, r1);
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r1[i].f.CompMul(c5.f);
+
+      // FloorF_R
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r1[i].f.Floor();
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r1[i].f.CompMul(c6.f);
+
+      // MinF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r1[i].f.CompMin(c7.f);
+
+      // MaxF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r1[i].f.CompMax(c8.f);
+
+      // MulF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r0[i].f = r0[i].f.CompMul(r1[i].f);
+
+      // LoadF
+      plExpressionNativeCode::LoadF(context, 0, uiFirstInstance, uiNumInstances, r1);
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r1[i].f.CompMul(c9.f);
+
+      // LoadF
+      plExpressionNativeCode::LoadF(context, 1, uiFirstInstance, uiNumInstances, r2);
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r2[i].f = r2[i].f.CompMul(c10.f);
+
+      // AddF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r1[i].f + r2[i].f;
+
+      // TruncF_R
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r2[i].f = r1[i].f.Trunc();
+
+      // SubF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r1[i].f - r2[i].f;
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r1[i].f.CompMul(c11.f);
+
+      // AddF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r0[i].f = r0[i].f + r1[i].f;
+
+      // StoreF
+      plExpressionNativeCode::StoreF(context, 0, uiFirstInstance, uiNumInstances, r0);
+    }
+  }
+
+  static plExpressionNativeCode s_ExpressionVMBench_Scale(0x2bb21c0d2d891b50ull, &ExpressionVMBench_Scale);
+} // namespace
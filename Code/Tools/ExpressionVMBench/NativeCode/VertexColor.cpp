@@ -0,0 +1,249 @@
+// Generated by plExpressionNativeCode::GenerateCpp(). Do not edit, regenerate it from the byte code instead.
+
+// Inputs:
+//  0: px(Float)
+//  1: py(Float)
+//  2: pz(Float)
+//  3: nz(Float)
+//  4: index(Int)
+// Outputs:
+//  0: density(Float)
+//  1: value(Int)
+// Functions:
+// Temp Registers: 7
+// Instructions: 38
+// LoadF    r0 i3(nz)
+// MinF_RC  r0 r0 0x3f800000(1.000000)
+// MaxF_RC  r1 r0 0x00000000(0.000000)
+// MulF_RC  r1 r1 0x437f0000(255.000000)
+// FToI_R   r1 r1
+// StoreI   o1(value) r1
+// LoadF    r1 i0(px)
+// MulF_RR  r2 r1 r1
+// LoadF    r3 i1(py)
+// MulF_RR  r4 r3 r3
+// AddF_RR  r2 r2 r4
+// LoadF    r4 i2(pz)
+// MulF_RR  r5 r4 r4
+// AddF_RR  r2 r2 r5
+// SqrtF_R  r2 r2
+// DivF_RR  r5 r1 r2
+// MulF_RC  r5 r5 0x3e99999a(0.300000)
+// DivF_RR  r6 r3 r2
+// MulF_RC  r6 r6 0x3f000000(0.500000)
+// AddF_RR  r5 r5 r6
+// DivF_RR  r4 r4 r2
+// MulF_RC  r4 r4 0x3f4ccccd(0.800000)
+// AddF_RR  r5 r5 r4
+// MulF_RC  r5 r5 0x3f000000(0.500000)
+// AddF_RC  r5 r5 0x3f000000(0.500000)
+// MinF_RC  r5 r5 0x3f800000(1.000000)
+// MaxF_RC  r5 r5 0x00000000(0.000000)
+// MovX_C   r0 0x00000000(0.000000)
+// SubF_RR  r0 r0 r2
+// MulF_RC  r0 r0 0x3c23d70a(0.010000)
+// ExpF_R   r0 r0
+// MulF_RR  r5 r5 r0
+// SinF_R   r1 r1
+// CosF_R   r3 r3
+// MulF_RR  r1 r1 r3
+// MulF_RC  r1 r1 0x3dcccccd(0.100000)
+// AddF_RR  r5 r5 r1
+// StoreF   o0(density) r5
+
+#include <Foundation/CodeUtils/Expression/ExpressionNativeCode.h>
+#include <Foundation/SimdMath/SimdMath.h>
+
+namespace
+{
+  void ExpressionVMBench_VertexColor(const plExpressionNativeContext& context)
+  {
+    plExpression::Register* r0 = context.m_pTempRegisters + 0 * plExpressionNativeCode::BlockSize;
+    plExpression::Register* r1 = context.m_pTempRegisters + 1 * plExpressionNativeCode::BlockSize;
+    plExpression::Register* r2 = context.m_pTempRegisters + 2 * plExpressionNativeCode::BlockSize;
+    plExpression::Register* r3 = context.m_pTempRegisters + 3 * plExpressionNativeCode::BlockSize;
+    plExpression::Register* r4 = context.m_pTempRegisters + 4 * plExpressionNativeCode::BlockSize;
+    plExpression::Register* r5 = context.m_pTempRegisters + 5 * plExpressionNativeCode::BlockSize;
+    plExpression::Register* r6 = context.m_pTempRegisters + 6 * plExpressionNativeCode::BlockSize;
+    const plUInt32 c0Raw = 0x3f800000u;
+    const plExpression::Register c0 = plExpressionNativeCode::MakeConstant(c0Raw);
+    const plUInt32 c1Raw = 0x00000000u;
+    const plExpression::Register c1 = plExpressionNativeCode::MakeConstant(c1Raw);
+    const plUInt32 c2Raw = 0x437f0000u;
+    const plExpression::Register c2 = plExpressionNativeCode::MakeConstant(c2Raw);
+    const plUInt32 c3Raw = 0x3e99999au;
+    const plExpression::Register c3 = plExpressionNativeCode::MakeConstant(c3Raw);
+    const plUInt32 c4Raw = 0x3f000000u;
+    const plExpression::Register c4 = plExpressionNativeCode::MakeConstant(c4Raw);
+    const plUInt32 c5Raw = 0x3f4ccccdu;
+    const plExpression::Register c5 = plExpressionNativeCode::MakeConstant(c5Raw);
+    const plUInt32 c6Raw = 0x3f000000u;
+    const plExpression::Register c6 = plExpressionNativeCode::MakeConstant(c6Raw);
+    const plUInt32 c7Raw = 0x3f000000u;
+    const plExpression::Register c7 = plExpressionNativeCode::MakeConstant(c7Raw);
+    const plUInt32 c8Raw = 0x3f800000u;
+    const plExpression::Register c8 = plExpressionNativeCode::MakeConstant(c8Raw);
+    const plUInt32 c9Raw = 0x00000000u;
+    const plExpression::Register c9 = plExpressionNativeCode::MakeConstant(c9Raw);
+    const plUInt32 c10Raw = 0x00000000u;
+    const plExpression::Register c10 = plExpressionNativeCode::MakeConstant(c10Raw);
+    const plUInt32 c11Raw = 0x3c23d70au;
+    const plExpression::Register c11 = plExpressionNativeCode::MakeConstant(c11Raw);
+    const plUInt32 c12Raw = 0x3dcccccdu;
+    const plExpression::Register c12 = plExpressionNativeCode::MakeConstant(c12Raw);
+
+    for (plUInt32 uiFirstInstance = 0; uiFirstInstance < context.m_uiNumInstances; uiFirstInstance += plExpressionNativeCode::BlockSize * 4)
+    {
+      const plUInt32 uiNumInstances = plMath::Min(context.m_uiNumInstances - uiFirstInstance, plExpressionNativeCode::BlockSize * 4);
+      const plUInt32 uiNumRegisters = (uiNumInstances + 3) / 4;
+
+      // LoadF
+      plExpressionNativeCode::LoadF(context, 3, uiFirstInstance, uiNumInstances, r0);
+
+      // MinF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r0[i].f = r0[i].f.CompMin(c0.f);
+
+      // MaxF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r0[i].f.CompMax(c1.f);
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r1[i].f.CompMul(c2.f);
+
+      // FToI_R
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].i = plSimdVec4i::Truncate(r1[i].f);
+
+      // StoreI
+      plExpressionNativeCode::StoreI(context, 1, uiFirstInstance, uiNumInstances, r1);
+
+      // LoadF
+      plExpressionNativeCode::LoadF(context, 0, uiFirstInstance, uiNumInstances, r1);
+
+      // MulF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r2[i].f = r1[i].f.CompMul(r1[i].f);
+
+      // LoadF
+      plExpressionNativeCode::LoadF(context, 1, uiFirstInstance, uiNumInstances, r3);
+
+      // MulF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r4[i].f = r3[i].f.CompMul(r3[i].f);
+
+      // AddF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r2[i].f = r2[i].f + r4[i].f;
+
+      // LoadF
+      plExpressionNativeCode::LoadF(context, 2, uiFirstInstance, uiNumInstances, r4);
+
+      // MulF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r4[i].f.CompMul(r4[i].f);
+
+      // AddF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r2[i].f = r2[i].f + r5[i].f;
+
+      // SqrtF_R
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r2[i].f = r2[i].f.GetSqrt();
+
+      // DivF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r1[i].f.CompDiv(r2[i].f);
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r5[i].f.CompMul(c3.f);
+
+      // DivF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r6[i].f = r3[i].f.CompDiv(r2[i].f);
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r6[i].f = r6[i].f.CompMul(c4.f);
+
+      // AddF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r5[i].f + r6[i].f;
+
+      // DivF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r4[i].f = r4[i].f.CompDiv(r2[i].f);
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r4[i].f = r4[i].f.CompMul(c5.f);
+
+      // AddF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r5[i].f + r4[i].f;
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r5[i].f.CompMul(c6.f);
+
+      // AddF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r5[i].f + c7.f;
+
+      // MinF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r5[i].f.CompMin(c8.f);
+
+      // MaxF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r5[i].f.CompMax(c9.f);
+
+      // MovX_C
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r0[i].i = c10.i;
+
+      // SubF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r0[i].f = r0[i].f - r2[i].f;
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r0[i].f = r0[i].f.CompMul(c11.f);
+
+      // ExpF_R
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r0[i].f = plSimdMath::Exp(r0[i].f);
+
+      // MulF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r5[i].f.CompMul(r0[i].f);
+
+      // SinF_R
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = plSimdMath::Sin(r1[i].f);
+
+      // CosF_R
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r3[i].f = plSimdMath::Cos(r3[i].f);
+
+      // MulF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r1[i].f.CompMul(r3[i].f);
+
+      // MulF_RC
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r1[i].f = r1[i].f.CompMul(c12.f);
+
+      // AddF_RR
+      for (plUInt32 i = 0; i < uiNumRegisters; ++i)
+        r5[i].f = r5[i].f + r1[i].f;
+
+      // StoreF
+      plExpressionNativeCode::StoreF(context, 0, uiFirstInstance, uiNumInstances, r5);
+    }
+  }
+
+  static plExpressionNativeCode s_ExpressionVMBench_VertexColor(0x9dc6f1246d25b27cull, &ExpressionVMBench_VertexColor);
+} // namespace
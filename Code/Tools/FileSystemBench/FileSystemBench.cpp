@@ -0,0 +1,284 @@
+#include <Foundation/Application/Application.h>
+#include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Types/UniquePtr.h>
+#include <Foundation/Utilities/CommandLineOptions.h>
+
+plCommandLineOptionInt opt_DataDirs("_FileSystemBench", "-datadirs", "Number of mounted data directories.", 8, 1, 256);
+
+plCommandLineOptionInt opt_Files("_FileSystemBench", "-files", "Number of files per data directory.", 64, 1, 10000);
+
+plCommandLineOptionInt opt_MaxThreads("_FileSystemBench", "-threads", "The benchmark runs with 1, 2, 4, ... reader threads up to this number.", 4, 1, 128);
+
+plCommandLineOptionInt opt_Lookups("_FileSystemBench", "-lookups", "Number of lookups per thread.", 20000, 100, 100000000);
+
+namespace
+{
+  plAtomicInteger32 s_iStopWriter;
+
+  /// \brief Looks up existing and missing files, like resource loading does when it searches the mounted data directories.
+  class plReaderThread : public plThread
+  {
+  public:
+    plUInt32 m_uiNumDataDirs = 0;
+    plUInt32 m_uiNumFiles = 0;
+    plUInt32 m_uiNumLookups = 0;
+    plUInt32 m_uiSeed = 0;
+    plUInt32 m_uiNumErrors = 0;
+
+    plReaderThread()
+      : plThread("FileSystemBench")
+    {
+    }
+
+    virtual plUInt32 Run() override
+    {
+      plStringBuilder sFile, sAbsolutePath;
+      plUInt32 uiSeed = m_uiSeed;
+
+      for (plUInt32 i = 0; i < m_uiNumLookups; i += 3)
+      {
+        uiSeed = uiSeed * 1103515245u + 12345u;
+        const plUInt32 uiDataDir = (uiSeed >> 8) % m_uiNumDataDirs;
+        const plUInt32 uiFile = (uiSeed >> 16) % m_uiNumFiles;
+
+        sFile.SetFormat("File_{}_{}.txt", uiDataDir, uiFile);
+
+        if (!plFileSystem::ExistsFile(sFile))
+          ++m_uiNumErrors;
+
+        if (plFileSystem::ResolvePath(sFile, &sAbsolutePath, nullptr).Failed())
+          ++m_uiNumErrors;
+
+        sFile.SetFormat("Missing_{}.txt", uiFile);
+
+        if (plFileSystem::ExistsFile(sFile))
+          ++m_uiNumErrors;
+      }
+
+      return 0;
+    }
+  };
+
+  /// \brief Mounts and unmounts a data directory in a loop, like the editor and streaming do.
+  class plWriterThread : public plThread
+  {
+  public:
+    plStringBuilder m_sFolder;
+    plUInt32 m_uiNumChanges = 0;
+
+    plWriterThread()
+      : plThread("FileSystemBenchWriter")
+    {
+    }
+
+    virtual plUInt32 Run() override
+    {
+      while (s_iStopWriter == 0)
+      {
+        plFileSystem::AddDataDirectory(m_sFolder, "BenchWriter").IgnoreResult();
+        plFileSystem::RemoveDataDirectoryGroup("BenchWriter");
+        ++m_uiNumChanges;
+      }
+
+      return 0;
+    }
+  };
+} // namespace
+
+/// \brief Measures how many file lookups per second plFileSystem handles with an increasing number of threads.
+///
+/// Every measurement is done without and with plDataDirectory::FolderType::s_bCacheResolvedFiles, and once more while another thread
+/// keeps mounting and unmounting a data directory. The data directories and files are created in the temp folder and deleted afterwards.
+class plFileSystemBench : public plApplication
+{
+  plStringBuilder m_sRootFolder;
+
+public:
+  using SUPER = plApplication;
+
+  plFileSystemBench()
+    : plApplication("FileSystemBench")
+  {
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    plGlobalLog::AddLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::AddLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    plGlobalLog::RemoveLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::RemoveLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  plResult CreateFiles(plUInt32 uiNumDataDirs, plUInt32 uiNumFiles)
+  {
+    m_sRootFolder = plOSFile::GetTempDataFolder("FileSystemBench");
+
+    plStringBuilder sPath;
+    for (plUInt32 uiDataDir = 0; uiDataDir < uiNumDataDirs; ++uiDataDir)
+    {
+      sPath.SetFormat("{}/DataDir{}", m_sRootFolder, uiDataDir);
+      PL_SUCCEED_OR_RETURN(plOSFile::CreateDirectoryStructure(sPath));
+
+      for (plUInt32 uiFile = 0; uiFile < uiNumFiles; ++uiFile)
+      {
+        sPath.SetFormat("{}/DataDir{}/File_{}_{}.txt", m_sRootFolder, uiDataDir, uiDataDir, uiFile);
+
+        plOSFile file;
+        PL_SUCCEED_OR_RETURN(file.Open(sPath, plFileOpenMode::Write));
+        PL_SUCCEED_OR_RETURN(file.Write("x", 1));
+      }
+    }
+
+    sPath.SetFormat("{}/Empty", m_sRootFolder);
+    return plOSFile::CreateDirectoryStructure(sPath);
+  }
+
+  void MountDataDirectories(plUInt32 uiNumDataDirs)
+  {
+    plStringBuilder sPath;
+    for (plUInt32 uiDataDir = 0; uiDataDir < uiNumDataDirs; ++uiDataDir)
+    {
+      sPath.SetFormat("{}/DataDir{}", m_sRootFolder, uiDataDir);
+      plFileSystem::AddDataDirectory(sPath, "Bench").IgnoreResult();
+    }
+  }
+
+  /// \brief Returns the number of lookups per millisecond.
+  double Measure(plUInt32 uiNumThreads, bool bWithWriter, plUInt32& out_uiNumChanges)
+  {
+    const plUInt32 uiNumLookups = static_cast<plUInt32>(opt_Lookups.GetOptionValue(plCommandLineOption::LogMode::Never));
+
+    plDynamicArray<plUniquePtr<plReaderThread>> readers;
+    for (plUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      plUniquePtr<plReaderThread> pThread = PL_DEFAULT_NEW(plReaderThread);
+      pThread->m_uiNumDataDirs = static_cast<plUInt32>(opt_DataDirs.GetOptionValue(plCommandLineOption::LogMode::Never));
+      pThread->m_uiNumFiles = static_cast<plUInt32>(opt_Files.GetOptionValue(plCommandLineOption::LogMode::Never));
+      pThread->m_uiNumLookups = uiNumLookups;
+      pThread->m_uiSeed = i * 7919 + 1;
+      readers.PushBack(std::move(pThread));
+    }
+
+    plWriterThread writer;
+    writer.m_sFolder.SetFormat("{}/Empty", m_sRootFolder);
+    s_iStopWriter = 0;
+
+    if (bWithWriter)
+    {
+      writer.Start();
+    }
+
+    const plTime start = plTime::Now();
+
+    for (auto& pThread : readers)
+    {
+      pThread->Start();
+    }
+
+    for (auto& pThread : readers)
+    {
+      pThread->Join();
+    }
+
+    const plTime duration = plTime::Now() - start;
+
+    if (bWithWriter)
+    {
+      s_iStopWriter = 1;
+      writer.Join();
+    }
+
+    out_uiNumChanges = writer.m_uiNumChanges;
+
+    for (auto& pThread : readers)
+    {
+      if (pThread->m_uiNumErrors > 0)
+      {
+        plLog::Error("{} lookups returned the wrong result", pThread->m_uiNumErrors);
+        SetReturnCode(1);
+      }
+    }
+
+    return (static_cast<double>(uiNumLookups) * uiNumThreads) / duration.GetMilliseconds();
+  }
+
+  virtual Execution Run() override
+  {
+    {
+      plStringBuilder cmdHelp;
+      if (plCommandLineOption::LogAvailableOptionsToBuffer(cmdHelp, plCommandLineOption::LogAvailableModes::IfHelpRequested, "_FileSystemBench"))
+      {
+        plLog::Print(cmdHelp);
+        return plApplication::Execution::Quit;
+      }
+    }
+
+    const plUInt32 uiNumDataDirs = static_cast<plUInt32>(opt_DataDirs.GetOptionValue(plCommandLineOption::LogMode::Always));
+    const plUInt32 uiNumFiles = static_cast<plUInt32>(opt_Files.GetOptionValue(plCommandLineOption::LogMode::Always));
+    const plUInt32 uiMaxThreads = static_cast<plUInt32>(opt_MaxThreads.GetOptionValue(plCommandLineOption::LogMode::Always));
+    opt_Lookups.GetOptionValue(plCommandLineOption::LogMode::Always);
+
+    if (CreateFiles(uiNumDataDirs, uiNumFiles).Failed())
+    {
+      plLog::Error("Failed to create the test files in '{}'", m_sRootFolder);
+      SetReturnCode(1);
+      return plApplication::Execution::Quit;
+    }
+
+#if PL_ENABLED(PL_SUPPORTS_DIRECTORY_WATCHER)
+    const bool bCacheSupported = true;
+#else
+    const bool bCacheSupported = false;
+#endif
+
+    for (bool bCacheResolvedFiles : {false, true})
+    {
+      if (bCacheResolvedFiles && !bCacheSupported)
+        continue;
+
+#if PL_ENABLED(PL_SUPPORTS_DIRECTORY_WATCHER)
+      // only affects data directories that are mounted afterwards
+      plDataDirectory::FolderType::s_bCacheResolvedFiles = bCacheResolvedFiles;
+#endif
+
+      MountDataDirectories(uiNumDataDirs);
+
+      for (plUInt32 uiNumThreads = 1; uiNumThreads <= uiMaxThreads; uiNumThreads *= 2)
+      {
+        plUInt32 uiNumChanges = 0;
+        const double fLookups = Measure(uiNumThreads, false, uiNumChanges);
+        const double fLookupsWithWriter = Measure(uiNumThreads, true, uiNumChanges);
+
+        plLog::Info("{} threads{}: {} lookups/ms, {} lookups/ms while {} data directories were mounted and unmounted", uiNumThreads,
+          bCacheResolvedFiles ? ", cached" : "", plArgF(fLookups, 0), plArgF(fLookupsWithWriter, 0), uiNumChanges);
+      }
+
+      plFileSystem::RemoveDataDirectoryGroup("Bench");
+    }
+
+#if PL_ENABLED(PL_SUPPORTS_DIRECTORY_WATCHER)
+    plDataDirectory::FolderType::s_bCacheResolvedFiles = false;
+#endif
+
+    plOSFile::DeleteFolder(m_sRootFolder).IgnoreResult();
+
+    return plApplication::Execution::Quit;
+  }
+};
+
+PL_CONSOLEAPP_ENTRY_POINT(plFileSystemBench);
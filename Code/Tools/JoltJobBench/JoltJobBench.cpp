@@ -0,0 +1,299 @@
+#include <Foundation/Application/Application.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Utilities/CommandLineOptions.h>
+#include <Jolt.h>
+#include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Core/TempAllocator.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/PhysicsSettings.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <JoltPlugin/System/JoltJobSystem.h>
+#include <JoltPlugin/Utilities/JoltConversionUtils.h>
+#include <thread>
+
+plCommandLineOptionInt opt_Bodies("_JoltJobBench", "-bodies", "Number of dynamic boxes that are dropped onto the ground.", 2000, 10, 100000);
+
+plCommandLineOptionInt opt_Frames("_JoltJobBench", "-frames", "Number of simulated frames (60 Hz) per run.", 300, 1, 100000);
+
+plCommandLineOptionInt opt_Runs("_JoltJobBench", "-runs", "How often every measurement is repeated. The fastest run is reported.", 3, 1, 100);
+
+plCommandLineOptionInt opt_Threads("_JoltJobBench", "-threads", "Number of short task worker threads. -1 uses the default for this machine.", -1, -1, 128);
+
+plCommandLineOptionInt opt_OtherTasks("_JoltJobBench", "-othertasks", "Number of other tasks that run next to the physics update every frame, each busy for 100 microseconds.", 64, 1, 10000);
+
+namespace
+{
+  constexpr JPH::ObjectLayer s_StaticLayer = 0;
+  constexpr JPH::ObjectLayer s_DynamicLayer = 1;
+
+  class plBenchBroadPhaseLayers final : public JPH::BroadPhaseLayerInterface
+  {
+  public:
+    virtual JPH::uint GetNumBroadPhaseLayers() const override { return 2; }
+
+    virtual JPH::BroadPhaseLayer GetBroadPhaseLayer(JPH::ObjectLayer inLayer) const override { return JPH::BroadPhaseLayer(static_cast<JPH::uint8>(inLayer)); }
+
+#if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
+    virtual const char* GetBroadPhaseLayerName(JPH::BroadPhaseLayer inLayer) const override
+    {
+      return inLayer == JPH::BroadPhaseLayer(s_StaticLayer) ? "Static" : "Dynamic";
+    }
+#endif
+  };
+
+  class plBenchObjectVsBroadPhaseLayerFilter final : public JPH::ObjectVsBroadPhaseLayerFilter
+  {
+  public:
+    virtual bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::BroadPhaseLayer inLayer2) const override
+    {
+      return inLayer1 != s_StaticLayer || inLayer2 != JPH::BroadPhaseLayer(s_StaticLayer);
+    }
+  };
+
+  class plBenchObjectLayerPairFilter final : public JPH::ObjectLayerPairFilter
+  {
+  public:
+    virtual bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::ObjectLayer inLayer2) const override
+    {
+      return inLayer1 != s_StaticLayer || inLayer2 != s_StaticLayer;
+    }
+  };
+
+  /// \brief Stands in for the rest of the engine, which uses the worker threads while the physics update runs.
+  class plOtherTask : public plTask
+  {
+  public:
+    virtual void Execute() override
+    {
+      const plTime end = plTime::Now() + plTime::MakeFromMicroseconds(100);
+      while (plTime::Now() < end)
+      {
+      }
+    }
+  };
+
+  struct plFrameTimes
+  {
+    plTime m_Average;
+    plTime m_Worst;
+  };
+} // namespace
+
+/// \brief Compares the physics frame times with Jolt jobs running on the plTaskSystem (plJoltJobSystem) and on a separate JPH::JobSystemThreadPool.
+///
+/// This is the choice that the 'Jolt.UseTaskSystem' cvar makes. Both job systems are set up exactly like plJoltCore does it. Every measurement
+/// is done with the physics update running alone and while other tasks occupy the worker threads, which is where the separate thread pool
+/// oversubscribes the CPU. The final body positions of all runs must be identical, since Jolt's simulation doesn't depend on the job order.
+class plJoltJobBench : public plApplication
+{
+  plBenchBroadPhaseLayers m_BroadPhaseLayers;
+  plBenchObjectVsBroadPhaseLayerFilter m_ObjectVsBroadPhaseFilter;
+  plBenchObjectLayerPairFilter m_ObjectLayerPairFilter;
+
+  plDynamicArray<plSharedPtr<plTask>> m_OtherTasks;
+  plDynamicArray<plVec3> m_ReferencePositions;
+
+public:
+  using SUPER = plApplication;
+
+  plJoltJobBench()
+    : plApplication("JoltJobBench")
+  {
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    plGlobalLog::AddLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::AddLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    plGlobalLog::RemoveLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::RemoveLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  /// \brief Drops stacks of slightly rotated boxes onto the ground, so that they tumble and pile up.
+  void CreateScene(JPH::PhysicsSystem& ref_system, plUInt32 uiNumBodies)
+  {
+    JPH::BodyInterface& bodies = ref_system.GetBodyInterface();
+
+    JPH::BodyCreationSettings ground(new JPH::BoxShape(JPH::Vec3(500.0f, 1.0f, 500.0f)), JPH::RVec3(0, -1, 0), JPH::Quat::sIdentity(), JPH::EMotionType::Static, s_StaticLayer);
+    bodies.CreateAndAddBody(ground, JPH::EActivation::DontActivate);
+
+    JPH::RefConst<JPH::Shape> pBox = new JPH::BoxShape(JPH::Vec3(0.5f, 0.5f, 0.5f));
+
+    const plUInt32 uiStackHeight = 10;
+    const plUInt32 uiNumStacks = (uiNumBodies + uiStackHeight - 1) / uiStackHeight;
+    const plUInt32 uiStacksPerRow = static_cast<plUInt32>(plMath::Ceil(plMath::Sqrt(static_cast<float>(uiNumStacks))));
+
+    for (plUInt32 i = 0; i < uiNumBodies; ++i)
+    {
+      const plUInt32 uiStack = i / uiStackHeight;
+      const plUInt32 uiLevel = i % uiStackHeight;
+
+      const JPH::RVec3 vPosition((uiStack % uiStacksPerRow) * 2.0f, 1.0f + uiLevel * 1.5f, (uiStack / uiStacksPerRow) * 2.0f);
+      const JPH::Quat qRotation = JPH::Quat::sRotation(JPH::Vec3(1, 0, 1).Normalized(), 0.2f + 0.1f * (i % 7));
+
+      JPH::BodyCreationSettings box(pBox, vPosition, qRotation, JPH::EMotionType::Dynamic, s_DynamicLayer);
+      bodies.CreateAndAddBody(box, JPH::EActivation::Activate);
+    }
+
+    ref_system.OptimizeBroadPhase();
+  }
+
+  void GetPositions(JPH::PhysicsSystem& ref_system, plDynamicArray<plVec3>& out_positions)
+  {
+    JPH::BodyIDVector bodyIDs;
+    ref_system.GetBodies(bodyIDs);
+
+    out_positions.Clear();
+    for (const JPH::BodyID& bodyID : bodyIDs)
+    {
+      out_positions.PushBack(plJoltConversionUtils::ToVec3(ref_system.GetBodyInterface().GetPosition(bodyID)));
+    }
+  }
+
+  plFrameTimes Measure(JPH::JobSystem* pJobSystem, bool bOtherTasks)
+  {
+    const plUInt32 uiNumBodies = static_cast<plUInt32>(opt_Bodies.GetOptionValue(plCommandLineOption::LogMode::Never));
+    const plUInt32 uiNumFrames = static_cast<plUInt32>(opt_Frames.GetOptionValue(plCommandLineOption::LogMode::Never));
+    const plUInt32 uiNumRuns = static_cast<plUInt32>(opt_Runs.GetOptionValue(plCommandLineOption::LogMode::Never));
+
+    JPH::TempAllocatorImpl tempAllocator(64 * 1024 * 1024);
+
+    plFrameTimes fastest;
+    fastest.m_Average = plTime::MakeFromHours(1);
+
+    for (plUInt32 uiRun = 0; uiRun < uiNumRuns; ++uiRun)
+    {
+      JPH::PhysicsSystem system;
+      system.Init(uiNumBodies + 1, 0, uiNumBodies * 4 * 10, uiNumBodies * 4, m_BroadPhaseLayers, m_ObjectVsBroadPhaseFilter, m_ObjectLayerPairFilter);
+
+      CreateScene(system, uiNumBodies);
+
+      plTime total;
+      plTime worst;
+
+      for (plUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+      {
+        const plTime start = plTime::Now();
+
+        plTaskGroupID group;
+        if (bOtherTasks)
+        {
+          group = plTaskSystem::CreateTaskGroup(plTaskPriority::EarlyThisFrame);
+          for (const plSharedPtr<plTask>& pTask : m_OtherTasks)
+          {
+            plTaskSystem::AddTaskToGroup(group, pTask);
+          }
+          plTaskSystem::StartTaskGroup(group);
+        }
+
+        if (system.Update(1.0f / 60.0f, 1, &tempAllocator, pJobSystem) != JPH::EPhysicsUpdateError::None)
+        {
+          plLog::Error("The physics update failed");
+          SetReturnCode(1);
+        }
+
+        if (bOtherTasks)
+        {
+          plTaskSystem::WaitForGroup(group);
+        }
+
+        const plTime duration = plTime::Now() - start;
+        total += duration;
+        worst = plMath::Max(worst, duration);
+      }
+
+      if (total / uiNumFrames < fastest.m_Average)
+      {
+        fastest.m_Average = total / uiNumFrames;
+        fastest.m_Worst = worst;
+      }
+
+      plDynamicArray<plVec3> positions;
+      GetPositions(system, positions);
+
+      if (m_ReferencePositions.IsEmpty())
+      {
+        m_ReferencePositions = positions;
+      }
+      else if (m_ReferencePositions != positions)
+      {
+        plLog::Error("The simulation result differs from the first run");
+        SetReturnCode(1);
+      }
+    }
+
+    return fastest;
+  }
+
+  virtual Execution Run() override
+  {
+    {
+      plStringBuilder cmdHelp;
+      if (plCommandLineOption::LogAvailableOptionsToBuffer(cmdHelp, plCommandLineOption::LogAvailableModes::IfHelpRequested, "_JoltJobBench"))
+      {
+        plLog::Print(cmdHelp);
+        return plApplication::Execution::Quit;
+      }
+    }
+
+    const plInt32 iThreads = opt_Threads.GetOptionValue(plCommandLineOption::LogMode::Always);
+    if (iThreads >= 0)
+    {
+      plTaskSystem::SetWorkerThreadCount(iThreads, -1);
+    }
+
+    opt_Bodies.GetOptionValue(plCommandLineOption::LogMode::Always);
+    opt_Frames.GetOptionValue(plCommandLineOption::LogMode::Always);
+    opt_Runs.GetOptionValue(plCommandLineOption::LogMode::Always);
+
+    const plUInt32 uiNumOtherTasks = static_cast<plUInt32>(opt_OtherTasks.GetOptionValue(plCommandLineOption::LogMode::Always));
+    for (plUInt32 i = 0; i < uiNumOtherTasks; ++i)
+    {
+      m_OtherTasks.PushBack(PL_DEFAULT_NEW(plOtherTask));
+    }
+
+    const plUInt32 uiNumPoolThreads = std::thread::hardware_concurrency() - 1;
+
+    plLog::Info("{} short task worker threads, {} Jolt thread pool threads", plTaskSystem::GetWorkerThreadCount(plWorkerThreadType::ShortTasks), uiNumPoolThreads);
+
+    for (bool bUseTaskSystem : {true, false})
+    {
+      // both are created like plJoltCore::Startup() does it
+      std::unique_ptr<JPH::JobSystem> pJobSystem;
+      if (bUseTaskSystem)
+      {
+        pJobSystem = std::make_unique<plJoltJobSystem>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+      }
+      else
+      {
+        pJobSystem = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, uiNumPoolThreads);
+      }
+
+      const plFrameTimes alone = Measure(pJobSystem.get(), false);
+      const plFrameTimes withOtherTasks = Measure(pJobSystem.get(), true);
+
+      plLog::Info("{}: {} ms per frame (worst {} ms), {} ms per frame with other tasks (worst {} ms)", bUseTaskSystem ? "Task system" : "Thread pool",
+        plArgF(alone.m_Average.GetMilliseconds(), 3), plArgF(alone.m_Worst.GetMilliseconds(), 3), plArgF(withOtherTasks.m_Average.GetMilliseconds(), 3),
+        plArgF(withOtherTasks.m_Worst.GetMilliseconds(), 3));
+    }
+
+    m_OtherTasks.Clear();
+
+    return plApplication::Execution::Quit;
+  }
+};
+
+PL_CONSOLEAPP_ENTRY_POINT(plJoltJobBench);
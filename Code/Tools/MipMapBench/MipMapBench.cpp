@@ -0,0 +1,177 @@
+#include <Foundation/Application/Application.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Utilities/CommandLineOptions.h>
+#include <Texture/Image/Image.h>
+#include <Texture/Image/ImageUtils.h>
+
+plCommandLineOptionInt opt_Size("_MipMapBench", "-size", "Width and height of the cube map faces and array slices.", 1024, 16, 8192);
+
+plCommandLineOptionInt opt_VolumeSize("_MipMapBench", "-volume", "Width, height and depth of the volume texture.", 128, 4, 1024);
+
+plCommandLineOptionInt opt_Runs("_MipMapBench", "-runs", "How often every measurement is repeated. The fastest run is reported.", 3, 1, 100);
+
+/// \brief Generates the mip chains of a cube map, a texture array and a volume texture with every image filter, once distributed over the
+/// task system and once serially.
+///
+/// Prints the fastest time of both and fails, if the two mip chains are not bit-identical.
+class plMipMapBench : public plApplication
+{
+public:
+  using SUPER = plApplication;
+
+  plMipMapBench()
+    : plApplication("MipMapBench")
+  {
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    plGlobalLog::AddLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::AddLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    plGlobalLog::RemoveLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::RemoveLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  /// \brief Fills the image with smooth gradients plus noise, so that every filter tap contributes to the result.
+  void CreateImage(plImage& ref_image, plUInt32 uiWidth, plUInt32 uiHeight, plUInt32 uiDepth, plUInt32 uiFaces, plUInt32 uiArraySlices)
+  {
+    plImageHeader header;
+    header.SetImageFormat(plImageFormat::R32G32B32A32_FLOAT);
+    header.SetWidth(uiWidth);
+    header.SetHeight(uiHeight);
+    header.SetDepth(uiDepth);
+    header.SetNumFaces(uiFaces);
+    header.SetNumArrayIndices(uiArraySlices);
+    ref_image.ResetAndAlloc(header);
+
+    plRandom rng;
+    rng.Initialize(42);
+
+    plBlobPtr<plColor> pixels = ref_image.GetBlobPtr<plColor>();
+    for (plUInt32 i = 0; i < pixels.GetCount(); ++i)
+    {
+      const plUInt32 x = i % uiWidth;
+      const plUInt32 y = (i / uiWidth) % uiHeight;
+
+      pixels[i].r = 0.5f + 0.4f * plMath::Sin(plAngle::MakeFromRadian(x * 0.05f + y * 0.01f)) + rng.FloatMinMax(-0.1f, 0.1f);
+      pixels[i].g = 0.5f + 0.4f * plMath::Cos(plAngle::MakeFromRadian(y * 0.07f)) + rng.FloatMinMax(-0.1f, 0.1f);
+      pixels[i].b = ((x / 13 + y / 7) & 1) ? 0.9f : 0.1f;
+      pixels[i].a = rng.FloatZeroToOneInclusive();
+    }
+  }
+
+  plTime Measure(const plImage& source, plImage& ref_target, const plImageUtils::MipMapOptions& options, bool bMultithreaded)
+  {
+    plImageUtils::SetMultithreading(bMultithreaded);
+
+    plTime fastest = plTime::MakeFromHours(1);
+    for (plInt32 iRun = 0; iRun < opt_Runs.GetOptionValue(plCommandLineOption::LogMode::Never); ++iRun)
+    {
+      const plTime tStart = plTime::Now();
+      plImageUtils::GenerateMipMaps(source, ref_target, options);
+      fastest = plMath::Min(fastest, plTime::Now() - tStart);
+    }
+
+    plImageUtils::SetMultithreading(true);
+    return fastest;
+  }
+
+  bool Compare(plStringView sImage, plStringView sFilter, const plImage& source, const plImageFilter* pFilter, plImageAddressMode::Enum addressMode)
+  {
+    plImageUtils::MipMapOptions options;
+    options.m_filter = pFilter;
+    options.m_addressModeU = addressMode;
+    options.m_addressModeV = addressMode;
+    options.m_addressModeW = addressMode;
+
+    plImage parallel;
+    plImage serial;
+    const plTime tParallel = Measure(source, parallel, options, true);
+    const plTime tSerial = Measure(source, serial, options, false);
+
+    const plByteBlobPtr parallelData = parallel.GetByteBlobPtr();
+    const plByteBlobPtr serialData = serial.GetByteBlobPtr();
+    const bool bIdentical = parallelData.GetCount() == serialData.GetCount() && memcmp(parallelData.GetPtr(), serialData.GetPtr(), parallelData.GetCount()) == 0;
+
+    plLog::Info("{}, {}: parallel {} ms, serial {} ms, speedup {}x, {}", sImage, sFilter, plArgF(tParallel.GetMilliseconds(), 1), plArgF(tSerial.GetMilliseconds(), 1), plArgF(tSerial.GetSeconds() / plMath::Max(tParallel.GetSeconds(), 1e-9), 2), bIdentical ? "identical" : "DIFFERENT");
+
+    if (!bIdentical)
+    {
+      plLog::Error("The parallel mip chain of the {} with the {} filter differs from the serial one", sImage, sFilter);
+    }
+
+    return bIdentical;
+  }
+
+  virtual Execution Run() override
+  {
+    {
+      plStringBuilder cmdHelp;
+      if (plCommandLineOption::LogAvailableOptionsToBuffer(cmdHelp, plCommandLineOption::LogAvailableModes::IfHelpRequested, "_MipMapBench"))
+      {
+        plLog::Print(cmdHelp);
+        return plApplication::Execution::Quit;
+      }
+    }
+
+    const plUInt32 uiSize = opt_Size.GetOptionValue(plCommandLineOption::LogMode::Always);
+    const plUInt32 uiVolumeSize = opt_VolumeSize.GetOptionValue(plCommandLineOption::LogMode::Always);
+    opt_Runs.GetOptionValue(plCommandLineOption::LogMode::Always);
+
+    plImage cubeMap;
+    CreateImage(cubeMap, uiSize, uiSize, 1, 6, 1);
+
+    // a non power of two height makes the filter weights differ between neighboring rows
+    plImage textureArray;
+    CreateImage(textureArray, uiSize, uiSize / 2 + 3, 1, 1, 4);
+
+    plImage volume;
+    CreateImage(volume, uiVolumeSize, uiVolumeSize, uiVolumeSize, 1, 1);
+
+    struct Filter
+    {
+      const char* m_szName;
+      const plImageFilter* m_pFilter;
+    };
+
+    const plImageFilterBox filterBox;
+    const plImageFilterTriangle filterTriangle;
+    const plImageFilterSincWithKaiserWindow filterKaiser;
+
+    const Filter filters[] = {
+      {"box", &filterBox},
+      {"triangle", &filterTriangle},
+      {"kaiser", &filterKaiser},
+    };
+
+    bool bAllIdentical = true;
+
+    for (const Filter& filter : filters)
+    {
+      bAllIdentical &= Compare("cube map", filter.m_szName, cubeMap, filter.m_pFilter, plImageAddressMode::Clamp);
+      bAllIdentical &= Compare("texture array", filter.m_szName, textureArray, filter.m_pFilter, plImageAddressMode::Repeat);
+      bAllIdentical &= Compare("volume", filter.m_szName, volume, filter.m_pFilter, plImageAddressMode::Mirror);
+    }
+
+    if (!bAllIdentical)
+    {
+      SetReturnCode(1);
+    }
+
+    return plApplication::Execution::Quit;
+  }
+};
+
+PL_CONSOLEAPP_ENTRY_POINT(plMipMapBench);
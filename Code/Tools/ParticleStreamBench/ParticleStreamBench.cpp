@@ -0,0 +1,497 @@
+#include <Foundation/Application/Application.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamGroup.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Math/Color16f.h>
+#include <Foundation/Math/Float16.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Tracks/ColorGradient.h>
+#include <Foundation/Tracks/Curve1D.h>
+#include <Foundation/Utilities/CommandLineOptions.h>
+#include <ParticlePlugin/Streams/ParticleStreamSimd.h>
+
+plCommandLineOptionInt opt_Particles("_ParticleStreamBench", "-particles", "Number of particles.", 100000, 4, 10000000);
+
+plCommandLineOptionInt opt_Frames("_ParticleStreamBench", "-frames", "Number of measured frames per behavior.", 100, 1, 100000);
+
+namespace
+{
+  static constexpr float s_fTimeDiff = 1.0f / 60.0f;
+  static constexpr float s_fFriction = 0.5f;
+  static constexpr float s_fStartAlpha = 1.0f;
+  static constexpr float s_fExponent = 2.0f;
+  static constexpr float s_fBaseSize = 0.5f;
+  static constexpr float s_fCurveScale = 2.0f;
+
+  /// \brief The streams of a particle system with the Gravity, Velocity, FadeOut, SizeCurve and ColorGradient behaviors.
+  ///
+  /// Velocity3 is the Float3 velocity stream that was used before the velocity was padded to Float4.
+  struct plBenchStreams
+  {
+    plProcessingStreamGroup m_Group;
+    plProcessingStream* m_pPosition = nullptr;
+    plProcessingStream* m_pVelocity = nullptr;
+    plProcessingStream* m_pVelocity3 = nullptr;
+    plProcessingStream* m_pLifeTime = nullptr;
+    plProcessingStream* m_pColor = nullptr;
+    plProcessingStream* m_pSize = nullptr;
+
+    void Initialize(plUInt32 uiNumParticles)
+    {
+      m_pPosition = m_Group.AddStream("Position", plProcessingStream::DataType::Float4);
+      m_pVelocity = m_Group.AddStream("Velocity", plProcessingStream::DataType::Float4);
+      m_pVelocity3 = m_Group.AddStream("Velocity3", plProcessingStream::DataType::Float3);
+      m_pLifeTime = m_Group.AddStream("LifeTime", plProcessingStream::DataType::Half2);
+      m_pColor = m_Group.AddStream("Color", plProcessingStream::DataType::Half4);
+      m_pSize = m_Group.AddStream("Size", plProcessingStream::DataType::Half);
+      m_Group.SetSize(uiNumParticles);
+
+      // the stream data is allocated when the group is processed the first time
+      m_Group.Process();
+
+      plRandom rng;
+      rng.Initialize(42);
+
+      plVec4* pPosition = m_pPosition->GetWritableData<plVec4>();
+      plVec4* pVelocity = m_pVelocity->GetWritableData<plVec4>();
+      plVec3* pVelocity3 = m_pVelocity3->GetWritableData<plVec3>();
+      plFloat16Vec2* pLifeTime = m_pLifeTime->GetWritableData<plFloat16Vec2>();
+      plColorLinear16f* pColor = m_pColor->GetWritableData<plColorLinear16f>();
+      plFloat16* pSize = m_pSize->GetWritableData<plFloat16>();
+
+      // the streams are padded to a multiple of four, initialize the padding as well
+      const plUInt32 uiNumPadded = plParticleStreamSimd::GetNumGroups(uiNumParticles) * 4;
+      for (plUInt32 i = 0; i < uiNumPadded; ++i)
+      {
+        const plVec3 vVelocity(static_cast<float>(rng.DoubleMinMax(-5, 5)), static_cast<float>(rng.DoubleMinMax(-5, 5)), static_cast<float>(rng.DoubleMinMax(0, 10)));
+        const float fLifeTime = static_cast<float>(rng.DoubleMinMax(1, 4));
+
+        pPosition[i] = plVec4(static_cast<float>(rng.DoubleMinMax(-10, 10)), static_cast<float>(rng.DoubleMinMax(-10, 10)), 0.0f, 1.0f);
+        pVelocity[i] = vVelocity.GetAsVec4(0.0f);
+        pVelocity3[i] = vVelocity;
+        pLifeTime[i] = plVec2(static_cast<float>(rng.DoubleMinMax(0, fLifeTime)), 1.0f / fLifeTime);
+        pColor[i] = plColor::White;
+        pSize[i] = s_fBaseSize;
+      }
+    }
+  };
+
+  /// \brief The size curve and color gradient, with the lookup tables that the behaviors bake them into.
+  struct plBenchCurves
+  {
+    plCurve1D m_Curve;
+    plColorGradient m_Gradient;
+
+    float m_AlphaTable[plParticleStreamSimd::LookupTableSize + 1];
+    float m_CurveTable[plParticleStreamSimd::LookupTableSize + 1];
+    plSimdVec4f m_ColorTable[plParticleStreamSimd::LookupTableSize + 1];
+
+    void Initialize()
+    {
+      m_Curve.AddControlPoint(0.0).m_Position.y = 0.0;
+      m_Curve.AddControlPoint(0.2).m_Position.y = 1.0;
+      m_Curve.AddControlPoint(0.7).m_Position.y = 0.8;
+      m_Curve.AddControlPoint(1.0).m_Position.y = 0.0;
+      m_Curve.SortControlPoints();
+      m_Curve.CreateLinearApproximation();
+
+      m_Gradient.AddColorControlPoint(0.0, plColorGammaUB(255, 240, 200));
+      m_Gradient.AddColorControlPoint(0.3, plColorGammaUB(255, 128, 0));
+      m_Gradient.AddColorControlPoint(0.8, plColorGammaUB(80, 20, 20));
+      m_Gradient.AddColorControlPoint(1.0, plColorGammaUB(20, 20, 20));
+      m_Gradient.AddAlphaControlPoint(0.0, 255);
+      m_Gradient.AddAlphaControlPoint(0.9, 200);
+      m_Gradient.AddAlphaControlPoint(1.0, 0);
+      m_Gradient.SortControlPoints();
+
+      for (plUInt32 i = 0; i <= plParticleStreamSimd::LookupTableSize; ++i)
+      {
+        const float fPos = plMath::Min(1.0f, static_cast<float>(i) / (plParticleStreamSimd::LookupTableSize - 1));
+
+        m_AlphaTable[i] = EvaluateAlpha(fPos);
+        m_CurveTable[i] = EvaluateCurve(fPos);
+
+        const plColor color = EvaluateGradient(fPos);
+        m_ColorTable[i].Load<4>(&color.r);
+      }
+    }
+
+    float EvaluateAlpha(float fLifeTimeFraction) const { return plMath::Min(1.0f, s_fStartAlpha * plMath::Pow(fLifeTimeFraction, s_fExponent)); }
+
+    float EvaluateCurve(float fAgeFraction) const { return static_cast<float>(m_Curve.NormalizeValue(m_Curve.Evaluate(m_Curve.ConvertNormalizedPos(fAgeFraction)))); }
+
+    plColor EvaluateGradient(float fAgeFraction) const
+    {
+      plColor rgba;
+      plUInt8 alpha;
+      m_Gradient.EvaluateColor(fAgeFraction, rgba);
+      m_Gradient.EvaluateAlpha(fAgeFraction, alpha);
+      rgba.a = plMath::ColorByteToFloat(alpha);
+      return rgba;
+    }
+  };
+
+  // The behaviors before the streams were padded: scalar loops over a Float3 velocity stream, curves and gradients are evaluated for every
+  // second particle per frame.
+
+  void PreviousMovement(plBenchStreams& ref_streams, plUInt32 uiNumParticles)
+  {
+    const plVec3 vAddGravity = plVec3(0.0f, 0.0f, -10.0f) * s_fTimeDiff;
+    const float fFrictionFactor = plMath::Pow(0.5f, s_fTimeDiff * s_fFriction);
+
+    // Gravity
+    {
+      plProcessingStreamIterator<plVec3> itVelocity(ref_streams.m_pVelocity3, uiNumParticles, 0);
+      while (!itVelocity.HasReachedEnd())
+      {
+        itVelocity.Current() += vAddGravity;
+        itVelocity.Advance();
+      }
+    }
+
+    // Velocity, with a wind force of zero
+    {
+      plProcessingStreamIterator<plVec3> itVelocity(ref_streams.m_pVelocity3, uiNumParticles, 0);
+      while (!itVelocity.HasReachedEnd())
+      {
+        itVelocity.Current() *= fFrictionFactor;
+        itVelocity.Advance();
+      }
+    }
+
+    // ApplyVelocity
+    {
+      plProcessingStreamIterator<plVec4> itPosition(ref_streams.m_pPosition, uiNumParticles, 0);
+      plProcessingStreamIterator<plVec3> itVelocity(ref_streams.m_pVelocity3, uiNumParticles, 0);
+      while (!itPosition.HasReachedEnd())
+      {
+        plVec3& pos = reinterpret_cast<plVec3&>(itPosition.Current());
+        pos += itVelocity.Current() * s_fTimeDiff;
+
+        itPosition.Advance();
+        itVelocity.Advance();
+      }
+    }
+  }
+
+  void PreviousFadeOut(plBenchStreams& ref_streams, plUInt32 uiNumParticles, plUInt32 uiFrame)
+  {
+    plProcessingStreamIterator<plFloat16Vec2> itLifeTime(ref_streams.m_pLifeTime, uiNumParticles, 0);
+    plProcessingStreamIterator<plColorLinear16f> itColor(ref_streams.m_pColor, uiNumParticles, 0);
+
+    itLifeTime.Advance(uiFrame % 2);
+    itColor.Advance(uiFrame % 2);
+
+    while (!itLifeTime.HasReachedEnd())
+    {
+      const float fLifeTimeFraction = itLifeTime.Current().x * itLifeTime.Current().y;
+      itColor.Current().a = plMath::Min(1.0f, s_fStartAlpha * plMath::Pow(fLifeTimeFraction, s_fExponent));
+
+      itLifeTime.Advance(2);
+      itColor.Advance(2);
+    }
+  }
+
+  void PreviousSizeCurve(plBenchStreams& ref_streams, const plBenchCurves& curves, plUInt32 uiNumParticles, plUInt32 uiFrame)
+  {
+    plProcessingStreamIterator<plFloat16Vec2> itLifeTime(ref_streams.m_pLifeTime, uiNumParticles, 0);
+    plProcessingStreamIterator<plFloat16> itSize(ref_streams.m_pSize, uiNumParticles, 0);
+
+    itLifeTime.Advance(uiFrame % 2);
+    itSize.Advance(uiFrame % 2);
+
+    while (!itLifeTime.HasReachedEnd())
+    {
+      const float fAgeFraction = 1.0f - (itLifeTime.Current().x * itLifeTime.Current().y);
+      itSize.Current() = s_fBaseSize + curves.EvaluateCurve(fAgeFraction) * s_fCurveScale;
+
+      itLifeTime.Advance(2);
+      itSize.Advance(2);
+    }
+  }
+
+  void PreviousColorGradient(plBenchStreams& ref_streams, const plBenchCurves& curves, plUInt32 uiNumParticles, plUInt32 uiFrame)
+  {
+    plProcessingStreamIterator<plFloat16Vec2> itLifeTime(ref_streams.m_pLifeTime, uiNumParticles, 0);
+    plProcessingStreamIterator<plColorLinear16f> itColor(ref_streams.m_pColor, uiNumParticles, 0);
+
+    itLifeTime.Advance(uiFrame % 2);
+    itColor.Advance(uiFrame % 2);
+
+    while (!itLifeTime.HasReachedEnd())
+    {
+      const float fAgeFraction = 1.0f - (itLifeTime.Current().x * itLifeTime.Current().y);
+      itColor.Current() = curves.EvaluateGradient(fAgeFraction);
+
+      itLifeTime.Advance(2);
+      itColor.Advance(2);
+    }
+  }
+
+  // The same kernels as the behaviors of the particle plugin: groups of four particles, all particles are updated every frame.
+
+  void CurrentMovement(plBenchStreams& ref_streams, plUInt32 uiNumParticles)
+  {
+    const plVec3 vAddGravity0 = plVec3(0.0f, 0.0f, -10.0f) * s_fTimeDiff;
+    plSimdVec4f vAddGravity;
+    vAddGravity.Load<3>(&vAddGravity0.x);
+
+    const plSimdFloat fFrictionFactor = plMath::Pow(0.5f, s_fTimeDiff * s_fFriction);
+    const plSimdFloat fTimeDiff = s_fTimeDiff;
+
+    const plUInt32 uiNumElements = plParticleStreamSimd::GetNumGroups(uiNumParticles) * 4;
+
+    // Gravity
+    {
+      plSimdVec4f* pVelocity = ref_streams.m_pVelocity->GetWritableData<plSimdVec4f>();
+      plSimdVec4f* pVelocityEnd = pVelocity + uiNumElements;
+
+      for (; pVelocity < pVelocityEnd; pVelocity += 4)
+      {
+        pVelocity[0] += vAddGravity;
+        pVelocity[1] += vAddGravity;
+        pVelocity[2] += vAddGravity;
+        pVelocity[3] += vAddGravity;
+      }
+    }
+
+    // Velocity, with a wind force of zero
+    {
+      plSimdVec4f* pVelocity = ref_streams.m_pVelocity->GetWritableData<plSimdVec4f>();
+      plSimdVec4f* pVelocityEnd = pVelocity + uiNumElements;
+
+      for (; pVelocity < pVelocityEnd; pVelocity += 4)
+      {
+        pVelocity[0] *= fFrictionFactor;
+        pVelocity[1] *= fFrictionFactor;
+        pVelocity[2] *= fFrictionFactor;
+        pVelocity[3] *= fFrictionFactor;
+      }
+    }
+
+    // ApplyVelocity
+    {
+      plSimdVec4f* pPosition = ref_streams.m_pPosition->GetWritableData<plSimdVec4f>();
+      const plSimdVec4f* pVelocity = ref_streams.m_pVelocity->GetData<plSimdVec4f>();
+      plSimdVec4f* pPositionEnd = pPosition + uiNumElements;
+
+      for (; pPosition < pPositionEnd; pPosition += 4, pVelocity += 4)
+      {
+        pPosition[0] += pVelocity[0] * fTimeDiff;
+        pPosition[1] += pVelocity[1] * fTimeDiff;
+        pPosition[2] += pVelocity[2] * fTimeDiff;
+        pPosition[3] += pVelocity[3] * fTimeDiff;
+      }
+    }
+  }
+
+  void CurrentFadeOut(plBenchStreams& ref_streams, const plBenchCurves& curves, plUInt32 uiNumParticles)
+  {
+    const plFloat16Vec2* pLifeTime = ref_streams.m_pLifeTime->GetData<plFloat16Vec2>();
+    plColorLinear16f* pColor = ref_streams.m_pColor->GetWritableData<plColorLinear16f>();
+
+    const plUInt32 uiNumGroups = plParticleStreamSimd::GetNumGroups(uiNumParticles);
+    for (plUInt32 uiGroup = 0; uiGroup < uiNumGroups; ++uiGroup, pLifeTime += 4, pColor += 4)
+    {
+      const plSimdVec4f vLifeTimeFraction = plParticleStreamSimd::LoadLifeTimeFraction(pLifeTime);
+      const plSimdVec4f vAlpha = plParticleStreamSimd::SampleLookupTable(curves.m_AlphaTable, vLifeTimeFraction);
+
+      plParticleStreamSimd::StoreAlpha(pColor, vAlpha);
+    }
+  }
+
+  void CurrentSizeCurve(plBenchStreams& ref_streams, const plBenchCurves& curves, plUInt32 uiNumParticles)
+  {
+    const plFloat16Vec2* pLifeTime = ref_streams.m_pLifeTime->GetData<plFloat16Vec2>();
+    plFloat16* pSize = ref_streams.m_pSize->GetWritableData<plFloat16>();
+
+    const plSimdVec4f vOne(1.0f);
+    const plSimdVec4f vBaseSize(s_fBaseSize);
+    const plSimdVec4f vCurveScale(s_fCurveScale);
+
+    const plUInt32 uiNumGroups = plParticleStreamSimd::GetNumGroups(uiNumParticles);
+    for (plUInt32 uiGroup = 0; uiGroup < uiNumGroups; ++uiGroup, pLifeTime += 4, pSize += 4)
+    {
+      const plSimdVec4f vAgeFraction = vOne - plParticleStreamSimd::LoadLifeTimeFraction(pLifeTime);
+      const plSimdVec4f vCurveValue = plParticleStreamSimd::SampleLookupTable(curves.m_CurveTable, vAgeFraction);
+
+      plParticleStreamSimd::StoreHalf(pSize, vBaseSize + vCurveValue.CompMul(vCurveScale));
+    }
+  }
+
+  void CurrentColorGradient(plBenchStreams& ref_streams, const plBenchCurves& curves, plUInt32 uiNumParticles)
+  {
+    const plFloat16Vec2* pLifeTime = ref_streams.m_pLifeTime->GetData<plFloat16Vec2>();
+    plColorLinear16f* pColor = ref_streams.m_pColor->GetWritableData<plColorLinear16f>();
+
+    const plSimdVec4f vOne(1.0f);
+    plSimdVec4f values[4];
+
+    const plUInt32 uiNumGroups = plParticleStreamSimd::GetNumGroups(uiNumParticles);
+    for (plUInt32 uiGroup = 0; uiGroup < uiNumGroups; ++uiGroup, pLifeTime += 4, pColor += 4)
+    {
+      const plSimdVec4f vPos = vOne - plParticleStreamSimd::LoadLifeTimeFraction(pLifeTime);
+
+      plParticleStreamSimd::SampleLookupTable(curves.m_ColorTable, vPos, values);
+
+      plParticleStreamSimd::StoreColor(pColor + 0, values[0]);
+      plParticleStreamSimd::StoreColor(pColor + 1, values[1]);
+      plParticleStreamSimd::StoreColor(pColor + 2, values[2]);
+      plParticleStreamSimd::StoreColor(pColor + 3, values[3]);
+    }
+  }
+} // namespace
+
+/// \brief Measures the particle behaviors on the padded Float4 streams against the scalar loops that were used before.
+///
+/// The previous FadeOut, SizeCurve and ColorGradient behaviors only updated every second particle per frame. The current ones update all
+/// particles every frame, so the timings are per frame and not per particle. Afterwards the results of the lookup tables are compared with
+/// the exactly evaluated curves.
+class plParticleStreamBench : public plApplication
+{
+public:
+  using SUPER = plApplication;
+
+  plParticleStreamBench()
+    : plApplication("ParticleStreamBench")
+  {
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    plGlobalLog::AddLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::AddLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    plGlobalLog::RemoveLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::RemoveLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  /// \brief Returns the average time per frame.
+  template <typename Func>
+  plTime Measure(Func func)
+  {
+    const plUInt32 uiNumFrames = static_cast<plUInt32>(opt_Frames.GetOptionValue(plCommandLineOption::LogMode::Never));
+
+    const plTime start = plTime::Now();
+
+    for (plUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      func(uiFrame);
+    }
+
+    return (plTime::Now() - start) / uiNumFrames;
+  }
+
+  void LogResult(plStringView sName, plTime previous, plTime current)
+  {
+    plLog::Info("{}: previous {} ms, current {} ms ({}x)", sName, plArgF(previous.GetMilliseconds(), 3), plArgF(current.GetMilliseconds(), 3), plArgF(previous.GetSeconds() / current.GetSeconds(), 2));
+  }
+
+  void CheckResults(plBenchStreams& ref_streams, const plBenchCurves& curves, plUInt32 uiNumParticles)
+  {
+    const plFloat16Vec2* pLifeTime = ref_streams.m_pLifeTime->GetData<plFloat16Vec2>();
+    const plColorLinear16f* pColor = ref_streams.m_pColor->GetData<plColorLinear16f>();
+    const plFloat16* pSize = ref_streams.m_pSize->GetData<plFloat16>();
+
+    float fMaxAlphaError = 0.0f;
+    float fMaxSizeError = 0.0f;
+    float fMaxColorError = 0.0f;
+
+    CurrentFadeOut(ref_streams, curves, uiNumParticles);
+    CurrentSizeCurve(ref_streams, curves, uiNumParticles);
+
+    for (plUInt32 i = 0; i < uiNumParticles; ++i)
+    {
+      const float fLifeTimeFraction = pLifeTime[i].x * pLifeTime[i].y;
+      fMaxAlphaError = plMath::Max(fMaxAlphaError, plMath::Abs(static_cast<float>(pColor[i].a) - curves.EvaluateAlpha(fLifeTimeFraction)));
+
+      const float fSize = s_fBaseSize + curves.EvaluateCurve(1.0f - fLifeTimeFraction) * s_fCurveScale;
+      fMaxSizeError = plMath::Max(fMaxSizeError, plMath::Abs(static_cast<float>(pSize[i]) - fSize));
+    }
+
+    CurrentColorGradient(ref_streams, curves, uiNumParticles);
+
+    for (plUInt32 i = 0; i < uiNumParticles; ++i)
+    {
+      const plColor expected = curves.EvaluateGradient(1.0f - pLifeTime[i].x * pLifeTime[i].y);
+      const plColor actual = pColor[i].ToLinearFloat();
+
+      fMaxColorError = plMath::Max(fMaxColorError, plMath::Abs(actual.r - expected.r));
+      fMaxColorError = plMath::Max(fMaxColorError, plMath::Abs(actual.g - expected.g));
+      fMaxColorError = plMath::Max(fMaxColorError, plMath::Abs(actual.b - expected.b));
+      fMaxColorError = plMath::Max(fMaxColorError, plMath::Abs(actual.a - expected.a));
+    }
+
+    plLog::Info("Largest lookup table error: alpha {}, size {}, color {}", plArgF(fMaxAlphaError, 4), plArgF(fMaxSizeError, 4), plArgF(fMaxColorError, 4));
+
+    // the streams store 16 bit floats, which are accurate to about 0.001 for values up to 1
+    if (fMaxAlphaError > 0.005f || fMaxSizeError > 0.01f || fMaxColorError > 0.01f)
+    {
+      plLog::Error("The lookup tables differ too much from the evaluated curves");
+      SetReturnCode(1);
+    }
+  }
+
+  virtual Execution Run() override
+  {
+    {
+      plStringBuilder cmdHelp;
+      if (plCommandLineOption::LogAvailableOptionsToBuffer(cmdHelp, plCommandLineOption::LogAvailableModes::IfHelpRequested, "_ParticleStreamBench"))
+      {
+        plLog::Print(cmdHelp);
+        return plApplication::Execution::Quit;
+      }
+    }
+
+    const plUInt32 uiNumParticles = static_cast<plUInt32>(opt_Particles.GetOptionValue(plCommandLineOption::LogMode::Always));
+    opt_Frames.GetOptionValue(plCommandLineOption::LogMode::Always);
+
+    plBenchStreams streams;
+    streams.Initialize(uiNumParticles);
+
+    plBenchCurves curves;
+    curves.Initialize();
+
+    const plTime previousMovement = Measure([&](plUInt32 uiFrame)
+      { PreviousMovement(streams, uiNumParticles); });
+    const plTime currentMovement = Measure([&](plUInt32 uiFrame)
+      { CurrentMovement(streams, uiNumParticles); });
+    LogResult("Gravity, Velocity and ApplyVelocity", previousMovement, currentMovement);
+
+    const plTime previousFadeOut = Measure([&](plUInt32 uiFrame)
+      { PreviousFadeOut(streams, uiNumParticles, uiFrame); });
+    const plTime currentFadeOut = Measure([&](plUInt32 uiFrame)
+      { CurrentFadeOut(streams, curves, uiNumParticles); });
+    LogResult("FadeOut", previousFadeOut, currentFadeOut);
+
+    const plTime previousSizeCurve = Measure([&](plUInt32 uiFrame)
+      { PreviousSizeCurve(streams, curves, uiNumParticles, uiFrame); });
+    const plTime currentSizeCurve = Measure([&](plUInt32 uiFrame)
+      { CurrentSizeCurve(streams, curves, uiNumParticles); });
+    LogResult("SizeCurve", previousSizeCurve, currentSizeCurve);
+
+    const plTime previousColorGradient = Measure([&](plUInt32 uiFrame)
+      { PreviousColorGradient(streams, curves, uiNumParticles, uiFrame); });
+    const plTime currentColorGradient = Measure([&](plUInt32 uiFrame)
+      { CurrentColorGradient(streams, curves, uiNumParticles); });
+    LogResult("ColorGradient", previousColorGradient, currentColorGradient);
+
+    LogResult("All behaviors", previousMovement + previousFadeOut + previousSizeCurve + previousColorGradient, currentMovement + currentFadeOut + currentSizeCurve + currentColorGradient);
+
+    CheckResults(streams, curves, uiNumParticles);
+
+    return plApplication::Execution::Quit;
+  }
+};
+
+PL_CONSOLEAPP_ENTRY_POINT(plParticleStreamBench);
@@ -0,0 +1,118 @@
+#include <Foundation/Application/Application.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Utilities/CommandLineOptions.h>
+
+plCommandLineOptionPath opt_Input("_ProfilingCaptureConverter", "-in", "Path to a file written by plProfilingSystem::StartContinuousCapture().", "");
+
+plCommandLineOptionPath opt_Output("_ProfilingCaptureConverter", "-out", "Path to the JSON file to write. Defaults to the input path with a '.json' extension.", "");
+
+/// \brief Converts continuous profiling captures into the JSON format that plProfilingSystem::ProfilingData::Write() produces.
+///
+/// Captures are usually recorded on machines that shouldn't spend the time on the conversion, so this is done offline.
+class plProfilingCaptureConverter : public plApplication
+{
+  plStringBuilder m_sInputFile;
+  plStringBuilder m_sOutputFile;
+
+public:
+  using SUPER = plApplication;
+
+  plProfilingCaptureConverter()
+    : plApplication("ProfilingCaptureConverter")
+  {
+  }
+
+  plResult ParseArguments()
+  {
+    m_sInputFile = opt_Input.GetOptionValue(plCommandLineOption::LogMode::Always);
+    m_sInputFile.MakeCleanPath();
+
+    if (m_sInputFile.IsEmpty())
+    {
+      plLog::Error("Missing '-in' argument");
+      return PL_FAILURE;
+    }
+
+    m_sOutputFile = opt_Output.GetOptionValue(plCommandLineOption::LogMode::Always);
+    m_sOutputFile.MakeCleanPath();
+
+    if (m_sOutputFile.IsEmpty())
+    {
+      m_sOutputFile = m_sInputFile;
+      m_sOutputFile.ChangeFileExtension("json");
+    }
+
+    return PL_SUCCESS;
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    // Add the empty data directory to access files via absolute paths
+    plFileSystem::AddDataDirectory("", "App", ":", plFileSystem::AllowWrites).IgnoreResult();
+
+    plGlobalLog::AddLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::AddLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    plGlobalLog::RemoveLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::RemoveLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  virtual Execution Run() override
+  {
+    {
+      plStringBuilder cmdHelp;
+      if (plCommandLineOption::LogAvailableOptionsToBuffer(cmdHelp, plCommandLineOption::LogAvailableModes::IfHelpRequested, "_ProfilingCaptureConverter"))
+      {
+        plLog::Print(cmdHelp);
+        return plApplication::Execution::Quit;
+      }
+    }
+
+    if (ParseArguments().Failed())
+    {
+      SetReturnCode(1);
+      return plApplication::Execution::Quit;
+    }
+
+    plFileReader input;
+    if (input.Open(m_sInputFile).Failed())
+    {
+      plLog::Error("Failed to open '{}'", m_sInputFile);
+      SetReturnCode(1);
+      return plApplication::Execution::Quit;
+    }
+
+    plFileWriter output;
+    if (output.Open(m_sOutputFile).Failed())
+    {
+      plLog::Error("Failed to open '{}' for writing", m_sOutputFile);
+      SetReturnCode(1);
+      return plApplication::Execution::Quit;
+    }
+
+    if (plProfilingSystem::ConvertContinuousCaptureToJSON(input, output).Failed())
+    {
+      plLog::Error("'{}' is not a valid profiling capture", m_sInputFile);
+      SetReturnCode(1);
+      return plApplication::Execution::Quit;
+    }
+
+    plLog::Success("Wrote '{}'", m_sOutputFile);
+    return plApplication::Execution::Quit;
+  }
+};
+
+PL_CONSOLEAPP_ENTRY_POINT(plProfilingCaptureConverter);
@@ -0,0 +1,285 @@
+#include <Foundation/Application/Application.h>
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Utilities/CommandLineOptions.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
+
+plCommandLineOptionInt opt_RenderData("_RenderDataSortBench", "-renderdata", "Number of render data per category.", 30000, 1, 10000000);
+
+plCommandLineOptionInt opt_Categories("_RenderDataSortBench", "-categories", "Number of categories that the render data is added to (opaque, masked, transparent).", 1, 1, 3);
+
+plCommandLineOptionInt opt_Batches("_RenderDataSortBench", "-batches", "Number of distinct batch ids.", 200, 1, 1000000);
+
+plCommandLineOptionInt opt_Runs("_RenderDataSortBench", "-runs", "How often every measurement is repeated. The fastest run is reported.", 10, 1, 1000);
+
+class plBenchRenderData : public plRenderData
+{
+  PL_ADD_DYNAMIC_REFLECTION(plBenchRenderData, plRenderData);
+};
+
+// clang-format off
+PL_BEGIN_DYNAMIC_REFLECTED_TYPE(plBenchRenderData, 1, plRTTINoAllocator)
+PL_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+namespace
+{
+  /// \brief The sortable render data as it was before the batch id and the type were copied into it.
+  struct plPreviousSortableRenderData
+  {
+    PL_DECLARE_POD_TYPE();
+
+    const plRenderData* m_pRenderData;
+    plUInt64 m_uiSortingKey;
+  };
+
+  /// \brief The comparison sort that plExtractedRenderData::SortAndBatch() used before, it has to look up the batch id in the render data.
+  struct plPreviousRenderDataComparer
+  {
+    PL_FORCE_INLINE bool Less(const plPreviousSortableRenderData& a, const plPreviousSortableRenderData& b) const
+    {
+      if (a.m_uiSortingKey == b.m_uiSortingKey)
+      {
+        return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
+      }
+
+      return a.m_uiSortingKey < b.m_uiSortingKey;
+    }
+  };
+} // namespace
+
+/// \brief Compares plExtractedRenderData::SortAndBatch() with the comparison sort and batching that it used before.
+///
+/// The render data is created in random order with random batch ids, positions and sorting keys, like the extraction of a scene does.
+/// Both paths have to produce the same order of sorting keys and batch ids and the same number of batches.
+class plRenderDataSortBench : public plApplication
+{
+  plDeque<plBenchRenderData> m_RenderData;
+  plCamera m_Camera;
+
+public:
+  using SUPER = plApplication;
+
+  plRenderDataSortBench()
+    : plApplication("RenderDataSortBench")
+  {
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    plGlobalLog::AddLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::AddLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    plGlobalLog::RemoveLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::RemoveLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  plRenderData::Category GetCategory(plUInt32 uiIndex) const
+  {
+    const plRenderData::Category categories[] = {plDefaultRenderDataCategories::LitOpaque, plDefaultRenderDataCategories::LitMasked, plDefaultRenderDataCategories::LitTransparent};
+    return categories[uiIndex % opt_Categories.GetOptionValue(plCommandLineOption::LogMode::Never)];
+  }
+
+  void CreateRenderData(plUInt32 uiCount, plUInt32 uiNumBatches)
+  {
+    plRandom rng;
+    rng.Initialize(42);
+
+    m_Camera.LookAt(plVec3::MakeZero(), plVec3(1.0f, 0.0f, 0.0f), plVec3(0.0f, 0.0f, 1.0f));
+
+    for (plUInt32 i = 0; i < uiCount; ++i)
+    {
+      plBenchRenderData& renderData = m_RenderData.ExpandAndGetRef();
+      renderData.m_uiBatchId = rng.UIntInRange(uiNumBatches);
+      renderData.m_uiSortingKey = rng.UIntInRange(16);
+      renderData.m_fSortingDepthOffset = 0.0f;
+      renderData.m_GlobalTransform = plTransform::MakeIdentity();
+      renderData.m_GlobalTransform.m_vPosition.Set(static_cast<float>(rng.DoubleMinMax(1, 500)), static_cast<float>(rng.DoubleMinMax(-200, 200)), 0.0f);
+    }
+  }
+
+  /// \brief Returns the render data in a random order, so that the render data isn't accessed linearly, just like after extraction.
+  void GetShuffledRenderData(plDynamicArray<const plRenderData*>& out_renderData)
+  {
+    out_renderData.Clear();
+    for (const plBenchRenderData& renderData : m_RenderData)
+    {
+      out_renderData.PushBack(&renderData);
+    }
+
+    plRandom rng;
+    rng.Initialize(1337);
+
+    for (plUInt32 i = out_renderData.GetCount(); i > 1; --i)
+    {
+      plMath::Swap(out_renderData[i - 1], out_renderData[rng.UIntInRange(i)]);
+    }
+  }
+
+  plTime MeasureSortAndBatch(const plDynamicArray<const plRenderData*>& renderData, plDynamicArray<plUInt64>& out_order, plUInt32& out_uiNumBatches)
+  {
+    plExtractedRenderData extractedData;
+    extractedData.SetCamera(m_Camera);
+
+    plTime fastest = plTime::MakeFromHours(1);
+
+    for (plInt32 iRun = 0; iRun < opt_Runs.GetOptionValue(plCommandLineOption::LogMode::Never); ++iRun)
+    {
+      extractedData.Clear();
+
+      for (plUInt32 i = 0; i < renderData.GetCount(); ++i)
+      {
+        extractedData.AddRenderData(renderData[i], GetCategory(i));
+      }
+
+      const plTime start = plTime::Now();
+      extractedData.SortAndBatch();
+      fastest = plMath::Min(fastest, plTime::Now() - start);
+    }
+
+    out_order.Clear();
+    out_uiNumBatches = 0;
+
+    for (plUInt32 c = 0; c < static_cast<plUInt32>(opt_Categories.GetOptionValue(plCommandLineOption::LogMode::Never)); ++c)
+    {
+      const plRenderData::Category category = GetCategory(c);
+      const plRenderDataBatchList batchList = extractedData.GetRenderDataBatchesWithCategory(category);
+      out_uiNumBatches += batchList.GetBatchCount();
+
+      for (plUInt32 b = 0; b < batchList.GetBatchCount(); ++b)
+      {
+        const plRenderDataBatch batch = batchList.GetBatch(b);
+        for (auto it = batch.GetIterator<plBenchRenderData>(); it.IsValid(); ++it)
+        {
+          out_order.PushBack(it->GetCategorySortingKey(category, m_Camera));
+          out_order.PushBack(it->m_uiBatchId);
+        }
+      }
+    }
+
+    return fastest;
+  }
+
+  plTime MeasurePreviousSortAndBatch(const plDynamicArray<const plRenderData*>& renderData, plDynamicArray<plUInt64>& out_order, plUInt32& out_uiNumBatches)
+  {
+    const plUInt32 uiNumCategories = static_cast<plUInt32>(opt_Categories.GetOptionValue(plCommandLineOption::LogMode::Never));
+
+    plDynamicArray<plPreviousSortableRenderData> dataPerCategory[3];
+    plDynamicArray<plArrayPtr<plPreviousSortableRenderData>> batchesPerCategory[3];
+
+    plTime fastest = plTime::MakeFromHours(1);
+
+    for (plInt32 iRun = 0; iRun < opt_Runs.GetOptionValue(plCommandLineOption::LogMode::Never); ++iRun)
+    {
+      for (plUInt32 c = 0; c < uiNumCategories; ++c)
+      {
+        dataPerCategory[c].Clear();
+        batchesPerCategory[c].Clear();
+      }
+
+      for (plUInt32 i = 0; i < renderData.GetCount(); ++i)
+      {
+        auto& sortableRenderData = dataPerCategory[i % uiNumCategories].ExpandAndGetRef();
+        sortableRenderData.m_pRenderData = renderData[i];
+        sortableRenderData.m_uiSortingKey = renderData[i]->GetCategorySortingKey(GetCategory(i), m_Camera);
+      }
+
+      const plTime start = plTime::Now();
+
+      for (plUInt32 c = 0; c < uiNumCategories; ++c)
+      {
+        auto& data = dataPerCategory[c];
+        data.Sort(plPreviousRenderDataComparer());
+
+        plUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
+        plUInt32 uiCurrentBatchStartIndex = 0;
+        const plRTTI* pCurrentBatchType = data[0].m_pRenderData->GetDynamicRTTI();
+
+        for (plUInt32 i = 1; i < data.GetCount(); ++i)
+        {
+          auto pRenderData = data[i].m_pRenderData;
+
+          if (pRenderData->m_uiBatchId != uiCurrentBatchId || pRenderData->GetDynamicRTTI() != pCurrentBatchType)
+          {
+            batchesPerCategory[c].PushBack(plMakeArrayPtr(&data[uiCurrentBatchStartIndex], i - uiCurrentBatchStartIndex));
+
+            uiCurrentBatchId = pRenderData->m_uiBatchId;
+            uiCurrentBatchStartIndex = i;
+            pCurrentBatchType = pRenderData->GetDynamicRTTI();
+          }
+        }
+
+        batchesPerCategory[c].PushBack(plMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex));
+      }
+
+      fastest = plMath::Min(fastest, plTime::Now() - start);
+    }
+
+    out_order.Clear();
+    out_uiNumBatches = 0;
+
+    for (plUInt32 c = 0; c < uiNumCategories; ++c)
+    {
+      out_uiNumBatches += batchesPerCategory[c].GetCount();
+
+      for (const plPreviousSortableRenderData& data : dataPerCategory[c])
+      {
+        out_order.PushBack(data.m_uiSortingKey);
+        out_order.PushBack(data.m_pRenderData->m_uiBatchId);
+      }
+    }
+
+    return fastest;
+  }
+
+  virtual Execution Run() override
+  {
+    {
+      plStringBuilder cmdHelp;
+      if (plCommandLineOption::LogAvailableOptionsToBuffer(cmdHelp, plCommandLineOption::LogAvailableModes::IfHelpRequested, "_RenderDataSortBench"))
+      {
+        plLog::Print(cmdHelp);
+        return plApplication::Execution::Quit;
+      }
+    }
+
+    const plUInt32 uiNumCategories = static_cast<plUInt32>(opt_Categories.GetOptionValue(plCommandLineOption::LogMode::Always));
+    const plUInt32 uiNumRenderData = static_cast<plUInt32>(opt_RenderData.GetOptionValue(plCommandLineOption::LogMode::Always)) * uiNumCategories;
+    opt_Runs.GetOptionValue(plCommandLineOption::LogMode::Always);
+
+    CreateRenderData(uiNumRenderData, static_cast<plUInt32>(opt_Batches.GetOptionValue(plCommandLineOption::LogMode::Always)));
+
+    plDynamicArray<const plRenderData*> renderData;
+    GetShuffledRenderData(renderData);
+
+    plDynamicArray<plUInt64> order, previousOrder;
+    plUInt32 uiNumBatches = 0, uiPreviousNumBatches = 0;
+
+    const plTime sortAndBatch = MeasureSortAndBatch(renderData, order, uiNumBatches);
+    const plTime previousSortAndBatch = MeasurePreviousSortAndBatch(renderData, previousOrder, uiPreviousNumBatches);
+
+    plLog::Info("{} render data in {} categories: SortAndBatch {} ms, previous comparison sort {} ms, {} batches", uiNumRenderData, uiNumCategories,
+      plArgF(sortAndBatch.GetMilliseconds(), 2), plArgF(previousSortAndBatch.GetMilliseconds(), 2), uiNumBatches);
+
+    if (order != previousOrder || uiNumBatches != uiPreviousNumBatches)
+    {
+      plLog::Error("The render data was sorted or batched differently, {} batches before", uiPreviousNumBatches);
+      SetReturnCode(1);
+    }
+
+    return plApplication::Execution::Quit;
+  }
+};
+
+PL_CONSOLEAPP_ENTRY_POINT(plRenderDataSortBench);
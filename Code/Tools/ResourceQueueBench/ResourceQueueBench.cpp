@@ -0,0 +1,486 @@
+#include <Core/ResourceManager/Implementation/Declarations.h>
+#include <Foundation/Application/Application.h>
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Utilities/CommandLineOptions.h>
+
+plCommandLineOptionInt opt_Resources("_ResourceQueueBench", "-resources", "Number of streamed resources, laid out along a line.", 20000, 1000, 10000000);
+
+plCommandLineOptionInt opt_ViewRadius("_ResourceQueueBench", "-view", "How many resources in front of and behind the camera are used every frame.", 500, 10, 1000000);
+
+plCommandLineOptionInt opt_Frames("_ResourceQueueBench", "-frames", "Number of simulated frames (60 Hz).", 5000, 10, 10000000);
+
+plCommandLineOptionInt opt_Speed("_ResourceQueueBench", "-speed", "How many resources the camera moves per frame.", 4, 1, 1000);
+
+plCommandLineOptionInt opt_Loads("_ResourceQueueBench", "-loads", "Number of resources that the data loader loads per frame.", 3, 1, 1000);
+
+namespace
+{
+  /// \brief Has the state of plResource that the loading queue depends on.
+  struct plBenchResource
+  {
+    plUInt32 m_uiPosition = 0;
+    plResourcePriority m_Priority = plResourcePriority::Medium;
+    plTime m_LastAcquire;
+    bool m_bLoaded = false;
+    bool m_bQueued = false;
+    plUInt32 m_uiLoadingQueueIndex = plInvalidIndex;
+    plInt32 m_iRequestFrame = -1;
+
+    /// \brief Same as plResource::GetLoadingPriority() for a resource that is not loaded yet and has a type fallback.
+    float GetLoadingPriority(plTime now) const
+    {
+      if (m_Priority == plResourcePriority::Critical)
+        return 0.0f;
+
+      float fPriority = static_cast<float>(m_Priority) * 10.0f;
+      fPriority += 10.0f;
+
+      const float secondsSinceAcquire = (float)(now - m_LastAcquire).GetSeconds();
+      const float fTimePriority = plMath::Min(10.0f, secondsSinceAcquire);
+
+      return fPriority + fTimePriority;
+    }
+  };
+
+  /// \brief The loading queue as it was before plResourceLoadingQueue: a plDeque that gets one reverse bubble sort pass and 50 refreshed
+  /// priorities every time a data loader picks a resource. Removing a resource is a linear search.
+  class plPreviousLoadingQueue
+  {
+  public:
+    bool IsEmpty() const { return m_Queue.IsEmpty(); }
+
+    void Insert(plBenchResource* pResource, plTime lastFrameUpdate)
+    {
+      LoadingInfo li;
+      li.m_pResource = pResource;
+
+      if (pResource->m_Priority == plResourcePriority::Critical)
+      {
+        li.m_fPriority = 0.0f;
+        m_Queue.PushFront(li);
+      }
+      else
+      {
+        li.m_fPriority = pResource->GetLoadingPriority(lastFrameUpdate);
+        m_Queue.PushBack(li);
+      }
+    }
+
+    bool Remove(plBenchResource* pResource)
+    {
+      LoadingInfo li;
+      li.m_pResource = pResource;
+
+      return m_Queue.RemoveAndSwap(li);
+    }
+
+    plBenchResource* PopFront(plTime now)
+    {
+      UpdateLoadingDeadlines(now);
+
+      plBenchResource* pResource = m_Queue.PeekFront().m_pResource;
+      m_Queue.PopFront();
+      return pResource;
+    }
+
+  private:
+    struct LoadingInfo
+    {
+      float m_fPriority = 0.0f;
+      plBenchResource* m_pResource = nullptr;
+
+      bool operator==(const LoadingInfo& rhs) const { return m_pResource == rhs.m_pResource; }
+    };
+
+    void UpdateLoadingDeadlines(plTime now)
+    {
+      const plUInt32 uiCount = m_Queue.GetCount();
+      m_uiLastResourcePriorityUpdateIdx = plMath::Min(m_uiLastResourcePriorityUpdateIdx, uiCount);
+
+      plUInt32 uiUpdateCount = plMath::Min(50u, uiCount - m_uiLastResourcePriorityUpdateIdx);
+
+      if (uiUpdateCount == 0)
+      {
+        m_uiLastResourcePriorityUpdateIdx = 0;
+        uiUpdateCount = plMath::Min(50u, uiCount - m_uiLastResourcePriorityUpdateIdx);
+      }
+
+      for (plUInt32 i = 0; i < uiUpdateCount; ++i)
+      {
+        auto& element = m_Queue[m_uiLastResourcePriorityUpdateIdx];
+        element.m_fPriority = element.m_pResource->GetLoadingPriority(now);
+        ++m_uiLastResourcePriorityUpdateIdx;
+      }
+
+      for (plUInt32 i = uiCount; i > 1; --i)
+      {
+        const plUInt32 idx2 = i - 1;
+        const plUInt32 idx1 = i - 2;
+
+        if (m_Queue[idx1].m_fPriority > m_Queue[idx2].m_fPriority)
+        {
+          plMath::Swap(m_Queue[idx1], m_Queue[idx2]);
+        }
+      }
+    }
+
+    plDeque<LoadingInfo> m_Queue;
+    plUInt32 m_uiLastResourcePriorityUpdateIdx = 0;
+  };
+
+  /// \brief Same algorithm as plResourceLoadingQueue together with plResourceManager::UpdateLoadingDeadlines(): an indexed binary heap,
+  /// whose priorities are all refreshed once per frame.
+  class plCurrentLoadingQueue
+  {
+  public:
+    bool IsEmpty() const { return m_Heap.IsEmpty(); }
+
+    void Insert(plBenchResource* pResource, plTime lastFrameUpdate)
+    {
+      Entry entry;
+      entry.m_fPriority = pResource->GetLoadingPriority(lastFrameUpdate);
+      entry.m_uiSequence = m_uiNextSequence++;
+      entry.m_pResource = pResource;
+
+      m_Heap.PushBack(entry);
+      pResource->m_uiLoadingQueueIndex = m_Heap.GetCount() - 1;
+
+      SiftUp(m_Heap.GetCount() - 1);
+    }
+
+    bool Remove(plBenchResource* pResource)
+    {
+      if (pResource->m_uiLoadingQueueIndex == plInvalidIndex)
+        return false;
+
+      RemoveAt(pResource->m_uiLoadingQueueIndex);
+      return true;
+    }
+
+    plBenchResource* PopFront(plTime now)
+    {
+      if (m_LastLoadingDeadlinesUpdate != now)
+      {
+        m_LastLoadingDeadlinesUpdate = now;
+        UpdateAllPriorities(now);
+      }
+
+      plBenchResource* pResource = m_Heap[0].m_pResource;
+      RemoveAt(0);
+      return pResource;
+    }
+
+  private:
+    struct Entry
+    {
+      float m_fPriority = 0.0f;
+      plUInt64 m_uiSequence = 0;
+      plBenchResource* m_pResource = nullptr;
+
+      PL_ALWAYS_INLINE bool operator<(const Entry& rhs) const
+      {
+        if (m_fPriority != rhs.m_fPriority)
+          return m_fPriority < rhs.m_fPriority;
+
+        return m_uiSequence > rhs.m_uiSequence;
+      }
+    };
+
+    void UpdateAllPriorities(plTime now)
+    {
+      for (Entry& entry : m_Heap)
+      {
+        entry.m_fPriority = entry.m_pResource->GetLoadingPriority(now);
+      }
+
+      for (plUInt32 i = m_Heap.GetCount() / 2; i > 0; --i)
+      {
+        SiftDown(i - 1);
+      }
+    }
+
+    void RemoveAt(plUInt32 uiIndex)
+    {
+      m_Heap[uiIndex].m_pResource->m_uiLoadingQueueIndex = plInvalidIndex;
+
+      const plUInt32 uiLastIndex = m_Heap.GetCount() - 1;
+
+      if (uiIndex != uiLastIndex)
+      {
+        const Entry last = m_Heap[uiLastIndex];
+        const bool bMoveUp = last < m_Heap[uiIndex];
+
+        m_Heap.PopBack();
+        Store(uiIndex, last);
+
+        if (bMoveUp)
+          SiftUp(uiIndex);
+        else
+          SiftDown(uiIndex);
+      }
+      else
+      {
+        m_Heap.PopBack();
+      }
+    }
+
+    void SiftUp(plUInt32 uiIndex)
+    {
+      const Entry entry = m_Heap[uiIndex];
+
+      while (uiIndex > 0)
+      {
+        const plUInt32 uiParent = (uiIndex - 1) / 2;
+
+        if (!(entry < m_Heap[uiParent]))
+          break;
+
+        Store(uiIndex, m_Heap[uiParent]);
+        uiIndex = uiParent;
+      }
+
+      Store(uiIndex, entry);
+    }
+
+    void SiftDown(plUInt32 uiIndex)
+    {
+      const plUInt32 uiCount = m_Heap.GetCount();
+      const Entry entry = m_Heap[uiIndex];
+
+      while (true)
+      {
+        const plUInt32 uiLeft = uiIndex * 2 + 1;
+
+        if (uiLeft >= uiCount)
+          break;
+
+        const plUInt32 uiRight = uiLeft + 1;
+        const plUInt32 uiChild = (uiRight < uiCount && m_Heap[uiRight] < m_Heap[uiLeft]) ? uiRight : uiLeft;
+
+        if (!(m_Heap[uiChild] < entry))
+          break;
+
+        Store(uiIndex, m_Heap[uiChild]);
+        uiIndex = uiChild;
+      }
+
+      Store(uiIndex, entry);
+    }
+
+    void Store(plUInt32 uiIndex, const Entry& entry)
+    {
+      m_Heap[uiIndex] = entry;
+      entry.m_pResource->m_uiLoadingQueueIndex = uiIndex;
+    }
+
+    plDynamicArray<Entry> m_Heap;
+    plUInt64 m_uiNextSequence = 0;
+    plTime m_LastLoadingDeadlinesUpdate;
+  };
+
+  struct plStreamingResult
+  {
+    plTime m_QueueTime;
+    plUInt64 m_uiMissingResourceFrames = 0;
+    plDynamicArray<plUInt32> m_TimeToFirstUse;
+    plUInt32 m_uiUselessLoads = 0;
+  };
+} // namespace
+
+/// \brief Simulates streaming while a camera moves back and forth over a line of resources, with the previous and the current loading queue.
+///
+/// Every frame all resources around the camera are acquired and queued, if they are not loaded. The data loader loads a fixed number of
+/// resources per frame, and resources far away from the camera are unloaded again, or removed from the queue. The benchmark reports the time
+/// spent in the queue, how many resources around the camera were missing on average, and how many frames it took from the first request of
+/// a resource until it was loaded, for all resources that were still in view when they got loaded.
+class plResourceQueueBench : public plApplication
+{
+public:
+  using SUPER = plApplication;
+
+  plResourceQueueBench()
+    : plApplication("ResourceQueueBench")
+  {
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    plGlobalLog::AddLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::AddLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    plGlobalLog::RemoveLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::RemoveLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  template <typename QUEUE>
+  plStreamingResult Simulate()
+  {
+    const plUInt32 uiNumResources = static_cast<plUInt32>(opt_Resources.GetOptionValue(plCommandLineOption::LogMode::Never));
+    const plUInt32 uiViewRadius = static_cast<plUInt32>(opt_ViewRadius.GetOptionValue(plCommandLineOption::LogMode::Never));
+    const plUInt32 uiNumFrames = static_cast<plUInt32>(opt_Frames.GetOptionValue(plCommandLineOption::LogMode::Never));
+    const plUInt32 uiSpeed = static_cast<plUInt32>(opt_Speed.GetOptionValue(plCommandLineOption::LogMode::Never));
+    const plUInt32 uiNumLoads = static_cast<plUInt32>(opt_Loads.GetOptionValue(plCommandLineOption::LogMode::Never));
+    const plUInt32 uiUnloadDistance = uiViewRadius * 3;
+
+    plDynamicArray<plBenchResource> resources;
+    resources.SetCount(uiNumResources);
+
+    plUInt32 uiSeed = 1;
+    for (plUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      uiSeed = uiSeed * 1103515245u + 12345u;
+
+      resources[i].m_uiPosition = i;
+
+      // a few resources are needed right away, like the ones that are acquired with BlockTillLoaded
+      const plUInt32 uiRandom = (uiSeed >> 16) % 100;
+      resources[i].m_Priority = uiRandom < 2 ? plResourcePriority::Critical : static_cast<plResourcePriority>(1 + uiRandom % 5);
+    }
+
+    QUEUE queue;
+    plStreamingResult result;
+
+    plUInt32 uiCamera = uiViewRadius;
+    bool bForward = true;
+
+    for (plUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      const plTime now = plTime::MakeFromSeconds(uiFrame / 60.0);
+
+      if (bForward && uiCamera + uiSpeed >= uiNumResources)
+        bForward = false;
+      else if (!bForward && uiCamera < uiSpeed)
+        bForward = true;
+
+      uiCamera = bForward ? uiCamera + uiSpeed : uiCamera - uiSpeed;
+
+      const plUInt32 uiViewStart = uiCamera > uiViewRadius ? uiCamera - uiViewRadius : 0;
+      const plUInt32 uiViewEnd = plMath::Min(uiCamera + uiViewRadius, uiNumResources - 1);
+
+      // unload everything that is far away, like plResourceManager::FreeAllUnusedResources() would do for resources that aren't referenced anymore
+      for (plBenchResource& resource : resources)
+      {
+        const plUInt32 uiDistance = resource.m_uiPosition > uiCamera ? resource.m_uiPosition - uiCamera : uiCamera - resource.m_uiPosition;
+        if (uiDistance <= uiUnloadDistance)
+          continue;
+
+        resource.m_bLoaded = false;
+        resource.m_iRequestFrame = -1;
+
+        if (resource.m_bQueued)
+        {
+          const plTime start = plTime::Now();
+          queue.Remove(&resource);
+          result.m_QueueTime += plTime::Now() - start;
+
+          resource.m_bQueued = false;
+        }
+      }
+
+      // acquire everything in view
+      {
+        const plTime start = plTime::Now();
+
+        for (plUInt32 i = uiViewStart; i <= uiViewEnd; ++i)
+        {
+          plBenchResource& resource = resources[i];
+          resource.m_LastAcquire = now;
+
+          if (resource.m_bLoaded)
+            continue;
+
+          ++result.m_uiMissingResourceFrames;
+
+          if (!resource.m_bQueued)
+          {
+            resource.m_bQueued = true;
+            resource.m_iRequestFrame = resource.m_iRequestFrame < 0 ? static_cast<plInt32>(uiFrame) : resource.m_iRequestFrame;
+            queue.Insert(&resource, now);
+          }
+        }
+
+        result.m_QueueTime += plTime::Now() - start;
+      }
+
+      for (plUInt32 uiLoad = 0; uiLoad < uiNumLoads && !queue.IsEmpty(); ++uiLoad)
+      {
+        const plTime start = plTime::Now();
+        plBenchResource* pResource = queue.PopFront(now);
+        result.m_QueueTime += plTime::Now() - start;
+
+        pResource->m_bQueued = false;
+        pResource->m_bLoaded = true;
+
+        if (pResource->m_uiPosition >= uiViewStart && pResource->m_uiPosition <= uiViewEnd)
+        {
+          result.m_TimeToFirstUse.PushBack(uiFrame - pResource->m_iRequestFrame);
+        }
+        else
+        {
+          ++result.m_uiUselessLoads;
+        }
+
+        pResource->m_iRequestFrame = -1;
+      }
+    }
+
+    result.m_TimeToFirstUse.Sort();
+    return result;
+  }
+
+  void Report(const char* szName, const plStreamingResult& result)
+  {
+    const plUInt32 uiNumFrames = static_cast<plUInt32>(opt_Frames.GetOptionValue(plCommandLineOption::LogMode::Never));
+
+    double fAverage = 0.0;
+    for (plUInt32 uiFrames : result.m_TimeToFirstUse)
+    {
+      fAverage += uiFrames;
+    }
+
+    fAverage /= plMath::Max(result.m_TimeToFirstUse.GetCount(), 1u);
+
+    const plUInt32 uiPercentile95 = result.m_TimeToFirstUse.IsEmpty() ? 0 : result.m_TimeToFirstUse[result.m_TimeToFirstUse.GetCount() * 95 / 100];
+
+    plLog::Info("{}: {} us queue time per frame, {} missing resources in view per frame, time to first use {} frames on average, {} frames for 95 percent, {} loads were out of view", szName,
+      plArgF(result.m_QueueTime.GetMicroseconds() / uiNumFrames, 2), plArgF(static_cast<double>(result.m_uiMissingResourceFrames) / uiNumFrames, 1), plArgF(fAverage, 1),
+      uiPercentile95, result.m_uiUselessLoads);
+  }
+
+  virtual Execution Run() override
+  {
+    {
+      plStringBuilder cmdHelp;
+      if (plCommandLineOption::LogAvailableOptionsToBuffer(cmdHelp, plCommandLineOption::LogAvailableModes::IfHelpRequested, "_ResourceQueueBench"))
+      {
+        plLog::Print(cmdHelp);
+        return plApplication::Execution::Quit;
+      }
+    }
+
+    opt_Resources.GetOptionValue(plCommandLineOption::LogMode::Always);
+    opt_ViewRadius.GetOptionValue(plCommandLineOption::LogMode::Always);
+    opt_Frames.GetOptionValue(plCommandLineOption::LogMode::Always);
+    opt_Speed.GetOptionValue(plCommandLineOption::LogMode::Always);
+    opt_Loads.GetOptionValue(plCommandLineOption::LogMode::Always);
+
+    Report("Previous", Simulate<plPreviousLoadingQueue>());
+    Report("Current", Simulate<plCurrentLoadingQueue>());
+
+    return plApplication::Execution::Quit;
+  }
+};
+
+PL_CONSOLEAPP_ENTRY_POINT(plResourceQueueBench);
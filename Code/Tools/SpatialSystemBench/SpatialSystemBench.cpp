@@ -0,0 +1,264 @@
+#include <Core/World/SpatialSystem_Bvh.h>
+#include <Core/World/SpatialSystem_RegularGrid.h>
+#include <Foundation/Application/Application.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Types/TagSet.h>
+#include <Foundation/Types/UniquePtr.h>
+#include <Foundation/Utilities/CommandLineOptions.h>
+
+plCommandLineOptionInt opt_Objects("_SpatialSystemBench", "-objects", "Number of objects. Every third one is dynamic and moves every frame.", 30000, 1, 10000000);
+
+plCommandLineOptionInt opt_Frames("_SpatialSystemBench", "-frames", "Number of frames. Every frame the dynamic objects are moved and the queries are run.", 20, 1, 10000);
+
+plCommandLineOptionInt opt_Queries("_SpatialSystemBench", "-queries", "Number of sphere, box and frustum queries per frame.", 20, 1, 10000);
+
+plCommandLineOptionFloat opt_WorldSize("_SpatialSystemBench", "-size", "Objects are distributed over a square with this edge length.", 4000.0f, 10.0f, 1000000.0f);
+
+namespace
+{
+  struct plBenchObject
+  {
+    plSimdBBoxSphere m_Bounds;
+    plUInt32 m_uiCategoryBitmask = 0;
+  };
+
+  struct plBenchResults
+  {
+    plTime m_Create;
+    plTime m_Update;
+    plTime m_Sphere;
+    plTime m_Box;
+    plTime m_Frustum;
+    plUInt64 m_uiNumSphereResults = 0;
+    plUInt64 m_uiNumBoxResults = 0;
+    plUInt64 m_uiNumFrustumResults = 0;
+    plUInt64 m_uiNumSphereExpected = 0;
+    plUInt64 m_uiNumBoxExpected = 0;
+  };
+} // namespace
+
+/// \brief Runs the same scene and queries through plSpatialSystem_RegularGrid and plSpatialSystem_Bvh and compares their timings.
+///
+/// The spatial systems only store the object pointers and never dereference them, so the objects are identified by fake pointers.
+/// The number of objects that every kind of query found is printed as well. The sphere and box queries are also checked against a brute
+/// force search, the BVH has to find exactly the overlapping objects, the grid may find more, because it is conservative.
+class plSpatialSystemBench : public plApplication
+{
+  plDynamicArray<plBenchObject> m_Objects;
+
+public:
+  using SUPER = plApplication;
+
+  plSpatialSystemBench()
+    : plApplication("SpatialSystemBench")
+  {
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    plGlobalLog::AddLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::AddLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    plGlobalLog::RemoveLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::RemoveLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  void CreateObjects(plUInt32 uiNumObjects, float fWorldSize)
+  {
+    plRandom rng;
+    rng.Initialize(42);
+
+    const double fHalfSize = fWorldSize * 0.5;
+    const plUInt32 categories[] = {plDefaultSpatialDataCategories::RenderStatic.GetBitmask(), plDefaultSpatialDataCategories::RenderDynamic.GetBitmask(),
+      plDefaultSpatialDataCategories::RenderStatic.GetBitmask() | plDefaultSpatialDataCategories::OcclusionStatic.GetBitmask()};
+
+    m_Objects.SetCount(uiNumObjects);
+    for (plUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      const plVec3 vCenter(static_cast<float>(rng.DoubleMinMax(-fHalfSize, fHalfSize)), static_cast<float>(rng.DoubleMinMax(-fHalfSize, fHalfSize)), static_cast<float>(rng.DoubleMinMax(-200, 200)));
+      const plVec3 vHalfExtents(static_cast<float>(rng.DoubleMinMax(0.5, 20)), static_cast<float>(rng.DoubleMinMax(0.5, 20)), static_cast<float>(rng.DoubleMinMax(0.5, 20)));
+
+      m_Objects[i].m_Bounds = plSimdBBoxSphere::MakeFromCenterExtents(plSimdConversion::ToVec3(vCenter), plSimdConversion::ToVec3(vHalfExtents), vHalfExtents.GetLength());
+      m_Objects[i].m_uiCategoryBitmask = categories[i % PL_ARRAY_SIZE(categories)];
+    }
+  }
+
+  void Measure(plSpatialSystem& ref_system, plBenchResults& out_results)
+  {
+    const plUInt32 uiNumFrames = static_cast<plUInt32>(opt_Frames.GetOptionValue(plCommandLineOption::LogMode::Never));
+    const plUInt32 uiNumQueries = static_cast<plUInt32>(opt_Queries.GetOptionValue(plCommandLineOption::LogMode::Never));
+    const double fHalfSize = opt_WorldSize.GetOptionValue(plCommandLineOption::LogMode::Never) * 0.5;
+
+    // both systems get the same movement and queries
+    plRandom rng;
+    rng.Initialize(1337);
+
+    plDynamicArray<plBenchObject> objects = m_Objects;
+    plDynamicArray<plSpatialDataHandle> handles;
+    handles.SetCountUninitialized(objects.GetCount());
+
+    const plTagSet tags;
+
+    plTime start = plTime::Now();
+
+    for (plUInt32 i = 0; i < objects.GetCount(); ++i)
+    {
+      handles[i] = ref_system.CreateSpatialData(objects[i].m_Bounds, reinterpret_cast<plGameObject*>(static_cast<size_t>(i + 1)), objects[i].m_uiCategoryBitmask, tags);
+    }
+
+    out_results.m_Create = plTime::Now() - start;
+
+    for (plUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      ref_system.StartNewFrame();
+
+      // move the dynamic objects a bit, some of them far
+      for (plUInt32 i = 1; i < objects.GetCount(); i += 3)
+      {
+        plVec3 vOffset(static_cast<float>(rng.DoubleMinMax(-2, 2)), static_cast<float>(rng.DoubleMinMax(-2, 2)), 0.0f);
+        if (rng.UIntInRange(50) == 0)
+        {
+          vOffset.x = static_cast<float>(rng.DoubleMinMax(-500, 500));
+        }
+
+        objects[i].m_Bounds.m_CenterAndRadius += plSimdConversion::ToVec3(vOffset);
+      }
+
+      start = plTime::Now();
+
+      for (plUInt32 i = 1; i < objects.GetCount(); i += 3)
+      {
+        ref_system.UpdateSpatialDataBounds(handles[i], objects[i].m_Bounds);
+      }
+
+      out_results.m_Update += plTime::Now() - start;
+
+      for (plUInt32 uiQuery = 0; uiQuery < uiNumQueries; ++uiQuery)
+      {
+        plSpatialSystem::QueryParams params;
+        params.m_uiCategoryBitmask = (uiQuery % 2) != 0 ? plDefaultSpatialDataCategories::RenderDynamic.GetBitmask() : plDefaultSpatialDataCategories::RenderStatic.GetBitmask() | plDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
+
+        const plVec3 vCenter(static_cast<float>(rng.DoubleMinMax(-fHalfSize, fHalfSize)), static_cast<float>(rng.DoubleMinMax(-fHalfSize, fHalfSize)), 0.0f);
+
+        auto countResults = [](plUInt64& inout_uiCount) {
+          return [&inout_uiCount](plGameObject*) {
+            ++inout_uiCount;
+            return plVisitorExecution::Continue;
+          };
+        };
+
+        const plBoundingSphere sphere = plBoundingSphere::MakeFromCenterAndRadius(vCenter, 150.0f);
+        const plBoundingBox box = plBoundingBox::MakeFromMinMax(vCenter - plVec3(100.0f), vCenter + plVec3(300.0f, 100.0f, 100.0f));
+
+        start = plTime::Now();
+        ref_system.FindObjectsInSphere(sphere, params, countResults(out_results.m_uiNumSphereResults));
+        out_results.m_Sphere += plTime::Now() - start;
+
+        start = plTime::Now();
+        ref_system.FindObjectsInBox(box, params, countResults(out_results.m_uiNumBoxResults));
+        out_results.m_Box += plTime::Now() - start;
+
+        const plSimdBSphere simdSphere(plSimdConversion::ToVec3(sphere.m_vCenter), sphere.m_fRadius);
+        const plSimdBBox simdBox(plSimdConversion::ToVec3(box.m_vMin), plSimdConversion::ToVec3(box.m_vMax));
+
+        for (const plBenchObject& object : objects)
+        {
+          if ((object.m_uiCategoryBitmask & params.m_uiCategoryBitmask) == 0)
+            continue;
+
+          const plSimdBSphere objectSphere = object.m_Bounds.GetSphere();
+          const plSimdBBox objectBox = object.m_Bounds.GetBox();
+
+          if (simdSphere.Overlaps(objectSphere) && objectBox.Overlaps(simdSphere))
+            ++out_results.m_uiNumSphereExpected;
+
+          if (simdBox.Overlaps(objectSphere) && objectBox.Overlaps(simdBox))
+            ++out_results.m_uiNumBoxExpected;
+        }
+
+        const plFrustum frustum = plFrustum::MakeFromFOV(vCenter, plVec3(1.0f, 0.3f, 0.0f).GetNormalized(), plVec3(0.0f, 0.0f, 1.0f), plAngle::MakeFromDegree(70), plAngle::MakeFromDegree(50), 0.1f, 800.0f);
+        plDynamicArray<const plGameObject*> visibleObjects;
+
+        start = plTime::Now();
+        ref_system.FindVisibleObjects(frustum, params, visibleObjects, {}, plVisibilityState::Direct);
+        out_results.m_Frustum += plTime::Now() - start;
+
+        out_results.m_uiNumFrustumResults += visibleObjects.GetCount();
+      }
+    }
+
+    for (const plSpatialDataHandle& hData : handles)
+    {
+      ref_system.DeleteSpatialData(hData);
+    }
+  }
+
+  void PrintResults(plStringView sName, const plBenchResults& results)
+  {
+    plLog::Info("{}: create {} ms, update {} ms, sphere queries {} ms ({} found), box queries {} ms ({} found), frustum queries {} ms ({} found)", sName,
+      plArgF(results.m_Create.GetMilliseconds(), 2), plArgF(results.m_Update.GetMilliseconds(), 2), plArgF(results.m_Sphere.GetMilliseconds(), 2),
+      results.m_uiNumSphereResults, plArgF(results.m_Box.GetMilliseconds(), 2), results.m_uiNumBoxResults, plArgF(results.m_Frustum.GetMilliseconds(), 2),
+      results.m_uiNumFrustumResults);
+  }
+
+  virtual Execution Run() override
+  {
+    {
+      plStringBuilder cmdHelp;
+      if (plCommandLineOption::LogAvailableOptionsToBuffer(cmdHelp, plCommandLineOption::LogAvailableModes::IfHelpRequested, "_SpatialSystemBench"))
+      {
+        plLog::Print(cmdHelp);
+        return plApplication::Execution::Quit;
+      }
+    }
+
+    const plUInt32 uiNumObjects = static_cast<plUInt32>(opt_Objects.GetOptionValue(plCommandLineOption::LogMode::Always));
+    opt_Frames.GetOptionValue(plCommandLineOption::LogMode::Always);
+    opt_Queries.GetOptionValue(plCommandLineOption::LogMode::Always);
+
+    CreateObjects(uiNumObjects, opt_WorldSize.GetOptionValue(plCommandLineOption::LogMode::Always));
+
+    plBenchResults gridResults;
+    {
+      plUniquePtr<plSpatialSystem> pGrid = PL_DEFAULT_NEW(plSpatialSystem_RegularGrid);
+      Measure(*pGrid, gridResults);
+    }
+
+    plBenchResults bvhResults;
+    {
+      plUniquePtr<plSpatialSystem> pBvh = PL_DEFAULT_NEW(plSpatialSystem_Bvh);
+      Measure(*pBvh, bvhResults);
+    }
+
+    PrintResults("Regular grid", gridResults);
+    PrintResults("BVH", bvhResults);
+
+    if (gridResults.m_uiNumSphereResults < gridResults.m_uiNumSphereExpected || gridResults.m_uiNumBoxResults < gridResults.m_uiNumBoxExpected)
+    {
+      plLog::Error("The regular grid missed objects, expected {} in spheres and {} in boxes", gridResults.m_uiNumSphereExpected, gridResults.m_uiNumBoxExpected);
+      SetReturnCode(1);
+    }
+
+    if (bvhResults.m_uiNumSphereResults != bvhResults.m_uiNumSphereExpected || bvhResults.m_uiNumBoxResults != bvhResults.m_uiNumBoxExpected)
+    {
+      plLog::Error("The BVH found the wrong objects, expected {} in spheres and {} in boxes", bvhResults.m_uiNumSphereExpected, bvhResults.m_uiNumBoxExpected);
+      SetReturnCode(1);
+    }
+
+    return plApplication::Execution::Quit;
+  }
+};
+
+PL_CONSOLEAPP_ENTRY_POINT(plSpatialSystemBench);
@@ -0,0 +1,238 @@
+#include <Foundation/Application/Application.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Utilities/CommandLineOptions.h>
+
+plCommandLineOptionInt opt_Threads("_TaskSystemBench", "-threads", "Number of short task worker threads. -1 uses the default for this machine.", -1, -1, 128);
+
+plCommandLineOptionInt opt_Tasks("_TaskSystemBench", "-tasks", "Number of tasks per fan-out.", 4096, 16, 1000000);
+
+plCommandLineOptionInt opt_Runs("_TaskSystemBench", "-runs", "How often every measurement is repeated. The fastest run is reported.", 10, 1, 1000);
+
+namespace
+{
+  /// \brief A task that does (almost) nothing, so that only the scheduling overhead is measured.
+  class plBenchTask : public plTask
+  {
+  public:
+    plAtomicInteger32* m_pCounter = nullptr;
+    plTime m_StartTime;
+    plTime m_Latency;
+
+    virtual void Execute() override
+    {
+      m_Latency = plTime::Now() - m_StartTime;
+      m_pCounter->Increment();
+    }
+  };
+
+  /// \brief Runs on a worker thread and fans out the given tasks in groups of 8, like systems do that split up their work from inside a task.
+  class plFanOutTask : public plTask
+  {
+  public:
+    plArrayPtr<plSharedPtr<plTask>> m_Tasks;
+
+    virtual void Execute() override
+    {
+      plDynamicArray<plTaskGroupID> groups;
+
+      for (plUInt32 i = 0; i < m_Tasks.GetCount(); i += 8)
+      {
+        plTaskGroupID group = plTaskSystem::CreateTaskGroup(plTaskPriority::EarlyThisFrame);
+
+        for (plUInt32 j = i; j < plMath::Min(i + 8, m_Tasks.GetCount()); ++j)
+        {
+          plTaskSystem::AddTaskToGroup(group, m_Tasks[j]);
+        }
+
+        plTaskSystem::StartTaskGroup(group);
+        groups.PushBack(group);
+      }
+
+      for (const plTaskGroupID& group : groups)
+      {
+        plTaskSystem::WaitForGroup(group);
+      }
+    }
+  };
+} // namespace
+
+/// \brief Measures the task throughput and the scheduling latency of every plTaskSchedulingMode.
+///
+/// The tasks don't do any work, so the numbers are dominated by the cost of queuing, dequeuing and finishing tasks and by the contention
+/// on the task system's locks. To see the difference between the modes, run this on a machine with many cores.
+class plTaskSystemBench : public plApplication
+{
+  plDynamicArray<plSharedPtr<plTask>> m_Tasks;
+  plAtomicInteger32 m_iExecuted;
+
+public:
+  using SUPER = plApplication;
+
+  plTaskSystemBench()
+    : plApplication("TaskSystemBench")
+  {
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    plGlobalLog::AddLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::AddLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    plGlobalLog::RemoveLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::RemoveLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  /// \brief The main thread puts all tasks into one group and waits for it.
+  plTime MeasureMainThreadFanOut()
+  {
+    plTime fastest = plTime::MakeFromHours(1);
+
+    for (plInt32 iRun = 0; iRun < opt_Runs.GetOptionValue(plCommandLineOption::LogMode::Never); ++iRun)
+    {
+      m_iExecuted = 0;
+      const plTime start = plTime::Now();
+
+      plTaskGroupID group = plTaskSystem::CreateTaskGroup(plTaskPriority::EarlyThisFrame);
+      for (const plSharedPtr<plTask>& pTask : m_Tasks)
+      {
+        plTaskSystem::AddTaskToGroup(group, pTask);
+      }
+
+      plTaskSystem::StartTaskGroup(group);
+      plTaskSystem::WaitForGroup(group);
+
+      fastest = plMath::Min(fastest, plTime::Now() - start);
+      PL_ASSERT_ALWAYS(m_iExecuted == static_cast<plInt32>(m_Tasks.GetCount()), "Not all tasks were executed");
+    }
+
+    return fastest;
+  }
+
+  /// \brief Every worker thread fans out its share of the tasks in small groups and waits for them.
+  plTime MeasureWorkerFanOut()
+  {
+    const plUInt32 uiNumWorkers = plMath::Max(plTaskSystem::GetWorkerThreadCount(plWorkerThreadType::ShortTasks), 1u);
+    const plUInt32 uiTasksPerWorker = (m_Tasks.GetCount() + uiNumWorkers - 1) / uiNumWorkers;
+
+    plDynamicArray<plSharedPtr<plFanOutTask>> fanOutTasks;
+    for (plUInt32 i = 0; i < m_Tasks.GetCount(); i += uiTasksPerWorker)
+    {
+      plSharedPtr<plFanOutTask> pTask = PL_DEFAULT_NEW(plFanOutTask);
+      pTask->ConfigureTask("FanOut", plTaskNesting::Maybe);
+      pTask->m_Tasks = m_Tasks.GetArrayPtr().GetSubArray(i, plMath::Min(uiTasksPerWorker, m_Tasks.GetCount() - i));
+      fanOutTasks.PushBack(pTask);
+    }
+
+    plTime fastest = plTime::MakeFromHours(1);
+
+    for (plInt32 iRun = 0; iRun < opt_Runs.GetOptionValue(plCommandLineOption::LogMode::Never); ++iRun)
+    {
+      m_iExecuted = 0;
+      const plTime start = plTime::Now();
+
+      plTaskGroupID group = plTaskSystem::CreateTaskGroup(plTaskPriority::EarlyThisFrame);
+      for (const plSharedPtr<plFanOutTask>& pTask : fanOutTasks)
+      {
+        plTaskSystem::AddTaskToGroup(group, pTask);
+      }
+
+      plTaskSystem::StartTaskGroup(group);
+      plTaskSystem::WaitForGroup(group);
+
+      fastest = plMath::Min(fastest, plTime::Now() - start);
+      PL_ASSERT_ALWAYS(m_iExecuted == static_cast<plInt32>(m_Tasks.GetCount()), "Not all tasks were executed");
+    }
+
+    return fastest;
+  }
+
+  /// \brief Starts single tasks one after the other and returns the median and the 99th percentile of the time until they started executing.
+  void MeasureLatency(plTime& out_median, plTime& out_p99)
+  {
+    const plUInt32 uiNumSamples = plMath::Min(m_Tasks.GetCount(), 1000u);
+
+    plDynamicArray<plTime> latencies;
+    latencies.Reserve(uiNumSamples);
+
+    for (plUInt32 i = 0; i < uiNumSamples; ++i)
+    {
+      plBenchTask* pTask = static_cast<plBenchTask*>(m_Tasks[i].Borrow());
+      pTask->m_StartTime = plTime::Now();
+
+      plTaskSystem::WaitForGroup(plTaskSystem::StartSingleTask(m_Tasks[i], plTaskPriority::EarlyThisFrame));
+
+      latencies.PushBack(pTask->m_Latency);
+    }
+
+    latencies.Sort();
+    out_median = latencies[uiNumSamples / 2];
+    out_p99 = latencies[(uiNumSamples * 99) / 100];
+  }
+
+  void Measure(plTaskSchedulingMode::Enum mode, const char* szModeName)
+  {
+    plTaskSystem::SetSchedulingMode(mode);
+
+    const double fNumTasks = static_cast<double>(m_Tasks.GetCount());
+
+    const plTime mainThreadFanOut = MeasureMainThreadFanOut();
+    const plTime workerFanOut = MeasureWorkerFanOut();
+
+    plTime latencyMedian, latencyP99;
+    MeasureLatency(latencyMedian, latencyP99);
+
+    plLog::Info("{}: main thread fan-out {} tasks/ms, worker fan-out {} tasks/ms, latency median {} us, p99 {} us", szModeName,
+      plArgF(fNumTasks / mainThreadFanOut.GetMilliseconds(), 0), plArgF(fNumTasks / workerFanOut.GetMilliseconds(), 0),
+      plArgF(latencyMedian.GetMicroseconds(), 1), plArgF(latencyP99.GetMicroseconds(), 1));
+  }
+
+  virtual Execution Run() override
+  {
+    {
+      plStringBuilder cmdHelp;
+      if (plCommandLineOption::LogAvailableOptionsToBuffer(cmdHelp, plCommandLineOption::LogAvailableModes::IfHelpRequested, "_TaskSystemBench"))
+      {
+        plLog::Print(cmdHelp);
+        return plApplication::Execution::Quit;
+      }
+    }
+
+    const plInt32 iThreads = opt_Threads.GetOptionValue(plCommandLineOption::LogMode::Always);
+    if (iThreads >= 0)
+    {
+      plTaskSystem::SetWorkerThreadCount(iThreads, -1);
+    }
+
+    const plUInt32 uiNumTasks = static_cast<plUInt32>(opt_Tasks.GetOptionValue(plCommandLineOption::LogMode::Always));
+    for (plUInt32 i = 0; i < uiNumTasks; ++i)
+    {
+      plSharedPtr<plBenchTask> pTask = PL_DEFAULT_NEW(plBenchTask);
+      pTask->ConfigureTask("Bench", plTaskNesting::Never);
+      pTask->m_pCounter = &m_iExecuted;
+      m_Tasks.PushBack(pTask);
+    }
+
+    plLog::Info("{} short task worker threads, {} tasks", plTaskSystem::GetWorkerThreadCount(plWorkerThreadType::ShortTasks), uiNumTasks);
+
+    Measure(plTaskSchedulingMode::Default, "Default");
+    Measure(plTaskSchedulingMode::WorkStealing, "WorkStealing");
+
+    plTaskSystem::SetSchedulingMode(plTaskSchedulingMode::Default);
+    m_Tasks.Clear();
+
+    return plApplication::Execution::Quit;
+  }
+};
+
+PL_CONSOLEAPP_ENTRY_POINT(plTaskSystemBench);
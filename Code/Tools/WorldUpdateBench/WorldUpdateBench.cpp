@@ -0,0 +1,213 @@
+#include <Core/Messages/UpdateLocalBoundsMessage.h>
+#include <Core/World/World.h>
+#include <Foundation/Application/Application.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Utilities/CommandLineOptions.h>
+
+plCommandLineOptionInt opt_Depth("_WorldUpdateBench", "-depth", "Number of hierarchy levels.", 4, 1, 16);
+
+plCommandLineOptionInt opt_FanOut("_WorldUpdateBench", "-fanout", "Number of root objects and of children per object.", 16, 1, 1024);
+
+plCommandLineOptionInt opt_Frames("_WorldUpdateBench", "-frames", "Number of measured world updates.", 100, 1, 100000);
+
+plCommandLineOptionInt opt_Threads("_WorldUpdateBench", "-threads", "Number of short task worker threads. -1 uses the default for this machine.", -1, -1, 128);
+
+plCommandLineOptionBool opt_SpatialSystem("_WorldUpdateBench", "-spatial", "Whether the world has a spatial system.", true);
+
+plCommandLineOptionBool opt_Bounds("_WorldUpdateBench", "-bounds", "Whether every object has bounds, which have to be updated in the spatial system every frame.", true);
+
+using plBenchBoundsComponentManager = plComponentManager<class plBenchBoundsComponent, plBlockStorageType::Compact>;
+
+/// \brief Gives its owner bounds, so that the owner is put into the spatial system.
+class plBenchBoundsComponent : public plComponent
+{
+  PL_DECLARE_COMPONENT_TYPE(plBenchBoundsComponent, plComponent, plBenchBoundsComponentManager);
+
+public:
+  virtual void OnActivated() override { GetOwner()->UpdateLocalBounds(); }
+  virtual void OnDeactivated() override { GetOwner()->UpdateLocalBounds(); }
+
+  void OnUpdateLocalBounds(plMsgUpdateLocalBounds& ref_msg) const
+  {
+    ref_msg.AddBounds(plBoundingBoxSphere::MakeFromCenterExtents(plVec3::MakeZero(), plVec3(0.5f), 0.5f), plDefaultSpatialDataCategories::RenderDynamic);
+  }
+};
+
+// clang-format off
+PL_BEGIN_COMPONENT_TYPE(plBenchBoundsComponent, 1, plComponentMode::Static)
+{
+  PL_BEGIN_MESSAGEHANDLERS
+  {
+    PL_MESSAGE_HANDLER(plMsgUpdateLocalBounds, OnUpdateLocalBounds),
+  }
+  PL_END_MESSAGEHANDLERS;
+}
+PL_END_COMPONENT_TYPE
+// clang-format on
+
+/// \brief Builds a world with a configurable hierarchy of dynamic objects and measures how long its updates take.
+///
+/// The root objects are rotated every frame, so all global transforms and bounds change. After the measurement every global transform
+/// and bounds are compared with ones that are computed serially from the local transforms, to make sure the parallel update produced the right results.
+class plWorldUpdateBench : public plApplication
+{
+public:
+  using SUPER = plApplication;
+
+  plWorldUpdateBench()
+    : plApplication("WorldUpdateBench")
+  {
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    plGlobalLog::AddLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::AddLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    plGlobalLog::RemoveLogWriter(plLogWriter::Console::LogMessageHandler);
+    plGlobalLog::RemoveLogWriter(plLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  void CreateChildren(plWorld& ref_world, plGameObjectHandle hParent, plUInt32 uiDepth, plUInt32 uiFanOut, bool bBounds, plDynamicArray<plGameObjectHandle>& out_roots, plUInt32& inout_uiNumObjects)
+  {
+    if (uiDepth == 0)
+      return;
+
+    auto pBoundsManager = ref_world.GetOrCreateComponentManager<plBenchBoundsComponentManager>();
+
+    for (plUInt32 i = 0; i < uiFanOut; ++i)
+    {
+      plGameObjectDesc desc;
+      desc.m_hParent = hParent;
+      desc.m_bDynamic = true;
+      desc.m_LocalPosition = plVec3(static_cast<float>(i) - uiFanOut * 0.5f, 1.0f, 0.0f);
+      desc.m_LocalRotation = plQuat::MakeFromAxisAndAngle(plVec3::MakeAxisZ(), plAngle::MakeFromDegree(static_cast<float>(i * 10)));
+
+      plGameObject* pObject = nullptr;
+      plGameObjectHandle hObject = ref_world.CreateObject(desc, pObject);
+      ++inout_uiNumObjects;
+
+      if (bBounds)
+      {
+        plBenchBoundsComponent* pComponent = nullptr;
+        pBoundsManager->CreateComponent(pObject, pComponent);
+      }
+
+      if (hParent.IsInvalidated())
+      {
+        out_roots.PushBack(hObject);
+      }
+
+      CreateChildren(ref_world, hObject, uiDepth - 1, uiFanOut, bBounds, out_roots, inout_uiNumObjects);
+    }
+  }
+
+  plUInt32 CountWrongObjects(const plWorld& world)
+  {
+    plUInt32 uiNumWrong = 0;
+
+    for (auto it = world.GetObjects(); it.IsValid(); ++it)
+    {
+      plTransform expected = it->GetLocalTransform();
+      for (const plGameObject* pParent = it->GetParent(); pParent != nullptr; pParent = pParent->GetParent())
+      {
+        expected = plTransform::MakeGlobalTransform(pParent->GetLocalTransform(), expected);
+      }
+
+      // the bounds are centered around the object, so the global bounds have to be centered around the global position
+      const plBoundingBoxSphere globalBounds = it->GetGlobalBounds();
+      const bool bWrongBounds = globalBounds.IsValid() && !globalBounds.m_vCenter.IsEqual(expected.m_vPosition, 0.001f);
+
+      if (!expected.IsEqual(it->GetGlobalTransform(), 0.001f) || bWrongBounds)
+      {
+        ++uiNumWrong;
+      }
+    }
+
+    return uiNumWrong;
+  }
+
+  virtual Execution Run() override
+  {
+    {
+      plStringBuilder cmdHelp;
+      if (plCommandLineOption::LogAvailableOptionsToBuffer(cmdHelp, plCommandLineOption::LogAvailableModes::IfHelpRequested, "_WorldUpdateBench"))
+      {
+        plLog::Print(cmdHelp);
+        return plApplication::Execution::Quit;
+      }
+    }
+
+    const plInt32 iThreads = opt_Threads.GetOptionValue(plCommandLineOption::LogMode::Always);
+    if (iThreads >= 0)
+    {
+      plTaskSystem::SetWorkerThreadCount(iThreads, -1);
+    }
+
+    const plUInt32 uiDepth = static_cast<plUInt32>(opt_Depth.GetOptionValue(plCommandLineOption::LogMode::Always));
+    const plUInt32 uiFanOut = static_cast<plUInt32>(opt_FanOut.GetOptionValue(plCommandLineOption::LogMode::Always));
+    const plUInt32 uiNumFrames = static_cast<plUInt32>(opt_Frames.GetOptionValue(plCommandLineOption::LogMode::Always));
+    const bool bBounds = opt_Bounds.GetOptionValue(plCommandLineOption::LogMode::Always);
+
+    plWorldDesc desc("WorldUpdateBench");
+    desc.m_bAutoCreateSpatialSystem = opt_SpatialSystem.GetOptionValue(plCommandLineOption::LogMode::Always);
+
+    plWorld world(desc);
+    PL_LOCK(world.GetWriteMarker());
+
+    plDynamicArray<plGameObjectHandle> roots;
+    plUInt32 uiNumObjects = 0;
+    CreateChildren(world, plGameObjectHandle(), uiDepth, uiFanOut, bBounds, roots, uiNumObjects);
+
+    // the first update initializes the components, don't measure that
+    world.Update();
+
+    plTime total;
+    plTime fastest = plTime::MakeFromHours(1);
+
+    for (plUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      const plQuat rotation = plQuat::MakeFromAxisAndAngle(plVec3::MakeAxisZ(), plAngle::MakeFromDegree(static_cast<float>(uiFrame)));
+      for (const plGameObjectHandle& hRoot : roots)
+      {
+        plGameObject* pRoot = nullptr;
+        if (world.TryGetObject(hRoot, pRoot))
+        {
+          pRoot->SetLocalRotation(rotation);
+        }
+      }
+
+      const plTime start = plTime::Now();
+      world.Update();
+      const plTime duration = plTime::Now() - start;
+
+      total += duration;
+      fastest = plMath::Min(fastest, duration);
+    }
+
+    const plUInt32 uiNumWrong = CountWrongObjects(world);
+    if (uiNumWrong > 0)
+    {
+      plLog::Error("{} of {} objects have wrong global transforms or bounds", uiNumWrong, uiNumObjects);
+      SetReturnCode(1);
+    }
+
+    plLog::Info("{} objects, {} short task worker threads: world update average {} ms, fastest {} ms", uiNumObjects,
+      plTaskSystem::GetWorkerThreadCount(plWorkerThreadType::ShortTasks), plArgF(total.GetMilliseconds() / uiNumFrames, 2), plArgF(fastest.GetMilliseconds(), 2));
+
+    return plApplication::Execution::Quit;
+  }
+};
+
+PL_CONSOLEAPP_ENTRY_POINT(plWorldUpdateBench);